@@ -10,8 +10,11 @@
 #include "Include/ISceneManager.h"
 #include "Include/ICameraController.h"
 #include "Src/ModelData.h"
+#include "Src/AssetManager.h"
+#include "Src/TextureStreamer.h"
 #include <d3d9.h>
 #include <d3dx9.h>
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include "Src/AnimationPlayer.h"
@@ -21,6 +24,30 @@
 #include "Src/SimpleGltfConverter.h"
 #include "Src/MultiModelGltfConverter.h"
 
+namespace {
+
+// 頂點 AABB 的中心與到最遠頂點的距離
+D3DXVECTOR4 ComputeBoundingSphere(const SkinMesh& mesh) {
+    if (mesh.vertices.empty()) {
+        return D3DXVECTOR4(0.0f, 0.0f, 0.0f, 0.0f);
+    }
+    XMFLOAT3 lo = mesh.vertices[0].pos, hi = lo;
+    for (const Vertex& v : mesh.vertices) {
+        lo.x = (std::min)(lo.x, v.pos.x); hi.x = (std::max)(hi.x, v.pos.x);
+        lo.y = (std::min)(lo.y, v.pos.y); hi.y = (std::max)(hi.y, v.pos.y);
+        lo.z = (std::min)(lo.z, v.pos.z); hi.z = (std::max)(hi.z, v.pos.z);
+    }
+    D3DXVECTOR3 center((lo.x + hi.x) * 0.5f, (lo.y + hi.y) * 0.5f, (lo.z + hi.z) * 0.5f);
+    float radiusSq = 0.0f;
+    for (const Vertex& v : mesh.vertices) {
+        D3DXVECTOR3 d(v.pos.x - center.x, v.pos.y - center.y, v.pos.z - center.z);
+        radiusSq = (std::max)(radiusSq, D3DXVec3LengthSq(&d));
+    }
+    return D3DXVECTOR4(center.x, center.y, center.z, sqrtf(radiusSq));
+}
+
+} // namespace
+
 GameScene::GameScene() 
     : Scene("GameScene")
     , EventListener(nullptr)  // 暫時傳入 nullptr，將在 OnInitialize 中重新初始化
@@ -282,6 +309,15 @@ void GameScene::OnRender() {
             //     if (testTex) testTex->Release();
             // }
             
+            // 串流貼圖依模型投影到螢幕上的大小決定常駐的 mip
+            auto* assetManager = dynamic_cast<AssetManager*>(services_->GetAssetManager());
+            D3DXMATRIX viewMatrix, projMatrix;
+            D3DVIEWPORT9 viewport;
+            device->GetTransform(D3DTS_VIEW, &viewMatrix);
+            device->GetTransform(D3DTS_PROJECTION, &projMatrix);
+            device->GetViewport(&viewport);
+            const float fovY = 2.0f * atanf(1.0f / projMatrix._22);
+            
             // 渲染每個模型
             int modelIndex = 0;
             for (const auto& model : loadedModels_) {
@@ -291,6 +327,26 @@ void GameScene::OnRender() {
                     D3DXMatrixIdentity(&worldMatrix);  // 使用單位矩陣，不改變位置
                     device->SetTransform(D3DTS_WORLD, &worldMatrix);
                     
+                    // 回報這個網格可能綁定的所有貼圖（各繪製路徑選用的貼圖不同）；完全在相機後方時不回報
+                    if (assetManager) {
+                        auto bounds = modelBounds_.find(model.get());
+                        if (bounds == modelBounds_.end()) {
+                            bounds = modelBounds_.emplace(model.get(), ComputeBoundingSphere(model->mesh)).first;
+                        }
+                        const D3DXVECTOR4& sphere = bounds->second;
+                        D3DXVECTOR3 center(sphere.x, sphere.y, sphere.z), viewCenter;
+                        D3DXMATRIX worldView = worldMatrix * viewMatrix;
+                        D3DXVec3TransformCoord(&viewCenter, &center, &worldView);
+                        if (viewCenter.z > -sphere.w) {
+                            const float pixels = TextureStreamer::EstimateScreenPixels(
+                                sphere.w, viewCenter.z, fovY, static_cast<float>(viewport.Height));
+                            assetManager->ReportTextureUsage(model->mesh.texture, pixels);
+                            for (const Material& material : model->mesh.materials) {
+                                assetManager->ReportTextureUsage(material.tex, pixels);
+                            }
+                        }
+                    }
+                    
                     
                     // 使用適合的shader
                     // 如果模型沒有骨骼權重數據，使用簡單shader
@@ -299,28 +355,28 @@ void GameScene::OnRender() {
                     bool useSimpleShader = true; // 使用簡單shader
                     
                     // 使用骨骼動畫shader渲染（如果可用）
-                    if (useSkeletalAnimation && skeletalAnimationEffect_ && !model->skeleton.joints.empty()) {
+                    if (useSkeletalAnimation && skeletalAnimationEffect_ && !model->skeleton->joints.empty()) {
                         
                         // 計算骨骼變換矩陣
                         std::vector<DirectX::XMFLOAT4X4> boneMatrices;
                         
                         // 如果有動畫，使用動畫播放器計算矩陣
-                        if (!model->skeleton.animations.empty()) {
+                        if (!model->skeleton->animations.empty()) {
                             // 確保動畫時間在範圍內
-                            float animDuration = model->skeleton.animations[0].duration;
+                            float animDuration = model->skeleton->animations[0].duration;
                             float loopedTime = fmodf(animationTime_, animDuration);
                             
                             AnimationPlayer::ComputeGlobalTransforms(
-                                model->skeleton,
-                                model->skeleton.animations[0], // 使用第一個動畫
+                                *model->skeleton,
+                                model->skeleton->animations[0], // 使用第一個動畫
                                 loopedTime,
                                 boneMatrices
                             );
                         } else {
                             // 沒有動畫，使用綁定姿勢
-                            boneMatrices.resize(model->skeleton.joints.size());
-                            for (size_t i = 0; i < model->skeleton.joints.size(); ++i) {
-                                boneMatrices[i] = model->skeleton.joints[i].bindPoseInverse;
+                            boneMatrices.resize(model->skeleton->joints.size());
+                            for (size_t i = 0; i < model->skeleton->joints.size(); ++i) {
+                                boneMatrices[i] = model->skeleton->joints[i].bindPoseInverse;
                             }
                         }
                         
@@ -343,7 +399,7 @@ void GameScene::OnRender() {
                         //     sprintf_s(debugMsg, "Using fixed pipeline: useSkeletalAnimation=%s, effect=%p, joints=%zu\n",
                         //               useSkeletalAnimation ? "true" : "false",
                         //               skeletalAnimationEffect_,
-                        //               model->skeleton.joints.size());
+                        //               model->skeleton->joints.size());
                         //     OutputDebugStringA(debugMsg);
                         // }
                         // 直接使用 SkinMesh 的 Draw 函數，它會使用已經設定好的貼圖
@@ -376,6 +432,11 @@ void GameScene::OnRender() {
             device->SetFVF(D3DFVF_XYZ | D3DFVF_DIFFUSE);
             device->DrawPrimitiveUP(D3DPT_TRIANGLELIST, 1, vertices, sizeof(Vertex));
         }
+        
+        // 依本幀回報的使用量補上或丟棄串流貼圖的 mip；模型貼圖由 AssetManager 的 TextureManager 載入
+        if (auto* assetManager = dynamic_cast<AssetManager*>(services_->GetAssetManager())) {
+            assetManager->UpdateStreaming();
+        }
     }
 }
 
@@ -397,6 +458,7 @@ void GameScene::OnCleanup() {
     
     // 清理 3D 模型指標
     loadedModels_.clear();
+    modelBounds_.clear();
     loadedTexture_.reset();
     
     // 清理shader
@@ -572,8 +634,9 @@ void GameScene::CreateGameUI() {
             ConvertModelToGltf();
         }, nullptr, L"");
     
-    if (convertButton) {
-        convertButton->name = L"Button_Convert";
+    // 已加入的組件改名要經過 UIManager，名稱索引才會更新
+    if (auto* uiMgr = dynamic_cast<UIManager*>(uiManager); uiMgr && convertButton) {
+        uiMgr->SetComponentName(convertButton, L"Button_Convert");
     }
     
     // 示範如何使用名稱查找組件
@@ -581,6 +644,12 @@ void GameScene::CreateGameUI() {
     // auto* bgComponent = uiManager->FindComponentByName<UIImageNew>(L"bg.png");
     // auto* testButtonComponent = uiManager->FindComponentByName<UIButtonNew>(L"Button_TEST");
     
+    // 把目前用到的小圖打包成圖集，連續繪製的 sprite 不必切換貼圖
+    if (auto* uiMgr = dynamic_cast<UIManager*>(uiManager)) {
+        size_t atlased = uiMgr->BuildAtlas();
+        std::cout << "UI atlas: " << atlased << " image(s) packed" << std::endl;
+    }
+    
     // 保存UI佈局到檔案
     SaveUILayout();  // 保存包含新按鈕的UI配置
     
@@ -618,6 +687,12 @@ void GameScene::LoadUILayout() {
     
     // 載入UI佈局
     if (UISerializer::LoadFromFile(uiManager, uiLayoutPath)) {
+#ifdef _DEBUG
+        // 反序列化後確認名稱/ID索引與組件樹一致
+        if (auto* uiMgr = dynamic_cast<UIManager*>(uiManager)) {
+            uiMgr->ValidateComponentIndex();
+        }
+#endif
         
         // 重新連接事件處理器
         // 找到PAUSE按鈕並重新連接點擊事件
@@ -806,6 +881,7 @@ void GameScene::LoadGameAssets() {
             
             // 直接賦值，型別相同
             loadedModels_ = models;
+            modelBounds_.clear();
             loadLog << "Total models stored: " << loadedModels_.size() << std::endl;
         } else {
             loadLog << "Failed to load horse_group.x" << std::endl;
@@ -965,10 +1041,10 @@ void GameScene::SaveModelsInDifferentFormats(const std::vector<std::shared_ptr<M
         meshV2.indices = model->mesh.indices;
         
         // Copy skeleton if present
-        if (!model->skeleton.joints.empty()) {
+        if (!model->skeleton->joints.empty()) {
             modelV2->skeleton = std::make_unique<SkeletonV2>();
-            modelV2->skeleton->joints.reserve(model->skeleton.joints.size());
-            for (const auto& joint : model->skeleton.joints) {
+            modelV2->skeleton->joints.reserve(model->skeleton->joints.size());
+            for (const auto& joint : model->skeleton->joints) {
                 JointV2 jointV2;
                 jointV2.name = joint.name;
                 jointV2.parentIndex = joint.parentIndex;
@@ -978,9 +1054,9 @@ void GameScene::SaveModelsInDifferentFormats(const std::vector<std::shared_ptr<M
         }
         
         // Copy animations if present
-        if (!model->skeleton.animations.empty()) {
-            modelV2->animations.reserve(model->skeleton.animations.size());
-            for (const auto& anim : model->skeleton.animations) {
+        if (!model->skeleton->animations.empty()) {
+            modelV2->animations.reserve(model->skeleton->animations.size());
+            for (const auto& anim : model->skeleton->animations) {
                 AnimationV2 animV2;
                 animV2.name = anim.name;
                 animV2.duration = anim.duration;
@@ -1107,6 +1183,7 @@ void GameScene::ClearCurrentModels() {
     
     // 清除所有模型資料
     loadedModels_.clear();
+    modelBounds_.clear();
     namedModels_.clear();
     
     // 釋放紋理
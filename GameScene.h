@@ -6,6 +6,7 @@
 #include "Include/IUIListener.h"
 #include <memory>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <d3d9.h>
 #include <d3dx9.h>
@@ -103,6 +104,9 @@ private:
     
     // 3D 模型
     std::vector<std::shared_ptr<ModelData>> loadedModels_;  // 存儲所有載入的模型
+    // 模型空間的包圍球（xyz 中心、w 半徑），第一次繪製時計算；用來估計串流貼圖在螢幕上的大小
+    // 更換 loadedModels_ 時一併清除，避免新模型重用舊位址
+    std::unordered_map<const ModelData*, D3DXVECTOR4> modelBounds_;
     std::map<std::string, std::shared_ptr<ModelData>> namedModels_;  // 按名稱存儲的模型
     std::shared_ptr<IDirect3DTexture9> loadedTexture_; // 存儲載入的紋理
     ID3DXEffect* skeletalAnimationEffect_ = nullptr; // 骨骼動畫shader
@@ -10,6 +10,7 @@
 #include <cctype>            // ::tolower, ::toupper
 #include <memory>            // std::unique_ptr, std::make_unique
 #include "AllocateHierarchy.h"
+#include "ModelTextureSource.h"
 
 // Step 1: Constructor 實作 // error check
 AllocateHierarchy::AllocateHierarchy(IDirect3DDevice9* device) noexcept
@@ -114,7 +115,7 @@ STDMETHODIMP AllocateHierarchy::CreateMeshContainer(
       OutputDebugStringA(debugMsg);
       
       // 嘗試原始檔名
-      HRESULT hr = D3DXCreateTextureFromFileA(
+      HRESULT hr = CreateModelTexture(
         m_device,
         pMaterials[i].pTextureFilename,
         &mc->m_Textures[i]
@@ -128,7 +129,7 @@ STDMETHODIMP AllocateHierarchy::CreateMeshContainer(
         sprintf_s(debugMsg, "AllocateHierarchy: Original failed, trying lowercase: %s\n", lowerName.c_str());
         OutputDebugStringA(debugMsg);
         
-        hr = D3DXCreateTextureFromFileA(
+        hr = CreateModelTexture(
           m_device,
           lowerName.c_str(),
           &mc->m_Textures[i]
@@ -145,7 +146,7 @@ STDMETHODIMP AllocateHierarchy::CreateMeshContainer(
           sprintf_s(debugMsg, "AllocateHierarchy: RED.BMP not found, using Horse4.bmp as fallback\n");
           OutputDebugStringA(debugMsg);
           
-          hr = D3DXCreateTextureFromFileA(
+          hr = CreateModelTexture(
             m_device,
             "Horse4.bmp",
             &mc->m_Textures[i]
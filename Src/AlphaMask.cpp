@@ -0,0 +1,191 @@
+#include "AlphaMask.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <bit>
+#include <cctype>
+
+AlphaMaskRule AlphaMaskRuleFor(const std::filesystem::path& image) {
+    std::string ext = image.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+    if (ext == ".png") {
+        return AlphaMaskRule::AlphaChannel;
+    }
+    if (ext == ".bmp") {
+        return AlphaMaskRule::GreenColorKey;
+    }
+    return AlphaMaskRule::Opaque;
+}
+
+AlphaMask AlphaMask::Build(const TextureImage& image, AlphaMaskRule rule) {
+    AlphaMask mask;
+    mask.width_ = int(image.width);
+    mask.height_ = int(image.height);
+    const size_t pixels = size_t(image.width) * image.height;
+    if (rule == AlphaMaskRule::Opaque || pixels == 0) {
+        mask.opaquePixels_ = pixels;
+        return mask;
+    }
+
+    // 一次走過像素，直接組成每個區塊的 64 bit 字
+    mask.blocksPerRow_ = (size_t(image.width) + kBlockSize - 1) / kBlockSize;
+    const size_t blockRows = (size_t(image.height) + kBlockSize - 1) / kBlockSize;
+    std::vector<uint64_t> blocks(mask.blocksPerRow_ * blockRows, 0);
+    const uint8_t* pixel = image.rgba.data();
+    for (uint32_t y = 0; y < image.height; ++y) {
+        uint64_t* blockRow = blocks.data() + size_t(y >> 3) * mask.blocksPerRow_;
+        const unsigned rowShift = (y & 7) << 3;
+        for (uint32_t x = 0; x < image.width; ++x, pixel += 4) {
+            const bool transparent = rule == AlphaMaskRule::AlphaChannel
+                                         ? pixel[3] < kAlphaThreshold
+                                         : pixel[1] > 200 && pixel[0] < 100 && pixel[2] < 100;
+            blockRow[x >> 3] |= uint64_t(!transparent) << (rowShift | (x & 7));
+        }
+    }
+    for (uint64_t bits : blocks) {
+        mask.opaquePixels_ += size_t(std::popcount(bits));
+    }
+    if (mask.opaquePixels_ == 0 || mask.opaquePixels_ == pixels) {
+        return mask;
+    }
+
+    // 每個區塊指向一個字：整塊透明、整塊不透明共用前兩個，混合區塊依序加在後面
+    mask.words_ = { 0, ~uint64_t(0) };
+    std::vector<uint32_t> blockWords(blocks.size());
+    for (size_t by = 0; by < blockRows; ++by) {
+        const size_t rows = (std::min)(size_t(image.height) - by * kBlockSize, size_t(kBlockSize));
+        for (size_t bx = 0; bx < mask.blocksPerRow_; ++bx) {
+            // 右、下邊緣的區塊只比較圖片內的像素
+            const size_t columns = (std::min)(size_t(image.width) - bx * kBlockSize, size_t(kBlockSize));
+            const uint64_t rowBits = (uint64_t(1) << columns) - 1;
+            uint64_t valid = 0;
+            for (size_t row = 0; row < rows; ++row) {
+                valid |= rowBits << (row * 8);
+            }
+
+            const size_t block = by * mask.blocksPerRow_ + bx;
+            const uint64_t bits = blocks[block];
+            if (bits == 0) {
+                blockWords[block] = 0;
+            } else if (bits == valid) {
+                blockWords[block] = 1;
+            } else {
+                blockWords[block] = uint32_t(mask.words_.size());
+                mask.words_.push_back(bits);
+            }
+        }
+    }
+    if (mask.words_.size() <= size_t(UINT16_MAX) + 1) {
+        mask.blockWords_.assign(blockWords.begin(), blockWords.end());
+    } else {
+        mask.wideBlockWords_ = std::move(blockWords);
+    }
+    mask.words_.shrink_to_fit();
+    return mask;
+}
+
+AlphaMaskService::AlphaMaskService(size_t workers) {
+    workers = (std::max)(workers, size_t(1));
+    workers_.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+        workers_.emplace_back([this] { Run(); });
+    }
+}
+
+AlphaMaskService::~AlphaMaskService() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        queue_.clear();
+    }
+    queued_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+bool AlphaMaskService::Request(const std::filesystem::path& image) {
+    const std::string key = image.string();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_ || completed_.count(key) != 0 || building_.count(key) != 0 ||
+            std::find(queue_.begin(), queue_.end(), image) != queue_.end()) {
+            return false;
+        }
+        queue_.push_back(image);
+    }
+    queued_.notify_one();
+    return true;
+}
+
+std::shared_ptr<const AlphaMask> AlphaMaskService::Wait(const std::filesystem::path& image) {
+    const std::string key = image.string();
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        if (auto done = completed_.find(key); done != completed_.end()) {
+            return done->second;
+        }
+        if (building_.count(key) == 0) {
+            break;
+        }
+        finished_.wait(lock);
+    }
+
+    // 尚未開始或沒有排入：自己建立，不必排在其他檔案後面
+    auto queued = std::find(queue_.begin(), queue_.end(), image);
+    if (queued != queue_.end()) {
+        queue_.erase(queued);
+    }
+    building_.insert(key);
+    const uint64_t generation = generation_;
+    lock.unlock();
+    std::shared_ptr<const AlphaMask> mask = Create(image);
+    lock.lock();
+    building_.erase(key);
+    if (generation == generation_) {
+        completed_[key] = mask;
+    }
+    finished_.notify_all();
+    return mask;
+}
+
+void AlphaMaskService::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.clear();
+    completed_.clear();
+    generation_++;
+}
+
+void AlphaMaskService::Run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        queued_.wait(lock, [&] { return stop_ || !queue_.empty(); });
+        if (stop_) {
+            return;
+        }
+        std::filesystem::path image = std::move(queue_.front());
+        queue_.pop_front();
+        const std::string key = image.string();
+        building_.insert(key);
+        const uint64_t generation = generation_;
+        lock.unlock();
+        std::shared_ptr<const AlphaMask> mask = Create(image);
+        lock.lock();
+        building_.erase(key);
+        if (generation == generation_) {
+            completed_[key] = std::move(mask);
+        }
+        finished_.notify_all();
+    }
+}
+
+std::shared_ptr<const AlphaMask> AlphaMaskService::Create(const std::filesystem::path& image) {
+    try {
+        MappedFile file(image);
+        TextureCookOptions options;
+        options.colorKeyBmp = false;   // 色彩鍵由遮罩規則判斷，保留原本較寬鬆的偏綠範圍
+        return std::make_shared<const AlphaMask>(
+            AlphaMask::Build(DecodeTexture(image, file.bytes(), options), AlphaMaskRuleFor(image)));
+    } catch (const std::exception&) {
+        return nullptr;
+    }
+}
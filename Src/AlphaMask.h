@@ -0,0 +1,108 @@
+#pragma once
+
+#include "TextureCooker.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// UI 點擊測試用的透明度遮罩：以 8x8 區塊為單位，每個區塊一個 64 bit 的像素字（每像素 1 bit，不透明為 1）
+// 區塊表是粗一層的佔用金字塔：每個區塊記錄一個字的編號，0 為整塊透明、1 為整塊不透明，其餘指向混合區塊的字
+// 整塊透明或整塊不透明的區域共用前兩個字、不佔像素記憶體；查詢固定是區塊表與像素字兩次讀取，不依像素內容分支
+// 判斷規則沿用原本鎖定貼圖時的做法：PNG 看 alpha，BMP 看綠色色彩鍵，其他格式一律不透明
+
+enum class AlphaMaskRule {
+    AlphaChannel,    // alpha < kAlphaThreshold 為透明
+    GreenColorKey,   // 偏綠（G > 200、R < 100、B < 100）為透明
+    Opaque,
+};
+
+// 依副檔名選擇規則
+AlphaMaskRule AlphaMaskRuleFor(const std::filesystem::path& image);
+
+class AlphaMask {
+public:
+    static constexpr int kBlockSize = 8;
+    static constexpr uint8_t kAlphaThreshold = 32;
+
+    // image 為 R、G、B、A 順序（DecodeTexture 未套用色彩鍵的輸出）
+    static AlphaMask Build(const TextureImage& image, AlphaMaskRule rule);
+
+    int Width() const { return width_; }
+    int Height() const { return height_; }
+
+    // 超出範圍視為透明
+    bool IsOpaque(int x, int y) const {
+        if (static_cast<unsigned>(x) >= static_cast<unsigned>(width_) ||
+            static_cast<unsigned>(y) >= static_cast<unsigned>(height_)) {
+            return false;
+        }
+        if (words_.empty()) {
+            return opaquePixels_ != 0;
+        }
+        const size_t block = size_t(y >> 3) * blocksPerRow_ + size_t(x >> 3);
+        const size_t word = wideBlockWords_.empty() ? blockWords_[block] : wideBlockWords_[block];
+        return (words_[word] >> (((y & 7) << 3) | (x & 7))) & 1;
+    }
+
+    size_t OpaquePixels() const { return opaquePixels_; }
+    size_t TransparentPixels() const { return size_t(width_) * height_ - opaquePixels_; }
+    size_t MixedBlocks() const { return words_.empty() ? 0 : words_.size() - 2; }
+
+    // 遮罩本身佔用的位元組
+    size_t MemoryBytes() const {
+        return sizeof(*this) + blockWords_.capacity() * sizeof(uint16_t) +
+               wideBlockWords_.capacity() * sizeof(uint32_t) + words_.capacity() * sizeof(uint64_t);
+    }
+
+private:
+    int width_ = 0;
+    int height_ = 0;
+    size_t blocksPerRow_ = 0;
+    size_t opaquePixels_ = 0;
+    // 依列優先的區塊編號；混合區塊超過 uint16 能表示的數量時改用 wideBlockWords_
+    std::vector<uint16_t> blockWords_;
+    std::vector<uint32_t> wideBlockWords_;
+    std::vector<uint64_t> words_;   // [0] 全透明、[1] 全不透明，其後為混合區塊；整張圖都透明或都不透明時為空
+};
+
+// 在背景執行緒解碼圖片並建立遮罩；UI 建立元件時排入，第一次點擊測試時多半已完成
+// 所有方法皆可從任何執行緒呼叫；檔案以 path.string() 識別，結果保留到 Clear
+class AlphaMaskService {
+public:
+    explicit AlphaMaskService(size_t workers = 1);
+    ~AlphaMaskService();
+
+    AlphaMaskService(const AlphaMaskService&) = delete;
+    AlphaMaskService& operator=(const AlphaMaskService&) = delete;
+
+    // 排入建立；已排入或已完成時回傳 false
+    bool Request(const std::filesystem::path& image);
+
+    // 取得遮罩：還在排隊或沒有排入時在呼叫端執行緒建立，建立中則等待完成
+    // 讀檔或解碼失敗時回傳 nullptr（呼叫端視為整張不透明），失敗結果同樣保留
+    std::shared_ptr<const AlphaMask> Wait(const std::filesystem::path& image);
+
+    void Clear();
+
+private:
+    void Run();
+    static std::shared_ptr<const AlphaMask> Create(const std::filesystem::path& image);
+
+    mutable std::mutex mutex_;
+    std::condition_variable queued_;
+    std::condition_variable finished_;
+    std::deque<std::filesystem::path> queue_;
+    std::unordered_map<std::string, std::shared_ptr<const AlphaMask>> completed_;
+    std::unordered_set<std::string> building_;
+    std::vector<std::thread> workers_;
+    uint64_t generation_ = 0;   // Clear 時遞增，之前開始建立的結果不再放入
+    bool stop_ = false;
+};
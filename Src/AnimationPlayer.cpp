@@ -1,4 +1,5 @@
 ﻿#include "AnimationPlayer.h"
+#include <algorithm>
 using namespace DX;
 
 void AnimationPlayer::ComputeGlobalTransforms(
@@ -12,14 +13,24 @@ void AnimationPlayer::ComputeGlobalTransforms(
     const auto& channel = anim.channels[i];
     if (channel.empty()) continue;
     size_t prev = 0, next = 0;
-    for (size_t k = 0; k < channel.size(); ++k) {
-      if (channel[k].time <= time) prev = k;
-      if (channel[k].time >= time) { next = k; break; }
+    float factor = 0.0f;
+    if (anim.framesPerSecond > 0.0f) {
+      // 均勻取樣：由時間直接換算 key 索引
+      float frame = std::max(time, 0.0f) * anim.framesPerSecond;
+      size_t last = channel.size() - 1;
+      prev = std::min(static_cast<size_t>(frame), last);
+      next = std::min(prev + 1, last);
+      factor = next != prev ? frame - static_cast<float>(prev) : 0.0f;
+    } else {
+      for (size_t k = 0; k < channel.size(); ++k) {
+        if (channel[k].time <= time) prev = k;
+        if (channel[k].time >= time) { next = k; break; }
+      }
+      float t0 = channel[prev].time, t1 = channel[next].time;
+      factor = (t1 - t0 > 0) ? (time - t0) / (t1 - t0) : 0.0f;
     }
     const auto& kf0 = channel[prev];
     const auto& kf1 = channel[next];
-    float t0 = kf0.time, t1 = kf1.time;
-    float factor = (t1 - t0 > 0) ? (time - t0) / (t1 - t0) : 0.0f;
     // Decompose transform matrices
     DirectX::XMVECTOR s0, r0v, t0v;
     DirectX::XMVECTOR s1, r1v, t1v;
@@ -36,12 +47,25 @@ void AnimationPlayer::ComputeGlobalTransforms(
     DirectX::XMStoreFloat4x4(&globals[i], local);
   }
   // Combine with parent transforms
+  // glTF 的 joint 不保證父節點排在前面，先沿父鏈把尚未合併的祖先依序處理
+  std::vector<char> resolved(n, 0);
+  std::vector<size_t> chain;
   for (size_t i = 0; i < n; ++i) {
-    int p = skel.joints[i].parentIndex;
-    if (p >= 0) {
-      DirectX::XMMATRIX parent = DirectX::XMLoadFloat4x4(&globals[p]);
-      DirectX::XMMATRIX local = DirectX::XMLoadFloat4x4(&globals[i]);
-      DirectX::XMStoreFloat4x4(&globals[i], DirectX::XMMatrixMultiply(local, parent));
+    for (size_t j = i; j < n && !resolved[j]; ) {
+      chain.push_back(j);
+      resolved[j] = 1;
+      int p = skel.joints[j].parentIndex;
+      j = p >= 0 ? static_cast<size_t>(p) : n;
+    }
+    while (!chain.empty()) {
+      size_t j = chain.back();
+      chain.pop_back();
+      int p = skel.joints[j].parentIndex;
+      if (p >= 0 && static_cast<size_t>(p) < n) {
+        DirectX::XMMATRIX parent = DirectX::XMLoadFloat4x4(&globals[p]);
+        DirectX::XMMATRIX local = DirectX::XMLoadFloat4x4(&globals[j]);
+        DirectX::XMStoreFloat4x4(&globals[j], DirectX::XMMatrixMultiply(local, parent));
+      }
     }
   }
 }
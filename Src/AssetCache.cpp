@@ -0,0 +1,252 @@
+#include "AssetCache.h"
+
+void AssetItem::Touch(std::chrono::steady_clock::rep stamp) noexcept {
+    if (lastAccessed.load(std::memory_order_relaxed) != stamp) {
+        lastAccessed.store(stamp, std::memory_order_relaxed);
+    }
+}
+
+std::chrono::steady_clock::time_point AssetItem::LastAccessed() const noexcept {
+    return std::chrono::steady_clock::time_point(
+        std::chrono::steady_clock::duration(lastAccessed.load(std::memory_order_relaxed)));
+}
+
+AssetCache::AssetCache() : clock_(std::chrono::steady_clock::now().time_since_epoch().count()) {
+}
+
+void AssetCache::AdvanceClock(std::chrono::steady_clock::time_point now) noexcept {
+    clock_.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+std::chrono::steady_clock::time_point AssetCache::Clock() const noexcept {
+    return std::chrono::steady_clock::time_point(
+        std::chrono::steady_clock::duration(clock_.load(std::memory_order_relaxed)));
+}
+
+size_t AssetCache::ShardIndex(size_t hash) noexcept {
+    // 打散高位，避免與 unordered_map 內部使用的低位元相關
+    size_t h = hash;
+    h ^= h >> 17;
+    h *= 0x9E3779B97F4A7C15ull;
+    return (h >> 32) % kShardCount;
+}
+
+void AssetCache::Publish(AssetItem& item, std::shared_ptr<void> data) const {
+    {
+        std::lock_guard<std::mutex> lock(item.loadMutex);
+        if (data) {
+            item.data = std::move(data);
+            item.lastAccessed.store(clock_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            item.state.store(AssetCacheState::Loaded, std::memory_order_release);
+        } else {
+            item.state.store(AssetCacheState::Failed, std::memory_order_release);
+        }
+    }
+    item.loadDone.notify_all();
+}
+
+std::shared_ptr<void> AssetCache::Find(const std::string& key) const {
+    const HashedKey hashed(key);
+    const Shard& shard = ShardFor(hashed);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.items.find(hashed);
+    if (it == shard.items.end()) {
+        return nullptr;
+    }
+
+    AssetItem& item = *it->second;
+    if (item.state.load(std::memory_order_acquire) != AssetCacheState::Loaded) {
+        return nullptr;
+    }
+    Touch(item);
+    return item.data;
+}
+
+std::shared_ptr<void> AssetCache::Peek(const std::string& key) const {
+    const HashedKey hashed(key);
+    const Shard& shard = ShardFor(hashed);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.items.find(hashed);
+    if (it == shard.items.end() ||
+        it->second->state.load(std::memory_order_acquire) != AssetCacheState::Loaded) {
+        return nullptr;
+    }
+    return it->second->data;
+}
+
+bool AssetCache::IsLoaded(const std::string& key) const {
+    const HashedKey hashed(key);
+    const Shard& shard = ShardFor(hashed);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.items.find(hashed);
+    return it != shard.items.end() &&
+           it->second->state.load(std::memory_order_acquire) == AssetCacheState::Loaded;
+}
+
+std::shared_ptr<void> AssetCache::GetOrLoad(const std::string& key, const std::string& path,
+                                            uint8_t type, const LoadFunc& loader) {
+    const HashedKey hashed(key);
+    Shard& shard = ShardFor(hashed);
+    std::shared_ptr<AssetItem> item;
+
+    // 快速路徑：只取共享鎖；命中時由鎖保證項目存活，不複製項目的 shared_ptr（避免寫入共用的引用計數）
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.items.find(hashed);
+        if (it != shard.items.end()) {
+            AssetItem& found = *it->second;
+            if (found.state.load(std::memory_order_acquire) == AssetCacheState::Loaded) {
+                Touch(found);
+                return found.data;
+            }
+            item = it->second;
+        }
+    }
+
+    // 未命中：建立載入中的項目，只有建立者負責載入
+    bool isLoader = false;
+    if (!item || item->state.load(std::memory_order_acquire) == AssetCacheState::Failed) {
+        std::lock_guard<std::shared_mutex> lock(shard.mutex);
+        auto& slot = shard.items[key];
+        if (!slot || slot->state.load(std::memory_order_acquire) == AssetCacheState::Failed) {
+            slot = std::make_shared<AssetItem>();
+            slot->path = path;
+            slot->type = type;
+            slot->state.store(AssetCacheState::Loading, std::memory_order_relaxed);
+            isLoader = true;
+        }
+        item = slot;
+    }
+
+    if (isLoader) {
+        std::shared_ptr<void> data;
+        try {
+            data = loader();
+        }
+        catch (...) {
+            Publish(*item, nullptr);
+            throw;
+        }
+        Publish(*item, data);
+        return data;
+    }
+
+    // 其他執行緒正在載入，等待同一份結果
+    {
+        std::unique_lock<std::mutex> lock(item->loadMutex);
+        item->loadDone.wait(lock, [&item] {
+            return item->state.load(std::memory_order_acquire) != AssetCacheState::Loading;
+        });
+    }
+    if (item->state.load(std::memory_order_acquire) != AssetCacheState::Loaded) {
+        return nullptr;
+    }
+    Touch(*item);
+    return item->data;
+}
+
+void AssetCache::Store(const std::string& key, const std::string& path,
+                       uint8_t type, std::shared_ptr<void> data) {
+    auto item = std::make_shared<AssetItem>();
+    item->path = path;
+    item->type = type;
+    Publish(*item, std::move(data));
+
+    const HashedKey hashed(key);
+    Shard& shard = ShardFor(hashed);
+    std::lock_guard<std::shared_mutex> lock(shard.mutex);
+    shard.items[key] = std::move(item);
+}
+
+bool AssetCache::Erase(const std::string& key) {
+    const HashedKey hashed(key);
+    Shard& shard = ShardFor(hashed);
+    std::lock_guard<std::shared_mutex> lock(shard.mutex);
+    return shard.items.erase(key) > 0;
+}
+
+size_t AssetCache::EraseIf(const Predicate& pred) {
+    size_t erased = 0;
+    for (auto& shard : shards_) {
+        std::lock_guard<std::shared_mutex> lock(shard.mutex);
+        for (auto it = shard.items.begin(); it != shard.items.end();) {
+            const AssetItem& item = *it->second;
+            if (item.state.load(std::memory_order_acquire) != AssetCacheState::Loading && pred(item)) {
+                it = shard.items.erase(it);
+                ++erased;
+            } else {
+                ++it;
+            }
+        }
+    }
+    return erased;
+}
+
+size_t AssetCache::EraseUnreferenced(const Predicate& pred, const RefCounter& internalRefs) {
+    // 依固定順序鎖住所有 shard；其他路徑一次只持有一個 shard 的鎖，不會死結
+    std::array<std::unique_lock<std::shared_mutex>, kShardCount> locks;
+    for (size_t i = 0; i < kShardCount; ++i) {
+        locks[i] = std::unique_lock<std::shared_mutex>(shards_[i].mutex);
+    }
+
+    // 內容去重與 LoadAllModels 可能讓多個鍵共用同一份資料
+    std::unordered_map<const void*, long> cacheOwners;
+    for (const auto& shard : shards_) {
+        for (const auto& [key, item] : shard.items) {
+            if (item->data) {
+                ++cacheOwners[item->data.get()];
+            }
+        }
+    }
+
+    size_t erased = 0;
+    for (auto& shard : shards_) {
+        for (auto it = shard.items.begin(); it != shard.items.end();) {
+            const AssetItem& item = *it->second;
+            bool unused = false;
+            if (item.state.load(std::memory_order_acquire) != AssetCacheState::Loading && pred(item)) {
+                long owners = item.data ? cacheOwners[item.data.get()] : 0;
+                if (item.data && internalRefs) {
+                    owners += internalRefs(item);
+                }
+                unused = !item.data || item.data.use_count() <= owners;
+            }
+            if (unused) {
+                // 同一份資料的其他鍵稍後比對時，已移除的這一份不再算在快取內
+                if (item.data) {
+                    --cacheOwners[item.data.get()];
+                }
+                it = shard.items.erase(it);
+                ++erased;
+            } else {
+                ++it;
+            }
+        }
+    }
+    return erased;
+}
+
+void AssetCache::Clear() {
+    for (auto& shard : shards_) {
+        std::lock_guard<std::shared_mutex> lock(shard.mutex);
+        shard.items.clear();
+    }
+}
+
+size_t AssetCache::Size() const {
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        total += shard.items.size();
+    }
+    return total;
+}
+
+void AssetCache::ForEach(const Visitor& visitor) const {
+    for (const auto& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        for (const auto& [key, item] : shard.items) {
+            visitor(key, *item);
+        }
+    }
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+// 項目的載入狀態；快取只用這三種狀態，不依賴介面標頭的 AssetLoadState
+enum class AssetCacheState : uint8_t {
+    Loading,
+    Loaded,
+    Failed,
+};
+
+// 資產項目 - 內部使用
+// data 在 state 變為 Loaded 之前寫入，之後不再變動；重載時以新項目取代整個項目。
+// lastAccessed 為 atomic，命中時只需持有 shard 的共享鎖即可更新。
+// 是否仍被使用由 data 的 shared_ptr 引用數決定（見 AssetCache::EraseUnreferenced），不另外計數。
+struct AssetItem {
+    std::string path;
+    uint8_t type = 0;   // 呼叫端的資產分類（AssetManager 存放 AssetType），快取不解讀
+    std::atomic<AssetCacheState> state{ AssetCacheState::Loading };
+    std::shared_ptr<void> data;
+    std::atomic<std::chrono::steady_clock::rep> lastAccessed{ 0 };
+
+    // 單次載入保護：同一鍵只有一個執行緒執行載入，其餘請求者在此等待
+    std::mutex loadMutex;
+    std::condition_variable loadDone;
+
+    // stamp 為快取時鐘的值；同一影格內重複命中只讀不寫，不會反覆弄髒項目所在的快取行
+    void Touch(std::chrono::steady_clock::rep stamp) noexcept;
+    std::chrono::steady_clock::time_point LastAccessed() const noexcept;
+};
+
+// 以雜湊分片的資產快取
+// - 命中路徑：shard 共享鎖 + atomic 讀取，不取得任何獨佔鎖
+// - 未命中：同鍵的並行請求只會執行一次 loader，其他請求者等待同一份結果
+class AssetCache {
+public:
+    using LoadFunc = std::function<std::shared_ptr<void>()>;
+    using Visitor = std::function<void(const std::string&, const AssetItem&)>;
+    using Predicate = std::function<bool(const AssetItem&)>;
+
+    static constexpr size_t kShardCount = 16;
+
+    AssetCache();
+
+    // 存取時間以影格為粒度：命中時寫入的是最後一次 AdvanceClock 的時間，而不是每次都讀系統時鐘
+    // 由呼叫端在影格邊界呼叫；從未推進時所有項目的存取時間都停在建構時
+    void AdvanceClock(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) noexcept;
+    std::chrono::steady_clock::time_point Clock() const noexcept;
+
+    // 取得已載入的資料；未載入或載入中回傳 nullptr
+    std::shared_ptr<void> Find(const std::string& key) const;
+
+    // 同 Find，但不更新存取時間（內部維護用）
+    std::shared_ptr<void> Peek(const std::string& key) const;
+
+    // 檢查鍵值是否已載入完成
+    bool IsLoaded(const std::string& key) const;
+
+    // 取得或載入；loader 回傳 nullptr 或拋出例外時標記為 Failed，下次請求會重試
+    std::shared_ptr<void> GetOrLoad(const std::string& key, const std::string& path,
+                                    uint8_t type, const LoadFunc& loader);
+
+    // 直接寫入已載入的資料，取代既有項目
+    void Store(const std::string& key, const std::string& path,
+               uint8_t type, std::shared_ptr<void> data);
+
+    bool Erase(const std::string& key);
+    size_t EraseIf(const Predicate& pred);
+
+    // 移除符合 pred 且沒有外部持有者的項目，回傳移除數量
+    // 外部持有者 = data.use_count() 扣掉快取內共用同一份資料的項目數，再扣掉 internalRefs 回傳的其他內部持有者
+    // （例如 TextureCache 也持有同一張貼圖）。執行期間持有所有 shard 的獨佔鎖，計數不會被並行的命中改變
+    using RefCounter = std::function<long(const AssetItem&)>;
+    size_t EraseUnreferenced(const Predicate& pred, const RefCounter& internalRefs = {});
+    void Clear();
+
+    size_t Size() const;
+    void ForEach(const Visitor& visitor) const;
+
+private:
+    // 鍵值與其雜湊：選 shard 與查 map 共用同一次雜湊計算（unordered_map 的異質查詢）
+    struct HashedKey {
+        const std::string& key;
+        size_t hash;
+
+        explicit HashedKey(const std::string& k) noexcept : key(k), hash(std::hash<std::string>{}(k)) {}
+    };
+    struct KeyHash {
+        using is_transparent = void;
+        size_t operator()(const std::string& key) const noexcept { return std::hash<std::string>{}(key); }
+        size_t operator()(const HashedKey& key) const noexcept { return key.hash; }
+    };
+    struct KeyEqual {
+        using is_transparent = void;
+        bool operator()(const std::string& a, const std::string& b) const noexcept { return a == b; }
+        bool operator()(const HashedKey& a, const std::string& b) const noexcept { return a.key == b; }
+        bool operator()(const std::string& a, const HashedKey& b) const noexcept { return a == b.key; }
+    };
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string, std::shared_ptr<AssetItem>, KeyHash, KeyEqual> items;
+    };
+
+    static size_t ShardIndex(size_t hash) noexcept;
+    void Publish(AssetItem& item, std::shared_ptr<void> data) const;
+    void Touch(AssetItem& item) const noexcept { item.Touch(clock_.load(std::memory_order_relaxed)); }
+
+    Shard& ShardFor(const HashedKey& key) { return shards_[ShardIndex(key.hash)]; }
+    const Shard& ShardFor(const HashedKey& key) const { return shards_[ShardIndex(key.hash)]; }
+
+    std::array<Shard, kShardCount> shards_;
+    // 只在影格邊界寫入，命中路徑只讀；獨佔一條快取行，不與 shard 的鎖互相干擾
+    alignas(64) std::atomic<std::chrono::steady_clock::rep> clock_;
+};
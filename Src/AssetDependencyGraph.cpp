@@ -0,0 +1,269 @@
+#include "AssetDependencyGraph.h"
+#include "ModelMetadata.h"
+#include "json.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <unordered_set>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+void AssetDependencyGraph::UnlinkLocked(const std::string& asset) {
+    auto it = dependencies_.find(asset);
+    if (it == dependencies_.end()) {
+        return;
+    }
+    for (const auto& dep : it->second) {
+        auto& users = dependents_[dep];
+        users.erase(std::remove(users.begin(), users.end(), asset), users.end());
+    }
+    it->second.clear();
+}
+
+void AssetDependencyGraph::SetDependencies(const std::string& asset, const std::vector<std::string>& dependencies) {
+    std::lock_guard<std::shared_mutex> lock(mutex_);
+    UnlinkLocked(asset);
+
+    auto& deps = dependencies_[asset];
+    for (const auto& dep : dependencies) {
+        if (dep == asset || std::find(deps.begin(), deps.end(), dep) != deps.end()) {
+            continue;
+        }
+        deps.push_back(dep);
+        dependents_[dep].push_back(asset);
+        dependencies_.try_emplace(dep);
+    }
+}
+
+void AssetDependencyGraph::AddDependency(const std::string& asset, const std::string& dependency) {
+    std::lock_guard<std::shared_mutex> lock(mutex_);
+    auto& deps = dependencies_[asset];
+    if (dependency == asset || std::find(deps.begin(), deps.end(), dependency) != deps.end()) {
+        return;
+    }
+    deps.push_back(dependency);
+    dependents_[dependency].push_back(asset);
+    dependencies_.try_emplace(dependency);
+}
+
+void AssetDependencyGraph::RemoveAsset(const std::string& asset) {
+    std::lock_guard<std::shared_mutex> lock(mutex_);
+    UnlinkLocked(asset);
+
+    // 仍被其他資產引用時保留節點，只移除它自己的相依邊
+    auto users = dependents_.find(asset);
+    if (users == dependents_.end() || users->second.empty()) {
+        dependencies_.erase(asset);
+        dependents_.erase(asset);
+    }
+}
+
+void AssetDependencyGraph::Clear() {
+    std::lock_guard<std::shared_mutex> lock(mutex_);
+    dependencies_.clear();
+    dependents_.clear();
+}
+
+bool AssetDependencyGraph::HasAsset(const std::string& asset) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return dependencies_.count(asset) > 0;
+}
+
+std::vector<std::string> AssetDependencyGraph::GetDependencies(const std::string& asset) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = dependencies_.find(asset);
+    return it != dependencies_.end() ? it->second : std::vector<std::string>{};
+}
+
+std::vector<std::string> AssetDependencyGraph::GetDependents(const std::string& asset) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = dependents_.find(asset);
+    return it != dependents_.end() ? it->second : std::vector<std::string>{};
+}
+
+std::vector<std::vector<std::string>> AssetDependencyGraph::GetLoadLevels(const std::string& root) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    // 節點層級 = 1 + 所有相依項目的最大層級；以迭代 DFS 計算，避免深層遞迴
+    std::unordered_map<std::string, int> level;
+    std::unordered_set<std::string> onStack;
+    std::vector<std::pair<std::string, size_t>> stack;
+    stack.emplace_back(root, 0);
+    onStack.insert(root);
+
+    while (!stack.empty()) {
+        auto& [node, next] = stack.back();
+        auto it = dependencies_.find(node);
+        const std::vector<std::string>* deps = it != dependencies_.end() ? &it->second : nullptr;
+
+        if (deps && next < deps->size()) {
+            const std::string& dep = (*deps)[next++];
+            if (!level.count(dep) && !onStack.count(dep)) {
+                onStack.insert(dep);
+                stack.emplace_back(dep, 0);
+            }
+            continue;
+        }
+
+        int nodeLevel = 0;
+        if (deps) {
+            for (const auto& dep : *deps) {
+                auto lv = level.find(dep);
+                if (lv != level.end()) {
+                    nodeLevel = std::max(nodeLevel, lv->second + 1);
+                }
+            }
+        }
+        level[node] = nodeLevel;
+        onStack.erase(node);
+        stack.pop_back();
+    }
+
+    std::vector<std::vector<std::string>> levels;
+    for (const auto& [node, lv] : level) {
+        if (levels.size() <= static_cast<size_t>(lv)) {
+            levels.resize(lv + 1);
+        }
+        levels[lv].push_back(node);
+    }
+    for (auto& group : levels) {
+        std::sort(group.begin(), group.end());
+    }
+    return levels;
+}
+
+std::vector<std::string> AssetDependencyGraph::FindSharedAssets() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::vector<std::string> result;
+    for (const auto& [asset, users] : dependents_) {
+        if (users.size() > 1) {
+            result.push_back(asset);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::vector<std::string> AssetDependencyGraph::FindOrphanedAssets(
+    const std::function<bool(const std::string&)>& isLive) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::vector<std::string> result;
+    for (const auto& [asset, users] : dependents_) {
+        if (users.empty()) {
+            continue;   // 根節點，不是孤兒
+        }
+        bool referenced = std::any_of(users.begin(), users.end(), isLive);
+        if (!referenced && isLive(asset)) {
+            result.push_back(asset);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::string ResolveDependencyPath(const fs::path& ownerFile, const std::string& reference) {
+    fs::path ref(reference);
+    std::error_code ec;
+
+    if (ref.is_absolute() && fs::exists(ref, ec)) {
+        return ref.lexically_normal().string();
+    }
+
+    fs::path besideOwner = ownerFile.parent_path() / ref;
+    if (fs::exists(besideOwner, ec)) {
+        return besideOwner.lexically_normal().string();
+    }
+    if (fs::exists(ref, ec)) {
+        return ref.lexically_normal().string();
+    }
+    besideOwner = ownerFile.parent_path() / ref.filename();
+    if (fs::exists(besideOwner, ec)) {
+        return besideOwner.lexically_normal().string();
+    }
+
+    return (ownerFile.parent_path() / ref).lexically_normal().string();
+}
+
+namespace {
+
+void CollectGltfUris(const json& doc, const fs::path& file, std::vector<std::string>& out) {
+    for (const char* section : { "images", "buffers" }) {
+        auto it = doc.find(section);
+        if (it == doc.end() || !it->is_array()) {
+            continue;
+        }
+        for (const auto& entry : *it) {
+            auto uri = entry.find("uri");
+            if (uri == entry.end() || !uri->is_string()) {
+                continue;
+            }
+            const std::string& value = uri->get_ref<const std::string&>();
+            if (value.rfind("data:", 0) == 0) {
+                continue;   // 內嵌資料
+            }
+            out.push_back(ResolveDependencyPath(file, value));
+        }
+    }
+}
+
+std::vector<std::string> ScanGltf(const fs::path& file) {
+    json doc = json::parse(ReadGltfJson(file), nullptr, false);
+    if (doc.is_discarded()) {
+        return {};
+    }
+
+    std::vector<std::string> result;
+    CollectGltfUris(doc, file, result);
+    return result;
+}
+
+std::vector<std::string> ScanXFile(const fs::path& file) {
+    std::ifstream in(file, std::ios::binary);
+    char header[16] = {};
+    if (!in.read(header, sizeof(header)) || std::memcmp(header, "xof ", 4) != 0 ||
+        std::memcmp(header + 8, "txt ", 4) != 0) {
+        return {};   // 二進位或壓縮格式沒有可直接搜尋的字串
+    }
+
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::vector<std::string> result;
+    const std::string token = "TextureFilename";
+    for (size_t pos = text.find(token); pos != std::string::npos; pos = text.find(token, pos + token.size())) {
+        size_t open = text.find('"', pos);
+        size_t close = open == std::string::npos ? std::string::npos : text.find('"', open + 1);
+        if (close == std::string::npos) {
+            break;
+        }
+        std::string name = text.substr(open + 1, close - open - 1);
+        // .x 檔內的路徑會以 \\ 跳脫反斜線
+        for (size_t p = name.find("\\\\"); p != std::string::npos; p = name.find("\\\\", p + 1)) {
+            name.erase(p, 1);
+        }
+        if (!name.empty()) {
+            result.push_back(ResolveDependencyPath(file, name));
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+std::vector<std::string> ScanAssetDependencies(const fs::path& file) {
+    std::string ext = file.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+    std::vector<std::string> result;
+    if (ext == ".gltf" || ext == ".glb") {
+        result = ScanGltf(file);
+    } else if (ext == ".x") {
+        result = ScanXFile(file);
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 資產相依圖：模型 -> 貼圖 -> 其他資產
+// 節點以 AssetManager 的資產鍵值（正規化完整路徑）表示
+class AssetDependencyGraph {
+public:
+    // 設定資產的直接相依項目（取代先前的紀錄）
+    void SetDependencies(const std::string& asset, const std::vector<std::string>& dependencies);
+    void AddDependency(const std::string& asset, const std::string& dependency);
+    void RemoveAsset(const std::string& asset);
+    void Clear();
+
+    bool HasAsset(const std::string& asset) const;
+    std::vector<std::string> GetDependencies(const std::string& asset) const;
+    std::vector<std::string> GetDependents(const std::string& asset) const;
+
+    // 回傳 root 的相依閉包，依層分組：第 0 層為葉節點，同層資產彼此無相依可平行處理，
+    // 各層需依序完成；root 位於最後一層。循環相依會被截斷
+    std::vector<std::vector<std::string>> GetLoadLevels(const std::string& root) const;
+
+    // 被兩個以上資產引用的節點
+    std::vector<std::string> FindSharedAssets() const;
+
+    // 只作為相依項目存在、且所有引用者都已不在 isLive 中的節點
+    std::vector<std::string> FindOrphanedAssets(const std::function<bool(const std::string&)>& isLive) const;
+
+private:
+    void UnlinkLocked(const std::string& asset);
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, std::vector<std::string>> dependencies_;
+    std::unordered_map<std::string, std::vector<std::string>> dependents_;
+};
+
+// 以輕量方式掃描模型檔引用的外部資產（不建立裝置資源）
+// - glTF/GLB：讀取 JSON 的 images[].uri 與 buffers[].uri（略過 data: URI）
+// - 文字格式 .x：收集 TextureFilename 區塊
+// 其他格式回傳空列表，由載入完成後的材質資訊補上
+std::vector<std::string> ScanAssetDependencies(const std::filesystem::path& file);
+
+// 依載入器相同的搜尋順序解析相依檔案路徑：絕對路徑、模型所在目錄、目前目錄
+std::string ResolveDependencyPath(const std::filesystem::path& ownerFile, const std::string& reference);
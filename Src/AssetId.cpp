@@ -0,0 +1,73 @@
+#include "AssetId.h"
+#include <mutex>
+#include <stdexcept>
+
+AssetPathInterner& AssetPathInterner::Instance() {
+  static AssetPathInterner instance;
+  return instance;
+}
+
+AssetPathInterner::AssetPathInterner() {
+  for (auto& page : pages_) {
+    page.store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+std::string AssetPathInterner::Normalize(const std::filesystem::path& path) {
+  return path.lexically_normal().string();
+}
+
+AssetId AssetPathInterner::Intern(const std::filesystem::path& path) {
+  std::string key = Normalize(path);
+  if (key.empty()) {
+    return kInvalidAssetId;
+  }
+
+  {
+    std::shared_lock lock{ mutex_ };
+    auto it = ids_.find(key);
+    if (it != ids_.end()) {
+      return it->second;
+    }
+  }
+
+  std::scoped_lock lock{ mutex_ };
+  auto it = ids_.find(key);
+  if (it != ids_.end()) {
+    return it->second;
+  }
+
+  uint32_t index = count_.load(std::memory_order_relaxed);
+  if ((index >> kPageBits) >= kMaxPages) {
+    throw std::length_error("AssetPathInterner: 超出可用的 AssetId 數量");
+  }
+  Page* page = pages_[index >> kPageBits].load(std::memory_order_relaxed);
+  if (!page) {
+    ownedPages_.push_back(std::make_unique<Page>());
+    page = ownedPages_.back().get();
+    pages_[index >> kPageBits].store(page, std::memory_order_release);
+  }
+  page->paths[index & (kPageSize - 1)] = key;
+
+  AssetId id = index + 1;
+  ids_.emplace(std::move(key), id);
+  count_.store(index + 1, std::memory_order_release);
+  return id;
+}
+
+AssetId AssetPathInterner::Find(const std::filesystem::path& path) const {
+  std::string key = Normalize(path);
+  std::shared_lock lock{ mutex_ };
+  auto it = ids_.find(key);
+  return it != ids_.end() ? it->second : kInvalidAssetId;
+}
+
+const std::string& AssetPathInterner::GetPath(AssetId id) const noexcept {
+  static const std::string empty;
+  if (id == kInvalidAssetId || id > count_.load(std::memory_order_acquire)) {
+    return empty;
+  }
+  uint32_t index = id - 1;
+  const Page* page = pages_[index >> kPageBits].load(std::memory_order_acquire);
+  return page ? page->paths[index & (kPageSize - 1)] : empty;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 32 位元資產 ID：由路徑字串 intern 而來，同一正規化路徑永遠得到同一個 ID
+using AssetId = uint32_t;
+constexpr AssetId kInvalidAssetId = 0;
+
+// 全域路徑 interner
+// Intern 需要雜湊與鎖，應在建立資源或 UI 元件時呼叫一次；
+// GetPath 只做陣列讀取，不取鎖，可在每幀路徑上使用
+class AssetPathInterner {
+public:
+  static AssetPathInterner& Instance();
+
+  // 正規化路徑（與 AssetManager 的資產鍵值相同）並回傳其 ID
+  AssetId Intern(const std::filesystem::path& path);
+
+  // 查詢已 intern 的路徑；不存在時回傳 kInvalidAssetId
+  AssetId Find(const std::filesystem::path& path) const;
+
+  // 取得 ID 對應的正規化路徑；無效 ID 回傳空字串
+  const std::string& GetPath(AssetId id) const noexcept;
+
+  size_t Size() const noexcept { return count_.load(std::memory_order_acquire); }
+
+  static std::string Normalize(const std::filesystem::path& path);
+
+private:
+  AssetPathInterner();
+
+  static constexpr uint32_t kPageBits = 10;
+  static constexpr uint32_t kPageSize = 1u << kPageBits;
+  static constexpr uint32_t kMaxPages = 4096;
+
+  struct Page {
+    std::string paths[kPageSize];
+  };
+
+  mutable std::shared_mutex mutex_;
+  std::unordered_map<std::string, AssetId> ids_;
+  std::array<std::atomic<Page*>, kMaxPages> pages_;
+  std::vector<std::unique_ptr<Page>> ownedPages_;
+  std::atomic<uint32_t> count_{ 0 };
+};
@@ -9,12 +9,62 @@
 #include "GltfLoader.h"
 #include "GltfModelLoader.h"
 #include "ModelData.h"
+#include "ContentHash.h"
+#include "ModelTextureSource.h"
+#include "ParallelFor.h"
 #include <d3dx9.h>
 #include <algorithm>
 #include <filesystem>
+#include <fstream>
 
 namespace fs = std::filesystem;
 
+namespace {
+
+// 讀過整個檔案讓作業系統快取暖機，之後裝置執行緒上的載入不必等待磁碟
+void WarmFileCache(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::vector<char> chunk(1024 * 1024);
+    while (in.read(chunk.data(), static_cast<std::streamsize>(chunk.size())) || in.gcount() > 0) {
+    }
+}
+
+// AssetCache 不依賴介面標頭，資產類型以 uint8_t 存放
+constexpr uint8_t CacheType(AssetType type) noexcept {
+    return static_cast<uint8_t>(type);
+}
+
+AssetType ItemType(const AssetItem& item) noexcept {
+    return static_cast<AssetType>(item.type);
+}
+
+// Prefetch 第一階段同時讀檔的執行緒數
+constexpr size_t kPrefetchReadWorkers = 4;
+
+// 目前執行緒正在匯入的模型檔：載入器經由 ModelTextureSource 要求貼圖時，以它解析相對路徑並記錄相依
+thread_local const std::string* t_importingModel = nullptr;
+
+class ImportScope {
+public:
+    explicit ImportScope(const std::string& fullPath) noexcept : previous_(t_importingModel) {
+        t_importingModel = &fullPath;
+    }
+    ~ImportScope() { t_importingModel = previous_; }
+    ImportScope(const ImportScope&) = delete;
+    ImportScope& operator=(const ImportScope&) = delete;
+
+private:
+    const std::string* previous_;
+};
+
+bool IsMultiModelFormat(const std::string& path) {
+    std::string ext = fs::path(path).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    return ext == ".gltf" || ext == ".glb";
+}
+
+} // namespace
+
 // Factory 函式實作
 std::unique_ptr<IAssetManager> CreateAssetManager() {
     return std::make_unique<AssetManager>();
@@ -24,7 +74,6 @@ AssetManager::AssetManager()
     : device_(nullptr)
     , assetRoot_("./")
     , hotReloadEnabled_(false)
-    , stopFileWatcher_(false)
     , totalMemoryUsage_(0)
     , loadOperations_(0)
     , maxCacheSize_(100)
@@ -40,9 +89,16 @@ AssetManager::AssetManager()
 
 AssetManager::~AssetManager() {
     StopFileWatcher();
+    if (device_) {
+        UnregisterModelTextureSource(device_);
+    }
     UnloadAll();
 }
 
+void AssetManager::SetTextureCache(std::shared_ptr<TextureCache> cache) {
+    textureCache_ = std::move(cache);
+}
+
 bool AssetManager::Initialize(IDirect3DDevice9* device) {
     if (!device) {
         std::cerr << "AssetManager::Initialize: Invalid device" << std::endl;
@@ -52,7 +108,8 @@ bool AssetManager::Initialize(IDirect3DDevice9* device) {
     device_ = device;
     
     // 初始化子系統
-    textureManager_ = CreateTextureManager(device);
+    textureManager_ = textureCache_ ? CreateTextureManager(device, textureCache_, TextureCategory::Model)
+                                    : CreateTextureManager(device);
     if (!textureManager_) {
         std::cerr << "AssetManager: Failed to create TextureManager" << std::endl;
         return false;
@@ -64,11 +121,16 @@ bool AssetManager::Initialize(IDirect3DDevice9* device) {
         return false;
     }
     
+    // 模型載入器的材質貼圖改由資產快取與 TextureManager 提供，Prefetch 載入的貼圖不會再被讀一次
+    RegisterModelTextureSource(device, [this](const fs::path& reference) {
+        return AcquireModelTexture(reference);
+    });
+    
     return true;
 }
 
 void AssetManager::SetAssetRoot(const std::string& rootPath) {
-    std::lock_guard<std::shared_mutex> lock(assetMutex_);
+    std::lock_guard<std::shared_mutex> lock(pathMutex_);
     assetRoot_ = rootPath;
     
     // 確保路徑以 / 結尾
@@ -79,7 +141,7 @@ void AssetManager::SetAssetRoot(const std::string& rootPath) {
 }
 
 void AssetManager::SetAssetPath(AssetType type, const std::string& relativePath) {
-    std::lock_guard<std::shared_mutex> lock(assetMutex_);
+    std::lock_guard<std::shared_mutex> lock(pathMutex_);
     assetPaths_[type] = relativePath;
     
     // 確保路徑以 / 結尾
@@ -91,7 +153,7 @@ void AssetManager::SetAssetPath(AssetType type, const std::string& relativePath)
 }
 
 std::string AssetManager::ResolveAssetPath(const std::string& assetPath, AssetType type) const {
-    std::shared_lock<std::shared_mutex> lock(assetMutex_);
+    std::shared_lock<std::shared_mutex> lock(pathMutex_);
     
     // 如果是絕對路徑，直接使用
     if (fs::path(assetPath).is_absolute()) {
@@ -115,7 +177,7 @@ AssetType AssetManager::DetectAssetType(const std::string& assetPath) const {
     std::string ext = fs::path(assetPath).extension().string();
     std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
     
-    if (ext == ".x" || ext == ".fbx" || ext == ".gltf") {
+    if (ext == ".x" || ext == ".fbx" || ext == ".gltf" || ext == ".glb") {
         return AssetType::Model;
     } else if (ext == ".bmp" || ext == ".jpg" || ext == ".jpeg" || 
                ext == ".png" || ext == ".dds" || ext == ".tga") {
@@ -130,77 +192,115 @@ AssetType AssetManager::DetectAssetType(const std::string& assetPath) const {
 }
 
 std::string AssetManager::GenerateAssetKey(const std::string& assetPath) const {
-    // 使用正規化的路徑作為鍵值
-    return fs::path(assetPath).lexically_normal().string();
+    // 與 AssetPathInterner 及 TextureManager 的快取鍵使用同一個正規化
+    return AssetPathInterner::Normalize(assetPath);
 }
 
-std::shared_ptr<ModelData> AssetManager::LoadModelImpl(const std::string& fullPath) {
-    std::string key = GenerateAssetKey(fullPath);
+std::map<std::string, ModelData> AssetManager::ImportModels(const std::string& fullPath, bool separateObjects) {
+    // 根據檔案副檔名選擇適當的載入器
+    fs::path filePath(fullPath);
+    std::string extension = filePath.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
     
-    // 檢查快取
-    {
-        std::shared_lock<std::shared_mutex> lock(assetMutex_);
-        auto it = assets_.find(key);
-        if (it != assets_.end() && it->second.state == AssetLoadState::Loaded) {
-            UpdateAssetAccess(key);
-            return std::static_pointer_cast<ModelData>(it->second.data);
+    // Use unified IModelLoader interface for all formats
+    std::unique_ptr<IModelLoader> loader;
+    if (extension == ".x") {
+        // Use enhanced loader for .x files to get proper separation
+        if (separateObjects) {
+            loader = std::make_unique<XModelEnhancedLoader>();
+        } else {
+            loader = std::make_unique<XModelLoader>();
         }
+    } else if (extension == ".fbx") {
+        loader = std::make_unique<FbxLoader>();
+    } else if (separateObjects && (extension == ".gltf" || extension == ".glb")) {
+        loader = std::make_unique<GltfModelLoader>();
+    } else {
+        std::cerr << "Unsupported model format: " << extension << std::endl;
+        return {};
     }
     
-    // 載入模型
+    ImportScope scope(fullPath);
+    return loader->Load(filePath, device_);
+}
+
+std::shared_ptr<ModelData> AssetManager::LoadModelFromFile(const std::string& fullPath, bool allowShared) {
     try {
-        // 根據檔案副檔名選擇適當的載入器
-        fs::path filePath(fullPath);
-        std::string extension = filePath.extension().string();
-        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        // 內容定址：內容相同的檔案直接共用已載入的模型，不重新匯入
+        const uint64_t fileHash = HashFile(fullPath);
+        const uint64_t contentKey = HashBytes(&fileHash, sizeof(fileHash), 1);
+        if (allowShared && fileHash != 0) {
+            std::shared_ptr<ModelData> shared;
+            std::string source;
+            {
+                std::lock_guard<std::mutex> lock(contentMutex_);
+                auto it = modelsByContent_.find(contentKey);
+                if (it != modelsByContent_.end()) {
+                    shared = it->second.model.lock();
+                    source = it->second.source;
+                }
+            }
+            // 雜湊相同不代表內容相同：大小與位元組都相同才共用
+            if (shared && SameFileContent(source, fullPath)) {
+                std::lock_guard<std::mutex> lock(contentMutex_);
+                modelDuplicates_++;
+                modelBytesSaved_ += EstimateModelBytes(*shared);
+                return shared;
+            }
+        }
         
-        std::unique_ptr<IModelLoader> loader;
-        if (extension == ".fbx") {
-            loader = std::make_unique<FbxLoader>();
-        } else if (extension == ".x") {
-            loader = std::make_unique<XModelLoader>();
-        } else {
-            std::cerr << "Unsupported model format: " << extension << std::endl;
+        auto models = ImportModels(fullPath, false);
+        if (models.empty()) {
             return nullptr;
         }
         
-        // 直接使用載入器載入模型
-        auto models = loader->Load(filePath, device_);
-        
-        if (!models.empty()) {
-            // 取得第一個模型
-            auto modelData = std::make_shared<ModelData>(std::move(models.begin()->second));
-            
-            // 加入快取
-            {
-                std::lock_guard<std::shared_mutex> lock(assetMutex_);
-                AssetItem& item = assets_[key];
-                item.path = fullPath;
-                item.type = AssetType::Model;
-                item.state = AssetLoadState::Loaded;
-                item.data = modelData;
-                item.refCount = 1;
-                item.lastAccessed = std::chrono::steady_clock::now();
-            }
-            
-            loadOperations_++;
-            return modelData;
+        // 取得第一個模型
+        loadOperations_++;
+        auto model = std::make_shared<ModelData>(std::move(models.begin()->second));
+        if (fileHash != 0) {
+            std::lock_guard<std::mutex> lock(contentMutex_);
+            modelsByContent_[contentKey] = { fullPath, model };
         }
+        return model;
     }
     catch (const std::exception& e) {
         std::cerr << "Failed to load model " << fullPath << ": " << e.what() << std::endl;
-        
-        // 標記為載入失敗
-        {
-            std::lock_guard<std::shared_mutex> lock(assetMutex_);
-            AssetItem& item = assets_[key];
-            item.path = fullPath;
-            item.type = AssetType::Model;
-            item.state = AssetLoadState::Failed;
+        return nullptr;
+    }
+}
+
+std::shared_ptr<IDirect3DTexture9> AssetManager::LoadTextureFromFile(const std::string& fullPath) {
+    try {
+        std::filesystem::path fsPath(fullPath);
+        // 有新的烘焙 DDS 時只先上傳 mip 尾端，之後依 ReportTextureUsage 補上；否則 LoadStreamed 等同 Load
+        auto* texMgr = dynamic_cast<TextureManager*>(textureManager_.get());
+        auto texture = texMgr ? texMgr->LoadStreamed(fsPath) : textureManager_->Load(fsPath);
+        if (texture) {
+            loadOperations_++;
         }
+        return std::static_pointer_cast<IDirect3DTexture9>(texture);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Failed to load texture " << fullPath << ": " << e.what() << std::endl;
+        return nullptr;
     }
+}
+
+std::shared_ptr<ModelData> AssetManager::LoadModelImpl(const std::string& fullPath) {
+    std::string key = GenerateAssetKey(fullPath);
     
-    return nullptr;
+    // 快取命中只取 shard 共享鎖；未命中時同鍵只會載入一次
+    // loader 回傳 nullptr 會將項目標記為載入失敗
+    auto data = assets_.GetOrLoad(key, fullPath, CacheType(AssetType::Model), [&]() -> std::shared_ptr<void> {
+        auto model = LoadModelFromFile(fullPath);
+        if (model) {
+            RecordModelDependencies(fullPath, { model.get() });
+            WatchFile(fullPath);
+        }
+        return model;
+    });
+    
+    return std::static_pointer_cast<ModelData>(data);
 }
 
 std::vector<std::shared_ptr<ModelData>> AssetManager::LoadAllModelsImpl(const std::string& fullPath) {
@@ -208,49 +308,72 @@ std::vector<std::shared_ptr<ModelData>> AssetManager::LoadAllModelsImpl(const st
     std::string baseKey = GenerateAssetKey(fullPath);
     
     try {
-        // 根據檔案副檔名選擇適當的載入器
-        fs::path filePath(fullPath);
-        std::string extension = filePath.extension().string();
-        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
-        
-        // Use unified IModelLoader interface for all formats
-        std::unique_ptr<IModelLoader> loader;
-        
-        if (extension == ".x") {
-            // Use enhanced loader for .x files to get proper separation
-            loader = std::make_unique<XModelEnhancedLoader>();
-        } else if (extension == ".fbx") {
-            loader = std::make_unique<FbxLoader>();
-        } else if (extension == ".gltf" || extension == ".glb") {
-            loader = std::make_unique<GltfModelLoader>();
-        } else {
-            std::cerr << "Unsupported model format: " << extension << std::endl;
-            return result;
+        // 內容定址：內容相同的檔案直接共用整組已載入的模型
+        const uint64_t fileHash = HashFile(fullPath);
+        const uint64_t contentKey = HashBytes(&fileHash, sizeof(fileHash), 2);
+        if (fileHash != 0) {
+            std::vector<std::pair<std::string, std::shared_ptr<ModelData>>> shared;
+            std::string source;
+            {
+                std::lock_guard<std::mutex> lock(contentMutex_);
+                auto it = modelSetsByContent_.find(contentKey);
+                if (it != modelSetsByContent_.end()) {
+                    source = it->second.source;
+                    for (const auto& [modelName, weak] : it->second.models) {
+                        auto model = weak.lock();
+                        if (!model) {
+                            shared.clear();
+                            break;
+                        }
+                        shared.emplace_back(modelName, std::move(model));
+                    }
+                }
+            }
+            // 雜湊相同不代表內容相同：大小與位元組都相同才共用
+            if (!shared.empty() && !SameFileContent(source, fullPath)) {
+                shared.clear();
+            }
+            if (!shared.empty()) {
+                std::lock_guard<std::mutex> lock(contentMutex_);
+                modelDuplicates_ += shared.size();
+                for (const auto& entry : shared) {
+                    modelBytesSaved_ += EstimateModelBytes(*entry.second);
+                }
+            }
+            
+            if (!shared.empty()) {
+                for (auto& [modelName, model] : shared) {
+                    assets_.Store(baseKey + "::" + modelName, fullPath + "::" + modelName, CacheType(AssetType::Model), model);
+                    result.push_back(std::move(model));
+                }
+                return result;
+            }
         }
         
         // Load models using the unified interface
-        auto models = loader->Load(filePath, device_);
-        
+        auto models = ImportModels(fullPath, true);
+        std::vector<const ModelData*> imported;
+        std::vector<std::pair<std::string, std::weak_ptr<ModelData>>> contentSet;
         
         for (auto& [modelName, modelData] : models) {
             auto sharedModelData = std::make_shared<ModelData>(std::move(modelData));
             result.push_back(sharedModelData);
+            imported.push_back(sharedModelData.get());
+            contentSet.emplace_back(modelName, sharedModelData);
             
             // 加入快取，使用模型名稱作為鍵值的一部分
             std::string key = baseKey + "::" + modelName;
-            {
-                std::lock_guard<std::shared_mutex> lock(assetMutex_);
-                AssetItem& item = assets_[key];
-                item.path = fullPath + "::" + modelName;
-                item.type = AssetType::Model;
-                item.state = AssetLoadState::Loaded;
-                item.data = sharedModelData;
-                item.refCount = 1;
-                item.lastAccessed = std::chrono::steady_clock::now();
-            }
-            
+            assets_.Store(key, fullPath + "::" + modelName, CacheType(AssetType::Model), sharedModelData);
         }
         
+        if (!models.empty()) {
+            RecordModelDependencies(fullPath, imported);
+            WatchFile(fullPath);
+            if (fileHash != 0) {
+                std::lock_guard<std::mutex> lock(contentMutex_);
+                modelSetsByContent_[contentKey] = { fullPath, std::move(contentSet) };
+            }
+        }
         loadOperations_++;
     }
     catch (const std::exception& e) {
@@ -264,52 +387,16 @@ std::vector<std::shared_ptr<ModelData>> AssetManager::LoadAllModelsImpl(const st
 std::shared_ptr<IDirect3DTexture9> AssetManager::LoadTextureImpl(const std::string& fullPath) {
     std::string key = GenerateAssetKey(fullPath);
     
-    // 檢查快取
-    {
-        std::shared_lock<std::shared_mutex> lock(assetMutex_);
-        auto it = assets_.find(key);
-        if (it != assets_.end() && it->second.state == AssetLoadState::Loaded) {
-            UpdateAssetAccess(key);
-            return std::static_pointer_cast<IDirect3DTexture9>(it->second.data);
-        }
-    }
-    
-    // 載入紋理
-    try {
-        std::filesystem::path fsPath(fullPath);
-        auto texture = textureManager_->Load(fsPath);
-        
+    // 快取命中只取 shard 共享鎖；未命中時同鍵只會載入一次
+    auto data = assets_.GetOrLoad(key, fullPath, CacheType(AssetType::Texture), [&]() -> std::shared_ptr<void> {
+        auto texture = LoadTextureFromFile(fullPath);
         if (texture) {
-            // 加入快取
-            {
-                std::lock_guard<std::shared_mutex> lock(assetMutex_);
-                AssetItem& item = assets_[key];
-                item.path = fullPath;
-                item.type = AssetType::Texture;
-                item.state = AssetLoadState::Loaded;
-                item.data = texture;
-                item.refCount = 1;
-                item.lastAccessed = std::chrono::steady_clock::now();
-            }
-            
-            loadOperations_++;
-            return std::static_pointer_cast<IDirect3DTexture9>(texture);
+            WatchFile(fullPath);
         }
-    }
-    catch (const std::exception& e) {
-        std::cerr << "Failed to load texture " << fullPath << ": " << e.what() << std::endl;
-        
-        // 標記為載入失敗
-        {
-            std::lock_guard<std::shared_mutex> lock(assetMutex_);
-            AssetItem& item = assets_[key];
-            item.path = fullPath;
-            item.type = AssetType::Texture;
-            item.state = AssetLoadState::Failed;
-        }
-    }
+        return texture;
+    });
     
-    return nullptr;
+    return std::static_pointer_cast<IDirect3DTexture9>(data);
 }
 
 bool AssetManager::IsLoaded(const std::string& assetPath) const {
@@ -317,20 +404,17 @@ bool AssetManager::IsLoaded(const std::string& assetPath) const {
     std::string fullPath = ResolveAssetPath(assetPath, type);
     std::string key = GenerateAssetKey(fullPath);
     
-    std::shared_lock<std::shared_mutex> lock(assetMutex_);
-    auto it = assets_.find(key);
-    return it != assets_.end() && it->second.state == AssetLoadState::Loaded;
+    return assets_.IsLoaded(key);
 }
 
 std::vector<std::string> AssetManager::GetLoadedAssets(AssetType type) const {
-    std::shared_lock<std::shared_mutex> lock(assetMutex_);
     std::vector<std::string> result;
     
-    for (const auto& pair : assets_) {
-        if (pair.second.type == type && pair.second.state == AssetLoadState::Loaded) {
-            result.push_back(pair.second.path);
+    assets_.ForEach([&](const std::string&, const AssetItem& item) {
+        if (ItemType(item) == type && item.state.load(std::memory_order_acquire) == AssetCacheState::Loaded) {
+            result.push_back(item.path);
         }
-    }
+    });
     
     return result;
 }
@@ -340,31 +424,30 @@ void AssetManager::UnloadAsset(const std::string& assetPath) {
     std::string fullPath = ResolveAssetPath(assetPath, type);
     std::string key = GenerateAssetKey(fullPath);
     
-    std::lock_guard<std::shared_mutex> lock(assetMutex_);
-    auto it = assets_.find(key);
-    if (it != assets_.end()) {
-        assets_.erase(it);
-    }
+    assets_.Erase(key);
 }
 
 void AssetManager::UnloadUnusedAssets() {
-    std::lock_guard<std::shared_mutex> lock(assetMutex_);
-    auto now = std::chrono::steady_clock::now();
-    
-    auto it = assets_.begin();
-    while (it != assets_.end()) {
-        auto timeSinceAccess = now - it->second.lastAccessed;
-        if (timeSinceAccess > unusedAssetTimeout_ && it->second.refCount == 0) {
-            it = assets_.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    // 與命中時寫入的存取時間使用同一個影格時鐘；從未推進時沒有資產會被視為閒置
+    auto now = assets_.Clock();
+    auto* texMgr = dynamic_cast<TextureManager*>(textureManager_.get());
+    
+    // 只卸載閒置且沒有快取以外持有者的資產；貼圖另有一份由共用的 TextureCache 持有
+    assets_.EraseUnreferenced(
+        [&](const AssetItem& item) {
+            return now - item.LastAccessed() > unusedAssetTimeout_;
+        },
+        [&](const AssetItem& item) -> long {
+            if (ItemType(item) != AssetType::Texture || !texMgr) {
+                return 0;
+            }
+            auto* texture = static_cast<IDirect3DTexture9*>(item.data.get());
+            return texMgr->Cache()->IsResident(texture) ? 1 : 0;
+        });
 }
 
 void AssetManager::UnloadAll() {
-    std::lock_guard<std::shared_mutex> lock(assetMutex_);
-    assets_.clear();
+    assets_.Clear();
     totalMemoryUsage_ = 0;
 }
 
@@ -381,16 +464,9 @@ void AssetManager::EnableHotReload(bool enable) {
 }
 
 void AssetManager::ReloadAsset(const std::string& assetPath) {
-    // 卸載現有資產
-    UnloadAsset(assetPath);
-    
-    // 重新載入
+    // 就地重新匯入：既有的 shared_ptr 持有者會看到新資料
     AssetType type = DetectAssetType(assetPath);
-    if (type == AssetType::Model) {
-        LoadModelImpl(ResolveAssetPath(assetPath, type));
-    } else if (type == AssetType::Texture) {
-        LoadTextureImpl(ResolveAssetPath(assetPath, type));
-    }
+    ReimportFile(ResolveAssetPath(assetPath, type));
 }
 
 size_t AssetManager::GetMemoryUsage() const {
@@ -398,18 +474,14 @@ size_t AssetManager::GetMemoryUsage() const {
 }
 
 size_t AssetManager::GetAssetCount() const {
-    std::shared_lock<std::shared_mutex> lock(assetMutex_);
-    return assets_.size();
+    return assets_.Size();
 }
 
 void AssetManager::PrintDebugInfo() const {
-    std::shared_lock<std::shared_mutex> lock(assetMutex_);
-    
     // AssetManager debug info removed for minimal logging
-    for (const auto& pair : assets_) {
-        const AssetItem& item = pair.second;
+    assets_.ForEach([](const std::string&, const AssetItem& item) {
         std::string typeStr;
-        switch (item.type) {
+        switch (ItemType(item)) {
             case AssetType::Model: typeStr = "Model"; break;
             case AssetType::Texture: typeStr = "Texture"; break;
             case AssetType::Sound: typeStr = "Sound"; break;
@@ -418,51 +490,535 @@ void AssetManager::PrintDebugInfo() const {
         }
         
         std::string stateStr;
-        switch (item.state) {
-            case AssetLoadState::NotLoaded: stateStr = "NotLoaded"; break;
-            case AssetLoadState::Loading: stateStr = "Loading"; break;
-            case AssetLoadState::Loaded: stateStr = "Loaded"; break;
-            case AssetLoadState::Failed: stateStr = "Failed"; break;
+        switch (item.state.load(std::memory_order_acquire)) {
+            case AssetCacheState::Loading: stateStr = "Loading"; break;
+            case AssetCacheState::Loaded: stateStr = "Loaded"; break;
+            case AssetCacheState::Failed: stateStr = "Failed"; break;
         }
         
+    });
+    
+    if (auto* texMgr = dynamic_cast<TextureManager*>(textureManager_.get())) {
+        std::cout << texMgr->GetCacheStats().ToString();
     }
 }
 
-void AssetManager::UpdateAssetAccess(const std::string& key) {
-    // 注意：這個方法假設調用者已經有鎖
-    auto it = assets_.find(key);
-    if (it != assets_.end()) {
-        it->second.lastAccessed = std::chrono::steady_clock::now();
-        it->second.refCount++;
+void AssetManager::StartFileWatcher() {
+    // 持有 watcherMutex_ 直到監控開始：同時完成的載入會等待，之後再加入監控，不會遺漏
+    std::lock_guard<std::mutex> watcherLock(watcherMutex_);
+    fileWatcher_ = std::make_unique<FileWatcher>();
+    
+    // 監控目前已載入的所有檔案（多模型項目的路徑為 "file::model"）
+    assets_.ForEach([this](const std::string&, const AssetItem& item) {
+        std::string path = item.path;
+        size_t sep = path.find("::");
+        if (sep != std::string::npos) {
+            path.resize(sep);
+        }
+        fileWatcher_->Watch(path);
+    });
+    
+    fileWatcher_->Start([this](const std::string& filePath) {
+        OnFileChanged(filePath);
+    });
+}
+
+void AssetManager::StopFileWatcher() {
+    std::unique_ptr<FileWatcher> watcher;
+    {
+        std::lock_guard<std::mutex> watcherLock(watcherMutex_);
+        watcher.swap(fileWatcher_);
+    }
+    // 在鎖外停止：等待監控執行緒結束時，其他執行緒的載入不必跟著等待
+    if (watcher) {
+        watcher->Stop();
+        watcher.reset();
     }
+    
+    // 等待背景剖析結束並丟棄結果（std::async 的 future 解構時會等待）
+    reloadJobs_.clear();
+    textureReloads_.clear();
+    
+    std::lock_guard<std::mutex> lock(reloadMutex_);
+    pendingReloads_.clear();
 }
 
-void AssetManager::StartFileWatcher() {
-    // 簡化實作：實際應用中可以使用 Windows API 或跨平台庫來監控檔案變化
-    // 這裡只是一個示範
-    stopFileWatcher_ = false;
-    fileWatcherThread_ = std::make_unique<std::thread>([this]() {
-        while (!stopFileWatcher_) {
-            std::this_thread::sleep_for(std::chrono::seconds(1));
-            // 在實際實作中，這裡會檢查檔案變化
+void AssetManager::WatchFile(const std::string& fullPath) {
+    std::lock_guard<std::mutex> watcherLock(watcherMutex_);
+    if (fileWatcher_) {
+        fileWatcher_->Watch(fullPath);
+    }
+}
+
+void AssetManager::OnFileChanged(const std::string& filePath) {
+    // 監控執行緒：內容已確認改變，排入佇列等待影格邊界處理
+    // D3D9 裝置並非以 D3DCREATE_MULTITHREADED 建立，緩衝區與貼圖必須在裝置執行緒上建立
+    std::lock_guard<std::mutex> lock(reloadMutex_);
+    if (std::find(pendingReloads_.begin(), pendingReloads_.end(), filePath) == pendingReloads_.end()) {
+        pendingReloads_.push_back(filePath);
+    }
+}
+
+void AssetManager::ProcessPendingReloads() {
+    assets_.AdvanceClock();
+    
+    std::vector<std::string> reloads;
+    {
+        std::lock_guard<std::mutex> lock(reloadMutex_);
+        reloads.swap(pendingReloads_);
+    }
+    
+    auto* texMgr = dynamic_cast<TextureManager*>(textureManager_.get());
+    std::vector<std::string> deferred;
+    for (const auto& fullPath : reloads) {
+        const bool busy = std::any_of(reloadJobs_.begin(), reloadJobs_.end(),
+                                      [&](const auto& job) { return job.first == fullPath; }) ||
+                          std::find(textureReloads_.begin(), textureReloads_.end(), fullPath) != textureReloads_.end();
+        if (busy) {
+            // 上一次的重載還在背景進行，完成後再處理這次變更
+            deferred.push_back(fullPath);
+            continue;
+        }
+        
+        PreparedReload request;
+        request.fullPath = fullPath;
+        AssetType singleType = AssetType::Model;
+        const std::string key = GenerateAssetKey(fullPath);
+        const std::string prefix = key + "::";
+        assets_.ForEach([&](const std::string& itemKey, const AssetItem& item) {
+            if (itemKey == key) {
+                request.hasSingle = true;
+                singleType = ItemType(item);
+            } else if (itemKey.compare(0, prefix.size(), prefix) == 0) {
+                request.hasMulti = true;
+            }
+        });
+        
+        if (request.hasSingle && singleType == AssetType::Texture) {
+            // 貼圖交給 TextureManager 的解碼 worker；不支援背景解碼的格式（例如 DDS）直接同步重載
+            if (texMgr) {
+                texMgr->Evict(fullPath);
+            }
+            if (texMgr && texMgr->Prefetch(fullPath)) {
+                textureReloads_.push_back(fullPath);
+            } else {
+                ReimportFile(fullPath);
+            }
+        } else if (request.hasSingle || request.hasMulti) {
+            reloadJobs_.emplace_back(fullPath, std::async(std::launch::async, PrepareReload, std::move(request)));
+        }
+    }
+    
+    // 背景剖析完成的模型：建立緩衝區並交換
+    for (auto it = reloadJobs_.begin(); it != reloadJobs_.end();) {
+        if (it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++it;
+            continue;
+        }
+        PreparedReload prepared = it->second.get();
+        it = reloadJobs_.erase(it);
+        ApplyReload(prepared);
+    }
+    
+    // 背景解碼完成的貼圖：上傳後以與同步重載相同的方式交換
+    if (texMgr && !textureReloads_.empty()) {
+        texMgr->PumpUploads();
+        for (auto it = textureReloads_.begin(); it != textureReloads_.end();) {
+            if (texMgr->Prefetch(*it)) {
+                ++it;   // 仍在解碼或等待上傳
+                continue;
+            }
+            // 已上傳則 Load 直接命中快取；解碼失敗時 Load 退回同步載入
+            ReplaceTexture(*it);
+            it = textureReloads_.erase(it);
+        }
+    }
+    
+    if (!deferred.empty()) {
+        std::lock_guard<std::mutex> lock(reloadMutex_);
+        for (auto& fullPath : deferred) {
+            if (std::find(pendingReloads_.begin(), pendingReloads_.end(), fullPath) == pendingReloads_.end()) {
+                pendingReloads_.push_back(std::move(fullPath));
+            }
+        }
+    }
+}
+
+void AssetManager::ReportTextureUsage(const IDirect3DBaseTexture9* texture, float screenPixels) {
+    if (!texture) {
+        return;
+    }
+    if (auto* texMgr = dynamic_cast<TextureManager*>(textureManager_.get())) {
+        texMgr->ReportTextureUsage(texture, screenPixels);
+    }
+}
+
+TextureStreamerStats AssetManager::UpdateStreaming() {
+    auto* texMgr = dynamic_cast<TextureManager*>(textureManager_.get());
+    return texMgr ? texMgr->UpdateStreaming() : TextureStreamerStats{};
+}
+
+AssetManager::PreparedReload AssetManager::PrepareReload(PreparedReload request) {
+    // worker 執行緒：不接觸裝置與快取，只使用不需裝置的載入器
+    fs::path filePath(request.fullPath);
+    std::string extension = filePath.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    
+    try {
+        if (extension == ".gltf" || extension == ".glb") {
+            // glTF 只能以 LoadAllModels 載入，沒有單一項目；與 ImportModels 同樣使用 GltfModelLoader
+            request.supported = true;
+            if (request.hasMulti) {
+                request.multi = GltfModelLoader().Load(filePath, nullptr);
+            }
+        } else {
+            // .x（XModelLoader/XModelEnhancedLoader）與 FBX 的載入器都經由裝置建立網格，這裡只先把檔案讀入
+            // 作業系統快取；影格邊界以 ImportModels 相同的載入器重新匯入，模型名稱與幾何才會與既有項目一致
+            WarmFileCache(request.fullPath);
+        }
+    }
+    catch (const std::exception& e) {
+        request.error = e.what();
+    }
+    return request;
+}
+
+void AssetManager::ApplyReload(PreparedReload& prepared) {
+    const std::string& fullPath = prepared.fullPath;
+    if (!prepared.supported) {
+        ReimportFile(fullPath);
+        return;
+    }
+    if (!prepared.error.empty()) {
+        std::cerr << "Failed to reload models from " << fullPath << ": " << prepared.error << std::endl;
+        return;
+    }
+    
+    // 裝置執行緒：只建立緩衝區與貼圖，再交換進既有的 shared_ptr<ModelData>
+    std::vector<const ModelData*> imported;
+    const std::string key = GenerateAssetKey(fullPath);
+    for (auto it = prepared.multi.begin(); it != prepared.multi.end();) {
+        if (CreateModelResources(fullPath, it->second)) {
+            imported.push_back(&it->second);
+            ++it;
+        } else {
+            it = prepared.multi.erase(it);
+        }
+    }
+    if (!imported.empty()) {
+        RecordModelDependencies(fullPath, imported);
+    }
+    
+    RemoveStaleModels(fullPath, prepared.multi);
+    for (auto& [modelName, modelData] : prepared.multi) {
+        ReplaceModel(key + "::" + modelName, fullPath + "::" + modelName, std::move(modelData));
+    }
+}
+
+bool AssetManager::CreateModelResources(const std::string& fullPath, ModelData& model) {
+    ImportScope scope(fullPath);
+    if (!model.mesh.CreateBuffers(device_)) {
+        return false;
+    }
+    // 與載入器相同，以第一個有貼圖的材質作為網格貼圖
+    auto textured = std::find_if(model.mesh.materials.begin(), model.mesh.materials.end(),
+                                 [](const Material& m) { return !m.textureFileName.empty(); });
+    if (textured != model.mesh.materials.end()) {
+        model.mesh.SetTexture(device_, ResolveDependencyPath(fullPath, textured->textureFileName));
+    }
+    return true;
+}
+
+void AssetManager::ReimportFile(const std::string& fullPath) {
+    std::string key = GenerateAssetKey(fullPath);
+    
+    // 找出引用此檔案的快取項目：單一項目 key，以及 LoadAllModels 建立的 "key::model"
+    bool hasSingle = false;
+    bool hasMulti = false;
+    AssetType singleType = AssetType::Model;
+    const std::string prefix = key + "::";
+    assets_.ForEach([&](const std::string& itemKey, const AssetItem& item) {
+        if (itemKey == key) {
+            hasSingle = true;
+            singleType = ItemType(item);
+        } else if (itemKey.compare(0, prefix.size(), prefix) == 0) {
+            hasMulti = true;
         }
     });
     
+    if (!hasSingle && !hasMulti) {
+        return;
+    }
+    
+    if (hasSingle && singleType == AssetType::Texture) {
+        // TextureManager 以路徑快取，需先移除才會真正重新讀檔
+        if (auto* texMgr = dynamic_cast<TextureManager*>(textureManager_.get())) {
+            texMgr->Evict(fullPath);
+        }
+        ReplaceTexture(fullPath);
+    } else if (hasSingle) {
+        auto fresh = LoadModelFromFile(fullPath, false);
+        if (fresh) {
+            RecordModelDependencies(fullPath, { fresh.get() });
+        }
+        auto live = std::static_pointer_cast<ModelData>(assets_.Peek(key));
+        if (fresh && live && !IsModelShared(live.get())) {
+            SwapModelData(*live, *fresh);
+        } else if (fresh) {
+            assets_.Store(key, fullPath, CacheType(AssetType::Model), fresh);
+        }
+    }
+    
+    if (hasMulti) {
+        try {
+            auto models = ImportModels(fullPath, true);
+            std::vector<const ModelData*> imported;
+            for (const auto& [modelName, modelData] : models) {
+                imported.push_back(&modelData);
+            }
+            if (!imported.empty()) {
+                RecordModelDependencies(fullPath, imported);
+            }
+            
+            RemoveStaleModels(fullPath, models);
+            for (auto& [modelName, modelData] : models) {
+                ReplaceModel(prefix + modelName, fullPath + "::" + modelName, std::move(modelData));
+            }
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Failed to reload models from " << fullPath << ": " << e.what() << std::endl;
+        }
+    }
 }
 
-void AssetManager::StopFileWatcher() {
-    if (fileWatcherThread_) {
-        stopFileWatcher_ = true;
-        if (fileWatcherThread_->joinable()) {
-            fileWatcherThread_->join();
+void AssetManager::SwapModelData(ModelData& live, ModelData& fresh) {
+    // 交換內容讓既有的 shared_ptr<ModelData> 直接看到新資料，再釋放舊的 GPU 緩衝
+    std::swap(live, fresh);
+    fresh.mesh.ReleaseBuffers();
+}
+
+void AssetManager::ReplaceTexture(const std::string& fullPath) {
+    // TextureManager 已移除舊的快取項目；背景解碼完成時 Load 直接取得已上傳的貼圖
+    const std::string key = GenerateAssetKey(fullPath);
+    auto fresh = LoadTextureFromFile(fullPath);
+    auto live = std::static_pointer_cast<IDirect3DTexture9>(assets_.Peek(key));
+    // 與其他路徑共用的貼圖不可就地覆寫，否則其他路徑也會看到新內容
+    auto* texMgr = dynamic_cast<TextureManager*>(textureManager_.get());
+    if (live && texMgr && texMgr->IsContentShared(live.get())) {
+        live.reset();
+    }
+    if (fresh && !(live && SwapTextureData(live.get(), fresh.get()))) {
+        // 格式或尺寸改變無法就地更新，改為取代快取項目
+        assets_.Store(key, fullPath, CacheType(AssetType::Texture), fresh);
+    }
+}
+
+void AssetManager::ReplaceModel(const std::string& key, const std::string& path, ModelData&& fresh) {
+    // 與其他路徑共用的模型不可就地覆寫，改為取代快取項目
+    auto live = std::static_pointer_cast<ModelData>(assets_.Peek(key));
+    if (live && !IsModelShared(live.get())) {
+        SwapModelData(*live, fresh);
+    } else {
+        assets_.Store(key, path, CacheType(AssetType::Model), std::make_shared<ModelData>(std::move(fresh)));
+    }
+}
+
+void AssetManager::RemoveStaleModels(const std::string& fullPath, const std::map<std::string, ModelData>& fresh) {
+    // 檔案中已不存在的物件：移除其 "key::model" 項目，持有者手上的 shared_ptr 仍然有效
+    // 重新匯入失敗（沒有任何模型）時保留舊項目
+    if (fresh.empty()) {
+        return;
+    }
+    const std::string prefix = GenerateAssetKey(fullPath) + "::";
+    std::vector<std::string> stale;
+    assets_.ForEach([&](const std::string& itemKey, const AssetItem&) {
+        if (itemKey.compare(0, prefix.size(), prefix) == 0 && !fresh.count(itemKey.substr(prefix.size()))) {
+            stale.push_back(itemKey);
+        }
+    });
+    for (const auto& key : stale) {
+        assets_.Erase(key);
+    }
+}
+
+bool AssetManager::SwapTextureData(IDirect3DTexture9* live, IDirect3DTexture9* fresh) {
+    if (live == fresh || live->GetLevelCount() != fresh->GetLevelCount()) {
+        return live == fresh;
+    }
+    
+    D3DSURFACE_DESC liveDesc, freshDesc;
+    if (FAILED(live->GetLevelDesc(0, &liveDesc)) || FAILED(fresh->GetLevelDesc(0, &freshDesc))) {
+        return false;
+    }
+    if (liveDesc.Width != freshDesc.Width || liveDesc.Height != freshDesc.Height ||
+        liveDesc.Format != freshDesc.Format) {
+        return false;
+    }
+    
+    // 逐層複製到既有貼圖，持有舊指標的使用者不需重新查詢
+    for (DWORD level = 0; level < live->GetLevelCount(); ++level) {
+        ComPtr<IDirect3DSurface9> dst, src;
+        if (FAILED(live->GetSurfaceLevel(level, &dst)) || FAILED(fresh->GetSurfaceLevel(level, &src))) {
+            return false;
+        }
+        if (FAILED(D3DXLoadSurfaceFromSurface(dst.Get(), nullptr, nullptr,
+                                              src.Get(), nullptr, nullptr, D3DX_FILTER_NONE, 0))) {
+            return false;
         }
-        fileWatcherThread_.reset();
     }
+    return true;
 }
 
-void AssetManager::OnFileChanged(const std::string& filePath) {
-    // 檔案變化處理
-    ReloadAsset(filePath);
+IDirect3DTexture9* AssetManager::AcquireModelTexture(const fs::path& reference) {
+    // 與相依圖相同的方式解析路徑，鍵值才會與 Prefetch 載入的貼圖一致
+    const std::string fullPath = t_importingModel ? ResolveDependencyPath(*t_importingModel, reference.string())
+                                                  : reference.string();
+    std::shared_ptr<IDirect3DTexture9> texture;
+    try {
+        texture = LoadTextureImpl(fullPath);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Failed to load model texture " << fullPath << ": " << e.what() << std::endl;
+    }
+    if (!texture || texture->GetType() != D3DRTYPE_TEXTURE) {
+        return nullptr;
+    }
+    
+    if (t_importingModel) {
+        std::lock_guard<std::mutex> lock(importMutex_);
+        emittedTextures_[GenerateAssetKey(*t_importingModel)].push_back(GenerateAssetKey(fullPath));
+    }
+    texture->AddRef();
+    return texture.get();
+}
+
+void AssetManager::RecordModelDependencies(const std::string& fullPath, const std::vector<const ModelData*>& models) {
+    // 載入器匯入時實際要求的貼圖（經由 ModelTextureSource 回報），加上材質記錄但未要求的貼圖檔名
+    const std::string key = GenerateAssetKey(fullPath);
+    std::vector<std::string> deps;
+    {
+        std::lock_guard<std::mutex> lock(importMutex_);
+        auto it = emittedTextures_.find(key);
+        if (it != emittedTextures_.end()) {
+            deps = std::move(it->second);
+            emittedTextures_.erase(it);
+        }
+    }
+    for (const ModelData* model : models) {
+        for (const auto& material : model->mesh.materials) {
+            if (!material.textureFileName.empty()) {
+                deps.push_back(ResolveDependencyPath(fullPath, material.textureFileName));
+            }
+        }
+    }
+    
+    for (auto& dep : deps) {
+        dep = GenerateAssetKey(dep);
+    }
+    std::sort(deps.begin(), deps.end());
+    deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+    dependencies_.SetDependencies(key, deps);
+}
+
+size_t AssetManager::Prefetch(const std::string& rootAsset) {
+    std::string fullPath = ResolveAssetPath(rootAsset, DetectAssetType(rootAsset));
+    std::string rootKey = GenerateAssetKey(fullPath);
+    
+    // 尚未載入過的根資產還沒有匯入器回報的相依，先以輕量掃描建立相依邊；載入後由匯入結果取代
+    if (!dependencies_.HasAsset(rootKey)) {
+        std::vector<std::string> deps = ScanAssetDependencies(fullPath);
+        for (auto& dep : deps) {
+            dep = GenerateAssetKey(dep);
+        }
+        dependencies_.SetDependencies(rootKey, deps);
+    }
+    
+    auto levels = dependencies_.GetLoadLevels(rootKey);
+    
+    // 第一階段：以有限數量的執行緒把所有檔案讀入作業系統快取
+    std::vector<std::string> files;
+    for (const auto& level : levels) {
+        files.insert(files.end(), level.begin(), level.end());
+    }
+    ParallelFor(files.size(), [&](size_t i) { WarmFileCache(files[i]); }, kPrefetchReadWorkers);
+    
+    // 第二階段：依相依順序（葉節點先）在裝置執行緒上建立資源；模型要求的貼圖經由 AcquireModelTexture 命中快取
+    size_t loaded = 0;
+    for (const auto& asset : files) {
+        bool ok = false;
+        switch (DetectAssetType(asset)) {
+            case AssetType::Model:
+                ok = IsMultiModelFormat(asset) ? !LoadAllModelsImpl(asset).empty() : LoadModelImpl(asset) != nullptr;
+                break;
+            case AssetType::Texture:
+                ok = LoadTextureImpl(asset) != nullptr;
+                break;
+            default:
+                break;   // 例如 glTF 的 .bin，已在第一階段讀入
+        }
+        loaded += ok ? 1 : 0;
+    }
+    
+    return loaded;
+}
+
+std::vector<std::string> AssetManager::GetAssetDependencies(const std::string& assetPath) const {
+    AssetType type = DetectAssetType(assetPath);
+    return dependencies_.GetDependencies(GenerateAssetKey(ResolveAssetPath(assetPath, type)));
+}
+
+std::vector<std::string> AssetManager::FindSharedAssets() const {
+    return dependencies_.FindSharedAssets();
+}
+
+std::vector<std::string> AssetManager::FindOrphanedAssets() const {
+    // 已載入、但引用它的模型都已卸載的資產
+    return dependencies_.FindOrphanedAssets([this](const std::string& key) {
+        if (assets_.IsLoaded(key)) {
+            return true;
+        }
+        // LoadAllModels 以 "key::model" 存放
+        bool anyLoaded = false;
+        const std::string prefix = key + "::";
+        assets_.ForEach([&](const std::string& itemKey, const AssetItem& item) {
+            if (!anyLoaded && itemKey.compare(0, prefix.size(), prefix) == 0 &&
+                item.state.load(std::memory_order_acquire) == AssetCacheState::Loaded) {
+                anyLoaded = true;
+            }
+        });
+        return anyLoaded;
+    });
+}
+
+bool AssetManager::IsModelShared(const ModelData* model) const {
+    size_t owners = 0;
+    assets_.ForEach([&](const std::string&, const AssetItem& item) {
+        if (item.data.get() == model) {
+            ++owners;
+        }
+    });
+    return owners > 1;
+}
+
+size_t AssetManager::EstimateModelBytes(const ModelData& model) noexcept {
+    // 頂點/索引資料：CPU 端一份 + GPU 緩衝一份
+    size_t meshBytes = model.mesh.vertices.size() * sizeof(Vertex) +
+                       model.mesh.indices.size() * sizeof(uint32_t);
+    return meshBytes * 2;
+}
+
+AssetManager::DedupReport AssetManager::GetDedupReport() const {
+    DedupReport report;
+    if (auto* texMgr = dynamic_cast<TextureManager*>(textureManager_.get())) {
+        auto stats = texMgr->GetDedupStats();
+        report.textureDuplicates = stats.duplicateLoads;
+        report.textureBytesSaved = stats.bytesSaved;
+    }
+    
+    std::lock_guard<std::mutex> lock(contentMutex_);
+    report.modelDuplicates = modelDuplicates_;
+    report.modelBytesSaved = modelBytesSaved_;
+    return report;
 }
 
 // 公開的載入方法實作
@@ -479,4 +1035,34 @@ std::vector<std::shared_ptr<ModelData>> AssetManager::LoadAllModels(const std::s
 std::shared_ptr<IDirect3DTexture9> AssetManager::LoadTexture(const std::string& assetPath) {
     std::string fullPath = ResolveAssetPath(assetPath, AssetType::Texture);
     return LoadTextureImpl(fullPath);
+}
+
+AssetId AssetManager::GetAssetId(const std::string& assetPath) const {
+    if (assetPath.empty()) {
+        return kInvalidAssetId;
+    }
+    // interner 的正規化方式與 GenerateAssetKey 相同，ID 對應的路徑即為快取鍵值
+    return AssetPathInterner::Instance().Intern(ResolveAssetPath(assetPath, DetectAssetType(assetPath)));
+}
+
+std::shared_ptr<ModelData> AssetManager::LoadModel(AssetId id) {
+    const std::string& key = AssetPathInterner::Instance().GetPath(id);
+    if (key.empty()) {
+        return nullptr;
+    }
+    if (auto data = assets_.Find(key)) {
+        return std::static_pointer_cast<ModelData>(data);
+    }
+    return LoadModelImpl(key);
+}
+
+std::shared_ptr<IDirect3DTexture9> AssetManager::LoadTexture(AssetId id) {
+    const std::string& key = AssetPathInterner::Instance().GetPath(id);
+    if (key.empty()) {
+        return nullptr;
+    }
+    if (auto data = assets_.Find(key)) {
+        return std::static_pointer_cast<IDirect3DTexture9>(data);
+    }
+    return LoadTextureImpl(key);
 }
\ No newline at end of file
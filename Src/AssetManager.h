@@ -3,6 +3,14 @@
 #include "IAssetManager.h"
 #include "IModelManager.h"
 #include "ITextureManager.h"
+#include "AssetCache.h"
+#include "AssetId.h"
+#include "AssetDependencyGraph.h"
+#include "FileWatcher.h"
+#include "ModelData.h"
+#include "TextureCache.h"
+#include "TextureStreamer.h"
+#include <map>
 #include <unordered_map>
 #include <filesystem>
 #include <mutex>
@@ -15,23 +23,22 @@
 
 using Microsoft::WRL::ComPtr;
 
-// 資產項目 - 內部使用
-struct AssetItem {
-    std::string path;
-    AssetType type;
-    AssetLoadState state;
-    std::shared_ptr<void> data;
-    size_t refCount;
-    std::chrono::time_point<std::chrono::steady_clock> lastAccessed;
-    
-    AssetItem() : type(AssetType::Model), state(AssetLoadState::NotLoaded), refCount(0) {}
-};
-
 class AssetManager : public IAssetManager {
 public:
+    // 內容去重報告：不同路徑但內容相同的資產共用同一份常駐資源
+    struct DedupReport {
+        size_t textureDuplicates = 0;
+        size_t textureBytesSaved = 0;
+        size_t modelDuplicates = 0;
+        size_t modelBytesSaved = 0;
+    };
+    
     AssetManager();
     ~AssetManager();
     
+    // 與其他 TextureManager 共用貼圖快取（分類為 Model）；需在 Initialize 之前呼叫，未設定時使用自己的快取
+    void SetTextureCache(std::shared_ptr<TextureCache> cache);
+    
     // IAssetManager 介面實作
     bool Initialize(IDirect3DDevice9* device) override;
     void SetAssetRoot(const std::string& rootPath) override;
@@ -57,6 +64,27 @@ public:
     std::shared_ptr<IDirect3DTexture9> LoadTexture(const std::string& assetPath) override;
     
     std::string ResolveAssetPath(const std::string& assetPath, AssetType type) const override;
+    
+    // 將資產路徑解析並 intern 為 AssetId；之後以 ID 載入可略過路徑解析與正規化
+    AssetId GetAssetId(const std::string& assetPath) const;
+    std::shared_ptr<ModelData> LoadModel(AssetId id);
+    std::shared_ptr<IDirect3DTexture9> LoadTexture(AssetId id);
+    
+    // 在影格邊界呼叫：推進資產快取的存取時鐘，並套用監控執行緒偵測到的熱重載
+    void ProcessPendingReloads();
+    
+    // 有烘焙 DDS 的貼圖以串流方式載入：渲染網格時回報貼圖在螢幕上的像素面積，
+    // 每幀在裝置執行緒呼叫一次 UpdateStreaming 依回報補上或丟棄 mip；不是串流貼圖時直接忽略
+    void ReportTextureUsage(const IDirect3DBaseTexture9* texture, float screenPixels);
+    TextureStreamerStats UpdateStreaming();
+    
+    // 相依圖：預先載入 rootAsset 的整個相依閉包，回傳成功載入（或已常駐）的模型與貼圖數量
+    size_t Prefetch(const std::string& rootAsset);
+    std::vector<std::string> GetAssetDependencies(const std::string& assetPath) const;
+    std::vector<std::string> FindSharedAssets() const;
+    std::vector<std::string> FindOrphanedAssets() const;
+    
+    DedupReport GetDedupReport() const;
 
 protected:
     std::shared_ptr<ModelData> LoadModelImpl(const std::string& fullPath) override;
@@ -69,36 +97,91 @@ private:
     std::string GenerateAssetKey(const std::string& assetPath) const;
     
     // 載入特定類型的資產
-    std::shared_ptr<ModelData> LoadModelFromFile(const std::string& fullPath);
+    std::map<std::string, ModelData> ImportModels(const std::string& fullPath, bool separateObjects);
+    std::shared_ptr<ModelData> LoadModelFromFile(const std::string& fullPath, bool allowShared = true);
     std::shared_ptr<IDirect3DTexture9> LoadTextureFromFile(const std::string& fullPath);
     
+    // 相依圖維護
+    void RecordModelDependencies(const std::string& fullPath, const std::vector<const ModelData*>& models);
+    
+    // ModelTextureSource：模型載入器經由資產快取取得貼圖，並記錄為匯入中模型的相依
+    IDirect3DTexture9* AcquireModelTexture(const std::filesystem::path& reference);
+    
     // 記憶體管理
-    void UpdateAssetAccess(const std::string& key);
     void CleanupUnusedAssets();
     
     // 熱重載支援
     void StartFileWatcher();
     void StopFileWatcher();
     void OnFileChanged(const std::string& filePath);
+    void WatchFile(const std::string& fullPath);
+    void ReimportFile(const std::string& fullPath);
+    
+    // 背景熱重載：worker 只讀檔、剖析並轉換為 CPU 端的 ModelData，影格邊界再建立緩衝區並交換
+    // 載入器需要裝置的格式（.x、FBX）在 worker 上只預讀檔案，影格邊界以 ImportModels 同步重新匯入
+    struct PreparedReload {
+        std::string fullPath;
+        bool hasSingle = false;                      // 快取中有單一項目 key
+        bool hasMulti = false;                       // 快取中有 LoadAllModels 建立的 "key::model"
+        bool supported = false;                      // 此格式有與 ImportModels 相同且不需裝置的載入器；否則在影格邊界同步重新匯入
+        std::map<std::string, ModelData> multi;      // 尚未建立緩衝區
+        std::string error;
+    };
+    static PreparedReload PrepareReload(PreparedReload request);
+    void ApplyReload(PreparedReload& prepared);
+    bool CreateModelResources(const std::string& fullPath, ModelData& model);
+    void SwapModelData(ModelData& live, ModelData& fresh);
+    void ReplaceModel(const std::string& key, const std::string& path, ModelData&& fresh);
+    void RemoveStaleModels(const std::string& fullPath, const std::map<std::string, ModelData>& fresh);
+    void ReplaceTexture(const std::string& fullPath);
+    bool SwapTextureData(IDirect3DTexture9* live, IDirect3DTexture9* fresh);
+    
+    // 內容去重
+    bool IsModelShared(const ModelData* model) const;
+    static size_t EstimateModelBytes(const ModelData& model) noexcept;
 
 private:
     // 核心資料
     IDirect3DDevice9* device_;
     std::string assetRoot_;
     std::unordered_map<AssetType, std::string> assetPaths_;
-    
-    // 資產快取
-    mutable std::shared_mutex assetMutex_;
-    std::unordered_map<std::string, AssetItem> assets_;
+    mutable std::shared_mutex pathMutex_;   // 保護 assetRoot_ / assetPaths_
+    
+    // 資產快取（分片，命中時不取獨佔鎖）
+    AssetCache assets_;
+    AssetDependencyGraph dependencies_;
+    std::mutex importMutex_;
+    std::unordered_map<std::string, std::vector<std::string>> emittedTextures_;   // 模型鍵 -> 匯入時要求的貼圖
+    
+    // 內容雜湊 -> 已載入模型（快取持有擁有權，這裡只做查詢）；source 為雜湊的來源檔，命中時逐位元組比對
+    struct ContentModel {
+        std::string source;
+        std::weak_ptr<ModelData> model;
+    };
+    struct ContentModelSet {
+        std::string source;
+        std::vector<std::pair<std::string, std::weak_ptr<ModelData>>> models;
+    };
+    mutable std::mutex contentMutex_;
+    std::unordered_map<uint64_t, ContentModel> modelsByContent_;
+    std::unordered_map<uint64_t, ContentModelSet> modelSetsByContent_;
+    size_t modelDuplicates_ = 0;
+    size_t modelBytesSaved_ = 0;
     
     // 子系統
     std::unique_ptr<IModelManager> modelManager_;
     std::unique_ptr<ITextureManager> textureManager_;
+    std::shared_ptr<TextureCache> textureCache_;
     
     // 熱重載
     bool hotReloadEnabled_;
-    std::unique_ptr<std::thread> fileWatcherThread_;
-    std::atomic<bool> stopFileWatcher_;
+    std::unique_ptr<FileWatcher> fileWatcher_;
+    std::mutex watcherMutex_;   // 保護 fileWatcher_：loader 在任意執行緒上呼叫 WatchFile，EnableHotReload 可能同時釋放監控器
+    std::mutex reloadMutex_;
+    std::vector<std::string> pendingReloads_;   // 監控執行緒寫入，影格邊界取出
+    // 以下只在呼叫 ProcessPendingReloads 的執行緒上存取
+    std::vector<std::pair<std::string, std::future<PreparedReload>>> reloadJobs_;   // 背景剖析中的模型
+    std::vector<std::string> textureReloads_;   // 背景解碼中的貼圖（TextureManager::Prefetch）
     
     // 統計
     mutable std::atomic<size_t> totalMemoryUsage_;
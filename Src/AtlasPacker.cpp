@@ -0,0 +1,123 @@
+#include "AtlasPacker.h"
+#include <algorithm>
+
+SkylinePacker::SkylinePacker(int width, int height)
+    : width_(width), height_(height) {
+    skyline_.push_back({ 0, 0, width });
+}
+
+double SkylinePacker::Occupancy() const {
+    return width_ > 0 && height_ > 0 ? double(usedArea_) / (double(width_) * height_) : 0.0;
+}
+
+int SkylinePacker::Fit(size_t index, int width, int height) const {
+    if (skyline_[index].x + width > width_) {
+        return -1;
+    }
+    int y = 0;
+    int remaining = width;
+    for (size_t i = index; remaining > 0; ++i) {
+        y = (std::max)(y, skyline_[i].y);
+        if (y + height > height_) {
+            return -1;
+        }
+        remaining -= skyline_[i].width;
+    }
+    return y;
+}
+
+std::optional<AtlasRect> SkylinePacker::Insert(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        return std::nullopt;
+    }
+
+    size_t bestIndex = skyline_.size();
+    int bestY = height_;
+    int bestWidth = width_ + 1;
+    for (size_t i = 0; i < skyline_.size(); ++i) {
+        int y = Fit(i, width, height);
+        if (y < 0) {
+            continue;
+        }
+        // 頂邊最低者優先；相同時選所在段較窄的，留下較完整的空間
+        if (y < bestY || (y == bestY && skyline_[i].width < bestWidth)) {
+            bestIndex = i;
+            bestY = y;
+            bestWidth = skyline_[i].width;
+        }
+    }
+    if (bestIndex == skyline_.size()) {
+        return std::nullopt;
+    }
+
+    AtlasRect rect{ skyline_[bestIndex].x, bestY, width, height };
+
+    // 新段覆蓋 [x, x + width)，被完全蓋住的段移除，部分蓋住的段裁掉左側
+    skyline_.insert(skyline_.begin() + bestIndex, { rect.x, rect.y + height, width });
+    for (size_t i = bestIndex + 1; i < skyline_.size();) {
+        Segment& segment = skyline_[i];
+        int covered = rect.x + width - segment.x;
+        if (covered <= 0) {
+            break;
+        }
+        if (covered >= segment.width) {
+            skyline_.erase(skyline_.begin() + i);
+            continue;
+        }
+        segment.x += covered;
+        segment.width -= covered;
+        break;
+    }
+    // 合併等高的相鄰段
+    for (size_t i = 0; i + 1 < skyline_.size();) {
+        if (skyline_[i].y == skyline_[i + 1].y) {
+            skyline_[i].width += skyline_[i + 1].width;
+            skyline_.erase(skyline_.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+
+    usedHeight_ = (std::max)(usedHeight_, rect.y + height);
+    usedArea_ += int64_t(width) * height;
+    return rect;
+}
+
+AtlasLayout PackAtlas(std::vector<AtlasItem> items, int pageWidth, int pageHeight, int padding) {
+    AtlasLayout layout;
+    layout.pageWidth = pageWidth;
+    layout.pageHeight = pageHeight;
+
+    std::stable_sort(items.begin(), items.end(), [](const AtlasItem& a, const AtlasItem& b) {
+        return a.height != b.height ? a.height > b.height : a.width > b.width;
+    });
+
+    std::vector<SkylinePacker> pages;
+    for (const AtlasItem& item : items) {
+        const int paddedWidth = item.width + 2 * padding;
+        const int paddedHeight = item.height + 2 * padding;
+        if (item.width <= 0 || item.height <= 0 || paddedWidth > pageWidth || paddedHeight > pageHeight) {
+            layout.rejected.push_back(item.key);
+            continue;
+        }
+
+        std::optional<AtlasRect> rect;
+        size_t page = 0;
+        for (; page < pages.size(); ++page) {
+            if ((rect = pages[page].Insert(paddedWidth, paddedHeight))) {
+                break;
+            }
+        }
+        if (!rect) {
+            pages.emplace_back(pageWidth, pageHeight);
+            rect = pages.back().Insert(paddedWidth, paddedHeight);
+        }
+        layout.placements[item.key] = { static_cast<uint32_t>(page),
+                                        { rect->x + padding, rect->y + padding, item.width, item.height } };
+    }
+
+    for (const SkylinePacker& page : pages) {
+        layout.pageUsedHeights.push_back(page.UsedHeight());
+    }
+    return layout;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 矩形打包：skyline bottom-left，每次放在讓頂邊最低的位置（同高時取最左）
+// 只處理整數座標，不接觸影像資料，建置工具與執行期共用
+
+struct AtlasRect {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+};
+
+// 單一頁面
+class SkylinePacker {
+public:
+    SkylinePacker(int width, int height);
+
+    // 放不下時回傳 nullopt，頁面狀態不變
+    std::optional<AtlasRect> Insert(int width, int height);
+
+    int Width() const { return width_; }
+    int Height() const { return height_; }
+    // 已放入矩形的最大底邊
+    int UsedHeight() const { return usedHeight_; }
+    // 已放入矩形面積 / 頁面面積
+    double Occupancy() const;
+
+private:
+    struct Segment {
+        int x;
+        int y;       // 此段目前的高度
+        int width;
+    };
+
+    // 從第 index 段開始放入寬 width 時的頂邊；放不下時回傳 -1
+    int Fit(size_t index, int width, int height) const;
+
+    int width_;
+    int height_;
+    int usedHeight_ = 0;
+    int64_t usedArea_ = 0;
+    std::vector<Segment> skyline_;
+};
+
+struct AtlasPlacement {
+    uint32_t page = 0;
+    AtlasRect rect;   // 不含 padding
+};
+
+struct AtlasLayout {
+    int pageWidth = 0;
+    int pageHeight = 0;
+    std::vector<int> pageUsedHeights;   // 每頁實際用到的高度（含 padding），可用來裁掉頁面底部
+    std::unordered_map<std::string, AtlasPlacement> placements;
+    std::vector<std::string> rejected;  // 加上 padding 後比頁面大
+};
+
+struct AtlasItem {
+    std::string key;
+    int width = 0;
+    int height = 0;
+};
+
+// 由高到低（同高時由寬到窄）依序放入第一個放得下的頁面，都放不下時開新頁
+// 每個矩形四周保留 padding 像素，供呼叫端延伸邊緣像素以免雙線性取樣滲色
+AtlasLayout PackAtlas(std::vector<AtlasItem> items, int pageWidth, int pageHeight, int padding);
@@ -0,0 +1,192 @@
+#include "ContentHash.h"
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace {
+
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t kPrime3 = 0x165667B19E3779F9ull;
+constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ull;
+constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ull;
+
+inline uint64_t Rotl(uint64_t x, int r) noexcept {
+    return (x << r) | (x >> (64 - r));
+}
+
+inline uint64_t Read64(const unsigned char* p) noexcept {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint32_t Read32(const unsigned char* p) noexcept {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint64_t Round(uint64_t acc, uint64_t input) noexcept {
+    acc += input * kPrime2;
+    acc = Rotl(acc, 31);
+    return acc * kPrime1;
+}
+
+inline uint64_t MergeRound(uint64_t acc, uint64_t val) noexcept {
+    acc ^= Round(0, val);
+    return acc * kPrime1 + kPrime4;
+}
+
+// 串流狀態：一次餵入任意長度的資料
+struct Xxh64State {
+    uint64_t v[4];
+    unsigned char buffer[32];
+    size_t bufferSize = 0;
+    uint64_t totalLength = 0;
+    uint64_t seed;
+
+    explicit Xxh64State(uint64_t s) noexcept : seed(s) {
+        v[0] = s + kPrime1 + kPrime2;
+        v[1] = s + kPrime2;
+        v[2] = s;
+        v[3] = s - kPrime1;
+    }
+
+    void Consume(const unsigned char* p) noexcept {
+        v[0] = Round(v[0], Read64(p));
+        v[1] = Round(v[1], Read64(p + 8));
+        v[2] = Round(v[2], Read64(p + 16));
+        v[3] = Round(v[3], Read64(p + 24));
+    }
+
+    void Update(const unsigned char* p, size_t len) noexcept {
+        totalLength += len;
+        if (bufferSize + len < 32) {
+            std::memcpy(buffer + bufferSize, p, len);
+            bufferSize += len;
+            return;
+        }
+        if (bufferSize > 0) {
+            size_t fill = 32 - bufferSize;
+            std::memcpy(buffer + bufferSize, p, fill);
+            Consume(buffer);
+            p += fill;
+            len -= fill;
+            bufferSize = 0;
+        }
+        while (len >= 32) {
+            Consume(p);
+            p += 32;
+            len -= 32;
+        }
+        if (len > 0) {
+            std::memcpy(buffer, p, len);
+            bufferSize = len;
+        }
+    }
+
+    uint64_t Digest() const noexcept {
+        uint64_t h;
+        if (totalLength >= 32) {
+            h = Rotl(v[0], 1) + Rotl(v[1], 7) + Rotl(v[2], 12) + Rotl(v[3], 18);
+            h = MergeRound(h, v[0]);
+            h = MergeRound(h, v[1]);
+            h = MergeRound(h, v[2]);
+            h = MergeRound(h, v[3]);
+        } else {
+            h = seed + kPrime5;
+        }
+        h += totalLength;
+
+        const unsigned char* p = buffer;
+        size_t len = bufferSize;
+        while (len >= 8) {
+            h ^= Round(0, Read64(p));
+            h = Rotl(h, 27) * kPrime1 + kPrime4;
+            p += 8;
+            len -= 8;
+        }
+        if (len >= 4) {
+            h ^= static_cast<uint64_t>(Read32(p)) * kPrime1;
+            h = Rotl(h, 23) * kPrime2 + kPrime3;
+            p += 4;
+            len -= 4;
+        }
+        while (len > 0) {
+            h ^= (*p) * kPrime5;
+            h = Rotl(h, 11) * kPrime1;
+            ++p;
+            --len;
+        }
+
+        h ^= h >> 33;
+        h *= kPrime2;
+        h ^= h >> 29;
+        h *= kPrime3;
+        h ^= h >> 32;
+        return h;
+    }
+};
+
+} // namespace
+
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed) noexcept {
+    Xxh64State state(seed);
+    state.Update(static_cast<const unsigned char*>(data), size);
+    return state.Digest();
+}
+
+uint64_t HashFile(const std::filesystem::path& file) noexcept {
+    std::ifstream in(file, std::ios::binary);
+    if (!in) {
+        return 0;
+    }
+
+    Xxh64State state(0);
+    std::vector<char> chunk(256 * 1024);
+    while (in) {
+        in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        std::streamsize got = in.gcount();
+        if (got <= 0) {
+            break;
+        }
+        state.Update(reinterpret_cast<const unsigned char*>(chunk.data()), static_cast<size_t>(got));
+    }
+    return state.Digest();
+}
+
+bool SameFileContent(const std::filesystem::path& a, const std::filesystem::path& b) noexcept {
+    if (a.empty() || b.empty()) {
+        return false;
+    }
+    std::error_code ec;
+    if (std::filesystem::equivalent(a, b, ec)) {
+        return true;
+    }
+    const auto sizeA = std::filesystem::file_size(a, ec);
+    if (ec) {
+        return false;
+    }
+    const auto sizeB = std::filesystem::file_size(b, ec);
+    if (ec || sizeA != sizeB) {
+        return false;
+    }
+
+    std::ifstream inA(a, std::ios::binary);
+    std::ifstream inB(b, std::ios::binary);
+    if (!inA || !inB) {
+        return false;
+    }
+    std::vector<char> chunkA(256 * 1024);
+    std::vector<char> chunkB(chunkA.size());
+    while (inA && inB) {
+        inA.read(chunkA.data(), static_cast<std::streamsize>(chunkA.size()));
+        inB.read(chunkB.data(), static_cast<std::streamsize>(chunkB.size()));
+        const std::streamsize got = inA.gcount();
+        if (got != inB.gcount() || std::memcmp(chunkA.data(), chunkB.data(), static_cast<size_t>(got)) != 0) {
+            return false;
+        }
+    }
+    return inA.eof() && inB.eof();
+}
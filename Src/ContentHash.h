@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+// 內容雜湊（XXH64 演算法），用於比對檔案內容是否真的改變
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0) noexcept;
+
+// 以串流方式雜湊整個檔案；讀取失敗回傳 0
+uint64_t HashFile(const std::filesystem::path& file) noexcept;
+
+// 兩個檔案的大小與位元組是否完全相同；雜湊命中後用來確認不是碰撞。任一檔案讀取失敗回傳 false
+bool SameFileContent(const std::filesystem::path& a, const std::filesystem::path& b) noexcept;
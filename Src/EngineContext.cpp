@@ -68,13 +68,16 @@ STDMETHODIMP EngineContext::Initialize(
   hr = d3dContext_->GetDevice(&device);
   if (FAILED(hr)) return hr;
 
-  // Step 5: 建立並檢查子系統 - 保持分離的TextureManager以優化不同用途
-  // UI紋理: 小圖、高頻存取、長生命週期
-  uiTextureManager_ = CreateTextureManager(device);
+  // Step 5: 建立並檢查子系統 - UI 與模型各自一個 TextureManager，共用同一份貼圖快取
+  // 同一檔案只載入一次；預算只會釋放沒有人持有的貼圖
+  textureCache_ = std::make_shared<TextureCache>();
+  textureCache_->SetBudget(TextureCategory::UI, 64u << 20);      // UI紋理: 小圖、高頻存取、長生命週期
+  textureCache_->SetBudget(TextureCategory::Model, 256u << 20);  // Model紋理: 大圖、場景生命週期、需要mipmap
+
+  uiTextureManager_ = CreateTextureManager(device, textureCache_, TextureCategory::UI);
   if (!uiTextureManager_) return E_FAIL;
   
-  // Model紋理: 大圖、場景生命週期、需要mipmap
-  modelTextureManager_ = CreateTextureManager(device);
+  modelTextureManager_ = CreateTextureManager(device, textureCache_, TextureCategory::Model);
   if (!modelTextureManager_) return E_FAIL;
 
   effectManager_ = CreateEffectManager();
@@ -169,6 +172,11 @@ STDMETHODIMP EngineContext::Run() {
       break;
     }
     
+    // 影格邊界：套用背景偵測到的資產熱重載
+    if (auto* am = dynamic_cast<AssetManager*>(assetManager_.get())) {
+      am->ProcessPendingReloads();
+    }
+    
     // 更新系統 - 優先使用新架構，如果不可用則使用舊系統
     if (sceneManager_) {
       // 新架構：使用 SceneManager 更新場景
@@ -299,6 +307,11 @@ bool EngineContext::InitializeModernSystems() {
         return false;
     }
     
+    // 與 UI／模型的 TextureManager 共用貼圖快取，同一檔案不會被載入兩次
+    if (auto* am = dynamic_cast<AssetManager*>(assetManager_.get())) {
+        am->SetTextureCache(textureCache_);
+    }
+    
     if (!assetManager_->Initialize(device.Get())) {
         std::cerr << "Failed to initialize AssetManager" << std::endl;
         return false;
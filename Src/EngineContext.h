@@ -20,6 +20,8 @@
 // #include "IUISystem.h" // Removed - using UIManager only
 #include "../Include/IEventManager.h"
 #include "ServiceLocator.h"
+#include "TextureCache.h"
+#include <memory>
 
 using Microsoft::WRL::ComPtr;
 
@@ -69,6 +71,8 @@ private:
   UINT                          height_;
 
   // 核心系統
+  // UI、模型與 AssetManager 的 TextureManager 共用同一份常駐貼圖，各自以分類計入預算
+  std::shared_ptr<TextureCache>         textureCache_;
   std::unique_ptr<ITextureManager>      uiTextureManager_;
   std::unique_ptr<ITextureManager>      modelTextureManager_;
   std::unique_ptr<IEffectManager>       effectManager_;
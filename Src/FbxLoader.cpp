@@ -7,6 +7,8 @@
 #include <d3dx9.h>
 #include "AnimationPlayer.h"
 #include "SkinMeshFactory.h"
+#include "ModelTextureSource.h"
+#include "ParallelFor.h"
 #include <filesystem>
 
 // Need access to InitVertexDecl
@@ -14,6 +16,31 @@ void InitVertexDecl(IDirect3DDevice9* dev);
 
 using namespace fbxsdk;
 
+namespace {
+
+// Read a layer element value for one polygon corner; cornerIndex is the polygon-vertex index.
+// Returns false for unsupported mapping modes or out-of-range indices (treated as unmapped).
+// Only const accessors are used, so it is safe to call from several threads at once.
+template <typename T>
+bool ReadLayerElement(const FbxLayerElementTemplate<T>& element, int cpIndex, int cornerIndex, T& out) {
+    LayerMapping mapping;
+    switch (element.GetMappingMode()) {
+        case FbxLayerElement::eByControlPoint: mapping = LayerMapping::ByControlPoint; break;
+        case FbxLayerElement::eByPolygonVertex: mapping = LayerMapping::ByPolygonVertex; break;
+        default: mapping = LayerMapping::Unsupported; break;
+    }
+    const auto& indexArray = element.GetIndexArray();
+    const auto& directArray = element.GetDirectArray();
+    int indexCount = element.GetReferenceMode() != FbxLayerElement::eDirect ? indexArray.GetCount() : -1;
+    int index = LayerElementIndex(mapping, cpIndex, cornerIndex, indexCount,
+                                  [&indexArray](int i) { return indexArray.GetAt(i); }, directArray.GetCount());
+    if (index < 0) return false;
+    out = directArray.GetAt(index);
+    return true;
+}
+
+} // namespace
+
 FbxLoader::FbxLoader() {
 }
 
@@ -75,15 +102,17 @@ std::map<std::string, ModelData> FbxLoader::Load(const std::filesystem::path& fi
         for (size_t i = 0; i < meshNodes.size(); ++i) {
             FbxNode* meshNode = meshNodes[i];
             ModelData modelData;
+            Skeleton skeleton;
             
             // Extract skeleton for this model
-            ExtractSkeleton(meshNode, modelData.skeleton);
+            ExtractSkeleton(meshNode, skeleton);
             
             // Extract animations
-            ExtractAnimations(scene, modelData.skeleton);
+            ExtractAnimations(scene, skeleton);
             
             // Convert this node only
-            ConvertNode(meshNode, modelData.mesh, modelData.skeleton, device, file);
+            ConvertNode(meshNode, modelData.mesh, skeleton, device, file);
+            modelData.skeleton = std::make_shared<const Skeleton>(std::move(skeleton));
             
             // Create buffers
             if (!modelData.mesh.vertices.empty()) {
@@ -103,15 +132,17 @@ std::map<std::string, ModelData> FbxLoader::Load(const std::filesystem::path& fi
     } else {
         // Single model case - process as before
         ModelData modelData;
+        Skeleton skeleton;
         
         // Extract skeleton first
-        ExtractSkeleton(root, modelData.skeleton);
+        ExtractSkeleton(root, skeleton);
         
         // Extract animations
-        ExtractAnimations(scene, modelData.skeleton);
+        ExtractAnimations(scene, skeleton);
         
         // Convert nodes to mesh
-        ConvertNode(root, modelData.mesh, modelData.skeleton, device, file);
+        ConvertNode(root, modelData.mesh, skeleton, device, file);
+        modelData.skeleton = std::make_shared<const Skeleton>(std::move(skeleton));
         
         // Create buffers after all mesh data is collected
         if (!modelData.mesh.vertices.empty()) {
@@ -190,186 +221,94 @@ void FbxLoader::ExtractMeshData(FbxMesh* fbxMesh, SkinMesh& mesh, IDirect3DDevic
     int vertexCount = fbxMesh->GetControlPointsCount();
     int polyCount = fbxMesh->GetPolygonCount();
     
-    // Extract skin deformer data
-    std::vector<std::vector<std::pair<int, float>>> skinWeights(vertexCount);
-    ExtractSkinWeights(fbxMesh, skinWeights);
+    // Top-4 normalized skin influences, resolved once per control point
+    std::vector<SkinInfluence> skinInfluences = ExtractSkinWeights(fbxMesh, vertexCount);
     
     // Get control points (vertex positions)
-    FbxVector4* controlPoints = fbxMesh->GetControlPoints();
+    const FbxVector4* controlPoints = fbxMesh->GetControlPoints();
     
     // Get layers for normals and UVs
     FbxLayer* layer0 = fbxMesh->GetLayer(0);
-    FbxLayerElementNormal* normalElement = layer0 ? layer0->GetNormals() : nullptr;
-    FbxLayerElementUV* uvElement = layer0 ? layer0->GetUVs() : nullptr;
+    const FbxLayerElementNormal* normalElement = layer0 ? layer0->GetNormals() : nullptr;
+    const FbxLayerElementUV* uvElement = layer0 ? layer0->GetUVs() : nullptr;
     
     // Get current vertex count to offset indices
     uint32_t baseVertexIndex = static_cast<uint32_t>(mesh.vertices.size());
     
-    // Reserve space for vertices (append to existing)
-    std::vector<Vertex> vertices;
-    vertices.reserve(polyCount * 3); // Assuming triangles
-    
-    // Extract vertex data
-    std::vector<uint32_t> indices;
-    int vertexCounter = 0;
-    
-    for (int polyIdx = 0; polyIdx < polyCount; ++polyIdx) {
-        int polySize = fbxMesh->GetPolygonSize(polyIdx);
-        
-        // Store vertices for this polygon first
-        std::vector<uint32_t> polyVertices;
+    // Prefix-sum corner and index offsets so every polygon knows where its output goes.
+    // The corner offset is also the polygon-vertex index used by eByPolygonVertex layers.
+    // Triangles emit 3 indices, quads 6; polygons with more than 4 vertices get no indices for now
+    const PolygonLayout layout = BuildPolygonLayout(polyCount, [fbxMesh](int polyIdx) {
+        return fbxMesh->GetPolygonSize(polyIdx);
+    });
+    const std::vector<uint32_t>& cornerOffsets = layout.corners;
+    const std::vector<uint32_t>& indexOffsets = layout.indices;
+    
+    // Append in place; workers fill disjoint ranges of the new tail
+    size_t firstVertex = mesh.vertices.size();
+    size_t firstIndex = mesh.indices.size();
+    mesh.vertices.resize(firstVertex + cornerOffsets[polyCount]);
+    mesh.indices.resize(firstIndex + indexOffsets[polyCount]);
+    Vertex* vertices = mesh.vertices.data() + firstVertex;
+    uint32_t* indices = mesh.indices.data() + firstIndex;
+    
+    // Corner extraction only reads the mesh, so polygon ranges are processed in parallel
+    constexpr int kPolygonsPerTask = 4096;
+    size_t taskCount = (static_cast<size_t>(polyCount) + kPolygonsPerTask - 1) / kPolygonsPerTask;
+    ParallelFor(taskCount, [&](size_t task) {
+        int polyBegin = static_cast<int>(task) * kPolygonsPerTask;
+        int polyEnd = (std::min)(polyBegin + kPolygonsPerTask, polyCount);
         
-        for (int vertIdx = 0; vertIdx < polySize; ++vertIdx) {
-            Vertex vertex = {};
-            
-            // Get control point index
-            int cpIndex = fbxMesh->GetPolygonVertex(polyIdx, vertIdx);
+        for (int polyIdx = polyBegin; polyIdx < polyEnd; ++polyIdx) {
+            uint32_t firstCorner = cornerOffsets[polyIdx];
+            int polySize = static_cast<int>(cornerOffsets[polyIdx + 1] - firstCorner);
             
-            // Position
-            FbxVector4 pos = controlPoints[cpIndex];
-            vertex.pos.x = static_cast<float>(pos[0]);
-            vertex.pos.y = static_cast<float>(pos[1]);
-            vertex.pos.z = static_cast<float>(pos[2]);
-            
-            // Normal
-            if (normalElement) {
-                FbxVector4 normal;
-                int vertexIndex = polyIdx * 3 + vertIdx;
+            for (int vertIdx = 0; vertIdx < polySize; ++vertIdx) {
+                Vertex& vertex = vertices[firstCorner + vertIdx];
+                int cornerIndex = static_cast<int>(firstCorner) + vertIdx;
                 
-                switch (normalElement->GetMappingMode()) {
-                    case FbxLayerElement::eByControlPoint:
-                        switch (normalElement->GetReferenceMode()) {
-                            case FbxLayerElement::eDirect:
-                                normal = normalElement->GetDirectArray().GetAt(cpIndex);
-                                break;
-                            case FbxLayerElement::eIndexToDirect:
-                                {
-                                    int index = normalElement->GetIndexArray().GetAt(cpIndex);
-                                    normal = normalElement->GetDirectArray().GetAt(index);
-                                }
-                                break;
-                        }
-                        break;
-                    case FbxLayerElement::eByPolygonVertex:
-                        switch (normalElement->GetReferenceMode()) {
-                            case FbxLayerElement::eDirect:
-                                normal = normalElement->GetDirectArray().GetAt(vertexIndex);
-                                break;
-                            case FbxLayerElement::eIndexToDirect:
-                                {
-                                    int index = normalElement->GetIndexArray().GetAt(vertexIndex);
-                                    normal = normalElement->GetDirectArray().GetAt(index);
-                                }
-                                break;
-                        }
-                        break;
+                // Get control point index
+                int cpIndex = fbxMesh->GetPolygonVertex(polyIdx, vertIdx);
+                
+                // Position
+                if (cpIndex >= 0 && cpIndex < vertexCount) {
+                    const FbxVector4& pos = controlPoints[cpIndex];
+                    vertex.pos.x = static_cast<float>(pos[0]);
+                    vertex.pos.y = static_cast<float>(pos[1]);
+                    vertex.pos.z = static_cast<float>(pos[2]);
                 }
                 
-                vertex.norm.x = static_cast<float>(normal[0]);
-                vertex.norm.y = static_cast<float>(normal[1]);
-                vertex.norm.z = static_cast<float>(normal[2]);
-            }
-            
-            // UV
-            if (uvElement) {
-                FbxVector2 uv;
-                bool unmapped;
-                fbxMesh->GetPolygonVertexUV(polyIdx, vertIdx, uvElement->GetName(), uv, unmapped);
+                // Normal
+                FbxVector4 normal;
+                if (normalElement && ReadLayerElement(*normalElement, cpIndex, cornerIndex, normal)) {
+                    vertex.norm.x = static_cast<float>(normal[0]);
+                    vertex.norm.y = static_cast<float>(normal[1]);
+                    vertex.norm.z = static_cast<float>(normal[2]);
+                }
                 
-                if (!unmapped) {
+                // UV
+                FbxVector2 uv;
+                if (uvElement && ReadLayerElement(*uvElement, cpIndex, cornerIndex, uv)) {
                     vertex.uv.x = static_cast<float>(uv[0]);
                     vertex.uv.y = 1.0f - static_cast<float>(uv[1]); // Flip V coordinate
                 }
-            }
-            
-            // Default color
-            vertex.col = 0xFFFFFFFF;
-            vertex.spec = 0xFFFFFFFF;
-            
-            // Skinning weights - extract from skin data
-            if (cpIndex < skinWeights.size() && !skinWeights[cpIndex].empty()) {
-                // Sort weights by influence (highest first)
-                auto weights = skinWeights[cpIndex];
-                std::sort(weights.begin(), weights.end(), 
-                    [](const auto& a, const auto& b) { return a.second > b.second; });
                 
-                // Take up to 4 bone influences
-                float totalWeight = 0.0f;
-                for (int w = 0; w < 4 && w < weights.size(); ++w) {
-                    switch (w) {
-                        case 0: vertex.weights.x = weights[w].second; break;
-                        case 1: vertex.weights.y = weights[w].second; break;
-                        case 2: vertex.weights.z = weights[w].second; break;
-                        case 3: vertex.weights.w = weights[w].second; break;
-                    }
-                    vertex.boneIndices[w] = static_cast<uint8_t>(weights[w].first);
-                    totalWeight += weights[w].second;
-                }
+                // Default color
+                vertex.col = 0xFFFFFFFF;
+                vertex.spec = 0xFFFFFFFF;
                 
-                // Normalize weights
-                if (totalWeight > 0.0f) {
-                    vertex.weights.x /= totalWeight;
-                    vertex.weights.y /= totalWeight;
-                    vertex.weights.z /= totalWeight;
-                    vertex.weights.w /= totalWeight;
-                }
-            } else {
-                // Default: bind to bone 0 with full weight
-                vertex.weights.x = 1.0f;
-                vertex.weights.y = 0.0f;
-                vertex.weights.z = 0.0f;
-                vertex.weights.w = 0.0f;
-                vertex.boneIndices[0] = 0;
-                vertex.boneIndices[1] = 0;
-                vertex.boneIndices[2] = 0;
-                vertex.boneIndices[3] = 0;
+                // Skinning weights (unskinned control points bind to bone 0 with full weight)
+                const SkinInfluence influence = cpIndex >= 0 && cpIndex < vertexCount
+                    ? skinInfluences[cpIndex] : SkinInfluence{};
+                vertex.weights = XMFLOAT4(influence.weights[0], influence.weights[1],
+                                          influence.weights[2], influence.weights[3]);
+                std::copy(std::begin(influence.boneIndices), std::end(influence.boneIndices), vertex.boneIndices);
             }
             
-            vertices.push_back(vertex);
-            polyVertices.push_back(baseVertexIndex + vertexCounter);
-            vertexCounter++;
+            // Now add indices based on polygon type (quads are split into two triangles)
+            WritePolygonIndices(polySize, baseVertexIndex + firstCorner, indices + indexOffsets[polyIdx]);
         }
-        
-        // Now add indices based on polygon type
-        if (polySize == 3) {
-            // Triangle
-            indices.push_back(polyVertices[0]);
-            indices.push_back(polyVertices[1]);
-            indices.push_back(polyVertices[2]);
-        } else if (polySize == 4) {
-            // Quad - split into two triangles
-            indices.push_back(polyVertices[0]);
-            indices.push_back(polyVertices[1]);
-            indices.push_back(polyVertices[2]);
-            
-            indices.push_back(polyVertices[0]);
-            indices.push_back(polyVertices[2]);
-            indices.push_back(polyVertices[3]);
-        }
-        // Ignore polygons with more than 4 vertices for now
-    }
-    
-    // Append vertices and indices to the mesh
-    mesh.vertices.insert(mesh.vertices.end(), vertices.begin(), vertices.end());
-    mesh.indices.insert(mesh.indices.end(), indices.begin(), indices.end());
-    
-    
-    // Output bounds for debugging
-    if (!vertices.empty()) {
-        float minX = vertices[0].pos.x, maxX = vertices[0].pos.x;
-        float minY = vertices[0].pos.y, maxY = vertices[0].pos.y;
-        float minZ = vertices[0].pos.z, maxZ = vertices[0].pos.z;
-        
-        for (const auto& v : vertices) {
-            minX = (std::min)(minX, v.pos.x);
-            maxX = (std::max)(maxX, v.pos.x);
-            minY = (std::min)(minY, v.pos.y);
-            maxY = (std::max)(maxY, v.pos.y);
-            minZ = (std::min)(minZ, v.pos.z);
-            maxZ = (std::max)(maxZ, v.pos.z);
-        }
-        
-    }
+    });
     
     // Don't create buffers here - wait until all meshes are processed
 }
@@ -590,21 +529,15 @@ void FbxLoader::ExtractSkeleton(FbxNode* node, Skeleton& skel) const {
     // For now, leave animations empty
 }
 
-void FbxLoader::ExtractSkinWeights(FbxMesh* fbxMesh, std::vector<std::vector<std::pair<int, float>>>& skinWeights) const {
-    if (!fbxMesh) return;
-    
-    int skinCount = fbxMesh->GetDeformerCount(FbxDeformer::eSkin);
-    if (skinCount == 0) {
-        return;
-    }
+std::vector<SkinInfluence> FbxLoader::ExtractSkinWeights(FbxMesh* fbxMesh, int controlPointCount) const {
+    SkinInfluenceBuilder builder(static_cast<size_t>((std::max)(controlPointCount, 0)));
     
     // Process first skin deformer
-    FbxSkin* skin = static_cast<FbxSkin*>(fbxMesh->GetDeformer(0, FbxDeformer::eSkin));
-    if (!skin) return;
-    
-    int clusterCount = skin->GetClusterCount();
+    FbxSkin* skin = fbxMesh && fbxMesh->GetDeformerCount(FbxDeformer::eSkin) > 0
+        ? static_cast<FbxSkin*>(fbxMesh->GetDeformer(0, FbxDeformer::eSkin)) : nullptr;
+    int clusterCount = skin ? skin->GetClusterCount() : 0;
     
-    // Process each cluster (bone)
+    // Process each cluster (bone); the builder keeps a running top-4 per control point
     for (int clusterIdx = 0; clusterIdx < clusterCount; ++clusterIdx) {
         FbxCluster* cluster = skin->GetCluster(clusterIdx);
         if (!cluster) continue;
@@ -612,27 +545,16 @@ void FbxLoader::ExtractSkinWeights(FbxMesh* fbxMesh, std::vector<std::vector<std
         // Get the bone index (for now, use cluster index)
         int boneIndex = clusterIdx;
         
-        // Get the indices and weights
         int indexCount = cluster->GetControlPointIndicesCount();
         int* indices = cluster->GetControlPointIndices();
         double* weights = cluster->GetControlPointWeights();
-        
-        // Add weights to the corresponding control points
         for (int i = 0; i < indexCount; ++i) {
-            int vertexIndex = indices[i];
-            float weight = static_cast<float>(weights[i]);
-            
-            if (vertexIndex >= 0 && vertexIndex < skinWeights.size() && weight > 0.0f) {
-                skinWeights[vertexIndex].push_back({boneIndex, weight});
-            }
+            builder.Add(indices[i], boneIndex, weights[i]);
         }
     }
     
-    // Debug output
-    int skinnedVertices = 0;
-    for (const auto& weights : skinWeights) {
-        if (!weights.empty()) skinnedVertices++;
-    }
+    // Normalized; control points without weights keep the bone 0 default
+    return builder.Build();
 }
 
 void FbxLoader::LoadTextureFromFile(const char* fileName, IDirect3DTexture9** outTexture, IDirect3DDevice9* device, const std::filesystem::path& fbxFilePath) const {
@@ -643,7 +565,7 @@ void FbxLoader::LoadTextureFromFile(const char* fileName, IDirect3DTexture9** ou
     
     // Strategy 1: Try absolute path
     if (texturePath.is_absolute() && std::filesystem::exists(texturePath)) {
-        HRESULT hr = D3DXCreateTextureFromFileA(device, texturePath.string().c_str(), outTexture);
+        HRESULT hr = CreateModelTexture(device, texturePath, outTexture);
         if (SUCCEEDED(hr)) {
             sprintf_s(debugMsg, "FbxLoader: Loaded texture from absolute path: %s\n", texturePath.string().c_str());
             OutputDebugStringA(debugMsg);
@@ -655,7 +577,7 @@ void FbxLoader::LoadTextureFromFile(const char* fileName, IDirect3DTexture9** ou
     std::filesystem::path fbxDir = fbxFilePath.parent_path();
     std::filesystem::path relativePath = fbxDir / texturePath.filename();
     if (std::filesystem::exists(relativePath)) {
-        HRESULT hr = D3DXCreateTextureFromFileA(device, relativePath.string().c_str(), outTexture);
+        HRESULT hr = CreateModelTexture(device, relativePath, outTexture);
         if (SUCCEEDED(hr)) {
             sprintf_s(debugMsg, "FbxLoader: Loaded texture from FBX directory: %s\n", relativePath.string().c_str());
             OutputDebugStringA(debugMsg);
@@ -666,7 +588,7 @@ void FbxLoader::LoadTextureFromFile(const char* fileName, IDirect3DTexture9** ou
     // Strategy 3: Try in test directory
     std::filesystem::path testPath = "test" / texturePath.filename();
     if (std::filesystem::exists(testPath)) {
-        HRESULT hr = D3DXCreateTextureFromFileA(device, testPath.string().c_str(), outTexture);
+        HRESULT hr = CreateModelTexture(device, testPath, outTexture);
         if (SUCCEEDED(hr)) {
             sprintf_s(debugMsg, "FbxLoader: Loaded texture from test/: %s\n", testPath.string().c_str());
             OutputDebugStringA(debugMsg);
@@ -676,7 +598,7 @@ void FbxLoader::LoadTextureFromFile(const char* fileName, IDirect3DTexture9** ou
     
     // Strategy 4: Try just filename in current directory
     if (std::filesystem::exists(texturePath.filename())) {
-        HRESULT hr = D3DXCreateTextureFromFileA(device, texturePath.filename().string().c_str(), outTexture);
+        HRESULT hr = CreateModelTexture(device, texturePath.filename(), outTexture);
         if (SUCCEEDED(hr)) {
             sprintf_s(debugMsg, "FbxLoader: Loaded texture from current dir: %s\n", texturePath.filename().string().c_str());
             OutputDebugStringA(debugMsg);
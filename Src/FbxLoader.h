@@ -8,6 +8,7 @@
 #include "SkinMesh.h"
 #include "Skeleton.h"
 #include "ModelData.h"
+#include "FbxMeshConversion.h"
 
 class FbxLoader : public IModelLoader {
 public:
@@ -28,7 +29,7 @@ private:
   void ExtractMeshData(FbxMesh* fbxMesh, SkinMesh& mesh, IDirect3DDevice9* device) const;
   void ExtractMaterials(FbxNode* node, SkinMesh& mesh, IDirect3DDevice9* device, const std::filesystem::path& fbxFilePath) const;
   void ExtractSkeleton(FbxNode* node, Skeleton& skel) const;
-  void ExtractSkinWeights(FbxMesh* fbxMesh, std::vector<std::vector<std::pair<int, float>>>& skinWeights) const;
+  std::vector<SkinInfluence> ExtractSkinWeights(FbxMesh* fbxMesh, int controlPointCount) const;
   void ExtractAnimations(FbxScene* scene, Skeleton& skel) const;
   void LoadTextureFromFile(const char* fileName, IDirect3DTexture9** outTexture, IDirect3DDevice9* device, const std::filesystem::path& fbxFilePath) const;
 };
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "FbxMeshConversion.h"
+
+#include <cmath>
+
+SkinInfluenceBuilder::SkinInfluenceBuilder(size_t controlPointCount) : top_(controlPointCount) {}
+
+void SkinInfluenceBuilder::Add(int controlPoint, int bone, double weight) {
+    const float w = static_cast<float>(weight);
+    if (controlPoint < 0 || size_t(controlPoint) >= top_.size() || !(w > 0.0f) || !std::isfinite(w)) {
+        return;
+    }
+
+    // 插入排序：找到第一個權重比 w 小的位置，擠掉第 4 名
+    Top& slot = top_[size_t(controlPoint)];
+    int pos = slot.count;
+    while (pos > 0 && slot.weights[pos - 1] < w) {
+        --pos;
+    }
+    if (pos >= 4) {
+        return;
+    }
+    for (int k = (slot.count < 4 ? slot.count : 3); k > pos; --k) {
+        slot.bones[k] = slot.bones[k - 1];
+        slot.weights[k] = slot.weights[k - 1];
+    }
+    slot.bones[pos] = bone;
+    slot.weights[pos] = w;
+    if (slot.count < 4) {
+        ++slot.count;
+    }
+}
+
+std::vector<SkinInfluence> SkinInfluenceBuilder::Build() const {
+    std::vector<SkinInfluence> result(top_.size());
+    for (size_t cp = 0; cp < top_.size(); ++cp) {
+        const Top& slot = top_[cp];
+        float total = 0.0f;
+        for (int k = 0; k < slot.count; ++k) {
+            total += slot.weights[k];
+        }
+        if (!(total > 0.0f) || !std::isfinite(total)) {
+            continue;
+        }
+
+        SkinInfluence& influence = result[cp];
+        for (int k = 0; k < 4; ++k) {
+            influence.weights[k] = k < slot.count ? slot.weights[k] / total : 0.0f;
+            influence.boneIndices[k] = k < slot.count ? static_cast<uint8_t>(slot.bones[k]) : 0;
+        }
+    }
+    return result;
+}
+
+uint32_t WritePolygonIndices(int polygonSize, uint32_t firstVertex, uint32_t* out) {
+    if (polygonSize != 3 && polygonSize != 4) {
+        return 0;
+    }
+    out[0] = firstVertex;
+    out[1] = firstVertex + 1;
+    out[2] = firstVertex + 2;
+    if (polygonSize == 3) {
+        return 3;
+    }
+    out[3] = firstVertex;
+    out[4] = firstVertex + 2;
+    out[5] = firstVertex + 3;
+    return 6;
+}
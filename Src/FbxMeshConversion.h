@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// FbxLoader 轉換網格時不依賴 FBX SDK 的部分：每個控制點的骨骼影響、多邊形的輸出位置與 layer element 索引
+
+// 單一控制點最多 4 個骨骼影響，權重由大到小且總和為 1；沒有影響時綁定骨骼 0、權重 1
+struct SkinInfluence {
+    float   weights[4] = { 1.0f, 0.0f, 0.0f, 0.0f };
+    uint8_t boneIndices[4] = {};
+};
+
+// 逐 cluster 加入權重，每個控制點只保留最大的 4 個（同權重時先加入者優先），不為每個控制點配置清單
+class SkinInfluenceBuilder {
+public:
+    explicit SkinInfluenceBuilder(size_t controlPointCount);
+
+    // 超出範圍的控制點、非正值或非有限值的權重被忽略
+    void Add(int controlPoint, int bone, double weight);
+
+    // 正規化後的結果，每個控制點一筆；保留的權重總和不為正時維持預設值
+    std::vector<SkinInfluence> Build() const;
+
+private:
+    struct Top {
+        int   bones[4] = {};
+        float weights[4] = {};
+        int   count = 0;
+    };
+    std::vector<Top> top_;
+};
+
+// 多邊形的輸出位置（前綴和）：第 i 個多邊形的角寫到 corners[i]…corners[i + 1]，索引寫到 indices[i] 起
+// corners[i] + 角的序號即 FBX 的 polygon-vertex 索引（eByPolygonVertex layer 以此查詢）
+// 三角形輸出 3 個索引、四邊形 6 個；其他多邊形仍輸出角，但不輸出索引
+struct PolygonLayout {
+    std::vector<uint32_t> corners;
+    std::vector<uint32_t> indices;
+};
+
+// polygonSize(i) 回傳第 i 個多邊形的頂點數；負值視為 0
+template <typename PolygonSize>
+PolygonLayout BuildPolygonLayout(int polygonCount, PolygonSize&& polygonSize) {
+    PolygonLayout layout;
+    const size_t count = polygonCount > 0 ? size_t(polygonCount) : 0;
+    layout.corners.resize(count + 1);
+    layout.indices.resize(count + 1);
+    for (size_t i = 0; i < count; ++i) {
+        const int size = polygonSize(int(i));
+        layout.corners[i + 1] = layout.corners[i] + uint32_t(size > 0 ? size : 0);
+        layout.indices[i + 1] = layout.indices[i] + (size == 3 ? 3u : size == 4 ? 6u : 0u);
+    }
+    return layout;
+}
+
+// 寫出一個多邊形的三角形索引（四邊形切成 0-1-2、0-2-3）；firstVertex 為第一個角的頂點編號，回傳寫入數
+uint32_t WritePolygonIndices(int polygonSize, uint32_t firstVertex, uint32_t* out);
+
+// layer element 的對應方式（FBX SDK 的 eByControlPoint／eByPolygonVertex，其他方式不支援）
+enum class LayerMapping { ByControlPoint, ByPolygonVertex, Unsupported };
+
+// 一個角在 direct array 中的位置：依對應方式取控制點或 polygon-vertex 索引，indexCount >= 0 時再以 indexAt 轉一次
+// （eIndexToDirect）；不支援的對應方式或任何一步超出範圍回傳 -1
+template <typename IndexAt>
+int LayerElementIndex(LayerMapping mapping, int controlPoint, int polygonVertex, int indexCount, IndexAt&& indexAt,
+                      int directCount) {
+    int index;
+    switch (mapping) {
+        case LayerMapping::ByControlPoint: index = controlPoint; break;
+        case LayerMapping::ByPolygonVertex: index = polygonVertex; break;
+        default: return -1;
+    }
+    if (indexCount >= 0) {
+        if (index < 0 || index >= indexCount) {
+            return -1;
+        }
+        index = indexAt(index);
+    }
+    return index >= 0 && index < directCount ? index : -1;
+}
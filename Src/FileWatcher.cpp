@@ -0,0 +1,323 @@
+#include "FileWatcher.h"
+#include "ContentHash.h"
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+FileWatcher::FileWatcher(std::chrono::milliseconds debounce, std::chrono::milliseconds pollInterval)
+    : debounce_(debounce)
+    , pollInterval_(pollInterval)
+{
+}
+
+FileWatcher::~FileWatcher() {
+    Stop();
+}
+
+std::string FileWatcher::NormalizeKey(const std::string& path) {
+    std::error_code ec;
+    fs::path absolute = fs::absolute(path, ec);
+    return (ec ? fs::path(path) : absolute).lexically_normal().string();
+}
+
+void FileWatcher::Watch(const std::string& path) {
+    std::string key = NormalizeKey(path);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (files_.count(key)) {
+        return;
+    }
+
+    WatchedFile file;
+    file.path = path;
+    std::error_code ec;
+    file.mtime = fs::last_write_time(key, ec);
+    file.size = fs::file_size(key, ec);
+    if (ec) {
+        file.size = 0;
+    }
+    files_.emplace(key, std::move(file));
+
+    if (inotifyFd_ >= 0) {
+        AddDirectoryWatch(fs::path(key).parent_path());
+    }
+}
+
+void FileWatcher::Unwatch(const std::string& path) {
+    std::string key = NormalizeKey(path);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (files_.erase(key) > 0 && inotifyFd_ >= 0) {
+        RemoveDirectoryWatch(fs::path(key).parent_path());
+    }
+}
+
+size_t FileWatcher::WatchedDirectoryCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dirWatches_.size();
+}
+
+bool FileWatcher::Start(ChangeCallback callback) {
+    if (IsRunning() || !callback) {
+        return false;
+    }
+
+    callback_ = std::move(callback);
+    stop_ = false;
+
+#ifdef __linux__
+    inotifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd_ >= 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [key, file] : files_) {
+            AddDirectoryWatch(fs::path(key).parent_path());
+        }
+    }
+#endif
+
+    thread_ = std::thread(&FileWatcher::Run, this);
+    return true;
+}
+
+void FileWatcher::Stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+
+    stop_ = true;
+    thread_.join();
+
+#ifdef __linux__
+    if (inotifyFd_ >= 0) {
+        close(inotifyFd_);
+    }
+#endif
+    inotifyFd_ = -1;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    dirWatches_.clear();
+    dirWatchIds_.clear();
+}
+
+size_t FileWatcher::Flush() {
+    auto now = std::chrono::steady_clock::now();
+#ifdef __linux__
+    if (inotifyFd_ >= 0) {
+        ReadInotifyEvents(now);
+    }
+#endif
+    PollChanges(now);
+    return FlushDebounced(now, true);
+}
+
+void FileWatcher::AddDirectoryWatch(const fs::path& dir) {
+    // 注意：呼叫者需持有 mutex_
+#ifdef __linux__
+    if (inotifyFd_ < 0 || dir.empty()) {
+        return;
+    }
+    auto existing = dirWatchIds_.find(dir.string());
+    if (existing != dirWatchIds_.end()) {
+        dirWatches_[existing->second].files++;
+        return;
+    }
+    int wd = inotify_add_watch(inotifyFd_, dir.c_str(),
+                               IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE);
+    if (wd >= 0) {
+        dirWatches_[wd] = DirectoryWatch{ dir.string(), 1 };
+        dirWatchIds_[dir.string()] = wd;
+    }
+#else
+    (void)dir;
+#endif
+}
+
+void FileWatcher::RemoveDirectoryWatch(const fs::path& dir) {
+    // 注意：呼叫者需持有 mutex_
+#ifdef __linux__
+    auto id = dirWatchIds_.find(dir.string());
+    if (id == dirWatchIds_.end()) {
+        return;
+    }
+    auto watch = dirWatches_.find(id->second);
+    if (watch != dirWatches_.end() && --watch->second.files > 0) {
+        return;
+    }
+    // 之後送達的 IN_IGNORED 找不到 wd，直接略過
+    inotify_rm_watch(inotifyFd_, id->second);
+    if (watch != dirWatches_.end()) {
+        dirWatches_.erase(watch);
+    }
+    dirWatchIds_.erase(id);
+#else
+    (void)dir;
+#endif
+}
+
+void FileWatcher::Run() {
+    while (!stop_) {
+#ifdef __linux__
+        if (inotifyFd_ >= 0) {
+            pollfd pfd{ inotifyFd_, POLLIN, 0 };
+            int ready = poll(&pfd, 1, static_cast<int>(pollInterval_.count()));
+            auto now = std::chrono::steady_clock::now();
+            if (ready > 0 && (pfd.revents & POLLIN)) {
+                ReadInotifyEvents(now);
+            }
+            FlushDebounced(now);
+            continue;
+        }
+#endif
+        std::this_thread::sleep_for(pollInterval_);
+        auto now = std::chrono::steady_clock::now();
+        PollChanges(now);
+        FlushDebounced(now);
+    }
+}
+
+void FileWatcher::PollChanges(std::chrono::steady_clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [key, file] : files_) {
+        std::error_code ec;
+        auto mtime = fs::last_write_time(key, ec);
+        if (ec) {
+            continue;   // 存檔過程中暫時不存在
+        }
+        uintmax_t size = fs::file_size(key, ec);
+        if (ec) {
+            continue;
+        }
+        if (mtime != file.mtime || size != file.size) {
+            file.mtime = mtime;
+            file.size = size;
+            file.pending = true;
+            file.lastEvent = now;
+        }
+    }
+}
+
+void FileWatcher::ReadInotifyEvents(std::chrono::steady_clock::time_point now) {
+#ifdef __linux__
+    alignas(inotify_event) char buffer[4096];
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (;;) {
+        ssize_t len = read(inotifyFd_, buffer, sizeof(buffer));
+        if (len <= 0) {
+            break;
+        }
+
+        for (char* p = buffer; p < buffer + len;) {
+            const auto* ev = reinterpret_cast<const inotify_event*>(p);
+            p += sizeof(inotify_event) + ev->len;
+
+            if (ev->mask & IN_Q_OVERFLOW) {
+                // 事件遺失：全部重新比對
+                for (auto& [key, file] : files_) {
+                    file.pending = true;
+                    file.lastEvent = now;
+                }
+                continue;
+            }
+            if (ev->mask & IN_IGNORED) {
+                // 目錄被刪除或移走，inotify 已自動移除監控
+                auto watch = dirWatches_.find(ev->wd);
+                if (watch != dirWatches_.end()) {
+                    dirWatchIds_.erase(watch->second.dir);
+                    dirWatches_.erase(watch);
+                }
+                continue;
+            }
+            if (ev->len == 0) {
+                continue;
+            }
+
+            auto dir = dirWatches_.find(ev->wd);
+            if (dir == dirWatches_.end()) {
+                continue;
+            }
+            std::string key = (fs::path(dir->second.dir) / ev->name).lexically_normal().string();
+            auto it = files_.find(key);
+            if (it != files_.end()) {
+                it->second.pending = true;
+                it->second.lastEvent = now;
+            }
+        }
+    }
+#else
+    (void)now;
+#endif
+}
+
+size_t FileWatcher::FlushDebounced(std::chrono::steady_clock::time_point now, bool force) {
+    // 監控執行緒取出的變更回報完之前，Flush 不會返回
+    std::lock_guard<std::mutex> flush(flushMutex_);
+    std::vector<std::string> ready;
+    std::vector<std::string> baseline;
+    size_t reported = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [key, file] : files_) {
+            if (file.pending) {
+                if (force || now - file.lastEvent >= debounce_) {
+                    file.pending = false;
+                    ready.push_back(key);
+                }
+            } else if (!file.hashKnown) {
+                baseline.push_back(key);
+            }
+        }
+    }
+
+    // 首次監控時在背景建立內容雜湊基準，避免在載入執行緒上讀整個檔案
+    for (const auto& key : baseline) {
+        uint64_t hash = HashFile(key);
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = files_.find(key);
+        if (it != files_.end() && !it->second.hashKnown && !it->second.pending && hash != 0) {
+            it->second.hash = hash;
+            it->second.hashKnown = true;
+        }
+    }
+
+    for (const auto& key : ready) {
+        uint64_t hash = HashFile(key);
+        if (hash == 0) {
+            continue;   // 讀取失敗（檔案被刪除或仍被鎖定）
+        }
+
+        std::string path;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = files_.find(key);
+            if (it == files_.end()) {
+                continue;
+            }
+            WatchedFile& file = it->second;
+            bool changed = !file.hashKnown || file.hash != hash;
+            file.hash = hash;
+            file.hashKnown = true;
+
+            std::error_code ec;
+            file.mtime = fs::last_write_time(key, ec);
+            file.size = fs::file_size(key, ec);
+            if (!changed) {
+                continue;   // 內容未變的存檔，略過
+            }
+            path = file.path;
+        }
+
+        if (callback_) {
+            callback_(path);
+            ++reported;
+        }
+    }
+    return reported;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// 檔案監控器
+// - Linux 使用 inotify 監控所在目錄，其他平台或 inotify 失敗時退回 mtime/大小輪詢
+// - 連續的變更事件會合併（debounce），靜止一段時間後才回報
+// - 回報前比對內容雜湊，內容沒變的存檔不會觸發回呼
+// 回呼在監控執行緒上執行，呼叫端需自行轉交到正確的執行緒
+class FileWatcher {
+public:
+    using ChangeCallback = std::function<void(const std::string& path)>;
+
+    explicit FileWatcher(std::chrono::milliseconds debounce = std::chrono::milliseconds(250),
+                         std::chrono::milliseconds pollInterval = std::chrono::milliseconds(250));
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    // 加入/移除監控檔案；可在執行中呼叫
+    void Watch(const std::string& path);
+    void Unwatch(const std::string& path);
+
+    bool Start(ChangeCallback callback);
+    void Stop();
+
+    // 在呼叫端執行緒立即處理一次：讀取待處理的事件並比對 mtime/大小、補建內容雜湊基準，
+    // 不等 debounce 就回報所有待回報的變更，回傳本次回報的數量。
+    // 與監控執行緒的回報互斥，返回時在此之前寫入的變更都已回報（供測試與需要同步結果的工具使用）
+    size_t Flush();
+
+    bool IsRunning() const { return thread_.joinable(); }
+    bool UsesInotify() const { return inotifyFd_ >= 0; }
+
+    // 目前持有的 inotify 目錄監控數；目錄中最後一個檔案 Unwatch 時即移除
+    size_t WatchedDirectoryCount() const;
+
+private:
+    struct WatchedFile {
+        std::string path;                               // 呼叫端註冊的原始路徑
+        std::filesystem::file_time_type mtime{};
+        uintmax_t size = 0;
+        uint64_t hash = 0;
+        bool hashKnown = false;
+        bool pending = false;
+        std::chrono::steady_clock::time_point lastEvent{};
+    };
+
+    static std::string NormalizeKey(const std::string& path);
+
+    void Run();
+    void PollChanges(std::chrono::steady_clock::time_point now);
+    void ReadInotifyEvents(std::chrono::steady_clock::time_point now);
+    size_t FlushDebounced(std::chrono::steady_clock::time_point now, bool force = false);
+    void AddDirectoryWatch(const std::filesystem::path& dir);
+    void RemoveDirectoryWatch(const std::filesystem::path& dir);
+
+    std::chrono::milliseconds debounce_;
+    std::chrono::milliseconds pollInterval_;
+
+    // 同一目錄只加一次 inotify 監控，以目錄中受監控的檔案數計數
+    struct DirectoryWatch {
+        std::string dir;
+        size_t files = 0;
+    };
+
+    mutable std::mutex mutex_;
+    std::mutex flushMutex_;                                 // 序列化 FlushDebounced（監控執行緒與 Flush）
+    std::unordered_map<std::string, WatchedFile> files_;   // 正規化路徑 -> 狀態
+    std::unordered_map<int, DirectoryWatch> dirWatches_;    // inotify wd -> 目錄
+    std::unordered_map<std::string, int> dirWatchIds_;      // 目錄 -> inotify wd
+
+    ChangeCallback callback_;
+    std::thread thread_;
+    std::atomic<bool> stop_{ false };
+    int inotifyFd_ = -1;
+};
@@ -0,0 +1,433 @@
+#include "GltfAccessor.h"
+#include "tiny_gltf.h"
+#include <algorithm>
+#include <cstdint>
+#include <format>
+#include <stdexcept>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define GLTF_ACCESSOR_SSE2 1
+#endif
+
+size_t GltfComponentSize(GltfComponentType type) {
+    switch (type) {
+        case GltfComponentType::Byte:
+        case GltfComponentType::UnsignedByte:
+            return 1;
+        case GltfComponentType::Short:
+        case GltfComponentType::UnsignedShort:
+            return 2;
+        default:
+            return 4;
+    }
+}
+
+bool GltfAccessorMatches(const GltfAccessorDesc& desc, int components, bool integerTarget) {
+    return desc.components == components && !(integerTarget && desc.componentType == GltfComponentType::Float);
+}
+
+namespace {
+
+template <typename T>
+T Load(const uint8_t* p) {
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    return v;
+}
+
+// glTF 2.0 規範 3.11：normalized 整數轉浮點數
+float Normalized(GltfComponentType type, const uint8_t* p) {
+    switch (type) {
+        case GltfComponentType::Byte:
+            return std::max(Load<int8_t>(p) / 127.0f, -1.0f);
+        case GltfComponentType::UnsignedByte:
+            return *p / 255.0f;
+        case GltfComponentType::Short:
+            return std::max(Load<int16_t>(p) / 32767.0f, -1.0f);
+        case GltfComponentType::UnsignedShort:
+            return Load<uint16_t>(p) / 65535.0f;
+        case GltfComponentType::UnsignedInt:
+            return static_cast<float>(Load<uint32_t>(p) / 4294967295.0);
+        default:
+            return Load<float>(p);
+    }
+}
+
+float Unnormalized(GltfComponentType type, const uint8_t* p) {
+    switch (type) {
+        case GltfComponentType::Byte:
+            return Load<int8_t>(p);
+        case GltfComponentType::UnsignedByte:
+            return *p;
+        case GltfComponentType::Short:
+            return Load<int16_t>(p);
+        case GltfComponentType::UnsignedShort:
+            return Load<uint16_t>(p);
+        case GltfComponentType::UnsignedInt:
+            return static_cast<float>(Load<uint32_t>(p));
+        default:
+            return Load<float>(p);
+    }
+}
+
+uint32_t ToUInt(GltfComponentType type, const uint8_t* p) {
+    switch (type) {
+        case GltfComponentType::Byte:
+            return static_cast<uint32_t>(Load<int8_t>(p));
+        case GltfComponentType::UnsignedByte:
+            return *p;
+        case GltfComponentType::Short:
+            return static_cast<uint32_t>(Load<int16_t>(p));
+        case GltfComponentType::UnsignedShort:
+            return Load<uint16_t>(p);
+        default:
+            return Load<uint32_t>(p);
+    }
+}
+
+void ConvertElement(const GltfAccessorDesc& d, const uint8_t* src, float* out) {
+    size_t size = GltfComponentSize(d.componentType);
+    for (int c = 0; c < d.components; ++c) {
+        out[c] = d.normalized ? Normalized(d.componentType, src + c * size)
+                              : Unnormalized(d.componentType, src + c * size);
+    }
+}
+
+void ConvertElement(const GltfAccessorDesc& d, const uint8_t* src, uint32_t* out) {
+    size_t size = GltfComponentSize(d.componentType);
+    for (int c = 0; c < d.components; ++c) {
+        out[c] = ToUInt(d.componentType, src + c * size);
+    }
+}
+
+template <typename Scalar>
+Scalar* At(Scalar* dst, size_t dstStride, size_t index) {
+    return reinterpret_cast<Scalar*>(reinterpret_cast<uint8_t*>(dst) + index * dstStride);
+}
+
+template <typename Scalar>
+void ApplySparse(const GltfAccessorDesc& d, Scalar* dst, size_t dstStride) {
+    size_t indexSize = GltfComponentSize(d.sparseIndexType);
+    size_t elementSize = GltfComponentSize(d.componentType) * d.components;
+    for (size_t k = 0; k < d.sparseCount; ++k) {
+        size_t index = ToUInt(d.sparseIndexType, d.sparseIndices + k * indexSize);
+        if (index < d.count) {
+            ConvertElement(d, d.sparseValues + k * elementSize, At(dst, dstStride, index));
+        }
+    }
+}
+
+template <typename Scalar>
+void FillZero(const GltfAccessorDesc& d, Scalar* dst, size_t dstStride) {
+    for (size_t i = 0; i < d.count; ++i) {
+        std::memset(At(dst, dstStride, i), 0, sizeof(Scalar) * d.components);
+    }
+}
+
+template <typename Scalar>
+void ConvertGeneric(const GltfAccessorDesc& d, Scalar* dst, size_t dstStride) {
+    for (size_t i = 0; i < d.count; ++i) {
+        ConvertElement(d, d.data + i * d.stride, At(dst, dstStride, i));
+    }
+}
+
+// 交錯的 float 屬性：固定大小的 memcpy 讓編譯器展開成一般的載入／儲存，不必每個元素呼叫一次 memcpy
+template <int Components>
+void CopyStrided(const GltfAccessorDesc& d, float* dst, size_t dstStride) {
+    for (size_t i = 0; i < d.count; ++i) {
+        std::memcpy(At(dst, dstStride, i), d.data + i * d.stride, sizeof(float) * Components);
+    }
+}
+
+#if GLTF_ACCESSOR_SSE2
+// 4 個 8/16 位元無號整數 → 4 個 32 位元整數
+inline __m128i WidenU8x4(const uint8_t* p) {
+    __m128i v = _mm_cvtsi32_si128(Load<int32_t>(p));
+    __m128i zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(v, zero), zero);
+}
+
+inline __m128i WidenU16x4(const uint8_t* p) {
+    __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+    return _mm_unpacklo_epi16(v, _mm_setzero_si128());
+}
+#endif
+
+// normalized 無號 VEC4（頂點色、WEIGHTS_0）：每個元素一次轉換 4 個元件
+// 用除法而不是乘倒數，結果與逐元件的 Normalized 逐位元相同（乘倒數時約半數的 8 位元值差 1 ulp）
+bool ConvertUnormVec4(const GltfAccessorDesc& d, float* dst, size_t dstStride) {
+#if GLTF_ACCESSOR_SSE2
+    if (d.components != 4 || !d.normalized) {
+        return false;
+    }
+    if (d.componentType == GltfComponentType::UnsignedByte) {
+        const __m128 scale = _mm_set1_ps(255.0f);
+        for (size_t i = 0; i < d.count; ++i) {
+            __m128 v = _mm_cvtepi32_ps(WidenU8x4(d.data + i * d.stride));
+            _mm_storeu_ps(At(dst, dstStride, i), _mm_div_ps(v, scale));
+        }
+        return true;
+    }
+    if (d.componentType == GltfComponentType::UnsignedShort) {
+        const __m128 scale = _mm_set1_ps(65535.0f);
+        for (size_t i = 0; i < d.count; ++i) {
+            __m128 v = _mm_cvtepi32_ps(WidenU16x4(d.data + i * d.stride));
+            _mm_storeu_ps(At(dst, dstStride, i), _mm_div_ps(v, scale));
+        }
+        return true;
+    }
+#endif
+    (void)d;
+    (void)dst;
+    (void)dstStride;
+    return false;
+}
+
+// 緊密排列的 8/16 位元索引 → uint32_t：每次迴圈展開 16/8 個
+bool ConvertPackedIndices(const GltfAccessorDesc& d, uint32_t* dst, size_t dstStride) {
+    if (d.components != 1 || dstStride != sizeof(uint32_t) ||
+        d.stride != GltfComponentSize(d.componentType)) {
+        return false;
+    }
+    size_t i = 0;
+    switch (d.componentType) {
+        case GltfComponentType::UnsignedInt:
+            std::memcpy(dst, d.data, d.count * sizeof(uint32_t));
+            return true;
+        case GltfComponentType::UnsignedShort:
+#if GLTF_ACCESSOR_SSE2
+            for (const __m128i zero = _mm_setzero_si128(); i + 8 <= d.count; i += 8) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d.data + i * 2));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi16(v, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4), _mm_unpackhi_epi16(v, zero));
+            }
+#endif
+            for (; i < d.count; ++i) {
+                dst[i] = Load<uint16_t>(d.data + i * 2);
+            }
+            return true;
+        case GltfComponentType::UnsignedByte:
+#if GLTF_ACCESSOR_SSE2
+            for (const __m128i zero = _mm_setzero_si128(); i + 16 <= d.count; i += 16) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d.data + i));
+                __m128i lo = _mm_unpacklo_epi8(v, zero);
+                __m128i hi = _mm_unpackhi_epi8(v, zero);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi16(lo, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4), _mm_unpackhi_epi16(lo, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), _mm_unpacklo_epi16(hi, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 12), _mm_unpackhi_epi16(hi, zero));
+            }
+#endif
+            for (; i < d.count; ++i) {
+                dst[i] = d.data[i];
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+// JOINTS_0：8/16 位元 VEC4 → XMUINT4
+bool ConvertJoints(const GltfAccessorDesc& d, uint32_t* dst, size_t dstStride) {
+#if GLTF_ACCESSOR_SSE2
+    if (d.components != 4) {
+        return false;
+    }
+    if (d.componentType == GltfComponentType::UnsignedByte) {
+        for (size_t i = 0; i < d.count; ++i) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(At(dst, dstStride, i)), WidenU8x4(d.data + i * d.stride));
+        }
+        return true;
+    }
+    if (d.componentType == GltfComponentType::UnsignedShort) {
+        for (size_t i = 0; i < d.count; ++i) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(At(dst, dstStride, i)), WidenU16x4(d.data + i * d.stride));
+        }
+        return true;
+    }
+#endif
+    (void)d;
+    (void)dst;
+    (void)dstStride;
+    return false;
+}
+
+} // namespace
+
+void GltfConvertAccessor(const GltfAccessorDesc& desc, float* dst, size_t dstStride) {
+    if (!desc.data) {
+        FillZero(desc, dst, dstStride);
+    } else if (desc.componentType == GltfComponentType::Float) {
+        size_t elementSize = sizeof(float) * desc.components;
+        if (desc.stride == elementSize && dstStride == elementSize) {
+            std::memcpy(dst, desc.data, desc.count * elementSize);
+        } else {
+            switch (desc.components) {
+                case 2: CopyStrided<2>(desc, dst, dstStride); break;
+                case 3: CopyStrided<3>(desc, dst, dstStride); break;
+                case 4: CopyStrided<4>(desc, dst, dstStride); break;
+                default:
+                    for (size_t i = 0; i < desc.count; ++i) {
+                        std::memcpy(At(dst, dstStride, i), desc.data + i * desc.stride, elementSize);
+                    }
+                    break;
+            }
+        }
+    } else if (!ConvertUnormVec4(desc, dst, dstStride)) {
+        ConvertGeneric(desc, dst, dstStride);
+    }
+    ApplySparse(desc, dst, dstStride);
+}
+
+void GltfConvertAccessor(const GltfAccessorDesc& desc, uint32_t* dst, size_t dstStride) {
+    if (!desc.data) {
+        FillZero(desc, dst, dstStride);
+    } else if (!ConvertPackedIndices(desc, dst, dstStride) && !ConvertJoints(desc, dst, dstStride)) {
+        ConvertGeneric(desc, dst, dstStride);
+    }
+    ApplySparse(desc, dst, dstStride);
+}
+
+int GltfTypeComponents(std::string_view type) {
+    if (type == "SCALAR") return 1;
+    if (type == "VEC2") return 2;
+    if (type == "VEC3") return 3;
+    if (type == "VEC4") return 4;
+    if (type == "MAT4") return 16;
+    return 0;   // MAT2/MAT3 的欄需對齊 4 位元組，目前沒有使用者
+}
+
+namespace {
+
+int ComponentCount(int type) {
+    switch (type) {
+        case TINYGLTF_TYPE_SCALAR: return 1;
+        case TINYGLTF_TYPE_VEC2: return 2;
+        case TINYGLTF_TYPE_VEC3: return 3;
+        case TINYGLTF_TYPE_VEC4: return 4;
+        case TINYGLTF_TYPE_MAT4: return 16;
+        default: return 0;
+    }
+}
+
+bool IsComponentType(int type) {
+    switch (static_cast<GltfComponentType>(type)) {
+        case GltfComponentType::Byte:
+        case GltfComponentType::UnsignedByte:
+        case GltfComponentType::Short:
+        case GltfComponentType::UnsignedShort:
+        case GltfComponentType::UnsignedInt:
+        case GltfComponentType::Float:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// 回傳 bufferView 內 [offset, offset + bytes) 的起始位址，超出範圍時拋出例外
+const uint8_t* ViewRange(const GltfBufferViewRange& view, int viewIndex, size_t offset, size_t bytes) {
+    if (offset > view.size || bytes > view.size - offset) {
+        throw std::runtime_error(std::format("glTF: bufferView {} 的資料超出範圍", viewIndex));
+    }
+    return view.data + offset;
+}
+
+// 兩種模型表示共用的建立流程；resolveView(index) 回傳已檢查過範圍的 bufferView
+template <typename ResolveView>
+GltfAccessorDesc Describe(const GltfAccessorFields& fields, int accessorIndex, ResolveView&& resolveView) {
+    if (fields.components == 0 || !IsComponentType(fields.componentType)) {
+        throw std::runtime_error(std::format("glTF: accessor {} 的型別不支援", accessorIndex));
+    }
+
+    GltfAccessorDesc desc;
+    desc.count = fields.count;
+    desc.componentType = static_cast<GltfComponentType>(fields.componentType);
+    desc.components = fields.components;
+    desc.normalized = fields.normalized;
+    size_t elementSize = GltfComponentSize(desc.componentType) * fields.components;
+
+    if (fields.bufferView >= 0) {
+        GltfBufferViewRange view = resolveView(fields.bufferView);
+        desc.stride = view.byteStride ? view.byteStride : elementSize;
+        if (desc.stride < elementSize) {
+            throw std::runtime_error(std::format("glTF: accessor {} 的 byteStride 小於元素大小", accessorIndex));
+        }
+        if (desc.count > 0 && desc.count - 1 > (SIZE_MAX - elementSize) / desc.stride) {
+            throw std::runtime_error(std::format("glTF: accessor {} 的 count 無效", accessorIndex));
+        }
+        size_t bytes = desc.count ? (desc.count - 1) * desc.stride + elementSize : 0;
+        desc.data = ViewRange(view, fields.bufferView, fields.byteOffset, bytes);
+    } else {
+        desc.stride = elementSize;
+    }
+
+    if (fields.sparseCount > 0) {
+        desc.sparseCount = fields.sparseCount;
+        desc.sparseIndexType = static_cast<GltfComponentType>(fields.sparseIndexType);
+        if (desc.sparseIndexType != GltfComponentType::UnsignedByte &&
+            desc.sparseIndexType != GltfComponentType::UnsignedShort &&
+            desc.sparseIndexType != GltfComponentType::UnsignedInt) {
+            throw std::runtime_error(std::format("glTF: accessor {} 的 sparse 索引型別無效", accessorIndex));
+        }
+        if (desc.sparseCount > SIZE_MAX / elementSize) {
+            throw std::runtime_error(std::format("glTF: accessor {} 的 sparse count 無效", accessorIndex));
+        }
+        desc.sparseIndices = ViewRange(resolveView(fields.sparseIndicesView), fields.sparseIndicesView,
+                                       fields.sparseIndicesOffset,
+                                       desc.sparseCount * GltfComponentSize(desc.sparseIndexType));
+        desc.sparseValues = ViewRange(resolveView(fields.sparseValuesView), fields.sparseValuesView,
+                                      fields.sparseValuesOffset, desc.sparseCount * elementSize);
+    }
+    return desc;
+}
+
+} // namespace
+
+GltfAccessorDesc DescribeGltfAccessor(const tinygltf::Model& model, int accessorIndex) {
+    if (accessorIndex < 0 || static_cast<size_t>(accessorIndex) >= model.accessors.size()) {
+        throw std::runtime_error(std::format("glTF: accessor {} 不存在", accessorIndex));
+    }
+    const auto& acc = model.accessors[accessorIndex];
+
+    GltfAccessorFields fields;
+    fields.bufferView = acc.bufferView;
+    fields.byteOffset = acc.byteOffset;
+    fields.count = acc.count;
+    fields.componentType = acc.componentType;
+    fields.components = ComponentCount(acc.type);
+    fields.normalized = acc.normalized;
+    if (acc.sparse.isSparse && acc.sparse.count > 0) {
+        fields.sparseCount = static_cast<size_t>(acc.sparse.count);
+        fields.sparseIndicesView = acc.sparse.indices.bufferView;
+        fields.sparseIndicesOffset = acc.sparse.indices.byteOffset;
+        fields.sparseIndexType = acc.sparse.indices.componentType;
+        fields.sparseValuesView = acc.sparse.values.bufferView;
+        fields.sparseValuesOffset = acc.sparse.values.byteOffset;
+    }
+
+    return Describe(fields, accessorIndex, [&model](int viewIndex) {
+        if (viewIndex < 0 || static_cast<size_t>(viewIndex) >= model.bufferViews.size()) {
+            throw std::runtime_error(std::format("glTF: bufferView {} 不存在", viewIndex));
+        }
+        const auto& view = model.bufferViews[viewIndex];
+        if (view.buffer < 0 || static_cast<size_t>(view.buffer) >= model.buffers.size()) {
+            throw std::runtime_error(std::format("glTF: buffer {} 不存在", view.buffer));
+        }
+        const auto& buffer = model.buffers[view.buffer].data;
+        if (view.byteOffset > buffer.size() || view.byteLength > buffer.size() - view.byteOffset) {
+            throw std::runtime_error(std::format("glTF: bufferView {} 的資料超出緩衝區", viewIndex));
+        }
+        return GltfBufferViewRange{ buffer.data() + view.byteOffset, view.byteLength, view.byteStride };
+    });
+}
+
+GltfAccessorDesc DescribeGltfAccessor(const GltfAccessorFields& fields, int accessorIndex,
+                                      std::span<const GltfBufferViewRange> views) {
+    return Describe(fields, accessorIndex, [views](int viewIndex) {
+        if (viewIndex < 0 || static_cast<size_t>(viewIndex) >= views.size()) {
+            throw std::runtime_error(std::format("glTF: bufferView {} 不存在", viewIndex));
+        }
+        return views[viewIndex];
+    });
+}
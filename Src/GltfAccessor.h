@@ -0,0 +1,192 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace tinygltf {
+class Model;
+}
+
+// glTF accessor.componentType
+enum class GltfComponentType : int {
+    Byte = 5120,
+    UnsignedByte = 5121,
+    Short = 5122,
+    UnsignedShort = 5123,
+    UnsignedInt = 5125,
+    Float = 5126,
+};
+
+// accessor 在記憶體中的位置與格式，與資料來源（tinygltf 緩衝區或直接對應的 GLB）無關
+// 建立者負責檢查範圍：所有指標在 count 個元素內都必須可讀
+struct GltfAccessorDesc {
+    const uint8_t* data = nullptr;   // 第一個元素；沒有 bufferView 時為 nullptr，元素皆為 0
+    size_t count = 0;
+    size_t stride = 0;               // 相鄰元素間隔的位元組數（已套用預設的緊密排列）
+    GltfComponentType componentType = GltfComponentType::Float;
+    int components = 0;              // SCALAR = 1、VEC2 = 2、VEC3 = 3、VEC4 = 4、MAT4 = 16
+    bool normalized = false;
+
+    // sparse：以 sparseValues 的元素取代 sparseIndices 指定的位置（索引遞增排列）
+    size_t sparseCount = 0;
+    const uint8_t* sparseIndices = nullptr;
+    GltfComponentType sparseIndexType = GltfComponentType::UnsignedInt;
+    const uint8_t* sparseValues = nullptr;
+};
+
+// 已對應到記憶體並確認落在所屬 buffer 內的 bufferView
+struct GltfBufferViewRange {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    size_t byteStride = 0;           // 0 表示緊密排列
+};
+
+// accessor 的 JSON 欄位，與模型表示（tinygltf 或直接解析的 JSON）無關
+struct GltfAccessorFields {
+    int bufferView = -1;
+    size_t byteOffset = 0;
+    size_t count = 0;
+    int componentType = 0;
+    int components = 0;              // 由 GltfTypeComponents 取得；0 表示不支援的 type
+    bool normalized = false;
+
+    size_t sparseCount = 0;
+    int sparseIndicesView = -1;
+    size_t sparseIndicesOffset = 0;
+    int sparseIndexType = 0;
+    int sparseValuesView = -1;
+    size_t sparseValuesOffset = 0;
+};
+
+size_t GltfComponentSize(GltfComponentType type);
+
+// accessor.type 字串（"SCALAR"、"VEC3"…）的元件數；不支援時回傳 0
+int GltfTypeComponents(std::string_view type);
+
+// 由 tinygltf 模型建立描述；索引無效、型別不支援或資料超出緩衝區時拋出 std::runtime_error
+GltfAccessorDesc DescribeGltfAccessor(const tinygltf::Model& model, int accessorIndex);
+
+// 由 accessor 欄位與預先解析的 bufferView 建立描述（例如 GltfDocument 直接對應的 GLB），檢查規則同上
+GltfAccessorDesc DescribeGltfAccessor(const GltfAccessorFields& fields, int accessorIndex,
+                                      std::span<const GltfBufferViewRange> views);
+
+// 批次轉換核心：將 desc 的每個元素轉為 components 個 float／uint32_t，
+// 寫入 dst 起算每隔 dstStride 位元組的位置（可直接寫入交錯的頂點欄位），並套用 sparse
+// normalized 整數依 glTF 規範轉為 [0, 1] 或 [-1, 1]；非 normalized 整數直接轉型
+void GltfConvertAccessor(const GltfAccessorDesc& desc, float* dst, size_t dstStride);
+void GltfConvertAccessor(const GltfAccessorDesc& desc, uint32_t* dst, size_t dstStride);
+
+// 目的元素型別：Scalar 為每個元件的型別，Components 必須等於 accessor 的元件數
+template <typename T> struct GltfElementTraits;
+template <> struct GltfElementTraits<float> { using Scalar = float; static constexpr int Components = 1; };
+template <> struct GltfElementTraits<uint32_t> { using Scalar = uint32_t; static constexpr int Components = 1; };
+template <> struct GltfElementTraits<DirectX::XMFLOAT2> { using Scalar = float; static constexpr int Components = 2; };
+template <> struct GltfElementTraits<DirectX::XMFLOAT3> { using Scalar = float; static constexpr int Components = 3; };
+template <> struct GltfElementTraits<DirectX::XMFLOAT4> { using Scalar = float; static constexpr int Components = 4; };
+template <> struct GltfElementTraits<DirectX::XMFLOAT4X4> { using Scalar = float; static constexpr int Components = 16; };
+template <> struct GltfElementTraits<DirectX::XMUINT4> { using Scalar = uint32_t; static constexpr int Components = 4; };
+
+bool GltfAccessorMatches(const GltfAccessorDesc& desc, int components, bool integerTarget);
+
+// 型別化的 accessor 檢視：處理 byteStride、元件型別、normalized 與 sparse
+// MAT4 以 glTF 的欄主序直接複製，對 XMFLOAT4X4（列向量慣例）即為正確的矩陣
+template <typename T>
+class AccessorSpan {
+public:
+    using Traits = GltfElementTraits<T>;
+    using Scalar = typename Traits::Scalar;
+
+    AccessorSpan() = default;
+
+    // 元件數不符或無法轉成 Scalar（例如 float 資料讀成 uint32_t）時 valid() 為 false
+    explicit AccessorSpan(const GltfAccessorDesc& desc)
+        : desc_(desc), valid_(GltfAccessorMatches(desc, Traits::Components, !std::is_same_v<Scalar, float>)) {
+    }
+
+    bool valid() const noexcept { return valid_; }
+    size_t size() const noexcept { return valid_ ? desc_.count : 0; }
+    bool empty() const noexcept { return size() == 0; }
+    const GltfAccessorDesc& desc() const noexcept { return desc_; }
+
+    // 批次轉換到 dst，元素間隔 dstStride 位元組，例如 CopyTo(&vertices[0].pos, sizeof(Vertex))
+    void CopyTo(T* dst, size_t dstStride = sizeof(T)) const {
+        if (valid_ && desc_.count > 0) {
+            GltfConvertAccessor(desc_, reinterpret_cast<Scalar*>(dst), dstStride);
+        }
+    }
+
+    std::vector<T> ToVector() const {
+        std::vector<T> out(size());
+        CopyTo(out.data());
+        return out;
+    }
+
+    // 單一元素存取；大量讀取請使用 CopyTo
+    T operator[](size_t index) const {
+        T value{};
+        if (index < size()) {
+            GltfAccessorDesc one = desc_;
+            one.count = 1;
+            one.data = desc_.data ? desc_.data + index * desc_.stride : nullptr;
+            one.sparseCount = 0;
+            size_t sparse = FindSparse(index);
+            if (sparse != kNoSparse) {
+                one.data = desc_.sparseValues + sparse * ElementSize();
+            }
+            GltfConvertAccessor(one, reinterpret_cast<Scalar*>(&value), sizeof(T));
+        }
+        return value;
+    }
+
+private:
+    static constexpr size_t kNoSparse = ~size_t(0);
+
+    size_t ElementSize() const {
+        return GltfComponentSize(desc_.componentType) * desc_.components;
+    }
+
+    size_t SparseIndexAt(size_t k) const {
+        const uint8_t* p = desc_.sparseIndices + k * GltfComponentSize(desc_.sparseIndexType);
+        switch (desc_.sparseIndexType) {
+            case GltfComponentType::UnsignedByte:
+                return *p;
+            case GltfComponentType::UnsignedShort: {
+                uint16_t v;
+                std::memcpy(&v, p, sizeof(v));
+                return v;
+            }
+            default: {
+                uint32_t v;
+                std::memcpy(&v, p, sizeof(v));
+                return v;
+            }
+        }
+    }
+
+    size_t FindSparse(size_t index) const {
+        size_t lo = 0;
+        size_t hi = desc_.sparseCount;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            size_t at = SparseIndexAt(mid);
+            if (at == index) {
+                return mid;
+            }
+            if (at < index) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return kNoSparse;
+    }
+
+    GltfAccessorDesc desc_;
+    bool valid_ = false;
+};
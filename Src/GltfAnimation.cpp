@@ -0,0 +1,456 @@
+#include "GltfAnimation.h"
+#include <DirectXMath.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <format>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+using namespace DirectX;
+
+namespace {
+
+enum class Interpolation { Step, Linear, CubicSpline };
+
+// 軌道路徑，同時作為每個 joint 軌道表的索引
+enum TrackPath { kTranslation = 0, kRotation = 1, kScale = 2, kPathCount = 3 };
+
+// 已解碼的取樣軌道；CUBICSPLINE 每個 key 有三筆值（in-tangent、值、out-tangent）
+// translation／scale 也以 XMFLOAT4 儲存（w 為 0），取樣時可直接載入 SIMD 暫存器
+struct Track {
+    TrackPath path = kTranslation;
+    Interpolation interpolation = Interpolation::Linear;
+    std::vector<float> times;
+    std::vector<XMFLOAT4> values;
+};
+
+struct RestPose {
+    XMFLOAT4 translation = { 0.0f, 0.0f, 0.0f, 0.0f };
+    XMFLOAT4 rotation = { 0.0f, 0.0f, 0.0f, 1.0f };
+    XMFLOAT4 scale = { 1.0f, 1.0f, 1.0f, 0.0f };
+};
+
+int IndexValue(const nlohmann::json& object, const char* key) {
+    auto it = object.find(key);
+    return it != object.end() && it->is_number_integer() ? it->get<int>() : -1;
+}
+
+// 讀取固定長度的數字陣列；不存在或長度不符時回傳 false
+template <size_t N>
+bool ReadFloats(const nlohmann::json& object, const char* key, std::array<float, N>& out) {
+    auto it = object.find(key);
+    if (it == object.end() || !it->is_array() || it->size() != N) {
+        return false;
+    }
+    for (size_t i = 0; i < N; ++i) {
+        if (!(*it)[i].is_number()) {
+            return false;
+        }
+        out[i] = (*it)[i].get<float>();
+    }
+    return true;
+}
+
+RestPose ReadRestPose(const nlohmann::json& node) {
+    RestPose rest;
+    std::array<float, 16> matrix;
+    if (ReadFloats(node, "matrix", matrix)) {
+        // glTF 的欄主序矩陣直接對應 DirectXMath 的列向量慣例
+        XMFLOAT4X4 m(matrix.data());
+        XMVECTOR s, r, t;
+        if (XMMatrixDecompose(&s, &r, &t, XMLoadFloat4x4(&m))) {
+            XMStoreFloat4(&rest.scale, s);
+            XMStoreFloat4(&rest.rotation, r);
+        }
+        rest.translation = { m._41, m._42, m._43, 0.0f };
+        return rest;
+    }
+
+    std::array<float, 3> v3;
+    std::array<float, 4> v4;
+    if (ReadFloats(node, "translation", v3)) {
+        rest.translation = { v3[0], v3[1], v3[2], 0.0f };
+    }
+    if (ReadFloats(node, "rotation", v4)) {
+        rest.rotation = { v4[0], v4[1], v4[2], v4[3] };
+    }
+    if (ReadFloats(node, "scale", v3)) {
+        rest.scale = { v3[0], v3[1], v3[2], 0.0f };
+    }
+    return rest;
+}
+
+// 解碼一個通道的取樣器；資料不完整時回傳 false
+bool DecodeTrack(const GltfDocument& document, const nlohmann::json& sampler, TrackPath path, Track& track) {
+    int input = IndexValue(sampler, "input");
+    int output = IndexValue(sampler, "output");
+    if (input < 0 || output < 0) {
+        return false;
+    }
+
+    std::string interpolation = sampler.value("interpolation", std::string("LINEAR"));
+    track.path = path;
+    track.interpolation = interpolation == "STEP" ? Interpolation::Step
+                        : interpolation == "CUBICSPLINE" ? Interpolation::CubicSpline
+                        : Interpolation::Linear;
+
+    AccessorSpan<float> times(document.DescribeAccessor(input));
+    if (times.empty()) {
+        return false;
+    }
+    track.times.resize(times.size());
+    times.CopyTo(track.times.data());
+
+    size_t valueCount = times.size() * (track.interpolation == Interpolation::CubicSpline ? 3 : 1);
+    GltfAccessorDesc desc = document.DescribeAccessor(output);
+    track.values.assign(valueCount, XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f));
+    if (path == kRotation) {
+        // rotation 可為 normalized 的 byte／short，由 accessor 讀取轉為 [-1, 1]
+        AccessorSpan<XMFLOAT4> values(desc);
+        if (values.size() != valueCount) {
+            return false;
+        }
+        values.CopyTo(track.values.data());
+    } else {
+        AccessorSpan<XMFLOAT3> values(desc);
+        if (values.size() != valueCount) {
+            return false;
+        }
+        values.CopyTo(reinterpret_cast<XMFLOAT3*>(track.values.data()), sizeof(XMFLOAT4));
+    }
+    return true;
+}
+
+// 依遞增時間取樣的游標：連續取樣時每個 key 只越過一次，時間倒退時重新開始
+class TrackSampler {
+public:
+    explicit TrackSampler(const Track& track) : track_(track) {}
+
+    XMVECTOR Sample(float time) {
+        const auto& times = track_.times;
+        if (time < lastTime_) {
+            key_ = 0;
+        }
+        lastTime_ = time;
+        while (key_ + 1 < times.size() && times[key_ + 1] <= time) {
+            ++key_;
+        }
+
+        if (time <= times.front()) {
+            return Value(0);
+        }
+        if (key_ + 1 >= times.size()) {
+            return Value(times.size() - 1);
+        }
+
+        float t0 = times[key_];
+        float dt = times[key_ + 1] - t0;
+        float u = dt > 0.0f ? (time - t0) / dt : 0.0f;
+        switch (track_.interpolation) {
+            case Interpolation::Step:
+                return Value(key_);
+            case Interpolation::Linear:
+                if (track_.path == kRotation) {
+                    return XMQuaternionSlerp(Value(key_), Value(key_ + 1), u);
+                }
+                return XMVectorLerp(Value(key_), Value(key_ + 1), u);
+            default: {
+                // glTF 規範附錄 C：tangent 以 key 間隔縮放後代入 Hermite 多項式
+                XMVECTOR outTangent = XMVectorScale(Load(key_ * 3 + 2), dt);
+                XMVECTOR inTangent = XMVectorScale(Load((key_ + 1) * 3), dt);
+                XMVECTOR result = XMVectorHermite(Value(key_), outTangent, Value(key_ + 1), inTangent, u);
+                return track_.path == kRotation ? XMQuaternionNormalize(result) : result;
+            }
+        }
+    }
+
+private:
+    XMVECTOR Load(size_t index) const {
+        return XMLoadFloat4(&track_.values[index]);
+    }
+
+    XMVECTOR Value(size_t key) const {
+        return Load(track_.interpolation == Interpolation::CubicSpline ? key * 3 + 1 : key);
+    }
+
+    const Track& track_;
+    size_t key_ = 0;
+    float lastTime_ = 0.0f;
+};
+
+// 將軌道需要的 key 時間（遞增）附加到 out：LINEAR 為原始 key；
+// STEP 在每個 key 之前再加一個緊鄰的時間，兩者之間保持前一個值，線性內插時不會漸變；
+// CUBICSPLINE 將每段 key 細分為至少 bakeRate 格／秒，線性內插近似 Hermite 曲線
+void AppendKeyTimes(const Track& track, float bakeRate, std::vector<float>& out) {
+    const auto& times = track.times;
+    out.push_back(times.front());
+    for (size_t k = 1; k < times.size(); ++k) {
+        float t0 = times[k - 1];
+        float t1 = times[k];
+        if (track.interpolation == Interpolation::Step) {
+            float hold = std::nextafter(t1, t0);
+            if (hold > t0) {
+                out.push_back(hold);
+            }
+        } else if (track.interpolation == Interpolation::CubicSpline && bakeRate > 0.0f) {
+            size_t steps = static_cast<size_t>(std::ceil((t1 - t0) * bakeRate - 1e-4f));
+            for (size_t i = 1; i < steps; ++i) {
+                float time = t0 + (t1 - t0) * static_cast<float>(i) / static_cast<float>(steps);
+                if (time > out.back() && time < t1) {
+                    out.push_back(time);
+                }
+            }
+        }
+        out.push_back(t1);
+    }
+}
+
+XMMATRIX ComposeLocal(FXMVECTOR scale, FXMVECTOR rotation, FXMVECTOR translation) {
+    return XMMatrixScalingFromVector(scale) *
+           XMMatrixRotationQuaternion(XMQuaternionNormalize(rotation)) *
+           XMMatrixTranslationFromVector(translation);
+}
+
+XMMATRIX NodeMatrix(const nlohmann::json& node) {
+    std::array<float, 16> matrix;
+    if (ReadFloats(node, "matrix", matrix)) {
+        XMFLOAT4X4 m(matrix.data());
+        return XMLoadFloat4x4(&m);
+    }
+    RestPose rest = ReadRestPose(node);
+    return ComposeLocal(XMLoadFloat4(&rest.scale), XMLoadFloat4(&rest.rotation), XMLoadFloat4(&rest.translation));
+}
+
+// key 為 joint 的區域變換乘上 offset（它與父 joint 之間非 joint 節點的變換）
+XMFLOAT4X4 ComposeKey(FXMVECTOR scale, FXMVECTOR rotation, FXMVECTOR translation, const XMFLOAT4X4& offset) {
+    XMFLOAT4X4 result;
+    XMStoreFloat4x4(&result, ComposeLocal(scale, rotation, translation) * XMLoadFloat4x4(&offset));
+    return result;
+}
+
+// 節點父子關係只記錄在 children，反向建立 parent 表（根節點為 -1）
+std::vector<int> ParentNodes(const nlohmann::json& nodes) {
+    std::vector<int> parentNode(nodes.size(), -1);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        auto children = nodes[i].find("children");
+        if (children == nodes[i].end() || !children->is_array()) {
+            continue;
+        }
+        for (const auto& child : *children) {
+            if (child.is_number_integer() && child.get<int>() >= 0 &&
+                static_cast<size_t>(child.get<int>()) < nodes.size()) {
+                parentNode[child.get<int>()] = static_cast<int>(i);
+            }
+        }
+    }
+    return parentNode;
+}
+
+} // namespace
+
+std::vector<int> ImportGltfSkin(const GltfDocument& document, int skinIndex, Skeleton& outSkel) {
+    const auto& skins = document.Section("skins");
+    const auto& nodes = document.Section("nodes");
+    if (skinIndex < 0 || static_cast<size_t>(skinIndex) >= skins.size()) {
+        throw std::runtime_error(std::format("glTF: skin {} 不存在", skinIndex));
+    }
+    const auto& skin = skins[skinIndex];
+    auto jointsIt = skin.find("joints");
+    if (jointsIt == skin.end() || !jointsIt->is_array()) {
+        throw std::runtime_error(std::format("glTF: skin {} 沒有 joints", skinIndex));
+    }
+    const auto& joints = *jointsIt;
+
+    std::vector<int> parentNode = ParentNodes(nodes);
+
+    std::vector<int> nodeToJoint(nodes.size(), -1);
+    std::vector<int> jointNodes;
+    jointNodes.reserve(joints.size());
+    for (size_t i = 0; i < joints.size(); ++i) {
+        int node = joints[i].is_number_integer() ? joints[i].get<int>() : -1;
+        if (node < 0 || static_cast<size_t>(node) >= nodes.size() || nodeToJoint[node] >= 0) {
+            throw std::runtime_error(std::format("glTF: skin {} 的 joint {} 無效", skinIndex, i));
+        }
+        nodeToJoint[node] = static_cast<int>(i);
+        jointNodes.push_back(node);
+    }
+
+    std::vector<XMFLOAT4X4> inverseBind;
+    int ibmIndex = IndexValue(skin, "inverseBindMatrices");
+    if (ibmIndex >= 0) {
+        inverseBind = AccessorSpan<XMFLOAT4X4>(document.DescribeAccessor(ibmIndex)).ToVector();
+    }
+    XMFLOAT4X4 identity;
+    XMStoreFloat4x4(&identity, XMMatrixIdentity());
+
+    outSkel.joints.clear();
+    outSkel.joints.reserve(jointNodes.size());
+    for (size_t i = 0; i < jointNodes.size(); ++i) {
+        int node = jointNodes[i];
+        SkeletonJoint joint;
+        joint.name = nodes[node].value("name", std::string());
+        if (joint.name.empty()) {
+            joint.name = "joint_" + std::to_string(i);
+        }
+
+        // 中間可能夾著不屬於 skin 的節點，往上找到最近的 joint；步數上限防止 children 形成環
+        int parent = parentNode[node];
+        for (size_t steps = 0; parent >= 0 && nodeToJoint[parent] < 0 && steps < nodes.size(); ++steps) {
+            parent = parentNode[parent];
+        }
+        joint.parentIndex = parent >= 0 ? nodeToJoint[parent] : -1;
+        joint.bindPoseInverse = i < inverseBind.size() ? inverseBind[i] : identity;
+        outSkel.joints.push_back(std::move(joint));
+    }
+    return nodeToJoint;
+}
+
+void ImportGltfAnimations(const GltfDocument& document, const std::vector<int>& nodeToJoint,
+                          Skeleton& outSkel, const GltfAnimationOptions& options) {
+    const auto& animations = document.Section("animations");
+    const auto& nodes = document.Section("nodes");
+    size_t jointCount = outSkel.joints.size();
+
+    std::vector<int> parentNode = ParentNodes(nodes);
+    XMFLOAT4X4 identity;
+    XMStoreFloat4x4(&identity, XMMatrixIdentity());
+    std::vector<RestPose> rest(jointCount);
+    std::vector<XMFLOAT4X4> offsets(jointCount, identity);
+    for (size_t node = 0; node < nodeToJoint.size() && node < nodes.size(); ++node) {
+        int joint = nodeToJoint[node];
+        if (joint < 0 || static_cast<size_t>(joint) >= jointCount) {
+            continue;
+        }
+        rest[joint] = ReadRestPose(nodes[node]);
+
+        // AnimationPlayer 只沿 joint 合併父變換，夾在中間（或根 joint 之上）的非 joint 節點以靜止變換併入 key
+        XMMATRIX offset = XMMatrixIdentity();
+        int parent = parentNode[node];
+        for (size_t steps = 0; parent >= 0 && nodeToJoint[parent] < 0 && steps < nodes.size(); ++steps) {
+            offset = offset * NodeMatrix(nodes[parent]);
+            parent = parentNode[parent];
+        }
+        XMStoreFloat4x4(&offsets[joint], offset);
+    }
+
+    // 以下暫存區在各動畫之間重複使用
+    std::vector<Track> tracks;
+    std::vector<std::array<int, kPathCount>> jointTracks;
+    std::vector<float> keyTimes;
+    std::vector<float> trackTimes;
+    std::vector<float> merged;
+
+    for (size_t animIdx = 0; animIdx < animations.size(); ++animIdx) {
+        const auto& animation = animations[animIdx];
+        auto channelsIt = animation.find("channels");
+        auto samplersIt = animation.find("samplers");
+        if (channelsIt == animation.end() || samplersIt == animation.end() ||
+            !channelsIt->is_array() || !samplersIt->is_array()) {
+            continue;
+        }
+
+        tracks.clear();
+        jointTracks.assign(jointCount, { -1, -1, -1 });
+        for (const auto& channel : *channelsIt) {
+            auto target = channel.find("target");
+            int samplerIndex = IndexValue(channel, "sampler");
+            if (target == channel.end() || samplerIndex < 0 ||
+                static_cast<size_t>(samplerIndex) >= samplersIt->size()) {
+                continue;
+            }
+            int node = IndexValue(*target, "node");
+            if (node < 0 || static_cast<size_t>(node) >= nodeToJoint.size() || nodeToJoint[node] < 0) {
+                continue;   // 不屬於這個 skin 的節點
+            }
+            std::string pathName = target->value("path", std::string());
+            TrackPath path = pathName == "translation" ? kTranslation
+                           : pathName == "rotation" ? kRotation
+                           : pathName == "scale" ? kScale
+                           : kPathCount;
+            if (path == kPathCount) {
+                continue;   // weights（morph target）不屬於骨架動畫
+            }
+
+            Track track;
+            if (!DecodeTrack(document, (*samplersIt)[samplerIndex], path, track)) {
+                continue;
+            }
+            jointTracks[nodeToJoint[node]][path] = static_cast<int>(tracks.size());
+            tracks.push_back(std::move(track));
+        }
+
+        SkeletonAnimation result;
+        result.name = animation.value("name", std::string());
+        if (result.name.empty()) {
+            result.name = "Animation_" + std::to_string(animIdx);
+        }
+        result.duration = 0.0f;
+        for (const auto& track : tracks) {
+            result.duration = std::max(result.duration, track.times.back());
+        }
+
+        // 均勻格點：第 i 格的時間恰為 i / rate，最後一格不早於 duration
+        size_t frameCount = 0;
+        if (options.resampleRate > 0.0f) {
+            result.framesPerSecond = options.resampleRate;
+            frameCount = static_cast<size_t>(std::ceil(result.duration * options.resampleRate - 1e-4f)) + 1;
+        }
+
+        result.channels.resize(jointCount);
+        for (size_t joint = 0; joint < jointCount; ++joint) {
+            const auto& slots = jointTracks[joint];
+            auto& keys = result.channels[joint];
+            XMVECTOR restValue[kPathCount] = {
+                XMLoadFloat4(&rest[joint].translation),
+                XMLoadFloat4(&rest[joint].rotation),
+                XMLoadFloat4(&rest[joint].scale),
+            };
+
+            if (slots[kTranslation] < 0 && slots[kRotation] < 0 && slots[kScale] < 0) {
+                keys.push_back({ 0.0f, ComposeKey(restValue[kScale], restValue[kRotation], restValue[kTranslation],
+                                                  offsets[joint]) });
+                continue;
+            }
+
+            keyTimes.clear();
+            if (frameCount > 0) {
+                keyTimes.reserve(frameCount);
+                for (size_t i = 0; i < frameCount; ++i) {
+                    keyTimes.push_back(static_cast<float>(i) / options.resampleRate);
+                }
+            } else {
+                // 各軌道的 key 時間皆已排序，逐一合併後去除重複
+                for (int slot : slots) {
+                    if (slot < 0) {
+                        continue;
+                    }
+                    trackTimes.clear();
+                    AppendKeyTimes(tracks[slot], options.splineBakeRate, trackTimes);
+                    merged.resize(keyTimes.size() + trackTimes.size());
+                    auto end = std::merge(keyTimes.begin(), keyTimes.end(), trackTimes.begin(), trackTimes.end(),
+                                          merged.begin());
+                    merged.erase(std::unique(merged.begin(), end), merged.end());
+                    keyTimes.swap(merged);
+                }
+            }
+
+            std::optional<TrackSampler> samplers[kPathCount];
+            for (int path = 0; path < kPathCount; ++path) {
+                if (slots[path] >= 0) {
+                    samplers[path].emplace(tracks[slots[path]]);
+                }
+            }
+
+            keys.reserve(keyTimes.size());
+            for (float time : keyTimes) {
+                XMVECTOR t = samplers[kTranslation] ? samplers[kTranslation]->Sample(time) : restValue[kTranslation];
+                XMVECTOR r = samplers[kRotation] ? samplers[kRotation]->Sample(time) : restValue[kRotation];
+                XMVECTOR s = samplers[kScale] ? samplers[kScale]->Sample(time) : restValue[kScale];
+                keys.push_back({ time, ComposeKey(s, r, t, offsets[joint]) });
+            }
+        }
+        outSkel.animations.push_back(std::move(result));
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "GltfDocument.h"
+#include "Skeleton.h"
+#include <vector>
+
+// glTF 動畫匯入選項
+struct GltfAnimationOptions {
+    // > 0 時將每個動畫重新取樣為每秒 resampleRate 格的均勻格點（SkeletonAnimation::framesPerSecond），
+    // 執行期可由時間直接換算 key 索引；0 表示保留原始 key 時間（每個 joint 取其 T/R/S 軌道時間的聯集）
+    float resampleRate = 0.0f;
+
+    // resampleRate 為 0 時 AnimationPlayer 在 key 之間一律線性內插，為保留取樣器的內插方式：
+    // STEP 軌道在每個 key 之前緊鄰加入保持前值的 key；CUBICSPLINE 軌道在每段 key 之間以至少此頻率加入中間 key
+    float splineBakeRate = 30.0f;
+};
+
+// 匯入 skin：joint 順序與 skin.joints 相同（JOINTS_0 與 inverseBindMatrices 皆以此為索引），
+// parentIndex 為最近一個同屬此 skin 的祖先節點；未指定 inverseBindMatrices 時為單位矩陣
+// 回傳節點索引 → joint 索引的對照（非 joint 節點為 -1）；skin 無效時拋出 std::runtime_error
+std::vector<int> ImportGltfSkin(const GltfDocument& document, int skinIndex, Skeleton& outSkel);
+
+// 匯入所有以 nodeToJoint 中 joint 為目標的動畫，每個 joint 一個通道，key 為區域變換矩陣（S * R * T）
+// 支援 translation／rotation／scale 路徑與 STEP／LINEAR／CUBICSPLINE 內插；未被動畫的成分沿用節點的靜止姿勢
+// joint 與父 joint 之間（根 joint 則為其所有祖先）不屬於 skin 的節點以靜止變換併入 key，這些節點的動畫不套用
+// 沒有被動畫的 joint 只有一個靜止姿勢 key；資料不完整的通道會被略過
+void ImportGltfAnimations(const GltfDocument& document, const std::vector<int>& nodeToJoint,
+                          Skeleton& outSkel, const GltfAnimationOptions& options = {});
@@ -0,0 +1,196 @@
+#include "GltfDocument.h"
+#include <cstring>
+#include <format>
+#include <stdexcept>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint32_t kGlbMagic = 0x46546C67u;       // "glTF"
+constexpr uint32_t kChunkJson = 0x4E4F534Au;      // "JSON"
+constexpr uint32_t kChunkBin = 0x004E4942u;       // "BIN\0"
+
+uint32_t ReadU32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+int Base64Value(char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '+' || c == '-') return 62;
+    if (c == '/' || c == '_') return 63;
+    return -1;
+}
+
+std::vector<uint8_t> DecodeBase64(std::string_view text) {
+    std::vector<uint8_t> out;
+    out.reserve(text.size() / 4 * 3);
+    uint32_t bits = 0;
+    int count = 0;
+    for (char c : text) {
+        int v = Base64Value(c);
+        if (v < 0) {
+            continue;   // '=' 補位與空白
+        }
+        bits = (bits << 6) | static_cast<uint32_t>(v);
+        count += 6;
+        if (count >= 8) {
+            count -= 8;
+            out.push_back(static_cast<uint8_t>(bits >> count));
+        }
+    }
+    return out;
+}
+
+size_t SizeValue(const nlohmann::json& object, const char* key) {
+    auto it = object.find(key);
+    return it != object.end() && it->is_number_unsigned() ? it->get<size_t>() : 0;
+}
+
+int IndexValue(const nlohmann::json& object, const char* key) {
+    auto it = object.find(key);
+    return it != object.end() && it->is_number_integer() ? it->get<int>() : -1;
+}
+
+} // namespace
+
+GltfDocument::GltfDocument(const fs::path& file) : file_(file) {
+    std::span<const uint8_t> bytes = file_.bytes();
+    std::span<const uint8_t> jsonChunk = bytes;
+    std::span<const uint8_t> binChunk;
+
+    if (bytes.size() >= 12 && ReadU32(bytes.data()) == kGlbMagic) {
+        // GLB：12 位元組檔頭後接 chunk（長度、型別、資料）；第一個 chunk 必為 JSON
+        size_t length = ReadU32(bytes.data() + 8);
+        if (length > bytes.size()) {
+            throw std::runtime_error(std::format("GLB 檔案長度不符: {}", file.string()));
+        }
+        jsonChunk = {};
+        for (size_t offset = 12; offset + 8 <= length;) {
+            size_t chunkLength = ReadU32(bytes.data() + offset);
+            uint32_t chunkType = ReadU32(bytes.data() + offset + 4);
+            if (chunkLength > length - offset - 8) {
+                throw std::runtime_error(std::format("GLB chunk 超出檔案範圍: {}", file.string()));
+            }
+            std::span<const uint8_t> chunk = bytes.subspan(offset + 8, chunkLength);
+            if (offset == 12 && chunkType != kChunkJson) {
+                throw std::runtime_error(std::format("GLB 缺少 JSON chunk: {}", file.string()));
+            }
+            if (chunkType == kChunkJson && jsonChunk.empty()) {
+                jsonChunk = chunk;
+            } else if (chunkType == kChunkBin && binChunk.empty()) {
+                binChunk = chunk;
+            }
+            offset += 8 + ((chunkLength + 3) & ~size_t(3));
+        }
+    }
+
+    json_ = nlohmann::json::parse(jsonChunk.begin(), jsonChunk.end(), nullptr, false);
+    if (json_.is_discarded() || !json_.is_object()) {
+        throw std::runtime_error(std::format("glTF JSON 解析失敗: {}", file.string()));
+    }
+    LoadBuffers(file, binChunk);
+}
+
+void GltfDocument::LoadBuffers(const fs::path& file, std::span<const uint8_t> binChunk) {
+    const nlohmann::json& buffers = Section("buffers");
+    buffers_.reserve(buffers.size());
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        const nlohmann::json& buffer = buffers[i];
+        size_t byteLength = SizeValue(buffer, "byteLength");
+        std::span<const uint8_t> data;
+
+        auto uri = buffer.find("uri");
+        if (uri == buffer.end() || !uri->is_string()) {
+            // 沒有 uri 的第一個 buffer 指向 GLB 的 BIN chunk（規範允許 chunk 尾端有補位）
+            if (i == 0) {
+                data = binChunk;
+            }
+        } else {
+            const std::string& value = uri->get_ref<const std::string&>();
+            if (value.rfind("data:", 0) == 0) {
+                size_t comma = value.find(',');
+                if (comma != std::string::npos) {
+                    embedded_.push_back(DecodeBase64(std::string_view(value).substr(comma + 1)));
+                    data = embedded_.back();
+                }
+            } else {
+                std::u8string utf8(value.begin(), value.end());
+                externalFiles_.emplace_back(file.parent_path() / fs::path(utf8));
+                data = externalFiles_.back().bytes();
+            }
+        }
+
+        if (data.size() < byteLength) {
+            throw std::runtime_error(std::format("glTF buffer {} 的資料不足 {} 位元組: {}", i, byteLength, file.string()));
+        }
+        buffers_.push_back(data.first(byteLength));
+    }
+
+    // bufferView 於開啟時解析一次；超出 buffer 的 view 保留為空範圍，被 accessor 使用時才報錯
+    const nlohmann::json& views = Section("bufferViews");
+    views_.reserve(views.size());
+    for (const nlohmann::json& view : views) {
+        GltfBufferViewRange range;
+        int bufferIndex = IndexValue(view, "buffer");
+        size_t byteOffset = SizeValue(view, "byteOffset");
+        size_t byteLength = SizeValue(view, "byteLength");
+        if (bufferIndex >= 0 && static_cast<size_t>(bufferIndex) < buffers_.size()) {
+            std::span<const uint8_t> buffer = buffers_[bufferIndex];
+            if (byteOffset <= buffer.size() && byteLength <= buffer.size() - byteOffset) {
+                range.data = buffer.data() + byteOffset;
+                range.size = byteLength;
+                range.byteStride = SizeValue(view, "byteStride");
+            }
+        }
+        views_.push_back(range);
+    }
+}
+
+const nlohmann::json& GltfDocument::Section(const char* name) const {
+    static const nlohmann::json kEmpty = nlohmann::json::array();
+    auto it = json_.find(name);
+    return it != json_.end() && it->is_array() ? *it : kEmpty;
+}
+
+GltfAccessorDesc GltfDocument::DescribeAccessor(int accessorIndex) const {
+    const nlohmann::json& accessors = Section("accessors");
+    if (accessorIndex < 0 || static_cast<size_t>(accessorIndex) >= accessors.size()) {
+        throw std::runtime_error(std::format("glTF: accessor {} 不存在", accessorIndex));
+    }
+    const nlohmann::json& acc = accessors[accessorIndex];
+
+    GltfAccessorFields fields;
+    fields.bufferView = IndexValue(acc, "bufferView");
+    fields.byteOffset = SizeValue(acc, "byteOffset");
+    fields.count = SizeValue(acc, "count");
+    fields.componentType = IndexValue(acc, "componentType");
+    fields.components = GltfTypeComponents(acc.value("type", std::string()));
+    fields.normalized = acc.value("normalized", false);
+
+    auto sparse = acc.find("sparse");
+    if (sparse != acc.end() && sparse->is_object()) {
+        fields.sparseCount = SizeValue(*sparse, "count");
+        auto indices = sparse->find("indices");
+        auto values = sparse->find("values");
+        if (fields.sparseCount > 0 && indices != sparse->end() && values != sparse->end()) {
+            fields.sparseIndicesView = IndexValue(*indices, "bufferView");
+            fields.sparseIndicesOffset = SizeValue(*indices, "byteOffset");
+            fields.sparseIndexType = IndexValue(*indices, "componentType");
+            fields.sparseValuesView = IndexValue(*values, "bufferView");
+            fields.sparseValuesOffset = SizeValue(*values, "byteOffset");
+        } else {
+            fields.sparseCount = 0;
+        }
+    }
+    return DescribeGltfAccessor(fields, accessorIndex, views_);
+}
+
+std::span<const uint8_t> GltfDocument::Buffer(size_t index) const {
+    return index < buffers_.size() ? buffers_[index] : std::span<const uint8_t>{};
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "GltfAccessor.h"
+#include "MappedFile.h"
+#include "json.hpp"
+#include <filesystem>
+#include <span>
+#include <vector>
+
+// 不經 tinygltf 的 glTF 文件：只解析 JSON，緩衝區直接以記憶體對應存取
+// - .glb 的 BIN chunk 與外部 .bin 檔以 MappedFile 對應，accessor 直接讀取對應的頁面，不複製
+// - 只有 data: URI 內嵌的緩衝區需要解碼到記憶體
+// 無法開啟、檔頭無效或 JSON 解析失敗時建構子拋出 std::runtime_error
+class GltfDocument {
+public:
+    explicit GltfDocument(const std::filesystem::path& file);
+
+    GltfDocument(GltfDocument&&) = default;
+    GltfDocument& operator=(GltfDocument&&) = default;
+    GltfDocument(const GltfDocument&) = delete;
+    GltfDocument& operator=(const GltfDocument&) = delete;
+
+    const nlohmann::json& json() const noexcept { return json_; }
+
+    // 回傳 JSON 中名為 name 的陣列；不存在時回傳空陣列
+    const nlohmann::json& Section(const char* name) const;
+
+    // 規則同 DescribeGltfAccessor；回傳的指標在文件存活期間有效
+    GltfAccessorDesc DescribeAccessor(int accessorIndex) const;
+
+    size_t BufferCount() const noexcept { return buffers_.size(); }
+    std::span<const uint8_t> Buffer(size_t index) const;
+
+private:
+    void LoadBuffers(const std::filesystem::path& file, std::span<const uint8_t> binChunk);
+
+    MappedFile file_;
+    std::vector<MappedFile> externalFiles_;
+    std::vector<std::vector<uint8_t>> embedded_;
+    std::vector<std::span<const uint8_t>> buffers_;
+    std::vector<GltfBufferViewRange> views_;
+    nlohmann::json json_;
+};
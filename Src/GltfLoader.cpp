@@ -1,110 +1,91 @@
 ﻿#define NOMINMAX
 #include <DirectXMath.h>
 #include "GltfLoader.h"
+#include "GltfAccessor.h"
 #include <iostream>
 #include <algorithm>
 
 using namespace DirectX;
 
-void GltfLoader::ParseMesh(const tinygltf::Model& model, SkinMesh& outMesh) {
-  if (model.meshes.empty()) return;
-  const auto& prim = model.meshes[0].primitives[0];
+void GltfLoader::ParseMesh(const GltfDocument& document, SkinMesh& outMesh) {
+  const auto& meshes = document.Section("meshes");
+  if (meshes.empty()) return;
+  auto prims = meshes[0].find("primitives");
+  if (prims == meshes[0].end() || !prims->is_array() || prims->empty()) return;
+  const auto& prim = (*prims)[0];
+  auto attrs = prim.find("attributes");
+  if (attrs == prim.end() || !attrs->is_object()) return;
+  auto attribute = [&attrs](const char* name) {
+    auto it = attrs->find(name);
+    return it != attrs->end() && it->is_number_integer() ? it->get<int>() : -1;
+  };
+  int posIndex = attribute("POSITION");
+  if (posIndex < 0) return;
   // Positions
-  const auto& posAcc = model.accessors[prim.attributes.at("POSITION")];
-  const auto& posView = model.bufferViews[posAcc.bufferView];
-  const auto& posBuf = model.buffers[posView.buffer];
-  size_t vcount = posAcc.count;
+  AccessorSpan<XMFLOAT3> positions(document.DescribeAccessor(posIndex));
+  size_t vcount = positions.size();
+  if (vcount == 0) return;
   outMesh.vertices.resize(vcount);
-  const float* posPtr = reinterpret_cast<const float*>(
-    &posBuf.data[posView.byteOffset + posAcc.byteOffset]);
-  for (size_t i = 0; i < vcount; ++i) {
-    outMesh.vertices[i].pos.x = posPtr[3 * i + 0];
-    outMesh.vertices[i].pos.y = posPtr[3 * i + 1];
-    outMesh.vertices[i].pos.z = posPtr[3 * i + 2];
+  Vertex* vertices = outMesh.vertices.data();
+  positions.CopyTo(&vertices[0].pos, sizeof(Vertex));
+  // Normals / UV
+  if (int normIndex = attribute("NORMAL"); normIndex >= 0) {
+    AccessorSpan<XMFLOAT3> normals(document.DescribeAccessor(normIndex));
+    if (normals.size() == vcount) normals.CopyTo(&vertices[0].norm, sizeof(Vertex));
   }
-  // Indices
-  const auto& idxAcc = model.accessors[prim.indices];
-  const auto& idxView = model.bufferViews[idxAcc.bufferView];
-  const auto& idxBuf = model.buffers[idxView.buffer];
-  const unsigned short* idxPtr = reinterpret_cast<const unsigned short*>(
-    &idxBuf.data[idxView.byteOffset + idxAcc.byteOffset]);
-  size_t icount = idxAcc.count;
-  outMesh.indices.resize(icount);
-  for (size_t i = 0; i < icount; ++i) outMesh.indices[i] = idxPtr[i];
-}
-
-void GltfLoader::ParseSkeleton(const tinygltf::Model& model, Skeleton& outSkel) {
-  if (model.skins.empty()) return;
-  const auto& skin = model.skins[0];
-  size_t jcount = skin.joints.size();
-  outSkel.joints.resize(jcount);
-  // inverse bind matrices
-  const auto& ibmAcc = model.accessors[skin.inverseBindMatrices];
-  const auto& ibmView = model.bufferViews[ibmAcc.bufferView];
-  const auto& ibmBuf = model.buffers[ibmView.buffer];
-  const float* matPtr = reinterpret_cast<const float*>(
-    &ibmBuf.data[ibmView.byteOffset + ibmAcc.byteOffset]);
-  for (size_t i = 0; i < jcount; ++i) {
-    outSkel.joints[i].name = model.nodes[skin.joints[i]].name;
-    outSkel.joints[i].parentIndex = -1;
-    // parent indices can be set by checking node hierarchy
-    DirectX::XMFLOAT4X4 ibm;
-    memcpy(&ibm, &matPtr[16 * i], sizeof(XMFLOAT4X4));
-    outSkel.joints[i].bindPoseInverse = ibm;
+  if (int uvIndex = attribute("TEXCOORD_0"); uvIndex >= 0) {
+    AccessorSpan<XMFLOAT2> uvs(document.DescribeAccessor(uvIndex));
+    if (uvs.size() == vcount) uvs.CopyTo(&vertices[0].uv, sizeof(Vertex));
   }
-}
-
-void GltfLoader::ParseAnimations(const tinygltf::Model& model, Skeleton& outSkel) {
-  for (const auto& anim : model.animations) {
-    SkeletonAnimation a;
-    a.name = anim.name;
-    float maxTime = 0;
-    size_t jcount = outSkel.joints.size();
-    a.channels.assign(jcount, {});
-    for (const auto& channel : anim.channels) {
-      int joint = channel.target_node;
-      const auto& sampler = anim.samplers[channel.sampler];
-      // input times
-      const auto& tAcc = model.accessors[sampler.input];
-      const auto& tView = model.bufferViews[tAcc.bufferView];
-      const auto& tBuf = model.buffers[tView.buffer];
-      const float* times = reinterpret_cast<const float*>(
-        &tBuf.data[tView.byteOffset + tAcc.byteOffset]);
-      // output transforms
-      const auto& dAcc = model.accessors[sampler.output];
-      const auto& dView = model.bufferViews[dAcc.bufferView];
-      const auto& dBuf = model.buffers[dView.buffer];
-      const float* mats = reinterpret_cast<const float*>(
-        &dBuf.data[dView.byteOffset + dAcc.byteOffset]);
-      for (size_t i = 0; i < tAcc.count; ++i) {
-        SkeletonAnimationKey key;
-        key.time = times[i];
-        DirectX::XMFLOAT4X4 mat;
-        memcpy(&mat, &mats[16 * i], sizeof(DirectX::XMFLOAT4X4));
-        key.transform = mat;
-        a.channels[joint].push_back(key);
-
-        maxTime = std::max(maxTime, key.time);
-        
+  // Skin weights
+  int jointsIndex = attribute("JOINTS_0");
+  int weightsIndex = attribute("WEIGHTS_0");
+  if (jointsIndex >= 0 && weightsIndex >= 0) {
+    AccessorSpan<XMUINT4> joints(document.DescribeAccessor(jointsIndex));
+    AccessorSpan<XMFLOAT4> weights(document.DescribeAccessor(weightsIndex));
+    if (joints.size() == vcount && weights.size() == vcount) {
+      weights.CopyTo(&vertices[0].weights, sizeof(Vertex));
+      std::vector<XMUINT4> jointValues = joints.ToVector();
+      for (size_t i = 0; i < vcount; ++i) {
+        const XMUINT4& j = jointValues[i];
+        vertices[i].boneIndices[0] = static_cast<uint8_t>(std::min<uint32_t>(j.x, 255));
+        vertices[i].boneIndices[1] = static_cast<uint8_t>(std::min<uint32_t>(j.y, 255));
+        vertices[i].boneIndices[2] = static_cast<uint8_t>(std::min<uint32_t>(j.z, 255));
+        vertices[i].boneIndices[3] = static_cast<uint8_t>(std::min<uint32_t>(j.w, 255));
       }
     }
-    a.duration = maxTime;
-    outSkel.animations.push_back(a);
+  }
+  // Indices (u8 / u16 / u32)
+  if (int idxIndex = prim.value("indices", -1); idxIndex >= 0) {
+    AccessorSpan<uint32_t> indices(document.DescribeAccessor(idxIndex));
+    outMesh.indices.resize(indices.size());
+    indices.CopyTo(outMesh.indices.data());
   }
 }
 
-bool GltfLoader::Load(const std::string& filename, SkinMesh& outMesh, Skeleton& outSkel) {
-  tinygltf::TinyGLTF loader;
-  tinygltf::Model model;
-  std::string err, warn;
-  bool isBinary = (filename.find(".glb") != std::string::npos);
-  bool ret = isBinary ? loader.LoadBinaryFromFile(&model, &err, &warn, filename)
-    : loader.LoadASCIIFromFile(&model, &err, &warn, filename);
-  if (!warn.empty()) std::cerr << warn << std::endl;
-  if (!err.empty()) std::cerr << err << std::endl;
-  if (!ret) return false;
-  ParseMesh(model, outMesh);
-  ParseSkeleton(model, outSkel);
-  ParseAnimations(model, outSkel);
+std::vector<int> GltfLoader::ParseSkeleton(const GltfDocument& document, Skeleton& outSkel) {
+  if (document.Section("skins").empty()) return {};
+  // joint 階層與 inverse bind matrices
+  return ImportGltfSkin(document, 0, outSkel);
+}
+
+void GltfLoader::ParseAnimations(const GltfDocument& document, const std::vector<int>& nodeToJoint,
+  Skeleton& outSkel, const GltfAnimationOptions& options) {
+  // sampler 的輸出是 T/R/S 向量與四元數（不是矩陣），依內插方式取樣後組成區域矩陣
+  if (outSkel.joints.empty()) return;
+  ImportGltfAnimations(document, nodeToJoint, outSkel, options);
+}
+
+bool GltfLoader::Load(const std::string& filename, SkinMesh& outMesh, Skeleton& outSkel,
+  const GltfAnimationOptions& options) {
+  try {
+    GltfDocument document(filename);
+    ParseMesh(document, outMesh);
+    std::vector<int> nodeToJoint = ParseSkeleton(document, outSkel);
+    ParseAnimations(document, nodeToJoint, outSkel, options);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return false;
+  }
   return true;
 }
\ No newline at end of file
@@ -3,7 +3,8 @@
 #include <vector>
 #include "SkinMesh.h"
 #include "Skeleton.h"
-#include "tiny_gltf.h"
+#include "GltfAnimation.h"
+#include "GltfDocument.h"
 
 
 class GltfLoader {
@@ -13,13 +14,17 @@ public:
    * @param filename glTF/GLB 檔案路徑
    * @param outMesh  輸出網格資料
    * @param outSkel  輸出骨架與動畫資料
+   * @param options  動畫匯入選項（例如重新取樣為均勻格點）
    * @return 載入成功回傳 true
    */
   static bool Load(const std::string& filename,
     SkinMesh& outMesh,
-    Skeleton& outSkel);
+    Skeleton& outSkel,
+    const GltfAnimationOptions& options = {});
 private:
-  static void ParseMesh(const tinygltf::Model& model, SkinMesh& outMesh);
-  static void ParseSkeleton(const tinygltf::Model& model, Skeleton& outSkel);
-  static void ParseAnimations(const tinygltf::Model& model, Skeleton& outSkel);
+  static void ParseMesh(const GltfDocument& document, SkinMesh& outMesh);
+  // 回傳節點索引 → joint 索引的對照，供動畫通道對應目標
+  static std::vector<int> ParseSkeleton(const GltfDocument& document, Skeleton& outSkel);
+  static void ParseAnimations(const GltfDocument& document, const std::vector<int>& nodeToJoint,
+    Skeleton& outSkel, const GltfAnimationOptions& options);
 };
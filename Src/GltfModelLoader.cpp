@@ -1,17 +1,183 @@
 #include "GltfModelLoader.h"
+#include "GltfAccessor.h"
+#include "GltfAnimation.h"
+#include "GltfDocument.h"
 #include "GltfLoader.h"
 #include "ModelData.h"
+#include "ModelMetadata.h"
+#include "ParallelFor.h"
 #include "SkinMesh.h"
 #include "Skeleton.h"
-#include "tiny_gltf.h"
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <cstdio>
 #include <windows.h>
 
+namespace {
+
+// 單一 primitive 的解碼工作；名稱在排程前決定，結果依檔案順序寫回
+struct PrimitiveJob {
+    std::string name;
+    const nlohmann::json* primitive = nullptr;
+    int skin = -1;
+    ModelData model;
+    bool decoded = false;
+};
+
+// 只產生 CPU 端資料（頂點、索引、材質），不呼叫裝置，可在工作執行緒上執行
+// 沒有可用的頂點時回傳 false；accessor 無效時拋出 std::runtime_error
+bool DecodePrimitive(const GltfDocument& document, const nlohmann::json& prim, ModelData& modelData) {
+    const auto& materials = document.Section("materials");
+    const auto& textures = document.Section("textures");
+    const auto& images = document.Section("images");
+    
+    // 檢查是否有必要的屬性
+    auto attrIt = prim.find("attributes");
+    if (attrIt == prim.end() || !attrIt->is_object()) {
+        return false;
+    }
+    const auto& attributes = *attrIt;
+    auto attribute = [&attributes](const char* name) {
+        auto it = attributes.find(name);
+        return it != attributes.end() && it->is_number_integer() ? it->get<int>() : -1;
+    };
+    int positionIndex = attribute("POSITION");
+    if (positionIndex < 0) {
+        return false;
+    }
+    
+    // 載入頂點位置；accessor 讀取會處理 byteStride、normalized 整數與 sparse
+    AccessorSpan<XMFLOAT3> positions(document.DescribeAccessor(positionIndex));
+    size_t vertexCount = positions.size();
+    if (vertexCount == 0) {
+        return false;
+    }
+    modelData.mesh.vertices.resize(vertexCount);
+    Vertex* vertices = modelData.mesh.vertices.data();
+    positions.CopyTo(&vertices[0].pos, sizeof(Vertex));
+    
+    // 設置預設的白色頂點顏色
+    for (size_t i = 0; i < vertexCount; ++i) {
+        vertices[i].col = D3DCOLOR_XRGB(255, 255, 255);
+    }
+    
+    // 載入法線
+    if (int normalIndex = attribute("NORMAL"); normalIndex >= 0) {
+        AccessorSpan<XMFLOAT3> normals(document.DescribeAccessor(normalIndex));
+        if (normals.size() == vertexCount) {
+            normals.CopyTo(&vertices[0].norm, sizeof(Vertex));
+        }
+    }
+    
+    // 載入紋理座標
+    if (int uvIndex = attribute("TEXCOORD_0"); uvIndex >= 0) {
+        AccessorSpan<XMFLOAT2> uvs(document.DescribeAccessor(uvIndex));
+        if (uvs.size() == vertexCount) {
+            uvs.CopyTo(&vertices[0].uv, sizeof(Vertex));
+        }
+    }
+    
+    // 載入骨骼索引與權重
+    int jointsIndex = attribute("JOINTS_0");
+    int weightsIndex = attribute("WEIGHTS_0");
+    if (jointsIndex >= 0 && weightsIndex >= 0) {
+        AccessorSpan<XMUINT4> joints(document.DescribeAccessor(jointsIndex));
+        AccessorSpan<XMFLOAT4> weights(document.DescribeAccessor(weightsIndex));
+        if (joints.size() == vertexCount && weights.size() == vertexCount) {
+            weights.CopyTo(&vertices[0].weights, sizeof(Vertex));
+            std::vector<XMUINT4> jointValues = joints.ToVector();
+            for (size_t i = 0; i < vertexCount; ++i) {
+                const XMUINT4& j = jointValues[i];
+                vertices[i].boneIndices[0] = static_cast<uint8_t>(std::min<uint32_t>(j.x, 255));
+                vertices[i].boneIndices[1] = static_cast<uint8_t>(std::min<uint32_t>(j.y, 255));
+                vertices[i].boneIndices[2] = static_cast<uint8_t>(std::min<uint32_t>(j.z, 255));
+                vertices[i].boneIndices[3] = static_cast<uint8_t>(std::min<uint32_t>(j.w, 255));
+            }
+        }
+    }
+    
+    // 載入索引（UNSIGNED_BYTE／SHORT／INT 皆擴展為 32 位元）
+    if (int indicesIndex = prim.value("indices", -1); indicesIndex >= 0) {
+        AccessorSpan<uint32_t> indices(document.DescribeAccessor(indicesIndex));
+        modelData.mesh.indices.resize(indices.size());
+        indices.CopyTo(modelData.mesh.indices.data());
+    }
+    
+    // 處理材質和貼圖
+    int materialIndex = prim.value("material", -1);
+    if (materialIndex >= 0 && materialIndex < static_cast<int>(materials.size())) {
+        const auto& material = materials[materialIndex];
+        
+        // 創建材質
+        Material modelMat;
+        
+        // 設置材質屬性（未指定時 glTF 預設為白色）
+        static const nlohmann::json kNoPbr = nlohmann::json::object();
+        auto pbrIt = material.find("pbrMetallicRoughness");
+        const auto& pbr = pbrIt != material.end() && pbrIt->is_object() ? *pbrIt : kNoPbr;
+        auto factor = pbr.value("baseColorFactor", std::vector<float>{ 1.0f, 1.0f, 1.0f, 1.0f });
+        if (factor.size() >= 4) {
+            modelMat.mat.Diffuse.r = factor[0];
+            modelMat.mat.Diffuse.g = factor[1];
+            modelMat.mat.Diffuse.b = factor[2];
+            modelMat.mat.Diffuse.a = factor[3];
+        }
+        modelMat.mat.Ambient = modelMat.mat.Diffuse;
+        modelMat.mat.Specular = D3DXCOLOR(1.0f, 1.0f, 1.0f, 1.0f);
+        modelMat.mat.Power = 10.0f;
+        
+        // 處理貼圖
+        int textureIndex = -1;
+        auto baseColorIt = pbr.find("baseColorTexture");
+        if (baseColorIt != pbr.end() && baseColorIt->is_object()) {
+            textureIndex = baseColorIt->value("index", -1);
+        }
+        if (textureIndex >= 0 && textureIndex < static_cast<int>(textures.size())) {
+            int source = textures[textureIndex].value("source", -1);
+            if (source >= 0 && source < static_cast<int>(images.size())) {
+                // 取得貼圖檔案名稱
+                std::string textureFileName = images[source].value("uri", std::string());
+                modelMat.textureFileName = textureFileName;
+                
+                char debugMsg[256];
+                sprintf_s(debugMsg, "GltfModelLoader: Found texture '%s' for material %d\n",
+                          textureFileName.c_str(), materialIndex);
+                OutputDebugStringA(debugMsg);
+            }
+        }
+        
+        modelData.mesh.materials.push_back(modelMat);
+    } else {
+        // 沒有材質，創建預設材質
+        Material defaultMat;
+        defaultMat.mat.Diffuse = D3DXCOLOR(1.0f, 1.0f, 1.0f, 1.0f);
+        defaultMat.mat.Ambient = D3DXCOLOR(1.0f, 1.0f, 1.0f, 1.0f);
+        defaultMat.mat.Specular = D3DXCOLOR(1.0f, 1.0f, 1.0f, 1.0f);
+        defaultMat.mat.Power = 10.0f;
+        modelData.mesh.materials.push_back(defaultMat);
+    }
+    
+    return true;
+}
+
+} // namespace
+
 std::map<std::string, ModelData> GltfModelLoader::Load(
     const std::filesystem::path& file, IDirect3DDevice9* device) const {
     
+    return LoadMeshes(file, device, nullptr);
+}
+
+std::map<std::string, ModelData> GltfModelLoader::LoadObject(
+    const std::filesystem::path& file, const std::string& objectName, IDirect3DDevice9* device) const {
+    
+    return LoadMeshes(file, device, &objectName);
+}
+
+std::map<std::string, ModelData> GltfModelLoader::LoadMeshes(
+    const std::filesystem::path& file, IDirect3DDevice9* device, const std::string* objectName) const {
+    
     std::map<std::string, ModelData> models;
     
     
@@ -21,177 +187,99 @@ std::map<std::string, ModelData> GltfModelLoader::Load(
             return models;
         }
         
-        // 載入 glTF 檔案
-        tinygltf::TinyGLTF loader;
-        tinygltf::Model gltfModel;
-        std::string err, warn;
+        // 只解析 JSON；GLB 的 BIN chunk 與外部 .bin 以記憶體對應讀取，頂點直接從對應的頁面轉換
+        GltfDocument document(file);
+        const auto& meshes = document.Section("meshes");
         
-        bool isBinary = (file.extension() == ".glb");
-        bool ret = isBinary ? 
-            loader.LoadBinaryFromFile(&gltfModel, &err, &warn, file.string()) :
-            loader.LoadASCIIFromFile(&gltfModel, &err, &warn, file.string());
-            
-        if (!ret) {
-            return models;
+        // 網格所屬的 skin 記錄在引用它的節點上；同一網格被多個節點引用時取第一個帶 skin 的節點
+        std::vector<int> meshSkin(meshes.size(), -1);
+        for (const auto& node : document.Section("nodes")) {
+            int mesh = node.value("mesh", -1);
+            int skin = node.value("skin", -1);
+            if (mesh >= 0 && static_cast<size_t>(mesh) < meshes.size() && skin >= 0 && meshSkin[mesh] < 0) {
+                meshSkin[mesh] = skin;
+            }
         }
         
-        // 處理每個網格
-        for (size_t meshIdx = 0; meshIdx < gltfModel.meshes.size(); ++meshIdx) {
-            const auto& mesh = gltfModel.meshes[meshIdx];
+        // 收集要解碼的 primitive；只載入單一物件時略過其他 primitive
+        std::vector<PrimitiveJob> jobs;
+        for (size_t meshIdx = 0; meshIdx < meshes.size(); ++meshIdx) {
+            const auto& mesh = meshes[meshIdx];
+            auto primsIt = mesh.find("primitives");
+            if (primsIt == mesh.end() || !primsIt->is_array()) {
+                continue;
+            }
+            const auto& primitives = *primsIt;
             
-            // 處理每個 primitive
-            for (size_t primIdx = 0; primIdx < mesh.primitives.size(); ++primIdx) {
-                const auto& prim = mesh.primitives[primIdx];
-                
-                ModelData modelData;
-                
-                // 檢查是否有必要的屬性
-                if (prim.attributes.find("POSITION") == prim.attributes.end()) {
+            for (size_t primIdx = 0; primIdx < primitives.size(); ++primIdx) {
+                // 產生模型名稱（與 ScanGltfMetadata 相同）
+                std::string modelName = GltfModelName(mesh, meshIdx, primIdx);
+                if (objectName && modelName != *objectName) {
                     continue;
                 }
                 
-                // 載入頂點位置
-                const auto& posAccessor = gltfModel.accessors[prim.attributes.at("POSITION")];
-                const auto& posBufferView = gltfModel.bufferViews[posAccessor.bufferView];
-                const auto& posBuffer = gltfModel.buffers[posBufferView.buffer];
-                
-                size_t vertexCount = posAccessor.count;
-                modelData.mesh.vertices.resize(vertexCount);
-                
-                const float* posPtr = reinterpret_cast<const float*>(
-                    &posBuffer.data[posBufferView.byteOffset + posAccessor.byteOffset]);
-                    
-                for (size_t i = 0; i < vertexCount; ++i) {
-                    modelData.mesh.vertices[i].pos.x = posPtr[3 * i + 0];
-                    modelData.mesh.vertices[i].pos.y = posPtr[3 * i + 1];
-                    modelData.mesh.vertices[i].pos.z = posPtr[3 * i + 2];
-                    
-                    // 設置預設的白色頂點顏色
-                    modelData.mesh.vertices[i].col = D3DCOLOR_XRGB(255, 255, 255);
-                }
-                
-                // 載入法線
-                if (prim.attributes.find("NORMAL") != prim.attributes.end()) {
-                    const auto& normAccessor = gltfModel.accessors[prim.attributes.at("NORMAL")];
-                    const auto& normBufferView = gltfModel.bufferViews[normAccessor.bufferView];
-                    const auto& normBuffer = gltfModel.buffers[normBufferView.buffer];
-                    
-                    const float* normPtr = reinterpret_cast<const float*>(
-                        &normBuffer.data[normBufferView.byteOffset + normAccessor.byteOffset]);
-                        
-                    for (size_t i = 0; i < vertexCount; ++i) {
-                        modelData.mesh.vertices[i].norm.x = normPtr[3 * i + 0];
-                        modelData.mesh.vertices[i].norm.y = normPtr[3 * i + 1];
-                        modelData.mesh.vertices[i].norm.z = normPtr[3 * i + 2];
-                    }
-                }
-                
-                // 載入紋理座標
-                if (prim.attributes.find("TEXCOORD_0") != prim.attributes.end()) {
-                    const auto& uvAccessor = gltfModel.accessors[prim.attributes.at("TEXCOORD_0")];
-                    const auto& uvBufferView = gltfModel.bufferViews[uvAccessor.bufferView];
-                    const auto& uvBuffer = gltfModel.buffers[uvBufferView.buffer];
-                    
-                    const float* uvPtr = reinterpret_cast<const float*>(
-                        &uvBuffer.data[uvBufferView.byteOffset + uvAccessor.byteOffset]);
-                        
-                    for (size_t i = 0; i < vertexCount; ++i) {
-                        modelData.mesh.vertices[i].uv.x = uvPtr[2 * i + 0];
-                        modelData.mesh.vertices[i].uv.y = uvPtr[2 * i + 1];
-                    }
-                }
-                
-                // 載入索引
-                if (prim.indices >= 0) {
-                    const auto& idxAccessor = gltfModel.accessors[prim.indices];
-                    const auto& idxBufferView = gltfModel.bufferViews[idxAccessor.bufferView];
-                    const auto& idxBuffer = gltfModel.buffers[idxBufferView.buffer];
-                    
-                    size_t indexCount = idxAccessor.count;
-                    modelData.mesh.indices.resize(indexCount);
-                    
-                    if (idxAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT) {
-                        const unsigned short* idxPtr = reinterpret_cast<const unsigned short*>(
-                            &idxBuffer.data[idxBufferView.byteOffset + idxAccessor.byteOffset]);
-                        for (size_t i = 0; i < indexCount; ++i) {
-                            modelData.mesh.indices[i] = idxPtr[i];
-                        }
-                    } else if (idxAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT) {
-                        const unsigned int* idxPtr = reinterpret_cast<const unsigned int*>(
-                            &idxBuffer.data[idxBufferView.byteOffset + idxAccessor.byteOffset]);
-                        for (size_t i = 0; i < indexCount; ++i) {
-                            modelData.mesh.indices[i] = idxPtr[i];
-                        }
-                    }
-                }
-                
-                // 處理材質和貼圖
-                if (prim.material >= 0 && prim.material < static_cast<int>(gltfModel.materials.size())) {
-                    const auto& material = gltfModel.materials[prim.material];
-                    
-                    // 創建材質
-                    Material modelMat;
-                    
-                    // 設置材質屬性
-                    const auto& pbr = material.pbrMetallicRoughness;
-                    if (pbr.baseColorFactor.size() >= 4) {
-                        modelMat.mat.Diffuse.r = static_cast<float>(pbr.baseColorFactor[0]);
-                        modelMat.mat.Diffuse.g = static_cast<float>(pbr.baseColorFactor[1]);
-                        modelMat.mat.Diffuse.b = static_cast<float>(pbr.baseColorFactor[2]);
-                        modelMat.mat.Diffuse.a = static_cast<float>(pbr.baseColorFactor[3]);
-                    }
-                    modelMat.mat.Ambient = modelMat.mat.Diffuse;
-                    modelMat.mat.Specular = D3DXCOLOR(1.0f, 1.0f, 1.0f, 1.0f);
-                    modelMat.mat.Power = 10.0f;
-                    
-                    // 處理貼圖
-                    if (pbr.baseColorTexture.index >= 0 && 
-                        pbr.baseColorTexture.index < static_cast<int>(gltfModel.textures.size())) {
-                        
-                        const auto& texture = gltfModel.textures[pbr.baseColorTexture.index];
-                        if (texture.source >= 0 && texture.source < static_cast<int>(gltfModel.images.size())) {
-                            const auto& image = gltfModel.images[texture.source];
-                            
-                            // 取得貼圖檔案名稱
-                            std::string textureFileName = image.uri;
-                            modelMat.textureFileName = textureFileName;
-                            
-                            char debugMsg[256];
-                            sprintf_s(debugMsg, "GltfModelLoader: Found texture '%s' for material %d\n",
-                                      textureFileName.c_str(), prim.material);
-                            OutputDebugStringA(debugMsg);
-                        }
-                    }
-                    
-                    modelData.mesh.materials.push_back(modelMat);
-                } else {
-                    // 沒有材質，創建預設材質
-                    Material defaultMat;
-                    defaultMat.mat.Diffuse = D3DXCOLOR(1.0f, 1.0f, 1.0f, 1.0f);
-                    defaultMat.mat.Ambient = D3DXCOLOR(1.0f, 1.0f, 1.0f, 1.0f);
-                    defaultMat.mat.Specular = D3DXCOLOR(1.0f, 1.0f, 1.0f, 1.0f);
-                    defaultMat.mat.Power = 10.0f;
-                    modelData.mesh.materials.push_back(defaultMat);
+                PrimitiveJob job;
+                job.name = std::move(modelName);
+                job.primitive = &primitives[primIdx];
+                job.skin = meshSkin[meshIdx];
+                jobs.push_back(std::move(job));
+            }
+        }
+        
+        // 各 primitive 的解碼互相獨立，分散到多個執行緒；單一 primitive 的資料無效時只略過該 primitive
+        ParallelFor(jobs.size(), [&](size_t i) {
+            PrimitiveJob& job = jobs[i];
+            try {
+                job.decoded = DecodePrimitive(document, *job.primitive, job.model);
+            } catch (const std::exception& e) {
+                char debugMsg[512];
+                sprintf_s(debugMsg, "GltfModelLoader: Skipped primitive '%s': %s\n", job.name.c_str(), e.what());
+                OutputDebugStringA(debugMsg);
+            }
+        });
+        
+        // 匯入用到的 skin 與其動畫，使用同一 skin 的網格共用同一份骨架；skin 無效時網格仍以靜態方式載入
+        std::map<int, std::shared_ptr<const Skeleton>> skeletons;
+        for (const auto& job : jobs) {
+            if (!job.decoded || job.skin < 0 || skeletons.count(job.skin)) {
+                continue;
+            }
+            std::shared_ptr<const Skeleton>& shared = skeletons[job.skin];
+            try {
+                Skeleton skeleton;
+                std::vector<int> nodeToJoint = ImportGltfSkin(document, job.skin, skeleton);
+                ImportGltfAnimations(document, nodeToJoint, skeleton, animationOptions_);
+                shared = std::make_shared<const Skeleton>(std::move(skeleton));
+            } catch (const std::exception& e) {
+                shared = EmptySkeleton();
+                char debugMsg[512];
+                sprintf_s(debugMsg, "GltfModelLoader: Skipped skin %d: %s\n", job.skin, e.what());
+                OutputDebugStringA(debugMsg);
+            }
+        }
+        
+        // Direct3D 資源只在呼叫端執行緒上依檔案順序建立
+        for (auto& job : jobs) {
+            if (!job.decoded) {
+                continue;
+            }
+            
+            // 創建 Direct3D 緩衝區
+            ModelData& modelData = job.model;
+            if (job.skin >= 0) {
+                modelData.skeleton = skeletons[job.skin];
+            }
+            if (!device) {
+                models[job.name] = std::move(modelData);
+                continue;
+            }
+            if (modelData.mesh.CreateBuffers(device)) {
+                // 載入貼圖（如果有的話）
+                if (!modelData.mesh.materials.empty() && !modelData.mesh.materials[0].textureFileName.empty()) {
+                    modelData.mesh.SetTexture(device, modelData.mesh.materials[0].textureFileName);
                 }
                 
-                // 創建 Direct3D 緩衝區
-                if (modelData.mesh.CreateBuffers(device)) {
-                    // 載入貼圖（如果有的話）
-                    if (!modelData.mesh.materials.empty() && !modelData.mesh.materials[0].textureFileName.empty()) {
-                        modelData.mesh.SetTexture(device, modelData.mesh.materials[0].textureFileName);
-                    }
-                    
-                    // 產生模型名稱
-                    std::string modelName = mesh.name;
-                    if (modelName.empty()) {
-                        modelName = "Mesh_" + std::to_string(meshIdx);
-                    }
-                    if (mesh.primitives.size() > 1) {
-                        modelName += "_" + std::to_string(primIdx);
-                    }
-                    
-                    models[modelName] = std::move(modelData);
-                }
+                models[job.name] = std::move(modelData);
             }
         }
         
@@ -206,38 +294,10 @@ std::map<std::string, ModelData> GltfModelLoader::Load(
 std::vector<std::string> GltfModelLoader::GetModelNames(
     const std::filesystem::path& file) const {
     
+    // 只解析 JSON 結構（GLB 不讀 BIN chunk），不解碼任何緩衝區
     std::vector<std::string> names;
-    
-    try {
-        // 載入 glTF 檔案以獲取模型名稱
-        tinygltf::TinyGLTF loader;
-        tinygltf::Model gltfModel;
-        std::string err, warn;
-        
-        bool isBinary = (file.extension() == ".glb");
-        bool ret = isBinary ? 
-            loader.LoadBinaryFromFile(&gltfModel, &err, &warn, file.string()) :
-            loader.LoadASCIIFromFile(&gltfModel, &err, &warn, file.string());
-            
-        if (ret) {
-            for (size_t meshIdx = 0; meshIdx < gltfModel.meshes.size(); ++meshIdx) {
-                const auto& mesh = gltfModel.meshes[meshIdx];
-                
-                for (size_t primIdx = 0; primIdx < mesh.primitives.size(); ++primIdx) {
-                    std::string modelName = mesh.name;
-                    if (modelName.empty()) {
-                        modelName = "Mesh_" + std::to_string(meshIdx);
-                    }
-                    if (mesh.primitives.size() > 1) {
-                        modelName += "_" + std::to_string(primIdx);
-                    }
-                    names.push_back(modelName);
-                }
-            }
-        }
-    } catch (...) {
-        // 錯誤處理
+    for (auto& info : ScanGltfMetadata(file)) {
+        names.push_back(std::move(info.name));
     }
-    
     return names;
 }
\ No newline at end of file
@@ -1,17 +1,35 @@
 #pragma once
+#include "GltfAnimation.h"
 #include "IModelLoader.h"
+#include "IPartialModelLoader.h"
 #include <filesystem>
 #include <map>
 #include <vector>
 #include <string>
 
-class GltfModelLoader : public IModelLoader {
+class GltfModelLoader : public IModelLoader, public IPartialModelLoader {
 public:
-    // 載入檔案中的所有模型
+    // animationOptions 控制 skin 動畫的匯入（例如重新取樣為均勻格點）
+    explicit GltfModelLoader(const GltfAnimationOptions& animationOptions = {})
+        : animationOptions_(animationOptions) {}
+    
+    // 載入檔案中的所有模型；device 為 nullptr 時只轉換 CPU 端資料，不建立緩衝區與貼圖（可在背景執行緒呼叫）
     [[nodiscard]] std::map<std::string, ModelData>
         Load(const std::filesystem::path& file, IDirect3DDevice9* device) const override;
     
     // 獲取檔案中包含的模型名稱列表（不實際載入）
     [[nodiscard]] std::vector<std::string>
         GetModelNames(const std::filesystem::path& file) const override;
+    
+    // 只轉換名稱為 objectName 的 primitive 並建立其緩衝區
+    // （緩衝區以記憶體對應存取，其他 primitive 的資料頁面不會被讀入）
+    [[nodiscard]] std::map<std::string, ModelData>
+        LoadObject(const std::filesystem::path& file, const std::string& objectName,
+                   IDirect3DDevice9* device) const override;
+
+private:
+    std::map<std::string, ModelData> LoadMeshes(
+        const std::filesystem::path& file, IDirect3DDevice9* device, const std::string* objectName) const;
+    
+    GltfAnimationOptions animationOptions_;
 };
\ No newline at end of file
@@ -0,0 +1,18 @@
+﻿#pragma once
+#include <filesystem>
+#include <map>
+#include <string>
+#include "ModelData.h"
+
+// 可只載入檔案中單一物件的 IModelLoader 擴充介面
+// ModelManager 以 dynamic_cast 偵測；未實作的載入器仍以完整載入後挑選物件
+class IPartialModelLoader {
+public:
+  virtual ~IPartialModelLoader() = default;
+
+  // 回傳最多一個項目（鍵為 objectName）；物件不存在時回傳空 map
+  // 檔案無法部分載入時，實作應退回完整載入後挑出該物件
+  [[nodiscard]] virtual std::map<std::string, ModelData>
+    LoadObject(const std::filesystem::path& file, const std::string& objectName,
+               IDirect3DDevice9* device) const = 0;
+};
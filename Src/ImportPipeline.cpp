@@ -0,0 +1,109 @@
+#include "ImportPipeline.h"
+#include <format>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// 每次讀取的上限；多個讀檔 worker 以位置讀取，不共用檔案指標
+constexpr size_t kReadChunk = 4u << 20;
+
+const char* const kStageNames[] = { "read", "parse", "process", "upload" };
+
+} // namespace
+
+std::vector<uint8_t> ReadFileBytes(const std::filesystem::path& file) {
+    std::vector<uint8_t> bytes;
+#ifdef _WIN32
+    HANDLE handle = CreateFileW(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error(std::format("無法開啟檔案: {}", file.string()));
+    }
+    LARGE_INTEGER fileSize = {};
+    if (!GetFileSizeEx(handle, &fileSize)) {
+        CloseHandle(handle);
+        throw std::runtime_error(std::format("無法取得檔案大小: {}", file.string()));
+    }
+    bytes.resize(static_cast<size_t>(fileSize.QuadPart));
+    for (size_t offset = 0; offset < bytes.size();) {
+        OVERLAPPED position = {};
+        position.Offset = static_cast<DWORD>(offset);
+        position.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(offset) >> 32);
+        DWORD request = static_cast<DWORD>((std::min)(kReadChunk, bytes.size() - offset));
+        DWORD read = 0;
+        if (!ReadFile(handle, bytes.data() + offset, request, &read, &position) || read == 0) {
+            CloseHandle(handle);
+            throw std::runtime_error(std::format("讀取檔案失敗: {}", file.string()));
+        }
+        offset += read;
+    }
+    CloseHandle(handle);
+#else
+    int fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error(std::format("無法開啟檔案: {}", file.string()));
+    }
+    struct stat info = {};
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw std::runtime_error(std::format("無法取得檔案大小: {}", file.string()));
+    }
+    bytes.resize(static_cast<size_t>(info.st_size));
+    for (size_t offset = 0; offset < bytes.size();) {
+        size_t request = (std::min)(kReadChunk, bytes.size() - offset);
+        ssize_t read = pread(fd, bytes.data() + offset, request, static_cast<off_t>(offset));
+        if (read <= 0) {
+            close(fd);
+            throw std::runtime_error(std::format("讀取檔案失敗: {}", file.string()));
+        }
+        offset += static_cast<size_t>(read);
+    }
+    close(fd);
+#endif
+    return bytes;
+}
+
+void ImportMemoryBudget::Acquire(uint64_t bytes) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    released_.wait(lock, [&] { return used_ == 0 || used_ + bytes <= limit_; });
+    used_ += bytes;
+    peak_ = (std::max)(peak_, used_);
+}
+
+void ImportMemoryBudget::Release(uint64_t bytes) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        used_ -= (std::min)(used_, bytes);
+    }
+    released_.notify_all();
+}
+
+uint64_t ImportMemoryBudget::Peak() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return peak_;
+}
+
+std::string ImportPipelineStats::ToString() const {
+    std::string text = std::format("import pipeline: {:.3f} s wall, peak in-flight {:.1f} MB, {} failure(s)\n",
+                                   wallSeconds, peakInFlightBytes / 1048576.0, failures.size());
+    for (size_t i = 0; i < static_cast<size_t>(ImportStage::Count); ++i) {
+        const ImportStageStats& stage = stages[i];
+        double rate = wallSeconds > 0.0 ? stage.items / wallSeconds : 0.0;
+        text += std::format("  {:<8} {:>6} items {:>8.1f}/s  busy {:.3f} s  starved {:.3f} s  blocked {:.3f} s",
+                            kStageNames[i], stage.items, rate, stage.busySeconds, stage.starvedSeconds,
+                            stage.blockedSeconds);
+        if (stage.bytesRead > 0) {
+            text += std::format("  {:.1f} MB/s", wallSeconds > 0.0 ? stage.bytesRead / 1048576.0 / wallSeconds : 0.0);
+        }
+        text += '\n';
+    }
+    return text;
+}
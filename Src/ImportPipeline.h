@@ -0,0 +1,319 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// 匯入管線的四個階段：讀檔 → 剖析 → CPU 處理 → 上傳
+enum class ImportStage { Read, Parse, Process, Upload, Count };
+
+struct ImportStageStats {
+    size_t items = 0;              // 完成（含失敗）的件數
+    size_t failures = 0;
+    uint64_t bytesRead = 0;        // 只有讀檔階段會累計
+    double busySeconds = 0.0;      // 執行階段工作的時間（所有 worker 加總）
+    double starvedSeconds = 0.0;   // 等待上游輸入的時間
+    double blockedSeconds = 0.0;   // 等待下游佇列空位或記憶體預算的時間
+};
+
+struct ImportPipelineStats {
+    ImportStageStats stages[static_cast<size_t>(ImportStage::Count)];
+    uint64_t peakInFlightBytes = 0;    // 在途資料預估位元組的峰值
+    double wallSeconds = 0.0;
+    std::vector<std::pair<std::filesystem::path, std::string>> failures;
+
+    const ImportStageStats& operator[](ImportStage stage) const { return stages[static_cast<size_t>(stage)]; }
+    ImportStageStats& operator[](ImportStage stage) { return stages[static_cast<size_t>(stage)]; }
+
+    // 每個階段一行：件數、吞吐量與 busy/starved/blocked 時間，供記錄或除錯輸出
+    std::string ToString() const;
+};
+
+struct ImportPipelineOptions {
+    size_t queueCapacity = 4;                  // 相鄰階段之間佇列的容量（件數）
+    uint64_t memoryBudget = 512ull << 20;      // 在途資料的預估位元組上限
+    double expansionFactor = 4.0;              // 一件在途資料的預估大小 = 檔案大小 × expansionFactor
+    size_t readWorkers = 2;
+    size_t parseWorkers = 0;                   // 0 表示硬體執行緒數
+    size_t processWorkers = 0;                 // 0 表示硬體執行緒數
+};
+
+// 以位置讀取（POSIX pread / Win32 ReadFile + OVERLAPPED offset）讀入整個檔案，失敗時拋出 std::runtime_error
+std::vector<uint8_t> ReadFileBytes(const std::filesystem::path& file);
+
+// 在途資料的記憶體預算：新工作進入管線前預留其預估大小，完成上傳後歸還
+// 沒有任何在途資料時一律允許進入，避免單一超過預算的檔案讓管線停住
+class ImportMemoryBudget {
+public:
+    explicit ImportMemoryBudget(uint64_t limit) : limit_(limit) {}
+
+    void Acquire(uint64_t bytes);
+    void Release(uint64_t bytes);
+    uint64_t Peak() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable released_;
+    uint64_t limit_;
+    uint64_t used_ = 0;
+    uint64_t peak_ = 0;
+};
+
+// 有容量上限的多生產者／多消費者佇列；Close 後 Push 失敗，Pop 取完剩餘項目後回傳 nullopt
+template <typename T>
+class ImportQueue {
+public:
+    explicit ImportQueue(size_t capacity) : capacity_(capacity ? capacity : 1) {}
+
+    bool Push(T item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notFull_.wait(lock, [&] { return closed_ || items_.size() < capacity_; });
+        if (closed_) {
+            return false;
+        }
+        items_.push_back(std::move(item));
+        notEmpty_.notify_one();
+        return true;
+    }
+
+    std::optional<T> Pop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notEmpty_.wait(lock, [&] { return closed_ || !items_.empty(); });
+        if (items_.empty()) {
+            return std::nullopt;
+        }
+        T item = std::move(items_.front());
+        items_.pop_front();
+        notFull_.notify_one();
+        return item;
+    }
+
+    void Close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        notEmpty_.notify_all();
+        notFull_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable notEmpty_;
+    std::condition_variable notFull_;
+    std::deque<T> items_;
+    size_t capacity_;
+    bool closed_ = false;
+};
+
+// 多檔案的分階段匯入：讀檔、剖析、處理三個階段各自有 worker，彼此以有界佇列串接，
+// 上游在下游佇列已滿時停下（back-pressure）；在途資料另受 ImportMemoryBudget 限制
+// 上傳階段在呼叫 Run 的執行緒上依完成順序執行（Direct3D 9 裝置只能在建立它的執行緒使用），
+// 不需要上傳時傳入空的 upload 即可在沒有裝置的環境執行
+// 任一階段拋出例外時該檔案略過後續階段並記錄於 stats.failures，其他檔案照常進行
+template <typename Parsed, typename Processed>
+class ImportPipeline {
+public:
+    using ParseFn = std::function<Parsed(const std::filesystem::path&, std::vector<uint8_t>&&)>;
+    using ProcessFn = std::function<Processed(const std::filesystem::path&, Parsed&&)>;
+    using UploadFn = std::function<void(const std::filesystem::path&, Processed&&)>;
+
+    ImportPipeline(ParseFn parse, ProcessFn process, UploadFn upload, const ImportPipelineOptions& options = {})
+        : parse_(std::move(parse)), process_(std::move(process)), upload_(std::move(upload)), options_(options) {}
+
+    ImportPipelineStats Run(const std::vector<std::filesystem::path>& files) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Job {
+        std::filesystem::path file;
+        uint64_t reserved = 0;
+        std::vector<uint8_t> bytes;
+        std::optional<Parsed> parsed;
+        std::optional<Processed> processed;
+        std::string error;
+    };
+
+    // 每個 worker 各自累計，結束時再合併，避免熱路徑上的共享寫入
+    struct StageTimer {
+        ImportStageStats stats;
+        Clock::time_point mark = Clock::now();
+
+        double Lap() {
+            Clock::time_point now = Clock::now();
+            double seconds = std::chrono::duration<double>(now - mark).count();
+            mark = now;
+            return seconds;
+        }
+    };
+
+    static size_t WorkerCount(size_t requested) {
+        return requested ? requested : (std::max)(1u, std::thread::hardware_concurrency());
+    }
+
+    static void Merge(ImportStageStats& into, const ImportStageStats& from) {
+        into.items += from.items;
+        into.failures += from.failures;
+        into.bytesRead += from.bytesRead;
+        into.busySeconds += from.busySeconds;
+        into.starvedSeconds += from.starvedSeconds;
+        into.blockedSeconds += from.blockedSeconds;
+    }
+
+    // 從 input 取出工作、以 work 處理後送往 output；最後一個結束的 worker 關閉 output
+    template <typename Work>
+    void RunStage(ImportQueue<Job>& input, ImportQueue<Job>& output, std::atomic<size_t>& active,
+                  ImportStageStats& merged, std::mutex& mergeMutex, Work&& work) const {
+        StageTimer timer;
+        while (std::optional<Job> job = input.Pop()) {
+            timer.stats.starvedSeconds += timer.Lap();
+            if (job->error.empty()) {
+                try {
+                    work(*job);
+                } catch (const std::exception& e) {
+                    job->error = e.what();
+                } catch (...) {
+                    job->error = "unknown exception";
+                }
+                timer.stats.failures += job->error.empty() ? 0 : 1;
+            }
+            timer.stats.items++;
+            timer.stats.busySeconds += timer.Lap();
+            output.Push(std::move(*job));
+            timer.stats.blockedSeconds += timer.Lap();
+        }
+        timer.stats.starvedSeconds += timer.Lap();
+        {
+            std::lock_guard<std::mutex> lock(mergeMutex);
+            Merge(merged, timer.stats);
+        }
+        if (active.fetch_sub(1) == 1) {
+            output.Close();
+        }
+    }
+
+    ParseFn parse_;
+    ProcessFn process_;
+    UploadFn upload_;
+    ImportPipelineOptions options_;
+};
+
+template <typename Parsed, typename Processed>
+ImportPipelineStats ImportPipeline<Parsed, Processed>::Run(const std::vector<std::filesystem::path>& files) const {
+    ImportPipelineStats stats;
+    Clock::time_point start = Clock::now();
+
+    ImportMemoryBudget budget(options_.memoryBudget);
+    ImportQueue<Job> parseQueue(options_.queueCapacity);
+    ImportQueue<Job> processQueue(options_.queueCapacity);
+    ImportQueue<Job> uploadQueue(options_.queueCapacity);
+    std::mutex mergeMutex;
+
+    // 讀檔：依序領取檔案，先向預算預留在途大小再讀入
+    size_t readWorkers = (std::min)(WorkerCount(options_.readWorkers), (std::max)(files.size(), size_t(1)));
+    std::atomic<size_t> nextFile{ 0 };
+    std::atomic<size_t> activeReaders{ readWorkers };
+    auto readWorker = [&]() {
+        StageTimer timer;
+        for (size_t i = nextFile.fetch_add(1); i < files.size(); i = nextFile.fetch_add(1)) {
+            Job job;
+            job.file = files[i];
+            std::error_code ec;
+            uint64_t fileSize = std::filesystem::file_size(job.file, ec);
+            job.reserved = ec ? 0 : static_cast<uint64_t>(static_cast<double>(fileSize) * options_.expansionFactor);
+            timer.Lap();
+            budget.Acquire(job.reserved);
+            timer.stats.blockedSeconds += timer.Lap();
+            try {
+                job.bytes = ReadFileBytes(job.file);
+                timer.stats.bytesRead += job.bytes.size();
+            } catch (const std::exception& e) {
+                job.error = e.what();
+                timer.stats.failures++;
+            }
+            timer.stats.items++;
+            timer.stats.busySeconds += timer.Lap();
+            parseQueue.Push(std::move(job));
+            timer.stats.blockedSeconds += timer.Lap();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mergeMutex);
+            Merge(stats[ImportStage::Read], timer.stats);
+        }
+        if (activeReaders.fetch_sub(1) == 1) {
+            parseQueue.Close();
+        }
+    };
+
+    size_t parseWorkers = WorkerCount(options_.parseWorkers);
+    size_t processWorkers = WorkerCount(options_.processWorkers);
+    std::atomic<size_t> activeParsers{ parseWorkers };
+    std::atomic<size_t> activeProcessors{ processWorkers };
+
+    std::vector<std::future<void>> workers;
+    workers.reserve(readWorkers + parseWorkers + processWorkers);
+    for (size_t w = 0; w < readWorkers; ++w) {
+        workers.push_back(std::async(std::launch::async, readWorker));
+    }
+    for (size_t w = 0; w < parseWorkers; ++w) {
+        workers.push_back(std::async(std::launch::async, [&]() {
+            RunStage(parseQueue, processQueue, activeParsers, stats[ImportStage::Parse], mergeMutex,
+                     [&](Job& job) {
+                         job.parsed.emplace(parse_(job.file, std::move(job.bytes)));
+                         job.bytes = {};
+                     });
+        }));
+    }
+    for (size_t w = 0; w < processWorkers; ++w) {
+        workers.push_back(std::async(std::launch::async, [&]() {
+            RunStage(processQueue, uploadQueue, activeProcessors, stats[ImportStage::Process], mergeMutex,
+                     [&](Job& job) {
+                         job.processed.emplace(process_(job.file, std::move(*job.parsed)));
+                         job.parsed.reset();
+                     });
+        }));
+    }
+
+    // 上傳：在呼叫端執行緒上進行，完成後歸還預算讓讀檔階段繼續
+    StageTimer upload;
+    while (std::optional<Job> job = uploadQueue.Pop()) {
+        upload.stats.starvedSeconds += upload.Lap();
+        if (job->error.empty() && upload_) {
+            try {
+                upload_(job->file, std::move(*job->processed));
+            } catch (const std::exception& e) {
+                job->error = e.what();
+            } catch (...) {
+                job->error = "unknown exception";
+            }
+            upload.stats.failures += job->error.empty() ? 0 : 1;
+        }
+        if (!job->error.empty()) {
+            stats.failures.emplace_back(job->file, std::move(job->error));
+        }
+        upload.stats.items++;
+        job->processed.reset();
+        budget.Release(job->reserved);
+        upload.stats.busySeconds += upload.Lap();
+    }
+    stats[ImportStage::Upload] = upload.stats;
+
+    for (auto& worker : workers) {
+        worker.get();
+    }
+    stats.peakInFlightBytes = budget.Peak();
+    stats.wallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return stats;
+}
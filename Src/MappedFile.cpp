@@ -0,0 +1,98 @@
+#include "MappedFile.h"
+#include <format>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::filesystem::path& file) {
+#ifdef _WIN32
+    HANDLE handle = CreateFileW(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error(std::format("無法開啟檔案: {}", file.string()));
+    }
+    LARGE_INTEGER fileSize = {};
+    if (!GetFileSizeEx(handle, &fileSize)) {
+        CloseHandle(handle);
+        throw std::runtime_error(std::format("無法取得檔案大小: {}", file.string()));
+    }
+    if (fileSize.QuadPart == 0) {
+        CloseHandle(handle);
+        return;
+    }
+
+    // 檢視建立後即可關閉檔案與對應物件的 handle，檢視本身會保持對應
+    HANDLE mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(handle);
+    if (!mapping) {
+        throw std::runtime_error(std::format("無法建立檔案對應: {}", file.string()));
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view) {
+        throw std::runtime_error(std::format("無法對應檔案: {}", file.string()));
+    }
+    data_ = static_cast<const uint8_t*>(view);
+    size_ = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error(std::format("無法開啟檔案: {}", file.string()));
+    }
+    struct stat st = {};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error(std::format("無法取得檔案大小: {}", file.string()));
+    }
+    if (st.st_size == 0) {
+        ::close(fd);
+        return;
+    }
+
+    void* view = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        throw std::runtime_error(std::format("無法對應檔案: {}", file.string()));
+    }
+    data_ = static_cast<const uint8_t*>(view);
+    size_ = static_cast<size_t>(st.st_size);
+#endif
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+void MappedFile::Close() noexcept {
+    if (!data_) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+#else
+    ::munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+// 唯讀記憶體對應檔案：內容由作業系統依需求分頁載入，不會複製到行程的堆積
+// 開啟失敗時建構子拋出 std::runtime_error；空檔案的 data() 為 nullptr
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::filesystem::path& file);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const uint8_t* data() const noexcept { return data_; }
+    size_t size() const noexcept { return size_; }
+    std::span<const uint8_t> bytes() const noexcept { return { data_, size_ }; }
+
+private:
+    void Close() noexcept;
+
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
@@ -5,11 +5,25 @@
 #include "SkinMesh.h" 
 #include "Skeleton.h"
 
+// 沒有骨架的模型共用的空骨架，讓 ModelData::skeleton 永遠不是 nullptr
+inline const std::shared_ptr<const Skeleton>& EmptySkeleton() {
+  static const std::shared_ptr<const Skeleton> empty = std::make_shared<const Skeleton>();
+  return empty;
+}
+
+// 只能移動：網格持有 D3D 緩衝的裸指標（SkinMesh 本身只能移動，移動後來源不再持有緩衝）
 struct ModelData {
   SkinMesh mesh;
-  Skeleton skeleton;
+  // 骨架與動畫建立後不再修改，同一檔案的所有網格共用同一份（指派只增加參考計數）
+  std::shared_ptr<const Skeleton> skeleton = EmptySkeleton();
   std::shared_ptr<ID3DXAnimationController> animController;
   
   // Texture loading control
   bool useOriginalTextures = false;  // Default: don't use textures from model file
+
+  ModelData() = default;
+  ModelData(ModelData&&) noexcept = default;
+  ModelData& operator=(ModelData&&) noexcept = default;
+  ModelData(const ModelData&) = delete;
+  ModelData& operator=(const ModelData&) = delete;
 };
@@ -1,5 +1,6 @@
 ﻿// Step 0: ModelManager.cpp 必要 include // error check
 #include "ModelManager.h"
+#include <algorithm>            // std::find_if
 #include <stdexcept>            // std::invalid_argument
 
 // Factory 函式實作
@@ -21,6 +22,7 @@ ModelManager::ModelManager(std::unique_ptr<IModelLoader> loader, ITextureManager
 // Step 2: Initialize 可重置注入 // error check
 void ModelManager::Initialize(std::unique_ptr<IModelLoader> loader) {
   loader_ = std::move(loader);
+  ReleaseAllHandles();
   models_.clear();
 }
 
@@ -37,7 +39,9 @@ void ModelManager::LoadModels(
     throw std::invalid_argument("ModelManager::LoadModels: device is null");
   }
   // 委派給注入的 loader
-  models_ = loader_->Load(file, device);
+  auto loaded = loader_->Load(file, device);
+  ReleaseAllHandles();
+  models_ = std::move(loaded);
 }
 
 // Step 4: GetModel 實作 // error check
@@ -50,6 +54,51 @@ const ModelData* ModelManager::GetModel(
   return nullptr;
 }
 
+// Step 4a: handle 查詢
+ModelHandle ModelManager::GetModelHandle(const std::string& name) const {
+  if (auto it = handles_.find(name); it != handles_.end()) {
+    return it->second;
+  }
+  auto model = models_.find(name);
+  if (model == models_.end()) {
+    return {};
+  }
+  // 不持有擁有權的 shared_ptr：模型的生命週期由 models_ 管理
+  std::shared_ptr<const ModelData> view(std::shared_ptr<const ModelData>{}, &model->second);
+  ModelHandle handle = handlePool_.Insert(std::move(view));
+  if (handle.IsValid()) {
+    handles_.emplace(name, handle);
+  }
+  return handle;
+}
+
+const ModelData* ModelManager::GetModel(ModelHandle handle) const noexcept {
+  return handlePool_.Resolve(handle);
+}
+
+void ModelManager::ReleaseHandle(const std::string& name) noexcept {
+  if (auto it = handles_.find(name); it != handles_.end()) {
+    handlePool_.Remove(it->second);
+    handles_.erase(it);
+  }
+}
+
+void ModelManager::ReleaseAllHandles() noexcept {
+  handlePool_.Clear();
+  handles_.clear();
+}
+
+std::map<std::string, ModelData> ModelManager::LoadSingleModel(
+  const std::filesystem::path& file,
+  const std::string& modelName,
+  IDirect3DDevice9* device
+) const {
+  if (auto* partial = dynamic_cast<const IPartialModelLoader*>(loader_.get())) {
+    return partial->LoadObject(file, modelName, device);
+  }
+  return loader_->Load(file, device);
+}
+
 // Step 5: 載入特定模型實作
 bool ModelManager::LoadModel(
   const std::filesystem::path& file,
@@ -67,12 +116,12 @@ bool ModelManager::LoadModel(
     throw std::invalid_argument("ModelManager::LoadModel: device is null");
   }
 
-  // 載入檔案中的所有模型
-  auto allModels = loader_->Load(file, device);
+  // 只載入指定的模型（載入器支援時不解碼其他物件）
+  auto loaded = LoadSingleModel(file, modelName, device);
   
   // 檢查指定的模型是否存在
-  auto it = allModels.find(modelName);
-  if (it == allModels.end()) {
+  auto it = loaded.find(modelName);
+  if (it == loaded.end()) {
     return false; // 模型不存在
   }
   
@@ -102,12 +151,12 @@ bool ModelManager::LoadModelAs(
     throw std::invalid_argument("ModelManager::LoadModelAs: device is null");
   }
 
-  // 載入檔案中的所有模型
-  auto allModels = loader_->Load(file, device);
+  // 只載入指定的模型（載入器支援時不解碼其他物件）
+  auto loaded = LoadSingleModel(file, modelName, device);
   
   // 檢查指定的模型是否存在
-  auto it = allModels.find(modelName);
-  if (it == allModels.end()) {
+  auto it = loaded.find(modelName);
+  if (it == loaded.end()) {
     return false; // 模型不存在
   }
   
@@ -137,6 +186,28 @@ std::vector<std::string> ModelManager::GetAvailableModels(const std::filesystem:
   return loader_->GetModelNames(file);
 }
 
+std::vector<ModelObjectInfo> ModelManager::GetAvailableModelInfo(const std::filesystem::path& file) const {
+  if (!loader_) {
+    return {};
+  }
+
+  // 以載入器的名稱為準，數量由格式略讀器提供
+  std::vector<ModelObjectInfo> scanned = ScanModelMetadata(file);
+  std::vector<ModelObjectInfo> result;
+  for (auto& name : loader_->GetModelNames(file)) {
+    auto it = std::find_if(scanned.begin(), scanned.end(),
+      [&name](const ModelObjectInfo& info) { return info.name == name; });
+    if (it != scanned.end()) {
+      result.push_back(*it);
+    } else {
+      ModelObjectInfo info;
+      info.name = std::move(name);
+      result.push_back(std::move(info));
+    }
+  }
+  return result;
+}
+
 // Step 8: 檢查模型是否存在實作
 bool ModelManager::HasModel(const std::string& name) const noexcept {
   return models_.find(name) != models_.end();
@@ -146,6 +217,7 @@ bool ModelManager::HasModel(const std::string& name) const noexcept {
 bool ModelManager::RemoveModel(const std::string& name) {
   auto it = models_.find(name);
   if (it != models_.end()) {
+    ReleaseHandle(name);
     models_.erase(it);
     return true;
   }
@@ -154,5 +226,6 @@ bool ModelManager::RemoveModel(const std::string& name) {
 
 // Step 10: Clear 實作 // error check
 void ModelManager::Clear() noexcept {
+  ReleaseAllHandles();
   models_.clear();
 }
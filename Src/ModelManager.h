@@ -4,10 +4,16 @@
 #include <filesystem>           // std::filesystem::path
 #include <map>                  // std::map
 #include <string>               // std::string
+#include <unordered_map>        // std::unordered_map
 #include "IModelManager.h"
 #include "IModelLoader.h"       // IModelLoader 定義
+#include "IPartialModelLoader.h" // IPartialModelLoader 定義
 #include "ModelData.h"          // ModelData 定義
+#include "ModelMetadata.h"      // ModelObjectInfo 定義
 #include "ITextureManager.h"    // ITextureManager 定義
+#include "ResourceHandle.h"     // ResourceHandle / HandlePool
+
+using ModelHandle = ResourceHandle<ModelData>;
 
 class ModelManager : public IModelManager {
 
@@ -29,11 +35,20 @@ public:
   
   // 查詢檔案中包含的模型列表
   std::vector<std::string> GetAvailableModels(const std::filesystem::path& file) const override;
+
+  // 查詢檔案中各模型的頂點/三角形/材質數量，只略讀檔案結構，不載入模型
+  // 名稱與 GetAvailableModels 一致；略讀不支援的格式只回傳名稱，數量為 0
+  std::vector<ModelObjectInfo> GetAvailableModelInfo(const std::filesystem::path& file) const;
   
   // 檢查模型是否存在
   bool HasModel(const std::string& name) const noexcept override;
   
   [[nodiscard]] const ModelData* GetModel(const std::string& name) const noexcept override;
+
+  // 取得模型 handle（查詢一次名稱），之後每幀以 handle 取得模型，不做字串比較
+  // 模型被移除或整批重新載入後 handle 失效，GetModel 回傳 nullptr
+  [[nodiscard]] ModelHandle GetModelHandle(const std::string& name) const;
+  [[nodiscard]] const ModelData* GetModel(ModelHandle handle) const noexcept;
   void Clear() noexcept override;
   
   // 移除特定模型
@@ -46,4 +61,15 @@ private:
   ITextureManager* textureManager_;
   // 模型名稱到 ModelData 的映射
   std::map<std::string, ModelData> models_;
+  // 已發出的 handle；指向 models_ 的節點（std::map 節點位址在移除前不變）
+  mutable HandlePool<const ModelData, ModelData> handlePool_;
+  mutable std::unordered_map<std::string, ModelHandle> handles_;
+
+  // 載入器實作 IPartialModelLoader 時只載入 modelName，否則完整載入
+  std::map<std::string, ModelData> LoadSingleModel(const std::filesystem::path& file,
+                                                   const std::string& modelName,
+                                                   IDirect3DDevice9* device) const;
+
+  void ReleaseHandle(const std::string& name) noexcept;
+  void ReleaseAllHandles() noexcept;
 };
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "ModelMetadata.h"
+#include "XFileParser.h"
+#include "json.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+std::string ReadGltfJson(const fs::path& file) {
+    std::ifstream in(file, std::ios::binary);
+    if (!in) {
+        return {};
+    }
+
+    std::string ext = file.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    std::string text;
+    if (ext == ".glb") {
+        // GLB：12 位元組檔頭 + 第一個 chunk 必為 JSON；header[2] 為檔案總長度
+        uint32_t header[5] = {};
+        if (!in.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+            header[0] != 0x46546C67u || header[4] != 0x4E4F534Au ||
+            header[2] < sizeof(header) || header[3] > header[2] - sizeof(header)) {
+            return {};
+        }
+        text.resize(header[3]);
+        if (!in.read(text.data(), static_cast<std::streamsize>(text.size()))) {
+            return {};
+        }
+    } else {
+        text.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    return text;
+}
+
+std::string GltfModelName(const json& mesh, size_t meshIndex, size_t primitiveIndex) {
+    std::string name = mesh.value("name", std::string());
+    if (name.empty()) {
+        name = "Mesh_" + std::to_string(meshIndex);
+    }
+    auto prims = mesh.find("primitives");
+    if (prims != mesh.end() && prims->is_array() && prims->size() > 1) {
+        name += "_" + std::to_string(primitiveIndex);
+    }
+    return name;
+}
+
+namespace {
+
+uint32_t AccessorCount(const json& accessors, const json& index) {
+    if (!index.is_number_unsigned() || index.get<size_t>() >= accessors.size()) {
+        return 0;
+    }
+    return accessors[index.get<size_t>()].value("count", 0u);
+}
+
+uint32_t TriangleCount(int mode, uint32_t elementCount) {
+    switch (mode) {
+        case 4:     // TRIANGLES
+            return elementCount / 3;
+        case 5:     // TRIANGLE_STRIP
+        case 6:     // TRIANGLE_FAN
+            return elementCount >= 3 ? elementCount - 2 : 0;
+        default:    // 點與線
+            return 0;
+    }
+}
+
+} // namespace
+
+std::vector<ModelObjectInfo> ScanGltfMetadata(const fs::path& file) {
+    json doc = json::parse(ReadGltfJson(file), nullptr, false);
+    if (doc.is_discarded() || !doc.is_object()) {
+        return {};
+    }
+
+    static const json kEmpty = json::array();
+    auto section = [&doc](const char* name) -> const json& {
+        auto it = doc.find(name);
+        return it != doc.end() && it->is_array() ? *it : kEmpty;
+    };
+    const json& accessors = section("accessors");
+    const json& meshes = section("meshes");
+
+    std::vector<ModelObjectInfo> result;
+    for (size_t meshIdx = 0; meshIdx < meshes.size(); ++meshIdx) {
+        const json& mesh = meshes[meshIdx];
+        auto prims = mesh.find("primitives");
+        if (prims == mesh.end() || !prims->is_array()) {
+            continue;
+        }
+
+        for (size_t primIdx = 0; primIdx < prims->size(); ++primIdx) {
+            const json& prim = (*prims)[primIdx];
+            auto attributes = prim.find("attributes");
+            if (attributes == prim.end() || !attributes->contains("POSITION")) {
+                continue;   // 載入器同樣略過沒有位置的 primitive
+            }
+
+            ModelObjectInfo info;
+            info.name = GltfModelName(mesh, meshIdx, primIdx);
+            info.vertexCount = AccessorCount(accessors, (*attributes)["POSITION"]);
+            if (info.vertexCount == 0) {
+                continue;   // 載入器不建立沒有頂點的模型
+            }
+            auto indices = prim.find("indices");
+            uint32_t elementCount = indices != prim.end()
+                ? AccessorCount(accessors, *indices) : info.vertexCount;
+            info.triangleCount = TriangleCount(prim.value("mode", 4), elementCount);
+            info.materialCount = 1;   // 載入器對每個 primitive 建立一個材質（缺少時為預設材質）
+            result.push_back(std::move(info));
+        }
+    }
+    return result;
+}
+
+std::vector<ModelObjectInfo> ScanXFileMetadata(const fs::path& file) {
+    std::vector<XFileMeshInfo> meshes;
+    try {
+        meshes = ScanXFile(file);
+    }
+    catch (const std::exception&) {
+        return {};
+    }
+
+    // 名稱在略過空 Mesh 之前決定，mesh_N 與 _N 序號與載入器一致
+    std::vector<std::string> names = XFileModelNames(meshes);
+    std::vector<ModelObjectInfo> result;
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        if (meshes[i].triangleCount == 0) {
+            continue;   // XNativeModelLoader::BuildModels 同樣不建立沒有三角形的模型
+        }
+        ModelObjectInfo info;
+        info.name = std::move(names[i]);
+        info.vertexCount = meshes[i].vertexCount;
+        info.triangleCount = meshes[i].triangleCount;
+        info.materialCount = meshes[i].materialCount;
+        result.push_back(std::move(info));
+    }
+    return result;
+}
+
+std::vector<ModelObjectInfo> ScanModelMetadata(const fs::path& file) {
+    std::string ext = file.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+    if (ext == ".gltf" || ext == ".glb") {
+        return ScanGltfMetadata(file);
+    }
+    if (ext == ".x") {
+        return ScanXFileMetadata(file);
+    }
+    return {};
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "json.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// 模型檔中單一物件的結構資訊（不含頂點資料），供資產瀏覽器與模型清單使用
+struct ModelObjectInfo {
+    std::string name;               // 與對應載入器產生的模型名稱相同
+    uint32_t vertexCount = 0;
+    uint32_t triangleCount = 0;
+    uint32_t materialCount = 0;
+};
+
+// 只讀取檔案結構，不解碼頂點、不建立裝置資源；列出的物件與名稱和對應載入器產生的模型相同
+// - glTF/GLB：只讀 JSON（GLB 不讀 BIN chunk），數量取自 accessor.count；每個有頂點的 primitive 一個物件，命名為 GltfModelName
+// - .x：略讀 Frame/Mesh 結構；每個有三角形的 Mesh 一個物件，命名為 XFileModelNames
+//   （XModelLoader、XModelEnhanced 與 XNativeModelLoader 共用此規則）
+// 不支援的格式或解析失敗回傳空列表
+std::vector<ModelObjectInfo> ScanModelMetadata(const std::filesystem::path& file);
+std::vector<ModelObjectInfo> ScanGltfMetadata(const std::filesystem::path& file);
+std::vector<ModelObjectInfo> ScanXFileMetadata(const std::filesystem::path& file);
+
+// glTF 模型名稱：mesh.name（沒有時為 Mesh_<meshIndex>），有多個 primitive 時加上 _<primitiveIndex>
+std::string GltfModelName(const nlohmann::json& mesh, size_t meshIndex, size_t primitiveIndex);
+
+// 讀取 .gltf 的全文或 .glb 的 JSON chunk；失敗回傳空字串
+std::string ReadGltfJson(const std::filesystem::path& file);
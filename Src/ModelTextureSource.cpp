@@ -0,0 +1,58 @@
+#include "ModelTextureSource.h"
+#include <d3dx9.h>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace {
+
+struct SourceRegistry {
+    std::shared_mutex mutex;
+    std::unordered_map<IDirect3DDevice9*, ModelTextureSource> sources;
+};
+
+SourceRegistry& Registry() {
+    static SourceRegistry registry;
+    return registry;
+}
+
+} // namespace
+
+void RegisterModelTextureSource(IDirect3DDevice9* device, ModelTextureSource source) {
+    auto& registry = Registry();
+    std::lock_guard<std::shared_mutex> lock(registry.mutex);
+    if (source) {
+        registry.sources[device] = std::move(source);
+    } else {
+        registry.sources.erase(device);
+    }
+}
+
+void UnregisterModelTextureSource(IDirect3DDevice9* device) {
+    RegisterModelTextureSource(device, nullptr);
+}
+
+HRESULT CreateModelTexture(IDirect3DDevice9* device, const std::filesystem::path& reference,
+                           IDirect3DTexture9** texture) {
+    if (!device || !texture) {
+        return E_INVALIDARG;
+    }
+    *texture = nullptr;
+
+    ModelTextureSource source;
+    {
+        auto& registry = Registry();
+        std::shared_lock<std::shared_mutex> lock(registry.mutex);
+        auto it = registry.sources.find(device);
+        if (it != registry.sources.end()) {
+            source = it->second;
+        }
+    }
+
+    // 來源可能重新進入載入流程（例如經由資產快取），不可持有 registry 的鎖呼叫
+    if (source) {
+        *texture = source(reference);
+        return *texture ? S_OK : E_FAIL;
+    }
+    return D3DXCreateTextureFromFileA(device, reference.string().c_str(), texture);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <d3d9.h>
+#include <filesystem>
+#include <functional>
+
+// 模型載入器取得材質貼圖的來源
+// AllocateHierarchy、SkinMesh、FbxLoader 等載入器不直接以 D3DX 讀檔，而是經由 CreateModelTexture 取得貼圖：
+// 裝置註冊了來源時一律由它提供（AssetManager 以自己的 TextureManager 提供，與 Prefetch 共用同一份快取），
+// 否則退回 D3DXCreateTextureFromFileA。來源回傳的貼圖需已 AddRef，找不到時回傳 nullptr
+using ModelTextureSource = std::function<IDirect3DTexture9*(const std::filesystem::path& reference)>;
+
+// 每個裝置最多一個來源，重複註冊時取代；可從任何執行緒呼叫
+void RegisterModelTextureSource(IDirect3DDevice9* device, ModelTextureSource source);
+void UnregisterModelTextureSource(IDirect3DDevice9* device);
+
+// 取代載入器中的 D3DXCreateTextureFromFileA；成功時 *texture 為已 AddRef 的貼圖，呼叫端負責 Release
+HRESULT CreateModelTexture(IDirect3DDevice9* device, const std::filesystem::path& reference,
+                           IDirect3DTexture9** texture);
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 以最多 maxWorkers 個執行緒（0 表示硬體執行緒數）執行 body(0) … body(count - 1)
+// - worker 以原子計數器逐一領取索引，工作量不均時仍能平衡負載；呼叫端執行緒也參與工作
+// - 全部索引完成後才返回；body 拋出例外不會中止其他索引，結束後重新拋出索引最小者的例外
+// body 會被多個執行緒同時呼叫，結果應寫入以索引區分的位置，順序因此與排程無關
+template <typename Body>
+void ParallelFor(size_t count, Body&& body, size_t maxWorkers = 0) {
+    if (count == 0) {
+        return;
+    }
+    size_t workers = maxWorkers ? maxWorkers : (std::max)(1u, std::thread::hardware_concurrency());
+    workers = (std::min)(workers, count);
+
+    std::atomic<size_t> next{ 0 };
+    std::mutex errorMutex;
+    size_t errorIndex = count;
+    std::exception_ptr error;
+
+    auto run = [&]() {
+        for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+             i = next.fetch_add(1, std::memory_order_relaxed)) {
+            try {
+                body(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (i < errorIndex) {
+                    errorIndex = i;
+                    error = std::current_exception();
+                }
+            }
+        }
+    };
+
+    std::vector<std::future<void>> helpers;
+    helpers.reserve(workers - 1);
+    for (size_t w = 1; w < workers; ++w) {
+        helpers.push_back(std::async(std::launch::async, run));
+    }
+    run();
+    for (auto& helper : helpers) {
+        helper.wait();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// 世代式資源 handle：index 指向扁平陣列中的槽位，generation 在槽位被移除時遞增，
+// 因此過期的 handle 會解析失敗而不是指到新的資源
+template <typename Tag>
+struct ResourceHandle {
+  uint32_t index = 0;
+  uint32_t generation = 0;   // 0 表示無效 handle
+
+  bool IsValid() const noexcept { return generation != 0; }
+  bool operator==(const ResourceHandle& other) const noexcept {
+    return index == other.index && generation == other.generation;
+  }
+  bool operator!=(const ResourceHandle& other) const noexcept { return !(*this == other); }
+};
+
+// handle 資源池
+// - Insert/Remove/Clear 取內部鎖
+// - Resolve 不取鎖：分頁一旦配置就不會移動，只做兩次 atomic 讀取
+// Resolve 回傳的指標在該槽位被 Remove 之前有效；移除資源應在使用它的執行緒上（例如影格邊界）進行
+template <typename T, typename Tag = T>
+class HandlePool {
+public:
+  using Handle = ResourceHandle<Tag>;
+
+  HandlePool() {
+    for (auto& page : pages_) {
+      page.store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  HandlePool(const HandlePool&) = delete;
+  HandlePool& operator=(const HandlePool&) = delete;
+
+  Handle Insert(std::shared_ptr<T> resource) {
+    if (!resource) {
+      return {};
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint32_t index;
+    if (!freeList_.empty()) {
+      index = freeList_.back();
+      freeList_.pop_back();
+    } else {
+      index = nextIndex_;
+      if ((index >> kPageBits) >= kMaxPages) {
+        return {};   // 超出容量
+      }
+      if (!pages_[index >> kPageBits].load(std::memory_order_relaxed)) {
+        ownedPages_.push_back(std::make_unique<Page>());
+        pages_[index >> kPageBits].store(ownedPages_.back().get(), std::memory_order_release);
+      }
+      ++nextIndex_;
+    }
+
+    Slot& slot = SlotAt(index);
+    uint32_t generation = slot.generation.load(std::memory_order_relaxed);
+    slot.raw.store(resource.get(), std::memory_order_release);
+    slot.owner = std::move(resource);
+    return { index, generation };
+  }
+
+  void Remove(Handle handle) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!handle.IsValid() || handle.index >= nextIndex_) {
+      return;
+    }
+    Slot& slot = SlotAt(handle.index);
+    if (slot.generation.load(std::memory_order_relaxed) != handle.generation) {
+      return;
+    }
+    RetireSlot(slot, handle.index);
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (uint32_t index = 0; index < nextIndex_; ++index) {
+      Slot& slot = SlotAt(index);
+      if (slot.owner) {
+        RetireSlot(slot, index);
+      }
+    }
+  }
+
+  T* Resolve(Handle handle) const noexcept {
+    if (!handle.IsValid() || (handle.index >> kPageBits) >= kMaxPages) {
+      return nullptr;
+    }
+    const Page* page = pages_[handle.index >> kPageBits].load(std::memory_order_acquire);
+    if (!page) {
+      return nullptr;
+    }
+    const Slot& slot = page->slots[handle.index & kPageMask];
+    if (slot.generation.load(std::memory_order_acquire) != handle.generation) {
+      return nullptr;
+    }
+    T* resource = slot.raw.load(std::memory_order_acquire);
+    // 讀取期間槽位被回收時放棄結果
+    if (slot.generation.load(std::memory_order_acquire) != handle.generation) {
+      return nullptr;
+    }
+    return resource;
+  }
+
+private:
+  static constexpr uint32_t kPageBits = 10;
+  static constexpr uint32_t kPageSize = 1u << kPageBits;
+  static constexpr uint32_t kPageMask = kPageSize - 1;
+  static constexpr uint32_t kMaxPages = 1024;
+
+  struct Slot {
+    std::atomic<uint32_t> generation{ 1 };
+    std::atomic<T*> raw{ nullptr };
+    std::shared_ptr<T> owner;
+  };
+
+  struct Page {
+    Slot slots[kPageSize];
+  };
+
+  Slot& SlotAt(uint32_t index) {
+    return pages_[index >> kPageBits].load(std::memory_order_relaxed)->slots[index & kPageMask];
+  }
+
+  void RetireSlot(Slot& slot, uint32_t index) {
+    uint32_t next = slot.generation.load(std::memory_order_relaxed) + 1;
+    slot.generation.store(next == 0 ? 1 : next, std::memory_order_release);
+    slot.raw.store(nullptr, std::memory_order_release);
+    slot.owner.reset();
+    freeList_.push_back(index);
+  }
+
+  std::array<std::atomic<Page*>, kMaxPages> pages_;
+  std::vector<std::unique_ptr<Page>> ownedPages_;
+  std::vector<uint32_t> freeList_;
+  uint32_t nextIndex_ = 0;
+  std::mutex mutex_;
+};
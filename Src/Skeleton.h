@@ -18,6 +18,9 @@ struct SkeletonAnimation {
   std::string name;
   float duration;
   std::vector<std::vector<SkeletonAnimationKey>> channels;
+  // > 0 表示通道為均勻取樣：第 i 個 key 的時間為 i / framesPerSecond（只有一個 key 的通道為常數），
+  // 播放時可直接換算 key 索引；0 表示 key 時間不規則，需要搜尋
+  float framesPerSecond = 0.0f;
 };
 
 class Skeleton {
@@ -1,5 +1,6 @@
 ﻿#define NOMINMAX
 #include "SkinMesh.h"
+#include "ModelTextureSource.h"
 #include <iostream>
 #include <d3dx9.h>
 #include <iostream>
@@ -109,7 +110,7 @@ void SkinMesh::LoadMaterials(IDirect3DDevice9* dev, ID3DXBuffer* materialBuffer,
     // 2) 載入貼圖（如果檔名非空）
     if (mats[i].pTextureFilename && mats[i].pTextureFilename[0] != '\0') {
       
-      HRESULT hr = D3DXCreateTextureFromFileA(
+      HRESULT hr = CreateModelTexture(
         dev,
         mats[i].pTextureFilename,
         &materials[i].tex
@@ -141,7 +142,7 @@ void SkinMesh::SetTexture(IDirect3DDevice9* dev, const std::string& file) {
     texture = nullptr;
   }
   // 從檔案建立新貼圖
-  HRESULT hr = D3DXCreateTextureFromFileA(dev, file.c_str(), &texture);
+  HRESULT hr = CreateModelTexture(dev, file, &texture);
   char debugMsg[256];
   if (FAILED(hr)) {
     sprintf_s(debugMsg, "SetTexture 無法載入貼圖: %s (HRESULT: 0x%08X)\n", file.c_str(), hr);
@@ -3,6 +3,7 @@
 #include <d3dx9.h>
 #include <vector>
 #include <string>
+#include <utility>
 #include <DirectXMath.h>
 
 using namespace DirectX;
@@ -47,6 +48,7 @@ typedef struct _ISkinMesh {
 } ISkinMesh;
 
 // 使用 SkinMesh 避免與 D3DXMesh 衝突
+// 只能移動：vb/ib/texture 為持有參考的裸指標，移動後來源的指標清為 nullptr，避免兩份網格釋放同一組緩衝
 class SkinMesh : public ISkinMesh {
 public:
   std::vector<Vertex> vertices = {};
@@ -57,6 +59,28 @@ public:
   IDirect3DIndexBuffer9* ib = nullptr;
   IDirect3DTexture9* texture = nullptr;
 
+  SkinMesh() = default;
+  SkinMesh(SkinMesh&& other) noexcept
+    : ISkinMesh(std::move(other)), vertices(std::move(other.vertices)), indices(std::move(other.indices)),
+      materials(std::move(other.materials)), vb(std::exchange(other.vb, nullptr)),
+      ib(std::exchange(other.ib, nullptr)), texture(std::exchange(other.texture, nullptr)) {}
+  // 先釋放自己持有的緩衝再接手來源的
+  SkinMesh& operator=(SkinMesh&& other) noexcept {
+    if (this != &other) {
+      ReleaseBuffers();
+      ISkinMesh::operator=(std::move(other));
+      vertices = std::move(other.vertices);
+      indices = std::move(other.indices);
+      materials = std::move(other.materials);
+      vb = std::exchange(other.vb, nullptr);
+      ib = std::exchange(other.ib, nullptr);
+      texture = std::exchange(other.texture, nullptr);
+    }
+    return *this;
+  }
+  SkinMesh(const SkinMesh&) = delete;
+  SkinMesh& operator=(const SkinMesh&) = delete;
+
   bool CreateBuffers(IDirect3DDevice9* dev);
   void LoadMaterials(IDirect3DDevice9* dev, ID3DXBuffer* materialBuffer, DWORD numMaterials);
   void SetTexture(IDirect3DDevice9* dev, const std::string& file);
@@ -0,0 +1,339 @@
+#include "TextureCache.h"
+#include "ContentHash.h"
+#include <algorithm>
+#include <format>
+#include <mutex>
+
+const char* TextureCategoryName(TextureCategory category) noexcept {
+    switch (category) {
+    case TextureCategory::UI:
+        return "UI";
+    case TextureCategory::Model:
+        return "Model";
+    default:
+        return "?";
+    }
+}
+
+const char* TextureVariantName(TextureVariant variant) noexcept {
+    switch (variant) {
+    case TextureVariant::Stretched:
+        return "Stretched";
+    case TextureVariant::Mipmapped:
+        return "Mipmapped";
+    case TextureVariant::TopLevel:
+        return "TopLevel";
+    case TextureVariant::Streamed:
+        return "Streamed";
+    default:
+        return "?";
+    }
+}
+
+std::span<const TextureVariant> AcceptedTextureVariants(TextureCategory category) noexcept {
+    static constexpr TextureVariant kUI[] = { TextureVariant::TopLevel, TextureVariant::Mipmapped,
+                                              TextureVariant::Stretched };
+    static constexpr TextureVariant kMipmapped[] = { TextureVariant::Mipmapped, TextureVariant::Stretched };
+    if (category == TextureCategory::UI) {
+        return kUI;
+    }
+    return kMipmapped;
+}
+
+std::string TextureCacheStats::ToString() const {
+    std::string text = std::format("texture cache: {} texture(s), {:.1f} MB resident, {} path(s)\n", textures,
+                                   residentBytes / 1048576.0, paths);
+    text += std::format("  shared across categories: {} load(s), {:.1f} MB avoided\n", crossCategoryHits,
+                        crossCategoryBytesSaved / 1048576.0);
+    text += std::format("  same content, other path: {} load(s), {:.1f} MB avoided ({} hash collision(s))\n",
+                        duplicateLoads, bytesSaved / 1048576.0, hashCollisions);
+    text += std::format("  evicted: {} texture(s), {:.1f} MB\n", evictions, bytesEvicted / 1048576.0);
+    for (size_t i = 0; i < categories.size(); ++i) {
+        const Category& category = categories[i];
+        text += std::format("  {:<6} {} texture(s), {:.1f} MB", TextureCategoryName(static_cast<TextureCategory>(i)),
+                            category.textures, category.bytes / 1048576.0);
+        text += category.budget != 0 ? std::format(" / {:.1f} MB budget\n", category.budget / 1048576.0)
+                                     : std::string(" (no budget)\n");
+    }
+    return text;
+}
+
+std::string TextureCache::PathKey(const std::string& path, TextureVariant variant) {
+    // 正規化路徑不含控制字元，以 '\n' 分隔不會與其他路徑混淆
+    std::string key = path;
+    key += '\n';
+    key += static_cast<char>('0' + static_cast<int>(variant));
+    return key;
+}
+
+uint64_t TextureCache::ContentKey(uint64_t contentKey, TextureVariant variant) noexcept {
+    return HashBytes(&contentKey, sizeof(contentKey), static_cast<uint64_t>(variant) + 1);
+}
+
+TextureCache::TexturePtr TextureCache::Find(const std::string& path, TextureVariant variant, TextureCategory category) {
+    const std::string key = PathKey(path, variant);
+    std::scoped_lock lock{ mutex_ };
+    auto it = paths_.find(key);
+    if (it == paths_.end()) {
+        return nullptr;
+    }
+    Resident& resident = residents_.at(it->second);
+    TexturePtr texture = resident.texture;
+    TouchLocked(resident, category);
+    TrimLocked();
+    return texture;
+}
+
+TextureCache::TexturePtr TextureCache::Peek(const std::string& path, TextureVariant variant) const {
+    const std::string key = PathKey(path, variant);
+    std::shared_lock lock{ mutex_ };
+    auto it = paths_.find(key);
+    return it != paths_.end() ? residents_.at(it->second).texture : nullptr;
+}
+
+TextureCache::TexturePtr TextureCache::FindContent(uint64_t contentKey, const std::filesystem::path& source,
+                                                   const std::string& path, TextureVariant variant,
+                                                   TextureCategory category) {
+    if (contentKey == 0) {
+        return nullptr;
+    }
+    const uint64_t variantKey = ContentKey(contentKey, variant);
+    std::filesystem::path residentSource;
+    {
+        std::shared_lock lock{ mutex_ };
+        auto it = contents_.find(variantKey);
+        if (it == contents_.end()) {
+            return nullptr;
+        }
+        residentSource = residents_.at(it->second).contentSource;
+    }
+
+    // 雜湊相同不代表內容相同：大小與位元組都相同才共用
+    const bool same = SameFileContent(residentSource, source);
+
+    std::scoped_lock lock{ mutex_ };
+    if (!same) {
+        counters_.hashCollisions++;
+        return nullptr;
+    }
+    // 比對期間貼圖可能已被移除或換成其他來源
+    auto it = contents_.find(variantKey);
+    if (it == contents_.end() || residents_.at(it->second).contentSource != residentSource) {
+        return nullptr;
+    }
+    Resident& resident = residents_.at(it->second);
+    TexturePtr texture = resident.texture;
+    std::string key = PathKey(path, variant);
+    if (paths_.emplace(key, it->second).second) {
+        resident.paths.push_back(std::move(key));
+        counters_.duplicateLoads++;
+        counters_.bytesSaved += resident.bytes;
+    }
+    TouchLocked(resident, category);
+    TrimLocked();
+    return texture;
+}
+
+TextureCache::TexturePtr TextureCache::Insert(const std::string& path, TextureVariant variant, uint64_t contentKey,
+                                              const std::filesystem::path& source, TexturePtr texture, size_t bytes,
+                                              TextureCategory category) {
+    if (!texture) {
+        return nullptr;
+    }
+    const std::string pathKey = PathKey(path, variant);
+    std::scoped_lock lock{ mutex_ };
+    auto existing = paths_.find(pathKey);
+    if (existing != paths_.end()) {
+        // 其他執行緒先放入：使用既有的貼圖
+        Resident& resident = residents_.at(existing->second);
+        TexturePtr shared = resident.texture;
+        TouchLocked(resident, category);
+        TrimLocked();
+        return shared;
+    }
+
+    const IDirect3DBaseTexture9* key = texture.get();
+    auto [it, inserted] = residents_.try_emplace(key);
+    Resident& resident = it->second;
+    if (inserted) {
+        resident.texture = texture;
+        resident.bytes = bytes;
+        const uint64_t variantKey = ContentKey(contentKey, variant);
+        if (contentKey != 0 && !source.empty() && contents_.emplace(variantKey, key).second) {
+            resident.contentKey = variantKey;
+            resident.contentSource = source;
+        }
+    }
+    resident.paths.push_back(pathKey);
+    paths_.emplace(pathKey, key);
+    TouchLocked(resident, category);
+    TrimLocked();
+    return texture;
+}
+
+bool TextureCache::Erase(const std::string& path) {
+    std::scoped_lock lock{ mutex_ };
+    bool erased = false;
+    for (size_t variant = 0; variant < static_cast<size_t>(TextureVariant::Count); ++variant) {
+        erased |= EraseLocked(PathKey(path, static_cast<TextureVariant>(variant)));
+    }
+    return erased;
+}
+
+bool TextureCache::EraseLocked(const std::string& pathKey) {
+    auto it = paths_.find(pathKey);
+    if (it == paths_.end()) {
+        return false;
+    }
+    const IDirect3DBaseTexture9* key = it->second;
+    paths_.erase(it);
+    Resident& resident = residents_.at(key);
+    std::erase(resident.paths, pathKey);
+    if (resident.paths.empty()) {
+        RemoveLocked(key);
+    }
+    return true;
+}
+
+void TextureCache::Release(TextureCategory category) {
+    std::scoped_lock lock{ mutex_ };
+    std::vector<const IDirect3DBaseTexture9*> orphans;
+    for (auto& [key, resident] : residents_) {
+        if (resident.categories & Bit(category)) {
+            resident.categories &= ~Bit(category);
+            categoryBytes_[static_cast<size_t>(category)] -= resident.bytes;
+            if (resident.categories == 0) {
+                orphans.push_back(key);
+            }
+        }
+    }
+    for (const IDirect3DBaseTexture9* key : orphans) {
+        RemoveLocked(key);
+    }
+}
+
+void TextureCache::Clear() {
+    std::scoped_lock lock{ mutex_ };
+    residents_.clear();
+    paths_.clear();
+    contents_.clear();
+    categoryBytes_ = {};
+}
+
+bool TextureCache::IsContentShared(const IDirect3DBaseTexture9* texture) const {
+    std::shared_lock lock{ mutex_ };
+    auto it = residents_.find(texture);
+    return it != residents_.end() && it->second.paths.size() > 1;
+}
+
+bool TextureCache::IsResident(const IDirect3DBaseTexture9* texture) const {
+    std::shared_lock lock{ mutex_ };
+    return residents_.find(texture) != residents_.end();
+}
+
+void TextureCache::SetBudget(TextureCategory category, size_t bytes) {
+    std::scoped_lock lock{ mutex_ };
+    budgets_[static_cast<size_t>(category)] = bytes;
+    TrimLocked();
+}
+
+size_t TextureCache::Trim() {
+    std::scoped_lock lock{ mutex_ };
+    return TrimLocked();
+}
+
+TextureCacheStats TextureCache::GetStats() const {
+    std::shared_lock lock{ mutex_ };
+    TextureCacheStats stats = counters_;
+    stats.textures = residents_.size();
+    stats.paths = paths_.size();
+    for (const auto& [key, resident] : residents_) {
+        stats.residentBytes += resident.bytes;
+        for (size_t i = 0; i < stats.categories.size(); ++i) {
+            if (resident.categories & Bit(static_cast<TextureCategory>(i))) {
+                stats.categories[i].textures++;
+            }
+        }
+    }
+    for (size_t i = 0; i < stats.categories.size(); ++i) {
+        stats.categories[i].bytes = categoryBytes_[i];
+        stats.categories[i].budget = budgets_[i];
+    }
+    return stats;
+}
+
+void TextureCache::TouchLocked(Resident& resident, TextureCategory category) {
+    resident.lastUse = ++clock_;
+    if (resident.categories & Bit(category)) {
+        return;
+    }
+    if (resident.categories != 0) {
+        counters_.crossCategoryHits++;
+        counters_.crossCategoryBytesSaved += resident.bytes;
+    }
+    resident.categories |= Bit(category);
+    categoryBytes_[static_cast<size_t>(category)] += resident.bytes;
+}
+
+void TextureCache::RemoveLocked(const IDirect3DBaseTexture9* texture) {
+    auto it = residents_.find(texture);
+    if (it == residents_.end()) {
+        return;
+    }
+    Resident& resident = it->second;
+    for (size_t i = 0; i < categoryBytes_.size(); ++i) {
+        if (resident.categories & Bit(static_cast<TextureCategory>(i))) {
+            categoryBytes_[i] -= resident.bytes;
+        }
+    }
+    for (const std::string& path : resident.paths) {
+        paths_.erase(path);
+    }
+    if (resident.contentKey != 0) {
+        contents_.erase(resident.contentKey);
+    }
+    residents_.erase(it);
+}
+
+size_t TextureCache::TrimLocked() {
+    size_t evicted = 0;
+    for (size_t category = 0; category < budgets_.size(); ++category) {
+        const size_t budget = budgets_[category];
+        if (budget == 0 || categoryBytes_[category] <= budget) {
+            continue;
+        }
+
+        uint8_t overBudget = 0;
+        for (size_t i = 0; i < budgets_.size(); ++i) {
+            if (budgets_[i] != 0 && categoryBytes_[i] > budgets_[i]) {
+                overBudget |= Bit(static_cast<TextureCategory>(i));
+            }
+        }
+
+        // 只有快取持有的貼圖才能釋放；優先挑沒有被預算內分類引用的，再依最久未使用
+        struct Victim {
+            bool sharedWithinBudget;
+            uint64_t lastUse;
+            const IDirect3DBaseTexture9* key;
+        };
+        std::vector<Victim> victims;
+        for (const auto& [key, resident] : residents_) {
+            if ((resident.categories & Bit(static_cast<TextureCategory>(category))) && resident.texture.use_count() == 1) {
+                victims.push_back({ (resident.categories & ~overBudget) != 0, resident.lastUse, key });
+            }
+        }
+        std::sort(victims.begin(), victims.end(), [](const Victim& a, const Victim& b) {
+            return a.sharedWithinBudget != b.sharedWithinBudget ? !a.sharedWithinBudget : a.lastUse < b.lastUse;
+        });
+        for (const Victim& victim : victims) {
+            if (categoryBytes_[category] <= budget) {
+                break;
+            }
+            counters_.evictions++;
+            counters_.bytesEvicted += residents_.at(victim.key).bytes;
+            RemoveLocked(victim.key);
+            ++evicted;
+        }
+    }
+    return evicted;
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct IDirect3DBaseTexture9;
+
+// 使用貼圖的子系統；同一張貼圖可同時屬於多個分類
+enum class TextureCategory : uint8_t {
+    UI,
+    Model,
+    Count
+};
+
+const char* TextureCategoryName(TextureCategory category) noexcept;
+
+// 同一檔案依載入方式得到不同的貼圖：路徑與內容都相同但 variant 不同時不共用
+// （UI 拿到串流貼圖時最上層可能還沒載入，模型拿到 UI 的單層貼圖則沒有 mip）
+enum class TextureVariant : uint8_t {
+    Stretched,     // D3DX 載入：拉伸到 2 的冪、完整 mip 鏈
+    Mipmapped,     // 原尺寸、完整 mip 鏈（非 UI 分類的背景解碼、烘焙 DDS 一次載入）
+    TopLevel,      // 原尺寸、只有最上層（UI 的背景解碼、CreateFromImage、非 2 的冪只能單層的裝置）
+    Streamed,      // LoadStreamed：mip 依使用量以 SetLOD 限制，最上層不一定已載入
+    Count
+};
+
+const char* TextureVariantName(TextureVariant variant) noexcept;
+
+// 分類可以直接使用的 variant，依偏好順序（TextureManager 依序查詢快取）：UI 以原尺寸繪製、不需要 mip，
+// 但不能拿串流貼圖；其他分類需要完整 mip 鏈。D3DX 的同步載入兩邊都產生 Stretched，因此都接受
+std::span<const TextureVariant> AcceptedTextureVariants(TextureCategory category) noexcept;
+
+struct TextureCacheStats {
+    struct Category {
+        size_t textures = 0;
+        size_t bytes = 0;      // 此分類引用的貼圖大小；與其他分類共用的貼圖兩邊都算
+        size_t budget = 0;     // 0 表示不限
+    };
+
+    size_t textures = 0;
+    size_t residentBytes = 0;          // 每張貼圖只算一次
+    size_t paths = 0;                  // 路徑與 variant 的組合數
+    size_t duplicateLoads = 0;         // 不同路徑但內容相同而直接共用的次數
+    size_t hashCollisions = 0;         // 雜湊相同但內容不同而沒有共用的次數
+    size_t bytesSaved = 0;
+    size_t crossCategoryHits = 0;      // 已由其他分類載入而直接共用的次數
+    size_t crossCategoryBytesSaved = 0;
+    size_t evictions = 0;
+    size_t bytesEvicted = 0;
+    std::array<Category, static_cast<size_t>(TextureCategory::Count)> categories;
+
+    std::string ToString() const;
+};
+
+// 所有 TextureManager 共用的常駐貼圖快取：以路徑與內容雜湊查詢，每張貼圖記錄引用它的分類
+// 路徑與內容雜湊都與 TextureVariant 一起作為鍵，只有相同 variant 的載入才共用同一張貼圖
+// 每個分類可設定記憶體預算，超出時依最近使用時間釋放只有快取持有的貼圖
+// （仍有 shared_ptr 或 handle 在外的貼圖不會被釋放）
+// 本身不接觸 Direct3D：貼圖大小由呼叫端提供，可在沒有裝置的環境使用；所有方法皆可從任何執行緒呼叫
+// 內容去重以雜湊查詢，命中後再比對來源檔的大小與位元組，雜湊碰撞不會讓不同的貼圖被共用
+class TextureCache {
+public:
+    using TexturePtr = std::shared_ptr<IDirect3DBaseTexture9>;
+
+    TextureCache() = default;
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    // 以路徑與 variant 查詢；命中時把 category 加入此貼圖的分類並更新使用時間
+    TexturePtr Find(const std::string& path, TextureVariant variant, TextureCategory category);
+
+    // 以路徑與 variant 查詢，不改變分類與使用時間
+    TexturePtr Peek(const std::string& path, TextureVariant variant) const;
+
+    // 以內容與 variant 查詢；source 是算出 contentKey 的檔案，需與既有貼圖的來源檔逐位元組相同才算命中
+    // 命中時 path 成為同一張貼圖的別名，並計入內容去重。比對在鎖外讀檔
+    TexturePtr FindContent(uint64_t contentKey, const std::filesystem::path& source, const std::string& path,
+                           TextureVariant variant, TextureCategory category);
+
+    // 放入快取並套用預算；path 的同一 variant 已存在時保留既有貼圖並回傳它
+    // contentKey 為 0 表示不參與內容去重；source 為算出 contentKey 的檔案，供之後的命中比對
+    TexturePtr Insert(const std::string& path, TextureVariant variant, uint64_t contentKey,
+                      const std::filesystem::path& source, TexturePtr texture, size_t bytes,
+                      TextureCategory category);
+
+    // 移除路徑的所有 variant（熱重載用）；沒有其他路徑引用的貼圖一併移出快取。已取出的 shared_ptr 仍然有效
+    bool Erase(const std::string& path);
+
+    // category 不再使用快取中的貼圖：移除其分類標記，沒有任何分類引用的貼圖移出快取
+    void Release(TextureCategory category);
+
+    void Clear();
+
+    bool IsContentShared(const IDirect3DBaseTexture9* texture) const;
+
+    // 貼圖是否仍常駐在快取中（快取本身持有一份 shared_ptr）
+    bool IsResident(const IDirect3DBaseTexture9* texture) const;
+
+    // bytes 為 0 表示不限；調低時立即套用
+    void SetBudget(TextureCategory category, size_t bytes);
+
+    // 依預算釋放貼圖，回傳釋放的數量
+    size_t Trim();
+
+    TextureCacheStats GetStats() const;
+
+private:
+    struct Resident {
+        TexturePtr texture;
+        size_t bytes = 0;
+        uint64_t contentKey = 0;
+        std::filesystem::path contentSource;
+        uint64_t lastUse = 0;
+        uint8_t categories = 0;              // 以 TextureCategory 為位元的遮罩
+        std::vector<std::string> paths;      // PathKey 組成的鍵
+    };
+
+    // paths_ 與 contents_ 的鍵：原本的鍵加上 variant
+    static std::string PathKey(const std::string& path, TextureVariant variant);
+    static uint64_t ContentKey(uint64_t contentKey, TextureVariant variant) noexcept;
+
+    static uint8_t Bit(TextureCategory category) noexcept { return uint8_t(1u << static_cast<unsigned>(category)); }
+
+    void TouchLocked(Resident& resident, TextureCategory category);
+    bool EraseLocked(const std::string& pathKey);
+    void RemoveLocked(const IDirect3DBaseTexture9* texture);
+    size_t TrimLocked();
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<const IDirect3DBaseTexture9*, Resident> residents_;
+    std::unordered_map<std::string, const IDirect3DBaseTexture9*> paths_;
+    std::unordered_map<uint64_t, const IDirect3DBaseTexture9*> contents_;
+    std::array<size_t, static_cast<size_t>(TextureCategory::Count)> categoryBytes_{};
+    std::array<size_t, static_cast<size_t>(TextureCategory::Count)> budgets_{};
+    uint64_t clock_ = 0;
+    TextureCacheStats counters_;             // 只使用去重與釋放的計數
+};
@@ -0,0 +1,930 @@
+#include "TextureCooker.h"
+#include "ParallelFor.h"
+#include "stb_image.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TEXTURE_COOKER_SSE2 1
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double SecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// 少於這個列數的 mip 層直接在呼叫端執行緒處理，避免為小圖建立執行緒
+constexpr size_t kParallelRows = 64;
+
+const char* FormatName(TextureCookFormat format) {
+    switch (format) {
+    case TextureCookFormat::BC1: return "BC1";
+    case TextureCookFormat::BC3: return "BC3";
+    case TextureCookFormat::BC5: return "BC5";
+    default: return "auto";
+    }
+}
+
+size_t BlockBytes(TextureCookFormat format) {
+    return format == TextureCookFormat::BC1 ? 8 : 16;
+}
+
+// ---- sRGB 轉換 ----
+
+float SrgbToLinear(float c) {
+    return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+struct SrgbTables {
+    float toLinear[256];
+    float roundUp[255];   // 線性值超過 roundUp[i] 時 sRGB 8 bit 值至少為 i + 1（即 sRGB 空間的四捨五入點）
+};
+
+const SrgbTables& Srgb() {
+    static const SrgbTables tables = [] {
+        SrgbTables t = {};
+        for (int i = 0; i < 256; ++i) {
+            t.toLinear[i] = SrgbToLinear(i / 255.0f);
+        }
+        for (int i = 0; i < 255; ++i) {
+            t.roundUp[i] = SrgbToLinear((i + 0.5f) / 255.0f);
+        }
+        return t;
+    }();
+    return tables;
+}
+
+uint8_t LinearToSrgb8(float v) {
+    const float* roundUp = Srgb().roundUp;
+    return static_cast<uint8_t>(std::upper_bound(roundUp, roundUp + 255, v) - roundUp);
+}
+
+uint8_t UnitToByte(float v) {
+    return static_cast<uint8_t>(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+// ---- mip 產生 ----
+
+// mip 過濾時的像素表示（每像素 4 個 float）
+// Srgb/Linear：RGB 以 alpha 預乘，平均時透明像素不會把顏色帶進邊緣；Normal：xyz ∈ [-1, 1]，平均後重新正規化
+enum class FilterSpace { Srgb, Linear, Normal };
+
+std::vector<float> ToFilterSpace(const TextureImage& image, FilterSpace space) {
+    const float* toLinear = Srgb().toLinear;
+    size_t pixels = static_cast<size_t>(image.width) * image.height;
+    std::vector<float> out(pixels * 4);
+    for (size_t i = 0; i < pixels; ++i) {
+        const uint8_t* p = &image.rgba[i * 4];
+        float* q = &out[i * 4];
+        float a = p[3] / 255.0f;
+        if (space == FilterSpace::Normal) {
+            for (int c = 0; c < 3; ++c) {
+                q[c] = p[c] / 127.5f - 1.0f;
+            }
+        } else {
+            for (int c = 0; c < 3; ++c) {
+                q[c] = (space == FilterSpace::Srgb ? toLinear[p[c]] : p[c] / 255.0f) * a;
+            }
+        }
+        q[3] = a;
+    }
+    return out;
+}
+
+// 2×2 盒狀過濾；奇數尺寸時最後一行／列與自己平均
+void Downsample(const std::vector<float>& src, uint32_t srcWidth, uint32_t srcHeight, FilterSpace space,
+                std::vector<float>& dst, uint32_t dstWidth, uint32_t dstHeight, size_t workers) {
+    dst.resize(static_cast<size_t>(dstWidth) * dstHeight * 4);
+    ParallelFor(dstHeight, [&](size_t y) {
+        const float* row0 = &src[static_cast<size_t>((std::min)(2 * static_cast<uint32_t>(y), srcHeight - 1)) * srcWidth * 4];
+        const float* row1 = &src[static_cast<size_t>((std::min)(2 * static_cast<uint32_t>(y) + 1, srcHeight - 1)) * srcWidth * 4];
+        float* out = &dst[y * dstWidth * 4];
+        for (uint32_t x = 0; x < dstWidth; ++x) {
+            size_t x0 = static_cast<size_t>((std::min)(2 * x, srcWidth - 1)) * 4;
+            size_t x1 = static_cast<size_t>((std::min)(2 * x + 1, srcWidth - 1)) * 4;
+#ifdef TEXTURE_COOKER_SSE2
+            __m128 sum = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(row0 + x0), _mm_loadu_ps(row0 + x1)),
+                                    _mm_add_ps(_mm_loadu_ps(row1 + x0), _mm_loadu_ps(row1 + x1)));
+            _mm_storeu_ps(out + x * 4, _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+#else
+            for (int c = 0; c < 4; ++c) {
+                out[x * 4 + c] = (row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c]) * 0.25f;
+            }
+#endif
+            if (space == FilterSpace::Normal) {
+                float* n = out + x * 4;
+                float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                if (length > 1e-6f) {
+                    n[0] /= length;
+                    n[1] /= length;
+                    n[2] /= length;
+                }
+            }
+        }
+    }, dstHeight < kParallelRows ? 1 : workers);
+}
+
+TextureImage FromFilterSpace(const std::vector<float>& level, uint32_t width, uint32_t height, FilterSpace space,
+                             size_t workers) {
+    TextureImage image;
+    image.width = width;
+    image.height = height;
+    image.rgba.resize(static_cast<size_t>(width) * height * 4);
+    ParallelFor(height, [&](size_t y) {
+        for (size_t i = y * width; i < (y + 1) * width; ++i) {
+            const float* p = &level[i * 4];
+            uint8_t* q = &image.rgba[i * 4];
+            if (space == FilterSpace::Normal) {
+                for (int c = 0; c < 3; ++c) {
+                    q[c] = UnitToByte(p[c] * 0.5f + 0.5f);
+                }
+            } else {
+                float inverseAlpha = p[3] > 0.0f ? 1.0f / p[3] : 0.0f;
+                for (int c = 0; c < 3; ++c) {
+                    float v = p[c] * inverseAlpha;
+                    q[c] = space == FilterSpace::Srgb ? LinearToSrgb8(v) : UnitToByte(v);
+                }
+            }
+            q[3] = UnitToByte(p[3]);
+        }
+    }, height < kParallelRows ? 1 : workers);
+    return image;
+}
+
+// ---- 區塊編解碼 ----
+
+using Block = uint8_t[16][4];
+
+uint16_t Pack565(const float rgb[3]) {
+    auto quantize = [](float v, int maxValue) {
+        return static_cast<uint16_t>(std::clamp(static_cast<int>(v * maxValue / 255.0f + 0.5f), 0, maxValue));
+    };
+    return static_cast<uint16_t>((quantize(rgb[0], 31) << 11) | (quantize(rgb[1], 63) << 5) | quantize(rgb[2], 31));
+}
+
+// 565 展開成 8 bit 時複製高位元，與硬體解碼相同
+void Unpack565(uint16_t c, int rgb[3]) {
+    int r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+// fourColor 為 false 時是三色模式：第 3 個索引為透明黑
+void ColorPalette(uint16_t c0, uint16_t c1, bool fourColor, int palette[4][4]) {
+    Unpack565(c0, palette[0]);
+    Unpack565(c1, palette[1]);
+    for (int c = 0; c < 3; ++c) {
+        if (fourColor) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+        } else {
+            palette[2][c] = (palette[0][c] + palette[1][c] + 1) / 2;
+            palette[3][c] = 0;
+        }
+    }
+    palette[0][3] = palette[1][3] = palette[2][3] = 255;
+    palette[3][3] = fourColor ? 255 : 0;
+}
+
+// 為每個像素選最近的調色盤顏色，回傳 RGB 平方誤差總和；透明像素（三色模式）固定用索引 3
+int AssignColorIndices(const Block& block, const bool opaque[16], uint16_t c0, uint16_t c1, bool fourColor,
+                       uint8_t indices[16]) {
+    int palette[4][4];
+    ColorPalette(c0, c1, fourColor, palette);
+    int choices = fourColor ? 4 : 3;
+    int total = 0;
+    for (int i = 0; i < 16; ++i) {
+        if (!opaque[i]) {
+            indices[i] = 3;
+            continue;
+        }
+        int best = std::numeric_limits<int>::max();
+        for (int k = 0; k < choices; ++k) {
+            int dr = block[i][0] - palette[k][0];
+            int dg = block[i][1] - palette[k][1];
+            int db = block[i][2] - palette[k][2];
+            int error = dr * dr + dg * dg + db * db;
+            if (error < best) {
+                best = error;
+                indices[i] = static_cast<uint8_t>(k);
+            }
+        }
+        total += best;
+    }
+    return total;
+}
+
+// 固定索引下以最小平方法求兩個端點
+bool SolveColorEndpoints(const Block& block, const bool opaque[16], const uint8_t indices[16], bool fourColor,
+                         float e0[3], float e1[3]) {
+    static const float kFourWeights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+    static const float kThreeWeights[4] = { 1.0f, 0.0f, 0.5f, 0.0f };
+    const float* weights = fourColor ? kFourWeights : kThreeWeights;
+    float aa = 0, ab = 0, bb = 0, ax[3] = {}, bx[3] = {};
+    for (int i = 0; i < 16; ++i) {
+        if (!opaque[i]) {
+            continue;
+        }
+        float a = weights[indices[i]], b = 1.0f - a;
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        for (int c = 0; c < 3; ++c) {
+            ax[c] += a * block[i][c];
+            bx[c] += b * block[i][c];
+        }
+    }
+    float det = aa * bb - ab * ab;
+    if (std::fabs(det) < 1e-6f) {
+        return false;
+    }
+    for (int c = 0; c < 3; ++c) {
+        e0[c] = std::clamp((bb * ax[c] - ab * bx[c]) / det, 0.0f, 255.0f);
+        e1[c] = std::clamp((aa * bx[c] - ab * ax[c]) / det, 0.0f, 255.0f);
+    }
+    return true;
+}
+
+// 色彩區塊（BC1 或 BC2/BC3 的色彩部分）
+// punchThrough：alpha < 128 的像素以三色模式的透明索引表示（只適用 BC1）；否則一律四色模式
+void EncodeColorBlock(const Block& block, bool punchThrough, uint8_t* out) {
+    bool opaque[16];
+    int opaqueCount = 0;
+    for (int i = 0; i < 16; ++i) {
+        opaque[i] = !punchThrough || block[i][3] >= 128;
+        opaqueCount += opaque[i] ? 1 : 0;
+    }
+    bool fourColor = opaqueCount == 16;
+    uint16_t c0 = 0, c1 = 0;
+    uint8_t indices[16] = {};
+
+    if (opaqueCount == 0) {
+        std::fill(std::begin(indices), std::end(indices), uint8_t(3));
+    } else {
+        // 主成分軸上的最遠兩點作為初始端點
+        float mean[3] = {};
+        for (int i = 0; i < 16; ++i) {
+            if (opaque[i]) {
+                for (int c = 0; c < 3; ++c) {
+                    mean[c] += block[i][c];
+                }
+            }
+        }
+        for (float& m : mean) {
+            m /= opaqueCount;
+        }
+        float cov[6] = {};
+        for (int i = 0; i < 16; ++i) {
+            if (!opaque[i]) {
+                continue;
+            }
+            float d[3] = { block[i][0] - mean[0], block[i][1] - mean[1], block[i][2] - mean[2] };
+            cov[0] += d[0] * d[0]; cov[1] += d[0] * d[1]; cov[2] += d[0] * d[2];
+            cov[3] += d[1] * d[1]; cov[4] += d[1] * d[2]; cov[5] += d[2] * d[2];
+        }
+        float axis[3] = { 1.0f, 1.0f, 1.0f };
+        for (int iteration = 0; iteration < 8; ++iteration) {
+            float next[3] = {
+                cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2],
+                cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2],
+                cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2],
+            };
+            float length = (std::max)({ std::fabs(next[0]), std::fabs(next[1]), std::fabs(next[2]) });
+            if (length < 1e-6f) {
+                break;
+            }
+            for (int c = 0; c < 3; ++c) {
+                axis[c] = next[c] / length;
+            }
+        }
+        float minT = 0.0f, maxT = 0.0f;
+        for (int i = 0; i < 16; ++i) {
+            if (opaque[i]) {
+                float t = (block[i][0] - mean[0]) * axis[0] + (block[i][1] - mean[1]) * axis[1] +
+                          (block[i][2] - mean[2]) * axis[2];
+                minT = (std::min)(minT, t);
+                maxT = (std::max)(maxT, t);
+            }
+        }
+        float e0[3], e1[3];
+        float axisLength2 = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+        for (int c = 0; c < 3; ++c) {
+            e0[c] = std::clamp(mean[c] + maxT * axis[c] / axisLength2, 0.0f, 255.0f);
+            e1[c] = std::clamp(mean[c] + minT * axis[c] / axisLength2, 0.0f, 255.0f);
+        }
+
+        c0 = Pack565(e0);
+        c1 = Pack565(e1);
+        int bestError = AssignColorIndices(block, opaque, c0, c1, fourColor, indices);
+
+        // 最小平方法修正端點，誤差變小才採用
+        for (int iteration = 0; iteration < 2 && bestError > 0; ++iteration) {
+            if (!SolveColorEndpoints(block, opaque, indices, fourColor, e0, e1)) {
+                break;
+            }
+            uint16_t r0 = Pack565(e0), r1 = Pack565(e1);
+            uint8_t refined[16];
+            int error = AssignColorIndices(block, opaque, r0, r1, fourColor, refined);
+            if (error >= bestError) {
+                break;
+            }
+            bestError = error;
+            c0 = r0;
+            c1 = r1;
+            std::copy(std::begin(refined), std::end(refined), std::begin(indices));
+        }
+
+        // 解碼器以 c0 > c1 判斷四色模式，依模式調整端點順序
+        if (fourColor) {
+            if (c0 < c1) {
+                std::swap(c0, c1);
+                for (uint8_t& index : indices) {
+                    index ^= 1;
+                }
+            } else if (c0 == c1) {
+                std::fill(std::begin(indices), std::end(indices), uint8_t(0));
+            }
+        } else if (c0 > c1) {
+            std::swap(c0, c1);
+            for (uint8_t& index : indices) {
+                index = index < 2 ? index ^ 1 : index;
+            }
+        }
+    }
+
+    uint32_t bits = 0;
+    for (int i = 0; i < 16; ++i) {
+        bits |= static_cast<uint32_t>(indices[i]) << (2 * i);
+    }
+    out[0] = static_cast<uint8_t>(c0);
+    out[1] = static_cast<uint8_t>(c0 >> 8);
+    out[2] = static_cast<uint8_t>(c1);
+    out[3] = static_cast<uint8_t>(c1 >> 8);
+    std::memcpy(out + 4, &bits, 4);
+}
+
+void DecodeColorBlock(const uint8_t* in, bool alwaysFourColor, Block& block) {
+    uint16_t c0 = static_cast<uint16_t>(in[0] | (in[1] << 8));
+    uint16_t c1 = static_cast<uint16_t>(in[2] | (in[3] << 8));
+    uint32_t bits;
+    std::memcpy(&bits, in + 4, 4);
+    int palette[4][4];
+    ColorPalette(c0, c1, alwaysFourColor || c0 > c1, palette);
+    for (int i = 0; i < 16; ++i) {
+        const int* color = palette[(bits >> (2 * i)) & 3];
+        for (int c = 0; c < 4; ++c) {
+            block[i][c] = static_cast<uint8_t>(color[c]);
+        }
+    }
+}
+
+// 單通道區塊（BC3 的 alpha、BC4/BC5 的每個通道）
+// e0 > e1：八個值在端點間插值；否則六個插值值加上 0 與 255
+void ScalarPalette(int e0, int e1, int palette[8]) {
+    palette[0] = e0;
+    palette[1] = e1;
+    if (e0 > e1) {
+        for (int i = 1; i < 7; ++i) {
+            palette[i + 1] = ((7 - i) * e0 + i * e1 + 3) / 7;
+        }
+    } else {
+        for (int i = 1; i < 5; ++i) {
+            palette[i + 1] = ((5 - i) * e0 + i * e1 + 2) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+int AssignScalarIndices(const uint8_t values[16], int e0, int e1, uint8_t indices[16]) {
+    int palette[8];
+    ScalarPalette(e0, e1, palette);
+    int total = 0;
+    for (int i = 0; i < 16; ++i) {
+        int best = std::numeric_limits<int>::max();
+        for (int k = 0; k < 8; ++k) {
+            int d = values[i] - palette[k];
+            if (d * d < best) {
+                best = d * d;
+                indices[i] = static_cast<uint8_t>(k);
+            }
+        }
+        total += best;
+    }
+    return total;
+}
+
+void EncodeScalarBlock(const uint8_t values[16], uint8_t* out) {
+    int lo = 255, hi = 0, innerLo = 255, innerHi = 0;
+    bool hasExtremes = false;
+    for (int i = 0; i < 16; ++i) {
+        lo = (std::min)(lo, int(values[i]));
+        hi = (std::max)(hi, int(values[i]));
+        if (values[i] == 0 || values[i] == 255) {
+            hasExtremes = true;
+        } else {
+            innerLo = (std::min)(innerLo, int(values[i]));
+            innerHi = (std::max)(innerHi, int(values[i]));
+        }
+    }
+
+    int e0 = hi, e1 = lo;
+    uint8_t indices[16] = {};
+    int bestError = lo == hi ? 0 : AssignScalarIndices(values, e0, e1, indices);
+
+    // 八值模式：以最小平方法修正端點
+    if (bestError > 0) {
+        float aa = 0, ab = 0, bb = 0, ax = 0, bx = 0;
+        for (int i = 0; i < 16; ++i) {
+            float a = indices[i] == 0 ? 1.0f : indices[i] == 1 ? 0.0f : (8 - indices[i]) / 7.0f;
+            float b = 1.0f - a;
+            aa += a * a;
+            ab += a * b;
+            bb += b * b;
+            ax += a * values[i];
+            bx += b * values[i];
+        }
+        float det = aa * bb - ab * ab;
+        if (std::fabs(det) > 1e-6f) {
+            int r0 = std::clamp(static_cast<int>((bb * ax - ab * bx) / det + 0.5f), 0, 255);
+            int r1 = std::clamp(static_cast<int>((aa * bx - ab * ax) / det + 0.5f), 0, 255);
+            uint8_t refined[16];
+            int error = r0 > r1 ? AssignScalarIndices(values, r0, r1, refined) : bestError;
+            if (error < bestError) {
+                bestError = error;
+                e0 = r0;
+                e1 = r1;
+                std::copy(std::begin(refined), std::end(refined), std::begin(indices));
+            }
+        }
+    }
+
+    // 六值模式：區塊中有 0 或 255（常見於 alpha 邊緣）時，端點只需涵蓋其餘的值
+    if (bestError > 0 && hasExtremes) {
+        int s0 = innerLo <= innerHi ? innerLo : 0;
+        int s1 = innerLo <= innerHi ? innerHi : 0;
+        uint8_t alternative[16];
+        int error = AssignScalarIndices(values, s0, s1, alternative);
+        if (error < bestError) {
+            e0 = s0;
+            e1 = s1;
+            std::copy(std::begin(alternative), std::end(alternative), std::begin(indices));
+        }
+    }
+
+    uint64_t bits = 0;
+    for (int i = 0; i < 16; ++i) {
+        bits |= static_cast<uint64_t>(indices[i]) << (3 * i);
+    }
+    out[0] = static_cast<uint8_t>(e0);
+    out[1] = static_cast<uint8_t>(e1);
+    for (int i = 0; i < 6; ++i) {
+        out[2 + i] = static_cast<uint8_t>(bits >> (8 * i));
+    }
+}
+
+void DecodeScalarBlock(const uint8_t* in, uint8_t values[16]) {
+    int palette[8];
+    ScalarPalette(in[0], in[1], palette);
+    uint64_t bits = 0;
+    for (int i = 0; i < 6; ++i) {
+        bits |= static_cast<uint64_t>(in[2 + i]) << (8 * i);
+    }
+    for (int i = 0; i < 16; ++i) {
+        values[i] = static_cast<uint8_t>(palette[(bits >> (3 * i)) & 7]);
+    }
+}
+
+void EncodeBlock(const Block& block, TextureCookFormat format, uint8_t* out) {
+    uint8_t channel[16];
+    switch (format) {
+    case TextureCookFormat::BC1:
+        EncodeColorBlock(block, true, out);
+        break;
+    case TextureCookFormat::BC3:
+        for (int i = 0; i < 16; ++i) {
+            channel[i] = block[i][3];
+        }
+        EncodeScalarBlock(channel, out);
+        EncodeColorBlock(block, false, out + 8);
+        break;
+    default:
+        for (int c = 0; c < 2; ++c) {
+            for (int i = 0; i < 16; ++i) {
+                channel[i] = block[i][c];
+            }
+            EncodeScalarBlock(channel, out + 8 * c);
+        }
+        break;
+    }
+}
+
+void DecodeBlock(const uint8_t* in, TextureCookFormat format, Block& block) {
+    uint8_t channel[16];
+    switch (format) {
+    case TextureCookFormat::BC1:
+        DecodeColorBlock(in, false, block);
+        break;
+    case TextureCookFormat::BC3:
+        DecodeColorBlock(in + 8, true, block);
+        DecodeScalarBlock(in, channel);
+        for (int i = 0; i < 16; ++i) {
+            block[i][3] = channel[i];
+        }
+        break;
+    default:
+        for (int c = 0; c < 2; ++c) {
+            DecodeScalarBlock(in + 8 * c, channel);
+            for (int i = 0; i < 16; ++i) {
+                block[i][c] = channel[i];
+            }
+        }
+        for (int i = 0; i < 16; ++i) {
+            block[i][2] = 0;
+            block[i][3] = 255;
+        }
+        break;
+    }
+}
+
+// 每個區塊列的誤差平方和，最後依固定順序加總
+struct BlockRowError {
+    double color = 0.0;
+    double alpha = 0.0;
+    uint64_t colorSamples = 0;
+    uint64_t alphaSamples = 0;
+};
+
+double Psnr(double squaredError, uint64_t samples) {
+    if (samples == 0 || squaredError <= 0.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return 10.0 * std::log10(255.0 * 255.0 * samples / squaredError);
+}
+
+TextureCookFormat ChooseFormat(const TextureImage& top) {
+    for (size_t i = 3; i < top.rgba.size(); i += 4) {
+        if (top.rgba[i] != 0 && top.rgba[i] != 255) {
+            return TextureCookFormat::BC3;
+        }
+    }
+    return TextureCookFormat::BC1;
+}
+
+void PutU32(uint8_t*& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        *out++ = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+constexpr uint32_t FourCC(char a, char b, char c, char d) {
+    return uint32_t(uint8_t(a)) | (uint32_t(uint8_t(b)) << 8) | (uint32_t(uint8_t(c)) << 16) |
+           (uint32_t(uint8_t(d)) << 24);
+}
+
+} // namespace
+
+std::string TextureCookStats::ToString() const {
+    uint64_t pixels = uncompressedBytes / 4;
+    double ratio = compressedBytes ? static_cast<double>(uncompressedBytes) / compressedBytes : 0.0;
+    double megapixelsPerSecond = encodeSeconds > 0.0 ? pixels / encodeSeconds / 1e6 : 0.0;
+    std::string text = std::format("{}: {} {}x{}, {} mip(s), {:.1f} KB -> {:.1f} KB ({:.1f}:1), "
+                                   "decode {:.1f} ms, mips {:.1f} ms, encode {:.1f} ms ({:.1f} Mpix/s), PSNR {:.2f} dB",
+                                   source.filename().string(), FormatName(format), width, height, mipLevels,
+                                   uncompressedBytes / 1024.0, compressedBytes / 1024.0, ratio, decodeSeconds * 1e3,
+                                   mipSeconds * 1e3, encodeSeconds * 1e3, megapixelsPerSecond, colorPsnr);
+    if (format != TextureCookFormat::BC5) {
+        text += std::format(", alpha {:.2f} dB", alphaPsnr);
+    }
+    return text;
+}
+
+std::string TextureCookReport::ToString() const {
+    std::string text = pipeline.ToString();
+    uint64_t uncompressed = 0, compressed = 0;
+    double encodeSeconds = 0.0;
+    for (const TextureCookStats& texture : textures) {
+        text += "  " + texture.ToString() + '\n';
+        uncompressed += texture.uncompressedBytes;
+        compressed += texture.compressedBytes;
+        encodeSeconds += texture.encodeSeconds;
+    }
+    text += std::format("cooked {} texture(s): {:.1f} MB -> {:.1f} MB ({:.1f}:1), encode {:.1f} Mpix/s\n",
+                        textures.size(), uncompressed / 1048576.0, compressed / 1048576.0,
+                        compressed ? static_cast<double>(uncompressed) / compressed : 0.0,
+                        encodeSeconds > 0.0 ? uncompressed / 4 / encodeSeconds / 1e6 : 0.0);
+    return text;
+}
+
+std::filesystem::path CookedTexturePath(const std::filesystem::path& source) {
+    std::filesystem::path cooked = source;
+    cooked += ".dds";
+    return cooked;
+}
+
+TextureImage DecodeTexture(const std::filesystem::path& source, std::span<const uint8_t> bytes,
+                           const TextureCookOptions& options) {
+    if (bytes.size() > static_cast<size_t>((std::numeric_limits<int>::max)())) {
+        throw std::runtime_error(std::format("貼圖檔案過大: {}", source.string()));
+    }
+    int width = 0, height = 0, channels = 0;
+    stbi_uc* pixels = stbi_load_from_memory(bytes.data(), static_cast<int>(bytes.size()), &width, &height,
+                                            &channels, 4);
+    if (!pixels) {
+        throw std::runtime_error(std::format("無法解碼貼圖 {}: {}", source.string(), stbi_failure_reason()));
+    }
+    TextureImage image;
+    image.width = static_cast<uint32_t>(width);
+    image.height = static_cast<uint32_t>(height);
+    image.rgba.assign(pixels, pixels + static_cast<size_t>(width) * height * 4);
+    stbi_image_free(pixels);
+
+    std::string ext = source.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (options.colorKeyBmp && ext == ".bmp") {
+        // D3DX 的色彩鍵把符合的像素換成透明黑
+        for (size_t i = 0; i < image.rgba.size(); i += 4) {
+            uint8_t* p = &image.rgba[i];
+            if (p[0] == 0 && p[1] == 255 && p[2] == 0 && p[3] == 255) {
+                p[1] = 0;
+                p[3] = 0;
+            }
+        }
+    }
+    return image;
+}
+
+std::vector<TextureImage> BuildMipChain(TextureImage top, const TextureCookOptions& options) {
+    std::vector<TextureImage> mips;
+    if (!options.generateMips || (top.width <= 1 && top.height <= 1)) {
+        mips.push_back(std::move(top));
+        return mips;
+    }
+
+    FilterSpace space = options.format == TextureCookFormat::BC5 ? FilterSpace::Normal
+                        : options.srgb                           ? FilterSpace::Srgb
+                                                                 : FilterSpace::Linear;
+    // 每一層都從上一層的 float 結果往下過濾，量化只發生在輸出時，誤差不會逐層累積
+    std::vector<float> current = ToFilterSpace(top, space);
+    std::vector<float> next;
+    uint32_t width = top.width, height = top.height;
+    mips.push_back(std::move(top));
+    while (width > 1 || height > 1) {
+        uint32_t nextWidth = (std::max)(1u, width / 2), nextHeight = (std::max)(1u, height / 2);
+        Downsample(current, width, height, space, next, nextWidth, nextHeight, options.workers);
+        mips.push_back(FromFilterSpace(next, nextWidth, nextHeight, space, options.workers));
+        current.swap(next);
+        width = nextWidth;
+        height = nextHeight;
+    }
+    return mips;
+}
+
+CookedTexture EncodeTexture(const std::vector<TextureImage>& mips, const TextureCookOptions& options,
+                            TextureCookStats* stats) {
+    if (mips.empty() || mips[0].width == 0 || mips[0].height == 0) {
+        throw std::invalid_argument("EncodeTexture: 沒有影像資料");
+    }
+    if (mips[0].width % 4 != 0 || mips[0].height % 4 != 0) {
+        throw std::runtime_error(std::format("BC 壓縮需要寬高為 4 的倍數: {}x{}", mips[0].width, mips[0].height));
+    }
+    Clock::time_point start = Clock::now();
+
+    CookedTexture texture;
+    texture.format = options.format == TextureCookFormat::Auto ? ChooseFormat(mips[0]) : options.format;
+    texture.width = mips[0].width;
+    texture.height = mips[0].height;
+    texture.mips.resize(mips.size());
+
+    // 所有層的區塊列攤平成同一個索引空間，小的 mip 層與大的一起分配給 worker
+    const size_t blockBytes = BlockBytes(texture.format);
+    std::vector<size_t> rowStart(mips.size() + 1, 0);
+    for (size_t level = 0; level < mips.size(); ++level) {
+        size_t blocksX = (mips[level].width + 3) / 4, blocksY = (mips[level].height + 3) / 4;
+        texture.mips[level].resize(blocksX * blocksY * blockBytes);
+        rowStart[level + 1] = rowStart[level] + blocksY;
+    }
+    std::vector<BlockRowError> rowErrors(options.measureQuality ? rowStart.back() : 0);
+
+    ParallelFor(rowStart.back(), [&](size_t row) {
+        size_t level = std::upper_bound(rowStart.begin(), rowStart.end(), row) - rowStart.begin() - 1;
+        const TextureImage& image = mips[level];
+        uint32_t by = static_cast<uint32_t>(row - rowStart[level]);
+        size_t blocksX = (image.width + 3) / 4;
+        uint8_t* out = texture.mips[level].data() + by * blocksX * blockBytes;
+        for (size_t bx = 0; bx < blocksX; ++bx, out += blockBytes) {
+            // 小於 4×4 的 mip 層重複邊緣像素補滿區塊
+            Block block;
+            for (uint32_t i = 0; i < 16; ++i) {
+                uint32_t x = (std::min)(static_cast<uint32_t>(bx * 4 + i % 4), image.width - 1);
+                uint32_t y = (std::min)(by * 4 + i / 4, image.height - 1);
+                std::memcpy(block[i], &image.rgba[(static_cast<size_t>(y) * image.width + x) * 4], 4);
+            }
+            EncodeBlock(block, texture.format, out);
+            if (!options.measureQuality) {
+                continue;
+            }
+
+            Block decoded;
+            DecodeBlock(out, texture.format, decoded);
+            BlockRowError& error = rowErrors[row];
+            for (uint32_t i = 0; i < 16; ++i) {
+                if (bx * 4 + i % 4 >= image.width || by * 4 + i / 4 >= image.height) {
+                    continue;
+                }
+                // 完全透明的像素看不到，不計入色彩誤差
+                bool visible = texture.format == TextureCookFormat::BC5 || block[i][3] != 0;
+                int channels = texture.format == TextureCookFormat::BC5 ? 2 : 3;
+                for (int c = 0; c < channels && visible; ++c) {
+                    double d = double(block[i][c]) - decoded[i][c];
+                    error.color += d * d;
+                }
+                error.colorSamples += visible ? channels : 0;
+                if (texture.format != TextureCookFormat::BC5) {
+                    double d = double(block[i][3]) - decoded[i][3];
+                    error.alpha += d * d;
+                    error.alphaSamples++;
+                }
+            }
+        }
+    }, options.workers);
+
+    if (stats) {
+        stats->format = texture.format;
+        stats->width = texture.width;
+        stats->height = texture.height;
+        stats->mipLevels = static_cast<uint32_t>(mips.size());
+        stats->uncompressedBytes = 0;
+        stats->compressedBytes = 0;
+        for (size_t level = 0; level < mips.size(); ++level) {
+            stats->uncompressedBytes += static_cast<uint64_t>(mips[level].width) * mips[level].height * 4;
+            stats->compressedBytes += texture.mips[level].size();
+        }
+        BlockRowError total;
+        for (const BlockRowError& error : rowErrors) {
+            total.color += error.color;
+            total.alpha += error.alpha;
+            total.colorSamples += error.colorSamples;
+            total.alphaSamples += error.alphaSamples;
+        }
+        stats->colorPsnr = Psnr(total.color, total.colorSamples);
+        stats->alphaPsnr = Psnr(total.alpha, total.alphaSamples);
+        stats->encodeSeconds = SecondsSince(start);
+    }
+    return texture;
+}
+
+void WriteDds(const std::filesystem::path& file, const CookedTexture& texture) {
+    constexpr uint32_t kCaps = 0x1, kHeight = 0x2, kWidth = 0x4, kPixelFormat = 0x1000, kMipMapCount = 0x20000,
+                       kLinearSize = 0x80000;
+    constexpr uint32_t kFourCCFlag = 0x4;
+    constexpr uint32_t kComplex = 0x8, kTexture = 0x1000, kMipMap = 0x400000;
+
+    uint32_t fourCC = texture.format == TextureCookFormat::BC1   ? FourCC('D', 'X', 'T', '1')
+                      : texture.format == TextureCookFormat::BC3 ? FourCC('D', 'X', 'T', '5')
+                                                                 : FourCC('A', 'T', 'I', '2');
+    bool hasMips = texture.mips.size() > 1;
+
+    // "DDS " + 124 位元組 DDS_HEADER（含 32 位元組 DDS_PIXELFORMAT）
+    uint8_t header[128] = {};
+    uint8_t* out = header;
+    PutU32(out, FourCC('D', 'D', 'S', ' '));
+    PutU32(out, 124);
+    PutU32(out, kCaps | kHeight | kWidth | kPixelFormat | kLinearSize | (hasMips ? kMipMapCount : 0));
+    PutU32(out, texture.height);
+    PutU32(out, texture.width);
+    PutU32(out, static_cast<uint32_t>(texture.mips.empty() ? 0 : texture.mips[0].size()));
+    PutU32(out, 0);                                          // depth
+    PutU32(out, static_cast<uint32_t>(texture.mips.size()));
+    out += 11 * 4;                                           // reserved
+    PutU32(out, 32);
+    PutU32(out, kFourCCFlag);
+    PutU32(out, fourCC);
+    out += 5 * 4;                                            // RGB 位元數與遮罩，FourCC 格式不使用
+    PutU32(out, kTexture | (hasMips ? kComplex | kMipMap : 0));
+
+    std::filesystem::path temp = file;
+    temp += ".tmp";
+    {
+        std::ofstream stream(temp, std::ios::binary | std::ios::trunc);
+        if (!stream) {
+            throw std::runtime_error(std::format("無法建立檔案: {}", temp.string()));
+        }
+        stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+        for (const std::vector<uint8_t>& level : texture.mips) {
+            stream.write(reinterpret_cast<const char*>(level.data()), static_cast<std::streamsize>(level.size()));
+        }
+        if (!stream.flush()) {
+            throw std::runtime_error(std::format("寫入檔案失敗: {}", temp.string()));
+        }
+    }
+    std::filesystem::rename(temp, file);
+}
+
+DdsLayout ParseDds(std::span<const uint8_t> bytes) {
+    auto readU32 = [&](size_t offset) {
+        return uint32_t(bytes[offset]) | (uint32_t(bytes[offset + 1]) << 8) | (uint32_t(bytes[offset + 2]) << 16) |
+               (uint32_t(bytes[offset + 3]) << 24);
+    };
+    if (bytes.size() < 128 || readU32(0) != FourCC('D', 'D', 'S', ' ') || readU32(4) != 124) {
+        throw std::runtime_error("ParseDds: 不是 DDS 檔案");
+    }
+
+    DdsLayout layout;
+    layout.height = readU32(12);
+    layout.width = readU32(16);
+    uint32_t mipCount = (std::max)(readU32(28), 1u);
+    uint32_t fourCC = readU32(84);
+    if (fourCC == FourCC('D', 'X', 'T', '1')) {
+        layout.format = TextureCookFormat::BC1;
+    } else if (fourCC == FourCC('D', 'X', 'T', '5')) {
+        layout.format = TextureCookFormat::BC3;
+    } else if (fourCC == FourCC('A', 'T', 'I', '2')) {
+        layout.format = TextureCookFormat::BC5;
+    } else {
+        throw std::runtime_error("ParseDds: 不支援的像素格式");
+    }
+
+    size_t offset = 128;
+    for (uint32_t level = 0; level < mipCount; ++level) {
+        size_t blocksX = ((std::max)(layout.width >> level, 1u) + 3) / 4;
+        size_t blocksY = ((std::max)(layout.height >> level, 1u) + 3) / 4;
+        size_t size = blocksX * blocksY * BlockBytes(layout.format);
+        if (offset + size > bytes.size()) {
+            throw std::runtime_error(std::format("ParseDds: 第 {} 層資料不完整", level));
+        }
+        layout.levels.push_back(bytes.subspan(offset, size));
+        offset += size;
+    }
+    return layout;
+}
+
+TextureCookStats CookTexture(const std::filesystem::path& source, const std::filesystem::path& output,
+                             const TextureCookOptions& options) {
+    TextureCookStats stats;
+    stats.source = source;
+    Clock::time_point start = Clock::now();
+    TextureImage image = DecodeTexture(source, ReadFileBytes(source), options);
+    stats.decodeSeconds = SecondsSince(start);
+
+    start = Clock::now();
+    std::vector<TextureImage> mips = BuildMipChain(std::move(image), options);
+    stats.mipSeconds = SecondsSince(start);
+
+    WriteDds(output, EncodeTexture(mips, options, &stats));
+    return stats;
+}
+
+TextureCookReport CookTextureFiles(const std::vector<std::filesystem::path>& sources,
+                                   const TextureCookOptions& options, ImportPipelineOptions pipelineOptions) {
+    struct Decoded {
+        TextureImage image;
+        double seconds = 0.0;
+    };
+    struct Encoded {
+        CookedTexture texture;
+        TextureCookStats stats;
+    };
+
+    if (pipelineOptions.processWorkers == 0) {
+        pipelineOptions.processWorkers = 1;
+    }
+
+    TextureCookReport report;
+    ImportPipeline<Decoded, Encoded> pipeline(
+        [&](const std::filesystem::path& file, std::vector<uint8_t>&& bytes) {
+            Clock::time_point start = Clock::now();
+            Decoded decoded{ DecodeTexture(file, bytes, options) };
+            decoded.seconds = SecondsSince(start);
+            return decoded;
+        },
+        [&](const std::filesystem::path& file, Decoded&& decoded) {
+            Encoded encoded;
+            encoded.stats.source = file;
+            encoded.stats.decodeSeconds = decoded.seconds;
+            Clock::time_point start = Clock::now();
+            std::vector<TextureImage> mips = BuildMipChain(std::move(decoded.image), options);
+            encoded.stats.mipSeconds = SecondsSince(start);
+            encoded.texture = EncodeTexture(mips, options, &encoded.stats);
+            return encoded;
+        },
+        [&](const std::filesystem::path& file, Encoded&& encoded) {
+            WriteDds(CookedTexturePath(file), encoded.texture);
+            report.textures.push_back(std::move(encoded.stats));
+        },
+        pipelineOptions);
+    report.pipeline = pipeline.Run(sources);
+    return report;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "ImportPipeline.h"
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+// 離線貼圖處理：stb_image 解碼 → gamma 正確的 mip 鏈 → BC1/BC3/BC5 區塊壓縮 → DDS
+// 只依賴標準函式庫與 stb_image，可在沒有 Direct3D 的環境（例如 Linux 建置機）執行
+// 執行期由 TextureManager::Load 直接載入 CookedTexturePath 所指的 DDS，不需再解碼或產生 mip
+
+enum class TextureCookFormat {
+    Auto,   // 不透明或只有 0/255 的 alpha 用 BC1（1 bit alpha），其餘用 BC3
+    BC1,    // DXT1：RGB 565 + 1 bit alpha，每像素 4 bit
+    BC3,    // DXT5：BC1 色彩 + 插值 alpha，每像素 8 bit
+    BC5,    // ATI2：兩個獨立的單通道區塊（R、G），用於切線空間法線貼圖，每像素 8 bit
+};
+
+struct TextureCookOptions {
+    TextureCookFormat format = TextureCookFormat::Auto;
+    bool srgb = true;           // 色彩以 sRGB 儲存：轉到線性空間再做 mip 過濾；BC5 一律視為線性資料
+    bool generateMips = true;
+    bool colorKeyBmp = true;    // 與 TextureManager 相同：BMP 的純綠色 (0,255,0) 視為透明
+    bool measureQuality = true; // 解碼壓縮結果計算 PSNR
+    size_t workers = 0;         // 0 表示硬體執行緒數
+};
+
+// 8 bit RGBA 影像（列優先、無列間補齊）
+struct TextureImage {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> rgba;
+};
+
+struct CookedTexture {
+    TextureCookFormat format = TextureCookFormat::BC1;   // 實際採用的格式，不會是 Auto
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<std::vector<uint8_t>> mips;               // 每層的區塊資料，依 mip 層級排列
+};
+
+struct TextureCookStats {
+    std::filesystem::path source;
+    TextureCookFormat format = TextureCookFormat::BC1;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t mipLevels = 0;
+    uint64_t uncompressedBytes = 0;  // 以 A8R8G8B8 載入（含 mip）時的大小
+    uint64_t compressedBytes = 0;    // DDS 中區塊資料的大小
+    double decodeSeconds = 0.0;
+    double mipSeconds = 0.0;
+    double encodeSeconds = 0.0;
+    double colorPsnr = 0.0;          // 所有 mip 層合計；BC5 只計 R、G；完全無誤差時為 +inf
+    double alphaPsnr = 0.0;          // BC1/BC3 才有意義
+
+    // 單行摘要：格式、尺寸、壓縮率、各階段耗時、編碼吞吐量與 PSNR
+    std::string ToString() const;
+};
+
+struct TextureCookReport {
+    ImportPipelineStats pipeline;
+    std::vector<TextureCookStats> textures;   // 只含成功的檔案；失敗的記錄在 pipeline.failures
+
+    std::string ToString() const;
+};
+
+// 執行期找尋烘焙結果的位置：來源路徑後加上 .dds（bg.bmp → bg.bmp.dds），同名不同副檔名的來源不會互相覆蓋
+std::filesystem::path CookedTexturePath(const std::filesystem::path& source);
+
+// 解碼 BMP/PNG/TGA/JPG 等 stb_image 支援的格式；失敗時拋出 std::runtime_error
+TextureImage DecodeTexture(const std::filesystem::path& source, std::span<const uint8_t> bytes,
+                           const TextureCookOptions& options);
+
+// 由最上層往下逐層 2×2 過濾到 1×1；sRGB 色彩先轉到線性空間並以 alpha 加權，避免透明像素的顏色滲入邊緣
+std::vector<TextureImage> BuildMipChain(TextureImage top, const TextureCookOptions& options);
+
+// 依 options.format 壓縮每一層（Auto 時依最上層 alpha 決定）；最上層寬高需為 4 的倍數（Direct3D 9 的限制）
+CookedTexture EncodeTexture(const std::vector<TextureImage>& mips, const TextureCookOptions& options,
+                            TextureCookStats* stats = nullptr);
+
+// 寫出 DDS（DXT1/DXT5/ATI2 FourCC）；先寫入暫存檔再改名，執行期不會讀到寫到一半的檔案
+void WriteDds(const std::filesystem::path& file, const CookedTexture& texture);
+
+// DDS 檔案中各 mip 層的位置；levels 指向傳入的緩衝區
+struct DdsLayout {
+    TextureCookFormat format = TextureCookFormat::BC1;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<std::span<const uint8_t>> levels;
+};
+
+// 解析 WriteDds 產生的 DDS（DXT1/DXT5/ATI2）；其他格式或檔案被截斷時拋出 std::runtime_error
+DdsLayout ParseDds(std::span<const uint8_t> bytes);
+
+// 單一檔案：讀檔、解碼、產生 mip、壓縮並寫到 output
+TextureCookStats CookTexture(const std::filesystem::path& source, const std::filesystem::path& output,
+                             const TextureCookOptions& options = {});
+
+// 多個檔案以 ImportPipeline 分階段處理，各自寫到 CookedTexturePath(source)
+// 壓縮本身已用 ParallelFor 平行化，pipelineOptions.processWorkers 為 0 時只用一個處理 worker 以免執行緒過量
+TextureCookReport CookTextureFiles(const std::vector<std::filesystem::path>& sources,
+                                   const TextureCookOptions& options = {},
+                                   ImportPipelineOptions pipelineOptions = {});
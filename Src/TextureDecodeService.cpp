@@ -0,0 +1,134 @@
+#include "TextureDecodeService.h"
+#include "ContentHash.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <chrono>
+
+TextureDecodeService::TextureDecodeService(size_t workers, const TextureCookOptions& options)
+    : options_(options) {
+    if (workers == 0) {
+        unsigned hardware = std::thread::hardware_concurrency();
+        workers = hardware > 1 ? hardware - 1 : 1;
+    }
+    // 每張圖各自在一個 worker 上完成，不再於圖內平行化
+    options_.workers = 1;
+    workers_.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+        workers_.emplace_back([this] { Run(); });
+    }
+}
+
+TextureDecodeService::~TextureDecodeService() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        queue_.clear();
+    }
+    queued_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+bool TextureDecodeService::Request(const std::filesystem::path& file) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_ || !pending_.insert(file.string()).second) {
+            return false;
+        }
+        queue_.push_back(file);
+    }
+    queued_.notify_one();
+    return true;
+}
+
+bool TextureDecodeService::IsPending(const std::filesystem::path& file) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_.count(file.string()) != 0;
+}
+
+size_t TextureDecodeService::PendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_.size();
+}
+
+std::vector<DecodedTexture> TextureDecodeService::TakeCompleted(size_t maxCount) {
+    std::vector<DecodedTexture> taken;
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (!completed_.empty() && taken.size() < maxCount) {
+        pending_.erase(completed_.front().file.string());
+        taken.push_back(std::move(completed_.front()));
+        completed_.pop_front();
+    }
+    return taken;
+}
+
+std::optional<DecodedTexture> TextureDecodeService::Wait(const std::filesystem::path& file) {
+    const std::string key = file.string();
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (pending_.count(key) == 0) {
+        return std::nullopt;
+    }
+
+    // 尚未開始：從佇列拿出來自己解碼，不必排在其他檔案後面
+    auto queued = std::find_if(queue_.begin(), queue_.end(), [&](const std::filesystem::path& p) { return p.string() == key; });
+    if (queued != queue_.end()) {
+        queue_.erase(queued);
+        lock.unlock();
+        DecodedTexture decoded = Decode(file);
+        lock.lock();
+        pending_.erase(key);
+        return decoded;
+    }
+
+    for (;;) {
+        auto done = std::find_if(completed_.begin(), completed_.end(),
+                                 [&](const DecodedTexture& d) { return d.file.string() == key; });
+        if (done != completed_.end()) {
+            DecodedTexture decoded = std::move(*done);
+            completed_.erase(done);
+            pending_.erase(key);
+            return decoded;
+        }
+        finished_.wait(lock);
+    }
+}
+
+void TextureDecodeService::Run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        queued_.wait(lock, [&] { return stop_ || !queue_.empty(); });
+        if (stop_) {
+            return;
+        }
+        std::filesystem::path file = std::move(queue_.front());
+        queue_.pop_front();
+        lock.unlock();
+        DecodedTexture decoded = Decode(file);
+        lock.lock();
+        completed_.push_back(std::move(decoded));
+        finished_.notify_all();
+    }
+}
+
+DecodedTexture TextureDecodeService::Decode(const std::filesystem::path& file) const {
+    DecodedTexture decoded;
+    decoded.file = file;
+    auto start = std::chrono::steady_clock::now();
+    try {
+        MappedFile mapped(file);
+        decoded.contentHash = HashBytes(mapped.data(), mapped.size());
+        decoded.mips = BuildMipChain(DecodeTexture(file, mapped.bytes(), options_), options_);
+        // stb_image 輸出 R、G、B、A，D3DFMT_A8R8G8B8 在記憶體中是 B、G、R、A
+        for (TextureImage& mip : decoded.mips) {
+            for (size_t i = 0; i < mip.rgba.size(); i += 4) {
+                std::swap(mip.rgba[i], mip.rgba[i + 2]);
+            }
+        }
+    } catch (const std::exception& e) {
+        decoded.mips.clear();
+        decoded.error = e.what();
+    }
+    decoded.decodeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return decoded;
+}
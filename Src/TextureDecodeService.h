@@ -0,0 +1,62 @@
+#pragma once
+
+#include "TextureCooker.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+struct DecodedTexture {
+    std::filesystem::path file;
+    std::vector<TextureImage> mips;   // 像素為 A8R8G8B8 的記憶體順序（B、G、R、A），可直接複製到鎖定的貼圖
+    uint64_t contentHash = 0;         // 檔案內容雜湊，與 HashFile 相同
+    double decodeSeconds = 0.0;
+    std::string error;                // 非空表示讀檔或解碼失敗，mips 為空
+};
+
+// 背景貼圖解碼：worker 執行緒以記憶體對應讀檔、以 stb_image 解碼 PNG/BMP/TGA（BMP 套用與 TextureManager
+// 相同的綠色色彩鍵）並產生 mip，裝置執行緒只需取走結果、鎖定貼圖複製像素
+// 所有方法皆可從任何執行緒呼叫；檔案以 path.string() 識別
+class TextureDecodeService {
+public:
+    // workers 為 0 時使用硬體執行緒數減一（保留給裝置執行緒），至少一個
+    explicit TextureDecodeService(size_t workers = 0, const TextureCookOptions& options = {});
+    ~TextureDecodeService();
+
+    TextureDecodeService(const TextureDecodeService&) = delete;
+    TextureDecodeService& operator=(const TextureDecodeService&) = delete;
+
+    // 排入解碼；已在排隊、解碼中或已完成但尚未取走時不重複排入，回傳 false
+    bool Request(const std::filesystem::path& file);
+
+    // 已排入且結果尚未被取走
+    bool IsPending(const std::filesystem::path& file) const;
+    size_t PendingCount() const;
+
+    // 依完成順序取走最多 maxCount 個結果，不等待
+    std::vector<DecodedTexture> TakeCompleted(size_t maxCount = (std::numeric_limits<size_t>::max)());
+
+    // 取走指定檔案的結果：還在排隊時直接在呼叫端執行緒解碼，解碼中則等待完成；沒有排入時回傳 nullopt
+    std::optional<DecodedTexture> Wait(const std::filesystem::path& file);
+
+private:
+    void Run();
+    DecodedTexture Decode(const std::filesystem::path& file) const;
+
+    TextureCookOptions options_;
+    mutable std::mutex mutex_;
+    std::condition_variable queued_;
+    std::condition_variable finished_;
+    std::deque<std::filesystem::path> queue_;
+    std::deque<DecodedTexture> completed_;
+    std::unordered_set<std::string> pending_;   // 排隊中、解碼中與尚未取走的檔案
+    std::vector<std::thread> workers_;
+    bool stop_ = false;
+};
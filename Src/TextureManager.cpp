@@ -1,4 +1,68 @@
 ﻿#include "TextureManager.h"
+#include "ContentHash.h"
+#include "TextureCooker.h"
+#include "MappedFile.h"
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+// 有不比來源舊的烘焙結果（TextureCooker 輸出的 DDS）
+bool HasFreshCookedTexture(const std::filesystem::path& source, const std::filesystem::path& cooked) {
+  std::error_code ec;
+  const auto cookedTime = std::filesystem::last_write_time(cooked, ec);
+  return !ec && cookedTime >= std::filesystem::last_write_time(source, ec) && !ec;
+}
+
+// 內容定址：相同內容且相同載入方式（PNG/BMP 色彩鍵/其他/烘焙後的 DDS）的檔案共用同一份貼圖
+uint64_t ContentKey(uint64_t fileHash, const std::string& ext, bool cooked) {
+  const uint64_t loadMode = cooked ? 3 : (ext == ".png" || ext == ".PNG") ? 1 : (ext == ".bmp" || ext == ".BMP") ? 2 : 0;
+  return HashBytes(&fileHash, sizeof(fileHash), loadMode);
+}
+
+// 快取、解碼失敗與串流紀錄的鍵：與 AssetPathInterner（Acquire 的 AssetId）相同的正規化路徑
+std::string TextureKey(const std::filesystem::path& path) {
+  return AssetPathInterner::Normalize(path);
+}
+
+// 背景解碼支援的格式；其餘交給 D3DX 同步載入
+bool IsBackgroundDecodable(const std::string& ext) {
+  return ext == ".png" || ext == ".PNG" || ext == ".bmp" || ext == ".BMP" || ext == ".tga" || ext == ".TGA";
+}
+
+// 烘焙格式對應的 D3D 格式；ATI2 以 FourCC 表示，需要裝置支援
+D3DFORMAT CookedD3DFormat(TextureCookFormat format) {
+  switch (format) {
+  case TextureCookFormat::BC3:
+    return D3DFMT_DXT5;
+  case TextureCookFormat::BC5:
+    return static_cast<D3DFORMAT>(MAKEFOURCC('A', 'T', 'I', '2'));
+  default:
+    return D3DFMT_DXT1;
+  }
+}
+
+constexpr bool IsPowerOfTwo(uint32_t value) {
+  return value != 0 && (value & (value - 1)) == 0;
+}
+
+// 把 DDS 的第 level 層複製進貼圖；區塊壓縮格式一列是四行像素
+bool CopyDdsLevel(IDirect3DTexture9* texture, const DdsLayout& layout, uint32_t level) {
+  const std::span<const uint8_t> bytes = layout.levels[level];
+  const size_t blockRows = ((std::max)(layout.height >> level, 1u) + 3) / 4;
+  const size_t rowBytes = bytes.size() / blockRows;
+  D3DLOCKED_RECT locked;
+  if (FAILED(texture->LockRect(level, &locked, nullptr, 0))) {
+    return false;
+  }
+  for (size_t row = 0; row < blockRows; ++row) {
+    memcpy(static_cast<uint8_t*>(locked.pBits) + row * locked.Pitch, bytes.data() + row * rowBytes, rowBytes);
+  }
+  texture->UnlockRect(level);
+  return true;
+}
+
+} // namespace
 
 // Factory
 std::unique_ptr<ITextureManager> CreateTextureManager(
@@ -12,8 +76,50 @@ std::unique_ptr<ITextureManager> CreateTextureManager(
   return mgr;
 }
 
+std::unique_ptr<ITextureManager> CreateTextureManager(
+  ComPtr<IDirect3DDevice9> device,
+  std::shared_ptr<TextureCache> cache,
+  TextureCategory category
+) {
+  if (!device.Get()) {
+    throw std::invalid_argument("CreateTextureManager: device 為 nullptr");
+  }
+  if (!cache) {
+    throw std::invalid_argument("CreateTextureManager: cache 為 nullptr");
+  }
+  auto mgr = std::make_unique<TextureManager>(device, std::move(cache), category);
+  mgr->Initialize(device);
+  return mgr;
+}
+
 TextureManager::TextureManager(ComPtr<IDirect3DDevice9> device) noexcept
-  : device_(device) {
+  : device_(device), cache_(std::make_shared<TextureCache>()) {
+}
+
+TextureManager::TextureManager(
+  ComPtr<IDirect3DDevice9> device,
+  std::shared_ptr<TextureCache> cache,
+  TextureCategory category
+) noexcept
+  : device_(device), cache_(std::move(cache)), category_(category) {
+}
+
+TextureManager::~TextureManager() {
+  std::scoped_lock lock{ mutex_ };
+  ReleaseHandlesLocked();
+}
+
+HandlePool<IDirect3DBaseTexture9>& TextureManager::Handles() noexcept {
+  // 所有 manager 共用同一個池，Resolve 不需要知道 handle 來自哪個 manager
+  static HandlePool<IDirect3DBaseTexture9> pool;
+  return pool;
+}
+
+void TextureManager::ReleaseHandlesLocked() noexcept {
+  for (const auto& [id, handle] : handles_) {
+    Handles().Remove(handle);
+  }
+  handles_.clear();
 }
 
 void TextureManager::Initialize(ComPtr<IDirect3DDevice9> device) {
@@ -21,9 +127,15 @@ void TextureManager::Initialize(ComPtr<IDirect3DDevice9> device) {
     throw std::invalid_argument("TextureManager::Initialize: device 為 nullptr");
   }
 
+  {
+    std::scoped_lock streamLock{ streamMutex_ };
+    UnregisterStreamedLocked({});
+  }
   std::scoped_lock lock{ mutex_ };
   device_ = device;
-  cache_.clear();
+  ReleaseHandlesLocked();
+  cache_->Release(category_);
+  decodeFailures_.clear();
 }
 
 std::shared_ptr<IDirect3DBaseTexture9> TextureManager::Load(
@@ -39,14 +151,10 @@ std::shared_ptr<IDirect3DBaseTexture9> TextureManager::Load(
     throw std::runtime_error(std::format("TextureManager::Load: 檔案不存在 {}", filepath.string()));
   }
 
-  const std::string key = filepath.string();
+  const std::string key = TextureKey(filepath);
 
-  {
-    std::shared_lock lock{ mutex_ };
-    auto it = cache_.find(key);
-    if (it != cache_.end()) {
-      return it->second;
-    }
+  if (auto cached = FindCached(key)) {
+    return cached;
   }
 
   //  從檔案載入貼圖 (Managed Pool) - 對bg.bmp使用綠色色彩鍵
@@ -56,41 +164,99 @@ std::shared_ptr<IDirect3DBaseTexture9> TextureManager::Load(
   // 檢查檔案類型
   std::string filename = filepath.filename().string();
   std::string ext = filepath.extension().string();
+
+  // 已排入背景解碼：取走結果直接上傳（尚未開始時改在這裡解碼），不重複解碼
+  if (auto* decoder = Decoder()) {
+    if (auto decoded = decoder->Wait(filepath)) {
+      if (auto texture = Upload(std::move(*decoded))) {
+        return texture;
+      }
+    }
+  }
+
+  // 有烘焙結果時優先載入：已是區塊壓縮並含 mip，不需解碼
+  const std::filesystem::path cookedPath = CookedTexturePath(filepath);
+  const bool useCooked = HasFreshCookedTexture(filepath, cookedPath);
+
+  // 檔案只讀一次：雜湊與 D3DX 解碼使用同一份對應的內容
+  const std::filesystem::path& sourcePath = useCooked ? cookedPath : filepath;
+  MappedFile source;
+  try {
+    source = MappedFile(sourcePath);
+  } catch (const std::exception& e) {
+    throw std::runtime_error(std::format("TextureManager::Load: 無法讀取 {} ({})", sourcePath.string(), e.what()));
+  }
+  const uint64_t fileHash = source.data() ? HashBytes(source.data(), source.size()) : 0;
+  const uint64_t contentKey = ContentKey(fileHash, ext, useCooked);
+  if (fileHash != 0) {
+    const TextureVariant expected = useCooked ? TextureVariant::Mipmapped : TextureVariant::Stretched;
+    if (auto shared = cache_->FindContent(contentKey, sourcePath, key, expected, category_)) {
+      return shared;
+    }
+  }
   
   // 對 BMP 檔案使用綠色色彩鍵
   if (ext == ".bmp" || ext == ".BMP") {
     colorKey = D3DCOLOR_XRGB(0, 255, 0); // 純綠色作為透明色
   }
   
-  // PNG 需要特殊處理以避免黑邊
-  HRESULT hr;
-  if (ext == ".png" || ext == ".PNG") {
-    // 載入 PNG 時使用 A8R8G8B8 格式確保 alpha 通道正確
-    hr = D3DXCreateTextureFromFileExW(
+  HRESULT hr = E_FAIL;
+  if (useCooked) {
+    // 尺寸與 mip 數照檔案內容，不縮放、不過濾，資料直接複製到貼圖
+    hr = D3DXCreateTextureFromFileInMemoryEx(
       device_.Get(),
-      filepath.wstring().c_str(),
-      D3DX_DEFAULT, D3DX_DEFAULT,
-      D3DX_DEFAULT, 0,
-      D3DFMT_A8R8G8B8,  // 強制使用含 alpha 的格式
+      source.data(), static_cast<UINT>(source.size()),
+      D3DX_DEFAULT_NONPOW2, D3DX_DEFAULT_NONPOW2,
+      D3DX_FROM_FILE, 0,
+      D3DFMT_FROM_FILE,
       D3DPOOL_MANAGED,
-      D3DX_FILTER_NONE, D3DX_FILTER_NONE,  // 避免過濾造成的邊緣問題
-      0, nullptr, nullptr,  // PNG 不使用色彩鍵
-      reinterpret_cast<IDirect3DTexture9**>(&rawTex)
-    );
-  } else {
-    // 其他格式的標準載入
-    hr = D3DXCreateTextureFromFileExW(
-      device_.Get(),
-      filepath.wstring().c_str(),
-      D3DX_DEFAULT, D3DX_DEFAULT,
-      D3DX_DEFAULT, 0,
-      D3DFMT_UNKNOWN,
-      D3DPOOL_MANAGED,
-      D3DX_DEFAULT, D3DX_DEFAULT,
-      colorKey, nullptr, nullptr,
+      D3DX_FILTER_NONE, D3DX_FILTER_NONE,
+      0, nullptr, nullptr,
       reinterpret_cast<IDirect3DTexture9**>(&rawTex)
     );
   }
+  // 沒有烘焙結果，或裝置不支援其格式／尺寸時，從來源檔載入
+  // 此時 contentKey 是烘焙檔的雜湊，與載入的內容不符，不參與內容去重
+  bool contentMatches = fileHash != 0;
+  const bool loadedCooked = useCooked && SUCCEEDED(hr) && rawTex != nullptr;
+  if (useCooked && !loadedCooked) {
+    contentMatches = false;
+    try {
+      source = MappedFile(filepath);
+    } catch (const std::exception& e) {
+      throw std::runtime_error(std::format("TextureManager::Load: 無法讀取 {} ({})", filepath.string(), e.what()));
+    }
+  }
+  if (FAILED(hr) || rawTex == nullptr) {
+    // PNG 需要特殊處理以避免黑邊
+    if (ext == ".png" || ext == ".PNG") {
+      // 載入 PNG 時使用 A8R8G8B8 格式確保 alpha 通道正確
+      hr = D3DXCreateTextureFromFileInMemoryEx(
+        device_.Get(),
+        source.data(), static_cast<UINT>(source.size()),
+        D3DX_DEFAULT, D3DX_DEFAULT,
+        D3DX_DEFAULT, 0,
+        D3DFMT_A8R8G8B8,  // 強制使用含 alpha 的格式
+        D3DPOOL_MANAGED,
+        D3DX_FILTER_NONE, D3DX_FILTER_NONE,  // 避免過濾造成的邊緣問題
+        0, nullptr, nullptr,  // PNG 不使用色彩鍵
+        reinterpret_cast<IDirect3DTexture9**>(&rawTex)
+      );
+    } else {
+      // 其他格式的標準載入
+      hr = D3DXCreateTextureFromFileInMemoryEx(
+        device_.Get(),
+        source.data(), static_cast<UINT>(source.size()),
+        D3DX_DEFAULT, D3DX_DEFAULT,
+        D3DX_DEFAULT, 0,
+        D3DFMT_UNKNOWN,
+        D3DPOOL_MANAGED,
+        D3DX_DEFAULT, D3DX_DEFAULT,
+        colorKey, nullptr, nullptr,
+        reinterpret_cast<IDirect3DTexture9**>(&rawTex)
+      );
+    }
+  }
   if (FAILED(hr) || rawTex == nullptr) {
     throw std::runtime_error(std::format("TextureManager::Load: 載入貼圖失敗 {} (HRESULT=0x{:08X})", key, static_cast<UINT>(hr)));
   }
@@ -101,15 +267,366 @@ std::shared_ptr<IDirect3DBaseTexture9> TextureManager::Load(
     };
   std::shared_ptr<IDirect3DBaseTexture9> texPtr{ rawTex, deleter };
 
-  // 寫鎖寫入快取
+  // 烘焙檔的 mip 數照檔案內容；從來源檔載入時 D3DX 拉伸到 2 的冪並產生完整 mip
+  TextureVariant variant = TextureVariant::Stretched;
+  if (loadedCooked) {
+    variant = rawTex->GetLevelCount() > 1 ? TextureVariant::Mipmapped : TextureVariant::TopLevel;
+  }
+
+  // 其他執行緒先放入同一路徑時改用既有的貼圖
+  return cache_->Insert(key, variant, contentMatches ? contentKey : 0, sourcePath, texPtr,
+                        EstimateTextureBytes(texPtr.get()), category_);
+}
+
+bool TextureManager::Prefetch(const std::filesystem::path& filepath) {
+  if (filepath.empty()) {
+    return false;
+  }
+  if (auto* decoder = Decoder(); decoder && decoder->IsPending(filepath)) {
+    return true;
+  }
+  if (PeekCached(TextureKey(filepath))) {
+    return false;
+  }
+  {
+    std::shared_lock lock{ mutex_ };
+    if (decodeFailures_.count(TextureKey(filepath)) != 0) {
+      return false;
+    }
+  }
+  if (!IsBackgroundDecodable(filepath.extension().string()) ||
+      HasFreshCookedTexture(filepath, CookedTexturePath(filepath))) {
+    return false;
+  }
+
+  TextureDecodeService* decoder = nullptr;
   {
     std::scoped_lock lock{ mutex_ };
-    cache_.emplace(key, texPtr);
+    if (!decoder_) {
+      // UI 圖片以原尺寸繪製，只解碼最上層；其他分類產生完整 mip 鏈
+      TextureCookOptions options;
+      options.generateMips = category_ != TextureCategory::UI;
+      decoder_ = std::make_unique<TextureDecodeService>(0, options);
+    }
+    decoder = decoder_.get();
+  }
+  decoder->Request(filepath);
+  return true;
+}
+
+bool TextureManager::IsDecoding(const std::filesystem::path& filepath) const {
+  auto* decoder = Decoder();
+  return decoder && decoder->IsPending(filepath);
+}
+
+size_t TextureManager::PumpUploads(double budgetMs) {
+  auto* decoder = Decoder();
+  if (!decoder || !device_.Get()) {
+    return 0;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  size_t uploaded = 0;
+  for (;;) {
+    auto completed = decoder->TakeCompleted(1);
+    if (completed.empty()) {
+      break;
+    }
+    // 失敗的檔案記下來不再排入背景解碼，之後的 Load 會以同步路徑重試並回報錯誤
+    std::string key = TextureKey(completed.front().file);
+    if (Upload(std::move(completed.front()))) {
+      ++uploaded;
+    } else {
+      std::scoped_lock lock{ mutex_ };
+      decodeFailures_.insert(std::move(key));
+    }
+    if (std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() >= budgetMs) {
+      break;
+    }
+  }
+  return uploaded;
+}
+
+std::shared_ptr<IDirect3DBaseTexture9> TextureManager::LoadStreamed(const std::filesystem::path& filepath) {
+  if (!device_.Get()) {
+    throw std::logic_error("TextureManager::LoadStreamed: Device 未初始化");
+  }
+  if (filepath.empty()) {
+    throw std::invalid_argument("TextureManager::LoadStreamed: filepath 不能為空");
+  }
+
+  const std::string key = TextureKey(filepath);
+  if (auto cached = cache_->Find(key, TextureVariant::Streamed, category_)) {
+    return cached;
+  }
+
+  const std::string ext = filepath.extension().string();
+  const bool isDds = ext == ".dds" || ext == ".DDS";
+  const std::filesystem::path ddsPath = isDds ? filepath : CookedTexturePath(filepath);
+  if (!isDds && !HasFreshCookedTexture(filepath, ddsPath)) {
+    return Load(filepath);
+  }
+
+  StreamedTexture streamed;
+  streamed.key = key;
+  try {
+    streamed.file = MappedFile(ddsPath);
+    streamed.layout = ParseDds(streamed.file.bytes());
+  } catch (const std::exception&) {
+    // 不是烘焙器輸出的 DDS：交給 D3DX 一次載入
+    return Load(filepath);
+  }
+  const DdsLayout& layout = streamed.layout;
+
+  // 全部 mip 都配置在 Managed 貼圖上，但只複製 mip 尾端並以 SetLOD 限制裝置端常駐的層；
+  // 執行期只需複製更精細的層並調整 LOD
+  IDirect3DTexture9* rawTex = nullptr;
+  HRESULT hr = device_->CreateTexture(
+    layout.width, layout.height,
+    static_cast<UINT>(layout.levels.size()), 0,
+    CookedD3DFormat(layout.format), D3DPOOL_MANAGED,
+    &rawTex, nullptr
+  );
+  if (FAILED(hr) || rawTex == nullptr) {
+    return Load(filepath);
+  }
+
+  StreamTextureDesc desc{ layout.width, layout.height, {} };
+  for (const auto& level : layout.levels) {
+    desc.levelBytes.push_back(level.size());
+  }
+
+  std::scoped_lock streamLock{ streamMutex_ };
+  const StreamTextureId id = streamer_.Register(desc);
+  const uint32_t tail = streamer_.ResidentLevel(id);
+  for (uint32_t level = tail; level < layout.levels.size(); ++level) {
+    if (!CopyDdsLevel(rawTex, layout, level)) {
+      streamer_.Unregister(id);
+      rawTex->Release();
+      throw std::runtime_error(std::format("TextureManager::LoadStreamed: 無法鎖定貼圖 {} 第 {} 層", key, level));
+    }
   }
+  rawTex->SetLOD(tail);
+
+  auto deleter = [](IDirect3DBaseTexture9* p) noexcept {
+    if (p) p->Release();
+    };
+  std::shared_ptr<IDirect3DBaseTexture9> texPtr{ rawTex, deleter };
 
+  // 串流紀錄持有貼圖，快取的預算不會釋放它
+  auto cached = cache_->Insert(key, TextureVariant::Streamed, 0, {}, texPtr, EstimateTextureBytes(texPtr.get()),
+                               category_);
+  if (cached != texPtr) {
+    // 其他執行緒先載入完成：使用既有的貼圖
+    streamer_.Unregister(id);
+    return cached;
+  }
+  streamed.texture = texPtr;
+  streamedIds_[rawTex] = id;
+  streamed_.emplace(id, std::move(streamed));
   return texPtr;
 }
 
+void TextureManager::ReportTextureUsage(const IDirect3DBaseTexture9* texture, float screenPixels) {
+  std::scoped_lock lock{ streamMutex_ };
+  auto it = streamedIds_.find(texture);
+  if (it != streamedIds_.end()) {
+    streamer_.ReportUsage(it->second, screenPixels);
+  }
+}
+
+TextureStreamerStats TextureManager::UpdateStreaming() {
+  std::scoped_lock lock{ streamMutex_ };
+  return streamer_.Update();
+}
+
+void TextureManager::SetStreamingBudget(uint64_t bytes) {
+  std::scoped_lock lock{ streamMutex_ };
+  streamer_.SetMemoryBudget(bytes);
+}
+
+bool TextureManager::StreamTarget::StreamIn(StreamTextureId id, uint32_t level) {
+  // 由 UpdateStreaming 呼叫，已持有 streamMutex_
+  auto it = owner_.streamed_.find(id);
+  if (it == owner_.streamed_.end()) {
+    return false;
+  }
+  auto* texture = static_cast<IDirect3DTexture9*>(it->second.texture.get());
+  if (!CopyDdsLevel(texture, it->second.layout, level)) {
+    return false;
+  }
+  texture->SetLOD(level);
+  return true;
+}
+
+void TextureManager::StreamTarget::Evict(StreamTextureId id, uint32_t level) {
+  // Managed 貼圖調高 LOD 後，比 level 精細的層不再佔用顯示記憶體
+  auto it = owner_.streamed_.find(id);
+  if (it != owner_.streamed_.end()) {
+    it->second.texture->SetLOD(level);
+  }
+}
+
+void TextureManager::UnregisterStreamedLocked(const std::string& key) noexcept {
+  for (auto it = streamed_.begin(); it != streamed_.end();) {
+    if (key.empty() || it->second.key == key) {
+      streamer_.Unregister(it->first);
+      streamedIds_.erase(it->second.texture.get());
+      it = streamed_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+std::shared_ptr<IDirect3DBaseTexture9> TextureManager::FindCached(const std::string& key) {
+  for (TextureVariant variant : AcceptedTextureVariants(category_)) {
+    if (auto cached = cache_->Find(key, variant, category_)) {
+      return cached;
+    }
+  }
+  return nullptr;
+}
+
+std::shared_ptr<IDirect3DBaseTexture9> TextureManager::PeekCached(const std::string& key) const {
+  for (TextureVariant variant : AcceptedTextureVariants(category_)) {
+    if (auto cached = cache_->Peek(key, variant)) {
+      return cached;
+    }
+  }
+  return nullptr;
+}
+
+TextureDecodeService* TextureManager::Decoder() const {
+  std::shared_lock lock{ mutex_ };
+  return decoder_.get();
+}
+
+std::shared_ptr<IDirect3DBaseTexture9> TextureManager::Upload(DecodedTexture&& decoded) {
+  if (!decoded.error.empty() || decoded.mips.empty() || !device_.Get()) {
+    return nullptr;
+  }
+
+  const std::string key = TextureKey(decoded.file);
+  const uint64_t contentKey = ContentKey(decoded.contentHash, decoded.file.extension().string(), false);
+  if (auto cached = FindCached(key)) {
+    return cached;
+  }
+
+  // 以圖片原尺寸建立，不像 D3DX_DEFAULT 拉伸到 2 的冪
+  // 非 2 的冪尺寸在只支援 NONPOW2CONDITIONAL 的裝置上不能有 mip，只上傳最上層；
+  // 完全不支援時回傳 nullptr，由 Load 交給 D3DX 拉伸
+  const TextureImage& top = decoded.mips[0];
+  UINT levels = static_cast<UINT>(decoded.mips.size());
+  if (!IsPowerOfTwo(top.width) || !IsPowerOfTwo(top.height)) {
+    D3DCAPS9 caps;
+    if (FAILED(device_->GetDeviceCaps(&caps))) {
+      return nullptr;
+    }
+    if (caps.TextureCaps & D3DPTEXTURECAPS_POW2) {
+      if (!(caps.TextureCaps & D3DPTEXTURECAPS_NONPOW2CONDITIONAL)) {
+        return nullptr;
+      }
+      levels = 1;
+    }
+  }
+  const TextureVariant variant = levels > 1 ? TextureVariant::Mipmapped : TextureVariant::TopLevel;
+  if (decoded.contentHash != 0) {
+    if (auto shared = cache_->FindContent(contentKey, decoded.file, key, variant, category_)) {
+      return shared;
+    }
+  }
+
+  IDirect3DTexture9* rawTex = nullptr;
+  HRESULT hr = device_->CreateTexture(
+    top.width, top.height,
+    levels, 0,
+    D3DFMT_A8R8G8B8, D3DPOOL_MANAGED,
+    &rawTex, nullptr
+  );
+  if (FAILED(hr) || rawTex == nullptr) {
+    return nullptr;
+  }
+  // 像素已是 A8R8G8B8 的記憶體順序，逐列複製即可
+  for (UINT level = 0; level < levels; ++level) {
+    const TextureImage& mip = decoded.mips[level];
+    D3DLOCKED_RECT locked;
+    if (FAILED(rawTex->LockRect(level, &locked, nullptr, 0))) {
+      rawTex->Release();
+      return nullptr;
+    }
+    const size_t rowBytes = static_cast<size_t>(mip.width) * 4;
+    for (UINT y = 0; y < mip.height; ++y) {
+      memcpy(static_cast<uint8_t*>(locked.pBits) + static_cast<size_t>(y) * locked.Pitch,
+             mip.rgba.data() + y * rowBytes, rowBytes);
+    }
+    rawTex->UnlockRect(level);
+  }
+
+  auto deleter = [](IDirect3DBaseTexture9* p) noexcept {
+    if (p) p->Release();
+    };
+  std::shared_ptr<IDirect3DBaseTexture9> texPtr{ rawTex, deleter };
+
+  return cache_->Insert(key, variant, decoded.contentHash != 0 ? contentKey : 0, decoded.file, texPtr,
+                        EstimateTextureBytes(texPtr.get()), category_);
+}
+
+TextureHandle TextureManager::Acquire(const std::filesystem::path& filepath) {
+  const AssetId id = AssetPathInterner::Instance().Intern(filepath);
+  if (id == kInvalidAssetId) {
+    throw std::invalid_argument("TextureManager::Acquire: filepath 不能為空");
+  }
+
+  {
+    std::shared_lock lock{ mutex_ };
+    auto it = handles_.find(id);
+    if (it != handles_.end()) {
+      return it->second;
+    }
+  }
+
+  auto texture = Load(filepath);
+
+  std::scoped_lock lock{ mutex_ };
+  auto [it, inserted] = handles_.try_emplace(id);
+  if (inserted) {
+    it->second = Handles().Insert(std::move(texture));
+  }
+  return it->second;
+}
+
+TextureHandle TextureManager::CreateFromImage(const std::filesystem::path& key, const TextureImage& image) {
+  if (key.empty()) {
+    throw std::invalid_argument("TextureManager::CreateFromImage: key 不能為空");
+  }
+  Evict(key);
+
+  // 與背景解碼相同的上傳路徑：轉成 A8R8G8B8 的記憶體順序後逐列複製
+  DecodedTexture decoded;
+  decoded.file = key;
+  decoded.mips.push_back(image);
+  for (size_t i = 0; i < decoded.mips[0].rgba.size(); i += 4) {
+    std::swap(decoded.mips[0].rgba[i], decoded.mips[0].rgba[i + 2]);
+  }
+  auto texture = Upload(std::move(decoded));
+  if (!texture) {
+    throw std::runtime_error(std::format("TextureManager::CreateFromImage: 建立貼圖失敗 {} ({}x{})",
+      key.string(), image.width, image.height));
+  }
+
+  const AssetId id = AssetPathInterner::Instance().Intern(key);
+  std::scoped_lock lock{ mutex_ };
+  TextureHandle& handle = handles_[id];
+  Handles().Remove(handle);
+  handle = Handles().Insert(std::move(texture));
+  return handle;
+}
+
+IDirect3DBaseTexture9* TextureManager::Resolve(TextureHandle handle) noexcept {
+  return Handles().Resolve(handle);
+}
+
 std::shared_ptr<IDirect3DBaseTexture9> TextureManager::Get(
   std::string_view key
 ) const {
@@ -117,11 +634,75 @@ std::shared_ptr<IDirect3DBaseTexture9> TextureManager::Get(
     return nullptr;
   }
   std::shared_lock lock{ mutex_ };
-  auto it = cache_.find(std::string{ key });
-  return it != cache_.end() ? it->second : nullptr;
+  return PeekCached(TextureKey(key));
 }
 
 void TextureManager::Clear() noexcept {
+  {
+    std::scoped_lock streamLock{ streamMutex_ };
+    UnregisterStreamedLocked({});
+  }
+  std::scoped_lock lock{ mutex_ };
+  ReleaseHandlesLocked();
+  cache_->Release(category_);
+  decodeFailures_.clear();
+}
+
+bool TextureManager::Evict(const std::filesystem::path& filepath) {
+  // 與 Acquire 的 AssetId 及快取鍵使用同一個正規化路徑，任何寫法的同一路徑都能移除
+  const std::string key = TextureKey(filepath);
+  const AssetId id = AssetPathInterner::Instance().Find(filepath);
+  {
+    // 已取出的貼圖停在目前的 LOD，不再串流
+    std::scoped_lock streamLock{ streamMutex_ };
+    UnregisterStreamedLocked(key);
+  }
   std::scoped_lock lock{ mutex_ };
-  cache_.clear();
+  auto handle = handles_.find(id);
+  if (handle != handles_.end()) {
+    Handles().Remove(handle->second);
+    handles_.erase(handle);
+  }
+  decodeFailures_.erase(key);
+  return cache_->Erase(key);
+}
+
+bool TextureManager::IsContentShared(const IDirect3DBaseTexture9* texture) const {
+  return cache_->IsContentShared(texture);
+}
+
+TextureManager::DedupStats TextureManager::GetDedupStats() const {
+  const TextureCacheStats stats = cache_->GetStats();
+  return { stats.duplicateLoads, stats.bytesSaved };
+}
+
+size_t TextureManager::EstimateTextureBytes(IDirect3DBaseTexture9* texture) noexcept {
+  if (!texture || texture->GetType() != D3DRTYPE_TEXTURE) {
+    return 0;
+  }
+
+  auto* tex2d = static_cast<IDirect3DTexture9*>(texture);
+  size_t total = 0;
+  for (DWORD level = 0; level < tex2d->GetLevelCount(); ++level) {
+    D3DSURFACE_DESC desc;
+    if (FAILED(tex2d->GetLevelDesc(level, &desc))) {
+      break;
+    }
+    size_t bitsPerPixel = 32;
+    switch (desc.Format) {
+      case D3DFMT_DXT1: bitsPerPixel = 4; break;
+      case D3DFMT_DXT3:
+      case D3DFMT_DXT5:
+      case static_cast<D3DFORMAT>(MAKEFOURCC('A', 'T', 'I', '2')): bitsPerPixel = 8; break;
+      case D3DFMT_R5G6B5:
+      case D3DFMT_X1R5G5B5:
+      case D3DFMT_A1R5G5B5:
+      case D3DFMT_A4R4G4B4: bitsPerPixel = 16; break;
+      case D3DFMT_L8:
+      case D3DFMT_A8: bitsPerPixel = 8; break;
+      default: break;
+    }
+    total += static_cast<size_t>(desc.Width) * desc.Height * bitsPerPixel / 8;
+  }
+  return total;
 }
@@ -1,20 +1,41 @@
 ﻿#pragma once
 
 #include "ITextureManager.h"
+#include "AssetId.h"
+#include "ResourceHandle.h"
+#include "TextureDecodeService.h"
+#include "TextureStreamer.h"
+#include "TextureCache.h"
+#include "MappedFile.h"
 #include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
 #include <shared_mutex>
+#include <mutex>
 #include <format>
 #include <stdexcept>
 #include <d3dx9tex.h>
 
 using Microsoft::WRL::ComPtr;
 
+using TextureHandle = ResourceHandle<IDirect3DBaseTexture9>;
+
 class TextureManager : public ITextureManager {
 public:
-  // 建構函式，不拋例外
+  // 內容去重統計：不同路徑但內容相同的貼圖只保留一份
+  struct DedupStats {
+    size_t duplicateLoads = 0;   // 直接共用既有貼圖的次數
+    size_t bytesSaved = 0;       // 估計省下的顯示記憶體
+  };
+
+  // 建構函式，不拋例外；使用自己的快取
   explicit TextureManager(ComPtr<IDirect3DDevice9> device) noexcept;
 
-  ~TextureManager() override = default;
+  // 與其他 TextureManager 共用 cache：同一檔案以相同的 TextureVariant 只載入一次，載入的貼圖標記為 category
+  TextureManager(ComPtr<IDirect3DDevice9> device, std::shared_ptr<TextureCache> cache,
+    TextureCategory category) noexcept;
+
+  ~TextureManager() override;
 
   TextureManager(const TextureManager&) = delete;
   TextureManager& operator=(const TextureManager&) = delete;
@@ -29,21 +50,128 @@ public:
     const std::filesystem::path& filepath
   ) override;
 
+  // 載入（或取得已快取的）貼圖並回傳 handle；載入失敗時與 Load 相同拋出例外
+  // 應在建立元件時呼叫一次，每幀改用 Resolve
+  TextureHandle Acquire(const std::filesystem::path& filepath);
+
+  // 以記憶體中的 RGBA 像素建立 Managed 貼圖（單層）並以 key 快取，回傳 handle；用於執行期產生的貼圖
+  // （例如 UI 圖集頁面），key 不必是實際檔案。key 已在快取中時先取代；建立失敗時拋出 std::runtime_error
+  TextureHandle CreateFromImage(const std::filesystem::path& key, const TextureImage& image);
+
+  // 以 handle 取得貼圖：不取鎖、不查檔案系統；handle 已失效時回傳 nullptr
+  static IDirect3DBaseTexture9* Resolve(TextureHandle handle) noexcept;
+
+  // 把尚未快取的 PNG/BMP/TGA 交給背景 worker 解碼，不阻塞呼叫端
+  // 回傳 true 表示貼圖正在背景解碼（這次或先前排入）；已快取、有烘焙 DDS 或格式不支援時回傳 false
+  // 上傳的貼圖維持圖片原尺寸（同步的 D3DX 路徑會拉伸到 2 的冪），GetLevelDesc 的寬高即圖片本身的大小；
+  // UI 分類只有一層，其他分類有完整 mip（裝置只支援 NONPOW2CONDITIONAL 時非 2 的冪的貼圖也只有一層）
+  bool Prefetch(const std::filesystem::path& filepath);
+
+  // Prefetch 排入的貼圖還沒被 PumpUploads 取走；每幀輪詢用，不會重新排入
+  bool IsDecoding(const std::filesystem::path& filepath) const;
+
+  // 在裝置執行緒每幀呼叫：把已解碼的貼圖鎖定複製到 Managed 貼圖並放入快取
+  // 至少處理一張，累計超過 budgetMs 後停止；回傳成功上傳的數量
+  size_t PumpUploads(double budgetMs = 2.0);
+
+  // 以串流方式載入烘焙過的 DDS：只先複製 mip 尾端即可使用，之後依 ReportTextureUsage 的回報在
+  // UpdateStreaming 逐層補上更精細的 mip；沒有新的烘焙結果或裝置不支援其格式時等同 Load
+  // 沒有回報使用量的貼圖停在 mip 尾端
+  std::shared_ptr<IDirect3DBaseTexture9> LoadStreamed(const std::filesystem::path& filepath);
+
+  // 本幀使用 texture 的網格在螢幕上的像素面積（可用 TextureStreamer::EstimateScreenPixels 估計）
+  // 不是 LoadStreamed 載入的貼圖直接忽略
+  void ReportTextureUsage(const IDirect3DBaseTexture9* texture, float screenPixels);
+
+  // 在裝置執行緒每幀呼叫一次：依回報載入或丟棄串流貼圖的 mip
+  TextureStreamerStats UpdateStreaming();
+
+  // 所有串流貼圖常駐 mip 的顯示記憶體上限，超出時先丟遠處貼圖的最精細層
+  void SetStreamingBudget(uint64_t bytes);
+
   // 取得已快取貼圖，若不存在回傳 nullptr
   std::shared_ptr<IDirect3DBaseTexture9> Get(
     std::string_view key
   ) const override;
 
-  // 清除所有快取
+  // 清除此 manager 的快取：共用快取中只移除本分類的標記，其他分類仍在使用的貼圖保留
   void Clear() noexcept override;
 
+  // 從快取移除單一貼圖（熱重載用），所有共用此快取的 manager 都會重新讀檔；已取出的 shared_ptr 仍然有效
+  bool Evict(const std::filesystem::path& filepath);
+
+  // 貼圖是否被多個路徑共用（內容去重的結果）
+  bool IsContentShared(const IDirect3DBaseTexture9* texture) const;
+
+  DedupStats GetDedupStats() const;
+
+  // 快取整體統計（共用快取時包含其他分類）；ToString() 可直接輸出
+  TextureCacheStats GetCacheStats() const { return cache_->GetStats(); }
+
+  TextureCategory Category() const noexcept { return category_; }
+  const std::shared_ptr<TextureCache>& Cache() const noexcept { return cache_; }
+
+  // 估計貼圖所有 mip 層佔用的位元組數
+  static size_t EstimateTextureBytes(IDirect3DBaseTexture9* texture) noexcept;
+
 private:
+  // 釋放此 manager 發出的所有 handle；呼叫端需持有 mutex_
+  void ReleaseHandlesLocked() noexcept;
+
+  static HandlePool<IDirect3DBaseTexture9>& Handles() noexcept;
+
+  // 以背景解碼的結果建立貼圖並放入快取；解碼失敗或裝置拒絕時回傳 nullptr
+  std::shared_ptr<IDirect3DBaseTexture9> Upload(DecodedTexture&& decoded);
+
+  TextureDecodeService* Decoder() const;
+
+  // 以此分類可用的 variant 依序查詢快取（見 TextureVariant）；Find 會把本分類加入貼圖的分類
+  std::shared_ptr<IDirect3DBaseTexture9> FindCached(const std::string& key);
+  std::shared_ptr<IDirect3DBaseTexture9> PeekCached(const std::string& key) const;
+
+  // 串流中的貼圖：DDS 以記憶體對應保留，需要更精細的 mip 時才複製進 Managed 貼圖並調整 LOD
+  struct StreamedTexture {
+    std::string key;
+    std::shared_ptr<IDirect3DBaseTexture9> texture;
+    MappedFile file;
+    DdsLayout layout;
+  };
+
+  class StreamTarget : public ITextureStreamTarget {
+  public:
+    explicit StreamTarget(TextureManager& owner) noexcept : owner_(owner) {}
+    bool StreamIn(StreamTextureId id, uint32_t level) override;
+    void Evict(StreamTextureId id, uint32_t level) override;
+
+  private:
+    TextureManager& owner_;
+  };
+
+  // 取消註冊 key 對應的串流貼圖；key 為空時全部取消。呼叫端需持有 streamMutex_
+  void UnregisterStreamedLocked(const std::string& key) noexcept;
+
   ComPtr<IDirect3DDevice9> device_;
   mutable std::shared_mutex    mutex_;
-  std::unordered_map<std::string,
-    std::shared_ptr<IDirect3DBaseTexture9>> cache_;
+  // 路徑與內容雜湊 -> 貼圖；可能與其他 manager 共用，有自己的鎖
+  std::shared_ptr<TextureCache> cache_;
+  TextureCategory category_ = TextureCategory::Model;
+  std::unordered_map<AssetId, TextureHandle> handles_;
+  // 第一次 Prefetch 時建立，之後不再替換
+  std::unique_ptr<TextureDecodeService> decoder_;
+  // 背景解碼或上傳失敗的路徑，不再排入背景解碼
+  std::unordered_set<std::string> decodeFailures_;
+  // 串流狀態另用一把鎖，UpdateStreaming 複製 mip 時不擋住其他執行緒查快取
+  std::mutex streamMutex_;
+  StreamTarget streamTarget_{ *this };
+  TextureStreamer streamer_{ streamTarget_ };
+  std::unordered_map<StreamTextureId, StreamedTexture> streamed_;
+  std::unordered_map<const IDirect3DBaseTexture9*, StreamTextureId> streamedIds_;
 };
 
 /// <summary>Factory 函式：建立預設實作的 TextureManager。</summary>
 std::unique_ptr<ITextureManager> CreateTextureManager(ComPtr<IDirect3DDevice9> device);
 
+/// <summary>Factory 函式：建立使用共用快取的 TextureManager，載入的貼圖標記為 category。</summary>
+std::unique_ptr<ITextureManager> CreateTextureManager(ComPtr<IDirect3DDevice9> device,
+  std::shared_ptr<TextureCache> cache, TextureCategory category);
+
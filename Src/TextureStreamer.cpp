@@ -0,0 +1,220 @@
+#include "TextureStreamer.h"
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <limits>
+#include <queue>
+
+namespace {
+
+uint64_t BytesFrom(const StreamTextureDesc& desc, uint32_t level) {
+    uint64_t total = 0;
+    for (size_t i = level; i < desc.levelBytes.size(); ++i) {
+        total += desc.levelBytes[i];
+    }
+    return total;
+}
+
+} // namespace
+
+std::string TextureStreamerStats::ToString() const {
+    return std::format("texture streaming: {} texture(s), resident {:.1f} MB / wanted {:.1f} MB, "
+                       "{} pending, +{} level(s) ({:.1f} MB), -{} level(s)",
+                       textures, residentBytes / 1048576.0, wantedBytes / 1048576.0, pendingTextures, levelsStreamed,
+                       bytesStreamed / 1048576.0, levelsEvicted);
+}
+
+TextureStreamer::TextureStreamer(ITextureStreamTarget& target, const TextureStreamerOptions& options)
+    : target_(target), options_(options) {}
+
+uint32_t TextureStreamer::TailLevel(const StreamTextureDesc& desc, uint32_t tailDimension) {
+    uint32_t last = desc.levelBytes.empty() ? 0 : static_cast<uint32_t>(desc.levelBytes.size() - 1);
+    for (uint32_t level = 0; level < last; ++level) {
+        if ((std::max)((std::max)(desc.width >> level, 1u), (std::max)(desc.height >> level, 1u)) <= tailDimension) {
+            return level;
+        }
+    }
+    return last;
+}
+
+StreamTextureId TextureStreamer::Register(const StreamTextureDesc& desc) {
+    if (desc.levelBytes.empty()) {
+        return 0;
+    }
+    StreamTextureId id;
+    if (!freeIds_.empty()) {
+        id = freeIds_.back();
+        freeIds_.pop_back();
+    } else {
+        entries_.emplace_back();
+        id = static_cast<StreamTextureId>(entries_.size());
+    }
+    Entry& entry = entries_[id - 1];
+    entry.desc = desc;
+    entry.tail = TailLevel(desc, options_.tailDimension);
+    entry.resident = entry.tail;
+    entry.wanted = entry.tail;
+    entry.footprint = 0.0f;
+    entry.used = true;
+    residentBytes_ += BytesFrom(desc, entry.resident);
+    return id;
+}
+
+void TextureStreamer::Unregister(StreamTextureId id) {
+    Entry* entry = Find(id);
+    if (!entry) {
+        return;
+    }
+    residentBytes_ -= BytesFrom(entry->desc, entry->resident);
+    *entry = {};
+    freeIds_.push_back(id);
+}
+
+void TextureStreamer::ReportUsage(StreamTextureId id, float screenPixels) {
+    if (Entry* entry = Find(id)) {
+        entry->footprint = (std::max)(entry->footprint, screenPixels);
+    }
+}
+
+uint32_t TextureStreamer::ResidentLevel(StreamTextureId id) const {
+    const Entry* entry = Find(id);
+    return entry ? entry->resident : 0;
+}
+
+uint32_t TextureStreamer::WantedLevel(StreamTextureId id) const {
+    const Entry* entry = Find(id);
+    return entry ? entry->wanted : 0;
+}
+
+float TextureStreamer::EstimateScreenPixels(float radius, float distance, float fovY, float viewportHeight) {
+    if (radius <= 0.0f || viewportHeight <= 0.0f) {
+        return 0.0f;
+    }
+    float projected = radius * viewportHeight / (2.0f * (std::max)(distance, radius) * std::tan(fovY * 0.5f));
+    return 3.14159265f * projected * projected;
+}
+
+TextureStreamer::Entry* TextureStreamer::Find(StreamTextureId id) {
+    return id != 0 && id <= entries_.size() && entries_[id - 1].used ? &entries_[id - 1] : nullptr;
+}
+
+const TextureStreamer::Entry* TextureStreamer::Find(StreamTextureId id) const {
+    return id != 0 && id <= entries_.size() && entries_[id - 1].used ? &entries_[id - 1] : nullptr;
+}
+
+uint32_t TextureStreamer::DesiredLevel(const Entry& entry) const {
+    if (entry.footprint <= 0.0f) {
+        return entry.tail;
+    }
+    // 每個 texel 約對應一個螢幕像素的層：texels(level) = texels(0) / 4^level
+    double texels = static_cast<double>(entry.desc.width) * entry.desc.height;
+    double level = std::floor(0.5 * std::log2(texels / entry.footprint) + options_.lodBias);
+    return static_cast<uint32_t>(std::clamp(level, 0.0, static_cast<double>(entry.tail)));
+}
+
+float TextureStreamer::Importance(const Entry& entry, uint32_t level) {
+    double texels = static_cast<double>((std::max)(entry.desc.width >> level, 1u)) *
+                    (std::max)(entry.desc.height >> level, 1u);
+    return static_cast<float>(entry.footprint / texels);
+}
+
+TextureStreamer::Entry* TextureStreamer::PickVictim(float limit, const Entry* keep) {
+    Entry* victim = nullptr;
+    float lowest = limit;
+    for (Entry& entry : entries_) {
+        if (!entry.used || &entry == keep || entry.resident >= entry.tail) {
+            continue;
+        }
+        float importance = Importance(entry, entry.resident);
+        // 同樣不重要時先丟大的
+        if (importance < lowest || (victim && importance == lowest &&
+                                    entry.desc.levelBytes[entry.resident] > victim->desc.levelBytes[victim->resident])) {
+            lowest = importance;
+            victim = &entry;
+        }
+    }
+    return victim;
+}
+
+void TextureStreamer::EvictOne(Entry& entry, TextureStreamerStats& stats) {
+    residentBytes_ -= entry.desc.levelBytes[entry.resident];
+    entry.resident++;
+    target_.Evict(static_cast<StreamTextureId>(&entry - entries_.data() + 1), entry.resident);
+    stats.levelsEvicted++;
+}
+
+TextureStreamerStats TextureStreamer::Update() {
+    TextureStreamerStats stats;
+
+    struct Candidate {
+        float importance;
+        StreamTextureId id;
+        uint32_t level;
+        bool operator<(const Candidate& other) const { return importance < other.importance; }
+    };
+    std::priority_queue<Candidate> candidates;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        Entry& entry = entries_[i];
+        if (!entry.used) {
+            continue;
+        }
+        entry.wanted = DesiredLevel(entry);
+        if (entry.resident > entry.wanted) {
+            candidates.push({ Importance(entry, entry.resident - 1), static_cast<StreamTextureId>(i + 1),
+                              entry.resident - 1 });
+        }
+    }
+
+    // 預算被調低時先丟到預算內
+    while (residentBytes_ > options_.memoryBudget) {
+        Entry* victim = PickVictim(std::numeric_limits<float>::infinity(), nullptr);
+        if (!victim) {
+            break;
+        }
+        EvictOne(*victim, stats);
+    }
+
+    // 依重要性由高到低逐層載入；每張貼圖一次一層，載入後以下一層的重要性重新排隊
+    while (!candidates.empty()) {
+        Candidate candidate = candidates.top();
+        candidates.pop();
+        Entry* entry = Find(candidate.id);
+        if (!entry || entry->resident != candidate.level + 1) {
+            continue;
+        }
+        uint64_t cost = entry->desc.levelBytes[candidate.level];
+        if (stats.bytesStreamed > 0 && stats.bytesStreamed + cost > options_.uploadBytesPerFrame) {
+            break;
+        }
+        // 騰出空間：只丟比這一層更不重要的 mip，避免兩張貼圖來回搶同一塊預算
+        while (residentBytes_ + cost > options_.memoryBudget) {
+            Entry* victim = PickVictim(candidate.importance, entry);
+            if (!victim) {
+                break;
+            }
+            EvictOne(*victim, stats);
+        }
+        if (residentBytes_ + cost > options_.memoryBudget || !target_.StreamIn(candidate.id, candidate.level)) {
+            continue;
+        }
+        entry->resident = candidate.level;
+        residentBytes_ += cost;
+        stats.levelsStreamed++;
+        stats.bytesStreamed += cost;
+        if (entry->resident > entry->wanted) {
+            candidates.push({ Importance(*entry, entry->resident - 1), candidate.id, entry->resident - 1 });
+        }
+    }
+
+    for (Entry& entry : entries_) {
+        if (!entry.used) {
+            continue;
+        }
+        stats.textures++;
+        stats.wantedBytes += BytesFrom(entry.desc, entry.wanted);
+        stats.pendingTextures += entry.resident > entry.wanted ? 1 : 0;
+        entry.footprint = 0.0f;
+    }
+    stats.residentBytes = residentBytes_;
+    return stats;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 漸進式貼圖串流的決策部分：依使用貼圖的網格在螢幕上的面積決定每張貼圖需要的 mip，
+// 在全域記憶體預算內依優先順序逐層載入，預算不足時先丟棄最不重要（遠處或沒用到）貼圖的最精細層
+// 實際搬移資料交給 ITextureStreamTarget，本身不接觸 Direct3D，可在沒有裝置的環境執行
+// 不是執行緒安全的，應在同一個執行緒（通常是裝置執行緒）上使用
+
+using StreamTextureId = uint32_t;   // 0 表示無效
+
+// level 0 為最精細；levelBytes[i] 為第 i 層佔用的位元組數
+struct StreamTextureDesc {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint64_t> levelBytes;
+};
+
+// 實際載入／釋放 mip 的一方；TextureManager 以 Direct3D 9 實作
+class ITextureStreamTarget {
+public:
+    virtual ~ITextureStreamTarget() = default;
+
+    // 載入第 level 層（比目前最精細的常駐層再精細一層）；失敗回傳 false，下一幀重試
+    virtual bool StreamIn(StreamTextureId id, uint32_t level) = 0;
+
+    // 釋放比 level 更精細的層，使 level 成為最精細的常駐層
+    virtual void Evict(StreamTextureId id, uint32_t level) = 0;
+};
+
+struct TextureStreamerOptions {
+    uint64_t memoryBudget = 256ull << 20;        // 所有串流貼圖常駐 mip 的位元組上限
+    uint64_t uploadBytesPerFrame = 8ull << 20;   // 每幀最多載入的位元組（至少會載入一層）
+    uint32_t tailDimension = 64;                 // 寬高都不超過此值的 mip 尾端一律常駐
+    float lodBias = 0.0f;                        // 正值讓需要的 mip 變粗
+};
+
+struct TextureStreamerStats {
+    size_t textures = 0;
+    uint64_t residentBytes = 0;
+    uint64_t wantedBytes = 0;        // 每張貼圖都達到需要的 mip 時的總大小
+    size_t levelsStreamed = 0;       // 以下三項只計本次 Update
+    size_t levelsEvicted = 0;
+    uint64_t bytesStreamed = 0;
+    size_t pendingTextures = 0;      // 常駐的 mip 仍比需要的粗
+
+    std::string ToString() const;
+};
+
+class TextureStreamer {
+public:
+    explicit TextureStreamer(ITextureStreamTarget& target, const TextureStreamerOptions& options = {});
+
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    // 呼叫端需已讓 TailLevel 以下（含）的層常駐；desc 沒有任何層時回傳 0
+    StreamTextureId Register(const StreamTextureDesc& desc);
+    void Unregister(StreamTextureId id);
+
+    // 寬高都不超過 tailDimension 的最精細層；整張貼圖都比它小時為 0
+    static uint32_t TailLevel(const StreamTextureDesc& desc, uint32_t tailDimension);
+
+    // 本幀使用此貼圖的網格在螢幕上的像素面積；同一幀多次回報取最大值
+    void ReportUsage(StreamTextureId id, float screenPixels);
+
+    // 每幀呼叫一次：計算需要的 mip、處理預算並對 target 發出載入與釋放，最後清除本幀的使用回報
+    // 需要比常駐更少的 mip 時不會主動釋放，只有預算不足時才會被挑出來丟棄
+    TextureStreamerStats Update();
+
+    uint32_t ResidentLevel(StreamTextureId id) const;
+    uint32_t WantedLevel(StreamTextureId id) const;
+    uint64_t ResidentBytes() const { return residentBytes_; }
+
+    // 調低預算時在下一次 Update 釋放超出的部分
+    void SetMemoryBudget(uint64_t bytes) { options_.memoryBudget = bytes; }
+
+    // 半徑 radius 的包圍球在距離 distance、垂直視角 fovY（弧度）、視窗高 viewportHeight 像素下投影的像素面積
+    static float EstimateScreenPixels(float radius, float distance, float fovY, float viewportHeight);
+
+private:
+    struct Entry {
+        StreamTextureDesc desc;
+        uint32_t tail = 0;
+        uint32_t resident = 0;     // 最精細的常駐層
+        uint32_t wanted = 0;
+        float footprint = 0.0f;    // 本幀回報的像素面積
+        bool used = false;
+    };
+
+    Entry* Find(StreamTextureId id);
+    const Entry* Find(StreamTextureId id) const;
+    uint32_t DesiredLevel(const Entry& entry) const;
+    // 第 level 層每個 texel 對應的螢幕像素數；越大表示這層越需要
+    static float Importance(const Entry& entry, uint32_t level);
+    // 丟棄一層最精細 mip 的候選：importance 低於 limit 者中最低的；沒有時回傳 nullptr
+    Entry* PickVictim(float limit, const Entry* keep);
+    void EvictOne(Entry& entry, TextureStreamerStats& stats);
+
+    ITextureStreamTarget& target_;
+    TextureStreamerOptions options_;
+    std::vector<Entry> entries_;               // id - 1 為索引
+    std::vector<StreamTextureId> freeIds_;
+    uint64_t residentBytes_ = 0;
+};
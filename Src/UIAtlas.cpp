@@ -0,0 +1,186 @@
+#include "UIAtlas.h"
+#include "MappedFile.h"
+#include "ParallelFor.h"
+#include "json.hpp"
+#include "stb_image_write.h"
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <unordered_set>
+
+using json = nlohmann::json;
+
+namespace {
+
+uint32_t NextPowerOfTwo(uint32_t value) {
+    uint32_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+std::string ToUtf8(const std::wstring& text) {
+    std::u8string utf8 = std::filesystem::path(text).u8string();
+    return std::string(reinterpret_cast<const char*>(utf8.data()), utf8.size());
+}
+
+std::wstring FromUtf8(const std::string& text) {
+    return std::filesystem::path(std::u8string(reinterpret_cast<const char8_t*>(text.data()), text.size())).wstring();
+}
+
+// 複製到 rect，並把邊緣像素向外延伸 padding 像素（四角取角落像素）
+void Blit(TextureImage& page, const TextureImage& image, const AtlasRect& rect, int padding) {
+    const size_t rowBytes = size_t(image.width) * 4;
+    for (int row = -padding; row < int(image.height) + padding; ++row) {
+        const int sourceRow = std::clamp(row, 0, int(image.height) - 1);
+        const uint8_t* source = image.rgba.data() + size_t(sourceRow) * rowBytes;
+        uint8_t* dest = page.rgba.data() + (size_t(rect.y + row) * page.width + rect.x) * 4;
+        memcpy(dest, source, rowBytes);
+        for (int i = 1; i <= padding; ++i) {
+            memcpy(dest - size_t(i) * 4, source, 4);
+            memcpy(dest + rowBytes + size_t(i - 1) * 4, source + rowBytes - 4, 4);
+        }
+    }
+}
+
+// 先寫入暫存檔再改名，執行期不會讀到寫到一半的檔案
+void WriteFileAtomically(const std::filesystem::path& file, const void* data, size_t size) {
+    std::filesystem::path temp = file;
+    temp += ".tmp";
+    {
+        std::ofstream stream(temp, std::ios::binary | std::ios::trunc);
+        if (!stream) {
+            throw std::runtime_error(std::format("無法建立檔案: {}", temp.string()));
+        }
+        stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        if (!stream.flush()) {
+            throw std::runtime_error(std::format("寫入失敗: {}", temp.string()));
+        }
+    }
+    std::filesystem::rename(temp, file);
+}
+
+} // namespace
+
+UIAtlas BuildUIAtlas(const std::vector<std::wstring>& images, const UIAtlasOptions& options) {
+    std::vector<std::wstring> unique;
+    std::unordered_set<std::wstring> seen;
+    for (const std::wstring& image : images) {
+        if (!image.empty() && seen.insert(image).second) {
+            unique.push_back(image);
+        }
+    }
+
+    TextureCookOptions decodeOptions;
+    decodeOptions.colorKeyBmp = true;
+    std::vector<std::optional<TextureImage>> decoded(unique.size());
+    ParallelFor(unique.size(), [&](size_t i) {
+        try {
+            MappedFile file(unique[i]);
+            decoded[i] = DecodeTexture(unique[i], file.bytes(), decodeOptions);
+        } catch (const std::exception&) {
+            // 留空：記入 skipped，由 TextureManager 個別載入並回報錯誤
+        }
+    }, options.workers);
+
+    UIAtlas atlas;
+    std::vector<AtlasItem> items;
+    for (size_t i = 0; i < unique.size(); ++i) {
+        const std::optional<TextureImage>& image = decoded[i];
+        if (!image || int(image->width) > options.maxSpriteSize || int(image->height) > options.maxSpriteSize) {
+            atlas.skipped.push_back(unique[i]);
+            continue;
+        }
+        items.push_back({ std::to_string(i), int(image->width), int(image->height) });
+    }
+
+    AtlasLayout layout = PackAtlas(std::move(items), options.pageSize, options.pageSize, options.padding);
+    for (const std::string& key : layout.rejected) {
+        atlas.skipped.push_back(unique[std::stoul(key)]);
+    }
+
+    atlas.pages.resize(layout.pageUsedHeights.size());
+    for (size_t page = 0; page < atlas.pages.size(); ++page) {
+        TextureImage& image = atlas.pages[page];
+        image.width = uint32_t(layout.pageWidth);
+        image.height = (std::min)(NextPowerOfTwo(uint32_t(layout.pageUsedHeights[page])), uint32_t(layout.pageHeight));
+        image.rgba.assign(size_t(image.width) * image.height * 4, 0);
+    }
+    for (const auto& [key, placement] : layout.placements) {
+        const size_t index = std::stoul(key);
+        Blit(atlas.pages[placement.page], *decoded[index], placement.rect, options.padding);
+        atlas.sprites[unique[index]] = { placement.page, placement.rect };
+    }
+    return atlas;
+}
+
+void WriteUIAtlas(UIAtlas& atlas, const std::filesystem::path& manifest) {
+    json document;
+    document["version"] = 1;
+    document["pages"] = json::array();
+    atlas.pageFiles.clear();
+    for (size_t page = 0; page < atlas.pages.size(); ++page) {
+        const TextureImage& image = atlas.pages[page];
+        std::vector<uint8_t> png;
+        auto append = [](void* context, void* data, int size) {
+            auto* out = static_cast<std::vector<uint8_t>*>(context);
+            out->insert(out->end(), static_cast<uint8_t*>(data), static_cast<uint8_t*>(data) + size);
+        };
+        if (!stbi_write_png_to_func(append, &png, int(image.width), int(image.height), 4, image.rgba.data(),
+                                    int(image.width) * 4)) {
+            throw std::runtime_error(std::format("WriteUIAtlas: 無法編碼第 {} 頁", page));
+        }
+        std::filesystem::path file = manifest.parent_path() / std::format("{}_{}.png", manifest.stem().string(), page);
+        WriteFileAtomically(file, png.data(), png.size());
+        atlas.pageFiles.push_back(file);
+        document["pages"].push_back(file.filename().string());
+    }
+
+    document["sprites"] = json::array();
+    for (const auto& [path, sprite] : atlas.sprites) {
+        document["sprites"].push_back({ { "path", ToUtf8(path) }, { "page", sprite.page }, { "x", sprite.rect.x },
+                                        { "y", sprite.rect.y }, { "width", sprite.rect.width },
+                                        { "height", sprite.rect.height } });
+    }
+    document["skipped"] = json::array();
+    for (const std::wstring& path : atlas.skipped) {
+        document["skipped"].push_back(ToUtf8(path));
+    }
+
+    const std::string text = document.dump(2);
+    WriteFileAtomically(manifest, text.data(), text.size());
+}
+
+UIAtlas ReadUIAtlas(const std::filesystem::path& manifest) {
+    std::ifstream stream(manifest, std::ios::binary);
+    if (!stream) {
+        throw std::runtime_error(std::format("ReadUIAtlas: 無法開啟 {}", manifest.string()));
+    }
+
+    UIAtlas atlas;
+    try {
+        json document = json::parse(stream);
+        for (const json& page : document.at("pages")) {
+            atlas.pageFiles.push_back(manifest.parent_path() / page.get<std::string>());
+        }
+        for (const json& sprite : document.at("sprites")) {
+            UIAtlasSprite entry;
+            entry.page = sprite.at("page").get<uint32_t>();
+            entry.rect = { sprite.at("x").get<int>(), sprite.at("y").get<int>(), sprite.at("width").get<int>(),
+                           sprite.at("height").get<int>() };
+            if (entry.page >= atlas.pageFiles.size()) {
+                throw std::runtime_error("頁碼超出範圍");
+            }
+            atlas.sprites[FromUtf8(sprite.at("path").get<std::string>())] = entry;
+        }
+        for (const json& path : document.value("skipped", json::array())) {
+            atlas.skipped.push_back(FromUtf8(path.get<std::string>()));
+        }
+    } catch (const std::exception& e) {
+        throw std::runtime_error(std::format("ReadUIAtlas: {} 格式錯誤: {}", manifest.string(), e.what()));
+    }
+    return atlas;
+}
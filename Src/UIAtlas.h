@@ -0,0 +1,45 @@
+#pragma once
+
+#include "AtlasPacker.h"
+#include "TextureCooker.h"
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// UI 圖片圖集：把許多小圖打包進少數幾張頁面，UI 以來源矩形從頁面繪製，相鄰的圖片可以併成同一批
+// 圖片以與 TextureManager 相同的方式解碼（BMP 的純綠色視為透明），打包後的像素可直接使用
+// 建置時以 BuildUIAtlas + WriteUIAtlas 輸出 PNG 頁面與 JSON 清單，執行期以 ReadUIAtlas 讀回；
+// 也可在執行期直接 BuildUIAtlas 後把 pages 上傳成貼圖。本身不接觸 Direct3D
+
+struct UIAtlasOptions {
+    int pageSize = 1024;       // 頁面寬高；最後一頁的高度會裁到實際用到的 2 的冪次
+    int padding = 2;           // 每張圖四周以邊緣像素延伸的寬度，避免縮放時的雙線性取樣滲入鄰圖
+    int maxSpriteSize = 512;   // 寬或高超過此值的圖片不放進圖集（大圖本身就只需一次繪製）
+    size_t workers = 0;        // 解碼用的執行緒數，0 表示硬體執行緒數
+};
+
+struct UIAtlasSprite {
+    uint32_t page = 0;
+    AtlasRect rect;            // 頁面中的像素位置，不含 padding
+};
+
+struct UIAtlas {
+    std::vector<TextureImage> pages;                 // RGBA；ReadUIAtlas 讀入時為空，改用 pageFiles
+    std::vector<std::filesystem::path> pageFiles;    // WriteUIAtlas／ReadUIAtlas 的頁面檔案
+    std::unordered_map<std::wstring, UIAtlasSprite> sprites;   // 以 UI 使用的圖片路徑為鍵
+    std::vector<std::wstring> skipped;               // 太大、無法解碼或找不到的圖片，仍由 TextureManager 個別載入
+
+    size_t PageCount() const { return (std::max)(pages.size(), pageFiles.size()); }
+};
+
+// 解碼並打包 images（重複的路徑只放一次）；個別圖片失敗時記入 skipped，不拋出例外
+UIAtlas BuildUIAtlas(const std::vector<std::wstring>& images, const UIAtlasOptions& options = {});
+
+// 頁面寫成 manifest 同目錄的 <manifest 主檔名>_<頁碼>.png，清單為 JSON；寫入失敗時拋出 std::runtime_error
+// 寫入後 atlas.pageFiles 為各頁的檔案路徑
+void WriteUIAtlas(UIAtlas& atlas, const std::filesystem::path& manifest);
+
+// 讀回 WriteUIAtlas 的清單；檔案不存在或格式錯誤時拋出 std::runtime_error
+UIAtlas ReadUIAtlas(const std::filesystem::path& manifest);
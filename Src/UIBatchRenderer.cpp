@@ -0,0 +1,176 @@
+#include "UIBatchRenderer.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+HRESULT UIBatchRenderer::Draw(IDirect3DDevice9* dev, ID3DXSprite* sprite, ID3DXFont* font, const UIDrawList& list) {
+    if (!dev) {
+        return E_POINTER;
+    }
+    stats_ = {};
+    stats_.quads = list.QuadCount();
+    stats_.textRuns = list.TextCount();
+    stats_.batches = list.Batches().size();
+
+    // 整幀的頂點一次寫入：放得下就接在上一幀之後（NOOVERWRITE），繞回開頭時才 DISCARD
+    const std::vector<UIVertex>& vertices = list.Vertices();
+    UINT baseVertex = 0;
+    if (!vertices.empty()) {
+        const UINT count = UINT(vertices.size());
+        HRESULT hr = EnsureBuffers(dev, count);
+        if (FAILED(hr)) {
+            return hr;
+        }
+        DWORD lockFlags = D3DLOCK_NOOVERWRITE;
+        if (ringOffset_ + count > capacity_) {
+            ringOffset_ = 0;
+            lockFlags = D3DLOCK_DISCARD;
+        }
+        void* data = nullptr;
+        hr = vertexBuffer_->Lock(ringOffset_ * sizeof(UIVertex), count * sizeof(UIVertex), &data, lockFlags);
+        if (FAILED(hr)) {
+            return hr;
+        }
+        memcpy(data, vertices.data(), count * sizeof(UIVertex));
+        vertexBuffer_->Unlock();
+        baseVertex = ringOffset_;
+        ringOffset_ += count;
+    }
+
+    DWORD oldFVF = 0;
+    dev->GetFVF(&oldFVF);
+
+    bool quadStates = false;
+    IDirect3DBaseTexture9* boundTexture = nullptr;
+    bool boundSolid = false;
+    for (const UIDrawBatch& batch : list.Batches()) {
+        if (batch.kind == UIDrawBatchKind::Text) {
+            if (!sprite || !font) {
+                continue;
+            }
+            sprite->Begin(D3DXSPRITE_ALPHABLEND | D3DXSPRITE_DONOTSAVESTATE);
+            D3DXMATRIX identity;
+            D3DXMatrixIdentity(&identity);
+            sprite->SetTransform(&identity);
+            for (uint32_t i = batch.first; i < batch.first + batch.count; ++i) {
+                const UITextRun& run = list.TextRuns()[i];
+                RECT rect = { run.left, run.top, run.right, run.bottom };
+                font->DrawText(sprite, run.text.c_str(), -1, &rect, run.format, run.color);
+            }
+            sprite->End();
+            stats_.drawCalls++;
+            // sprite 會改動貼圖階段與頂點格式
+            quadStates = false;
+            continue;
+        }
+
+        if (!quadStates) {
+            SetQuadStates(dev);
+            quadStates = true;
+            boundTexture = nullptr;
+            boundSolid = false;
+        }
+        const bool solid = batch.texture == nullptr;
+        if (solid != boundSolid || batch.texture != boundTexture) {
+            // 純色直接取頂點色；貼圖與頂點色相乘（與 ID3DXSprite 相同）
+            const DWORD op = solid ? D3DTOP_SELECTARG2 : D3DTOP_MODULATE;
+            dev->SetTexture(0, batch.texture);
+            dev->SetTextureStageState(0, D3DTSS_COLOROP, op);
+            dev->SetTextureStageState(0, D3DTSS_ALPHAOP, op);
+            boundTexture = batch.texture;
+            boundSolid = solid;
+        }
+        for (UINT done = 0; done < batch.count;) {
+            const UINT quads = (std::min)(batch.count - done, kMaxQuadsPerDraw);
+            dev->DrawIndexedPrimitive(D3DPT_TRIANGLELIST, INT(baseVertex + (batch.first + done) * 4), 0, quads * 4, 0,
+                                      quads * 2);
+            stats_.drawCalls++;
+            done += quads;
+        }
+    }
+
+    // 不讓裝置繼續持有 UI 貼圖；頂點格式還給 3D 場景
+    dev->SetTexture(0, nullptr);
+    dev->SetFVF(oldFVF);
+    return S_OK;
+}
+
+void UIBatchRenderer::OnLostDevice() {
+    vertexBuffer_.Reset();
+    capacity_ = 0;
+    ringOffset_ = 0;
+}
+
+HRESULT UIBatchRenderer::EnsureBuffers(IDirect3DDevice9* dev, UINT vertexCount) {
+    if (!indexBuffer_) {
+        // 固定的四邊形索引 (0,1,2)(0,2,3)，每次繪製以 BaseVertexIndex 指向該批的頂點
+        HRESULT hr = dev->CreateIndexBuffer(kMaxQuadsPerDraw * 6 * sizeof(WORD), D3DUSAGE_WRITEONLY, D3DFMT_INDEX16,
+                                            D3DPOOL_MANAGED, &indexBuffer_, nullptr);
+        if (FAILED(hr)) {
+            return hr;
+        }
+        WORD* indices = nullptr;
+        hr = indexBuffer_->Lock(0, 0, reinterpret_cast<void**>(&indices), 0);
+        if (FAILED(hr)) {
+            indexBuffer_.Reset();
+            return hr;
+        }
+        for (UINT quad = 0; quad < kMaxQuadsPerDraw; ++quad) {
+            const WORD v = WORD(quad * 4);
+            WORD* out = indices + quad * 6;
+            out[0] = v;
+            out[1] = WORD(v + 1);
+            out[2] = WORD(v + 2);
+            out[3] = v;
+            out[4] = WORD(v + 2);
+            out[5] = WORD(v + 3);
+        }
+        indexBuffer_->Unlock();
+    }
+
+    if (vertexCount > capacity_) {
+        // 一次加倍，避免 UI 逐漸變多時每幀重建
+        UINT capacity = (std::max)(capacity_ * 2, UINT(8192));
+        while (capacity < vertexCount) {
+            capacity *= 2;
+        }
+        vertexBuffer_.Reset();
+        HRESULT hr = dev->CreateVertexBuffer(capacity * sizeof(UIVertex), D3DUSAGE_DYNAMIC | D3DUSAGE_WRITEONLY, kFVF,
+                                             D3DPOOL_DEFAULT, &vertexBuffer_, nullptr);
+        if (FAILED(hr)) {
+            capacity_ = 0;
+            return hr;
+        }
+        capacity_ = capacity;
+        ringOffset_ = capacity;   // 第一次鎖定走 DISCARD
+    }
+    return S_OK;
+}
+
+void UIBatchRenderer::SetQuadStates(IDirect3DDevice9* dev) {
+    dev->SetVertexShader(nullptr);
+    dev->SetPixelShader(nullptr);
+    dev->SetFVF(kFVF);
+    dev->SetStreamSource(0, vertexBuffer_.Get(), 0, sizeof(UIVertex));
+    dev->SetIndices(indexBuffer_.Get());
+
+    dev->SetRenderState(D3DRS_LIGHTING, FALSE);
+    dev->SetRenderState(D3DRS_CULLMODE, D3DCULL_NONE);
+    dev->SetRenderState(D3DRS_FOGENABLE, FALSE);
+    dev->SetRenderState(D3DRS_ALPHATESTENABLE, FALSE);
+
+    dev->SetTextureStageState(0, D3DTSS_COLORARG1, D3DTA_TEXTURE);
+    dev->SetTextureStageState(0, D3DTSS_COLORARG2, D3DTA_DIFFUSE);
+    dev->SetTextureStageState(0, D3DTSS_ALPHAARG1, D3DTA_TEXTURE);
+    dev->SetTextureStageState(0, D3DTSS_ALPHAARG2, D3DTA_DIFFUSE);
+    dev->SetTextureStageState(0, D3DTSS_TEXCOORDINDEX, 0);
+    dev->SetTextureStageState(0, D3DTSS_TEXTURETRANSFORMFLAGS, D3DTTFF_DISABLE);
+    dev->SetTextureStageState(1, D3DTSS_COLOROP, D3DTOP_DISABLE);
+    dev->SetTextureStageState(1, D3DTSS_ALPHAOP, D3DTOP_DISABLE);
+
+    dev->SetSamplerState(0, D3DSAMP_ADDRESSU, D3DTADDRESS_CLAMP);
+    dev->SetSamplerState(0, D3DSAMP_ADDRESSV, D3DTADDRESS_CLAMP);
+    dev->SetSamplerState(0, D3DSAMP_MINFILTER, D3DTEXF_LINEAR);
+    dev->SetSamplerState(0, D3DSAMP_MAGFILTER, D3DTEXF_LINEAR);
+    dev->SetSamplerState(0, D3DSAMP_MIPFILTER, D3DTEXF_NONE);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "UIDrawList.h"
+#include <d3dx9.h>
+#include <wrl/client.h>
+using Microsoft::WRL::ComPtr;
+
+struct UIDrawStats {
+    size_t quads = 0;
+    size_t textRuns = 0;
+    size_t batches = 0;
+    size_t drawCalls = 0;   // DrawIndexedPrimitive 次數加上文字的 sprite 批次數
+};
+
+// 把 UIDrawList 送到裝置：所有頂點每幀上傳一次到環狀配置的動態頂點緩衝，每個四邊形批次一次 DrawIndexedPrimitive
+// （超過 kMaxQuadsPerDraw 時分段），文字批次以一組 sprite Begin/End 交給 ID3DXFont
+// 只在裝置執行緒使用；呼叫端負責 alpha 混合與 Z 測試等整體 UI 狀態
+class UIBatchRenderer {
+public:
+    static constexpr DWORD kFVF = D3DFVF_XYZRHW | D3DFVF_DIFFUSE | D3DFVF_TEX1;
+    static constexpr UINT kMaxQuadsPerDraw = 16384;   // 16 bit 索引可定址的頂點數 / 4
+
+    // list 需已 Finish；sprite 或 font 為 nullptr 時略過文字
+    HRESULT Draw(IDirect3DDevice9* dev, ID3DXSprite* sprite, ID3DXFont* font, const UIDrawList& list);
+
+    // 動態頂點緩衝在 D3DPOOL_DEFAULT，裝置 Reset 前需釋放；下一次 Draw 時重新建立
+    void OnLostDevice();
+
+    const UIDrawStats& LastStats() const { return stats_; }
+
+private:
+    HRESULT EnsureBuffers(IDirect3DDevice9* dev, UINT vertexCount);
+    void SetQuadStates(IDirect3DDevice9* dev);
+
+    ComPtr<IDirect3DVertexBuffer9> vertexBuffer_;
+    ComPtr<IDirect3DIndexBuffer9> indexBuffer_;
+    UINT capacity_ = 0;     // 頂點數
+    UINT ringOffset_ = 0;   // 下一段可用的頂點位置
+    UIDrawStats stats_;
+};
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// UIManager 的名稱與 ID 索引：名稱或 ID 到組件的雜湊表，查找不必走訪組件樹
+// 同一個名稱或 ID 可能對應多個組件（圖片組件以檔名命名、反序列化的 ID 可能與新建的重複），
+// 這時回傳組件樹前序走訪中最先遇到的，與原本遞迴查找的結果相同；只有重複的鍵需要比較樹中位置
+// 索引是扁平的，組件換父組件時不必更新；已登記的組件改名稱或 ID 要經過 Rename/Renumber
+// Component 需要有 name（std::wstring）、id（int）、parent 與 children（unique_ptr 的 vector）；
+// 不依賴 Direct3D，可用簡單的組件型別直接檢查
+
+template <typename Component>
+class UIComponentIndex {
+public:
+    using Roots = std::vector<std::unique_ptr<Component>>;
+
+    // roots 為組件樹的根組件清單，重複的鍵依它決定前後
+    explicit UIComponentIndex(const Roots& roots) : roots_(roots) {}
+
+    void Clear() {
+        byName_.clear();
+        byId_.clear();
+    }
+
+    // 登記或移除組件與其整個子樹
+    void AddTree(Component* component) {
+        byName_[component->name].push_back(component);
+        byId_[component->id].push_back(component);
+        for (const auto& child : component->children) {
+            AddTree(child.get());
+        }
+    }
+
+    void RemoveTree(Component* component) {
+        for (const auto& child : component->children) {
+            RemoveTree(child.get());
+        }
+        Erase(byName_, component->name, component);
+        Erase(byId_, component->id, component);
+    }
+
+    void Rename(Component* component, const std::wstring& name) {
+        if (component->name == name) {
+            return;
+        }
+        Erase(byName_, component->name, component);
+        component->name = name;
+        byName_[name].push_back(component);
+    }
+
+    void Renumber(Component* component, int id) {
+        if (component->id == id) {
+            return;
+        }
+        Erase(byId_, component->id, component);
+        component->id = id;
+        byId_[id].push_back(component);
+    }
+
+    Component* FindByName(const std::wstring& name) const {
+        auto it = byName_.find(name);
+        return it != byName_.end() ? First(it->second) : nullptr;
+    }
+
+    Component* FindById(int id) const {
+        auto it = byId_.find(id);
+        return it != byId_.end() ? First(it->second) : nullptr;
+    }
+
+    // 登記的組件數（每個組件在名稱與 ID 索引各登記一次）
+    size_t Size() const {
+        size_t count = 0;
+        for (const auto& [name, entries] : byName_) {
+            count += entries.size();
+        }
+        return count;
+    }
+
+    // 調試用：比對索引與組件樹。樹中每個組件都要以目前的名稱與 ID 登記，
+    // 登記總數要等於樹中的組件數（沒有已刪除或重複登記的組件）；不一致時寫到 log 並回傳 false
+    bool Validate(std::wostream& log) const {
+        bool valid = true;
+        size_t treeCount = 0;
+        ValidateTree(roots_, log, valid, treeCount);
+
+        size_t idCount = 0;
+        for (const auto& [id, entries] : byId_) {
+            idCount += entries.size();
+        }
+        const size_t nameCount = Size();
+        if (nameCount != treeCount || idCount != treeCount) {
+            log << L"UIManager: component index has " << nameCount << L" names and " << idCount << L" ids for "
+                << treeCount << L" components" << std::endl;
+            valid = false;
+        }
+        return valid;
+    }
+
+private:
+    Component* First(const std::vector<Component*>& entries) const {
+        Component* first = entries.front();
+        for (size_t i = 1; i < entries.size(); ++i) {
+            if (Precedes(entries[i], first)) {
+                first = entries[i];
+            }
+        }
+        return first;
+    }
+
+    // a 在前序走訪中是否比 b 先遇到：祖先在子孫之前，否則比較分岔處兩個兄弟的順序
+    bool Precedes(const Component* a, const Component* b) const {
+        std::vector<const Component*> pathA, pathB;
+        for (const Component* c = a; c; c = c->parent) {
+            pathA.push_back(c);
+        }
+        for (const Component* c = b; c; c = c->parent) {
+            pathB.push_back(c);
+        }
+        size_t depth = 0;
+        while (depth < pathA.size() && depth < pathB.size() &&
+               pathA[pathA.size() - 1 - depth] == pathB[pathB.size() - 1 - depth]) {
+            ++depth;
+        }
+        if (depth == pathA.size() || depth == pathB.size()) {
+            return depth == pathA.size() && depth != pathB.size();
+        }
+        const Component* branchA = pathA[pathA.size() - 1 - depth];
+        const Component* branchB = pathB[pathB.size() - 1 - depth];
+        const Roots& siblings = depth == 0 ? roots_ : pathA[pathA.size() - depth]->children;
+        for (const auto& sibling : siblings) {
+            if (sibling.get() == branchA || sibling.get() == branchB) {
+                return sibling.get() == branchA;
+            }
+        }
+        return false;
+    }
+
+    template <typename Key>
+    static void Erase(std::unordered_map<Key, std::vector<Component*>>& index, const Key& key,
+                      Component* component) {
+        auto it = index.find(key);
+        if (it == index.end()) {
+            return;
+        }
+        auto& entries = it->second;
+        entries.erase(std::remove(entries.begin(), entries.end(), component), entries.end());
+        if (entries.empty()) {
+            index.erase(it);
+        }
+    }
+
+    template <typename Key>
+    static bool Contains(const std::unordered_map<Key, std::vector<Component*>>& index, const Key& key,
+                         const Component* component) {
+        auto it = index.find(key);
+        return it != index.end() && std::find(it->second.begin(), it->second.end(), component) != it->second.end();
+    }
+
+    void ValidateTree(const Roots& components, std::wostream& log, bool& valid, size_t& count) const {
+        for (const auto& component : components) {
+            ++count;
+            if (!Contains(byName_, component->name, component.get())) {
+                log << L"UIManager: component \"" << component->name << L"\" (id " << component->id
+                    << L") missing from name index" << std::endl;
+                valid = false;
+            }
+            if (!Contains(byId_, component->id, component.get())) {
+                log << L"UIManager: component \"" << component->name << L"\" (id " << component->id
+                    << L") missing from id index" << std::endl;
+                valid = false;
+            }
+            ValidateTree(component->children, log, valid, count);
+        }
+    }
+
+    const Roots& roots_;
+    std::unordered_map<std::wstring, std::vector<Component*>> byName_;
+    std::unordered_map<int, std::vector<Component*>> byId_;
+};
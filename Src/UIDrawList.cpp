@@ -0,0 +1,124 @@
+#include "UIDrawList.h"
+#include <algorithm>
+
+namespace {
+
+bool Overlaps(const UIDrawRect& a, const UIDrawRect& b) {
+    return a.left < b.right && b.left < a.right && a.top < b.bottom && b.top < a.bottom;
+}
+
+UIDrawRect Union(const UIDrawRect& a, const UIDrawRect& b) {
+    return { (std::min)(a.left, b.left), (std::min)(a.top, b.top), (std::max)(a.right, b.right),
+             (std::max)(a.bottom, b.bottom) };
+}
+
+} // namespace
+
+void UIDrawList::Clear() {
+    pending_.clear();
+    quads_.clear();
+    texts_.clear();
+    batches_.clear();
+    vertices_.clear();
+    textRuns_.clear();
+}
+
+void UIDrawList::AddImage(IDirect3DBaseTexture9* texture, uint32_t textureWidth, uint32_t textureHeight,
+                          const UIDrawRect& source, const UIDrawRect& dest, uint32_t color) {
+    if (!texture || textureWidth == 0 || textureHeight == 0) {
+        return;
+    }
+    const float invWidth = 1.0f / float(textureWidth);
+    const float invHeight = 1.0f / float(textureHeight);
+    PushQuad(texture, dest, source.left * invWidth, source.top * invHeight, source.right * invWidth,
+             source.bottom * invHeight, color);
+}
+
+void UIDrawList::AddSolid(const UIDrawRect& dest, uint32_t color) {
+    PushQuad(nullptr, dest, 0.0f, 0.0f, 0.0f, 0.0f, color);
+}
+
+void UIDrawList::AddFrame(const UIDrawRect& rect, uint32_t color, float thickness) {
+    const float inner = (std::min)(thickness, (std::min)(rect.right - rect.left, rect.bottom - rect.top) * 0.5f);
+    AddSolid({ rect.left, rect.top, rect.right, rect.top + inner }, color);
+    AddSolid({ rect.left, rect.bottom - inner, rect.right, rect.bottom }, color);
+    AddSolid({ rect.left, rect.top + inner, rect.left + inner, rect.bottom - inner }, color);
+    AddSolid({ rect.right - inner, rect.top + inner, rect.right, rect.bottom - inner }, color);
+}
+
+void UIDrawList::AddText(std::wstring_view text, int left, int top, int right, int bottom, uint32_t format,
+                         uint32_t color) {
+    if (text.empty()) {
+        return;
+    }
+    const UIDrawRect bounds{ float(left), float(top), float(right), float(bottom) };
+    const uint32_t batch = Place(UIDrawBatchKind::Text, nullptr, bounds, (format & kTextNoClip) != 0);
+    texts_.push_back({ batch, { std::wstring(text), left, top, right, bottom, format, color } });
+}
+
+void UIDrawList::PushQuad(IDirect3DBaseTexture9* texture, const UIDrawRect& dest, float u0, float v0, float u1,
+                          float v1, uint32_t color) {
+    if (!(dest.right > dest.left && dest.bottom > dest.top)) {
+        return;
+    }
+    const uint32_t batch = Place(UIDrawBatchKind::Quads, texture, dest, false);
+
+    // 像素中心在整數座標加 0.5：頂點往左上移半個像素，貼圖像素才會一對一對齊螢幕像素
+    const float left = dest.left - 0.5f;
+    const float top = dest.top - 0.5f;
+    const float right = dest.right - 0.5f;
+    const float bottom = dest.bottom - 0.5f;
+    quads_.push_back({ batch,
+                       { { left, top, 0.0f, 1.0f, color, u0, v0 },
+                         { right, top, 0.0f, 1.0f, color, u1, v0 },
+                         { right, bottom, 0.0f, 1.0f, color, u1, v1 },
+                         { left, bottom, 0.0f, 1.0f, color, u0, v1 } } });
+}
+
+uint32_t UIDrawList::Place(UIDrawBatchKind kind, IDirect3DBaseTexture9* texture, const UIDrawRect& bounds,
+                           bool unbounded) {
+    const size_t stop = pending_.size() > kLookback ? pending_.size() - kLookback : 0;
+    for (size_t i = pending_.size(); i-- > stop;) {
+        PendingBatch& batch = pending_[i];
+        if (batch.kind == kind && batch.texture == texture) {
+            batch.bounds = Union(batch.bounds, bounds);
+            batch.unbounded = batch.unbounded || unbounded;
+            batch.count++;
+            return uint32_t(i);
+        }
+        // 之後畫的批次與它重疊：不能再往前併
+        if (unbounded || batch.unbounded || Overlaps(batch.bounds, bounds)) {
+            break;
+        }
+    }
+    pending_.push_back({ kind, texture, bounds, unbounded, 1 });
+    return uint32_t(pending_.size() - 1);
+}
+
+void UIDrawList::Finish() {
+    batches_.clear();
+    vertices_.clear();
+    textRuns_.clear();
+
+    // 每批的起點：四邊形與文字各自依批次順序連續存放
+    std::vector<uint32_t> cursor(pending_.size());
+    uint32_t quadOffset = 0;
+    uint32_t textOffset = 0;
+    batches_.reserve(pending_.size());
+    for (size_t i = 0; i < pending_.size(); ++i) {
+        const PendingBatch& batch = pending_[i];
+        uint32_t& offset = batch.kind == UIDrawBatchKind::Quads ? quadOffset : textOffset;
+        cursor[i] = offset;
+        batches_.push_back({ batch.kind, batch.texture, offset, batch.count });
+        offset += batch.count;
+    }
+
+    vertices_.resize(size_t(quadOffset) * 4);
+    for (const Quad& quad : quads_) {
+        std::copy(std::begin(quad.vertices), std::end(quad.vertices), vertices_.begin() + size_t(cursor[quad.batch]++) * 4);
+    }
+    textRuns_.resize(textOffset);
+    for (Text& text : texts_) {
+        textRuns_[cursor[text.batch]++] = std::move(text.run);
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct IDirect3DBaseTexture9;
+
+// UI 的 CPU 端繪製清單：依呼叫順序（即圖層順序）記錄貼圖四邊形、純色四邊形與文字，
+// 相同貼圖的四邊形（純色視為同一種狀態）與文字各自合併成批次，交給 UIBatchRenderer 以少數幾次繪製送出
+// 新項目只會併入往回 kLookback 批以內、且中間的批次都不與它重疊的同類批次，合併不會改變重疊處的前後順序
+// 本身不接觸 Direct3D（貼圖只當作識別用的指標），可不建裝置直接檢查產生的批次
+
+struct UIDrawRect {
+    float left = 0.0f;
+    float top = 0.0f;
+    float right = 0.0f;
+    float bottom = 0.0f;
+};
+
+// D3DFVF_XYZRHW | D3DFVF_DIFFUSE | D3DFVF_TEX1
+struct UIVertex {
+    float x, y, z, rhw;
+    uint32_t color;
+    float u, v;
+};
+
+struct UITextRun {
+    std::wstring text;
+    int left = 0;
+    int top = 0;
+    int right = 0;
+    int bottom = 0;
+    uint32_t format = 0;   // ID3DXFont::DrawText 的 DT_* 旗標
+    uint32_t color = 0;
+};
+
+enum class UIDrawBatchKind : uint8_t {
+    Quads,
+    Text,
+};
+
+struct UIDrawBatch {
+    UIDrawBatchKind kind = UIDrawBatchKind::Quads;
+    IDirect3DBaseTexture9* texture = nullptr;   // Quads：nullptr 為純色
+    uint32_t first = 0;   // Quads：第一個四邊形（頂點從 first * 4 起）；Text：TextRuns() 的索引
+    uint32_t count = 0;
+};
+
+class UIDrawList {
+public:
+    static constexpr size_t kLookback = 8;
+    static constexpr uint32_t kTextNoClip = 0x00000100;   // DT_NOCLIP：文字可能畫出矩形外，不與其他批次交換順序
+
+    // 保留容量，每幀重複使用
+    void Clear();
+
+    // source 為貼圖中的像素矩形，dest 為螢幕座標；textureWidth/textureHeight 是整張貼圖的大小，用來換算 UV
+    void AddImage(IDirect3DBaseTexture9* texture, uint32_t textureWidth, uint32_t textureHeight,
+                  const UIDrawRect& source, const UIDrawRect& dest, uint32_t color);
+    void AddSolid(const UIDrawRect& dest, uint32_t color);
+    // 沿 rect 內緣畫寬 thickness 的外框（四個純色四邊形）
+    void AddFrame(const UIDrawRect& rect, uint32_t color, float thickness = 1.0f);
+    void AddText(std::wstring_view text, int left, int top, int right, int bottom, uint32_t format, uint32_t color);
+
+    // 依批次順序排好頂點與文字；在最後一次 Add 之後、讀取下列結果之前呼叫
+    void Finish();
+
+    const std::vector<UIDrawBatch>& Batches() const { return batches_; }
+    const std::vector<UIVertex>& Vertices() const { return vertices_; }
+    const std::vector<UITextRun>& TextRuns() const { return textRuns_; }
+    size_t QuadCount() const { return quads_.size(); }
+    size_t TextCount() const { return texts_.size(); }
+
+private:
+    struct PendingBatch {
+        UIDrawBatchKind kind;
+        IDirect3DBaseTexture9* texture;
+        UIDrawRect bounds;
+        bool unbounded;
+        uint32_t count;
+    };
+    struct Quad {
+        uint32_t batch;
+        UIVertex vertices[4];
+    };
+    struct Text {
+        uint32_t batch;
+        UITextRun run;
+    };
+
+    // 回傳項目所屬的批次
+    uint32_t Place(UIDrawBatchKind kind, IDirect3DBaseTexture9* texture, const UIDrawRect& bounds, bool unbounded);
+    void PushQuad(IDirect3DBaseTexture9* texture, const UIDrawRect& dest, float u0, float v0, float u1, float v1,
+                  uint32_t color);
+
+    std::vector<PendingBatch> pending_;
+    std::vector<Quad> quads_;
+    std::vector<Text> texts_;
+
+    std::vector<UIDrawBatch> batches_;
+    std::vector<UIVertex> vertices_;
+    std::vector<UITextRun> textRuns_;
+};
@@ -0,0 +1,83 @@
+#include "UIHitGrid.h"
+#include <algorithm>
+
+void UIHitGrid::Clear() {
+    items_.clear();
+    cells_.clear();
+    large_.clear();
+}
+
+void UIHitGrid::Insert(uint32_t key, const UIHitRect& rect) {
+    Remove(key);
+    if (rect.Empty()) {
+        return;
+    }
+    items_.emplace(key, rect);
+    const CellRange range = CellsOf(rect);
+    if (range.large) {
+        large_.push_back(key);
+        return;
+    }
+    for (int cy = range.y0; cy <= range.y1; ++cy) {
+        for (int cx = range.x0; cx <= range.x1; ++cx) {
+            cells_[CellKey(cx, cy)].push_back(key);
+        }
+    }
+}
+
+void UIHitGrid::Remove(uint32_t key) {
+    auto it = items_.find(key);
+    if (it == items_.end()) {
+        return;
+    }
+    const CellRange range = CellsOf(it->second);
+    items_.erase(it);
+    if (range.large) {
+        Erase(large_, key);
+        return;
+    }
+    for (int cy = range.y0; cy <= range.y1; ++cy) {
+        for (int cx = range.x0; cx <= range.x1; ++cx) {
+            auto cell = cells_.find(CellKey(cx, cy));
+            if (cell == cells_.end()) {
+                continue;
+            }
+            Erase(cell->second, key);
+            if (cell->second.empty()) {
+                cells_.erase(cell);
+            }
+        }
+    }
+}
+
+void UIHitGrid::Query(int x, int y, std::vector<uint32_t>& out) const {
+    if (auto cell = cells_.find(CellKey(x >> kCellShift, y >> kCellShift)); cell != cells_.end()) {
+        for (uint32_t key : cell->second) {
+            if (items_.at(key).Contains(x, y)) {
+                out.push_back(key);
+            }
+        }
+    }
+    for (uint32_t key : large_) {
+        if (items_.at(key).Contains(x, y)) {
+            out.push_back(key);
+        }
+    }
+}
+
+UIHitGrid::CellRange UIHitGrid::CellsOf(const UIHitRect& rect) {
+    // 右、下邊界不含在矩形內；算術右移讓負座標也落在正確的格子
+    CellRange range{ rect.left >> kCellShift, rect.top >> kCellShift, (rect.right - 1) >> kCellShift,
+                     (rect.bottom - 1) >> kCellShift, false };
+    const uint64_t cells = uint64_t(int64_t(range.x1) - range.x0 + 1) * uint64_t(int64_t(range.y1) - range.y0 + 1);
+    range.large = cells > kMaxCellsPerItem;
+    return range;
+}
+
+void UIHitGrid::Erase(std::vector<uint32_t>& keys, uint32_t key) {
+    auto it = std::find(keys.begin(), keys.end(), key);
+    if (it != keys.end()) {
+        *it = keys.back();
+        keys.pop_back();
+    }
+}
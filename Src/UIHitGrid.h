@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// UI 點擊測試用的均勻格線空間索引：每個項目以呼叫端指定的整數 key 識別，記錄一個螢幕矩形，
+// 依矩形覆蓋的格子登記；查詢一點只需看該點所在的一格，不必走訪全部元件
+// 只負責幾何，z 順序、可見性與透明度由呼叫端對查到的少數候選判斷
+// 本身不依賴 Windows 或 Direct3D，可直接檢查查詢結果
+
+struct UIHitRect {
+    int left = 0;
+    int top = 0;
+    int right = 0;
+    int bottom = 0;
+
+    bool Empty() const { return right <= left || bottom <= top; }
+    bool Contains(int x, int y) const { return x >= left && x < right && y >= top && y < bottom; }
+};
+
+class UIHitGrid {
+public:
+    static constexpr int kCellShift = 6;               // 64x64 像素一格
+    static constexpr size_t kMaxCellsPerItem = 1024;   // 超過的大矩形放在每次都檢查的清單
+
+    void Clear();
+
+    // key 已存在時等同 Update；空矩形只移除舊的登記
+    void Insert(uint32_t key, const UIHitRect& rect);
+    void Update(uint32_t key, const UIHitRect& rect) { Insert(key, rect); }
+    void Remove(uint32_t key);
+
+    // 把矩形包含 (x, y) 的項目 key 附加到 out，順序不固定
+    void Query(int x, int y, std::vector<uint32_t>& out) const;
+
+    size_t Size() const { return items_.size(); }
+    size_t CellCount() const { return cells_.size(); }
+
+private:
+    struct CellRange {
+        int x0, y0, x1, y1;   // 含兩端
+        bool large;
+    };
+
+    static CellRange CellsOf(const UIHitRect& rect);
+    static uint64_t CellKey(int cx, int cy) { return (uint64_t(uint32_t(cx)) << 32) | uint32_t(cy); }
+    static void Erase(std::vector<uint32_t>& keys, uint32_t key);
+
+    std::unordered_map<uint32_t, UIHitRect> items_;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> cells_;
+    std::vector<uint32_t> large_;
+};
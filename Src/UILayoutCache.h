@@ -0,0 +1,87 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+// UIComponentNew 的絕對座標快取：每個組件存一份 UILayoutState（絕對矩形與失效旗標），
+// 讀取時快取有效就直接回傳，否則只沿著失效的父組件往上重算
+// - Invalidate 讓組件與子樹失效，遇到已失效的組件即停止往下：組件只會在所有祖先都已重算後才變為有效，
+//   所以失效組件的子孫一定也已失效。換父組件後新的父組件可能已失效而組件本身仍有效，
+//   因此換父組件也要對組件本身呼叫 Invalidate，這個條件才會成立
+// - 另有一個「有組件失效」的旗標（UIManager 持有的實例）：Update 在旗標清除時不走訪組件樹；
+//   直接修改欄位而沒有呼叫 Invalidate 的組件，讀取時與 Update 都不會重算
+// Component 需要有 relativeX、relativeY、width、height（int）、parent、children（unique_ptr 的 vector），
+// 以及本類別可存取的 mutable layout_（UILayoutState<Rect>）；Rect 需要有 left/top/right/bottom
+// 不依賴 Direct3D，可用簡單的組件型別直接檢查
+
+template <typename Rect>
+struct UILayoutState {
+    Rect absolute{};
+    bool dirty = true;
+};
+
+template <typename Component>
+class UILayoutCache {
+public:
+    using Roots = std::vector<std::unique_ptr<Component>>;
+
+    explicit UILayoutCache(const Roots& roots) : roots_(roots) {}
+
+    static auto Absolute(const Component& component) {
+        if (component.layout_.dirty) {
+            Recompute(component);
+        }
+        return component.layout_.absolute;
+    }
+
+    // 座標、大小或父組件改變後呼叫
+    static void Invalidate(const Component& component) {
+        if (component.layout_.dirty) {
+            return;
+        }
+        component.layout_.dirty = true;
+        for (const auto& child : component.children) {
+            Invalidate(*child);
+        }
+    }
+
+    // 記錄有組件失效；組件呼叫 Invalidate、加入或移除組件時由管理者呼叫
+    void MarkDirty() { dirty_ = true; }
+    bool IsDirty() const { return dirty_; }
+
+    // 由上而下重算所有失效組件，每個組件只計算一次；沒有標記時不走訪
+    void Update() {
+        if (!dirty_) {
+            return;
+        }
+        dirty_ = false;
+        UpdateTree(roots_);
+    }
+
+private:
+    static void Recompute(const Component& component) {
+        int x = component.relativeX;
+        int y = component.relativeY;
+        if (component.parent) {
+            const auto parent = Absolute(*component.parent);
+            x += parent.left;
+            y += parent.top;
+        }
+        auto& layout = component.layout_;
+        layout.absolute.left = x;
+        layout.absolute.top = y;
+        layout.absolute.right = x + component.width;
+        layout.absolute.bottom = y + component.height;
+        layout.dirty = false;
+    }
+
+    static void UpdateTree(const Roots& components) {
+        for (const auto& component : components) {
+            Absolute(*component);
+            UpdateTree(component->children);
+        }
+    }
+
+    const Roots& roots_;
+    bool dirty_ = true;
+};
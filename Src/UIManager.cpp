@@ -5,12 +5,101 @@
 #include "UICoordinateFix.h"
 #include <iostream>
 #include <set>
+#include <chrono>
+#include <format>
+#include <functional>
 
 // Factory 函式實作
 std::unique_ptr<IUIManager> CreateUIManager(ITextureManager* textureManager) {
   return std::make_unique<UIManager>(textureManager);
 }
 
+namespace {
+
+UIDrawRect ToDrawRect(const RECT& rect) {
+  return { float(rect.left), float(rect.top), float(rect.right), float(rect.bottom) };
+}
+
+// 以貼圖實際大小換算 UV；source 為 nullptr 時畫整張貼圖
+void RecordTexture(UIDrawList& list, IDirect3DBaseTexture9* texture, const RECT* source, const RECT& dest, D3DCOLOR color) {
+  D3DSURFACE_DESC desc;
+  if (!texture || FAILED(static_cast<IDirect3DTexture9*>(texture)->GetLevelDesc(0, &desc))) return;
+  const RECT full = { 0, 0, LONG(desc.Width), LONG(desc.Height) };
+  list.AddImage(texture, desc.Width, desc.Height, ToDrawRect(source ? *source : full), ToDrawRect(dest), color);
+}
+
+// 以圖片本身的大小畫在 (x, y)，與 ID3DXSprite 不縮放時相同
+void RecordTextureAt(UIDrawList& list, const UITextureRef& ref, IDirect3DBaseTexture9* texture, int x, int y, D3DCOLOR color) {
+  UINT width, height;
+  if (!ref.GetSize(texture, width, height)) return;
+  RecordTexture(list, texture, ref.SourceRect(), RECT{ x, y, x + LONG(width), y + LONG(height) }, color);
+}
+
+} // namespace
+
+IDirect3DBaseTexture9* UITextureRef::Get(ITextureManager* texMgr, const std::wstring& wanted, const UIAtlasLookup* atlas) {
+  const uint32_t generation = atlas ? atlas->generation : 0;
+  if (path == wanted && atlasGeneration == generation) {
+    if (auto* tex = TextureManager::Resolve(handle)) {
+      return tex;
+    }
+    // 只有 TextureManager 會設定 decoding
+    if (decoding) {
+      auto* mgr = static_cast<TextureManager*>(texMgr);
+      if (mgr->IsDecoding(wanted)) {
+        return nullptr;
+      }
+      // PumpUploads 已取走結果：上傳成功時命中快取，失敗時由 Load 同步重試並回報錯誤
+      decoding = false;
+      handle = mgr->Acquire(wanted);
+      return TextureManager::Resolve(handle);
+    }
+  }
+
+  // 慢速路徑：路徑或圖集改變，或 handle 失效
+  path = wanted;
+  handle = {};
+  atlased = false;
+  decoding = false;
+  atlasGeneration = generation;
+  if (atlas) {
+    auto it = atlas->entries.find(wanted);
+    if (it != atlas->entries.end()) {
+      if (auto* page = TextureManager::Resolve(it->second.page)) {
+        handle = it->second.page;
+        source = it->second.source;
+        atlased = true;
+        return page;
+      }
+    }
+  }
+  if (auto* mgr = dynamic_cast<TextureManager*>(texMgr)) {
+    // 尚未載入的貼圖交給背景解碼，上傳完成前先不畫，避免大量圖片卡住同一幀
+    if (mgr->Prefetch(wanted)) {
+      decoding = true;
+      return nullptr;
+    }
+    handle = mgr->Acquire(wanted);
+    return TextureManager::Resolve(handle);
+  }
+  return texMgr->Load(wanted).get();
+}
+
+bool UITextureRef::GetSize(IDirect3DBaseTexture9* texture, UINT& width, UINT& height) const {
+  if (atlased) {
+    width = UINT(source.right - source.left);
+    height = UINT(source.bottom - source.top);
+    return true;
+  }
+  D3DSURFACE_DESC desc;
+  if (!texture || FAILED(static_cast<IDirect3DTexture9*>(texture)->GetLevelDesc(0, &desc))) {
+    return false;
+  }
+  width = desc.Width;
+  height = desc.Height;
+  return true;
+}
+
 UIManager::UIManager(ITextureManager* textureManager) 
   : textureManager_(textureManager) {
   // 創建預設層 (layer 0)
@@ -44,8 +133,15 @@ STDMETHODIMP UIManager::Render(IDirect3DDevice9* dev) {
     return E_POINTER;
   }
   
+  const auto renderStart = std::chrono::steady_clock::now();
+  
+  // 上傳背景解碼完成的貼圖（每幀有時間上限）
+  if (auto* mgr = dynamic_cast<TextureManager*>(textureManager_)) {
+    mgr->PumpUploads();
+  }
   
   SortElementsByLayer();
+  UpdateLayout();
   
   // 保存原始渲染狀態
   DWORD oldAlphaBlend, oldSrcBlend, oldDestBlend;
@@ -61,44 +157,16 @@ STDMETHODIMP UIManager::Render(IDirect3DDevice9* dev) {
   // 關閉 Z 緩衝區以避免 UI 問題
   dev->SetRenderState(D3DRS_ZENABLE, FALSE);
   
-  // 設定顏色鍵 (Color Key) - 綠色透明
-  // 注意: D3DXSprite 不直接支援顏色鍵，需要在載入紋理時處理
-  
-  // 不要設定任何變換矩陣給 D3D 裝置 - 只在 2D UI 中使用
-  // 文字使用的是螢幕空間座標，sprite 也應該一樣
-  
-  // 設定alpha混合狀態 - 不要排序以避免問題
-  sprite_->Begin(D3DXSPRITE_ALPHABLEND | D3DXSPRITE_DONOTSAVESTATE);
-  
-  // 在 Begin 之後設定單位矩陣
-  D3DXMATRIX identityMatrix;
-  D3DXMatrixIdentity(&identityMatrix);
-  sprite_->SetTransform(&identityMatrix);
-  
-  // 診斷輸出視窗和視圖設定 - 已移除以減少噪音
-  
-  // 不要修改 D3D 變換矩陣 - Sprite 在螢幕空間工作
+  // 先依圖層順序記錄到繪製清單，最後合併成少數幾批一次送出
+  drawList_.Clear();
   
   // 渲染圖片元素
-  for (const auto& img : imageElements_) {
+  for (auto& img : imageElements_) {
     if (!img.visible || img.layer >= layers_.size() || !layers_[img.layer].visible) continue;
     
     if (textureManager_) {
-      auto texture = textureManager_->Load(img.imagePath);
+      auto* texture = img.textureRef.Get(textureManager_, img.imagePath, &atlas_);
       if (texture) {
-        // 診斷特定圖片的座標 - 已移除
-        
-        D3DXVECTOR3 pos(float(img.destRect.left), float(img.destRect.top), 0.0f);
-        
-        // 計算縮放
-        D3DSURFACE_DESC desc;
-        if (SUCCEEDED(static_cast<IDirect3DTexture9*>(texture.get())->GetLevelDesc(0, &desc))) {
-          float scaleX = float(img.destRect.right - img.destRect.left) / float(desc.Width);
-          float scaleY = float(img.destRect.bottom - img.destRect.top) / float(desc.Height);
-          
-          // 暫時不使用縮放 - 直接以原始大小顯示
-        }
-        
         // 設定透明度 - 結合圖片顏色和層級透明度
         D3DCOLOR finalColor = img.color;
         if (img.layer < layers_.size()) {
@@ -111,19 +179,14 @@ STDMETHODIMP UIManager::Render(IDirect3DDevice9* dev) {
           finalColor = (img.color & 0x00FFFFFF) | (combinedAlpha << 24);
         }
         
-        sprite_->Draw(static_cast<IDirect3DTexture9*>(texture.get()), 
-                     nullptr, nullptr, &pos, finalColor);
-        
-        // 重設變換
-        D3DXMATRIX identity;
-        D3DXMatrixIdentity(&identity);
-        sprite_->SetTransform(&identity);
+        // 以原始大小顯示，不縮放到 destRect
+        RecordTextureAt(drawList_, img.textureRef, texture, img.destRect.left, img.destRect.top, finalColor);
       }
     }
   }
   
   // 渲染按鈕
-  RenderButtons(dev);
+  RenderButtons();
   
   // 渲染文字元素
   for (const auto& text : textElements_) {
@@ -135,21 +198,37 @@ STDMETHODIMP UIManager::Render(IDirect3DDevice9* dev) {
       finalColor = (finalColor & 0x00FFFFFF) | (alpha << 24);
     }
     
-    RECT rect = text.rect;
-    font_->DrawText(sprite_.Get(), text.text.c_str(), -1, &rect, text.format, finalColor);
+    drawList_.AddText(text.text, text.rect.left, text.rect.top, text.rect.right, text.rect.bottom, text.format, finalColor);
   }
   
-  // 渲染新組件系統（需要在 sprite 內渲染圖片）
-  RenderComponents(dev, rootComponents_);
+  // 渲染新組件系統
+  RenderComponents(rootComponents_);
   
-  sprite_->End();
+  drawList_.Finish();
+  HRESULT hr = batchRenderer_.Draw(dev, sprite_.Get(), font_.Get(), drawList_);
+  if (FAILED(hr)) {
+    std::cerr << "UIManager::Render failed: could not draw UI batches (hr=0x" << std::hex << hr << std::dec << ")" << std::endl;
+  }
   
   // 恢復原始渲染狀態
   dev->SetRenderState(D3DRS_ALPHABLENDENABLE, oldAlphaBlend);
   dev->SetRenderState(D3DRS_SRCBLEND, oldSrcBlend);
   dev->SetRenderState(D3DRS_DESTBLEND, oldDestBlend);
   
-  return S_OK;
+  lastRenderCpuMs_ = std::chrono::duration<double, std::milli>(
+    std::chrono::steady_clock::now() - renderStart).count();
+  return hr;
+}
+
+void UIManager::OnLostDevice() {
+  if (font_) font_->OnLostDevice();
+  if (sprite_) sprite_->OnLostDevice();
+  batchRenderer_.OnLostDevice();
+}
+
+void UIManager::OnResetDevice() {
+  if (font_) font_->OnResetDevice();
+  if (sprite_) sprite_->OnResetDevice();
 }
 
 
@@ -178,12 +257,10 @@ bool UIManager::HandleMessage(const MSG& msg) {
         // 如果有父組件，需要轉換為相對座標
         if (draggedComponent_->parent) {
           RECT parentRect = draggedComponent_->parent->GetAbsoluteRect();
-          draggedComponent_->relativeX = newAbsX - parentRect.left;
-          draggedComponent_->relativeY = newAbsY - parentRect.top;
+          draggedComponent_->SetPosition(newAbsX - parentRect.left, newAbsY - parentRect.top);
         } else {
           // 沒有父組件，直接使用絕對座標
-          draggedComponent_->relativeX = newAbsX;
-          draggedComponent_->relativeY = newAbsY;
+          draggedComponent_->SetPosition(newAbsX, newAbsY);
         }
         
         // 檢查是否有拖放目標
@@ -329,8 +406,7 @@ bool UIManager::HandleMessage(const MSG& msg) {
             
           case DragMode::MoveRevert:
             // 移動但回復模式 - 返回原始位置
-            draggedComponent_->relativeX = draggedComponent_->originalX;
-            draggedComponent_->relativeY = draggedComponent_->originalY;
+            draggedComponent_->SetPosition(draggedComponent_->originalX, draggedComponent_->originalY);
             draggedComponent_->OnDragEnd(false);
             break;
             
@@ -357,6 +433,7 @@ bool UIManager::HandleMessage(const MSG& msg) {
               }
               
               // 從父容器中移除
+              OnComponentRemoved(draggedComponent_);
               if (draggedComponent_->parent) {
                 auto& siblings = draggedComponent_->parent->children;
                 siblings.erase(
@@ -378,8 +455,7 @@ bool UIManager::HandleMessage(const MSG& msg) {
               }
             } else {
               // 拒絕拖放 - 返回原始位置
-              draggedComponent_->relativeX = draggedComponent_->originalX;
-              draggedComponent_->relativeY = draggedComponent_->originalY;
+              draggedComponent_->SetPosition(draggedComponent_->originalX, draggedComponent_->originalY);
               draggedComponent_->OnDragEnd(false);
             }
             break;
@@ -511,6 +587,12 @@ int UIManager::AddImage(const std::wstring& imagePath, int x, int y, int width,
   element.id = nextId_++;
   element.visible = true;
   // draggable parameter is ignored for now - UIImageElement no longer has this property
+  PrefetchTexture(imagePath);
+  if (useTransparency) {
+    RequestAlphaMask(imagePath);
+  }
+  // 原本的判斷對舊式圖片一律檢查透明度
+  AddLegacyHit(element.id, element.destRect, layer, false, true, imagePath);
   imageElements_.push_back(element);
   return element.id;
 }
@@ -520,7 +602,10 @@ void UIManager::ClearLayer(int layer) {
     std::remove_if(textElements_.begin(), textElements_.end(),
       [layer](const UITextElement& e) { return e.layer == layer; }),
     textElements_.end());
-    
+  
+  for (const auto& img : imageElements_) {
+    if (img.layer == layer) RemoveLegacyHit(img.id);
+  }
   imageElements_.erase(
     std::remove_if(imageElements_.begin(), imageElements_.end(),
       [layer](const UIImageElement& e) { return e.layer == layer; }),
@@ -531,6 +616,8 @@ void UIManager::ClearAll() {
   textElements_.clear();
   imageElements_.clear();
   buttons_.clear();
+  legacyHits_.Clear();
+  legacyHitInfo_.clear();
 }
 
 // 按鈕功能實現
@@ -547,6 +634,7 @@ int UIManager::AddButton(const std::wstring& text, int x, int y, int width, int
   button.id = nextId_++;
   button.draggable = draggable;
   button.visible = true;
+  AddLegacyHit(button.id, button.rect, layer, true, false, L"");
   buttons_.push_back(button);
   return button.id;
 }
@@ -564,6 +652,9 @@ int UIManager::AddImageButton(const std::wstring& imagePath, int x, int y, int w
   button.id = nextId_++;
   button.draggable = draggable;
   button.visible = true;
+  PrefetchTexture(imagePath);
+  RequestAlphaMask(imagePath);
+  AddLegacyHit(button.id, button.rect, layer, true, true, imagePath);
   buttons_.push_back(button);
   return button.id;
 }
@@ -572,6 +663,7 @@ void UIManager::SetButtonVisible(int buttonId, bool visible) {
   for (auto& button : buttons_) {
     if (button.id == buttonId) {
       button.visible = visible;
+      if (auto hit = legacyHitInfo_.find(buttonId); hit != legacyHitInfo_.end()) hit->second.visible = visible;
       break;
     }
   }
@@ -581,6 +673,7 @@ void UIManager::SetImageVisible(int imageId, bool visible) {
   for (auto& img : imageElements_) {
     if (img.id == imageId) {
       img.visible = visible;
+      if (auto hit = legacyHitInfo_.find(imageId); hit != legacyHitInfo_.end()) hit->second.visible = visible;
       break;
     }
   }
@@ -595,84 +688,88 @@ bool UIManager::IsPointInTransparentArea(int x, int y, const std::wstring& image
     return true; // 在矩形外視為透明
   }
   
-  // 檢查是否有快取的 alpha 遮罩
+  const AlphaMask* mask = GetAlphaMask(imagePath);
+  if (!mask) {
+    return false; // 無法建立遮罩，視為不透明
+  }
+  
+  // 元件可能被縮放繪製：依比例換算成圖片座標
+  int texX = (x - rect.left) * mask->Width() / (rect.right - rect.left);
+  int texY = (y - rect.top) * mask->Height() / (rect.bottom - rect.top);
+  return !mask->IsOpaque(texX, texY);
+}
+
+void UIManager::RequestAlphaMask(const std::wstring& imagePath) {
+  if (imagePath.empty() || alphaMaskCache_.count(imagePath) != 0) return;
+  if (!alphaMasks_) {
+    alphaMasks_ = std::make_unique<AlphaMaskService>();
+  }
+  alphaMasks_->Request(imagePath);
+}
+
+const AlphaMask* UIManager::GetAlphaMask(const std::wstring& imagePath) {
   auto it = alphaMaskCache_.find(imagePath);
   if (it == alphaMaskCache_.end()) {
-    // 建立 alpha 遮罩
-    BuildAlphaMask(imagePath);
-    it = alphaMaskCache_.find(imagePath);
-    if (it == alphaMaskCache_.end()) {
-      return false; // 無法建立遮罩，視為不透明
+    if (!alphaMasks_) {
+      alphaMasks_ = std::make_unique<AlphaMaskService>();
     }
+    it = alphaMaskCache_.emplace(imagePath, alphaMasks_->Wait(imagePath)).first;
   }
-  
-  const AlphaMask& mask = it->second;
-  
-  // 計算紋理座標
-  float u = float(x - rect.left) / float(rect.right - rect.left);
-  float v = float(y - rect.top) / float(rect.bottom - rect.top);
-  
-  int texX = int(u * mask.width);
-  int texY = int(v * mask.height);
-  
-  if (texX < 0 || texX >= mask.width || texY < 0 || texY >= mask.height) {
-    return true;
+  return it->second.get();
+}
+
+void UIManager::ClearAlphaMaskCache() {
+  alphaMaskCache_.clear();
+  if (alphaMasks_) {
+    alphaMasks_->Clear();
   }
-  
-  // 查詢遮罩
-  int index = texY * mask.width + texX;
-  return !mask.mask[index]; // false = 透明, true = 不透明
 }
 
-int UIManager::GetTopMostElementAt(int x, int y) {
-  // 按層級從高到低檢查所有元素
-  int topMostId = -1;
-  int topMostLayer = -1;
-  
-  // 檢查按鈕
-  for (const auto& button : buttons_) {
-    if (!button.visible) continue;
-    if (button.layer < (int)layers_.size() && !layers_[button.layer].visible) continue;
-    
-    if (x >= button.rect.left && x < button.rect.right && 
-        y >= button.rect.top && y < button.rect.bottom) {
-      if (button.layer > topMostLayer) { // 只考慮更高層級的元素
-        if (button.useBackgroundImage) {
-          if (!IsPointInTransparentArea(x, y, button.backgroundImage, button.rect)) {
-            topMostId = button.id;
-            topMostLayer = button.layer;
-          }
-        } else {
-          topMostId = button.id;
-          topMostLayer = button.layer;
-        }
-      }
-    }
+size_t UIManager::GetAlphaMaskBytes() const {
+  size_t bytes = 0;
+  for (const auto& [path, mask] : alphaMaskCache_) {
+    bytes += mask ? mask->MemoryBytes() : 0;
   }
+  return bytes;
+}
+
+int UIManager::GetTopMostElementAt(int x, int y) {
+  hitCandidates_.clear();
+  legacyHits_.Query(x, y, hitCandidates_);
+  
+  // 層級高的優先；同一層按鈕先於圖片，再依建立順序
+  std::sort(hitCandidates_.begin(), hitCandidates_.end(), [this](uint32_t a, uint32_t b) {
+    const LegacyHit& ha = legacyHitInfo_.at(int(a));
+    const LegacyHit& hb = legacyHitInfo_.at(int(b));
+    if (ha.layer != hb.layer) return ha.layer > hb.layer;
+    if (ha.isButton != hb.isButton) return ha.isButton;
+    return a < b;
+  });
   
-  // 檢查圖片元素
-  for (const auto& img : imageElements_) {
-    if (!img.visible) continue;
-    if (img.layer < (int)layers_.size() && !layers_[img.layer].visible) continue;
-    
-    if (x >= img.destRect.left && x < img.destRect.right && 
-        y >= img.destRect.top && y < img.destRect.bottom) {
-      if (img.layer > topMostLayer) { // 只考慮更高層級的元素
-        if (!IsPointInTransparentArea(x, y, img.imagePath, img.destRect)) {
-          topMostId = img.id;
-          topMostLayer = img.layer;
-        }
-      }
-    }
+  // 只對候選做可見性與透明度檢查，第一個通過的就是最上層
+  for (uint32_t id : hitCandidates_) {
+    const LegacyHit& hit = legacyHitInfo_.at(int(id));
+    if (!hit.visible || hit.layer < 0) continue;
+    if (hit.layer < (int)layers_.size() && !layers_[hit.layer].visible) continue;
+    if (hit.checkTransparency && IsPointInTransparentArea(x, y, hit.imagePath, hit.rect)) continue;
+    return int(id);
   }
-  
-  return topMostId;
+  return -1;
 }
 
-void UIManager::RenderButtons(IDirect3DDevice9* dev) {
-  // 移除重複的調試輸出
-  
-  for (const auto& button : buttons_) {
+void UIManager::AddLegacyHit(int id, const RECT& rect, int layer, bool isButton, bool checkTransparency,
+                             const std::wstring& imagePath) {
+  legacyHitInfo_[id] = {rect, layer, isButton, true, checkTransparency, imagePath};
+  legacyHits_.Insert(uint32_t(id), {rect.left, rect.top, rect.right, rect.bottom});
+}
+
+void UIManager::RemoveLegacyHit(int id) {
+  legacyHits_.Remove(uint32_t(id));
+  legacyHitInfo_.erase(id);
+}
+
+void UIManager::RenderButtons() {
+  for (auto& button : buttons_) {
     if (!button.visible || button.layer >= layers_.size() || !layers_[button.layer].visible) continue;
     
     // 計算最終顏色（考慮層級透明度）
@@ -689,23 +786,10 @@ void UIManager::RenderButtons(IDirect3DDevice9* dev) {
       textColor = (textColor & 0x00FFFFFF) | (txtAlpha << 24);
     }
     
-    // 渲染按鈕背景
+    // 渲染按鈕背景（縮放到按鈕大小）
     if (button.useBackgroundImage && textureManager_) {
-      auto texture = textureManager_->Load(button.backgroundImage);
+      auto* texture = button.textureRef.Get(textureManager_, button.backgroundImage, &atlas_);
       if (texture) {
-        D3DXVECTOR3 pos(float(button.rect.left), float(button.rect.top), 0.0f);
-        
-        // 計算縮放
-        D3DSURFACE_DESC desc;
-        if (SUCCEEDED(static_cast<IDirect3DTexture9*>(texture.get())->GetLevelDesc(0, &desc))) {
-          float scaleX = float(button.rect.right - button.rect.left) / float(desc.Width);
-          float scaleY = float(button.rect.bottom - button.rect.top) / float(desc.Height);
-          
-          D3DXMATRIX scale;
-          D3DXMatrixScaling(&scale, scaleX, scaleY, 1.0f);
-          sprite_->SetTransform(&scale);
-        }
-        
         // 根據按鈕狀態調整顏色
         D3DCOLOR finalColor = backgroundColor;
         if (button.isPressed) {
@@ -714,13 +798,7 @@ void UIManager::RenderButtons(IDirect3DDevice9* dev) {
           finalColor = D3DCOLOR_ARGB((finalColor >> 24) & 0xFF, 255, 255, 200); // 微亮
         }
         
-        sprite_->Draw(static_cast<IDirect3DTexture9*>(texture.get()), 
-                     nullptr, nullptr, &pos, finalColor);
-        
-        // 重設變換
-        D3DXMATRIX identity;
-        D3DXMatrixIdentity(&identity);
-        sprite_->SetTransform(&identity);
+        RecordTexture(drawList_, texture, button.textureRef.SourceRect(), button.rect, finalColor);
       }
     } else {
       // 使用純色背景（簡化實現，可以用矩形繪製）
@@ -728,18 +806,15 @@ void UIManager::RenderButtons(IDirect3DDevice9* dev) {
     }
     
     // 渲染按鈕文字
-    if (!button.text.empty() && font_) {
+    if (!button.text.empty()) {
       RECT textRect = button.rect;
       // 如果按鈕被按下，文字稍微偏移
       if (button.isPressed) {
-        textRect.left += 1;
-        textRect.top += 1;
-        textRect.right += 1;
-        textRect.bottom += 1;
+        OffsetRect(&textRect, 1, 1);
       }
       
-      font_->DrawText(sprite_.Get(), button.text.c_str(), -1, &textRect, 
-                     DT_CENTER | DT_VCENTER | DT_SINGLELINE, textColor);
+      drawList_.AddText(button.text, textRect.left, textRect.top, textRect.right, textRect.bottom,
+                        DT_CENTER | DT_VCENTER | DT_SINGLELINE, textColor);
     }
   }
 }
@@ -775,11 +850,16 @@ void UIManager::SortElementsByLayer() {
 // 新的UI組件系統實現
 // =============================================================================
 
+void UIComponentNew::MarkLayoutDirty() {
+  if (manager) manager->OnComponentLayoutChanged(this);
+  UILayoutCache<UIComponentNew>::Invalidate(*this);
+}
+
 // UIImageNew 實現
-void UIImageNew::Render(IDirect3DDevice9* dev, ID3DXSprite* sprite, ITextureManager* texMgr, ID3DXFont* font) {
+void UIImageNew::Render(UIDrawList& list, ITextureManager* texMgr) {
   if (!visible || !texMgr) return;
   
-  auto texture = texMgr->Load(imagePath);
+  auto* texture = textureRef.Get(texMgr, imagePath, manager ? &manager->GetAtlas() : nullptr);
   if (!texture) return;
   
   RECT absRect = GetAbsoluteRect();
@@ -795,9 +875,6 @@ void UIImageNew::Render(IDirect3DDevice9* dev, ID3DXSprite* sprite, ITextureMana
   //   }
   // }
   
-  // 計算座標位置 - 檢查是否需要偏移調整
-  float renderX = float(absRect.left);
-  float renderY = float(absRect.top);
   
   // 診斷輸出座標轉換和實際紋理大小 - 已關閉
   // if (imagePath == L"bg.png") {
@@ -807,7 +884,7 @@ void UIImageNew::Render(IDirect3DDevice9* dev, ID3DXSprite* sprite, ITextureMana
   //     sprintf_s(debugMsg, "UIImageNew::Render bg.png: relativeXY=(%d,%d), absRect=(%d,%d,%d,%d), renderPos=(%.1f,%.1f)\n",
   //               relativeX, relativeY,
   //               absRect.left, absRect.top, absRect.right, absRect.bottom,
-  //               renderX, renderY);
+  //               float(absRect.left), float(absRect.top));
   //     OutputDebugStringA(debugMsg);
   //     
   //     // 也輸出父元素資訊
@@ -822,11 +899,9 @@ void UIImageNew::Render(IDirect3DDevice9* dev, ID3DXSprite* sprite, ITextureMana
   //   }
   // }
   
-  D3DXVECTOR3 pos(renderX, renderY, 0.0f);
-  
   // 檢查實際紋理大小
   if (imagePath == L"bg.png") {
-    IDirect3DTexture9* tex = static_cast<IDirect3DTexture9*>(texture.get());
+    IDirect3DTexture9* tex = static_cast<IDirect3DTexture9*>(texture);
     D3DSURFACE_DESC desc;
     if (SUCCEEDED(tex->GetLevelDesc(0, &desc))) {
       // 紋理大小調試輸出 - 已移除
@@ -841,8 +916,7 @@ void UIImageNew::Render(IDirect3DDevice9* dev, ID3DXSprite* sprite, ITextureMana
   }
   
   // 直接以原始大小繪製，不進行縮放
-  sprite->Draw(static_cast<IDirect3DTexture9*>(texture.get()), 
-               nullptr, nullptr, &pos, finalColor);
+  RecordTextureAt(list, textureRef, texture, absRect.left, absRect.top, finalColor);
 }
 
 bool UIImageNew::OnMouseDown(int x, int y, bool isRightButton) {
@@ -871,7 +945,7 @@ bool UIImageNew::OnDrop(UIComponentNew* dragged) {
 }
 
 // UIButtonNew 實現  
-void UIButtonNew::Render(IDirect3DDevice9* dev, ID3DXSprite* sprite, ITextureManager* texMgr, ID3DXFont* font) {
+void UIButtonNew::Render(UIDrawList& list, ITextureManager* texMgr) {
   if (!visible) return;
   
   RECT absRect = GetAbsoluteRect();
@@ -885,20 +959,18 @@ void UIButtonNew::Render(IDirect3DDevice9* dev, ID3DXSprite* sprite, ITextureMan
   }
   
   // 根據狀態選擇圖片
-  std::wstring currentImage;
+  const std::wstring* currentImage = &normalImage;
   switch (state) {
-    case State::Hover: currentImage = hoverImage.empty() ? normalImage : hoverImage; break;
-    case State::Pressed: currentImage = pressedImage.empty() ? normalImage : pressedImage; break;
-    case State::Disabled: currentImage = disabledImage.empty() ? normalImage : disabledImage; break;
-    default: currentImage = normalImage; break;
+    case State::Hover: if (!hoverImage.empty()) currentImage = &hoverImage; break;
+    case State::Pressed: if (!pressedImage.empty()) currentImage = &pressedImage; break;
+    case State::Disabled: if (!disabledImage.empty()) currentImage = &disabledImage; break;
+    default: break;
   }
   
   // 渲染背景圖片或純色
-  if (!currentImage.empty() && texMgr) {
-    auto texture = texMgr->Load(currentImage);
+  if (!currentImage->empty() && texMgr) {
+    auto* texture = textureRef.Get(texMgr, *currentImage, manager ? &manager->GetAtlas() : nullptr);
     if (texture) {
-      D3DXVECTOR3 pos(float(absRect.left), float(absRect.top), 0.0f);
-      
       // 暫時不使用縮放 - 先確認座標正確
       
       D3DCOLOR btnColor = backgroundColor;
@@ -908,129 +980,51 @@ void UIButtonNew::Render(IDirect3DDevice9* dev, ID3DXSprite* sprite, ITextureMan
         btnColor = D3DCOLOR_ARGB(255, 255, 255, 200); // 微亮
       }
       
-      sprite->Draw(static_cast<IDirect3DTexture9*>(texture.get()), 
-                   nullptr, nullptr, &pos, btnColor);
-      
-      // 不需要重設變換
+      RecordTextureAt(list, textureRef, texture, absRect.left, absRect.top, btnColor);
     }
   } else {
-    // 渲染純色背景 - 使用虛擬的 1x1 紋理
-    if (sprite && dev) {
-      // 調試輸出
-      static std::set<UIButtonNew*> debuggedButtons;
-      if (debuggedButtons.find(this) == debuggedButtons.end()) {
-        std::wcout << L"Button \"" << text << L"\" rendering solid background" << std::endl;
-        debuggedButtons.insert(this);
-      }
-      
-      // 創建或使用緩存的 1x1 白色紋理
-      static ComPtr<IDirect3DTexture9> s_whiteTexture;
-      if (!s_whiteTexture) {
-        if (SUCCEEDED(dev->CreateTexture(1, 1, 1, 0, D3DFMT_A8R8G8B8, D3DPOOL_MANAGED, &s_whiteTexture, nullptr))) {
-          D3DLOCKED_RECT lockedRect;
-          if (SUCCEEDED(s_whiteTexture->LockRect(0, &lockedRect, nullptr, 0))) {
-            *(DWORD*)lockedRect.pBits = 0xFFFFFFFF; // 純白色
-            s_whiteTexture->UnlockRect(0);
-          }
-        }
-      }
-      
-      if (s_whiteTexture) {
-        // 使用 sprite 渲染純色矩形
-        RECT srcRect = {0, 0, 1, 1};
-        D3DXVECTOR3 pos(float(absRect.left), float(absRect.top), 0.0f);
-        D3DXVECTOR3 scale(float(absRect.right - absRect.left), float(absRect.bottom - absRect.top), 1.0f);
-        
-        // 根據狀態調整顏色
-        D3DCOLOR btnColor = backgroundColor;
-        if (state == State::Pressed) {
-          // 按下時變暗
-          BYTE r = (backgroundColor >> 16) & 0xFF;
-          BYTE g = (backgroundColor >> 8) & 0xFF;
-          BYTE b = backgroundColor & 0xFF;
-          r = r * 128 / 255;
-          g = g * 128 / 255;
-          b = b * 128 / 255;
-          btnColor = D3DCOLOR_ARGB(255, r, g, b);
-        } else if (state == State::Hover) {
-          // 懸停時變亮
-          BYTE r = (backgroundColor >> 16) & 0xFF;
-          BYTE g = (backgroundColor >> 8) & 0xFF;
-          BYTE b = backgroundColor & 0xFF;
-          r = min(255, r * 220 / 192);
-          g = min(255, g * 220 / 192);
-          b = min(255, b * 220 / 192);
-          btnColor = D3DCOLOR_ARGB(255, r, g, b);
-        }
-        
-        // 設置變換矩陣來縮放 1x1 紋理到按鈕大小
-        D3DXMATRIX matScale, matTrans, matWorld;
-        D3DXMatrixScaling(&matScale, scale.x, scale.y, 1.0f);
-        D3DXMatrixTranslation(&matTrans, pos.x, pos.y, 0.0f);
-        matWorld = matScale * matTrans;
-        sprite->SetTransform(&matWorld);
-        
-        sprite->Draw(s_whiteTexture.Get(), &srcRect, nullptr, nullptr, btnColor);
-        
-        // 重置變換
-        D3DXMatrixIdentity(&matWorld);
-        sprite->SetTransform(&matWorld);
-      } else {
-        // 備用方案：使用 DrawPrimitiveUP
-        sprite->End();
-      
-      struct CUSTOMVERTEX {
-        float x, y, z, rhw;
-        D3DCOLOR color;
-      };
-      
-      D3DCOLOR btnColor = backgroundColor;
-      if (state == State::Pressed) {
-        btnColor = D3DCOLOR_ARGB(255, 128, 128, 128); // 變暗
-      } else if (state == State::Hover) {
-        btnColor = D3DCOLOR_ARGB(255, 220, 220, 220); // 微亮
-      }
-      
-      CUSTOMVERTEX vertices[4] = {
-        {float(absRect.left),  float(absRect.top),    0.0f, 1.0f, btnColor},
-        {float(absRect.right), float(absRect.top),    0.0f, 1.0f, btnColor},
-        {float(absRect.right), float(absRect.bottom), 0.0f, 1.0f, btnColor},
-        {float(absRect.left),  float(absRect.bottom), 0.0f, 1.0f, btnColor}
-      };
-      
-      // 保存當前狀態
-      DWORD oldFVF;
-      dev->GetFVF(&oldFVF);
-      DWORD oldAlphaBlend;
-      dev->GetRenderState(D3DRS_ALPHABLENDENABLE, &oldAlphaBlend);
-      
-      // 設置渲染狀態
-      dev->SetRenderState(D3DRS_ALPHABLENDENABLE, TRUE);
-      dev->SetFVF(D3DFVF_XYZRHW | D3DFVF_DIFFUSE);
-      dev->DrawPrimitiveUP(D3DPT_TRIANGLEFAN, 2, vertices, sizeof(CUSTOMVERTEX));
-      
-      // 恢復狀態
-      dev->SetFVF(oldFVF);
-      dev->SetRenderState(D3DRS_ALPHABLENDENABLE, oldAlphaBlend);
-      
-      // 重新開始 sprite
-      sprite->Begin(D3DXSPRITE_ALPHABLEND | D3DXSPRITE_DONOTSAVESTATE);
-      }
+    // 渲染純色背景
+    static std::set<UIButtonNew*> debuggedButtons;
+    if (debuggedButtons.find(this) == debuggedButtons.end()) {
+      std::wcout << L"Button \"" << text << L"\" rendering solid background" << std::endl;
+      debuggedButtons.insert(this);
+    }
+    
+    // 根據狀態調整顏色
+    D3DCOLOR btnColor = backgroundColor;
+    if (state == State::Pressed) {
+      // 按下時變暗
+      BYTE r = (backgroundColor >> 16) & 0xFF;
+      BYTE g = (backgroundColor >> 8) & 0xFF;
+      BYTE b = backgroundColor & 0xFF;
+      r = r * 128 / 255;
+      g = g * 128 / 255;
+      b = b * 128 / 255;
+      btnColor = D3DCOLOR_ARGB(255, r, g, b);
+    } else if (state == State::Hover) {
+      // 懸停時變亮
+      BYTE r = (backgroundColor >> 16) & 0xFF;
+      BYTE g = (backgroundColor >> 8) & 0xFF;
+      BYTE b = backgroundColor & 0xFF;
+      r = min(255, r * 220 / 192);
+      g = min(255, g * 220 / 192);
+      b = min(255, b * 220 / 192);
+      btnColor = D3DCOLOR_ARGB(255, r, g, b);
     }
+    
+    list.AddSolid(ToDrawRect(absRect), btnColor);
   }
   
   // 渲染文字
-  if (font && !text.empty()) {
-    RECT textRect = absRect;
-    
+  if (!text.empty()) {
     // 根據狀態調整文字顏色
     D3DCOLOR finalTextColor = textColor;
     if (state == State::Disabled) {
       finalTextColor = D3DCOLOR_ARGB(255, 128, 128, 128); // 灰色
     }
     
-    font->DrawText(sprite, text.c_str(), -1, &textRect, 
-                   DT_CENTER | DT_VCENTER | DT_SINGLELINE, finalTextColor);
+    list.AddText(text, absRect.left, absRect.top, absRect.right, absRect.bottom,
+                 DT_CENTER | DT_VCENTER | DT_SINGLELINE, finalTextColor);
   }
 }
 
@@ -1068,79 +1062,29 @@ bool UIButtonNew::OnMouseUp(int x, int y, bool isRightButton) {
 }
 
 // UIEditNew 實現
-void UIEditNew::Render(IDirect3DDevice9* dev, ID3DXSprite* sprite, ITextureManager* texMgr, ID3DXFont* font) {
+void UIEditNew::Render(UIDrawList& list, ITextureManager* texMgr) {
   if (!visible) return;
   
   RECT absRect = GetAbsoluteRect();
   
   // 渲染背景圖片或純色
   if (!backgroundImage.empty() && texMgr) {
-    auto texture = texMgr->Load(backgroundImage);
+    auto* texture = textureRef.Get(texMgr, backgroundImage, manager ? &manager->GetAtlas() : nullptr);
     if (texture) {
-      D3DXVECTOR3 pos(float(absRect.left), float(absRect.top), 0.0f);
-      
-      D3DSURFACE_DESC desc;
-      if (SUCCEEDED(static_cast<IDirect3DTexture9*>(texture.get())->GetLevelDesc(0, &desc))) {
-        float scaleX = float(width) / float(desc.Width);
-        float scaleY = float(height) / float(desc.Height);
-        
-        D3DXMATRIX scale;
-        D3DXMatrixScaling(&scale, scaleX, scaleY, 1.0f);
-        sprite->SetTransform(&scale);
-      }
-      
-      sprite->Draw(static_cast<IDirect3DTexture9*>(texture.get()), 
-                   nullptr, nullptr, &pos, backgroundColor);
-      
-      D3DXMATRIX identity;
-      D3DXMatrixIdentity(&identity);
-      sprite->SetTransform(&identity);
+      // 縮放到編輯框大小
+      RecordTexture(list, texture, textureRef.SourceRect(), absRect, backgroundColor);
     }
   } else {
-    // 沒有背景圖片時，渲染純色矩形（使用D3D繪製）
-    if (dev) {
-      // 創建矩形頂點
-      struct CUSTOMVERTEX {
-        float x, y, z, rhw;
-        D3DCOLOR color;
-      };
-      
-      CUSTOMVERTEX vertices[4] = {
-        {float(absRect.left),  float(absRect.top),    0.0f, 1.0f, backgroundColor},
-        {float(absRect.right), float(absRect.top),    0.0f, 1.0f, backgroundColor},
-        {float(absRect.right), float(absRect.bottom), 0.0f, 1.0f, backgroundColor},
-        {float(absRect.left),  float(absRect.bottom), 0.0f, 1.0f, backgroundColor}
-      };
-      
-      // 保存原始狀態
-      DWORD oldFVF;
-      dev->GetFVF(&oldFVF);
-      
-      // 設定FVF和頂點格式
-      dev->SetFVF(D3DFVF_XYZRHW | D3DFVF_DIFFUSE);
-      dev->DrawPrimitiveUP(D3DPT_TRIANGLEFAN, 2, vertices, sizeof(CUSTOMVERTEX));
-      
-      // 恢復FVF
-      dev->SetFVF(oldFVF);
-      
-      // 渲染邊框
-      if (isFocused) {
-        CUSTOMVERTEX border[5] = {
-          {float(absRect.left),  float(absRect.top),    0.0f, 1.0f, borderColor},
-          {float(absRect.right), float(absRect.top),    0.0f, 1.0f, borderColor},
-          {float(absRect.right), float(absRect.bottom), 0.0f, 1.0f, borderColor},
-          {float(absRect.left),  float(absRect.bottom), 0.0f, 1.0f, borderColor},
-          {float(absRect.left),  float(absRect.top),    0.0f, 1.0f, borderColor}
-        };
-        dev->SetFVF(D3DFVF_XYZRHW | D3DFVF_DIFFUSE);
-        dev->DrawPrimitiveUP(D3DPT_LINESTRIP, 4, border, sizeof(CUSTOMVERTEX));
-        dev->SetFVF(oldFVF);
-      }
+    // 沒有背景圖片時，渲染純色矩形
+    list.AddSolid(ToDrawRect(absRect), backgroundColor);
+    
+    // 渲染邊框
+    if (isFocused) {
+      list.AddFrame(ToDrawRect(absRect), borderColor);
     }
   }
   
   // TODO: 渲染邊框、文字和游標
-  // 需要font參數才能渲染文字
 }
 
 bool UIEditNew::OnMouseDown(int x, int y, bool isRightButton) {
@@ -1224,6 +1168,8 @@ UIComponentNew* UIManager::CreateImage(const std::wstring& imagePath, int x, int
   auto image = std::make_unique<UIImageNew>();
   image->id = nextId_++;
   image->imagePath = imagePath;
+  PrefetchTexture(imagePath);
+  RequestAlphaMask(imagePath);
   
   // 從圖片路徑提取檔案名稱作為組件名稱
   size_t lastSlash = imagePath.find_last_of(L"/\\");
@@ -1261,6 +1207,7 @@ UIComponentNew* UIManager::CreateImage(const std::wstring& imagePath, int x, int
   } else {
     rootComponents_.push_back(std::move(image));
   }
+  OnComponentAdded(result);
   
   return result;
 }
@@ -1288,6 +1235,9 @@ UIComponentNew* UIManager::CreateButton(const std::wstring& text, int x, int y,
   button->pressedImage = pressedImage;
   button->disabledImage = disabledImage;
   button->manager = this;  // 設置管理器指針
+  for (const auto* image : { &normalImage, &hoverImage, &pressedImage, &disabledImage }) {
+    PrefetchTexture(*image);
+  }
   
   // 包裝原始的onClick，加入事件通知
   auto originalOnClick = onClick;
@@ -1310,6 +1260,7 @@ UIComponentNew* UIManager::CreateButton(const std::wstring& text, int x, int y,
     rootComponents_.push_back(std::move(button));
     std::wcout << L"Added button \"" << text << L"\" to root components. Total root components: " << rootComponents_.size() << std::endl;
   }
+  OnComponentAdded(result);
   
   return result;
 }
@@ -1334,91 +1285,129 @@ UIComponentNew* UIManager::CreateEdit(int x, int y, int width, int height, UICom
   } else {
     rootComponents_.push_back(std::move(edit));
   }
+  OnComponentAdded(result);
   
   return result;
 }
 
-// 智能事件委派 - 遞歸查找滑鼠下的組件，考慮透明度
+// 智能事件委派 - 從空間索引取得滑鼠下的組件，考慮透明度
 UIComponentNew* UIManager::GetComponentAt(int x, int y) {
-  
-  std::function<UIComponentNew*(const std::vector<std::unique_ptr<UIComponentNew>>&)> findComponent;
-  
-  findComponent = [&](const std::vector<std::unique_ptr<UIComponentNew>>& components) -> UIComponentNew* {
-    // 反向遍歷，因為後添加的在上層
-    for (auto it = components.rbegin(); it != components.rend(); ++it) {
-      auto& comp = *it;
-      if (!comp->visible) continue;
-      
-      RECT rect = comp->GetAbsoluteRect();
-      
-      // 對 bg.png 的特殊調試 - 已移除
-      
-      if (x >= rect.left && x < rect.right && y >= rect.top && y < rect.bottom) {
-        // 先檢查子組件
-        UIComponentNew* child = findComponent(comp->children);
-        if (child) return child;
-        
-        // 檢查當前組件是否在透明區域 (只對圖片組件檢查)
-        if (auto* img = dynamic_cast<UIImageNew*>(comp.get())) {
-          if (img->useTransparency && IsPointInTransparentArea(x, y, img->imagePath, rect)) {
-            // b-kuang.png 透明區域調試 - 已移除
-            continue; // 在透明區域，跳過此組件
-          }
-          // b-kuang.png 非透明區域調試 - 已移除
-        }
-        
-        // 沒有子組件被點擊且不在透明區域，返回此組件
-        return comp.get();
+  // 候選已依 z 順序排好（子組件在父組件之前，後添加的在前），只對它們檢查透明度
+  for (uint32_t slot : QueryComponentHits(x, y)) {
+    UIComponentNew* comp = componentHitSlots_[slot].component;
+    
+    // 檢查當前組件是否在透明區域 (只對圖片組件檢查)
+    if (auto* img = dynamic_cast<UIImageNew*>(comp)) {
+      if (img->useTransparency && IsPointInTransparentArea(x, y, img->imagePath, comp->GetAbsoluteRect())) {
+        continue; // 在透明區域，跳過此組件
       }
     }
-    return nullptr;
-  };
-  
-  return findComponent(rootComponents_);
+    return comp;
+  }
+  return nullptr;
 }
 
 UIComponentNew* UIManager::GetDraggableComponentAt(int x, int y) {
-  std::function<UIComponentNew*(const std::vector<std::unique_ptr<UIComponentNew>>&)> findComponent;
+  for (uint32_t slot : QueryComponentHits(x, y)) {
+    UIComponentNew* comp = componentHitSlots_[slot].component;
+    if (!comp->IsDraggable()) continue;
+    
+    if (auto* img = dynamic_cast<UIImageNew*>(comp)) {
+      // 如果不允許從透明區域拖曳，則需要檢查透明度
+      if (!img->allowDragFromTransparent && img->useTransparency &&
+          IsPointInTransparentArea(x, y, img->imagePath, comp->GetAbsoluteRect())) {
+        continue;
+      }
+    }
+    return comp;
+  }
+  return nullptr;
+}
+
+void UIManager::OnComponentLayoutChanged(UIComponentNew* component) {
+  layout_.MarkDirty();
+  if (!hitIndexDirty_) {
+    movedComponents_.push_back(component);
+  }
+}
+
+void UIManager::OnComponentAdded(UIComponentNew* component) {
+  componentIndex_.AddTree(component);
+  InvalidateHitIndex();
+}
+
+void UIManager::OnComponentRemoved(UIComponentNew* component) {
+  componentIndex_.RemoveTree(component);
+  InvalidateHitIndex();
+}
+
+void UIManager::InvalidateHitIndex() {
+  layout_.MarkDirty();
+  hitIndexDirty_ = true;
+  movedComponents_.clear();
+}
+
+void UIManager::RebuildComponentHitIndex() {
+  componentHits_.Clear();
+  componentHitSlots_.clear();
+  componentHitSlot_.clear();
+  
+  std::function<void(const std::vector<std::unique_ptr<UIComponentNew>>&, uint32_t)> assign =
+    [&](const std::vector<std::unique_ptr<UIComponentNew>>& components, uint32_t parent) {
+      for (const auto& comp : components) {
+        const uint32_t slot = uint32_t(componentHitSlots_.size());
+        componentHitSlots_.push_back({comp.get(), parent, 0, {}});
+        componentHitSlot_[comp.get()] = slot;
+        assign(comp->children, slot);
+        componentHitSlots_[slot].end = uint32_t(componentHitSlots_.size());
+      }
+    };
+  assign(rootComponents_, kNoHitSlot);
   
-  findComponent = [&](const std::vector<std::unique_ptr<UIComponentNew>>& components) -> UIComponentNew* {
-    // 反向遍歷，因為後添加的在上層
-    for (auto it = components.rbegin(); it != components.rend(); ++it) {
-      auto& comp = *it;
-      if (!comp->visible) continue;
-      
-      RECT rect = comp->GetAbsoluteRect();
-      
-      if (x >= rect.left && x < rect.right && y >= rect.top && y < rect.bottom) {
-        
-        // 先檢查子組件是否有可拖曳的
-        UIComponentNew* draggableChild = findComponent(comp->children);
-        if (draggableChild) {
-          return draggableChild;
-        }
-        
-        // 如果沒有可拖曳的子組件，檢查當前組件是否可拖曳
-        if (comp->IsDraggable()) {
-          if (auto* img = dynamic_cast<UIImageNew*>(comp.get())) {
-            // 如果不允許從透明區域拖曳，則需要檢查透明度
-            if (!img->allowDragFromTransparent && img->useTransparency && 
-                IsPointInTransparentArea(x, y, img->imagePath, rect)) {
-              // 在透明區域且不允許從透明區域拖曳
-              // 不返回這個組件，繼續檢查其他組件
-            } else {
-              // 找到可拖曳組件
-              return comp.get();
-            }
-          } else {
-            // 不是圖片組件，直接返回
-            return comp.get();
-          }
-        }
+  UpdateComponentHits(0, uint32_t(componentHitSlots_.size()));
+  hitIndexDirty_ = false;
+}
+
+void UIManager::UpdateComponentHits(uint32_t first, uint32_t end) {
+  // 前序排列：父組件的 clip 一定已經更新過
+  for (uint32_t slot = first; slot < end; ++slot) {
+    ComponentHit& hit = componentHitSlots_[slot];
+    const RECT rect = hit.component->GetAbsoluteRect();
+    if (hit.parent == kNoHitSlot) {
+      hit.clip = rect;
+    } else if (!IntersectRect(&hit.clip, &rect, &componentHitSlots_[hit.parent].clip)) {
+      hit.clip = {0, 0, 0, 0};
+    }
+    componentHits_.Update(slot, {hit.clip.left, hit.clip.top, hit.clip.right, hit.clip.bottom});
+  }
+}
+
+const std::vector<uint32_t>& UIManager::QueryComponentHits(int x, int y) {
+  if (hitIndexDirty_) {
+    RebuildComponentHitIndex();
+  } else {
+    for (UIComponentNew* moved : movedComponents_) {
+      auto it = componentHitSlot_.find(moved);
+      if (it != componentHitSlot_.end()) {
+        UpdateComponentHits(it->second, componentHitSlots_[it->second].end);
       }
     }
-    return nullptr;
-  };
+  }
+  movedComponents_.clear();
   
-  return findComponent(rootComponents_);
+  hitCandidates_.clear();
+  componentHits_.Query(x, y, hitCandidates_);
+  
+  // 隱藏的組件連同子組件都不接收滑鼠
+  auto hidden = [this](uint32_t slot) {
+    for (; slot != kNoHitSlot; slot = componentHitSlots_[slot].parent) {
+      if (!componentHitSlots_[slot].component->visible) return true;
+    }
+    return false;
+  };
+  hitCandidates_.erase(std::remove_if(hitCandidates_.begin(), hitCandidates_.end(), hidden), hitCandidates_.end());
+  std::sort(hitCandidates_.begin(), hitCandidates_.end(), std::greater<uint32_t>());
+  return hitCandidates_;
 }
 
 void UIManager::SetFocusedComponent(UIComponentNew* component) {
@@ -1439,7 +1428,11 @@ void UIManager::SetFocusedComponent(UIComponentNew* component) {
   }
 }
 
-void UIManager::RenderComponents(IDirect3DDevice9* dev, const std::vector<std::unique_ptr<UIComponentNew>>& components) {
+void UIManager::UpdateLayout() {
+  layout_.Update();
+}
+
+void UIManager::RenderComponents(const std::vector<std::unique_ptr<UIComponentNew>>& components) {
   static bool firstRender = true;
   if (firstRender && &components == &rootComponents_) {
     std::cout << "UIManager: Rendering " << components.size() << " root components" << std::endl;
@@ -1448,121 +1441,121 @@ void UIManager::RenderComponents(IDirect3DDevice9* dev, const std::vector<std::u
   
   for (const auto& comp : components) {
     if (comp->visible) {
-      comp->Render(dev, sprite_.Get(), textureManager_, font_.Get());
+      comp->Render(drawList_, textureManager_);
       
       // 遞歸渲染子組件
-      RenderComponents(dev, comp->children);
+      RenderComponents(comp->children);
     }
   }
 }
 
-// 建立 Alpha 遮罩
-void UIManager::BuildAlphaMask(const std::wstring& imagePath) const {
-  if (!textureManager_) return;
-  
-  try {
-    auto texture = textureManager_->Load(imagePath);
-    if (!texture) return;
-    
-    IDirect3DTexture9* tex = static_cast<IDirect3DTexture9*>(texture.get());
-    D3DSURFACE_DESC desc;
-    if (FAILED(tex->GetLevelDesc(0, &desc))) return;
-    
-    AlphaMask mask;
-    mask.width = desc.Width;
-    mask.height = desc.Height;
-    mask.mask.resize(desc.Width * desc.Height, true); // 預設為不透明
-    
-    // 獲取surface以讀取像素數據
-    ComPtr<IDirect3DSurface9> surface;
-    if (SUCCEEDED(tex->GetSurfaceLevel(0, &surface))) {
-      D3DLOCKED_RECT lockedRect;
-      
-      if (SUCCEEDED(surface->LockRect(&lockedRect, nullptr, D3DLOCK_READONLY))) {
-        // 判斷是 BMP 還是 PNG
-        bool isBMP = imagePath.find(L".bmp") != std::wstring::npos;
-        bool isPNG = imagePath.find(L".png") != std::wstring::npos;
-        
-        // 根據格式讀取像素
-        for (UINT y = 0; y < desc.Height; y++) {
-          DWORD* row = (DWORD*)((BYTE*)lockedRect.pBits + y * lockedRect.Pitch);
-          
-          for (UINT x = 0; x < desc.Width; x++) {
-            DWORD pixel = row[x];
-            
-            bool isTransparent = false;
-            
-            if (isBMP) {
-              // BMP: 檢查綠色色鍵
-              BYTE r = (pixel >> 16) & 0xFF;
-              BYTE g = (pixel >> 8) & 0xFF;
-              BYTE b = pixel & 0xFF;
-              
-              // 綠色色鍵檢測：綠色較高，紅藍較低
-              if (g > 200 && r < 100 && b < 100) {
-                isTransparent = true;
-              }
-            } else if (isPNG) {
-              // PNG: 檢查 alpha 通道
-              BYTE alpha = (pixel >> 24) & 0xFF;
-              if (alpha < 32) { // 只有幾乎完全透明的像素才視為透明（alpha < 12.5%）
-                isTransparent = true;
-              }
-            }
-            
-            int index = y * desc.Width + x;
-            mask.mask[index] = !isTransparent;
-          }
+void UIManager::PrefetchTexture(const std::wstring& imagePath) const {
+  if (imagePath.empty()) return;
+  if (auto* mgr = dynamic_cast<TextureManager*>(textureManager_)) {
+    mgr->Prefetch(imagePath);
+  }
+}
+
+std::vector<std::wstring> UIManager::CollectImagePaths() const {
+  std::vector<std::wstring> paths;
+  for (const auto& img : imageElements_) {
+    paths.push_back(img.imagePath);
+  }
+  for (const auto& button : buttons_) {
+    if (button.useBackgroundImage) {
+      paths.push_back(button.backgroundImage);
+    }
+  }
+  std::function<void(const std::vector<std::unique_ptr<UIComponentNew>>&)> collect =
+    [&](const std::vector<std::unique_ptr<UIComponentNew>>& components) {
+      for (const auto& comp : components) {
+        if (auto* image = dynamic_cast<const UIImageNew*>(comp.get())) {
+          paths.push_back(image->imagePath);
+        } else if (auto* button = dynamic_cast<const UIButtonNew*>(comp.get())) {
+          paths.insert(paths.end(), { button->normalImage, button->hoverImage, button->pressedImage, button->disabledImage });
+        } else if (auto* edit = dynamic_cast<const UIEditNew*>(comp.get())) {
+          paths.push_back(edit->backgroundImage);
         }
-        
-        surface->UnlockRect();
+        collect(comp->children);
       }
+    };
+  collect(rootComponents_);
+  std::erase_if(paths, [](const std::wstring& path) { return path.empty(); });
+  return paths;
+}
+
+size_t UIManager::BuildAtlas(std::vector<std::wstring> images, const UIAtlasOptions& options) {
+  auto* mgr = dynamic_cast<TextureManager*>(textureManager_);
+  if (!mgr) return 0;
+  if (images.empty()) {
+    images = CollectImagePaths();
+  }
+
+  UIAtlas atlas = BuildUIAtlas(images, options);
+  std::vector<TextureHandle> pages;
+  try {
+    for (size_t page = 0; page < atlas.pages.size(); ++page) {
+      pages.push_back(mgr->CreateFromImage(std::format("<ui-atlas>/{}", page), atlas.pages[page]));
     }
-    
-    // 計算透明像素的百分比
-    int transparentCount = 0;
-    for (bool opaque : mask.mask) {
-      if (!opaque) transparentCount++;
-    }
-    float transparentPercent = (float)transparentCount / (mask.width * mask.height) * 100.0f;
-    
-    // 存入快取
-    alphaMaskCache_[imagePath] = std::move(mask);
-    
-    // Alpha mask 建立成功 - 調試輸出已移除
-    
-  } catch (...) {
-    // 錯誤處理
+  } catch (const std::exception& e) {
+    std::cerr << "UIManager::BuildAtlas: " << e.what() << std::endl;
+    return 0;
   }
+  SetAtlas(atlas, pages);
+  return atlas.sprites.size();
 }
 
-// 遞歸查找組件的輔助函數
-UIComponentNew* FindComponentInTree(const std::vector<std::unique_ptr<UIComponentNew>>& components, 
-                                   std::function<bool(UIComponentNew*)> predicate) {
-  for (const auto& comp : components) {
-    if (predicate(comp.get())) {
-      return comp.get();
-    }
-    
-    // 遞歸搜索子組件
-    UIComponentNew* found = FindComponentInTree(comp->children, predicate);
-    if (found) {
-      return found;
+size_t UIManager::LoadAtlas(const std::filesystem::path& manifest) {
+  auto* mgr = dynamic_cast<TextureManager*>(textureManager_);
+  if (!mgr) return 0;
+
+  try {
+    UIAtlas atlas = ReadUIAtlas(manifest);
+    std::vector<TextureHandle> pages;
+    for (const auto& file : atlas.pageFiles) {
+      pages.push_back(mgr->Acquire(file));
     }
+    SetAtlas(atlas, pages);
+    return atlas.sprites.size();
+  } catch (const std::exception& e) {
+    std::cerr << "UIManager::LoadAtlas: " << e.what() << std::endl;
+    return 0;
   }
-  return nullptr;
+}
+
+void UIManager::ClearAtlas() {
+  atlas_.entries.clear();
+  atlas_.generation++;
+}
+
+void UIManager::SetAtlas(const UIAtlas& atlas, const std::vector<TextureHandle>& pages) {
+  atlas_.entries.clear();
+  for (const auto& [path, sprite] : atlas.sprites) {
+    const AtlasRect& r = sprite.rect;
+    atlas_.entries[path] = { pages[sprite.page], RECT{ r.x, r.y, r.x + r.width, r.y + r.height } };
+  }
+  // 已取得個別貼圖的參照在下一次 Get 時改查圖集
+  atlas_.generation++;
+}
+
+void UIManager::SetComponentName(UIComponentNew* component, const std::wstring& name) {
+  if (component) componentIndex_.Rename(component, name);
+}
+
+void UIManager::SetComponentId(UIComponentNew* component, int id) {
+  if (component) componentIndex_.Renumber(component, id);
 }
 
 UIComponentNew* UIManager::FindComponentByName(const std::wstring& name) {
-  return FindComponentInTree(rootComponents_, [&name](UIComponentNew* comp) {
-    return comp->name == name;
-  });
+  return componentIndex_.FindByName(name);
 }
 
 UIComponentNew* UIManager::FindComponentById(int id) {
-  return FindComponentInTree(rootComponents_, [id](UIComponentNew* comp) {
-    return comp->id == id;
-  });
+  return componentIndex_.FindById(id);
+}
+
+bool UIManager::ValidateComponentIndex() const {
+  return componentIndex_.Validate(std::wcerr);
 }
 
 // UI事件監聽器管理
@@ -1604,6 +1597,8 @@ void UIManager::AddComponent(std::unique_ptr<UIComponentNew> component) {
   
   // 設置管理器指針
   component->manager = this;
+  component->MarkLayoutDirty();
+  OnComponentAdded(component.get());
   
   // 如果有父元件，添加到父元件的children中
   if (component->parent) {
@@ -1,6 +1,14 @@
 ﻿#pragma once
 #include "IUIManager.h"
 #include "ITextureManager.h"
+#include "TextureManager.h"
+#include "UIAtlas.h"
+#include "AlphaMask.h"
+#include "UIDrawList.h"
+#include "UIBatchRenderer.h"
+#include "UIHitGrid.h"
+#include "UIComponentIndex.h"
+#include "UILayoutCache.h"
 #include <vector>
 #include <string>
 #include <functional>
@@ -27,8 +35,39 @@ struct UITextElement {
   int layer;
 };
 
+// 執行期的 UI 圖集：圖片路徑 -> 頁面貼圖與來源矩形
+struct UIAtlasLookup {
+  struct Entry {
+    TextureHandle page;
+    RECT source;
+  };
+  std::unordered_map<std::wstring, Entry> entries;
+  uint32_t generation = 0;   // 每次載入或清除圖集遞增，UITextureRef 依此重新查詢
+};
+
+// 元件持有的貼圖參照：第一次使用時取得 handle，之後每幀只做 handle 解析
+// 路徑變更、圖集改變或 handle 失效（貼圖被清除或熱重載）時才會重新向 TextureManager 取得
+// 圖片在圖集中時回傳頁面貼圖，繪製時需以 SourceRect() 為來源矩形
+struct UITextureRef {
+  std::wstring path;
+  TextureHandle handle;
+  RECT source = {};
+  bool atlased = false;
+  bool decoding = false;     // 已排入背景解碼：之後每幀只查詢是否上傳完成，不再重新排入
+  uint32_t atlasGeneration = 0;
+
+  IDirect3DBaseTexture9* Get(ITextureManager* texMgr, const std::wstring& wanted, const UIAtlasLookup* atlas = nullptr);
+
+  // 傳給 ID3DXSprite::Draw 的來源矩形；不在圖集中時為 nullptr（整張貼圖）
+  const RECT* SourceRect() const { return atlased ? &source : nullptr; }
+
+  // 圖片本身的寬高（在圖集中時為來源矩形的大小）
+  bool GetSize(IDirect3DBaseTexture9* texture, UINT& width, UINT& height) const;
+};
+
 struct UIImageElement {
   std::wstring imagePath;
+  UITextureRef textureRef;
   RECT destRect;
   D3DCOLOR color;
   bool useTransparency;
@@ -47,6 +86,7 @@ struct UIComponentNew {
   std::wstring name;  // 組件名稱，用於查找
   int relativeX, relativeY;  // 相對於父組件的座標
   int width, height;
+  // 直接修改座標、大小或 parent 後要呼叫 MarkLayoutDirty()，或改用 SetPosition/SetSize
   bool visible = true;
   bool enabled = true;
   
@@ -54,17 +94,14 @@ struct UIComponentNew {
   std::vector<std::unique_ptr<UIComponentNew>> children;
   UIManager* manager = nullptr;  // 指向所屬的UIManager，用於發送事件
   
-  // 計算絕對座標
-  virtual RECT GetAbsoluteRect() const {
-    int absX = relativeX;
-    int absY = relativeY;
-    if (parent) {
-      RECT parentRect = parent->GetAbsoluteRect();
-      absX += parentRect.left;
-      absY += parentRect.top;
-    }
-    return {absX, absY, absX + width, absY + height};
-  }
+  // 絕對座標：快取有效時直接回傳，否則只沿著失效的父組件往上重算（見 UILayoutCache）
+  RECT GetAbsoluteRect() const { return UILayoutCache<UIComponentNew>::Absolute(*this); }
+  
+  void SetPosition(int x, int y) { relativeX = x; relativeY = y; MarkLayoutDirty(); }
+  void SetSize(int w, int h) { width = w; height = h; MarkLayoutDirty(); }
+  
+  // 讓自己與所有子組件的絕對座標快取失效，下次使用或 UIManager::UpdateLayout 時重算
+  void MarkLayoutDirty();
   
   // 事件處理 - 只有當滑鼠在此組件上時才會被調用
   virtual bool OnMouseMove(int x, int y) { return false; }
@@ -89,20 +126,26 @@ struct UIComponentNew {
   int originalX = 0;
   int originalY = 0;
   
-  virtual void Render(IDirect3DDevice9* dev, ID3DXSprite* sprite, ITextureManager* texMgr, ID3DXFont* font = nullptr) = 0;
+  // 只記錄到繪製清單，由 UIManager 合併成批次後一次送出
+  virtual void Render(UIDrawList& list, ITextureManager* texMgr) = 0;
   
   virtual ~UIComponentNew() = default;
+  
+private:
+  friend class UILayoutCache<UIComponentNew>;
+  mutable UILayoutState<RECT> layout_;
 };
 
 // 圖片組件
 struct UIImageNew : public UIComponentNew {
   std::wstring imagePath;
+  UITextureRef textureRef;
   D3DCOLOR color = 0xFFFFFFFF;
   bool useTransparency = true;
   bool allowDragFromTransparent = false;  // 是否允許從透明區域拖曳，預設為false
   bool canReceiveDrop = false;  // 是否可接收拖放
   
-  void Render(IDirect3DDevice9* dev, ID3DXSprite* sprite, ITextureManager* texMgr, ID3DXFont* font = nullptr) override;
+  void Render(UIDrawList& list, ITextureManager* texMgr) override;
   bool OnMouseDown(int x, int y, bool isRightButton) override;
   
   // 拖放實現
@@ -121,6 +164,7 @@ struct UIButtonNew : public UIComponentNew {
   std::wstring hoverImage; 
   std::wstring pressedImage;
   std::wstring disabledImage;
+  UITextureRef textureRef;   // 目前狀態使用的圖片
   
   // 狀態
   enum class State { Normal, Hover, Pressed, Disabled } state = State::Normal;
@@ -131,7 +175,7 @@ struct UIButtonNew : public UIComponentNew {
   
   std::function<void()> onClick;
   
-  void Render(IDirect3DDevice9* dev, ID3DXSprite* sprite, ITextureManager* texMgr, ID3DXFont* font = nullptr) override;
+  void Render(UIDrawList& list, ITextureManager* texMgr) override;
   bool OnMouseMove(int x, int y) override;
   bool OnMouseDown(int x, int y, bool isRightButton) override;
   bool OnMouseUp(int x, int y, bool isRightButton) override;
@@ -141,6 +185,7 @@ struct UIButtonNew : public UIComponentNew {
 struct UIEditNew : public UIComponentNew {
   std::wstring text;
   std::wstring backgroundImage;
+  UITextureRef textureRef;
   D3DCOLOR textColor = 0xFF000000;
   D3DCOLOR backgroundColor = 0xFFFFFFFF;
   D3DCOLOR borderColor = 0xFF808080;
@@ -149,7 +194,7 @@ struct UIEditNew : public UIComponentNew {
   int cursorPos = 0;
   int maxLength = 256;
   
-  void Render(IDirect3DDevice9* dev, ID3DXSprite* sprite, ITextureManager* texMgr, ID3DXFont* font = nullptr) override;
+  void Render(UIDrawList& list, ITextureManager* texMgr) override;
   bool OnMouseDown(int x, int y, bool isRightButton) override;
   bool OnKeyDown(WPARAM key) override;
   bool OnChar(WPARAM ch) override;
@@ -191,6 +236,7 @@ struct UIContainer {
 struct UIButton {
   std::wstring text;
   std::wstring backgroundImage;
+  UITextureRef textureRef;
   RECT rect;
   D3DCOLOR textColor;
   D3DCOLOR backgroundColor;
@@ -211,6 +257,24 @@ public:
   HRESULT Init(IDirect3DDevice9* dev) override;
   HRESULT Render(IDirect3DDevice9* dev) override;
 
+  // 上一次 Render 花費的 CPU 時間（毫秒），用於比較 UI 繪製成本
+  double GetLastRenderCpuMs() const { return lastRenderCpuMs_; }
+  
+  // 由上而下重算所有失效組件的絕對座標；Render 開始時呼叫，沒有組件失效時不走訪
+  void UpdateLayout();
+  // 組件的座標、大小或父組件改變時由 UIComponentNew::MarkLayoutDirty 呼叫
+  void OnComponentLayoutChanged(UIComponentNew* component);
+  
+  // 上一次 Render 的四邊形、文字、批次與繪製呼叫數
+  const UIDrawStats& GetLastDrawStats() const { return batchRenderer_.LastStats(); }
+  
+  // 裝置 Reset 前後呼叫，釋放與重建 D3DPOOL_DEFAULT 資源（字型、sprite、UI 動態頂點緩衝）
+  // 目前沒有呼叫端：EngineContext 不處理裝置遺失，ID3DContext::Reset 也沒有被呼叫，
+  // 且 EffectManager、FullScreenQuad 的 ID3DXEffect 尚無對應的釋放與重建；加入裝置遺失處理時，
+  // 在 TestCooperativeLevel 回傳 D3DERR_DEVICENOTRESET 後先呼叫 OnLostDevice，Reset 成功後再呼叫 OnResetDevice
+  void OnLostDevice();
+  void OnResetDevice();
+
   bool HandleMessage(const MSG& msg) override;
   void RegisterUIListener(IUIInputListener* listener) override {
     uiListeners_.push_back(listener);
@@ -265,12 +329,33 @@ public:
   bool GetImageSize(const std::wstring& imagePath, int& width, int& height) const;
   
   // 清除透明度快取（用於調試）
-  void ClearAlphaMaskCache() { alphaMaskCache_.clear(); }
+  void ClearAlphaMaskCache();
+  
+  // 目前快取的透明度遮罩數量與佔用的位元組
+  size_t GetAlphaMaskCount() const { return alphaMaskCache_.size(); }
+  size_t GetAlphaMaskBytes() const;
   
-  // 按名稱或ID查找組件
+  // 把 UI 圖片打包成圖集頁面，之後這些圖片改從頁面繪製，相鄰的圖片可以併成同一批
+  // images 為空時打包目前所有元件與舊式元素用到的圖片；回傳放入圖集的圖片數，無法使用圖集時回傳 0
+  size_t BuildAtlas(std::vector<std::wstring> images = {}, const UIAtlasOptions& options = {});
+  
+  // 載入建置時以 WriteUIAtlas 輸出的圖集；回傳圖集中的圖片數，失敗時回傳 0 並保留原本的圖集
+  size_t LoadAtlas(const std::filesystem::path& manifest);
+  
+  void ClearAtlas();
+  const UIAtlasLookup& GetAtlas() const { return atlas_; }
+  
+  // 按名稱或ID查找組件（雜湊索引，名稱或ID重複時回傳組件樹前序走訪中最先遇到的）
   UIComponentNew* FindComponentByName(const std::wstring& name) override;
   UIComponentNew* FindComponentById(int id) override;
   
+  // 已加入的組件要改名稱或ID時透過這裡，索引才會跟著更新
+  void SetComponentName(UIComponentNew* component, const std::wstring& name);
+  void SetComponentId(UIComponentNew* component, int id);
+  
+  // 調試用：比對索引與組件樹，不一致時輸出到 stderr 並回傳 false
+  bool ValidateComponentIndex() const;
+  
   // 模板方法：按名稱查找特定類型的組件
   template<typename T>
   T* FindComponentByName(const std::wstring& name) {
@@ -299,16 +384,24 @@ public:
   UIComponentNew* GetDropTarget() const { return dropTarget_; }
 
 private:
-  // Alpha 遮罩快取結構 - 避免每次都鎖定紋理
-  struct AlphaMask {
-    int width;
-    int height;
-    std::vector<bool> mask;  // true = 不透明, false = 透明
-  };
-  mutable std::unordered_map<std::wstring, AlphaMask> alphaMaskCache_;
+  // Alpha 遮罩快取：點擊測試只在裝置執行緒進行，這裡不取鎖；nullptr 表示無法建立，視為整張不透明
+  std::unordered_map<std::wstring, std::shared_ptr<const AlphaMask>> alphaMaskCache_;
+  // 第一次排入遮罩時建立
+  std::unique_ptr<AlphaMaskService> alphaMasks_;
+  
+  // 建立元件時把需要點擊測試的圖片排入背景建立遮罩
+  void RequestAlphaMask(const std::wstring& imagePath);
+  // 取得遮罩；背景尚未完成時等待或在目前執行緒建立
+  const AlphaMask* GetAlphaMask(const std::wstring& imagePath);
+  
+  // 建立元件時先把圖片排入背景解碼，第一次繪製時多半已上傳完成
+  void PrefetchTexture(const std::wstring& imagePath) const;
   
-  // 建立 Alpha 遮罩
-  void BuildAlphaMask(const std::wstring& imagePath) const;
+  // 目前元件樹與舊式元素引用的所有圖片路徑
+  std::vector<std::wstring> CollectImagePaths() const;
+  
+  // 以頁面 handle 取代目前的圖集
+  void SetAtlas(const UIAtlas& atlas, const std::vector<TextureHandle>& pages);
   
 private:
   std::vector<IUIInputListener*> uiListeners_;
@@ -330,6 +423,7 @@ private:
   UIComponentNew* hoveredComponent_ = nullptr;
   UIComponentNew* draggedComponent_ = nullptr;
   UIComponentNew* pressedComponent_ = nullptr;  // Track which component is pressed
+  UILayoutCache<UIComponentNew> layout_{ rootComponents_ };  // 有組件的絕對座標快取失效時才走訪
   
   // 交互狀態
   int nextId_ = 0;
@@ -344,8 +438,60 @@ private:
   
   // UI事件監聽器列表
   std::vector<IUIListener*> uiEventListeners_;
+
+  double lastRenderCpuMs_ = 0.0;
+  
+  UIAtlasLookup atlas_;
+  
+  // 每幀重複使用的繪製清單與批次繪製器
+  UIDrawList drawList_;
+  UIBatchRenderer batchRenderer_;
+  
+  // 點擊測試的空間索引：組件以前序走訪順序編號（slot），編號愈大愈上層，子樹佔連續的 slot
+  // 登記的矩形是組件與所有祖先矩形的交集，與原本「點要落在每一層父組件內」的遞迴判斷相同
+  // 新增或刪除組件時整個重建；移動只更新該組件的子樹；可見性在查詢時對候選判斷
+  struct ComponentHit {
+    UIComponentNew* component;
+    uint32_t parent;   // 父組件的 slot，根組件為 kNoHitSlot
+    uint32_t end;      // 子樹之後的第一個 slot
+    RECT clip;
+  };
+  static constexpr uint32_t kNoHitSlot = UINT32_MAX;
+  UIHitGrid componentHits_;
+  std::vector<ComponentHit> componentHitSlots_;
+  std::unordered_map<const UIComponentNew*, uint32_t> componentHitSlot_;
+  std::vector<UIComponentNew*> movedComponents_;
+  bool hitIndexDirty_ = true;
+  
+  // 舊式按鈕與圖片依 ID 登記；SortElementsByLayer 每幀重排陣列，所以點擊測試需要的資料另存一份
+  struct LegacyHit {
+    RECT rect;
+    int layer;
+    bool isButton;
+    bool visible;
+    bool checkTransparency;
+    std::wstring imagePath;
+  };
+  UIHitGrid legacyHits_;
+  std::unordered_map<int, LegacyHit> legacyHitInfo_;
+  
+  std::vector<uint32_t> hitCandidates_;  // 查詢暫存，每次重複使用
+  
+  // 名稱與ID索引；只有加入或移除組件、以及 SetComponentName/SetComponentId 會改動
+  UIComponentIndex<UIComponentNew> componentIndex_{ rootComponents_ };
+  
+  // 組件（連同子樹）加入或即將移除時呼叫，更新名稱/ID索引與點擊測試索引
+  void OnComponentAdded(UIComponentNew* component);
+  void OnComponentRemoved(UIComponentNew* component);
+  void InvalidateHitIndex();
+  void RebuildComponentHitIndex();
+  void UpdateComponentHits(uint32_t first, uint32_t end);
+  // 依 z 順序（上層在前）回傳包含該點且本身與祖先都可見的組件 slot
+  const std::vector<uint32_t>& QueryComponentHits(int x, int y);
+  void AddLegacyHit(int id, const RECT& rect, int layer, bool isButton, bool checkTransparency, const std::wstring& imagePath);
+  void RemoveLegacyHit(int id);
   
   void SortElementsByLayer();
-  void RenderButtons(IDirect3DDevice9* dev);
-  void RenderComponents(IDirect3DDevice9* dev, const std::vector<std::unique_ptr<UIComponentNew>>& components);
+  void RenderButtons();
+  void RenderComponents(const std::vector<std::unique_ptr<UIComponentNew>>& components);
 };
\ No newline at end of file
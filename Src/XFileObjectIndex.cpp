@@ -0,0 +1,187 @@
+﻿#include "XFileObjectIndex.h"
+#include "json.hpp"
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+
+constexpr int kIndexVersion = 1;
+
+fs::path SidecarPath(const fs::path& file) {
+  fs::path sidecar = file;
+  sidecar += ".objidx";
+  return sidecar;
+}
+
+json ToJson(XFileByteRange range) {
+  return json::array({ range.offset, range.size });
+}
+
+XFileByteRange RangeFromJson(const json& j) {
+  return { j.at(0).get<uint64_t>(), j.at(1).get<uint64_t>() };
+}
+
+json LayoutToJson(const XFileLayout& layout, uintmax_t size, int64_t time) {
+  json j;
+  j["version"] = kIndexVersion;
+  j["size"] = size;
+  j["time"] = time;
+  j["animated"] = layout.hasAnimation;
+  j["shared"] = json::array();
+  for (const auto& range : layout.shared) {
+    j["shared"].push_back(ToJson(range));
+  }
+  j["frames"] = json::array();
+  for (const auto& frame : layout.frames) {
+    j["frames"].push_back({
+      { "name", frame.name },
+      { "parent", frame.parent },
+      { "header", ToJson(frame.header) },
+      { "transform", ToJson(frame.transform) },
+      { "body", ToJson(frame.body) },
+    });
+  }
+  j["meshes"] = json::array();
+  for (const auto& mesh : layout.meshes) {
+    j["meshes"].push_back({
+      { "name", mesh.meshName },
+      { "frame", mesh.frameIndex },
+      { "vertices", mesh.vertexCount },
+      { "triangles", mesh.triangleCount },
+      { "materials", mesh.materialCount },
+      { "skinned", mesh.skinned },
+    });
+  }
+  return j;
+}
+
+XFileLayout LayoutFromJson(const json& j) {
+  XFileLayout layout;
+  layout.hasAnimation = j.at("animated").get<bool>();
+  for (const auto& range : j.at("shared")) {
+    layout.shared.push_back(RangeFromJson(range));
+  }
+  for (const auto& f : j.at("frames")) {
+    XFileFrameLayout frame;
+    frame.name = f.at("name").get<std::string>();
+    frame.parent = f.at("parent").get<int>();
+    frame.header = RangeFromJson(f.at("header"));
+    frame.transform = RangeFromJson(f.at("transform"));
+    frame.body = RangeFromJson(f.at("body"));
+    if (frame.parent >= static_cast<int>(layout.frames.size())) {
+      throw std::runtime_error("XFileObjectIndex: Frame 父節點索引無效");
+    }
+    layout.frames.push_back(std::move(frame));
+  }
+  for (const auto& m : j.at("meshes")) {
+    XFileMeshInfo mesh;
+    mesh.meshName = m.at("name").get<std::string>();
+    mesh.frameIndex = m.at("frame").get<int>();
+    mesh.vertexCount = m.at("vertices").get<uint32_t>();
+    mesh.triangleCount = m.at("triangles").get<uint32_t>();
+    mesh.materialCount = m.at("materials").get<uint32_t>();
+    mesh.skinned = m.at("skinned").get<bool>();
+    if (mesh.frameIndex >= static_cast<int>(layout.frames.size())) {
+      throw std::runtime_error("XFileObjectIndex: Mesh 的 Frame 索引無效");
+    }
+    if (mesh.frameIndex >= 0) {
+      mesh.frameName = layout.frames[mesh.frameIndex].name;
+    }
+    layout.meshes.push_back(std::move(mesh));
+  }
+  return layout;
+}
+
+bool IsInSubtree(const XFileLayout& layout, int frame, int root) {
+  for (; frame >= 0; frame = layout.frames[frame].parent) {
+    if (frame == root) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// 先寫入暫存檔再改名：中斷或並行寫入時，讀取端不會看到只寫了一半的旁檔
+// 暫存檔名含執行緒 ID，同時索引同一檔案的執行緒不會互相覆寫；旁檔只是快取，寫入失敗時略過
+void WriteSidecar(const fs::path& sidecar, const std::string& text) {
+  fs::path temp = sidecar;
+  temp += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+  {
+    std::ofstream out{ temp, std::ios::binary | std::ios::trunc };
+    if (!out || !(out << text) || !out.flush()) {
+      out.close();
+      std::error_code ec;
+      fs::remove(temp, ec);
+      return;
+    }
+  }
+  std::error_code ec;
+  fs::rename(temp, sidecar, ec);
+  if (ec) {
+    fs::remove(temp, ec);
+  }
+}
+
+} // namespace
+
+XFileLayout LoadXFileObjectIndex(const fs::path& file) {
+  uintmax_t size = fs::file_size(file);
+  int64_t time = static_cast<int64_t>(fs::last_write_time(file).time_since_epoch().count());
+  fs::path sidecar = SidecarPath(file);
+
+  if (std::ifstream in{ sidecar }) {
+    json j = json::parse(in, nullptr, false);
+    if (!j.is_discarded() && j.value("version", 0) == kIndexVersion &&
+        j.value("size", uintmax_t(0)) == size && j.value("time", int64_t(0)) == time) {
+      try {
+        return LayoutFromJson(j);
+      }
+      catch (const std::exception&) {
+        // 旁檔損毀，重新建立
+      }
+    }
+  }
+
+  XFileLayout layout = IndexXFile(file);
+  WriteSidecar(sidecar, LayoutToJson(layout, size, time).dump());
+  return layout;
+}
+
+std::optional<std::string> ExtractXFileObject(const fs::path& file, const std::string& objectName) {
+  try {
+    XFileLayout layout = LoadXFileObjectIndex(file);
+    if (layout.hasAnimation) {
+      return std::nullopt;
+    }
+
+    auto it = std::find_if(layout.frames.begin(), layout.frames.end(),
+      [&objectName](const XFileFrameLayout& frame) { return frame.name == objectName; });
+    if (it == layout.frames.end()) {
+      return std::nullopt;
+    }
+    int root = static_cast<int>(it - layout.frames.begin());
+
+    bool hasMesh = false;
+    for (const auto& mesh : layout.meshes) {
+      if (IsInSubtree(layout, mesh.frameIndex, root)) {
+        if (mesh.skinned) {
+          return std::nullopt;
+        }
+        hasMesh = true;
+      }
+    }
+    if (!hasMesh) {
+      return std::nullopt;
+    }
+    return ExtractXFileFrame(file, layout, root);
+  }
+  catch (const std::exception&) {
+    return std::nullopt;
+  }
+}
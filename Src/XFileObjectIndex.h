@@ -0,0 +1,17 @@
+﻿#pragma once
+#include <filesystem>
+#include <optional>
+#include <string>
+#include "XFileParser.h"
+
+// .x 物件索引旁檔：<模型檔>.objidx（JSON），保存 IndexXFile 的結果
+// 以來源檔大小與修改時間判斷是否過期；不存在或過期時重新略讀並嘗試寫回（寫入失敗不影響結果）
+// 來源檔格式錯誤時拋出 std::runtime_error
+XFileLayout LoadXFileObjectIndex(const std::filesystem::path& file);
+
+// 回傳只含具名 Frame objectName 子樹的 .x 內容，可交給 D3DXLoadMeshHierarchyFromXInMemory
+// 或 ParseXFileMemory。以下情況回傳 std::nullopt，呼叫端應改為完整載入：
+// - 找不到該 Frame，或其子樹沒有網格
+// - 子樹含蒙皮網格（骨骼可能位於子樹之外）或檔案含 AnimationSet
+// - 檔案無法讀取或格式錯誤
+std::optional<std::string> ExtractXFileObject(const std::filesystem::path& file, const std::string& objectName);
@@ -0,0 +1,979 @@
+﻿#include "XFileParser.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+
+// 二進位格式的 token 代碼（DirectX .x 檔規格）
+enum : uint16_t {
+  kTokenName = 1,
+  kTokenString = 2,
+  kTokenInteger = 3,
+  kTokenGuid = 5,
+  kTokenIntegerList = 6,
+  kTokenFloatList = 7,
+  kTokenOBrace = 10,
+  kTokenCBrace = 11,
+  kTokenTemplate = 31,
+};
+
+struct Token {
+  enum class Kind { End, OBrace, CBrace, Name, String } kind = Kind::End;
+  std::string_view text;
+};
+
+// 單次掃描的 token 讀取器：名稱與字串以 string_view 直接指向檔案緩衝區，不做配置
+class XReader {
+public:
+  XReader(const char* data, size_t size) : begin_(data), p_(data), end_(data + size) {
+    if (size < 16 || std::memcmp(data, "xof ", 4) != 0) {
+      throw std::runtime_error("XFileParser: 不是 .x 檔（缺少 xof 檔頭）");
+    }
+    std::string_view format(data + 8, 4);
+    if (format == "txt ") {
+      binary_ = false;
+    } else if (format == "bin ") {
+      binary_ = true;
+    } else if (format == "tzip" || format == "bzip") {
+      throw std::runtime_error("XFileParser: 不支援 MSZIP 壓縮的 .x 檔");
+    } else {
+      throw std::runtime_error(std::format("XFileParser: 未知的 .x 格式 '{}'", format));
+    }
+    double64_ = std::string_view(data + 12, 4) == "0064";
+    p_ += 16;
+  }
+
+  Token Next() {
+    return binary_ ? NextBinary() : NextText();
+  }
+
+  // 目前讀取位置相對於檔案開頭的位元組位移
+  uint64_t Offset() const {
+    return static_cast<uint64_t>(p_ - begin_);
+  }
+
+  uint32_t ReadInt() {
+    if (!binary_) {
+      SkipSeparators();
+      int64_t value = 0;
+      auto [ptr, ec] = std::from_chars(p_, end_, value);
+      if (ec != std::errc()) {
+        Fail("預期整數");
+      }
+      p_ = ptr;
+      return static_cast<uint32_t>(value);
+    }
+    if (!FillList()) {
+      return ReadU32();   // 單一 TOKEN_INTEGER
+    }
+    --listLeft_;
+    return listIsFloat_ ? static_cast<uint32_t>(ReadRawFloat()) : ReadU32();
+  }
+
+  float ReadFloat() {
+    if (!binary_) {
+      SkipSeparators();
+      if (p_ < end_ && *p_ == '+') {
+        ++p_;
+      }
+      float value = 0;
+      auto [ptr, ec] = std::from_chars(p_, end_, value);
+      if (ec != std::errc()) {
+        Fail("預期浮點數");
+      }
+      p_ = ptr;
+      return value;
+    }
+    if (!FillList()) {
+      return static_cast<float>(ReadU32());
+    }
+    --listLeft_;
+    return listIsFloat_ ? ReadRawFloat() : static_cast<float>(ReadU32());
+  }
+
+  // 略過 count 個數值而不做轉換；二進位格式直接跳過整段列表
+  void SkipValues(size_t count) {
+    if (!binary_) {
+      for (; count > 0; --count) {
+        SkipSeparators();
+        while (p_ < end_ && !IsSeparator(*p_) && *p_ != '{' && *p_ != '}') {
+          ++p_;
+        }
+      }
+      return;
+    }
+    while (count > 0) {
+      if (!FillList()) {
+        Skip(4);
+        --count;
+        continue;
+      }
+      size_t take = std::min<size_t>(count, listLeft_);
+      Skip(take * (listIsFloat_ && double64_ ? 8 : 4));
+      listLeft_ -= static_cast<uint32_t>(take);
+      count -= take;
+    }
+  }
+
+  // 讀取數量欄位，並以剩餘位元組數檢查合理性，避免損毀檔案造成巨量配置
+  uint32_t ReadCount(size_t valuesPerItem = 1) {
+    uint32_t count = ReadInt();
+    if (static_cast<size_t>(count) * valuesPerItem > static_cast<size_t>(end_ - p_)) {
+      Fail("數量超出檔案大小");
+    }
+    return count;
+  }
+
+  std::string ReadString() {
+    Token t = Next();
+    if (t.kind != Token::Kind::String && t.kind != Token::Kind::Name) {
+      Fail("預期字串");
+    }
+    std::string s(t.text);
+    // 文字格式以 \\ 跳脫反斜線
+    for (size_t pos = s.find("\\\\"); pos != std::string::npos; pos = s.find("\\\\", pos + 1)) {
+      s.erase(pos, 1);
+    }
+    return s;
+  }
+
+  // 讀取資料物件開頭：[名稱] {，回傳名稱（可能為空）
+  std::string_view ReadObjectHeader() {
+    Token t = Next();
+    if (t.kind == Token::Kind::OBrace) {
+      return {};
+    }
+    if (t.kind != Token::Kind::Name) {
+      Fail("預期物件開頭");
+    }
+    if (Next().kind != Token::Kind::OBrace) {
+      Fail("預期 '{'");
+    }
+    return t.text;
+  }
+
+  // 略過目前物件剩餘的內容，直到對應的 '}'
+  void SkipObject() {
+    if (!binary_) {
+      SkipTextObject();
+      return;
+    }
+    for (int depth = 1; depth > 0;) {
+      Token t = Next();
+      if (t.kind == Token::Kind::End) {
+        Fail("物件未結束");
+      } else if (t.kind == Token::Kind::OBrace) {
+        ++depth;
+      } else if (t.kind == Token::Kind::CBrace) {
+        --depth;
+      }
+    }
+  }
+
+  [[noreturn]] void Fail(std::string_view what) const {
+    throw std::runtime_error(std::format("XFileParser: {}（位移 {}）", what, size_t(p_ - begin_)));
+  }
+
+private:
+  static bool IsSeparator(char c) {
+    return c == ',' || c == ';' || static_cast<unsigned char>(c) <= ' ';
+  }
+
+  void SkipSeparators() {
+    while (p_ < end_) {
+      char c = *p_;
+      if (IsSeparator(c)) {
+        ++p_;
+      } else if (c == '#' || (c == '/' && p_ + 1 < end_ && p_[1] == '/')) {
+        while (p_ < end_ && *p_ != '\n') {
+          ++p_;
+        }
+      } else {
+        break;
+      }
+    }
+  }
+
+  // 文字格式只需追蹤大括號層級，逐位元組掃描即可，不必切出每個 token
+  void SkipTextObject() {
+    for (int depth = 1; depth > 0;) {
+      if (p_ >= end_) {
+        Fail("物件未結束");
+      }
+      switch (*p_++) {
+        case '{':
+          ++depth;
+          break;
+        case '}':
+          --depth;
+          break;
+        case '"': {
+          const void* close = std::memchr(p_, '"', end_ - p_);
+          if (!close) {
+            Fail("字串未結束");
+          }
+          p_ = static_cast<const char*>(close) + 1;
+          break;
+        }
+        case '/':
+          if (p_ >= end_ || *p_ != '/') {
+            break;
+          }
+          [[fallthrough]];
+        case '#': {
+          const void* eol = std::memchr(p_, '\n', end_ - p_);
+          p_ = eol ? static_cast<const char*>(eol) : end_;
+          break;
+        }
+        default:
+          break;
+      }
+    }
+  }
+
+  Token NextText() {
+    for (;;) {
+      SkipSeparators();
+      if (p_ >= end_) {
+        return {};
+      }
+      char c = *p_;
+      if (c == '{') {
+        ++p_;
+        return { Token::Kind::OBrace, "{" };
+      }
+      if (c == '}') {
+        ++p_;
+        return { Token::Kind::CBrace, "}" };
+      }
+      if (c == '<') {
+        // 範本或資料中的 GUID
+        const void* close = std::memchr(p_, '>', end_ - p_);
+        p_ = close ? static_cast<const char*>(close) + 1 : end_;
+        continue;
+      }
+      if (c == '"') {
+        const char* start = ++p_;
+        const void* close = std::memchr(p_, '"', end_ - p_);
+        if (!close) {
+          Fail("字串未結束");
+        }
+        p_ = static_cast<const char*>(close) + 1;
+        return { Token::Kind::String, std::string_view(start, p_ - 1 - start) };
+      }
+      const char* start = p_;
+      while (p_ < end_ && !IsSeparator(*p_) && std::strchr("{}\"<", *p_) == nullptr) {
+        ++p_;
+      }
+      return { Token::Kind::Name, std::string_view(start, p_ - start) };
+    }
+  }
+
+  Token NextBinary() {
+    SkipListRemainder();
+    for (;;) {
+      if (end_ - p_ < 2) {
+        return {};
+      }
+      uint16_t token = ReadU16();
+      switch (token) {
+        case kTokenName:
+        case kTokenString: {
+          uint32_t length = ReadU32();
+          if (length > static_cast<size_t>(end_ - p_)) {
+            Fail("名稱長度超出檔案大小");
+          }
+          std::string_view text(p_, length);
+          p_ += length;
+          return { token == kTokenName ? Token::Kind::Name : Token::Kind::String, text };
+        }
+        case kTokenOBrace:
+          return { Token::Kind::OBrace, "{" };
+        case kTokenCBrace:
+          return { Token::Kind::CBrace, "}" };
+        case kTokenTemplate:
+          return { Token::Kind::Name, "template" };
+        case kTokenInteger:
+          Skip(4);
+          break;
+        case kTokenGuid:
+          Skip(16);
+          break;
+        case kTokenIntegerList:
+          Skip(static_cast<size_t>(ReadU32()) * 4);
+          break;
+        case kTokenFloatList:
+          Skip(static_cast<size_t>(ReadU32()) * (double64_ ? 8 : 4));
+          break;
+        default:
+          // 分隔符號、範本關鍵字，以及字串結尾 DWORD 的高位補零
+          break;
+      }
+    }
+  }
+
+  // 二進位格式的數值以 list token 成批出現；回傳 false 表示讀到單一 TOKEN_INTEGER
+  bool FillList() {
+    while (listLeft_ == 0) {
+      uint16_t token = ReadU16();
+      if (token == kTokenIntegerList || token == kTokenFloatList) {
+        listLeft_ = ReadU32();
+        listIsFloat_ = token == kTokenFloatList;
+        size_t bytes = static_cast<size_t>(listLeft_) * (listIsFloat_ && double64_ ? 8 : 4);
+        if (bytes > static_cast<size_t>(end_ - p_)) {
+          Fail("數值列表超出檔案大小");
+        }
+      } else if (token == kTokenInteger) {
+        return false;
+      } else if (token == kTokenOBrace || token == kTokenCBrace || token == kTokenName || token == kTokenString) {
+        Fail("預期數值");
+      }
+    }
+    return true;
+  }
+
+  void SkipListRemainder() {
+    if (listLeft_ > 0) {
+      Skip(static_cast<size_t>(listLeft_) * (listIsFloat_ && double64_ ? 8 : 4));
+      listLeft_ = 0;
+    }
+  }
+
+  void Skip(size_t bytes) {
+    if (bytes > static_cast<size_t>(end_ - p_)) {
+      Fail("檔案意外結束");
+    }
+    p_ += bytes;
+  }
+
+  uint16_t ReadU16() {
+    uint16_t v;
+    if (end_ - p_ < 2) {
+      Fail("檔案意外結束");
+    }
+    std::memcpy(&v, p_, 2);
+    p_ += 2;
+    return v;
+  }
+
+  uint32_t ReadU32() {
+    uint32_t v;
+    if (end_ - p_ < 4) {
+      Fail("檔案意外結束");
+    }
+    std::memcpy(&v, p_, 4);
+    p_ += 4;
+    return v;
+  }
+
+  float ReadRawFloat() {
+    if (double64_) {
+      double d;
+      if (end_ - p_ < 8) {
+        Fail("檔案意外結束");
+      }
+      std::memcpy(&d, p_, 8);
+      p_ += 8;
+      return static_cast<float>(d);
+    }
+    uint32_t bits = ReadU32();
+    float f;
+    std::memcpy(&f, &bits, 4);
+    return f;
+  }
+
+  const char* begin_;
+  const char* p_;
+  const char* end_;
+  bool binary_ = false;
+  bool double64_ = false;
+  uint32_t listLeft_ = 0;
+  bool listIsFloat_ = false;
+};
+
+class XFileSceneParser {
+public:
+  // skim 不為 nullptr 時只略讀結構：Mesh 只記錄數量，不保留任何陣列內容，並記錄各物件的位元組區段
+  XFileSceneParser(const char* data, size_t size, XFileScene& scene,
+                   XFileLayout* skim = nullptr)
+    : in_(data, size), scene_(scene), skim_(skim) {
+  }
+
+  void Parse() {
+    for (;;) {
+      uint64_t start = in_.Offset();
+      Token t = in_.Next();
+      if (t.kind == Token::Kind::End) {
+        break;
+      }
+      if (t.kind == Token::Kind::OBrace) {
+        in_.SkipObject();
+        continue;
+      }
+      if (t.kind != Token::Kind::Name) {
+        continue;
+      }
+      if (t.text == "Frame") {
+        ParseFrame(-1, start);
+      } else if (t.text == "Mesh") {
+        ParseMesh(-1);
+      } else if (skim_) {
+        in_.ReadObjectHeader();
+        in_.SkipObject();
+        if (t.text == "AnimationSet") {
+          skim_->hasAnimation = true;
+        } else {
+          skim_->shared.push_back({ start, in_.Offset() - start });
+        }
+      } else if (t.text == "AnimationSet") {
+        ParseAnimationSet();
+      } else if (t.text == "AnimTicksPerSecond") {
+        in_.ReadObjectHeader();
+        scene_.ticksPerSecond = in_.ReadInt();
+        in_.SkipObject();
+      } else if (t.text == "Material") {
+        // 頂層具名材質，MeshMaterialList 會以 { 名稱 } 引用
+        std::string name(in_.ReadObjectHeader());
+        namedMaterials_[name] = ParseMaterialBody();
+      } else {
+        // template 與其他不需要的物件
+        in_.ReadObjectHeader();
+        in_.SkipObject();
+      }
+    }
+  }
+
+private:
+  // start 為 "Frame" token 的起始位移
+  void ParseFrame(int parent, uint64_t start) {
+    int index = static_cast<int>(scene_.frames.size());
+    scene_.frames.push_back({ std::string(in_.ReadObjectHeader()), parent, {} });
+    if (skim_) {
+      skim_->frames.push_back({ scene_.frames.back().name, parent, { start, in_.Offset() - start }, {}, {} });
+    }
+
+    for (;;) {
+      uint64_t childStart = in_.Offset();
+      Token t = in_.Next();
+      switch (t.kind) {
+        case Token::Kind::End:
+          in_.Fail("Frame 未結束");
+        case Token::Kind::CBrace:
+          if (skim_) {
+            skim_->frames[index].body = { start, in_.Offset() - start };
+          }
+          return;
+        case Token::Kind::OBrace:
+          in_.SkipObject();   // 資料參照
+          break;
+        default:
+          if (t.text == "Frame") {
+            ParseFrame(index, childStart);
+          } else if (t.text == "FrameTransformMatrix" && skim_) {
+            in_.ReadObjectHeader();
+            in_.SkipObject();
+            skim_->frames[index].transform = { childStart, in_.Offset() - childStart };
+          } else if (t.text == "FrameTransformMatrix") {
+            in_.ReadObjectHeader();
+            ReadMatrix(scene_.frames[index].transform);
+            in_.SkipObject();
+          } else if (t.text == "Mesh") {
+            ParseMesh(index);
+          } else {
+            in_.ReadObjectHeader();
+            in_.SkipObject();
+          }
+          break;
+      }
+    }
+  }
+
+  void ParseMesh(int frameIndex) {
+    if (skim_) {
+      SkimMesh(frameIndex);
+      return;
+    }
+
+    XFileMesh mesh;
+    mesh.name = in_.ReadObjectHeader();
+    mesh.frameIndex = frameIndex;
+
+    uint32_t vertexCount = in_.ReadCount(3);
+    mesh.positions.resize(vertexCount);
+    for (auto& p : mesh.positions) {
+      p = ReadVector3();
+    }
+
+    uint32_t faceCount = in_.ReadCount();
+    std::vector<uint32_t> trianglesPerFace(faceCount);
+    mesh.indices.reserve(static_cast<size_t>(faceCount) * 3);
+    for (uint32_t f = 0; f < faceCount; ++f) {
+      trianglesPerFace[f] = ReadPolygon(mesh.indices, vertexCount);
+    }
+
+    for (;;) {
+      Token t = in_.Next();
+      if (t.kind == Token::Kind::End) {
+        in_.Fail("Mesh 未結束");
+      }
+      if (t.kind == Token::Kind::CBrace) {
+        break;
+      }
+      if (t.kind == Token::Kind::OBrace) {
+        in_.SkipObject();
+      } else if (t.text == "MeshNormals") {
+        ParseNormals(mesh, trianglesPerFace);
+      } else if (t.text == "MeshTextureCoords") {
+        in_.ReadObjectHeader();
+        mesh.uvs.resize(in_.ReadCount(2));
+        for (auto& uv : mesh.uvs) {
+          uv.u = in_.ReadFloat();
+          uv.v = in_.ReadFloat();
+        }
+        in_.SkipObject();
+      } else if (t.text == "MeshMaterialList") {
+        ParseMaterialList(mesh, trianglesPerFace);
+      } else if (t.text == "SkinWeights") {
+        ParseSkinWeights(mesh);
+      } else {
+        // XSkinMeshHeader、VertexDuplicationIndices、MeshVertexColors 等
+        in_.ReadObjectHeader();
+        in_.SkipObject();
+      }
+    }
+
+    scene_.meshes.push_back(std::move(mesh));
+  }
+
+  void SkimMesh(int frameIndex) {
+    XFileMeshInfo info;
+    info.meshName = in_.ReadObjectHeader();
+    info.frameIndex = frameIndex;
+    if (frameIndex >= 0) {
+      info.frameName = scene_.frames[frameIndex].name;
+    }
+
+    info.vertexCount = in_.ReadCount(3);
+    in_.SkipValues(static_cast<size_t>(info.vertexCount) * 3);
+    uint32_t faceCount = in_.ReadCount();
+    for (uint32_t f = 0; f < faceCount; ++f) {
+      uint32_t corners = in_.ReadCount();
+      in_.SkipValues(corners);
+      info.triangleCount += corners >= 3 ? corners - 2 : 0;
+    }
+
+    for (;;) {
+      Token t = in_.Next();
+      if (t.kind == Token::Kind::End) {
+        in_.Fail("Mesh 未結束");
+      }
+      if (t.kind == Token::Kind::CBrace) {
+        break;
+      }
+      if (t.kind == Token::Kind::OBrace) {
+        in_.SkipObject();
+        continue;
+      }
+      in_.ReadObjectHeader();
+      if (t.text == "MeshMaterialList") {
+        info.materialCount = in_.ReadInt();
+      } else if (t.text == "SkinWeights" || t.text == "XSkinMeshHeader") {
+        info.skinned = true;
+      }
+      in_.SkipObject();
+    }
+
+    skim_->meshes.push_back(std::move(info));
+  }
+
+  // 讀取一個多邊形並以扇形三角化，回傳產生的三角形數
+  uint32_t ReadPolygon(std::vector<uint32_t>& out, uint32_t vertexCount) {
+    uint32_t count = in_.ReadCount();
+    uint32_t first = 0, prev = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+      uint32_t index = in_.ReadInt();
+      if (index >= vertexCount) {
+        in_.Fail("面索引超出範圍");
+      }
+      if (i == 0) {
+        first = index;
+      } else if (i >= 2) {
+        out.push_back(first);
+        out.push_back(prev);
+        out.push_back(index);
+      }
+      prev = index;
+    }
+    return count >= 3 ? count - 2 : 0;
+  }
+
+  void ParseNormals(XFileMesh& mesh, const std::vector<uint32_t>& trianglesPerFace) {
+    in_.ReadObjectHeader();
+    uint32_t normalCount = in_.ReadCount(3);
+    mesh.normals.resize(normalCount);
+    for (auto& n : mesh.normals) {
+      n = ReadVector3();
+    }
+
+    uint32_t faceCount = in_.ReadCount();
+    bool consistent = faceCount == trianglesPerFace.size();
+    mesh.normalIndices.reserve(mesh.indices.size());
+    for (uint32_t f = 0; f < faceCount; ++f) {
+      uint32_t triangles = ReadPolygon(mesh.normalIndices, normalCount);
+      consistent = consistent && triangles == trianglesPerFace[f];
+    }
+    if (!consistent) {
+      mesh.normalIndices.clear();   // 面結構與網格不符，捨棄法線
+    }
+    in_.SkipObject();
+  }
+
+  void ParseMaterialList(XFileMesh& mesh, const std::vector<uint32_t>& trianglesPerFace) {
+    in_.ReadObjectHeader();
+    in_.ReadInt();   // nMaterials：以實際出現的 Material 物件為準
+    uint32_t indexCount = in_.ReadCount();
+    std::vector<uint32_t> faceMaterials(indexCount);
+    for (auto& m : faceMaterials) {
+      m = in_.ReadInt();
+    }
+
+    // 面數可能多於索引數，不足的部分沿用最後一個索引
+    mesh.triangleMaterials.reserve(mesh.indices.size() / 3);
+    for (size_t f = 0; f < trianglesPerFace.size(); ++f) {
+      uint32_t material = f < faceMaterials.size() ? faceMaterials[f]
+                        : faceMaterials.empty() ? 0 : faceMaterials.back();
+      mesh.triangleMaterials.insert(mesh.triangleMaterials.end(), trianglesPerFace[f], material);
+    }
+
+    for (;;) {
+      Token t = in_.Next();
+      if (t.kind == Token::Kind::End) {
+        in_.Fail("MeshMaterialList 未結束");
+      }
+      if (t.kind == Token::Kind::CBrace) {
+        break;
+      }
+      if (t.kind == Token::Kind::OBrace) {
+        // { 名稱 }：引用頂層材質
+        Token name = in_.Next();
+        auto it = namedMaterials_.find(std::string(name.text));
+        mesh.materials.push_back(it != namedMaterials_.end() ? it->second : XFileMaterial{});
+        if (name.kind != Token::Kind::CBrace) {
+          in_.SkipObject();
+        }
+      } else if (t.text == "Material") {
+        in_.ReadObjectHeader();
+        mesh.materials.push_back(ParseMaterialBody());
+      } else {
+        in_.ReadObjectHeader();
+        in_.SkipObject();
+      }
+    }
+  }
+
+  XFileMaterial ParseMaterialBody() {
+    XFileMaterial material;
+    for (float& c : material.diffuse) {
+      c = in_.ReadFloat();
+    }
+    material.power = in_.ReadFloat();
+    for (float& c : material.specular) {
+      c = in_.ReadFloat();
+    }
+    for (float& c : material.emissive) {
+      c = in_.ReadFloat();
+    }
+
+    for (;;) {
+      Token t = in_.Next();
+      if (t.kind == Token::Kind::End) {
+        in_.Fail("Material 未結束");
+      }
+      if (t.kind == Token::Kind::CBrace) {
+        break;
+      }
+      if (t.kind == Token::Kind::OBrace) {
+        in_.SkipObject();
+      } else if (t.text == "TextureFilename" || t.text == "TextureFileName") {
+        in_.ReadObjectHeader();
+        material.textureFileName = in_.ReadString();
+        in_.SkipObject();
+      } else {
+        in_.ReadObjectHeader();
+        in_.SkipObject();
+      }
+    }
+    return material;
+  }
+
+  void ParseSkinWeights(XFileMesh& mesh) {
+    in_.ReadObjectHeader();
+    XFileSkinWeights skin;
+    skin.boneName = in_.ReadString();
+    uint32_t count = in_.ReadCount(2);
+    skin.vertexIndices.resize(count);
+    for (auto& index : skin.vertexIndices) {
+      index = in_.ReadInt();
+    }
+    skin.weights.resize(count);
+    for (auto& weight : skin.weights) {
+      weight = in_.ReadFloat();
+    }
+    ReadMatrix(skin.offset);
+    in_.SkipObject();
+    mesh.skinWeights.push_back(std::move(skin));
+  }
+
+  void ParseAnimationSet() {
+    XFileAnimationSet set;
+    set.name = in_.ReadObjectHeader();
+    for (;;) {
+      Token t = in_.Next();
+      if (t.kind == Token::Kind::End) {
+        in_.Fail("AnimationSet 未結束");
+      }
+      if (t.kind == Token::Kind::CBrace) {
+        break;
+      }
+      if (t.kind == Token::Kind::OBrace) {
+        in_.SkipObject();
+      } else if (t.text == "Animation") {
+        set.animations.push_back(ParseAnimation());
+      } else {
+        in_.ReadObjectHeader();
+        in_.SkipObject();
+      }
+    }
+    scene_.animationSets.push_back(std::move(set));
+  }
+
+  XFileAnimation ParseAnimation() {
+    in_.ReadObjectHeader();
+    XFileAnimation animation;
+    for (;;) {
+      Token t = in_.Next();
+      if (t.kind == Token::Kind::End) {
+        in_.Fail("Animation 未結束");
+      }
+      if (t.kind == Token::Kind::CBrace) {
+        break;
+      }
+      if (t.kind == Token::Kind::OBrace) {
+        // { FrameName }：動畫作用的 Frame
+        Token name = in_.Next();
+        if (name.kind == Token::Kind::Name) {
+          animation.frameName = name.text;
+        }
+        if (name.kind != Token::Kind::CBrace) {
+          in_.SkipObject();
+        }
+      } else if (t.text == "AnimationKey") {
+        ParseAnimationKey(animation);
+      } else {
+        in_.ReadObjectHeader();   // AnimationOptions 等
+        in_.SkipObject();
+      }
+    }
+    return animation;
+  }
+
+  void ParseAnimationKey(XFileAnimation& animation) {
+    in_.ReadObjectHeader();
+    uint32_t keyType = in_.ReadInt();
+    uint32_t keyCount = in_.ReadCount(2);
+
+    static constexpr uint32_t kValueCount[] = { 4, 3, 3, 16, 16 };
+    if (keyType >= std::size(kValueCount)) {
+      in_.Fail(std::format("未知的 AnimationKey 類型 {}", keyType));
+    }
+    switch (keyType) {
+      case 0: animation.rotationKeys.reserve(keyCount); break;
+      case 1: animation.scaleKeys.reserve(keyCount); break;
+      case 2: animation.positionKeys.reserve(keyCount); break;
+      default: animation.matrixKeys.reserve(keyCount); break;
+    }
+
+    for (uint32_t k = 0; k < keyCount; ++k) {
+      uint32_t time = in_.ReadInt();
+      if (in_.ReadInt() != kValueCount[keyType]) {
+        in_.Fail("AnimationKey 數值個數不符");
+      }
+      switch (keyType) {
+        case 0: {
+          XFileQuaternionKey key;
+          key.time = time;
+          key.w = in_.ReadFloat();
+          key.x = in_.ReadFloat();
+          key.y = in_.ReadFloat();
+          key.z = in_.ReadFloat();
+          animation.rotationKeys.push_back(key);
+          break;
+        }
+        case 1:
+          animation.scaleKeys.push_back({ time, ReadVector3() });
+          break;
+        case 2:
+          animation.positionKeys.push_back({ time, ReadVector3() });
+          break;
+        default: {
+          XFileMatrixKey key;
+          key.time = time;
+          ReadMatrix(key.value);
+          animation.matrixKeys.push_back(key);
+          break;
+        }
+      }
+    }
+    in_.SkipObject();
+  }
+
+  XFileVector3 ReadVector3() {
+    XFileVector3 v;
+    v.x = in_.ReadFloat();
+    v.y = in_.ReadFloat();
+    v.z = in_.ReadFloat();
+    return v;
+  }
+
+  void ReadMatrix(XFileMatrix& out) {
+    for (float& f : out.m) {
+      f = in_.ReadFloat();
+    }
+  }
+
+  XReader in_;
+  XFileScene& scene_;
+  XFileLayout* skim_;
+  std::unordered_map<std::string, XFileMaterial> namedMaterials_;
+};
+
+} // namespace
+
+XFileScene ParseXFileMemory(const char* data, size_t size) {
+  XFileScene scene;
+  XFileSceneParser(data, size, scene).Parse();
+  return scene;
+}
+
+namespace {
+
+std::vector<char> ReadWholeFile(const std::filesystem::path& file) {
+  std::ifstream in(file, std::ios::binary | std::ios::ate);
+  if (!in) {
+    throw std::runtime_error(std::format("XFileParser: 無法開啟檔案 {}", file.string()));
+  }
+  std::vector<char> buffer(static_cast<size_t>(in.tellg()));
+  in.seekg(0);
+  if (!in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+    throw std::runtime_error(std::format("XFileParser: 讀取檔案失敗 {}", file.string()));
+  }
+  return buffer;
+}
+
+} // namespace
+
+XFileScene ParseXFile(const std::filesystem::path& file) {
+  std::vector<char> buffer = ReadWholeFile(file);
+  return ParseXFileMemory(buffer.data(), buffer.size());
+}
+
+XFileLayout IndexXFileMemory(const char* data, size_t size) {
+  XFileScene frames;
+  XFileLayout layout;
+  XFileSceneParser(data, size, frames, &layout).Parse();
+  return layout;
+}
+
+XFileLayout IndexXFile(const std::filesystem::path& file) {
+  std::vector<char> buffer = ReadWholeFile(file);
+  return IndexXFileMemory(buffer.data(), buffer.size());
+}
+
+std::vector<XFileMeshInfo> ScanXFileMemory(const char* data, size_t size) {
+  return IndexXFileMemory(data, size).meshes;
+}
+
+std::vector<XFileMeshInfo> ScanXFile(const std::filesystem::path& file) {
+  return IndexXFile(file).meshes;
+}
+
+std::string ExtractXFileFrame(const std::filesystem::path& file, const XFileLayout& layout, int frameIndex) {
+  if (frameIndex < 0 || static_cast<size_t>(frameIndex) >= layout.frames.size()) {
+    throw std::out_of_range(std::format("XFileParser: Frame 索引 {} 超出範圍", frameIndex));
+  }
+
+  std::ifstream in(file, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error(std::format("XFileParser: 無法開啟檔案 {}", file.string()));
+  }
+  std::string out;
+  auto append = [&](XFileByteRange range) {
+    if (range.size == 0) {
+      return;
+    }
+    size_t at = out.size();
+    out.resize(at + static_cast<size_t>(range.size));
+    in.seekg(static_cast<std::streamoff>(range.offset));
+    if (!in.read(out.data() + at, static_cast<std::streamsize>(range.size))) {
+      throw std::runtime_error(std::format("XFileParser: 讀取檔案失敗 {}", file.string()));
+    }
+  };
+
+  append({ 0, 16 });
+  bool binary = out.compare(8, 4, "bin ") == 0;
+  for (const auto& range : layout.shared) {
+    append(range);
+  }
+
+  // 祖先 Frame 只保留名稱與轉換矩陣，兄弟節點與其網格不會被載入
+  std::vector<int> ancestors;
+  for (int p = layout.frames[frameIndex].parent; p >= 0; p = layout.frames[p].parent) {
+    ancestors.push_back(p);
+  }
+  for (auto it = ancestors.rbegin(); it != ancestors.rend(); ++it) {
+    append(layout.frames[*it].header);
+    append(layout.frames[*it].transform);
+  }
+  append(layout.frames[frameIndex].body);
+  for (size_t i = 0; i < ancestors.size(); ++i) {
+    out += binary ? std::string("\x0B\0", 2) : std::string("}\n");
+  }
+  return out;
+}
+
+std::vector<std::string> XFileModelNames(const std::vector<XFileMeshInfo>& meshes) {
+  std::vector<std::string> names;
+  names.reserve(meshes.size());
+  std::unordered_map<std::string, int> used;
+  int unnamed = 0;
+  for (const auto& mesh : meshes) {
+    std::string name = !mesh.frameName.empty() ? mesh.frameName
+                     : !mesh.meshName.empty() ? mesh.meshName
+                     : "mesh_" + std::to_string(unnamed++);
+    // 同一個 Frame 底下有多個 Mesh 時加上序號
+    int& seen = used[name];
+    if (seen++ > 0) {
+      name += "_" + std::to_string(seen - 1);
+    }
+    names.push_back(std::move(name));
+  }
+  return names;
+}
+
+std::vector<std::string> XFileModelNames(const XFileScene& scene) {
+  std::vector<XFileMeshInfo> meshes(scene.meshes.size());
+  for (size_t i = 0; i < scene.meshes.size(); ++i) {
+    meshes[i].meshName = scene.meshes[i].name;
+    meshes[i].frameIndex = scene.meshes[i].frameIndex;
+    if (meshes[i].frameIndex >= 0) {
+      meshes[i].frameName = scene.frames[meshes[i].frameIndex].name;
+    }
+  }
+  return XFileModelNames(meshes);
+}
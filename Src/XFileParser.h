@@ -0,0 +1,129 @@
+﻿#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// .x 檔的可攜式剖析結果：只使用標準函式庫，不需要 D3DX 或 IDirect3DDevice9，
+// 可以在任何平台上烘焙、驗證 .x 資產
+
+// 4x4 矩陣，列主序，與 D3DXMATRIX / XMFLOAT4X4 的記憶體配置相同
+struct XFileMatrix {
+  float m[16] = { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1 };
+};
+
+struct XFileVector2 { float u = 0, v = 0; };
+struct XFileVector3 { float x = 0, y = 0, z = 0; };
+
+struct XFileMaterial {
+  float diffuse[4] = { 1, 1, 1, 1 };  // RGBA
+  float power = 0;
+  float specular[3] = {};
+  float emissive[3] = {};
+  std::string textureFileName;
+};
+
+struct XFileSkinWeights {
+  std::string boneName;               // 對應的 Frame 名稱
+  std::vector<uint32_t> vertexIndices;
+  std::vector<float> weights;
+  XFileMatrix offset;                 // 骨骼偏移（bind pose 反矩陣）
+};
+
+struct XFileMesh {
+  std::string name;
+  int frameIndex = -1;                     // 所屬 Frame；頂層 Mesh 為 -1
+  std::vector<XFileVector3> positions;
+  std::vector<uint32_t> indices;           // 三角化（扇形）後的位置索引
+  std::vector<XFileVector3> normals;
+  std::vector<uint32_t> normalIndices;     // 與 indices 一一對應；為空表示沒有法線
+  std::vector<XFileVector2> uvs;           // 與 positions 一一對應
+  std::vector<uint32_t> triangleMaterials; // 每個三角形的材質索引
+  std::vector<XFileMaterial> materials;
+  std::vector<XFileSkinWeights> skinWeights;
+};
+
+struct XFileFrame {
+  std::string name;
+  int parent = -1;
+  XFileMatrix transform;   // FrameTransformMatrix（相對於父節點）
+};
+
+struct XFileQuaternionKey { uint32_t time = 0; float w = 1, x = 0, y = 0, z = 0; };
+struct XFileVectorKey { uint32_t time = 0; XFileVector3 value; };
+struct XFileMatrixKey { uint32_t time = 0; XFileMatrix value; };
+
+// 一個 Frame 在動畫組中的關鍵影格；time 單位為 tick
+struct XFileAnimation {
+  std::string frameName;
+  std::vector<XFileQuaternionKey> rotationKeys;
+  std::vector<XFileVectorKey> scaleKeys;
+  std::vector<XFileVectorKey> positionKeys;
+  std::vector<XFileMatrixKey> matrixKeys;
+};
+
+struct XFileAnimationSet {
+  std::string name;
+  std::vector<XFileAnimation> animations;
+};
+
+struct XFileScene {
+  std::vector<XFileFrame> frames;     // 深度優先順序，父節點一定排在子節點之前
+  std::vector<XFileMesh> meshes;
+  std::vector<XFileAnimationSet> animationSets;
+  uint32_t ticksPerSecond = 4800;     // 檔案未指定 AnimTicksPerSecond 時 D3DX 的預設值
+};
+
+// 略讀結果：單一 Mesh 的結構資訊，不含任何頂點資料
+struct XFileMeshInfo {
+  std::string frameName;        // 所屬 Frame；頂層 Mesh 為空
+  std::string meshName;
+  int frameIndex = -1;
+  uint32_t vertexCount = 0;
+  uint32_t triangleCount = 0;   // 扇形三角化後的三角形數
+  uint32_t materialCount = 0;
+  bool skinned = false;         // 含 SkinWeights
+};
+
+// 檔案內的位元組區段 [offset, offset + size)
+struct XFileByteRange {
+  uint64_t offset = 0;
+  uint64_t size = 0;
+};
+
+// 略讀時記錄的 Frame 位置，用於只擷取單一物件
+struct XFileFrameLayout {
+  std::string name;
+  int parent = -1;
+  XFileByteRange header;      // "Frame 名稱 {"
+  XFileByteRange transform;   // FrameTransformMatrix；size 為 0 表示沒有
+  XFileByteRange body;        // 整個 Frame 物件，含子 Frame 與結尾大括號
+};
+
+struct XFileLayout {
+  std::vector<XFileMeshInfo> meshes;
+  std::vector<XFileFrameLayout> frames;   // 與 XFileScene::frames 相同順序
+  std::vector<XFileByteRange> shared;     // 所有物件共用的頂層物件：template、具名 Material 等
+  bool hasAnimation = false;              // 含 AnimationSet
+};
+
+// 剖析文字（txt）或二進位（bin）格式的 .x 檔，32 或 64 位元浮點數皆可
+// 不支援 MSZIP 壓縮格式（tzip/bzip）；格式錯誤或不支援時拋出 std::runtime_error
+XFileScene ParseXFile(const std::filesystem::path& file);
+XFileScene ParseXFileMemory(const char* data, size_t size);
+
+// 只略讀 Frame/Mesh 結構（數值陣列直接跳過），供模型清單與資產瀏覽使用
+std::vector<XFileMeshInfo> ScanXFile(const std::filesystem::path& file);
+std::vector<XFileMeshInfo> ScanXFileMemory(const char* data, size_t size);
+
+// 同 ScanXFile，另外記錄各 Frame 與共用物件的位元組區段
+XFileLayout IndexXFile(const std::filesystem::path& file);
+XFileLayout IndexXFileMemory(const char* data, size_t size);
+
+// 擷取 frameIndex 的子樹成為可獨立載入的 .x 內容（文字或二進位，與來源相同）：
+// 檔頭 + 共用物件 + 祖先 Frame（只含名稱與轉換矩陣）+ 整個子樹。不含 AnimationSet
+std::string ExtractXFileFrame(const std::filesystem::path& file, const XFileLayout& layout, int frameIndex);
+
+// 模型名稱：所屬 Frame 名稱，否則為 Mesh 名稱，再否則為 mesh_N；重複名稱加上 _N 序號
+std::vector<std::string> XFileModelNames(const std::vector<XFileMeshInfo>& meshes);
+std::vector<std::string> XFileModelNames(const XFileScene& scene);
@@ -2,9 +2,12 @@
 #include "AllocateHierarchy.h"
 #include "Utilities.h"
 #include "SkinMeshFactory.h"
+#include "XFileObjectIndex.h"
+#include "XFileParser.h"
 #include "XFileTypes.h"
 #include <DirectXMath.h>
 #include <iostream>
+#include <optional>
 
 // Helper structure for frame hierarchy traversal
 struct FrameInfo {
@@ -17,24 +20,41 @@ std::map<std::string, std::shared_ptr<ModelData>> XModelEnhanced::LoadWithSepara
     const std::filesystem::path& file,
     IDirect3DDevice9* device) {
     
+    return LoadHierarchy(file, nullptr, device);
+}
+
+std::map<std::string, std::shared_ptr<ModelData>> XModelEnhanced::LoadHierarchy(
+    const std::filesystem::path& file,
+    const std::string* xfileData,
+    IDirect3DDevice9* device) {
+    
     if (!device) {
         throw std::invalid_argument("Device is null");
     }
     
-    // Load the X file hierarchy
+    // Load the X file hierarchy (from an extracted subset when xfileData is given)
     AllocateHierarchy alloc(device);
     ID3DXAnimationController* animController = nullptr;
     D3DXFRAME* rootFrame = nullptr;
     
-    HRESULT hr = D3DXLoadMeshHierarchyFromX(
-        file.wstring().c_str(),
-        D3DXMESH_MANAGED,
-        device,
-        &alloc,
-        nullptr,
-        &rootFrame,
-        &animController
-    );
+    HRESULT hr = xfileData
+        ? D3DXLoadMeshHierarchyFromXInMemory(
+            xfileData->data(),
+            static_cast<DWORD>(xfileData->size()),
+            D3DXMESH_MANAGED,
+            device,
+            &alloc,
+            nullptr,
+            &rootFrame,
+            &animController)
+        : D3DXLoadMeshHierarchyFromX(
+            file.wstring().c_str(),
+            D3DXMESH_MANAGED,
+            device,
+            &alloc,
+            nullptr,
+            &rootFrame,
+            &animController);
     
     if (FAILED(hr)) {
         throw std::runtime_error("Failed to load X file");
@@ -46,23 +66,20 @@ std::map<std::string, std::shared_ptr<ModelData>> XModelEnhanced::LoadWithSepara
     D3DXMatrixIdentity(&identity);
     CollectMeshes(rootFrame, meshes, identity, "");
     
-    // Build skeleton from frame hierarchy
-    Skeleton skeleton;
-    ExtractSkeleton(rootFrame, skeleton);
+    // Build skeleton from frame hierarchy (immutable once built, shared by every mesh below)
+    Skeleton extracted;
+    ExtractSkeleton(rootFrame, extracted);
+    auto skeleton = std::make_shared<const Skeleton>(std::move(extracted));
     
     // Convert each mesh to a separate ModelData
     std::map<std::string, std::shared_ptr<ModelData>> result;
     
     std::cout << "XModelEnhanced: Found " << meshes.size() << " meshes in X file" << std::endl;
     
+    std::vector<std::string> names = ModelNames(meshes);
     for (size_t i = 0; i < meshes.size(); ++i) {
         const auto& meshInfo = meshes[i];
-        
-        // Generate unique name if needed
-        std::string modelName = meshInfo.name;
-        if (modelName.empty()) {
-            modelName = GenerateUniqueName("Object", meshes);
-        }
+        const std::string& modelName = names[i];
         
         // Create ModelData for this mesh
         auto modelData = std::make_shared<ModelData>();
@@ -136,12 +153,7 @@ std::vector<std::string> XModelEnhanced::GetObjectNames(
             D3DXMatrixIdentity(&identity);
             CollectMeshes(rootFrame, meshes, identity, "");
             
-            // Extract names
-            for (const auto& mesh : meshes) {
-                if (!mesh.name.empty()) {
-                    names.push_back(mesh.name);
-                }
-            }
+            names = ModelNames(meshes);
             
             // Clean up
             alloc.DestroyFrame(rootFrame);
@@ -162,8 +174,10 @@ std::shared_ptr<ModelData> XModelEnhanced::LoadObject(
     const std::string& objectName,
     IDirect3DDevice9* device) {
     
-    // Load all objects and return the requested one
-    auto models = LoadWithSeparation(file, device);
+    // Only the object's frame subtree is decoded when the file has an object index;
+    // otherwise load all objects and return the requested one
+    std::optional<std::string> subset = ExtractXFileObject(file, objectName);
+    auto models = LoadHierarchy(file, subset ? &*subset : nullptr, device);
     
     auto it = models.find(objectName);
     if (it != models.end()) {
@@ -188,13 +202,14 @@ void XModelEnhanced::CollectMeshes(
     if (frame->pMeshContainer) {
         std::cout << "XModelEnhanced: Found mesh in frame: " << (frame->Name ? frame->Name : "<unnamed>") << std::endl;
         
-        MeshInfo info;
-        info.name = frame->Name ? frame->Name : "";
-        info.parentName = parentName;
-        info.transform = combinedTransform;
-        
         D3DXMESHCONTAINER* meshContainer = frame->pMeshContainer;
         while (meshContainer) {
+            MeshInfo info;
+            info.name = frame->Name ? frame->Name : "";
+            info.meshName = meshContainer->Name ? meshContainer->Name : "";
+            info.parentName = parentName;
+            info.transform = combinedTransform;
+            
             // Extract mesh data
             info.mesh = meshContainer->MeshData.pMesh;
             
@@ -257,16 +272,16 @@ void XModelEnhanced::CollectMeshes(
         }
     }
     
-    // Process siblings
-    if (frame->pFrameSibling) {
-        CollectMeshes(frame->pFrameSibling, meshes, parentTransform, parentName);
-    }
-    
-    // Process children
+    // Process children before siblings so meshes come out in file order (needed for mesh_N numbering)
     if (frame->pFrameFirstChild) {
         std::string currentName = frame->Name ? frame->Name : "";
         CollectMeshes(frame->pFrameFirstChild, meshes, combinedTransform, currentName);
     }
+    
+    // Process siblings
+    if (frame->pFrameSibling) {
+        CollectMeshes(frame->pFrameSibling, meshes, parentTransform, parentName);
+    }
 }
 
 void XModelEnhanced::ConvertToSkinMesh(
@@ -506,26 +521,11 @@ void XModelEnhanced::ExtractSkeleton(
     }
 }
 
-std::string XModelEnhanced::GenerateUniqueName(
-    const std::string& baseName,
-    const std::vector<MeshInfo>& existingMeshes) {
-    
-    std::string uniqueName = baseName;
-    int counter = 1;
-    
-    // Check if name already exists
-    auto nameExists = [&](const std::string& name) {
-        for (const auto& mesh : existingMeshes) {
-            if (mesh.name == name) {
-                return true;
-            }
-        }
-        return false;
-    };
-    
-    while (nameExists(uniqueName)) {
-        uniqueName = baseName + "_" + std::to_string(counter++);
+std::vector<std::string> XModelEnhanced::ModelNames(const std::vector<MeshInfo>& meshes) {
+    std::vector<XFileMeshInfo> infos(meshes.size());
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        infos[i].frameName = meshes[i].name;
+        infos[i].meshName = meshes[i].meshName;
     }
-    
-    return uniqueName;
-}
\ No newline at end of file
+    return XFileModelNames(infos);
+}
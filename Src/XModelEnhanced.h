@@ -12,7 +12,8 @@ class XModelEnhanced {
 public:
     // Structure to hold information about each mesh in the X file
     struct MeshInfo {
-        std::string name;
+        std::string name;           // Owning frame name (empty for unnamed frames)
+        std::string meshName;       // Mesh object name from the file (may be empty)
         std::string parentName;
         D3DXMATRIX transform;
         ID3DXMesh* mesh = nullptr;
@@ -32,13 +33,21 @@ public:
         const std::filesystem::path& file,
         IDirect3DDevice9* device);
     
-    // Load specific object by name
+    // Load specific object by name.
+    // Uses the <file>.objidx object index to decode only that object's frame subtree;
+    // falls back to a full load for skinned/animated files or unindexed objects.
     static std::shared_ptr<ModelData> LoadObject(
         const std::filesystem::path& file,
         const std::string& objectName,
         IDirect3DDevice9* device);
 
 private:
+    // Shared by LoadWithSeparation and LoadObject; xfileData (optional) is an in-memory .x subset
+    static std::map<std::string, std::shared_ptr<ModelData>> LoadHierarchy(
+        const std::filesystem::path& file,
+        const std::string* xfileData,
+        IDirect3DDevice9* device);
+    
     // Helper to traverse frame hierarchy and collect meshes
     static void CollectMeshes(
         D3DXFRAME* frame,
@@ -58,8 +67,7 @@ private:
         Skeleton& skeleton,
         int parentIndex = -1);
     
-    // Helper to generate unique names for unnamed meshes
-    static std::string GenerateUniqueName(
-        const std::string& baseName,
-        const std::vector<MeshInfo>& existingMeshes);
+    // Model names for the collected meshes, same rule as XFileModelNames
+    // (frame name, else mesh name, else mesh_N; duplicates get a _N suffix)
+    static std::vector<std::string> ModelNames(const std::vector<MeshInfo>& meshes);
 };
\ No newline at end of file
@@ -1,4 +1,5 @@
 ﻿#include "XModelEnhancedLoader.h"
+#include "ModelMetadata.h"
 #include <iostream>
 
 std::map<std::string, ModelData> XModelEnhancedLoader::Load(
@@ -11,10 +12,10 @@ std::map<std::string, ModelData> XModelEnhancedLoader::Load(
         // Use XModelEnhanced to load with separation
         auto models = XModelEnhanced::LoadWithSeparation(file, device);
         
-        // Convert shared_ptr<ModelData> to ModelData
-        for (const auto& [name, modelPtr] : models) {
+        // The returned shared_ptrs are the only owners, so move the data out instead of copying
+        for (auto& [name, modelPtr] : models) {
             if (modelPtr) {
-                result[name] = *modelPtr;
+                result[name] = std::move(*modelPtr);
             }
         }
     }
@@ -25,25 +26,34 @@ std::map<std::string, ModelData> XModelEnhancedLoader::Load(
     return result;
 }
 
-std::vector<std::string> XModelEnhancedLoader::GetModelNames(
-    const std::filesystem::path& file) const {
+std::map<std::string, ModelData> XModelEnhancedLoader::LoadObject(
+    const std::filesystem::path& file,
+    const std::string& objectName,
+    IDirect3DDevice9* device) const {
     
-    // For now, we need to actually load the file to get names
-    // This could be optimized later to just parse the file structure
-    std::vector<std::string> names;
+    std::map<std::string, ModelData> result;
     
     try {
-        // Create a temporary device for loading
-        // Note: This is not ideal, but GetObjectNames requires a device
-        // In a real implementation, we might want to parse the file directly
-        IDirect3DDevice9* device = nullptr;
-        // TODO: Get device from somewhere or parse file without loading
-        
-        names = XModelEnhanced::GetObjectNames(file, device);
+        if (auto model = XModelEnhanced::LoadObject(file, objectName, device)) {
+            result[objectName] = std::move(*model);
+        }
     }
     catch (const std::exception& e) {
-        std::cerr << "XModelEnhancedLoader: Failed to get names from " << file << ": " << e.what() << std::endl;
+        std::cerr << "XModelEnhancedLoader: Failed to load " << objectName << " from " << file << ": " << e.what() << std::endl;
+    }
+    
+    return result;
+}
+
+std::vector<std::string> XModelEnhancedLoader::GetModelNames(
+    const std::filesystem::path& file) const {
+    
+    // Skim the frame/mesh structure only; no device or mesh creation needed.
+    // Same names as XModelEnhanced::GetObjectNames (XFileModelNames rule, one per mesh).
+    std::vector<std::string> names;
+    for (auto& info : ScanXFileMetadata(file)) {
+        names.push_back(std::move(info.name));
     }
     
     return names;
-}
\ No newline at end of file
+}
@@ -3,15 +3,21 @@
 #include <map>
 #include <string>
 #include "IModelLoader.h"
+#include "IPartialModelLoader.h"
 #include "ModelData.h"
 #include "XModelEnhanced.h"
 
 // IModelLoader implementation for XModelEnhanced
-class XModelEnhancedLoader : public IModelLoader {
+class XModelEnhancedLoader : public IModelLoader, public IPartialModelLoader {
 public:
     [[nodiscard]] std::map<std::string, ModelData>
         Load(const std::filesystem::path& file, IDirect3DDevice9* device) const override;
     
     [[nodiscard]] std::vector<std::string>
         GetModelNames(const std::filesystem::path& file) const override;
+    
+    // Loads a single object through XModelEnhanced::LoadObject
+    [[nodiscard]] std::map<std::string, ModelData>
+        LoadObject(const std::filesystem::path& file, const std::string& objectName,
+                   IDirect3DDevice9* device) const override;
 };
\ No newline at end of file
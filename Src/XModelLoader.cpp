@@ -1,28 +1,25 @@
 ﻿#include "XModelLoader.h"
 #include "AllocateHierarchy.h"
+#include "ModelMetadata.h"
 #include "Utilities.h"
 #include "SkinMeshFactory.h"
+#include "XFileObjectIndex.h"
+#include "XFileParser.h"
 #include <DirectXMath.h>
 #include <d3dx9.h>
 #include <format>
+#include <optional>
 #include <stdexcept>
 
-std::map<std::string, ModelData> XModelLoader::Load(
-  const std::filesystem::path& file,
-  IDirect3DDevice9* device) const {
-  if (!device) throw std::invalid_argument("device is null");
+namespace {
+
+// loadHierarchy 呼叫 D3DXLoadMeshHierarchyFromX 或其記憶體版本，其餘轉換流程相同
+template <typename LoadFn>
+std::map<std::string, ModelData> LoadFromHierarchy(IDirect3DDevice9* device, LoadFn&& loadHierarchy) {
   AllocateHierarchy alloc(device);
   ID3DXAnimationController* animCtrl = nullptr;
   FrameEx* root = nullptr;
-  HRESULT hr = D3DXLoadMeshHierarchyFromX(
-    file.wstring().c_str(),
-    D3DXMESH_MANAGED,
-    device,
-    &alloc,
-    nullptr,
-    reinterpret_cast<D3DXFRAME**>(&root),
-    &animCtrl
-  );
+  HRESULT hr = loadHierarchy(alloc, reinterpret_cast<D3DXFRAME**>(&root), &animCtrl);
   if (FAILED(hr)) throw std::runtime_error(std::format("Load X failed: 0x{:X}", hr));
 
   DirectX::XMMATRIX identity = DirectX::XMMatrixIdentity();
@@ -35,100 +32,94 @@ std::map<std::string, ModelData> XModelLoader::Load(
   skel.joints.reserve(frames.size());
   for (size_t i = 0; i < frames.size(); ++i) {
     std::string jointName = frames[i]->Name ? frames[i]->Name : "unnamed_joint_" + std::to_string(i);
-    skel.joints.push_back({ jointName, parents[i] });
+    skel.joints.push_back({ std::move(jointName), parents[i] });
   }
+  // 所有網格共用同一份骨架
+  auto skeleton = std::make_shared<const Skeleton>(std::move(skel));
 
-  std::map<std::string, ModelData> result;
-  int meshIndex = 0;
+  // 依檔案順序列出所有 Mesh（同一 Frame 的多個 Mesh 串在 pNextMeshContainer），命名規則與 XFileModelNames 相同
+  std::vector<MeshContainerEx*> containers;
+  std::vector<XFileMeshInfo> infos;
   for (auto* f : frames) {
-    if (!f->pMeshContainer) continue;
-    auto* mc = reinterpret_cast<MeshContainerEx*>(f->pMeshContainer);
+    for (auto* mc = f->pMeshContainer; mc; mc = mc->pNextMeshContainer) {
+      containers.push_back(reinterpret_cast<MeshContainerEx*>(mc));
+      XFileMeshInfo& info = infos.emplace_back();
+      info.frameName = f->Name ? f->Name : "";
+      info.meshName = mc->Name ? mc->Name : "";
+    }
+  }
+  std::vector<std::string> names = XFileModelNames(infos);
+
+  std::map<std::string, ModelData> result;
+  for (size_t i = 0; i < containers.size(); ++i) {
     ModelData md;
-    md.mesh = CreateSkinMesh(device, mc);
-    md.skeleton = skel;
+    md.mesh = CreateSkinMesh(device, containers[i]);
+    md.skeleton = skeleton;
     md.animController = std::shared_ptr<ID3DXAnimationController>(animCtrl, [](auto*) {});
-    
-    std::string meshName = f->Name ? f->Name : "mesh_" + std::to_string(meshIndex++);
-    result[meshName] = md;
+    result[names[i]] = std::move(md);
   }
 
   alloc.DestroyFrame(reinterpret_cast<D3DXFRAME*>(root));
   return result;
 }
 
-std::vector<std::string> XModelLoader::GetModelNames(
-  const std::filesystem::path& file) const {
-  
-  // 創建一個臨時設備來進行檢查 (這個實作比較簡化)
-  // 實際應用中可能需要更輕量級的方法來解析 .x 檔案結構
-  
-  // 為了簡化實作，我們先載入檔案然後提取名稱
-  // 注意：這需要一個有效的 D3D 設備，在實際應用中應該有更好的方法
-  
-  std::vector<std::string> modelNames;
-  
-  try {
-    // 建立一個簡單的 D3D 實例來解析檔案結構
-    IDirect3D9* d3d = Direct3DCreate9(D3D_SDK_VERSION);
-    if (!d3d) return modelNames;
-    
-    D3DPRESENT_PARAMETERS pp = {};
-    pp.Windowed = TRUE;
-    pp.SwapEffect = D3DSWAPEFFECT_DISCARD;
-    pp.BackBufferFormat = D3DFMT_UNKNOWN;
-    pp.hDeviceWindow = GetDesktopWindow();
-    
-    IDirect3DDevice9* tempDevice = nullptr;
-    HRESULT hr = d3d->CreateDevice(
-      D3DADAPTER_DEFAULT,
-      D3DDEVTYPE_REF, // 使用參考設備，速度慢但相容性好
-      GetDesktopWindow(),
-      D3DCREATE_SOFTWARE_VERTEXPROCESSING,
-      &pp,
-      &tempDevice
-    );
-    
-    if (SUCCEEDED(hr) && tempDevice) {
-      AllocateHierarchy alloc(tempDevice);
-      ID3DXAnimationController* animCtrl = nullptr;
-      FrameEx* root = nullptr;
-      
-      hr = D3DXLoadMeshHierarchyFromX(
+} // namespace
+
+std::map<std::string, ModelData> XModelLoader::Load(
+  const std::filesystem::path& file,
+  IDirect3DDevice9* device) const {
+  if (!device) throw std::invalid_argument("device is null");
+  return LoadFromHierarchy(device,
+    [&](AllocateHierarchy& alloc, D3DXFRAME** root, ID3DXAnimationController** animCtrl) {
+      return D3DXLoadMeshHierarchyFromX(
         file.wstring().c_str(),
         D3DXMESH_MANAGED,
-        tempDevice,
+        device,
         &alloc,
         nullptr,
-        reinterpret_cast<D3DXFRAME**>(&root),
-        &animCtrl
+        root,
+        animCtrl
       );
-      
-      if (SUCCEEDED(hr)) {
-        DirectX::XMMATRIX identity = DirectX::XMMatrixIdentity();
-        UpdateCombined(root, identity);
-        std::vector<FrameEx*> frames;
-        std::vector<int> parents;
-        CollectFrames(root, frames, parents, -1);
-        
-        // 收集所有包含 mesh 的 frame 名稱
-        for (auto* f : frames) {
-          if (f->pMeshContainer) {
-            modelNames.push_back(f->Name);
-          }
-        }
-        
-        alloc.DestroyFrame(reinterpret_cast<D3DXFRAME*>(root));
-      }
-      
-      if (animCtrl) animCtrl->Release();
-      tempDevice->Release();
-    }
-    
-    d3d->Release();
+    });
+}
+
+std::map<std::string, ModelData> XModelLoader::LoadObject(
+  const std::filesystem::path& file,
+  const std::string& objectName,
+  IDirect3DDevice9* device) const {
+  if (!device) throw std::invalid_argument("device is null");
+
+  // 有物件索引時只把該物件的子樹交給 D3DX，其他物件不會被解碼或建立網格
+  std::optional<std::string> subset = ExtractXFileObject(file, objectName);
+  auto models = subset
+    ? LoadFromHierarchy(device,
+        [&](AllocateHierarchy& alloc, D3DXFRAME** root, ID3DXAnimationController** animCtrl) {
+          return D3DXLoadMeshHierarchyFromXInMemory(
+            subset->data(),
+            static_cast<DWORD>(subset->size()),
+            D3DXMESH_MANAGED,
+            device,
+            &alloc,
+            nullptr,
+            root,
+            animCtrl
+          );
+        })
+    : Load(file, device);
+
+  std::map<std::string, ModelData> result;
+  if (auto it = models.find(objectName); it != models.end()) {
+    result.emplace(objectName, std::move(it->second));
   }
-  catch (...) {
-    // 如果解析失敗，返回空列表
+  return result;
+}
+
+std::vector<std::string> XModelLoader::GetModelNames(
+  const std::filesystem::path& file) const {
+  // 只略讀檔案結構，不需要裝置也不建立任何網格
+  std::vector<std::string> modelNames;
+  for (auto& info : ScanXFileMetadata(file)) {
+    modelNames.push_back(std::move(info.name));
   }
-  
   return modelNames;
 }
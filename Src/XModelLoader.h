@@ -3,13 +3,19 @@
 #include <map>
 #include <string>
 #include "IModelLoader.h"
+#include "IPartialModelLoader.h"
 #include "ModelData.h"
 
-class XModelLoader : public IModelLoader {
+class XModelLoader : public IModelLoader, public IPartialModelLoader {
 public:
   [[nodiscard]] std::map<std::string, ModelData>
     Load(const std::filesystem::path& file, IDirect3DDevice9* device) const override;
   
   [[nodiscard]] std::vector<std::string>
     GetModelNames(const std::filesystem::path& file) const override;
+
+  // 依 <檔名>.objidx 物件索引只載入 objectName 所在 Frame 的子樹；無法部分載入時完整載入
+  [[nodiscard]] std::map<std::string, ModelData>
+    LoadObject(const std::filesystem::path& file, const std::string& objectName,
+               IDirect3DDevice9* device) const override;
 };
@@ -0,0 +1,355 @@
+﻿#include "XNativeModelLoader.h"
+#include "AssetDependencyGraph.h"
+#include "ModelMetadata.h"
+#include "XFileObjectIndex.h"
+#include <DirectXMath.h>
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace DirectX;
+
+namespace {
+
+XMFLOAT4X4 ToFloat4x4(const XFileMatrix& m) {
+  XMFLOAT4X4 out;
+  std::memcpy(&out, m.m, sizeof(out));
+  return out;
+}
+
+// 每個頂點最多保留權重最大的 4 個骨骼影響
+struct VertexInfluences {
+  uint8_t joints[4] = {};
+  float weights[4] = {};
+  int count = 0;
+
+  void Add(uint8_t joint, float weight) {
+    int slot;
+    if (count < 4) {
+      slot = count++;
+    } else if (weight > weights[3]) {
+      slot = 3;
+    } else {
+      return;
+    }
+    joints[slot] = joint;
+    weights[slot] = weight;
+    // 插入排序，維持權重由大到小
+    for (int i = slot; i > 0 && weights[i] > weights[i - 1]; --i) {
+      std::swap(weights[i], weights[i - 1]);
+      std::swap(joints[i], joints[i - 1]);
+    }
+  }
+};
+
+std::vector<VertexInfluences> CollectInfluences(
+  const XFileMesh& mesh, const std::unordered_map<std::string, int>& jointIndex) {
+  std::vector<VertexInfluences> influences;
+  if (mesh.skinWeights.empty()) {
+    return influences;
+  }
+  influences.resize(mesh.positions.size());
+  for (const auto& skin : mesh.skinWeights) {
+    auto joint = jointIndex.find(skin.boneName);
+    if (joint == jointIndex.end() || joint->second > 255) {
+      continue;   // Vertex::boneIndices 為 8 位元
+    }
+    for (size_t i = 0; i < skin.vertexIndices.size(); ++i) {
+      uint32_t v = skin.vertexIndices[i];
+      if (v < influences.size() && skin.weights[i] > 0.0f) {
+        influences[v].Add(static_cast<uint8_t>(joint->second), skin.weights[i]);
+      }
+    }
+  }
+  return influences;
+}
+
+Vertex MakeVertex(const XFileMesh& src, uint32_t position, const XFileVector3* normal,
+                  const std::vector<VertexInfluences>& influences) {
+  Vertex v{};
+  const auto& p = src.positions[position];
+  v.pos = XMFLOAT3(p.x, p.y, p.z);
+  v.norm = normal ? XMFLOAT3(normal->x, normal->y, normal->z) : XMFLOAT3(0, 1, 0);
+  v.col = 0xFFFFFFFF;
+  v.spec = 0;
+  if (position < src.uvs.size()) {
+    v.uv = XMFLOAT2(src.uvs[position].u, src.uvs[position].v);
+  }
+
+  if (position < influences.size() && influences[position].count > 0) {
+    const auto& inf = influences[position];
+    float total = 0;
+    for (int i = 0; i < inf.count; ++i) {
+      total += inf.weights[i];
+    }
+    float w[4] = {};
+    for (int i = 0; i < inf.count; ++i) {
+      w[i] = inf.weights[i] / total;
+      v.boneIndices[i] = inf.joints[i];
+    }
+    v.weights = XMFLOAT4(w[0], w[1], w[2], w[3]);
+  } else {
+    v.weights = XMFLOAT4(1, 0, 0, 0);
+  }
+  return v;
+}
+
+void BuildMesh(const XFileMesh& src, const std::vector<VertexInfluences>& influences, SkinMesh& dst) {
+  const bool hasNormals = !src.normalIndices.empty();
+  const bool sharedIndices = hasNormals && src.normalIndices == src.indices;
+
+  if (!hasNormals || sharedIndices) {
+    // 位置與法線共用索引：頂點一對一轉換
+    dst.vertices.reserve(src.positions.size());
+    for (uint32_t i = 0; i < src.positions.size(); ++i) {
+      const XFileVector3* normal = sharedIndices && i < src.normals.size() ? &src.normals[i] : nullptr;
+      dst.vertices.push_back(MakeVertex(src, i, normal, influences));
+    }
+    dst.indices = src.indices;
+  } else {
+    // 法線有獨立索引：依 (位置, 法線) 組合拆分頂點
+    std::unordered_map<uint64_t, uint32_t> remap;
+    remap.reserve(src.indices.size());
+    dst.vertices.reserve(src.positions.size());
+    dst.indices.reserve(src.indices.size());
+    for (size_t i = 0; i < src.indices.size(); ++i) {
+      uint64_t key = (static_cast<uint64_t>(src.indices[i]) << 32) | src.normalIndices[i];
+      auto [it, inserted] = remap.try_emplace(key, static_cast<uint32_t>(dst.vertices.size()));
+      if (inserted) {
+        dst.vertices.push_back(MakeVertex(src, src.indices[i], &src.normals[src.normalIndices[i]], influences));
+      }
+      dst.indices.push_back(it->second);
+    }
+  }
+
+  dst.materials.reserve(src.materials.size());
+  for (const auto& m : src.materials) {
+    Material material{};
+    material.mat.Diffuse = { m.diffuse[0], m.diffuse[1], m.diffuse[2], m.diffuse[3] };
+    material.mat.Specular = { m.specular[0], m.specular[1], m.specular[2], 1.0f };
+    material.mat.Emissive = { m.emissive[0], m.emissive[1], m.emissive[2], 1.0f };
+    material.mat.Power = m.power;
+    material.textureFileName = m.textureFileName;
+    dst.materials.push_back(std::move(material));
+  }
+}
+
+// 依 tick 取樣：關鍵影格之間線性內插（旋轉使用 slerp），超出範圍時取端點
+template <typename Key, typename Lerp>
+auto SampleKeys(const std::vector<Key>& keys, uint32_t time, Lerp lerp) {
+  auto next = std::lower_bound(keys.begin(), keys.end(), time,
+    [](const Key& key, uint32_t t) { return key.time < t; });
+  if (next == keys.begin()) {
+    return lerp(*next, *next, 0.0f);
+  }
+  if (next == keys.end()) {
+    return lerp(keys.back(), keys.back(), 0.0f);
+  }
+  auto prev = next - 1;
+  float t = float(time - prev->time) / float(next->time - prev->time);
+  return lerp(*prev, *next, t);
+}
+
+// 將一個 Frame 的 SRT 或矩陣關鍵影格轉為區域變換矩陣序列（時間單位：秒）
+std::vector<SkeletonAnimationKey> ConvertAnimation(
+  const XFileAnimation& animation, const XFileMatrix& rest, float ticksPerSecond) {
+  std::vector<SkeletonAnimationKey> result;
+
+  if (!animation.matrixKeys.empty()) {
+    result.reserve(animation.matrixKeys.size());
+    for (const auto& key : animation.matrixKeys) {
+      result.push_back({ key.time / ticksPerSecond, ToFloat4x4(key.value) });
+    }
+    return result;
+  }
+
+  std::vector<uint32_t> times;
+  times.reserve(animation.rotationKeys.size() + animation.scaleKeys.size() + animation.positionKeys.size());
+  for (const auto& k : animation.rotationKeys) times.push_back(k.time);
+  for (const auto& k : animation.scaleKeys) times.push_back(k.time);
+  for (const auto& k : animation.positionKeys) times.push_back(k.time);
+  std::sort(times.begin(), times.end());
+  times.erase(std::unique(times.begin(), times.end()), times.end());
+
+  // 沒有對應軌道的成分沿用 Frame 靜止姿勢
+  XMFLOAT4X4 restMatrix = ToFloat4x4(rest);
+  XMVECTOR restScale, restRotation, restTranslation;
+  if (!XMMatrixDecompose(&restScale, &restRotation, &restTranslation, XMLoadFloat4x4(&restMatrix))) {
+    restScale = XMVectorSplatOne();
+    restRotation = XMQuaternionIdentity();
+    restTranslation = XMVectorSet(restMatrix._41, restMatrix._42, restMatrix._43, 0);
+  }
+
+  auto lerpVector = [](const XFileVectorKey& a, const XFileVectorKey& b, float t) {
+    return XMVectorLerp(XMVectorSet(a.value.x, a.value.y, a.value.z, 0),
+                        XMVectorSet(b.value.x, b.value.y, b.value.z, 0), t);
+  };
+  auto slerp = [](const XFileQuaternionKey& a, const XFileQuaternionKey& b, float t) {
+    return XMQuaternionSlerp(XMVectorSet(a.x, a.y, a.z, a.w), XMVectorSet(b.x, b.y, b.z, b.w), t);
+  };
+
+  result.reserve(times.size());
+  for (uint32_t time : times) {
+    XMVECTOR s = animation.scaleKeys.empty() ? restScale : SampleKeys(animation.scaleKeys, time, lerpVector);
+    XMVECTOR r = animation.rotationKeys.empty() ? restRotation : SampleKeys(animation.rotationKeys, time, slerp);
+    XMVECTOR t = animation.positionKeys.empty() ? restTranslation : SampleKeys(animation.positionKeys, time, lerpVector);
+
+    XMMATRIX m = XMMatrixScalingFromVector(s) *
+                 XMMatrixRotationQuaternion(XMQuaternionNormalize(r)) *
+                 XMMatrixTranslationFromVector(t);
+    SkeletonAnimationKey key;
+    key.time = time / ticksPerSecond;
+    XMStoreFloat4x4(&key.transform, m);
+    result.push_back(key);
+  }
+  return result;
+}
+
+Skeleton BuildSkeleton(const XFileScene& scene, std::unordered_map<std::string, int>& jointIndex) {
+  Skeleton skeleton;
+  skeleton.joints.reserve(scene.frames.size());
+  XMFLOAT4X4 identity;
+  XMStoreFloat4x4(&identity, XMMatrixIdentity());
+  for (size_t i = 0; i < scene.frames.size(); ++i) {
+    const auto& frame = scene.frames[i];
+    std::string name = frame.name.empty() ? "unnamed_joint_" + std::to_string(i) : frame.name;
+    jointIndex.emplace(name, static_cast<int>(i));
+    skeleton.joints.push_back({ std::move(name), frame.parent, identity });
+  }
+
+  // bind pose 反矩陣來自 SkinWeights 的 matrixOffset
+  for (const auto& mesh : scene.meshes) {
+    for (const auto& skin : mesh.skinWeights) {
+      auto it = jointIndex.find(skin.boneName);
+      if (it != jointIndex.end()) {
+        skeleton.joints[it->second].bindPoseInverse = ToFloat4x4(skin.offset);
+      }
+    }
+  }
+
+  const float ticksPerSecond = static_cast<float>(std::max<uint32_t>(scene.ticksPerSecond, 1));
+  for (const auto& set : scene.animationSets) {
+    SkeletonAnimation animation;
+    animation.name = set.name;
+    animation.duration = 0;
+    animation.channels.assign(skeleton.joints.size(), {});
+    for (const auto& track : set.animations) {
+      auto it = jointIndex.find(track.frameName);
+      if (it == jointIndex.end()) {
+        continue;
+      }
+      auto& channel = animation.channels[it->second];
+      channel = ConvertAnimation(track, scene.frames[it->second].transform, ticksPerSecond);
+      if (!channel.empty()) {
+        animation.duration = std::max(animation.duration, channel.back().time);
+      }
+    }
+    skeleton.animations.push_back(std::move(animation));
+  }
+  return skeleton;
+}
+
+} // namespace
+
+std::map<std::string, ModelData> XNativeModelLoader::BuildModels(const XFileScene& scene) {
+  std::unordered_map<std::string, int> jointIndex;
+  auto skeleton = std::make_shared<const Skeleton>(BuildSkeleton(scene, jointIndex));
+  std::vector<std::string> names = XFileModelNames(scene);
+
+  std::map<std::string, ModelData> result;
+  for (size_t i = 0; i < scene.meshes.size(); ++i) {
+    const auto& src = scene.meshes[i];
+    if (src.indices.empty()) {
+      continue;
+    }
+    ModelData md;
+    BuildMesh(src, CollectInfluences(src, jointIndex), md.mesh);
+    md.skeleton = skeleton;
+    result.emplace(names[i], std::move(md));
+  }
+  return result;
+}
+
+namespace {
+
+void CreateDeviceResources(const std::filesystem::path& file,
+                           std::map<std::string, ModelData>& models,
+                           IDirect3DDevice9* device) {
+  for (auto& [name, md] : models) {
+    if (!md.mesh.CreateBuffers(device)) {
+      throw std::runtime_error(std::format("XNativeModelLoader: 建立緩衝區失敗 {}", name));
+    }
+    // 與 GltfModelLoader 相同，以第一個有貼圖的材質作為網格貼圖
+    auto textured = std::find_if(md.mesh.materials.begin(), md.mesh.materials.end(),
+      [](const Material& m) { return !m.textureFileName.empty(); });
+    if (textured != md.mesh.materials.end()) {
+      md.mesh.SetTexture(device, ResolveDependencyPath(file, textured->textureFileName));
+    }
+  }
+}
+
+} // namespace
+
+std::map<std::string, ModelData> XNativeModelLoader::Load(
+  const std::filesystem::path& file,
+  IDirect3DDevice9* device) const {
+  auto result = BuildModels(ParseXFile(file));
+  if (device) {
+    CreateDeviceResources(file, result, device);
+  }
+  return result;
+}
+
+std::map<std::string, ModelData> XNativeModelLoader::LoadObject(
+  const std::filesystem::path& file,
+  const std::string& objectName,
+  IDirect3DDevice9* device) const {
+  std::optional<std::string> subset = ExtractXFileObject(file, objectName);
+  auto models = BuildModels(subset ? ParseXFileMemory(subset->data(), subset->size()) : ParseXFile(file));
+
+  std::map<std::string, ModelData> result;
+  if (auto it = models.find(objectName); it != models.end()) {
+    result.emplace(objectName, std::move(it->second));
+  }
+  if (device) {
+    CreateDeviceResources(file, result, device);
+  }
+  return result;
+}
+
+ImportPipelineStats XNativeModelLoader::ImportFiles(
+  const std::vector<std::filesystem::path>& files,
+  IDirect3DDevice9* device,
+  const LoadedCallback& onLoaded,
+  const ImportPipelineOptions& options) {
+  ImportPipeline<XFileScene, std::map<std::string, ModelData>> pipeline(
+    [](const std::filesystem::path&, std::vector<uint8_t>&& bytes) {
+      return ParseXFileMemory(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    },
+    [](const std::filesystem::path&, XFileScene&& scene) {
+      return BuildModels(scene);
+    },
+    [&](const std::filesystem::path& file, std::map<std::string, ModelData>&& models) {
+      if (device) {
+        CreateDeviceResources(file, models, device);
+      }
+      if (onLoaded) {
+        onLoaded(file, std::move(models));
+      }
+    },
+    options);
+  return pipeline.Run(files);
+}
+
+std::vector<std::string> XNativeModelLoader::GetModelNames(
+  const std::filesystem::path& file) const {
+  // 只略讀結構，不解碼頂點資料；沒有三角形的 Mesh 與 BuildModels 一樣不列出
+  std::vector<std::string> names;
+  for (auto& info : ScanXFileMetadata(file)) {
+    names.push_back(std::move(info.name));
+  }
+  return names;
+}
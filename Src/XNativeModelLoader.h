@@ -0,0 +1,40 @@
+﻿#pragma once
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include "IModelLoader.h"
+#include "IPartialModelLoader.h"
+#include "ImportPipeline.h"
+#include "ModelData.h"
+#include "XFileParser.h"
+
+// 不經過 D3DX 的 .x 載入器：以 XFileParser 剖析後直接填入 ModelData
+// device 為 nullptr 時只建立 CPU 端資料（頂點、索引、材質、骨架與動畫），
+// 可用於離線烘焙與驗證；有 device 時再建立緩衝區與貼圖
+class XNativeModelLoader : public IModelLoader, public IPartialModelLoader {
+public:
+  [[nodiscard]] std::map<std::string, ModelData>
+    Load(const std::filesystem::path& file, IDirect3DDevice9* device) const override;
+
+  [[nodiscard]] std::vector<std::string>
+    GetModelNames(const std::filesystem::path& file) const override;
+
+  // 有物件索引時只剖析 objectName 所在 Frame 的子樹（骨架也只含該子樹與其祖先）
+  [[nodiscard]] std::map<std::string, ModelData>
+    LoadObject(const std::filesystem::path& file, const std::string& objectName,
+               IDirect3DDevice9* device) const override;
+
+  // 將剖析結果轉為 ModelData（不建立任何裝置資源）
+  // 每個有三角形的 Mesh 一個模型，名稱由 XFileModelNames 決定（XModelLoader、XModelEnhanced 與 ScanXFileMetadata 相同）
+  [[nodiscard]] static std::map<std::string, ModelData> BuildModels(const XFileScene& scene);
+
+  // 以 ImportPipeline 匯入多個檔案：讀檔、剖析與 BuildModels 在背景執行緒進行，
+  // 緩衝區與貼圖（device 不為 nullptr 時）在呼叫端執行緒建立，每個檔案完成後交給 onLoaded
+  // 無法匯入的檔案不會呼叫 onLoaded，而是列在回傳統計的 failures 中
+  using LoadedCallback = std::function<void(const std::filesystem::path&, std::map<std::string, ModelData>&&)>;
+  static ImportPipelineStats ImportFiles(const std::vector<std::filesystem::path>& files,
+                                         IDirect3DDevice9* device, const LoadedCallback& onLoaded,
+                                         const ImportPipelineOptions& options = {});
+};
@@ -0,0 +1,269 @@
+#include "AlphaMask.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+// UIManager::IsPointInTransparentArea 的遮罩記憶體、建立時間與每次點擊測試的延遲
+// 改寫前：鎖定貼圖後逐像素填 std::vector<bool>，再走一遍計算透明比例；查詢以浮點比例換算座標
+// 改寫後：AlphaMask（8x8 區塊表 + 混合區塊的像素字）；查詢以整數比例換算座標
+// 每張圖以 1.5 倍縮放繪製，在元件範圍內隨機點擊；並逐像素確認兩者在 1:1 時結果相同
+// 用法：AlphaMaskBench [圖片或目錄]...（沒有參數時使用產生的 UI 圖片）
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr int kHits = 200000;
+
+struct Rect {
+    int left, top, right, bottom;
+};
+
+struct Image {
+    std::string name;
+    TextureImage pixels;
+    AlphaMaskRule rule;
+};
+
+// 改寫前 UIManager::BuildAlphaMask 的結果與查詢
+struct LegacyMask {
+    int width = 0;
+    int height = 0;
+    std::vector<bool> mask;
+    float transparentRatio = 0.0f;
+
+    size_t MemoryBytes() const { return sizeof(*this) + mask.capacity() / 8; }
+};
+
+LegacyMask BuildLegacy(const Image& image) {
+    LegacyMask legacy;
+    legacy.width = int(image.pixels.width);
+    legacy.height = int(image.pixels.height);
+    legacy.mask.resize(size_t(legacy.width) * legacy.height, true);
+    for (int y = 0; y < legacy.height; ++y) {
+        for (int x = 0; x < legacy.width; ++x) {
+            const uint8_t* p = &image.pixels.rgba[(size_t(y) * legacy.width + x) * 4];
+            bool transparent = false;
+            if (image.rule == AlphaMaskRule::AlphaChannel) {
+                transparent = p[3] < AlphaMask::kAlphaThreshold;
+            } else if (image.rule == AlphaMaskRule::GreenColorKey) {
+                transparent = p[1] > 200 && p[0] < 100 && p[2] < 100;
+            }
+            legacy.mask[size_t(y) * legacy.width + x] = !transparent;
+        }
+    }
+    size_t transparentPixels = 0;
+    for (bool opaque : legacy.mask) {
+        transparentPixels += !opaque;
+    }
+    legacy.transparentRatio = float(transparentPixels) / float(legacy.mask.size());
+    return legacy;
+}
+
+bool LegacyTransparent(const LegacyMask& mask, int x, int y, const Rect& rect) {
+    if (x < rect.left || x >= rect.right || y < rect.top || y >= rect.bottom) {
+        return true;
+    }
+    const float u = float(x - rect.left) / float(rect.right - rect.left);
+    const float v = float(y - rect.top) / float(rect.bottom - rect.top);
+    const int texX = int(u * mask.width), texY = int(v * mask.height);
+    if (texX < 0 || texX >= mask.width || texY < 0 || texY >= mask.height) {
+        return true;
+    }
+    return !mask.mask[size_t(texY) * mask.width + texX];
+}
+
+// 與 UIManager::IsPointInTransparentArea 相同的換算
+bool MaskTransparent(const AlphaMask& mask, int x, int y, const Rect& rect) {
+    if (x < rect.left || x >= rect.right || y < rect.top || y >= rect.bottom) {
+        return true;
+    }
+    const int texX = (x - rect.left) * mask.Width() / (rect.right - rect.left);
+    const int texY = (y - rect.top) * mask.Height() / (rect.bottom - rect.top);
+    return !mask.IsOpaque(texX, texY);
+}
+
+// 仿 UI 素材的圖片：帶透明內框的面板、圓形圖示、綠色色彩鍵的對話框、不透明按鈕、鋸齒邊緣的文字圖
+std::vector<Image> GenerateImages() {
+    struct Spec {
+        const char* name;
+        int width, height;
+        AlphaMaskRule rule;
+    };
+    const Spec specs[] = {
+        { "panel.png", 800, 600, AlphaMaskRule::AlphaChannel },
+        { "frame.png", 1024, 768, AlphaMaskRule::AlphaChannel },
+        { "dialog.bmp", 512, 384, AlphaMaskRule::GreenColorKey },
+        { "icon48.png", 48, 48, AlphaMaskRule::AlphaChannel },
+        { "icon64.png", 64, 64, AlphaMaskRule::AlphaChannel },
+        { "icon256.png", 256, 256, AlphaMaskRule::AlphaChannel },
+        { "button.bmp", 120, 40, AlphaMaskRule::GreenColorKey },
+        { "title.png", 300, 80, AlphaMaskRule::AlphaChannel },
+    };
+    std::mt19937 rng(1);
+    std::vector<Image> images;
+    for (const Spec& spec : specs) {
+        Image image{ spec.name, {}, spec.rule };
+        const int w = spec.width, h = spec.height;
+        const std::string name = spec.name;
+        image.pixels.width = uint32_t(w);
+        image.pixels.height = uint32_t(h);
+        image.pixels.rgba.assign(size_t(w) * h * 4, 255);
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                bool transparent = false;
+                if (name.rfind("icon", 0) == 0) {
+                    const float dx = x - w / 2.0f, dy = y - h / 2.0f;
+                    transparent = dx * dx + dy * dy > (w / 2.0f) * (w / 2.0f);
+                } else if (name == "title.png") {
+                    // 字形：橫條間夾雜不規則的筆畫
+                    transparent = (y / 6 + x / 9) % 3 == 0 || (rng() % 5 == 0 && (x / 4 + y / 4) % 2 == 0);
+                } else if (name != "button.bmp") {
+                    transparent = x >= 20 && x < w - 20 && y >= 36 && y < h - 20;
+                }
+                uint8_t* p = &image.pixels.rgba[(size_t(y) * w + x) * 4];
+                if (!transparent) {
+                    p[0] = uint8_t(x * 3);
+                    p[1] = uint8_t(100 + y % 50);
+                    p[2] = uint8_t(y * 5);
+                } else if (spec.rule == AlphaMaskRule::GreenColorKey) {
+                    p[0] = 0;
+                    p[2] = 0;
+                } else {
+                    p[3] = uint8_t(rng() % AlphaMask::kAlphaThreshold);
+                }
+            }
+        }
+        images.push_back(std::move(image));
+    }
+    return images;
+}
+
+bool IsImageFile(const fs::path& file) {
+    std::string ext = file.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+    return ext == ".png" || ext == ".bmp" || ext == ".tga";
+}
+
+// 與 AlphaMaskService 相同的解碼方式；無法解碼的檔案略過
+void LoadImages(const fs::path& input, std::vector<Image>& images) {
+    std::vector<fs::path> files;
+    std::error_code ec;
+    if (fs::is_directory(input, ec)) {
+        for (const auto& entry : fs::recursive_directory_iterator(input, ec)) {
+            if (entry.is_regular_file() && IsImageFile(entry.path())) {
+                files.push_back(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+    } else {
+        files.push_back(input);
+    }
+    for (const fs::path& file : files) {
+        try {
+            MappedFile mapped(file);
+            TextureCookOptions options;
+            options.colorKeyBmp = false;
+            images.push_back({ file.filename().string(), DecodeTexture(file, mapped.bytes(), options),
+                               AlphaMaskRuleFor(file) });
+        } catch (const std::exception& e) {
+            std::fprintf(stderr, "skipped %s: %s\n", file.string().c_str(), e.what());
+        }
+    }
+}
+
+// 取三次中最快的一次
+template <typename Work>
+double BestNanoseconds(Work&& work) {
+    double best = 0.0;
+    for (int run = 0; run < 3; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        work();
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        best = run == 0 ? ns : (std::min)(best, ns);
+    }
+    return best;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<Image> images;
+    for (int i = 1; i < argc; ++i) {
+        LoadImages(argv[i], images);
+    }
+    if (argc == 1) {
+        images = GenerateImages();
+    }
+    if (images.empty()) {
+        std::fprintf(stderr, "no images to measure\n");
+        return 1;
+    }
+
+    std::mt19937 rng(7);
+    size_t legacyBytes = 0, maskBytes = 0, mismatches = 0;
+    double legacyBuildNs = 0.0, maskBuildNs = 0.0, legacyHitNs = 0.0, maskHitNs = 0.0;
+    std::printf("%-28s %9s  %9s %9s  %7s  %8s %8s  %7s %7s\n", "image", "size", "old B", "new B", "mixed",
+                "old ms", "new ms", "old ns", "new ns");
+    for (const Image& image : images) {
+        LegacyMask legacy;
+        AlphaMask mask;
+        const double legacyBuild = BestNanoseconds([&] { legacy = BuildLegacy(image); });
+        const double maskBuild = BestNanoseconds([&] { mask = AlphaMask::Build(image.pixels, image.rule); });
+
+        for (int y = 0; y < mask.Height(); ++y) {
+            for (int x = 0; x < mask.Width(); ++x) {
+                mismatches += legacy.mask[size_t(y) * legacy.width + x] != mask.IsOpaque(x, y);
+            }
+        }
+
+        const Rect rect{ 100, 50, 100 + mask.Width() * 3 / 2, 50 + mask.Height() * 3 / 2 };
+        std::vector<std::pair<int, int>> points(kHits);
+        for (auto& point : points) {
+            point.first = rect.left + int(rng() % uint32_t(rect.right - rect.left));
+            point.second = rect.top + int(rng() % uint32_t(rect.bottom - rect.top));
+        }
+        volatile size_t sink = 0;
+        const double legacyHit = BestNanoseconds([&] {
+            size_t transparent = 0;
+            for (const auto& [x, y] : points) {
+                transparent += LegacyTransparent(legacy, x, y, rect);
+            }
+            sink = sink + transparent;
+        }) / kHits;
+        const double maskHit = BestNanoseconds([&] {
+            size_t transparent = 0;
+            for (const auto& [x, y] : points) {
+                transparent += MaskTransparent(mask, x, y, rect);
+            }
+            sink = sink + transparent;
+        }) / kHits;
+
+        std::printf("%-28s %4dx%-4d  %9zu %9zu  %7zu  %8.3f %8.3f  %7.1f %7.1f\n", image.name.c_str(), mask.Width(),
+                    mask.Height(), legacy.MemoryBytes(), mask.MemoryBytes(), mask.MixedBlocks(), legacyBuild / 1e6,
+                    maskBuild / 1e6, legacyHit, maskHit);
+        legacyBytes += legacy.MemoryBytes();
+        maskBytes += mask.MemoryBytes();
+        legacyBuildNs += legacyBuild;
+        maskBuildNs += maskBuild;
+        legacyHitNs += legacyHit;
+        maskHitNs += maskHit;
+    }
+
+    const double count = double(images.size());
+    std::printf("%zu image(s): memory %.1f KB -> %.1f KB, build %.2f ms -> %.2f ms, hit %.1f ns -> %.1f ns (mean)\n",
+                images.size(), legacyBytes / 1024.0, maskBytes / 1024.0, legacyBuildNs / 1e6, maskBuildNs / 1e6,
+                legacyHitNs / count, maskHitNs / count);
+    if (mismatches != 0) {
+        std::fprintf(stderr, "%zu pixel(s) differ from the old mask\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,196 @@
+#include "AlphaMask.h"
+#include "TestCheck.h"
+#include "stb_image_write.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+TextureImage MakeImage(int width, int height) {
+    TextureImage image;
+    image.width = uint32_t(width);
+    image.height = uint32_t(height);
+    image.rgba.assign(size_t(width) * height * 4, 255);
+    return image;
+}
+
+// 與改寫前逐像素判斷相同的規則
+bool ExpectedOpaque(const TextureImage& image, int x, int y, AlphaMaskRule rule) {
+    const uint8_t* p = &image.rgba[(size_t(y) * image.width + x) * 4];
+    switch (rule) {
+    case AlphaMaskRule::AlphaChannel:
+        return p[3] >= AlphaMask::kAlphaThreshold;
+    case AlphaMaskRule::GreenColorKey:
+        return !(p[1] > 200 && p[0] < 100 && p[2] < 100);
+    default:
+        return true;
+    }
+}
+
+void CheckMatches(const TextureImage& image, AlphaMaskRule rule) {
+    const AlphaMask mask = AlphaMask::Build(image, rule);
+    CHECK(mask.Width() == int(image.width) && mask.Height() == int(image.height));
+    size_t opaque = 0;
+    for (int y = 0; y < mask.Height(); ++y) {
+        for (int x = 0; x < mask.Width(); ++x) {
+            const bool expected = ExpectedOpaque(image, x, y, rule);
+            CHECK(mask.IsOpaque(x, y) == expected);
+            opaque += expected;
+        }
+    }
+    CHECK(mask.OpaquePixels() == opaque);
+    CHECK(mask.TransparentPixels() == size_t(mask.Width()) * mask.Height() - opaque);
+    CHECK(!mask.IsOpaque(-1, 0) && !mask.IsOpaque(0, -1));
+    CHECK(!mask.IsOpaque(mask.Width(), 0) && !mask.IsOpaque(0, mask.Height()));
+}
+
+// 隨機大小（含不是 8 的倍數的邊緣區塊）與隨機透明區域，逐像素與原本規則比對
+void TestMatchesPerPixelRule() {
+    std::mt19937 rng(3);
+    for (int round = 0; round < 40; ++round) {
+        const int width = 1 + int(rng() % 90), height = 1 + int(rng() % 70);
+        TextureImage image = MakeImage(width, height);
+        const int cx = int(rng() % uint32_t(width)), cy = int(rng() % uint32_t(height));
+        const int radius = int(rng() % 40);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                uint8_t* p = &image.rgba[(size_t(y) * width + x) * 4];
+                const bool inside = (x - cx) * (x - cx) + (y - cy) * (y - cy) < radius * radius;
+                const bool noise = rng() % 23 == 0;
+                if (inside != noise) {
+                    p[0] = uint8_t(rng() % 100);
+                    p[2] = uint8_t(rng() % 100);
+                    p[3] = uint8_t(rng() % 64);
+                }
+            }
+        }
+        CheckMatches(image, AlphaMaskRule::AlphaChannel);
+        CheckMatches(image, AlphaMaskRule::GreenColorKey);
+    }
+}
+
+// 整張透明或整張不透明時不保留區塊資料；整塊的區域不產生混合區塊
+void TestUniformRegionsStoreNoPixels() {
+    TextureImage image = MakeImage(100, 60);
+    const AlphaMask opaque = AlphaMask::Build(image, AlphaMaskRule::AlphaChannel);
+    CHECK(opaque.OpaquePixels() == 6000 && opaque.IsOpaque(99, 59));
+    CHECK(opaque.MemoryBytes() == sizeof(AlphaMask));
+    CHECK(AlphaMask::Build(image, AlphaMaskRule::Opaque).MemoryBytes() == sizeof(AlphaMask));
+
+    for (size_t i = 3; i < image.rgba.size(); i += 4) {
+        image.rgba[i] = 0;
+    }
+    const AlphaMask transparent = AlphaMask::Build(image, AlphaMaskRule::AlphaChannel);
+    CHECK(transparent.OpaquePixels() == 0 && !transparent.IsOpaque(0, 0));
+    CHECK(transparent.MemoryBytes() == sizeof(AlphaMask));
+    CHECK(AlphaMask::Build(image, AlphaMaskRule::Opaque).IsOpaque(50, 30));
+
+    // 左半透明、右半不透明，分界在區塊邊界上：沒有混合區塊
+    for (int y = 0; y < 60; ++y) {
+        for (int x = 48; x < 100; ++x) {
+            image.rgba[(size_t(y) * 100 + x) * 4 + 3] = 255;
+        }
+    }
+    const AlphaMask half = AlphaMask::Build(image, AlphaMaskRule::AlphaChannel);
+    CHECK(half.MixedBlocks() == 0);
+    CHECK(!half.IsOpaque(47, 10) && half.IsOpaque(48, 10) && half.IsOpaque(99, 59));
+    CheckMatches(image, AlphaMaskRule::AlphaChannel);
+}
+
+// 混合區塊超過 16 位元編號時改用 32 位元區塊表，結果不變
+void TestManyMixedBlocks() {
+    const int size = 2056;   // 257 x 257 個區塊，全部是混合區塊
+    TextureImage image = MakeImage(size, size);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            if ((x + y) % 2 == 0) {
+                image.rgba[(size_t(y) * size + x) * 4 + 3] = 0;
+            }
+        }
+    }
+    const AlphaMask mask = AlphaMask::Build(image, AlphaMaskRule::AlphaChannel);
+    CHECK(mask.MixedBlocks() == 257u * 257u);
+    CHECK(mask.OpaquePixels() == size_t(size) * size / 2);
+    for (int y = 0; y < size; y += 7) {
+        for (int x = 0; x < size; x += 3) {
+            CHECK(mask.IsOpaque(x, y) == ((x + y) % 2 != 0));
+        }
+    }
+}
+
+// 服務：依副檔名選擇規則、讀檔失敗回傳 nullptr、結果保留到 Clear
+void TestServiceBuildsFromFiles() {
+    const fs::path root = fs::temp_directory_path() / ("AlphaMaskTest_" + std::to_string(
+        std::chrono::steady_clock::now().time_since_epoch().count()));
+    fs::create_directories(root);
+    TextureImage image = MakeImage(40, 24);
+    for (int x = 0; x < 40; ++x) {
+        uint8_t* p = &image.rgba[size_t(x) * 4];   // 第一列：綠色且透明
+        p[0] = 0;
+        p[2] = 0;
+        p[3] = 0;
+    }
+    const std::string png = (root / "a.png").string(), bmp = (root / "a.bmp").string();
+    const std::string tga = (root / "a.tga").string();
+    CHECK(stbi_write_png(png.c_str(), 40, 24, 4, image.rgba.data(), 40 * 4));
+    CHECK(stbi_write_tga(tga.c_str(), 40, 24, 4, image.rgba.data()));
+    std::vector<uint8_t> rgb(40 * 24 * 3);
+    for (size_t i = 0; i < 40 * 24; ++i) {
+        std::copy_n(&image.rgba[i * 4], 3, &rgb[i * 3]);
+    }
+    CHECK(stbi_write_bmp(bmp.c_str(), 40, 24, 3, rgb.data()));
+    CHECK(AlphaMaskRuleFor(root / "X.PNG") == AlphaMaskRule::AlphaChannel);
+    CHECK(AlphaMaskRuleFor(root / "x.Bmp") == AlphaMaskRule::GreenColorKey);
+    CHECK(AlphaMaskRuleFor(tga) == AlphaMaskRule::Opaque);
+
+    {
+        AlphaMaskService service(2);
+        CHECK(service.Request(png));
+        CHECK(service.Request(bmp));
+        CHECK(!service.Request(png));
+        service.Request(root / "missing.png");
+        for (const std::string& file : { png, bmp }) {
+            std::shared_ptr<const AlphaMask> mask = service.Wait(file);
+            CHECK(mask && mask->Width() == 40 && mask->Height() == 24);
+            CHECK(!mask->IsOpaque(5, 0) && mask->IsOpaque(5, 1));
+            CHECK(mask->TransparentPixels() == 40);
+            CHECK(service.Wait(file) == mask);
+        }
+        std::shared_ptr<const AlphaMask> opaque = service.Wait(tga);   // 沒有排入也能直接建立
+        CHECK(opaque && opaque->OpaquePixels() == 40 * 24);
+        CHECK(service.Wait(root / "missing.png") == nullptr);
+
+        std::shared_ptr<const AlphaMask> before = service.Wait(png);
+        service.Clear();
+        CHECK(service.Request(png));
+        std::shared_ptr<const AlphaMask> after = service.Wait(png);
+        CHECK(after && after != before);
+
+        // 解構時佇列中仍有工作
+        for (int i = 0; i < 20; ++i) {
+            service.Clear();
+            service.Request(png);
+            service.Request(bmp);
+        }
+    }
+    fs::remove_all(root);
+}
+
+} // namespace
+
+int main() {
+    TestMatchesPerPixelRule();
+    TestUniformRegionsStoreNoPixels();
+    TestManyMixedBlocks();
+    TestServiceBuildsFromFiles();
+    std::printf("AlphaMaskTest ok\n");
+    return 0;
+}
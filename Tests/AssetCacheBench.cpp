@@ -0,0 +1,96 @@
+#include "AssetCache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// 命中路徑的執行緒擴展性：分片快取 vs. 單一互斥鎖保護的 map（改寫前的 AssetManager）
+// 用法：AssetCacheBench [最大執行緒數]
+
+namespace {
+
+constexpr int kKeys = 1024;
+constexpr int kLookupsPerThread = 400000;
+
+struct LockedMap {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<void>> items;
+
+    std::shared_ptr<void> Find(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = items.find(key);
+        return it != items.end() ? it->second : nullptr;
+    }
+};
+
+template <typename Lookup>
+double Run(int threadCount, const std::vector<std::string>& keys, Lookup&& lookup) {
+    std::atomic<int> ready{ 0 };
+    std::atomic<bool> go{ false };
+    std::atomic<size_t> misses{ 0 };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t] {
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            size_t localMisses = 0;
+            for (int i = 0; i < kLookupsPerThread; ++i) {
+                if (!lookup(keys[(i * 31 + t * 17) % kKeys])) {
+                    ++localMisses;
+                }
+            }
+            misses.fetch_add(localMisses);
+        });
+    }
+    while (ready.load() != threadCount) {
+        std::this_thread::yield();
+    }
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (misses.load() != 0) {
+        std::fprintf(stderr, "unexpected misses: %zu\n", misses.load());
+        std::exit(1);
+    }
+    return double(threadCount) * kLookupsPerThread / seconds / 1e6;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int maxThreads = argc > 1 ? std::atoi(argv[1]) : int((std::max)(1u, std::thread::hardware_concurrency()));
+
+    std::vector<std::string> keys;
+    AssetCache cache;
+    LockedMap locked;
+    for (int i = 0; i < kKeys; ++i) {
+        keys.push_back("models/asset_" + std::to_string(i) + ".x");
+        auto data = std::make_shared<int>(i);
+        cache.Store(keys.back(), keys.back(), 0, data);
+        locked.items[keys.back()] = data;
+    }
+
+    // 先各跑一次不計時，避免先量測的一方承擔 CPU 升頻與快取暖機
+    Run(1, keys, [&](const std::string& key) { return cache.Find(key) != nullptr; });
+    Run(1, keys, [&](const std::string& key) { return locked.Find(key) != nullptr; });
+
+    std::printf("threads  sharded Mlookups/s  locked Mlookups/s\n");
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double sharded = Run(threads, keys, [&](const std::string& key) { return cache.Find(key) != nullptr; });
+        double single = Run(threads, keys, [&](const std::string& key) { return locked.Find(key) != nullptr; });
+        std::printf("%7d  %18.1f  %17.1f\n", threads, sharded, single);
+    }
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include "AssetCache.h"
+#include "TestCheck.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// 快取不解讀類型，測試自訂分類值即可
+constexpr uint8_t kModel = 0;
+constexpr uint8_t kTexture = 1;
+
+const AssetCache::Predicate kAll = [](const AssetItem&) { return true; };
+
+// 還有外部持有者的資產不會被卸載；持有者釋放後才會
+void TestHandleLifetime() {
+    AssetCache cache;
+    cache.Store("a", "a", kModel, std::make_shared<int>(1));
+
+    for (int i = 0; i < 100; ++i) {
+        CHECK(cache.Find("a"));   // 反覆命中不應累積任何「使用中」狀態
+    }
+    CHECK(cache.EraseUnreferenced(kAll) == 1);
+    CHECK(!cache.Find("a"));
+
+    cache.Store("b", "b", kModel, std::make_shared<int>(2));
+    {
+        auto held = cache.Find("b");
+        CHECK(cache.EraseUnreferenced(kAll) == 0);
+        CHECK(cache.IsLoaded("b"));
+    }
+    CHECK(cache.EraseUnreferenced(kAll) == 1);
+    CHECK(cache.Size() == 0);
+}
+
+// 多個鍵共用同一份資料（內容去重）時，彼此不算外部持有者
+void TestSharedData() {
+    AssetCache cache;
+    auto shared = std::make_shared<int>(3);
+    cache.Store("x", "x", kModel, shared);
+    cache.Store("y", "y", kModel, shared);
+
+    CHECK(cache.EraseUnreferenced(kAll) == 0);   // 測試本身仍持有 shared
+    shared.reset();
+    CHECK(cache.EraseUnreferenced(kAll) == 2);
+
+    // 只有一個鍵閒置時，另一個鍵仍在快取中，閒置的鍵可以移除
+    shared = std::make_shared<int>(4);
+    cache.Store("x", "x", kModel, shared);
+    cache.Store("y", "y", kModel, shared);
+    shared.reset();
+    CHECK(cache.EraseUnreferenced([](const AssetItem& item) { return item.path == "x"; }) == 1);
+    CHECK(cache.IsLoaded("y"));
+}
+
+// internalRefs 扣掉快取以外但屬於引擎內部的持有者（例如 TextureCache）
+void TestInternalRefs() {
+    AssetCache cache;
+    auto residentCopy = std::make_shared<int>(5);
+    cache.Store("t", "t", kTexture, residentCopy);
+
+    CHECK(cache.EraseUnreferenced(kAll) == 0);
+    CHECK(cache.EraseUnreferenced(kAll, [](const AssetItem&) -> long { return 1; }) == 1);
+}
+
+// 存取時間以 AdvanceClock 推進的影格時鐘為準，同一影格內命中不會改變
+void TestAccessClock() {
+    using namespace std::chrono_literals;
+    AssetCache cache;
+    const auto start = std::chrono::steady_clock::time_point(1h);
+    cache.AdvanceClock(start);
+    cache.Store("a", "a", kModel, std::make_shared<int>(1));
+    cache.Store("b", "b", kModel, std::make_shared<int>(2));
+
+    cache.AdvanceClock(start + 5s);
+    CHECK(cache.Find("a"));
+    CHECK(cache.Find("a"));
+    CHECK(cache.Peek("b"));   // Peek 不更新存取時間
+    cache.AdvanceClock(start + 10s);
+
+    std::chrono::steady_clock::time_point a, b;
+    cache.ForEach([&](const std::string& key, const AssetItem& item) {
+        (key == "a" ? a : b) = item.LastAccessed();
+    });
+    CHECK(a == start + 5s && b == start);
+    CHECK(cache.Clock() == start + 10s);
+
+    // GetOrLoad 命中同樣蓋上目前的時鐘
+    cache.GetOrLoad("b", "b", kModel, [] { return std::shared_ptr<void>(); });
+    cache.ForEach([&](const std::string& key, const AssetItem& item) {
+        if (key == "b") {
+            b = item.LastAccessed();
+        }
+    });
+    CHECK(b == start + 10s);
+}
+
+// 多執行緒壓力：同鍵只載入一次、命中回傳正確資料，並與移除/卸載並行
+void TestConcurrentAccess() {
+    constexpr int kThreads = 16;
+    constexpr int kKeys = 200;
+    constexpr int kIterations = 20000;
+
+    AssetCache cache;
+    std::atomic<int> loads{ 0 };
+    std::atomic<int> wrong{ 0 };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < kIterations; ++i) {
+                const int id = (i * 7 + t) % kKeys;
+                const std::string key = "asset" + std::to_string(id);
+                auto data = cache.GetOrLoad(key, key, kModel, [&]() -> std::shared_ptr<void> {
+                    loads.fetch_add(1, std::memory_order_relaxed);
+                    return std::make_shared<int>(id);
+                });
+                if (!data || *static_cast<int*>(data.get()) != id) {
+                    wrong.fetch_add(1, std::memory_order_relaxed);
+                }
+                if (auto hit = cache.Find(key); hit && *static_cast<int*>(hit.get()) != id) {
+                    wrong.fetch_add(1, std::memory_order_relaxed);
+                }
+                if (i % 997 == 0) {
+                    cache.Erase(key);
+                }
+                if (t == 0 && i % 4001 == 0) {
+                    cache.EraseUnreferenced(kAll);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    CHECK(wrong.load() == 0);
+    // 每個鍵至少載入一次；重新載入只發生在 Erase/EraseUnreferenced 之後
+    const int erases = kThreads * ((kIterations + 996) / 997);
+    CHECK(loads.load() >= kKeys);
+    CHECK(loads.load() <= kKeys + erases + kKeys * ((kIterations + 4000) / 4001));
+    CHECK(cache.Size() <= static_cast<size_t>(kKeys));
+    std::printf("concurrent: %d loads for %d keys\n", loads.load(), kKeys);
+}
+
+} // namespace
+
+int main() {
+    TestHandleLifetime();
+    TestSharedData();
+    TestInternalRefs();
+    TestAccessClock();
+    TestConcurrentAccess();
+    std::printf("AssetCacheTest ok\n");
+    return 0;
+}
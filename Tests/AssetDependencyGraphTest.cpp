@@ -0,0 +1,245 @@
+#include "AssetDependencyGraph.h"
+#include "TestCheck.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Fixture {
+    fs::path root;
+
+    Fixture() {
+        root = fs::temp_directory_path() / ("AssetDependencyGraphTest_" + std::to_string(
+            std::chrono::steady_clock::now().time_since_epoch().count()));
+        fs::create_directories(root / "tex");
+    }
+    ~Fixture() { fs::remove_all(root); }
+
+    fs::path Write(const fs::path& name, const std::string& bytes) const {
+        std::ofstream(root / name, std::ios::binary) << bytes;
+        return root / name;
+    }
+
+    std::string Path(const fs::path& name) const {
+        return (root / name).lexically_normal().string();
+    }
+};
+
+using Levels = std::vector<std::vector<std::string>>;
+
+// 每個節點只出現一次，且它的相依項目都在更低的層（被循環截斷的邊除外）
+bool LevelsAreOrdered(const AssetDependencyGraph& graph, const Levels& levels, bool allowCycles = false) {
+    std::unordered_map<std::string, size_t> levelOf;
+    for (size_t i = 0; i < levels.size(); ++i) {
+        for (const auto& node : levels[i]) {
+            if (!levelOf.emplace(node, i).second) {
+                return false;
+            }
+        }
+    }
+    for (const auto& [node, level] : levelOf) {
+        for (const auto& dep : graph.GetDependencies(node)) {
+            auto it = levelOf.find(dep);
+            if (it == levelOf.end() || (it->second >= level && !allowCycles)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 自我引用與重複項目被忽略；SetDependencies 取代舊的邊；仍被引用的節點移除時只去掉自己的邊
+void TestEdges() {
+    AssetDependencyGraph graph;
+    graph.SetDependencies("model", { "tex", "tex", "model", "mat" });
+    CHECK(graph.GetDependencies("model") == (std::vector<std::string>{ "tex", "mat" }));
+    CHECK(graph.GetDependents("tex") == (std::vector<std::string>{ "model" }));
+    CHECK(graph.HasAsset("tex") && graph.HasAsset("mat") && !graph.HasAsset("other"));
+
+    graph.AddDependency("mat", "tex");
+    graph.AddDependency("mat", "tex");
+    graph.AddDependency("mat", "mat");
+    CHECK(graph.GetDependencies("mat") == (std::vector<std::string>{ "tex" }));
+    CHECK(graph.GetDependents("tex") == (std::vector<std::string>{ "model", "mat" }));
+
+    graph.SetDependencies("model", { "mat" });
+    CHECK(graph.GetDependents("tex") == (std::vector<std::string>{ "mat" }));
+
+    graph.RemoveAsset("mat");   // model 仍引用 mat
+    CHECK(graph.HasAsset("mat") && graph.GetDependencies("mat").empty());
+    CHECK(graph.GetDependents("tex").empty());
+    graph.RemoveAsset("model");
+    CHECK(!graph.HasAsset("model"));
+    CHECK(graph.GetDependents("mat").empty());
+
+    graph.Clear();
+    CHECK(!graph.HasAsset("mat") && !graph.HasAsset("tex"));
+}
+
+// 閉包依層分組：第 0 層為葉節點，root 在最後一層
+void TestLoadLevels() {
+    AssetDependencyGraph graph;
+    graph.SetDependencies("model", { "texA", "mat" });
+    graph.SetDependencies("mat", { "texA", "texB" });
+    graph.SetDependencies("texB", { "image" });
+    graph.SetDependencies("unrelated", { "texA" });
+
+    const Levels levels = graph.GetLoadLevels("model");
+    CHECK(levels == (Levels{ { "image", "texA" }, { "texB" }, { "mat" }, { "model" } }));
+    CHECK(LevelsAreOrdered(graph, levels));
+
+    CHECK(graph.GetLoadLevels("texB") == (Levels{ { "image" }, { "texB" } }));
+    CHECK(graph.GetLoadLevels("missing") == (Levels{ { "missing" } }));
+
+    // 很深的鏈不會因遞迴而溢位
+    AssetDependencyGraph chain;
+    const int depth = 100000;
+    for (int i = 0; i < depth; ++i) {
+        chain.AddDependency(std::to_string(i), std::to_string(i + 1));
+    }
+    const Levels deep = chain.GetLoadLevels("0");
+    CHECK(deep.size() == size_t(depth) + 1);
+    CHECK(deep.front() == (std::vector<std::string>{ std::to_string(depth) }));
+    CHECK(deep.back() == (std::vector<std::string>{ "0" }));
+}
+
+// 循環相依被截斷：每個節點仍只出現一次、root 在最後一層，而且不會無限迴圈
+void TestCycles() {
+    AssetDependencyGraph graph;
+    graph.SetDependencies("a", { "b" });
+    graph.SetDependencies("b", { "c" });
+    graph.SetDependencies("c", { "a", "leaf" });
+
+    for (const char* root : { "a", "b", "c" }) {
+        const Levels levels = graph.GetLoadLevels(root);
+        CHECK(LevelsAreOrdered(graph, levels, true));
+        CHECK(levels.back() == (std::vector<std::string>{ root }));
+        CHECK(std::count(levels.front().begin(), levels.front().end(), "leaf") == 1);
+        size_t total = 0;
+        for (const auto& level : levels) {
+            total += level.size();
+        }
+        CHECK(total == 4);
+    }
+
+    // 兩個節點互相引用
+    AssetDependencyGraph pair;
+    pair.AddDependency("x", "y");
+    pair.AddDependency("y", "x");
+    CHECK(pair.GetLoadLevels("x") == (Levels{ { "y" }, { "x" } }));
+    CHECK(pair.FindSharedAssets().empty());
+}
+
+// 共用：兩個以上引用者；孤兒：仍存活、但所有引用者都已卸載的相依項目，根節點不算
+void TestSharedAndOrphaned() {
+    AssetDependencyGraph graph;
+    graph.SetDependencies("m1", { "shared.png", "m1.png" });
+    graph.SetDependencies("m2", { "shared.png", "m2.png" });
+    graph.SetDependencies("m3", { "m2.png" });
+    CHECK(graph.FindSharedAssets() == (std::vector<std::string>{ "m2.png", "shared.png" }));
+
+    std::set<std::string> live = { "m1", "m2", "m3", "shared.png", "m1.png", "m2.png" };
+    auto isLive = [&live](const std::string& key) { return live.count(key) > 0; };
+    CHECK(graph.FindOrphanedAssets(isLive).empty());
+
+    live.erase("m1");
+    CHECK(graph.FindOrphanedAssets(isLive) == (std::vector<std::string>{ "m1.png" }));
+
+    live.erase("m2");   // m3 仍引用 m2.png
+    CHECK(graph.FindOrphanedAssets(isLive) == (std::vector<std::string>{ "m1.png", "shared.png" }));
+
+    live.erase("m1.png");   // 已卸載的資產不是孤兒
+    live.erase("m3");
+    CHECK(graph.FindOrphanedAssets(isLive) == (std::vector<std::string>{ "m2.png", "shared.png" }));
+
+    graph.RemoveAsset("m2");
+    CHECK(graph.FindSharedAssets() == (std::vector<std::string>{}));
+}
+
+std::string Glb(const std::string& json) {
+    std::string text = json;
+    while (text.size() % 4) {
+        text.push_back(' ');
+    }
+    std::string out;
+    auto u32 = [&out](uint32_t value) { out.append(reinterpret_cast<const char*>(&value), 4); };
+    u32(0x46546C67u);
+    u32(2);
+    u32(uint32_t(12 + 8 + text.size()));
+    u32(uint32_t(text.size()));
+    u32(0x4E4F534Au);
+    return out + text;
+}
+
+// glTF／GLB 的 images 與 buffers uri（略過 data: URI）、文字 .x 的 TextureFilename；結果排序且不重複
+void TestScan() {
+    Fixture fixture;
+    fixture.Write("tex/a.png", "png");
+    fixture.Write("mesh.bin", "bin");
+
+    const std::string json = R"({ "asset": { "version": "2.0" },
+        "images": [ { "uri": "tex/a.png" }, { "uri": "data:image/png;base64,AAAA" }, { "uri": "missing.png" },
+                    { "bufferView": 0 }, { "uri": "tex/a.png" } ],
+        "buffers": [ { "uri": "mesh.bin", "byteLength": 3 }, { "byteLength": 4 } ] })";
+    const std::vector<std::string> expected = { fixture.Path("mesh.bin"), fixture.Path("missing.png"),
+                                                fixture.Path("tex/a.png") };
+    CHECK(ScanAssetDependencies(fixture.Write("model.gltf", json)) == expected);
+    CHECK(ScanAssetDependencies(fixture.Write("model.GLB", Glb(json))) == expected);
+    CHECK(ScanAssetDependencies(fixture.Write("broken.gltf", "{ \"images\": [")).empty());
+    CHECK(ScanAssetDependencies(fixture.Write("broken.glb", Glb(json).substr(0, 30))).empty());
+
+    // .x 路徑中的 \\ 還原為單一反斜線；二進位 .x 沒有可直接搜尋的字串
+    const std::string x = "xof 0303txt 0032\n"
+        "Material M { 1;1;1;1;; 0; 0;0;0;; 0;0;0;; TextureFilename { \"tex/a.png\"; } }\n"
+        "Frame F { Mesh { 3; 0;0;0;, 1;0;0;, 0;1;0;; 1; 3;0,1,2;;\n"
+        "  MeshMaterialList { 2; 1; 0;; { M } Material { 1;1;1;1;; 0; 0;0;0;; 0;0;0;;\n"
+        "    TextureFilename { \"sub\\\\b.png\"; } } } } }\n";
+    CHECK(ScanAssetDependencies(fixture.Write("model.x", x)) ==
+          (std::vector<std::string>{ fixture.Path("sub\\b.png"), fixture.Path("tex/a.png") }));
+    CHECK(ScanAssetDependencies(fixture.Write("binary.x", "xof 0303bin 0032" + x.substr(16))).empty());
+    CHECK(ScanAssetDependencies(fixture.Write("model.obj", x)).empty());
+    CHECK(ScanAssetDependencies(fixture.root / "missing.gltf").empty());
+}
+
+// 搜尋順序：絕對路徑、模型所在目錄、目前目錄、模型目錄下的同名檔；都不存在時以模型目錄為準
+void TestResolve() {
+    Fixture fixture;
+    const fs::path owner = fixture.root / "model.x";
+    fixture.Write("tex/a.png", "png");
+    fixture.Write("flat.png", "png");
+
+    CHECK(ResolveDependencyPath(owner, (fixture.root / "tex/a.png").string()) == fixture.Path("tex/a.png"));
+    CHECK(ResolveDependencyPath(owner, "tex/../tex/a.png") == fixture.Path("tex/a.png"));
+    CHECK(ResolveDependencyPath(owner, "elsewhere/flat.png") == fixture.Path("flat.png"));
+    CHECK(ResolveDependencyPath(owner, "none/missing.png") == fixture.Path("none/missing.png"));
+    CHECK(ResolveDependencyPath(owner, (fixture.root / "gone/flat.png").string()) == fixture.Path("flat.png"));
+
+    const fs::path cwd = fs::current_path();
+    fs::current_path(fixture.root / "tex");
+    CHECK(ResolveDependencyPath(fixture.root / "sub" / "model.x", "a.png") == "a.png");
+    fs::current_path(cwd);
+}
+
+} // namespace
+
+int main() {
+    TestEdges();
+    TestLoadLevels();
+    TestCycles();
+    TestSharedAndOrphaned();
+    TestScan();
+    TestResolve();
+    std::printf("AssetDependencyGraphTest ok\n");
+    return 0;
+}
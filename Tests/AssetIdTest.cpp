@@ -0,0 +1,51 @@
+#include "AssetId.h"
+#include "ResourceHandle.h"
+#include "TestCheck.h"
+
+#include <cstdio>
+#include <memory>
+
+namespace {
+
+// 同一路徑的不同寫法得到同一個 ID 與同一個正規化字串（TextureManager 的快取鍵、AssetManager 的資產鍵）
+void TestNormalization() {
+    auto& interner = AssetPathInterner::Instance();
+    const AssetId id = interner.Intern("ui/./icons/../icons/ok.png");
+    CHECK(id != kInvalidAssetId);
+    CHECK(interner.Find("ui/icons/ok.png") == id);
+    CHECK(interner.Intern("ui/icons/ok.png") == id);
+    CHECK(interner.GetPath(id) == AssetPathInterner::Normalize("ui//icons/./ok.png"));
+    CHECK(interner.Find("ui/icons/missing.png") == kInvalidAssetId);
+    CHECK(interner.Intern("") == kInvalidAssetId);
+    CHECK(interner.GetPath(kInvalidAssetId).empty());
+}
+
+// 移除後舊 handle 解析失敗，即使槽位被新資源重用
+void TestStaleHandles() {
+    HandlePool<int> pool;
+    auto a = pool.Insert(std::make_shared<int>(1));
+    CHECK(pool.Resolve(a) && *pool.Resolve(a) == 1);
+
+    pool.Remove(a);
+    CHECK(!pool.Resolve(a));
+    auto b = pool.Insert(std::make_shared<int>(2));
+    CHECK(b.index == a.index);
+    CHECK(b.generation != a.generation);
+    CHECK(!pool.Resolve(a));
+    CHECK(*pool.Resolve(b) == 2);
+
+    pool.Remove(a);   // 過期 handle 不影響新資源
+    CHECK(pool.Resolve(b));
+    pool.Clear();
+    CHECK(!pool.Resolve(b));
+    CHECK(!pool.Resolve({}));
+}
+
+} // namespace
+
+int main() {
+    TestNormalization();
+    TestStaleHandles();
+    std::printf("AssetIdTest ok\n");
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include "AtlasPacker.h"
+#include "TestCheck.h"
+
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// 加上 padding 的外框
+AtlasRect Padded(const AtlasRect& rect, int padding) {
+    return { rect.x - padding, rect.y - padding, rect.width + 2 * padding, rect.height + 2 * padding };
+}
+
+bool Overlaps(const AtlasRect& a, const AtlasRect& b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+// 每個放入的矩形（含 padding）都在頁面內、彼此不重疊、不超過該頁記錄的使用高度
+void CheckLayout(const AtlasLayout& layout, const std::vector<AtlasItem>& items, int padding) {
+    for (const AtlasItem& item : items) {
+        auto it = layout.placements.find(item.key);
+        if (it == layout.placements.end()) {
+            continue;
+        }
+        const AtlasPlacement& placement = it->second;
+        CHECK(placement.rect.width == item.width && placement.rect.height == item.height);
+        CHECK(placement.page < layout.pageUsedHeights.size());
+        const AtlasRect padded = Padded(placement.rect, padding);
+        CHECK(padded.x >= 0 && padded.y >= 0);
+        CHECK(padded.x + padded.width <= layout.pageWidth && padded.y + padded.height <= layout.pageHeight);
+        CHECK(padded.y + padded.height <= layout.pageUsedHeights[placement.page]);
+    }
+    for (auto a = layout.placements.begin(); a != layout.placements.end(); ++a) {
+        for (auto b = std::next(a); b != layout.placements.end(); ++b) {
+            if (a->second.page == b->second.page) {
+                CHECK(!Overlaps(Padded(a->second.rect, padding), Padded(b->second.rect, padding)));
+            }
+        }
+    }
+}
+
+// 隨機大小的圖示：全部放入、沒有重疊、padding 之間至少相隔 2 * padding
+void TestRandomItemsDoNotOverlap() {
+    std::mt19937 rng(11);
+    for (int padding : { 0, 1, 2, 4 }) {
+        std::vector<AtlasItem> items;
+        for (int i = 0; i < 300; ++i) {
+            items.push_back({ "item" + std::to_string(i), 4 + int(rng() % 60), 4 + int(rng() % 60) });
+        }
+        const AtlasLayout layout = PackAtlas(items, 256, 256, padding);
+        CHECK(layout.rejected.empty());
+        CHECK(layout.placements.size() == items.size());
+        CHECK(layout.pageUsedHeights.size() > 1);   // 總面積超過一頁
+        CheckLayout(layout, items, padding);
+    }
+}
+
+// 加上 padding 後比頁面大的矩形與空矩形被拒絕，剛好放得下的仍放入
+void TestOversizedItemsAreRejected() {
+    const std::vector<AtlasItem> items = {
+        { "fits", 60, 60 },        // 60 + 2 * 2 = 64
+        { "wide", 61, 10 },
+        { "tall", 10, 61 },
+        { "empty", 0, 10 },
+        { "small", 8, 8 },
+    };
+    const AtlasLayout layout = PackAtlas(items, 64, 64, 2);
+    CHECK(layout.rejected.size() == 3);
+    CHECK(layout.placements.count("fits") && layout.placements.count("small"));
+    CHECK(!layout.placements.count("wide") && !layout.placements.count("tall") && !layout.placements.count("empty"));
+    // fits 佔滿第一頁，small 開新頁
+    CHECK(layout.pageUsedHeights.size() == 2);
+    CHECK(layout.placements.at("fits").rect.x == 2 && layout.placements.at("fits").rect.y == 2);
+    CHECK(layout.placements.at("small").page == 1);
+    CheckLayout(layout, items, 2);
+}
+
+// 同高的矩形由左到右排成一列，skyline 讓下一列從最低處開始
+void TestSkylinePlacement() {
+    SkylinePacker packer(64, 64);
+    for (int i = 0; i < 4; ++i) {
+        auto rect = packer.Insert(16, 32);
+        CHECK(rect && rect->x == i * 16 && rect->y == 0);
+    }
+    CHECK(packer.UsedHeight() == 32);
+    auto tall = packer.Insert(64, 32);
+    CHECK(tall && tall->x == 0 && tall->y == 32);
+    CHECK(packer.Occupancy() == 1.0);
+
+    // 放不下時回傳 nullopt，狀態不變
+    CHECK(!packer.Insert(1, 1));
+    CHECK(packer.UsedHeight() == 64 && packer.Occupancy() == 1.0);
+    CHECK(!SkylinePacker(8, 8).Insert(9, 1));
+}
+
+// 同樣的輸入得到同樣的配置：同高同寬的項目以 stable_sort 保留輸入順序
+void TestDeterministicOrder() {
+    std::vector<AtlasItem> items;
+    for (int i = 0; i < 50; ++i) {
+        items.push_back({ std::to_string(i), 10 + i % 7, 10 + i % 5 });
+    }
+    const AtlasLayout a = PackAtlas(items, 128, 128, 1);
+    const AtlasLayout b = PackAtlas(items, 128, 128, 1);
+    CHECK(a.placements.size() == b.placements.size());
+    for (const auto& [key, placement] : a.placements) {
+        const AtlasPlacement& other = b.placements.at(key);
+        CHECK(placement.page == other.page && placement.rect.x == other.rect.x && placement.rect.y == other.rect.y);
+    }
+}
+
+} // namespace
+
+int main() {
+    TestRandomItemsDoNotOverlap();
+    TestOversizedItemsAreRejected();
+    TestSkylinePlacement();
+    TestDeterministicOrder();
+    std::printf("AtlasPackerTest ok\n");
+    return 0;
+}
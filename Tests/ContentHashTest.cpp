@@ -0,0 +1,102 @@
+#include "ContentHash.h"
+#include "TextureCache.h"
+#include "TestCheck.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+// TextureCache 只需要指標身分，測試以自訂的型別代替 Direct3D 貼圖
+struct IDirect3DBaseTexture9 {
+    int id;
+};
+
+namespace {
+
+void WriteFile(const fs::path& path, const std::string& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << bytes;
+}
+
+TextureCache::TexturePtr MakeTexture(int id) {
+    return TextureCache::TexturePtr(new IDirect3DBaseTexture9{ id });
+}
+
+// 串流雜湊與一次雜湊整個緩衝區結果相同：已讀入記憶體的內容不需要再讀一次檔案
+void TestHashFileMatchesHashBytes(const fs::path& root) {
+    std::string bytes;
+    for (int i = 0; i < 700000; ++i) {
+        bytes.push_back(static_cast<char>((i * 131) ^ (i >> 7)));
+    }
+    const fs::path file = root / "big.bin";
+    WriteFile(file, bytes);
+    CHECK(HashFile(file) == HashBytes(bytes.data(), bytes.size()));
+    CHECK(HashFile(root / "missing.bin") == 0);
+}
+
+void TestSameFileContent(const fs::path& root) {
+    const fs::path a = root / "a.png";
+    const fs::path b = root / "b.png";
+    const fs::path c = root / "c.png";
+    const fs::path d = root / "d.png";
+    WriteFile(a, std::string(300000, 'x') + "tail");
+    WriteFile(b, std::string(300000, 'x') + "tail");
+    WriteFile(c, std::string(300000, 'x') + "tall");   // 大小相同、最後幾個位元組不同
+    WriteFile(d, std::string(300000, 'x'));
+
+    CHECK(SameFileContent(a, b));
+    CHECK(SameFileContent(a, a));
+    CHECK(!SameFileContent(a, c));
+    CHECK(!SameFileContent(a, d));
+    CHECK(!SameFileContent(a, root / "missing.png"));
+    CHECK(!SameFileContent(a, {}));
+}
+
+// 內容鍵相同（模擬雜湊碰撞）但來源檔不同時不共用貼圖
+void TestCacheRejectsCollision(const fs::path& root) {
+    const fs::path original = root / "tex.bmp";
+    const fs::path copy = root / "tex_copy.bmp";
+    const fs::path other = root / "other.bmp";
+    WriteFile(original, "BM original pixels");
+    WriteFile(copy, "BM original pixels");
+    WriteFile(other, "BM other pixels!!!");
+
+    TextureCache cache;
+    auto texture = MakeTexture(1);
+    const uint64_t key = 42;
+    cache.Insert(original.string(), TextureVariant::Mipmapped, key, original, texture, 100, TextureCategory::Model);
+
+    CHECK(!cache.FindContent(key, other, other.string(), TextureVariant::Mipmapped, TextureCategory::Model));
+    CHECK(!cache.Peek(other.string(), TextureVariant::Mipmapped));
+    CHECK(cache.FindContent(key, copy, copy.string(), TextureVariant::Mipmapped, TextureCategory::Model) == texture);
+    CHECK(cache.Peek(copy.string(), TextureVariant::Mipmapped) == texture);
+
+    auto stats = cache.GetStats();
+    CHECK(stats.duplicateLoads == 1);
+    CHECK(stats.hashCollisions == 1);
+    CHECK(stats.bytesSaved == 100);
+
+    // 沒有來源檔的貼圖不參與內容去重
+    cache.Insert("streamed.dds", TextureVariant::Mipmapped, 7, {}, MakeTexture(2), 10, TextureCategory::Model);
+    CHECK(!cache.FindContent(7, copy, "alias.dds", TextureVariant::Mipmapped, TextureCategory::Model));
+}
+
+} // namespace
+
+int main() {
+    const fs::path root = fs::temp_directory_path() / ("ContentHashTest_" + std::to_string(
+        std::chrono::steady_clock::now().time_since_epoch().count()));
+    fs::create_directories(root);
+
+    TestHashFileMatchesHashBytes(root);
+    TestSameFileContent(root);
+    TestCacheRejectsCollision(root);
+
+    fs::remove_all(root);
+    std::printf("ContentHashTest ok\n");
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include "FbxMeshConversion.h"
+#include "TestCheck.h"
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+namespace {
+
+bool Near(float a, float b) {
+    return std::fabs(a - b) < 1e-6f;
+}
+
+bool IsDefault(const SkinInfluence& influence) {
+    return influence.weights[0] == 1.0f && influence.weights[1] == 0.0f && influence.weights[2] == 0.0f &&
+           influence.weights[3] == 0.0f && influence.boneIndices[0] == 0 && influence.boneIndices[1] == 0 &&
+           influence.boneIndices[2] == 0 && influence.boneIndices[3] == 0;
+}
+
+// 超過 4 個影響時保留最大的 4 個並正規化；同權重時先加入的 cluster 優先；不足 4 個時其餘為 0
+void TestTopFourInfluences() {
+    SkinInfluenceBuilder builder(3);
+    const double weights[] = { 0.1, 0.3, 0.2, 0.3, 0.05, 0.4 };
+    for (int bone = 0; bone < 6; ++bone) {
+        builder.Add(0, bone, weights[bone]);
+    }
+    builder.Add(1, 7, 2.0);
+    builder.Add(1, 9, 6.0);
+
+    const std::vector<SkinInfluence> influences = builder.Build();
+    CHECK(influences.size() == 3);
+
+    const SkinInfluence& many = influences[0];
+    CHECK(many.boneIndices[0] == 5 && many.boneIndices[1] == 1 && many.boneIndices[2] == 3 &&
+          many.boneIndices[3] == 2);
+    CHECK(Near(many.weights[0], 0.4f / 1.2f) && Near(many.weights[1], 0.3f / 1.2f) &&
+          Near(many.weights[2], 0.3f / 1.2f) && Near(many.weights[3], 0.2f / 1.2f));
+    CHECK(Near(many.weights[0] + many.weights[1] + many.weights[2] + many.weights[3], 1.0f));
+
+    const SkinInfluence& two = influences[1];
+    CHECK(two.boneIndices[0] == 9 && two.boneIndices[1] == 7 && two.boneIndices[2] == 0 && two.boneIndices[3] == 0);
+    CHECK(Near(two.weights[0], 0.75f) && Near(two.weights[1], 0.25f) && two.weights[2] == 0.0f &&
+          two.weights[3] == 0.0f);
+
+    // 沒有任何影響的控制點綁定骨骼 0、權重 1
+    CHECK(IsDefault(influences[2]));
+}
+
+// 權重總和為 0（全為 0、負值、非有限值或轉成 float 後下溢）時維持預設值；超出範圍的控制點被忽略
+void TestZeroTotalWeight() {
+    SkinInfluenceBuilder builder(2);
+    builder.Add(0, 3, 0.0);
+    builder.Add(0, 4, -0.5);
+    builder.Add(0, 5, std::numeric_limits<double>::quiet_NaN());
+    builder.Add(0, 6, std::numeric_limits<double>::infinity());
+    builder.Add(0, 7, 1e-60);
+    builder.Add(-1, 1, 1.0);
+    builder.Add(2, 1, 1.0);
+    builder.Add(1, 2, 0.0);
+    builder.Add(1, 8, 0.5);
+
+    const std::vector<SkinInfluence> influences = builder.Build();
+    CHECK(IsDefault(influences[0]));
+    CHECK(influences[1].boneIndices[0] == 8 && influences[1].weights[0] == 1.0f && influences[1].weights[1] == 0.0f);
+    CHECK(SkinInfluenceBuilder(0).Build().empty());
+}
+
+// 三角形、四邊形與五邊形混合：角與索引的前綴和、polygon-vertex 索引與三角化結果
+void TestMixedPolygons() {
+    const std::vector<int> sizes = { 3, 4, 3, 5, 4, -1, 3 };
+    const PolygonLayout layout = BuildPolygonLayout(int(sizes.size()), [&sizes](int i) { return sizes[size_t(i)]; });
+    CHECK(layout.corners == (std::vector<uint32_t>{ 0, 3, 7, 10, 15, 19, 19, 22 }));
+    CHECK(layout.indices == (std::vector<uint32_t>{ 0, 3, 9, 12, 12, 18, 18, 21 }));
+
+    const uint32_t base = 100;
+    std::vector<uint32_t> indices(layout.indices.back(), 0xFFFFFFFFu);
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        const uint32_t written = WritePolygonIndices(sizes[i], base + layout.corners[i], indices.data() + layout.indices[i]);
+        CHECK(written == layout.indices[i + 1] - layout.indices[i]);
+    }
+    CHECK(indices == (std::vector<uint32_t>{ 100, 101, 102,
+                                             103, 104, 105, 103, 105, 106,
+                                             107, 108, 109,
+                                             115, 116, 117, 115, 117, 118,
+                                             119, 120, 121 }));
+
+    CHECK(BuildPolygonLayout(0, [](int) { return 3; }).corners == (std::vector<uint32_t>{ 0 }));
+}
+
+// eByPolygonVertex 以前綴和得到的 polygon-vertex 索引查詢：四邊形之後的角不再以 polyIdx * 3 + vertIdx 計算
+void TestPolygonVertexNormalIndex() {
+    const std::vector<int> sizes = { 4, 3, 4 };
+    const PolygonLayout layout = BuildPolygonLayout(int(sizes.size()), [&sizes](int i) { return sizes[size_t(i)]; });
+    const int cornerCount = int(layout.corners.back());
+    CHECK(cornerCount == 11);
+
+    auto noIndex = [](int) { return -1; };
+    for (int poly = 0; poly < int(sizes.size()); ++poly) {
+        for (int vert = 0; vert < sizes[size_t(poly)]; ++vert) {
+            const int corner = int(layout.corners[size_t(poly)]) + vert;
+            CHECK(LayerElementIndex(LayerMapping::ByPolygonVertex, 0, corner, -1, noIndex, cornerCount) == corner);
+        }
+    }
+    // 第 3 個多邊形第 2 個角：4 + 3 + 1 = 8，舊算法為 2 * 3 + 1 = 7
+    CHECK(layout.corners[2] + 1 == 8);
+
+    // eIndexToDirect：每個角的法線索引再經過 index array
+    const std::vector<int> indexArray = { 5, 4, 3, 2, 1, 0, 5, 4, 3, 2, 1 };
+    auto indexAt = [&indexArray](int i) { return indexArray[size_t(i)]; };
+    CHECK(LayerElementIndex(LayerMapping::ByPolygonVertex, 0, 8, int(indexArray.size()), indexAt, 6) == 3);
+    CHECK(LayerElementIndex(LayerMapping::ByPolygonVertex, 0, 11, int(indexArray.size()), indexAt, 6) == -1);
+    CHECK(LayerElementIndex(LayerMapping::ByPolygonVertex, 0, 0, int(indexArray.size()), indexAt, 5) == -1);
+
+    // eByControlPoint 不受多邊形大小影響；不支援的對應方式與超出範圍的索引回傳 -1
+    CHECK(LayerElementIndex(LayerMapping::ByControlPoint, 2, 9, -1, noIndex, 4) == 2);
+    CHECK(LayerElementIndex(LayerMapping::ByControlPoint, 4, 0, -1, noIndex, 4) == -1);
+    CHECK(LayerElementIndex(LayerMapping::ByControlPoint, -1, 0, -1, noIndex, 4) == -1);
+    CHECK(LayerElementIndex(LayerMapping::Unsupported, 0, 0, -1, noIndex, 4) == -1);
+}
+
+} // namespace
+
+int main() {
+    TestTopFourInfluences();
+    TestZeroTotalWeight();
+    TestMixedPolygons();
+    TestPolygonVertexNormalIndex();
+    std::printf("FbxMeshConversionTest ok\n");
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include "FileWatcher.h"
+#include "TestCheck.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+void WriteFile(const fs::path& path, const std::string& text) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << text;
+}
+
+struct Changes {
+    std::mutex mutex;
+    std::vector<std::string> paths;
+
+    size_t Count(const std::string& path) {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t n = 0;
+        for (const auto& p : paths) {
+            n += p == path ? 1 : 0;
+        }
+        return n;
+    }
+};
+
+// 等待回呼送達；debounce 與輪詢間隔都設得很短，逾時代表沒有送達
+bool WaitFor(Changes& changes, const std::string& path, size_t count) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (changes.Count(path) >= count) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+} // namespace
+
+int main() {
+    fs::path root = fs::temp_directory_path() / ("FileWatcherTest_" + std::to_string(
+        std::chrono::steady_clock::now().time_since_epoch().count()));
+    fs::create_directories(root / "a");
+    fs::create_directories(root / "b");
+    const std::string a1 = (root / "a" / "one.txt").string();
+    const std::string a2 = (root / "a" / "two.txt").string();
+    const std::string b1 = (root / "b" / "one.txt").string();
+    WriteFile(a1, "a1");
+    WriteFile(a2, "a2");
+    WriteFile(b1, "b1");
+
+    Changes changes;
+    FileWatcher watcher(std::chrono::milliseconds(30), std::chrono::milliseconds(20));
+    watcher.Watch(a1);
+    watcher.Watch(a2);
+    CHECK(watcher.Start([&](const std::string& path) {
+        std::lock_guard<std::mutex> lock(changes.mutex);
+        changes.paths.push_back(path);
+    }));
+    watcher.Watch(b1);
+#ifdef __linux__
+    CHECK(watcher.UsesInotify());
+#endif
+
+    if (watcher.UsesInotify()) {
+        // 同一目錄的檔案共用一個目錄監控
+        CHECK(watcher.WatchedDirectoryCount() == 2);
+    }
+
+    // 先建立內容雜湊基準再修改，否則第一次變更無法與舊內容比對
+    watcher.Flush();
+    WriteFile(a1, "a1 changed");
+    CHECK(WaitFor(changes, a1, 1));
+
+    // 內容相同的存檔不會觸發；Flush 返回時這次存檔已處理完
+    WriteFile(a2, "a2");
+    CHECK(watcher.Flush() == 0);
+    CHECK(changes.Count(a2) == 0);
+
+    // Flush 不等 debounce 直接回報，也不會與監控執行緒重複回報
+    WriteFile(a2, "a2 changed");
+    watcher.Flush();
+    CHECK(changes.Count(a2) == 1);
+
+    watcher.Unwatch(a1);
+    if (watcher.UsesInotify()) {
+        CHECK(watcher.WatchedDirectoryCount() == 2);   // a/two.txt 仍在監控
+    }
+    watcher.Unwatch(a2);
+    watcher.Unwatch(a2);   // 重複移除不影響計數
+    if (watcher.UsesInotify()) {
+        CHECK(watcher.WatchedDirectoryCount() == 1);
+    }
+
+    // 已移除的檔案不再回報，其他目錄照常回報
+    WriteFile(a1, "a1 changed again");
+    WriteFile(b1, "b1 changed");
+    CHECK(WaitFor(changes, b1, 1));
+    watcher.Flush();
+    CHECK(changes.Count(a1) == 1 && changes.Count(a2) == 1);
+
+    watcher.Unwatch(b1);
+    if (watcher.UsesInotify()) {
+        CHECK(watcher.WatchedDirectoryCount() == 0);
+    }
+
+    // 重新監控同一目錄會再加入監控
+    watcher.Watch(a1);
+    if (watcher.UsesInotify()) {
+        CHECK(watcher.WatchedDirectoryCount() == 1);
+    }
+
+    watcher.Stop();
+    CHECK(watcher.WatchedDirectoryCount() == 0);
+    fs::remove_all(root);
+    std::printf("FileWatcherTest ok\n");
+    return 0;
+}
@@ -0,0 +1,433 @@
+#include "GltfAccessor.h"
+#include "TestCheck.h"
+#include "tiny_gltf.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using DirectX::XMFLOAT3;
+using DirectX::XMFLOAT4;
+using DirectX::XMUINT4;
+
+namespace {
+
+// 以 glTF 2.0 規範 3.11 逐元件計算的參考值；x86 上 GltfConvertAccessor 的 normalized VEC4、索引與 joint
+// 走 SSE2 路徑，其他組合走逐元件的一般路徑，兩者都要與這裡逐位元相同
+template <typename T>
+T Load(const uint8_t* p) {
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    return v;
+}
+
+float ReferenceFloat(GltfComponentType type, bool normalized, const uint8_t* p) {
+    switch (type) {
+        case GltfComponentType::Byte:
+            return normalized ? (std::max)(Load<int8_t>(p) / 127.0f, -1.0f) : float(Load<int8_t>(p));
+        case GltfComponentType::UnsignedByte:
+            return normalized ? *p / 255.0f : float(*p);
+        case GltfComponentType::Short:
+            return normalized ? (std::max)(Load<int16_t>(p) / 32767.0f, -1.0f) : float(Load<int16_t>(p));
+        case GltfComponentType::UnsignedShort:
+            return normalized ? Load<uint16_t>(p) / 65535.0f : float(Load<uint16_t>(p));
+        case GltfComponentType::UnsignedInt:
+            return normalized ? float(Load<uint32_t>(p) / 4294967295.0) : float(Load<uint32_t>(p));
+        default:
+            return Load<float>(p);
+    }
+}
+
+uint32_t ReferenceUInt(GltfComponentType type, const uint8_t* p) {
+    switch (type) {
+        case GltfComponentType::Byte: return uint32_t(Load<int8_t>(p));
+        case GltfComponentType::UnsignedByte: return *p;
+        case GltfComponentType::Short: return uint32_t(Load<int16_t>(p));
+        case GltfComponentType::UnsignedShort: return Load<uint16_t>(p);
+        default: return Load<uint32_t>(p);
+    }
+}
+
+// 手工組成的緩衝區：每個 bufferView 各自一段記憶體
+struct Buffers {
+    std::vector<std::vector<uint8_t>> storage;
+    std::vector<GltfBufferViewRange> views;
+
+    int Add(std::vector<uint8_t> bytes, size_t byteStride = 0) {
+        storage.push_back(std::move(bytes));   // 外層擴充時只搬移 vector 標頭，先前的資料位址不變
+        views.push_back({ storage.back().data(), storage.back().size(), byteStride });
+        return int(views.size() - 1);
+    }
+
+    GltfAccessorDesc Describe(const GltfAccessorFields& fields) const {
+        return DescribeGltfAccessor(fields, 0, views);
+    }
+};
+
+std::vector<uint8_t> RandomBytes(size_t size, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> bytes(size);
+    for (auto& b : bytes) {
+        b = uint8_t(rng());
+    }
+    return bytes;
+}
+
+template <typename T>
+std::vector<uint8_t> Bytes(const std::vector<T>& values) {
+    std::vector<uint8_t> bytes(values.size() * sizeof(T));
+    std::memcpy(bytes.data(), values.data(), bytes.size());
+    return bytes;
+}
+
+bool SameBits(float a, float b) {
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+// 所有元件型別 × 元件數 × normalized × 緊密／交錯，count 取不是 8、16 倍數的值以涵蓋 SIMD 迴圈的尾端
+void TestConvertMatchesReference() {
+    const GltfComponentType types[] = { GltfComponentType::Byte, GltfComponentType::UnsignedByte,
+                                        GltfComponentType::Short, GltfComponentType::UnsignedShort,
+                                        GltfComponentType::UnsignedInt, GltfComponentType::Float };
+    uint32_t seed = 1;
+    for (GltfComponentType type : types) {
+        for (int components : { 1, 2, 3, 4, 16 }) {
+            for (size_t extraStride : { size_t(0), size_t(4), size_t(12) }) {
+                const size_t elementSize = GltfComponentSize(type) * components;
+                const size_t stride = extraStride ? elementSize + extraStride : 0;
+                for (size_t count : { size_t(1), size_t(7), size_t(37) }) {
+                    Buffers buffers;
+                    std::vector<uint8_t> bytes = RandomBytes((stride ? stride : elementSize) * count, seed++);
+                    if (type == GltfComponentType::Float) {
+                        for (size_t i = 0; i + 4 <= bytes.size(); i += 4) {
+                            const float value = float(int(bytes[i]) - 128) / 8.0f;   // 避免 NaN
+                            std::memcpy(&bytes[i], &value, 4);
+                        }
+                    }
+                    const int view = buffers.Add(bytes, stride);
+                    const size_t step = stride ? stride : elementSize;
+
+                    for (bool normalized : { false, true }) {
+                        if (normalized && type == GltfComponentType::Float) {
+                            continue;
+                        }
+                        GltfAccessorFields fields;
+                        fields.bufferView = view;
+                        fields.count = count;
+                        fields.componentType = int(type);
+                        fields.components = components;
+                        fields.normalized = normalized;
+                        const GltfAccessorDesc desc = buffers.Describe(fields);
+                        CHECK(desc.stride == step && desc.count == count);
+
+                        // 目的端同樣測緊密與交錯（多留一個 float 的空位）
+                        for (size_t dstPad : { size_t(0), size_t(1) }) {
+                            const size_t dstStride = (components + dstPad) * sizeof(float);
+                            std::vector<float> out((components + dstPad) * count, -7.0f);
+                            GltfConvertAccessor(desc, out.data(), dstStride);
+                            for (size_t i = 0; i < count; ++i) {
+                                for (int c = 0; c < components; ++c) {
+                                    const float expected = ReferenceFloat(type, normalized,
+                                        bytes.data() + i * step + c * GltfComponentSize(type));
+                                    CHECK(SameBits(out[i * (components + dstPad) + c], expected));
+                                }
+                                if (dstPad) {
+                                    CHECK(out[i * (components + dstPad) + components] == -7.0f);
+                                }
+                            }
+                        }
+                    }
+
+                    if (type == GltfComponentType::Float) {
+                        continue;
+                    }
+                    GltfAccessorFields fields;
+                    fields.bufferView = view;
+                    fields.count = count;
+                    fields.componentType = int(type);
+                    fields.components = components;
+                    const GltfAccessorDesc desc = buffers.Describe(fields);
+                    std::vector<uint32_t> out(components * count);
+                    GltfConvertAccessor(desc, out.data(), components * sizeof(uint32_t));
+                    for (size_t i = 0; i < count; ++i) {
+                        for (int c = 0; c < components; ++c) {
+                            CHECK(out[i * components + c] ==
+                                  ReferenceUInt(type, bytes.data() + i * step + c * GltfComponentSize(type)));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// 規範的端點：normalized 有號整數的最小值夾到 -1，無號最大值為 1
+void TestNormalizedEndpoints() {
+    Buffers buffers;
+    const int bytes = buffers.Add(Bytes(std::vector<int8_t>{ -128, -127, 0, 127 }));
+    const int ushorts = buffers.Add(Bytes(std::vector<uint16_t>{ 0, 1, 32768, 65535 }));
+    const int shorts = buffers.Add(Bytes(std::vector<int16_t>{ -32768, -32767, 16384, 32767 }));
+
+    auto read = [&](int view, GltfComponentType type) {
+        GltfAccessorFields fields;
+        fields.bufferView = view;
+        fields.count = 1;
+        fields.componentType = int(type);
+        fields.components = 4;
+        fields.normalized = true;
+        return AccessorSpan<XMFLOAT4>(buffers.Describe(fields))[0];
+    };
+    const XMFLOAT4 b = read(bytes, GltfComponentType::Byte);
+    CHECK(b.x == -1.0f && b.y == -1.0f && b.z == 0.0f && b.w == 1.0f);
+    const XMFLOAT4 u = read(ushorts, GltfComponentType::UnsignedShort);
+    CHECK(u.x == 0.0f && u.y == 1.0f / 65535.0f && u.z == 32768.0f / 65535.0f && u.w == 1.0f);
+    const XMFLOAT4 s = read(shorts, GltfComponentType::Short);
+    CHECK(s.x == -1.0f && s.y == -1.0f && s.z == 16384.0f / 32767.0f && s.w == 1.0f);
+}
+
+// 交錯的頂點緩衝：POSITION（float）、COLOR_0（normalized u8）與 JOINTS_0（u16）共用一個 byteStride = 24 的 bufferView
+void TestInterleavedAttributes() {
+    struct Packed {
+        float pos[3];
+        uint8_t color[4];
+        uint16_t joints[4];
+    };
+    static_assert(sizeof(Packed) == 24);
+    std::vector<Packed> packed(5);
+    for (size_t i = 0; i < packed.size(); ++i) {
+        packed[i] = { { float(i), float(i) * 2, -float(i) }, { uint8_t(i), 255, 0, uint8_t(51 * i) },
+                      { uint16_t(i), uint16_t(300 + i), 0, 65535 } };
+    }
+    Buffers buffers;
+    const int view = buffers.Add(Bytes(packed), sizeof(Packed));
+
+    GltfAccessorFields position;
+    position.bufferView = view;
+    position.count = packed.size();
+    position.componentType = int(GltfComponentType::Float);
+    position.components = 3;
+    GltfAccessorFields color = position;
+    color.byteOffset = offsetof(Packed, color);
+    color.componentType = int(GltfComponentType::UnsignedByte);
+    color.components = 4;
+    color.normalized = true;
+    GltfAccessorFields joints = color;
+    joints.byteOffset = offsetof(Packed, joints);
+    joints.componentType = int(GltfComponentType::UnsignedShort);
+    joints.normalized = false;
+
+    struct Vertex {
+        XMFLOAT3 pos;
+        XMFLOAT4 color;
+        XMUINT4 joints;
+    };
+    std::vector<Vertex> vertices(packed.size());
+    AccessorSpan<XMFLOAT3>(buffers.Describe(position)).CopyTo(&vertices[0].pos, sizeof(Vertex));
+    AccessorSpan<XMFLOAT4>(buffers.Describe(color)).CopyTo(&vertices[0].color, sizeof(Vertex));
+    AccessorSpan<XMUINT4>(buffers.Describe(joints)).CopyTo(&vertices[0].joints, sizeof(Vertex));
+    for (size_t i = 0; i < packed.size(); ++i) {
+        const Vertex& v = vertices[i];
+        CHECK(v.pos.x == float(i) && v.pos.y == float(i) * 2 && v.pos.z == -float(i));
+        CHECK(v.color.x == float(i) / 255.0f && v.color.y == 1.0f && v.color.z == 0.0f);
+        CHECK(v.color.w == float(51 * i) / 255.0f);
+        CHECK(v.joints.x == i && v.joints.y == 300 + i && v.joints.z == 0 && v.joints.w == 65535);
+    }
+}
+
+// sparse：三種索引型別；沒有 bufferView 的 accessor 以 0 為底；超出 count 的索引略過；operator[] 以二分搜尋取值
+void TestSparse() {
+    for (GltfComponentType indexType : { GltfComponentType::UnsignedByte, GltfComponentType::UnsignedShort,
+                                         GltfComponentType::UnsignedInt }) {
+        for (bool hasBase : { true, false }) {
+            Buffers buffers;
+            std::vector<int16_t> base(10 * 3);
+            for (size_t i = 0; i < base.size(); ++i) {
+                base[i] = int16_t(i);
+            }
+            const int baseView = buffers.Add(Bytes(base));
+            std::vector<uint8_t> indexBytes;
+            for (uint32_t index : { 1u, 4u, 9u, 200u }) {
+                const uint8_t* p = reinterpret_cast<const uint8_t*>(&index);
+                indexBytes.insert(indexBytes.end(), p, p + GltfComponentSize(indexType));   // 小端序
+            }
+            const int indexView = buffers.Add(indexBytes);
+            const int valueView = buffers.Add(Bytes(std::vector<int16_t>{ 100, 101, 102, 400, 401, 402,
+                                                                          900, 901, 902, 7, 7, 7 }));
+
+            GltfAccessorFields fields;
+            fields.bufferView = hasBase ? baseView : -1;
+            fields.count = 10;
+            fields.componentType = int(GltfComponentType::Short);
+            fields.components = 3;
+            fields.sparseCount = 4;
+            fields.sparseIndicesView = indexView;
+            fields.sparseIndexType = int(indexType);
+            fields.sparseValuesView = valueView;
+            const AccessorSpan<XMFLOAT3> values(buffers.Describe(fields));
+            CHECK(values.valid() && values.size() == 10);
+
+            const std::vector<XMFLOAT3> all = values.ToVector();
+            for (size_t i = 0; i < 10; ++i) {
+                const bool replaced = i == 1 || i == 4 || i == 9;
+                const float x = replaced ? float(i * 100) : hasBase ? float(i * 3) : 0.0f;
+                const float z = replaced || hasBase ? x + 2 : 0.0f;
+                CHECK(all[i].x == x && all[i].z == z);
+                CHECK(values[i].x == x && values[i].z == z);
+            }
+            CHECK(values[10].x == 0.0f);   // 超出 count
+        }
+    }
+}
+
+// 元件數不符、float 讀成整數時 valid() 為 false，讀取回傳預設值
+void TestSpanTypeMismatch() {
+    Buffers buffers;
+    const int view = buffers.Add(Bytes(std::vector<float>{ 1, 2, 3, 4, 5, 6 }));
+    GltfAccessorFields fields;
+    fields.bufferView = view;
+    fields.count = 2;
+    fields.componentType = int(GltfComponentType::Float);
+    fields.components = 3;
+    const GltfAccessorDesc desc = buffers.Describe(fields);
+    CHECK(AccessorSpan<XMFLOAT3>(desc).valid());
+    CHECK(!AccessorSpan<XMFLOAT4>(desc).valid() && AccessorSpan<XMFLOAT4>(desc).empty());
+    CHECK(!AccessorSpan<XMUINT4>(desc).valid());
+    CHECK(AccessorSpan<XMFLOAT4>(desc).ToVector().empty() && AccessorSpan<XMFLOAT4>(desc)[0].x == 0.0f);
+}
+
+bool Throws(const Buffers& buffers, const GltfAccessorFields& fields) {
+    try {
+        buffers.Describe(fields);
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+// 每一種範圍或型別錯誤都拋出 std::runtime_error，不會產生指向緩衝區外的描述
+void TestRangeChecksThrow() {
+    Buffers buffers;
+    const int view = buffers.Add(std::vector<uint8_t>(48));
+    const int strided = buffers.Add(std::vector<uint8_t>(48), 8);
+    const int indices = buffers.Add(std::vector<uint8_t>(4));
+
+    GltfAccessorFields ok;
+    ok.bufferView = view;
+    ok.count = 4;
+    ok.componentType = int(GltfComponentType::Float);
+    ok.components = 3;
+    CHECK(!Throws(buffers, ok));
+
+    GltfAccessorFields f = ok;
+    f.count = 5;                                       // 5 × 12 > 48
+    CHECK(Throws(buffers, f));
+    f = ok;
+    f.byteOffset = 4;                                  // 4 + 48 > 48
+    CHECK(Throws(buffers, f));
+    f = ok;
+    f.byteOffset = 100;                                // 起點就在緩衝區外
+    f.count = 0;
+    CHECK(Throws(buffers, f));
+    f = ok;
+    f.count = std::numeric_limits<size_t>::max() / 4;  // (count - 1) * stride 溢位
+    CHECK(Throws(buffers, f));
+    f = ok;
+    f.bufferView = strided;                            // byteStride 8 < 元素大小 12
+    CHECK(Throws(buffers, f));
+    f = ok;
+    f.bufferView = 7;
+    CHECK(Throws(buffers, f));
+    f = ok;
+    f.componentType = 5124;                            // 5124（INT）不是合法的 componentType
+    CHECK(Throws(buffers, f));
+    f = ok;
+    f.components = 0;
+    CHECK(Throws(buffers, f));
+
+    // 剛好用到最後一個位元組：交錯緩衝的最後一個元素不需要完整的 stride
+    f = ok;
+    f.bufferView = strided;
+    f.componentType = int(GltfComponentType::UnsignedShort);
+    f.components = 2;
+    f.count = 6;
+    f.byteOffset = 4;                                  // 4 + 5 × 8 + 4 = 48
+    CHECK(!Throws(buffers, f));
+    f.count = 7;
+    CHECK(Throws(buffers, f));
+
+    GltfAccessorFields sparse = ok;
+    sparse.sparseCount = 2;
+    sparse.sparseIndicesView = indices;
+    sparse.sparseIndexType = int(GltfComponentType::UnsignedShort);
+    sparse.sparseValuesView = view;
+    CHECK(!Throws(buffers, sparse));
+    f = sparse;
+    f.sparseIndexType = int(GltfComponentType::Short);  // 索引只能是無號
+    CHECK(Throws(buffers, f));
+    f = sparse;
+    f.sparseCount = 3;                                  // 3 × 2 > 4
+    CHECK(Throws(buffers, f));
+    f = sparse;
+    f.sparseValuesOffset = 40;                          // 40 + 2 × 12 > 48
+    CHECK(Throws(buffers, f));
+    f = sparse;
+    f.sparseIndicesView = -1;
+    CHECK(Throws(buffers, f));
+    f = sparse;
+    f.sparseCount = std::numeric_limits<size_t>::max() / 2;
+    CHECK(Throws(buffers, f));
+}
+
+// tinygltf 模型經由同一套檢查：bufferView 超出 buffer 與 buffer 不存在都拋出例外，正常的資料讀法相同
+void TestTinyGltfModel() {
+    tinygltf::Model model;
+    model.buffers.resize(1);
+    model.buffers[0].data = Bytes(std::vector<uint16_t>{ 0, 1, 2, 2, 3, 0 });
+    tinygltf::BufferView view;
+    view.buffer = 0;
+    view.byteLength = 12;
+    model.bufferViews.push_back(view);
+    tinygltf::Accessor accessor;
+    accessor.bufferView = 0;
+    accessor.count = 6;
+    accessor.componentType = TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT;
+    accessor.type = TINYGLTF_TYPE_SCALAR;
+    model.accessors.push_back(accessor);
+
+    const std::vector<uint32_t> indices = AccessorSpan<uint32_t>(DescribeGltfAccessor(model, 0)).ToVector();
+    CHECK(indices == (std::vector<uint32_t>{ 0, 1, 2, 2, 3, 0 }));
+
+    auto throws = [&](int index) {
+        try {
+            DescribeGltfAccessor(model, index);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    CHECK(throws(1) && throws(-1));
+    model.bufferViews[0].byteLength = 14;
+    CHECK(throws(0));
+    model.bufferViews[0].byteLength = 12;
+    model.bufferViews[0].buffer = 1;
+    CHECK(throws(0));
+}
+
+} // namespace
+
+int main() {
+    TestConvertMatchesReference();
+    TestNormalizedEndpoints();
+    TestInterleavedAttributes();
+    TestSparse();
+    TestSpanTypeMismatch();
+    TestRangeChecksThrow();
+    TestTinyGltfModel();
+    std::printf("GltfAccessorTest ok\n");
+    return 0;
+}
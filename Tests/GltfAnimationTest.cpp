@@ -0,0 +1,224 @@
+#include "AnimationPlayer.h"
+#include "GltfAnimation.h"
+#include "GltfTestFile.h"
+#include "TestCheck.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using DirectX::XMFLOAT4X4;
+
+namespace {
+
+bool Near(float a, float b, float epsilon = 1e-3f) {
+    return std::fabs(a - b) <= epsilon;
+}
+
+// 節點：0 Armature（非 joint，translation z = 10）→ 1 hips → 2 offset（非 joint，matrix 平移 y = 1）
+// → 3 spine → 4 head（translation y = 0.5，沒有動畫）；skin.joints 依子先父後排列 [head, spine, hips]
+// 動畫：hips 的 translation 為 STEP（x：0、5、7 於 0、1、2 秒），scale 為 CUBICSPLINE（1 → 2，切線 0），
+// spine 的 rotation 為 normalized short 的 LINEAR（0° → 繞 Z 90°），另有一個以非 joint 節點為目標的通道
+GltfTestFile BuildRig() {
+    GltfTestFile file;
+    auto& json = file.json;
+    json["nodes"] = nlohmann::json::array({
+        { { "name", "Armature" }, { "children", { 1 } }, { "translation", { 0, 0, 10 } } },
+        { { "name", "hips" }, { "children", { 2 } } },
+        { { "name", "offset" }, { "children", { 3 } },
+          { "matrix", { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 1, 0, 1 } } },
+        { { "name", "spine" }, { "children", { 4 } } },
+        { { "name", "head" }, { "translation", { 0, 0.5, 0 } } },
+    });
+
+    std::vector<float> inverseBind;
+    for (int joint = 0; joint < 3; ++joint) {
+        std::vector<float> m = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, joint == 1 ? -1.0f : 0.0f, 0, 1 };
+        inverseBind.insert(inverseBind.end(), m.begin(), m.end());
+    }
+    json["skins"] = nlohmann::json::array({
+        { { "joints", { 4, 3, 1 } }, { "inverseBindMatrices", file.AddFloats(inverseBind, "MAT4", 16) } },
+    });
+
+    const int stepTimes = file.AddFloats({ 0, 1, 2 }, "SCALAR", 1);
+    const int stepValues = file.AddFloats({ 0, 0, 0, 5, 0, 0, 7, 0, 0 }, "VEC3", 3);
+    const int splineTimes = file.AddFloats({ 0, 2 }, "SCALAR", 1);
+    const int splineValues = file.AddFloats({ 0, 0, 0, 1, 1, 1, 0, 0, 0, 0, 0, 0, 2, 2, 2, 0, 0, 0 }, "VEC3", 3);
+    const int rotationTimes = file.AddFloats({ 0, 1 }, "SCALAR", 1);
+    const std::vector<int16_t> rotations = { 0, 0, 0, 32767, 0, 0, 23170, 23170 };
+    const int rotationValues = file.AddAccessor(rotations, 5122, 2, "VEC4", true);
+
+    json["animations"] = nlohmann::json::array({ {
+        { "name", "Walk" },
+        { "samplers", {
+            { { "input", stepTimes }, { "output", stepValues }, { "interpolation", "STEP" } },
+            { { "input", splineTimes }, { "output", splineValues }, { "interpolation", "CUBICSPLINE" } },
+            { { "input", rotationTimes }, { "output", rotationValues } },
+        } },
+        { "channels", {
+            { { "sampler", 0 }, { "target", { { "node", 1 }, { "path", "translation" } } } },
+            { { "sampler", 1 }, { "target", { { "node", 1 }, { "path", "scale" } } } },
+            { { "sampler", 2 }, { "target", { { "node", 3 }, { "path", "rotation" } } } },
+            { { "sampler", 0 }, { "target", { { "node", 2 }, { "path", "translation" } } } },
+        } },
+    } });
+    return file;
+}
+
+// 依取樣器規則手算的值
+float StepX(float time) {
+    return time < 1.0f ? 0.0f : time < 2.0f ? 5.0f : 7.0f;
+}
+
+float SplineScale(float time) {
+    const float u = std::fmin(time / 2.0f, 1.0f);
+    return 1.0f + 3.0f * u * u - 2.0f * u * u * u;
+}
+
+float SpineAngle(float time) {
+    return 1.5707963f * std::fmin(time, 1.0f);
+}
+
+struct Fixture {
+    fs::path root;
+    Skeleton skel;
+    std::vector<int> nodeToJoint;
+
+    explicit Fixture(const GltfAnimationOptions& options) {
+        root = fs::temp_directory_path() / ("GltfAnimationTest_" + std::to_string(
+            std::chrono::steady_clock::now().time_since_epoch().count()));
+        fs::create_directories(root);
+        BuildRig().WriteGltf(root / "rig.gltf");
+        GltfDocument document(root / "rig.gltf");
+        nodeToJoint = ImportGltfSkin(document, 0, skel);
+        ImportGltfAnimations(document, nodeToJoint, skel, options);
+    }
+
+    ~Fixture() {
+        fs::remove_all(root);
+    }
+};
+
+// joint 依 skin.joints 的順序，父 joint 越過非 joint 節點；inverseBindMatrices 依 joint 索引
+void TestSkinHierarchy() {
+    Fixture fixture({});
+    const Skeleton& skel = fixture.skel;
+    CHECK(skel.joints.size() == 3);
+    CHECK(skel.joints[0].name == "head" && skel.joints[0].parentIndex == 1);
+    CHECK(skel.joints[1].name == "spine" && skel.joints[1].parentIndex == 2);
+    CHECK(skel.joints[2].name == "hips" && skel.joints[2].parentIndex == -1);
+    CHECK(fixture.nodeToJoint == (std::vector<int>{ -1, 2, -1, 1, 0 }));
+    CHECK(skel.joints[1].bindPoseInverse._42 == -1.0f && skel.joints[0].bindPoseInverse._42 == 0.0f);
+    CHECK(skel.joints[2].bindPoseInverse._11 == 1.0f);
+
+    // 沒有動畫的 joint 只有靜止姿勢一個 key
+    CHECK(skel.animations.size() == 1 && skel.animations[0].name == "Walk");
+    CHECK(skel.animations[0].channels[0].size() == 1);
+    CHECK(skel.animations[0].channels[0][0].transform._42 == 0.5f);
+    CHECK(Near(skel.animations[0].duration, 2.0f, 0.0f));
+}
+
+// 以 AnimationPlayer 播放，與手算的全域矩陣比對：
+// hips   = S(s) * T(x, 0, 0) * T(0, 0, 10)
+// spine  = Rz(θ) * T(0, 1, 0) * hips
+// head   = T(0, 0.5, 0) * spine
+void CheckPose(const Skeleton& skel, float time) {
+    std::vector<XMFLOAT4X4> globals;
+    AnimationPlayer::ComputeGlobalTransforms(skel, skel.animations[0], time, globals);
+    const float s = SplineScale(time), x = StepX(time), angle = SpineAngle(time);
+    const float c = std::cos(angle), sn = std::sin(angle);
+
+    const XMFLOAT4X4& hips = globals[2];
+    CHECK(Near(hips._11, s) && Near(hips._22, s) && Near(hips._41, x) && Near(hips._43, 10.0f));
+
+    const XMFLOAT4X4& spine = globals[1];
+    CHECK(Near(spine._11, s * c) && Near(spine._12, s * sn) && Near(spine._21, -s * sn));
+    CHECK(Near(spine._41, x) && Near(spine._42, s) && Near(spine._43, 10.0f));
+
+    const XMFLOAT4X4& head = globals[0];
+    CHECK(Near(head._41, x - 0.5f * s * sn) && Near(head._42, s * (0.5f * c + 1.0f)) && Near(head._43, 10.0f));
+}
+
+// 保留原始 key 時間（GltfModelLoader/GltfLoader 的預設）：STEP 在 key 之間保持、CUBICSPLINE 依 Hermite 曲線
+void TestKeyTimesKeepInterpolation() {
+    Fixture fixture({});
+    const Skeleton& skel = fixture.skel;
+    CHECK(skel.animations[0].framesPerSecond == 0.0f);
+    for (float time : { 0.0f, 0.25f, 0.5f, 0.75f, 0.999f, 1.0f, 1.3f, 1.5f, 1.999f, 2.0f, 2.5f }) {
+        CheckPose(skel, time);
+    }
+
+    // STEP 在 1 秒前緊鄰一個保持前值的 key
+    const auto& hips = skel.animations[0].channels[2];
+    bool held = false;
+    for (size_t k = 1; k < hips.size(); ++k) {
+        if (hips[k].time < 1.0f && hips[k].time > 0.9999f) {
+            held = hips[k].transform._41 == 0.0f && hips[k + 1].transform._41 == 5.0f;
+        }
+    }
+    CHECK(held);
+
+    // 線性內插的數值：0.5 秒時 STEP 不是 2.5、CUBICSPLINE 不是 1.25
+    std::vector<XMFLOAT4X4> globals;
+    AnimationPlayer::ComputeGlobalTransforms(skel, skel.animations[0], 0.5f, globals);
+    CHECK(globals[2]._41 == 0.0f && Near(globals[2]._11, 1.15625f));
+}
+
+// 重新取樣：格點上的值即為取樣器的值，AnimationPlayer 由時間換算 key 索引
+void TestResampledGrid() {
+    GltfAnimationOptions options;
+    options.resampleRate = 4.0f;
+    Fixture fixture(options);
+    const SkeletonAnimation& anim = fixture.skel.animations[0];
+    CHECK(anim.framesPerSecond == 4.0f);
+    CHECK(anim.channels[2].size() == 9 && anim.channels[1].size() == 9 && anim.channels[0].size() == 1);
+    CHECK(Near(anim.channels[2][2].transform._11, 1.15625f, 1e-5f));
+    CHECK(anim.channels[2][3].transform._41 == 0.0f && anim.channels[2][4].transform._41 == 5.0f);
+    CHECK(Near(anim.channels[1][2].transform._12, std::sin(0.78539816f), 1e-4f));
+    for (float time : { 0.0f, 0.5f, 1.0f, 1.5f, 2.0f, 3.0f }) {
+        CheckPose(fixture.skel, time);
+    }
+}
+
+// 無效的 skin 拋出例外
+void TestInvalidSkinThrows() {
+    const fs::path root = fs::temp_directory_path() / ("GltfAnimationTest_bad_" + std::to_string(
+        std::chrono::steady_clock::now().time_since_epoch().count()));
+    fs::create_directories(root);
+    GltfTestFile file = BuildRig();
+    file.json["skins"][0]["joints"] = { 4, 4 };
+    file.WriteGltf(root / "bad.gltf");
+    GltfDocument document(root / "bad.gltf");
+    Skeleton skel;
+    bool threw = false;
+    try {
+        ImportGltfSkin(document, 0, skel);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+    threw = false;
+    try {
+        ImportGltfSkin(document, 3, skel);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+    fs::remove_all(root);
+}
+
+} // namespace
+
+int main() {
+    TestSkinHierarchy();
+    TestKeyTimesKeepInterpolation();
+    TestResampledGrid();
+    TestInvalidSkinThrows();
+    std::printf("GltfAnimationTest ok\n");
+    return 0;
+}
@@ -0,0 +1,241 @@
+#include "GltfDocument.h"
+#include "GltfTestFile.h"
+#include "TestCheck.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using DirectX::XMFLOAT3;
+
+namespace {
+
+struct Fixture {
+    fs::path root;
+
+    Fixture() {
+        root = fs::temp_directory_path() / ("GltfDocumentTest_" + std::to_string(
+            std::chrono::steady_clock::now().time_since_epoch().count()));
+        fs::create_directories(root);
+    }
+    ~Fixture() { fs::remove_all(root); }
+};
+
+// 一個三角形：POSITION（float VEC3）與 16 位元索引
+GltfTestFile Triangle() {
+    GltfTestFile file;
+    const int positions = file.AddFloats({ 0, 0, 0, 1, 0, 0, 0, 1, 0 }, "VEC3", 3);
+    const int indices = file.AddAccessor(std::vector<uint16_t>{ 0, 1, 2 }, 5123, 3, "SCALAR");
+    file.json["meshes"] = nlohmann::json::array({ { { "primitives", { {
+        { "attributes", { { "POSITION", positions } } }, { "indices", indices } } } } } });
+    return file;
+}
+
+void CheckTriangle(const GltfDocument& document) {
+    const std::vector<XMFLOAT3> positions = AccessorSpan<XMFLOAT3>(document.DescribeAccessor(0)).ToVector();
+    CHECK(positions.size() == 3);
+    CHECK(positions[1].x == 1.0f && positions[1].y == 0.0f && positions[2].y == 1.0f);
+    CHECK(AccessorSpan<uint32_t>(document.DescribeAccessor(1)).ToVector() == (std::vector<uint32_t>{ 0, 1, 2 }));
+    CHECK(document.Section("meshes").size() == 1 && document.Section("animations").empty());
+}
+
+std::vector<uint8_t> ReadAll(const fs::path& file) {
+    std::ifstream in(file, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), {});
+}
+
+void PutU32(std::vector<uint8_t>& bytes, size_t offset, uint32_t value) {
+    std::memcpy(&bytes[offset], &value, sizeof(value));
+}
+
+bool OpenThrows(const fs::path& file) {
+    try {
+        GltfDocument document(file);
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+bool DescribeThrows(const GltfDocument& document, int accessor) {
+    try {
+        document.DescribeAccessor(accessor);
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+// GLB：BIN chunk 直接作為第一個 buffer；BIN chunk 比 byteLength 長（尾端補位）時取前 byteLength 位元組
+void TestGlb() {
+    Fixture fixture;
+    const GltfTestFile file = Triangle();
+    file.WriteGlb(fixture.root / "triangle.glb");
+    GltfDocument document(fixture.root / "triangle.glb");
+    CHECK(document.BufferCount() == 1 && document.Buffer(0).size() == file.bin.size());
+    CHECK(document.Buffer(1).empty());
+    CheckTriangle(document);
+
+    // 搬移後 bufferView 仍指向同一份對應
+    const GltfDocument moved(std::move(document));
+    CheckTriangle(moved);
+
+    // 把 buffer 的 byteLength 改小（等長替換，JSON chunk 長度不變），BIN chunk 尾端多出的位元組不屬於 buffer
+    GltfTestFile longer = Triangle();
+    longer.bin.resize(longer.bin.size() + 8, 0xCD);
+    longer.WriteGlb(fixture.root / "padded.glb");
+    std::vector<uint8_t> bytes = ReadAll(fixture.root / "padded.glb");
+    const std::string needle = "\"byteLength\":" + std::to_string(longer.bin.size()) + "}";
+    const std::string replacement = "\"byteLength\":" + std::to_string(file.bin.size()) + "}";
+    CHECK(needle.size() == replacement.size());
+    std::string text(bytes.begin(), bytes.end());
+    const size_t at = text.find(needle);
+    CHECK(at != std::string::npos);
+    text.replace(at, needle.size(), replacement);
+    GltfTestFile::WriteBytes(fixture.root / "padded.glb", text.data(), text.size());
+    const GltfDocument padded(fixture.root / "padded.glb");
+    CHECK(padded.Buffer(0).size() == file.bin.size());
+    CheckTriangle(padded);
+}
+
+// .gltf 加外部 .bin：.bin 以記憶體對應；缺檔或資料比 byteLength 短時拋出例外
+void TestExternalBin() {
+    Fixture fixture;
+    const GltfTestFile file = Triangle();
+    file.WriteGltf(fixture.root / "triangle.gltf");
+    CHECK(fs::exists(fixture.root / "triangle.bin"));
+    CheckTriangle(GltfDocument(fixture.root / "triangle.gltf"));
+
+    // 子目錄中的 .bin：uri 相對於 .gltf 所在目錄
+    fs::create_directories(fixture.root / "sub");
+    file.WriteGltf(fixture.root / "sub" / "nested.gltf");
+    CheckTriangle(GltfDocument(fixture.root / "sub" / "nested.gltf"));
+
+    std::vector<uint8_t> bin = ReadAll(fixture.root / "triangle.bin");
+    bin.resize(bin.size() - 4);
+    GltfTestFile::WriteBytes(fixture.root / "triangle.bin", bin.data(), bin.size());
+    CHECK(OpenThrows(fixture.root / "triangle.gltf"));
+    fs::remove(fixture.root / "triangle.bin");
+    CHECK(OpenThrows(fixture.root / "triangle.gltf"));
+}
+
+// data: URI：base64 解碼到記憶體，結果與其他兩種形式相同
+void TestDataUri() {
+    Fixture fixture;
+    const GltfTestFile file = Triangle();
+    file.WriteEmbedded(fixture.root / "embedded.gltf");
+    const GltfDocument document(fixture.root / "embedded.gltf");
+    CHECK(document.BufferCount() == 1 && document.Buffer(0).size() == file.bin.size());
+    CHECK(std::equal(file.bin.begin(), file.bin.end(), document.Buffer(0).begin()));
+    CheckTriangle(document);
+
+    // base64 比 byteLength 短
+    GltfTestFile shortData = Triangle();
+    shortData.bin.resize(8);
+    shortData.WriteEmbedded(fixture.root / "short.gltf");
+    std::vector<uint8_t> bytes = ReadAll(fixture.root / "short.gltf");
+    std::string text(bytes.begin(), bytes.end());
+    const size_t at = text.find("\"byteLength\":8");
+    CHECK(at != std::string::npos);
+    text.replace(at, 14, "\"byteLength\":64");
+    GltfTestFile::WriteBytes(fixture.root / "short.gltf", text.data(), text.size());
+    CHECK(OpenThrows(fixture.root / "short.gltf"));
+}
+
+// 截斷或改壞的 GLB 一律在開啟時拋出 std::runtime_error，不讀取檔案以外的位元組
+void TestTruncatedGlb() {
+    Fixture fixture;
+    Triangle().WriteGlb(fixture.root / "triangle.glb");
+    const std::vector<uint8_t> good = ReadAll(fixture.root / "triangle.glb");
+    const fs::path bad = fixture.root / "bad.glb";
+
+    // 檔頭宣告的長度大於檔案：每一種截斷長度
+    for (size_t size = 12; size < good.size(); ++size) {
+        GltfTestFile::WriteBytes(bad, good.data(), size);
+        CHECK(OpenThrows(bad));
+    }
+
+    // 檔頭長度一起改小：BIN chunk 的長度超出檔案
+    std::vector<uint8_t> bytes = good;
+    bytes.resize(good.size() - 4);
+    PutU32(bytes, 8, uint32_t(bytes.size()));
+    GltfTestFile::WriteBytes(bad, bytes.data(), bytes.size());
+    CHECK(OpenThrows(bad));
+
+    // JSON chunk 的長度超出檔案
+    bytes = good;
+    PutU32(bytes, 12, 0x7FFFFFF0u);
+    GltfTestFile::WriteBytes(bad, bytes.data(), bytes.size());
+    CHECK(OpenThrows(bad));
+
+    // 第一個 chunk 不是 JSON
+    bytes = good;
+    PutU32(bytes, 16, 0x004E4942u);
+    GltfTestFile::WriteBytes(bad, bytes.data(), bytes.size());
+    CHECK(OpenThrows(bad));
+
+    // JSON 內容損壞
+    bytes = good;
+    bytes[20] = '[';
+    bytes[21] = '{';
+    GltfTestFile::WriteBytes(bad, bytes.data(), bytes.size());
+    CHECK(OpenThrows(bad));
+
+    // 只有檔頭、沒有 BIN chunk：buffer 宣告的資料不存在
+    bytes.assign(good.begin(), good.begin() + 20 + std::ptrdiff_t(good[12] | good[13] << 8));
+    PutU32(bytes, 8, uint32_t(bytes.size()));
+    GltfTestFile::WriteBytes(bad, bytes.data(), bytes.size());
+    CHECK(OpenThrows(bad));
+
+    CHECK(OpenThrows(fixture.root / "missing.glb"));
+}
+
+// 超出 buffer 的 bufferView 開啟時不報錯，被 accessor 使用時才拋出；不存在的 accessor／bufferView 同樣拋出
+void TestOutOfRangeBufferView() {
+    Fixture fixture;
+    GltfTestFile file = Triangle();
+    file.json["bufferViews"][0]["byteLength"] = 4096;        // POSITION 的 view 超出 buffer
+    file.json["accessors"].push_back({ { "bufferView", 9 }, { "componentType", 5126 }, { "count", 1 },
+                                       { "type", "SCALAR" } });
+    file.json["accessors"].push_back({ { "bufferView", 1 }, { "byteOffset", 4 }, { "componentType", 5123 },
+                                       { "count", 3 }, { "type", "SCALAR" } });   // 4 + 6 > 6
+    file.json["accessors"].push_back({ { "bufferView", 1 }, { "componentType", 5123 }, { "count", 3 },
+                                       { "type", "MAT3" } });
+    file.WriteGlb(fixture.root / "views.glb");
+
+    const GltfDocument document(fixture.root / "views.glb");
+    CHECK(DescribeThrows(document, 0));
+    CHECK(!DescribeThrows(document, 1));
+    CHECK(DescribeThrows(document, 2));
+    CHECK(DescribeThrows(document, 3));
+    CHECK(DescribeThrows(document, 4));
+    CHECK(DescribeThrows(document, 5) && DescribeThrows(document, -1));
+
+    // bufferView 指向不存在的 buffer 或起點在 buffer 之外
+    GltfTestFile other = Triangle();
+    other.json["bufferViews"][0]["buffer"] = 3;
+    other.json["bufferViews"][1]["byteOffset"] = 1 << 20;
+    other.WriteGlb(fixture.root / "buffers.glb");
+    const GltfDocument buffers(fixture.root / "buffers.glb");
+    CHECK(DescribeThrows(buffers, 0) && DescribeThrows(buffers, 1));
+}
+
+} // namespace
+
+int main() {
+    TestGlb();
+    TestExternalBin();
+    TestDataUri();
+    TestTruncatedGlb();
+    TestOutOfRangeBufferView();
+    std::printf("GltfDocumentTest ok\n");
+    return 0;
+}
@@ -0,0 +1,173 @@
+#include "ContentHash.h"
+#include "GltfDocument.h"
+#include "GltfTestFile.h"
+#include "tiny_gltf.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// GltfModelLoader 開啟 GLB 並解碼頂點的時間與記憶體
+// 改寫前：tinygltf 讀入整個檔案並把 BIN chunk 複製到 tinygltf::Buffer，再由 accessor 轉換到頂點陣列
+// 改寫後：GltfDocument 只解析 JSON，BIN chunk 以記憶體對應直接讀取
+// 兩種方式各在獨立的子行程中執行（以 --run 重新啟動自己），解碼完成、來源仍存活時讀取 /proc/self/status：
+// RssAnon 為配置的記憶體，RssFile 為對應檔案的頁面（可由系統回收的頁面快取），VmHWM 為行程的 RSS 峰值
+// 兩列的 checksum 應相同；非 Linux 平台只印時間
+// 用法：GltfLoadBench [總頂點數] [primitive 數]
+
+namespace fs = std::filesystem;
+using DirectX::XMFLOAT2;
+using DirectX::XMFLOAT3;
+
+namespace {
+
+struct Vertex {
+    XMFLOAT3 pos;
+    XMFLOAT3 norm;
+    XMFLOAT2 uv;
+};
+
+struct DecodedPrimitive {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+};
+
+// POSITION/NORMAL/TEXCOORD_0 與 32 位元索引
+void WriteSyntheticGlb(const fs::path& file, size_t totalVertices, int primitiveCount) {
+    GltfTestFile glb;
+    uint32_t seed = 12345;
+    auto next = [&seed] {
+        seed = seed * 1664525u + 1013904223u;
+        return float(seed >> 8) / float(1u << 24);
+    };
+    nlohmann::json primitives = nlohmann::json::array();
+    const size_t vertices = totalVertices / size_t(primitiveCount);
+    for (int p = 0; p < primitiveCount; ++p) {
+        std::vector<float> positions(vertices * 3), normals(vertices * 3), uvs(vertices * 2);
+        for (auto& v : positions) v = next();
+        for (auto& v : normals) v = next();
+        for (auto& v : uvs) v = next();
+        std::vector<uint32_t> indices(vertices * 3);
+        for (size_t i = 0; i < indices.size(); ++i) {
+            indices[i] = uint32_t((i * 7) % vertices);
+        }
+        nlohmann::json attributes = {
+            { "POSITION", glb.AddFloats(positions, "VEC3", 3) },
+            { "NORMAL", glb.AddFloats(normals, "VEC3", 3) },
+            { "TEXCOORD_0", glb.AddFloats(uvs, "VEC2", 2) },
+        };
+        const int indexAccessor = glb.AddAccessor(indices, 5125, indices.size(), "SCALAR");
+        primitives.push_back({ { "attributes", attributes }, { "indices", indexAccessor } });
+    }
+    glb.json["meshes"] = nlohmann::json::array({ { { "name", "synthetic" }, { "primitives", primitives } } });
+    glb.WriteGlb(file);
+}
+
+// 與 GltfModelLoader 的 DecodePrimitive 相同的 accessor 讀取；describe(index) 回傳 GltfAccessorDesc
+template <typename Describe>
+void Decode(const nlohmann::json& prim, Describe&& describe, DecodedPrimitive& out) {
+    const nlohmann::json& attributes = prim.at("attributes");
+    AccessorSpan<XMFLOAT3> positions(describe(attributes.at("POSITION").get<int>()));
+    out.vertices.resize(positions.size());
+    positions.CopyTo(&out.vertices[0].pos, sizeof(Vertex));
+    AccessorSpan<XMFLOAT3>(describe(attributes.at("NORMAL").get<int>())).CopyTo(&out.vertices[0].norm, sizeof(Vertex));
+    AccessorSpan<XMFLOAT2>(describe(attributes.at("TEXCOORD_0").get<int>())).CopyTo(&out.vertices[0].uv, sizeof(Vertex));
+    AccessorSpan<uint32_t> indices(describe(prim.at("indices").get<int>()));
+    out.indices.resize(indices.size());
+    indices.CopyTo(out.indices.data());
+}
+
+uint64_t Checksum(const std::vector<DecodedPrimitive>& decoded) {
+    uint64_t hash = 0;
+    for (const auto& prim : decoded) {
+        hash = HashBytes(prim.vertices.data(), prim.vertices.size() * sizeof(Vertex), hash);
+        hash = HashBytes(prim.indices.data(), prim.indices.size() * sizeof(uint32_t), hash);
+    }
+    return hash;
+}
+
+// /proc/self/status 中的 kB 數值；讀不到時回傳 -1
+long StatusKb(const char* field) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    const size_t length = std::strlen(field);
+    while (std::getline(status, line)) {
+        if (line.compare(0, length, field) == 0 && line.size() > length && line[length] == ':') {
+            return std::atol(line.c_str() + length + 1);
+        }
+    }
+    return -1;
+}
+
+void PrintRow(const char* mode, double ms, uint64_t checksum) {
+    auto mb = [](long kb) { return kb < 0 ? std::string("-") : std::to_string(kb / 1024); };
+    std::printf("%-10s %9.0f %12s %12s %10s  %016llx\n", mode, ms, mb(StatusKb("RssAnon")).c_str(),
+                mb(StatusKb("RssFile")).c_str(), mb(StatusKb("VmHWM")).c_str(), (unsigned long long)checksum);
+}
+
+int Run(const std::string& mode, const fs::path& file) {
+    std::vector<DecodedPrimitive> decoded;
+    const auto start = std::chrono::steady_clock::now();
+    auto elapsed = [&start] {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    if (mode == "tinygltf") {
+        tinygltf::TinyGLTF loader;
+        tinygltf::Model model;
+        std::string error, warning;
+        if (!loader.LoadBinaryFromFile(&model, &error, &warning, file.string())) {
+            std::fprintf(stderr, "tinygltf: %s\n", error.c_str());
+            return 1;
+        }
+        // tinygltf 的 mesh 結構轉成與 GltfDocument 相同的 JSON 形式，兩邊共用 Decode
+        for (const tinygltf::Primitive& prim : model.meshes.at(0).primitives) {
+            nlohmann::json json = { { "attributes", prim.attributes }, { "indices", prim.indices } };
+            decoded.emplace_back();
+            Decode(json, [&model](int index) { return DescribeGltfAccessor(model, index); }, decoded.back());
+        }
+        PrintRow("tinygltf", elapsed(), Checksum(decoded));
+    } else if (mode == "mapped") {
+        GltfDocument document(file);
+        const nlohmann::json& primitives = document.Section("meshes").at(0).at("primitives");
+        for (const nlohmann::json& prim : primitives) {
+            decoded.emplace_back();
+            Decode(prim, [&document](int index) { return document.DescribeAccessor(index); }, decoded.back());
+        }
+        PrintRow("mapped", elapsed(), Checksum(decoded));
+    } else {
+        std::fprintf(stderr, "unknown mode %s\n", mode.c_str());
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 4 && std::string(argv[1]) == "--run") {
+        return Run(argv[2], argv[3]);
+    }
+
+    const size_t totalVertices = argc > 1 ? size_t(std::atoll(argv[1])) : 3000000;
+    const int primitiveCount = argc > 2 ? std::atoi(argv[2]) : 4;
+    const fs::path file = fs::temp_directory_path() / "GltfLoadBench.glb";
+    WriteSyntheticGlb(file, totalVertices, primitiveCount);
+    std::printf("%zu vertices in %d primitive(s), %.1f MB\n", totalVertices, primitiveCount,
+                fs::file_size(file) / 1048576.0);
+    std::printf("%-10s %9s %12s %12s %10s  %s\n", "loader", "ms", "RssAnon MB", "RssFile MB", "VmHWM MB", "checksum");
+    std::fflush(stdout);
+
+    int result = 0;
+    for (const char* mode : { "tinygltf", "mapped" }) {
+        const std::string command = "\"" + std::string(argv[0]) + "\" --run " + mode + " \"" + file.string() + "\"";
+        result |= std::system(command.c_str());
+    }
+    fs::remove(file);
+    return result == 0 ? 0 : 1;
+}
@@ -0,0 +1,184 @@
+#include "GltfDocument.h"
+#include "ContentHash.h"
+#include "ParallelFor.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// GltfModelLoader 的 primitive 解碼（頂點屬性與索引的 accessor 轉換）依 worker 數的擴展性
+// 產生含大量 primitive 的合成 GLB，分別以 1、2、4… 個 worker 解碼，並確認結果與單執行緒相同
+// GltfModelLoader 本身依賴 Direct3D，這裡以相同的 GltfDocument/AccessorSpan 呼叫重現其 CPU 工作
+// 用法：GltfPrimitiveDecodeBench [primitive 數] [每個 primitive 的頂點數] [最大 worker 數]
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+
+struct Vertex {
+    DirectX::XMFLOAT3 pos;
+    DirectX::XMFLOAT3 norm;
+    DirectX::XMFLOAT2 uv;
+};
+
+struct DecodedPrimitive {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+};
+
+void Append(std::vector<uint8_t>& bin, const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    bin.insert(bin.end(), bytes, bytes + size);
+    while (bin.size() % 4) {
+        bin.push_back(0);
+    }
+}
+
+void WriteU32(std::ofstream& out, uint32_t value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// 每個 primitive 有 POSITION/NORMAL/TEXCOORD_0 與 16 位元索引
+void WriteSyntheticGlb(const fs::path& file, int primitiveCount, int verticesPerPrimitive) {
+    json accessors = json::array();
+    json views = json::array();
+    json primitives = json::array();
+    std::vector<uint8_t> bin;
+    uint32_t seed = 12345;
+    auto next = [&seed] {
+        seed = seed * 1664525u + 1013904223u;
+        return float(seed >> 8) / float(1u << 24);
+    };
+    auto addAccessor = [&](const void* data, size_t size, int componentType, int count, const char* type) {
+        views.push_back({ { "buffer", 0 }, { "byteOffset", bin.size() }, { "byteLength", size } });
+        Append(bin, data, size);
+        accessors.push_back({ { "bufferView", views.size() - 1 }, { "componentType", componentType },
+                              { "count", count }, { "type", type } });
+        return int(accessors.size() - 1);
+    };
+
+    for (int p = 0; p < primitiveCount; ++p) {
+        std::vector<float> positions(size_t(verticesPerPrimitive) * 3);
+        std::vector<float> normals(positions.size());
+        std::vector<float> uvs(size_t(verticesPerPrimitive) * 2);
+        for (auto& v : positions) v = next();
+        for (auto& v : normals) v = next();
+        for (auto& v : uvs) v = next();
+        std::vector<uint16_t> indices(size_t(verticesPerPrimitive) * 3);
+        for (size_t i = 0; i < indices.size(); ++i) {
+            indices[i] = uint16_t((i * 7) % verticesPerPrimitive);
+        }
+        json attributes = {
+            { "POSITION", addAccessor(positions.data(), positions.size() * 4, 5126, verticesPerPrimitive, "VEC3") },
+            { "NORMAL", addAccessor(normals.data(), normals.size() * 4, 5126, verticesPerPrimitive, "VEC3") },
+            { "TEXCOORD_0", addAccessor(uvs.data(), uvs.size() * 4, 5126, verticesPerPrimitive, "VEC2") },
+        };
+        int indexAccessor = addAccessor(indices.data(), indices.size() * 2, 5123, int(indices.size()), "SCALAR");
+        primitives.push_back({ { "attributes", attributes }, { "indices", indexAccessor } });
+    }
+
+    json doc = {
+        { "asset", { { "version", "2.0" } } },
+        { "buffers", json::array({ { { "byteLength", bin.size() } } }) },
+        { "bufferViews", views },
+        { "accessors", accessors },
+        { "meshes", json::array({ { { "name", "synthetic" }, { "primitives", primitives } } }) },
+    };
+    std::string text = doc.dump();
+    while (text.size() % 4) {
+        text.push_back(' ');
+    }
+
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    WriteU32(out, 0x46546C67);   // "glTF"
+    WriteU32(out, 2);
+    WriteU32(out, uint32_t(12 + 8 + text.size() + 8 + bin.size()));
+    WriteU32(out, uint32_t(text.size()));
+    WriteU32(out, 0x4E4F534A);   // JSON
+    out.write(text.data(), std::streamsize(text.size()));
+    WriteU32(out, uint32_t(bin.size()));
+    WriteU32(out, 0x004E4942);   // BIN
+    out.write(reinterpret_cast<const char*>(bin.data()), std::streamsize(bin.size()));
+}
+
+// 與 GltfModelLoader 的 DecodePrimitive 相同的 accessor 讀取
+void Decode(const GltfDocument& document, const json& prim, DecodedPrimitive& out) {
+    const json& attributes = prim.at("attributes");
+    AccessorSpan<DirectX::XMFLOAT3> positions(document.DescribeAccessor(attributes.at("POSITION").get<int>()));
+    out.vertices.resize(positions.size());
+    positions.CopyTo(&out.vertices[0].pos, sizeof(Vertex));
+    AccessorSpan<DirectX::XMFLOAT3> normals(document.DescribeAccessor(attributes.at("NORMAL").get<int>()));
+    normals.CopyTo(&out.vertices[0].norm, sizeof(Vertex));
+    AccessorSpan<DirectX::XMFLOAT2> uvs(document.DescribeAccessor(attributes.at("TEXCOORD_0").get<int>()));
+    uvs.CopyTo(&out.vertices[0].uv, sizeof(Vertex));
+    AccessorSpan<uint32_t> indices(document.DescribeAccessor(prim.at("indices").get<int>()));
+    out.indices.resize(indices.size());
+    indices.CopyTo(out.indices.data());
+}
+
+uint64_t Checksum(const std::vector<DecodedPrimitive>& decoded) {
+    uint64_t hash = 0;
+    for (const auto& prim : decoded) {
+        hash = HashBytes(prim.vertices.data(), prim.vertices.size() * sizeof(Vertex), hash);
+        hash = HashBytes(prim.indices.data(), prim.indices.size() * sizeof(uint32_t), hash);
+    }
+    return hash;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int primitiveCount = argc > 1 ? std::atoi(argv[1]) : 400;
+    const int verticesPerPrimitive = argc > 2 ? std::atoi(argv[2]) : 5000;
+    const int maxWorkers = argc > 3 ? std::atoi(argv[3]) : int((std::max)(1u, std::thread::hardware_concurrency()));
+
+    const fs::path file = fs::temp_directory_path() / "GltfPrimitiveDecodeBench.glb";
+    WriteSyntheticGlb(file, primitiveCount, verticesPerPrimitive);
+    GltfDocument document(file);
+    const json& primitives = document.Section("meshes").at(0).at("primitives");
+    std::printf("%d primitive(s) x %d vertices, %.1f MB\n", primitiveCount, verticesPerPrimitive,
+                fs::file_size(file) / 1048576.0);
+
+    // 先完整解碼一次，讓對應的頁面載入記憶體，第一輪量測才不會包含分頁錯誤
+    {
+        std::vector<DecodedPrimitive> warmup(primitives.size());
+        ParallelFor(primitives.size(), [&](size_t i) { Decode(document, primitives[i], warmup[i]); }, 1);
+    }
+
+    uint64_t reference = 0;
+    double serialMs = 0.0;
+    std::printf("workers  decode ms  speedup\n");
+    for (int workers = 1; workers <= maxWorkers; workers *= 2) {
+        // 取三次中最快的一次，降低排程與配置的雜訊
+        std::vector<DecodedPrimitive> decoded;
+        double ms = 0.0;
+        for (int run = 0; run < 3; ++run) {
+            decoded.assign(primitives.size(), {});
+            auto start = std::chrono::steady_clock::now();
+            ParallelFor(primitives.size(), [&](size_t i) { Decode(document, primitives[i], decoded[i]); },
+                        size_t(workers));
+            double runMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            ms = run == 0 ? runMs : (std::min)(ms, runMs);
+        }
+
+        const uint64_t checksum = Checksum(decoded);
+        if (workers == 1) {
+            reference = checksum;
+            serialMs = ms;
+        } else if (checksum != reference) {
+            std::fprintf(stderr, "result differs from the single-worker decode with %d workers\n", workers);
+            return 1;
+        }
+        std::printf("%7d  %9.1f  %7.2fx\n", workers, ms, serialMs / ms);
+    }
+
+    fs::remove(file);
+    return 0;
+}
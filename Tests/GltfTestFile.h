@@ -0,0 +1,120 @@
+#pragma once
+
+#include "json.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// 測試用的 glTF 產生器：JSON 直接以 nlohmann::json 組成，緩衝區資料依序附加到 bin，
+// 可寫成 .gltf + 外部 .bin、內嵌 data: URI 的 .gltf 或 .glb
+class GltfTestFile {
+public:
+    nlohmann::json json = { { "asset", { { "version", "2.0" } } } };
+    std::vector<uint8_t> bin;
+
+    // 附加 size 位元組（補齊到 4 的倍數）並建立 bufferView，回傳 bufferView 索引
+    int AddView(const void* data, size_t size, size_t byteStride = 0) {
+        nlohmann::json view = { { "buffer", 0 }, { "byteOffset", bin.size() }, { "byteLength", size } };
+        if (byteStride > 0) {
+            view["byteStride"] = byteStride;
+        }
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        bin.insert(bin.end(), bytes, bytes + size);
+        while (bin.size() % 4) {
+            bin.push_back(0);
+        }
+        json["bufferViews"].push_back(view);
+        return int(json["bufferViews"].size() - 1);
+    }
+
+    // 緊密排列的 accessor，回傳 accessor 索引
+    template <typename T>
+    int AddAccessor(const std::vector<T>& values, int componentType, size_t count, const char* type,
+                    bool normalized = false) {
+        int view = AddView(values.data(), values.size() * sizeof(T));
+        nlohmann::json accessor = { { "bufferView", view }, { "componentType", componentType },
+                                    { "count", count }, { "type", type } };
+        if (normalized) {
+            accessor["normalized"] = true;
+        }
+        json["accessors"].push_back(accessor);
+        return int(json["accessors"].size() - 1);
+    }
+
+    int AddFloats(const std::vector<float>& values, const char* type, size_t components) {
+        return AddAccessor(values, 5126, values.size() / components, type);
+    }
+
+    // bin 在 .gltf 旁寫成同名 .bin
+    void WriteGltf(const std::filesystem::path& file) const {
+        std::filesystem::path binFile = file;
+        binFile.replace_extension(".bin");
+        WriteBytes(binFile, bin.data(), bin.size());
+        WriteText(file, WithBuffer(binFile.filename().string()).dump());
+    }
+
+    void WriteEmbedded(const std::filesystem::path& file) const {
+        WriteText(file, WithBuffer("data:application/octet-stream;base64," + Base64(bin)).dump());
+    }
+
+    void WriteGlb(const std::filesystem::path& file) const {
+        std::string text = WithBuffer(std::string()).dump();
+        while (text.size() % 4) {
+            text.push_back(' ');
+        }
+        std::vector<uint8_t> out;
+        auto u32 = [&out](uint32_t value) {
+            out.insert(out.end(), reinterpret_cast<const uint8_t*>(&value), reinterpret_cast<const uint8_t*>(&value) + 4);
+        };
+        u32(0x46546C67u);
+        u32(2);
+        u32(uint32_t(12 + 8 + text.size() + 8 + bin.size()));
+        u32(uint32_t(text.size()));
+        u32(0x4E4F534Au);
+        out.insert(out.end(), text.begin(), text.end());
+        u32(uint32_t(bin.size()));
+        u32(0x004E4942u);
+        out.insert(out.end(), bin.begin(), bin.end());
+        WriteBytes(file, out.data(), out.size());
+    }
+
+    static void WriteBytes(const std::filesystem::path& file, const void* data, size_t size) {
+        std::ofstream out(file, std::ios::binary);
+        out.write(static_cast<const char*>(data), std::streamsize(size));
+    }
+
+private:
+    // uri 為空時不寫 uri（GLB 的 BIN chunk）
+    nlohmann::json WithBuffer(const std::string& uri) const {
+        nlohmann::json result = json;
+        nlohmann::json buffer = { { "byteLength", bin.size() } };
+        if (!uri.empty()) {
+            buffer["uri"] = uri;
+        }
+        result["buffers"] = nlohmann::json::array({ buffer });
+        return result;
+    }
+
+    static void WriteText(const std::filesystem::path& file, const std::string& text) {
+        WriteBytes(file, text.data(), text.size());
+    }
+
+    static std::string Base64(const std::vector<uint8_t>& data) {
+        static const char kDigits[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string out;
+        for (size_t i = 0; i < data.size(); i += 3) {
+            uint32_t bits = uint32_t(data[i]) << 16;
+            if (i + 1 < data.size()) bits |= uint32_t(data[i + 1]) << 8;
+            if (i + 2 < data.size()) bits |= data[i + 2];
+            out.push_back(kDigits[(bits >> 18) & 63]);
+            out.push_back(kDigits[(bits >> 12) & 63]);
+            out.push_back(i + 1 < data.size() ? kDigits[(bits >> 6) & 63] : '=');
+            out.push_back(i + 2 < data.size() ? kDigits[bits & 63] : '=');
+        }
+        return out;
+    }
+};
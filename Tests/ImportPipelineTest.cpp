@@ -0,0 +1,142 @@
+#include "ImportPipeline.h"
+#include "TestCheck.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Fixture {
+    fs::path root;
+    std::vector<fs::path> files;
+
+    explicit Fixture(size_t count) {
+        root = fs::temp_directory_path() / ("ImportPipelineTest_" + std::to_string(
+            std::chrono::steady_clock::now().time_since_epoch().count()));
+        fs::create_directories(root);
+        for (size_t i = 0; i < count; ++i) {
+            files.push_back(root / ("file" + std::to_string(i) + ".bin"));
+            std::ofstream(files.back(), std::ios::binary) << std::string(1000 + i * 100, char('a' + i % 26));
+        }
+    }
+    ~Fixture() { fs::remove_all(root); }
+};
+
+// 每個檔案都經過所有階段一次；讀到的內容原樣傳到上傳階段
+void TestAllFilesReachUpload() {
+    Fixture fixture(24);
+    std::set<std::string> uploaded;
+    size_t uploadedBytes = 0;
+    ImportPipelineOptions options;
+    options.parseWorkers = 3;
+    options.processWorkers = 2;
+    ImportPipeline<size_t, size_t> pipeline(
+        [](const fs::path&, std::vector<uint8_t>&& bytes) { return bytes.size(); },
+        [](const fs::path&, size_t&& size) { return size * 2; },
+        [&](const fs::path& file, size_t&& doubled) {
+            uploaded.insert(file.filename().string());
+            uploadedBytes += doubled / 2;
+        },
+        options);
+
+    ImportPipelineStats stats = pipeline.Run(fixture.files);
+    CHECK(uploaded.size() == fixture.files.size());
+    CHECK(stats.failures.empty());
+    uint64_t expectedBytes = 0;
+    for (const auto& file : fixture.files) {
+        expectedBytes += fs::file_size(file);
+    }
+    CHECK(uploadedBytes == expectedBytes);
+    CHECK(stats[ImportStage::Read].bytesRead == expectedBytes);
+    for (size_t stage = 0; stage < static_cast<size_t>(ImportStage::Count); ++stage) {
+        CHECK(stats.stages[stage].items == fixture.files.size());
+    }
+}
+
+// 任一階段失敗只略過該檔案；失敗的檔案與原因記錄在 stats.failures
+void TestFailuresSkipLaterStages() {
+    Fixture fixture(10);
+    fixture.files.push_back(fixture.root / "missing.bin");
+    size_t uploads = 0;
+    ImportPipeline<std::string, std::string> pipeline(
+        [](const fs::path& file, std::vector<uint8_t>&&) {
+            if (file.filename() == "file3.bin") {
+                throw std::runtime_error("bad header");
+            }
+            return file.filename().string();
+        },
+        [](const fs::path&, std::string&& name) {
+            if (name == "file7.bin") {
+                throw std::runtime_error("bad mesh");
+            }
+            return name;
+        },
+        [&](const fs::path&, std::string&&) { ++uploads; });
+
+    ImportPipelineStats stats = pipeline.Run(fixture.files);
+    CHECK(uploads == 8);
+    CHECK(stats.failures.size() == 3);
+    CHECK(stats[ImportStage::Read].failures == 1);
+    CHECK(stats[ImportStage::Parse].failures == 1);
+    CHECK(stats[ImportStage::Process].failures == 1);
+    std::set<std::string> failed;
+    for (const auto& [file, error] : stats.failures) {
+        failed.insert(file.filename().string());
+        CHECK(!error.empty());
+    }
+    CHECK(failed == (std::set<std::string>{ "file3.bin", "file7.bin", "missing.bin" }));
+}
+
+// 在途資料不超過記憶體預算；上傳慢時上游被擋住而不是無限累積
+void TestMemoryBudget() {
+    Fixture fixture(16);
+    ImportPipelineOptions options;
+    options.memoryBudget = 8000;     // 約可容納三到四個檔案的預估大小
+    options.expansionFactor = 2.0;
+    options.queueCapacity = 8;
+    options.parseWorkers = 4;
+    options.processWorkers = 4;
+    size_t uploads = 0;
+    ImportPipeline<size_t, size_t> pipeline(
+        [](const fs::path&, std::vector<uint8_t>&& bytes) { return bytes.size(); },
+        [](const fs::path&, size_t&& size) { return size; },
+        [&](const fs::path&, size_t&&) {
+            ++uploads;
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        },
+        options);
+
+    ImportPipelineStats stats = pipeline.Run(fixture.files);
+    CHECK(uploads == fixture.files.size());
+    CHECK(stats.peakInFlightBytes <= options.memoryBudget);
+    CHECK(stats.peakInFlightBytes > 0);
+    CHECK(stats[ImportStage::Read].blockedSeconds > 0.0);
+
+    // 單一檔案超過預算時仍可通過，管線不會停住
+    options.memoryBudget = 10;
+    ImportPipeline<size_t, size_t> tiny(
+        [](const fs::path&, std::vector<uint8_t>&& bytes) { return bytes.size(); },
+        [](const fs::path&, size_t&& size) { return size; }, nullptr, options);
+    stats = tiny.Run(fixture.files);
+    CHECK(stats.failures.empty());
+    CHECK(stats[ImportStage::Upload].items == fixture.files.size());
+}
+
+} // namespace
+
+int main() {
+    TestAllFilesReachUpload();
+    TestFailuresSkipLaterStages();
+    TestMemoryBudget();
+    std::printf("ImportPipelineTest ok\n");
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include "XNativeModelLoader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// 從剖析結果到 AssetManager 快取（BuildModels 再以 make_shared 移入）之間的配置次數與位元組
+// 改寫前：ModelData::skeleton 為值，每個網格各有一份骨架與動畫的複本
+// 改寫後：同一檔案的網格共用 shared_ptr<const Skeleton>，ModelData 與 SkinMesh 只能移動
+// 測試檔：一條 N 節的骨骼鏈、M 個各有 4 組 SkinWeights 的物件，每節骨骼一條 K 個 key 的動畫
+// 只計算 BuildModels 與移入快取的部分（ParseXFile 不計）；峰值為計數期間同時存活的位元組
+// 改寫前的數字：同一份程式與改寫前的 Src（ModelData::skeleton 仍為值）一起建置
+// 用法：ModelDataAllocBench [物件數] [骨骼數] [每物件頂點數] [每條動畫 key 數]
+// 需要 d3d9.h／d3dx9.h 與 IModelLoader.h（見 Tests/CMakeLists.txt 的 ENGINE_D3D_INCLUDE_DIRS）
+
+namespace {
+
+bool counting = false;
+size_t allocations = 0;
+size_t allocatedBytes = 0;
+size_t liveBytes = 0;
+size_t peakBytes = 0;
+
+// 每塊配置前放 16 位元組的大小欄位，釋放時才知道要從存活量扣掉多少
+constexpr size_t kHeader = 16;
+
+void WriteSkinnedChain(const std::filesystem::path& file, int objects, int bones, int vertices, int keys) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::ofstream out(file, std::ios::binary);
+    auto matrix = [](float x, float y, float z) {
+        return "FrameTransformMatrix { 1,0,0,0, 0,1,0,0, 0,0,1,0, " + std::to_string(x) + "," +
+               std::to_string(y) + "," + std::to_string(z) + ",1;; }\n";
+    };
+
+    out << "xof 0303txt 0032\nAnimTicksPerSecond { 30; }\nFrame Root {\n" << matrix(0, 0, 0);
+    for (int b = 0; b < bones; ++b) {
+        out << "Frame Bone" << b << " {\n" << matrix(0, 1, 0);
+    }
+    out << std::string(size_t(bones) + 1, '}') << "\n";
+
+    for (int m = 0; m < objects; ++m) {
+        out << "Frame Obj" << m << " {\n" << matrix(float(m), 0, 0) << "Mesh Mesh" << m << " {\n" << vertices << ";\n";
+        for (int v = 0; v < vertices; ++v) {
+            out << unit(rng) << ";" << unit(rng) << ";" << unit(rng) << ";" << (v + 1 < vertices ? ",\n" : ";\n");
+        }
+        out << vertices - 2 << ";\n";
+        for (int t = 0; t < vertices - 2; ++t) {
+            out << "3;" << t << "," << t + 1 << "," << t + 2 << ";" << (t + 3 < vertices ? ",\n" : ";\n");
+        }
+        out << "XSkinMeshHeader { 4; 4; 4; }\n";
+        for (int s = 0; s < 4; ++s) {
+            out << "SkinWeights { \"Bone" << (m + s * (bones / 4)) % bones << "\"; " << vertices << "; ";
+            for (int v = 0; v < vertices; ++v) {
+                out << v << (v + 1 < vertices ? "," : ";");
+            }
+            for (int v = 0; v < vertices; ++v) {
+                out << "0.25" << (v + 1 < vertices ? "," : ";");
+            }
+            out << " 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1;; }\n";
+        }
+        out << "} }\n";
+    }
+
+    out << "AnimationSet Walk {\n";
+    for (int b = 0; b < bones; ++b) {
+        out << "Animation { { Bone" << b << " } AnimationKey { 0; " << keys << "; ";
+        for (int k = 0; k < keys; ++k) {
+            out << k * 4 << ";4;1,0,0,0;;" << (k + 1 < keys ? "," : ";");
+        }
+        out << " } }\n";
+    }
+    out << "}\n";
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+    auto* block = static_cast<unsigned char*>(std::malloc(size + kHeader));
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<size_t*>(block) = size;
+    if (counting) {
+        ++allocations;
+        allocatedBytes += size;
+        liveBytes += size;
+        peakBytes = (std::max)(peakBytes, liveBytes);
+    }
+    return block + kHeader;
+}
+
+void operator delete(void* p) noexcept {
+    if (!p) {
+        return;
+    }
+    auto* block = static_cast<unsigned char*>(p) - kHeader;
+    if (counting) {
+        liveBytes -= (std::min)(liveBytes, *reinterpret_cast<size_t*>(block));
+    }
+    std::free(block);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    operator delete(p);
+}
+
+// 量測只走 BuildModels，不建立裝置資源；以空的實作滿足 XNativeModelLoader.cpp 的連結，不需要 SkinMesh.cpp 與 D3D 程式庫
+bool SkinMesh::CreateBuffers(IDirect3DDevice9*) { return false; }
+void SkinMesh::SetTexture(IDirect3DDevice9*, const std::string&) {}
+void SkinMesh::ReleaseBuffers() {}
+
+int main(int argc, char** argv) {
+    const int objects = argc > 1 ? std::atoi(argv[1]) : 50;
+    const int bones = argc > 2 ? std::atoi(argv[2]) : 80;
+    const int vertices = argc > 3 ? std::atoi(argv[3]) : 300;
+    const int keys = argc > 4 ? std::atoi(argv[4]) : 60;
+
+    const std::filesystem::path file = std::filesystem::temp_directory_path() / ("ModelDataAllocBench_" +
+        std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".x");
+    WriteSkinnedChain(file, objects, bones, vertices, keys);
+    const XFileScene scene = ParseXFile(file);
+    std::filesystem::remove(file);
+    std::printf("%zu frames, %zu meshes, %d bones x %d keys\n", scene.frames.size(), scene.meshes.size(), bones, keys);
+
+    std::vector<std::shared_ptr<ModelData>> cache;
+    counting = true;
+    {
+        auto models = XNativeModelLoader::BuildModels(scene);
+        for (auto& [name, model] : models) {
+            cache.push_back(std::make_shared<ModelData>(std::move(model)));
+        }
+    }
+    counting = false;
+
+    std::printf("%-8s %12s %14s %14s\n", "models", "allocations", "allocated MB", "peak live MB");
+    std::printf("%-8zu %12zu %14.2f %14.2f\n", cache.size(), allocations, allocatedBytes / 1048576.0,
+                peakBytes / 1048576.0);
+    return 0;
+}
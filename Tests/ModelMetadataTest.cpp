@@ -0,0 +1,172 @@
+#include "GltfDocument.h"
+#include "GltfTestFile.h"
+#include "ModelMetadata.h"
+#include "TestCheck.h"
+#include "XFileParser.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Fixture {
+    fs::path root;
+
+    Fixture() {
+        root = fs::temp_directory_path() / ("ModelMetadataTest_" + std::to_string(
+            std::chrono::steady_clock::now().time_since_epoch().count()));
+        fs::create_directories(root);
+    }
+    ~Fixture() { fs::remove_all(root); }
+
+    fs::path Write(const char* name, const std::string& text) const {
+        std::ofstream(root / name, std::ios::binary) << text;
+        return root / name;
+    }
+};
+
+bool Same(const std::vector<ModelObjectInfo>& a, const std::vector<ModelObjectInfo>& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const ModelObjectInfo& x, const ModelObjectInfo& y) {
+        return x.name == y.name && x.vertexCount == y.vertexCount && x.triangleCount == y.triangleCount &&
+               x.materialCount == y.materialCount;
+    });
+}
+
+// 涵蓋每一條命名規則：同一 Frame 多個 Mesh、無名 Frame 的具名 Mesh、全部無名（mesh_N）、
+// 頂層 Mesh、重複的 Frame 名稱，以及沒有三角形的 Mesh（不產生模型但仍佔用名稱）
+const char kNames[] = R"(xof 0303txt 0032
+Material Red { 1;0;0;1;; 5; 0;0;0;; 0;0;0;; }
+Frame Body {
+  Mesh Torso { 4; 0;0;0;, 1;0;0;, 1;1;0;, 0;1;0;; 2; 3;0,1,2;, 4;0,1,2,3;;
+    MeshMaterialList { 2; 2; 0, 1;; { Red } Material { 0;1;0;1;; 5; 0;0;0;; 0;0;0;; } } }
+  Mesh { 3; 0;0;0;, 1;0;0;, 0;1;0;; 1; 3;0,1,2;; }
+  Frame {
+    Mesh Arm { 3; 0;0;0;, 1;0;0;, 0;1;0;; 1; 3;0,1,2;; }
+    Frame { Mesh { 5; 0;0;0;, 1;0;0;, 1;1;0;, 0;1;0;, 0;2;0;; 1; 5;0,1,2,3,4;; } }
+  }
+}
+Frame Body { Mesh { 3; 0;0;0;, 1;0;0;, 0;1;0;; 1; 3;0,1,2;; } }
+Frame Empty { Mesh Nothing { 3; 0;0;0;, 1;0;0;, 0;1;0;; 0; ; } }
+Mesh { 3; 0;0;0;, 1;0;0;, 0;1;0;; 1; 3;0,1,2;; }
+Mesh Loose { 3; 0;0;0;, 1;0;0;, 0;1;0;; 1; 3;0,1,2;; }
+)";
+
+// XNativeModelLoader::BuildModels 產生的模型：XFileModelNames(scene) 命名，略過沒有索引的 Mesh
+std::vector<ModelObjectInfo> LoaderModels(const XFileScene& scene) {
+    const std::vector<std::string> names = XFileModelNames(scene);
+    std::vector<ModelObjectInfo> models;
+    for (size_t i = 0; i < scene.meshes.size(); ++i) {
+        const XFileMesh& mesh = scene.meshes[i];
+        if (mesh.indices.empty()) {
+            continue;
+        }
+        models.push_back({ names[i], uint32_t(mesh.positions.size()), uint32_t(mesh.indices.size() / 3),
+                           uint32_t(mesh.materials.size()) });
+    }
+    return models;
+}
+
+std::vector<std::string> Names(const std::vector<ModelObjectInfo>& infos) {
+    std::vector<std::string> names;
+    for (const auto& info : infos) {
+        names.push_back(info.name);
+    }
+    return names;
+}
+
+void TestXFileNamesMatchLoader() {
+    Fixture fixture;
+    const fs::path file = fixture.Write("names.x", kNames);
+    const std::vector<ModelObjectInfo> scanned = ScanXFileMetadata(file);
+    CHECK(Names(scanned) == (std::vector<std::string>{
+        "Body", "Body_1", "Arm", "mesh_0", "Body_2", "mesh_1", "Loose" }));
+    CHECK(Same(scanned, LoaderModels(ParseXFile(file))));
+    CHECK(scanned[0].triangleCount == 3 && scanned[0].materialCount == 2);
+    CHECK(scanned[3].vertexCount == 5 && scanned[3].triangleCount == 3);
+
+    // ScanModelMetadata 依副檔名分派；不支援或損壞的檔案回傳空列表
+    CHECK(Same(ScanModelMetadata(file), scanned));
+    CHECK(ScanModelMetadata(fixture.Write("names.obj", kNames)).empty());
+    CHECK(ScanXFileMetadata(fixture.Write("broken.x", std::string(kNames, 120))).empty());
+    CHECK(ScanXFileMetadata(fixture.root / "missing.x").empty());
+}
+
+// GltfModelLoader::LoadMeshes 產生的模型：GltfModelName 命名，POSITION 缺少或為空的 primitive 不產生模型，
+// 頂點數取自 POSITION、三角形數取自索引（沒有索引時為頂點數），每個 primitive 一個材質
+std::vector<ModelObjectInfo> LoaderModels(const GltfDocument& document) {
+    std::vector<ModelObjectInfo> models;
+    const nlohmann::json& meshes = document.Section("meshes");
+    for (size_t meshIdx = 0; meshIdx < meshes.size(); ++meshIdx) {
+        const nlohmann::json& primitives = meshes[meshIdx].at("primitives");
+        for (size_t primIdx = 0; primIdx < primitives.size(); ++primIdx) {
+            const nlohmann::json& prim = primitives[primIdx];
+            const nlohmann::json& attributes = prim.at("attributes");
+            if (!attributes.contains("POSITION")) {
+                continue;
+            }
+            const size_t vertices = document.DescribeAccessor(attributes["POSITION"].get<int>()).count;
+            if (vertices == 0) {
+                continue;
+            }
+            const size_t elements = prim.contains("indices")
+                ? document.DescribeAccessor(prim["indices"].get<int>()).count : vertices;
+            models.push_back({ GltfModelName(meshes[meshIdx], meshIdx, primIdx), uint32_t(vertices),
+                               uint32_t(elements / 3), 1 });
+        }
+    }
+    return models;
+}
+
+GltfTestFile NamesGltf() {
+    GltfTestFile file;
+    const int quad = file.AddFloats({ 0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0 }, "VEC3", 3);
+    const int triangle = file.AddFloats({ 0, 0, 0, 1, 0, 0, 0, 1, 0 }, "VEC3", 3);
+    const int indices = file.AddAccessor(std::vector<uint16_t>{ 0, 1, 2, 0, 2, 3 }, 5123, 6, "SCALAR");
+    file.json["accessors"].push_back({ { "componentType", 5126 }, { "count", 0 }, { "type", "VEC3" } });
+    const int empty = int(file.json["accessors"].size() - 1);
+    auto prim = [](int position, int index) {
+        nlohmann::json p = { { "attributes", { { "POSITION", position } } } };
+        if (index >= 0) {
+            p["indices"] = index;
+        }
+        return p;
+    };
+    file.json["meshes"] = nlohmann::json::array({
+        { { "name", "Body" }, { "primitives", { prim(quad, indices), prim(triangle, -1),
+                                                { { "attributes", { { "NORMAL", triangle } } } } } } },
+        { { "primitives", { prim(triangle, -1) } } },
+        { { "name", "" }, { "primitives", { prim(empty, -1), prim(quad, indices) } } },
+    });
+    return file;
+}
+
+void TestGltfNamesMatchLoader() {
+    Fixture fixture;
+    const GltfTestFile file = NamesGltf();
+    file.WriteGlb(fixture.root / "names.glb");
+    file.WriteGltf(fixture.root / "names.gltf");
+
+    for (const char* name : { "names.glb", "names.gltf" }) {
+        const std::vector<ModelObjectInfo> scanned = ScanModelMetadata(fixture.root / name);
+        CHECK(Names(scanned) == (std::vector<std::string>{ "Body_0", "Body_1", "Mesh_1", "Mesh_2_1" }));
+        CHECK(Same(scanned, LoaderModels(GltfDocument(fixture.root / name))));
+        CHECK(scanned[0].vertexCount == 4 && scanned[0].triangleCount == 2);
+    }
+    CHECK(ScanGltfMetadata(fixture.Write("broken.gltf", "{ \"meshes\": [")).empty());
+}
+
+} // namespace
+
+int main() {
+    TestXFileNamesMatchLoader();
+    TestGltfNamesMatchLoader();
+    std::printf("ModelMetadataTest ok\n");
+    return 0;
+}
@@ -0,0 +1,255 @@
+#include "TestCheck.h"
+#include "TextureCache.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// TextureCache 只以指標識別貼圖，不呼叫任何方法；測試以假的型別代替 Direct3D 貼圖
+struct IDirect3DBaseTexture9 {
+    int id;
+};
+
+namespace fs = std::filesystem;
+
+namespace {
+
+using TexturePtr = TextureCache::TexturePtr;
+
+constexpr TextureCategory kUI = TextureCategory::UI;
+constexpr TextureCategory kModel = TextureCategory::Model;
+constexpr TextureVariant kMipmapped = TextureVariant::Mipmapped;
+
+TexturePtr MakeTexture(int id) {
+    return TexturePtr(new IDirect3DBaseTexture9{ id });
+}
+
+struct Fixture {
+    fs::path root;
+
+    Fixture() {
+        root = fs::temp_directory_path() / ("TextureCacheTest_" + std::to_string(
+            std::chrono::steady_clock::now().time_since_epoch().count()));
+        fs::create_directories(root);
+    }
+    ~Fixture() { fs::remove_all(root); }
+
+    fs::path Write(const std::string& name, const std::string& content) const {
+        fs::path file = root / name;
+        std::ofstream(file, std::ios::binary) << content;
+        return file;
+    }
+};
+
+// 不同分類以同一路徑查詢共用同一張貼圖，兩個分類都計入大小；釋放分類只移除其標記
+void TestCategoriesShareByPath() {
+    TextureCache cache;
+    {
+        TexturePtr ui = cache.Insert("a.png", kMipmapped, 0, {}, MakeTexture(1), 100, kUI);
+        TexturePtr model = cache.Find("a.png", kMipmapped, kModel);
+        CHECK(ui == model);
+        CHECK(cache.Insert("a.png", kMipmapped, 0, {}, MakeTexture(2), 100, kModel) == ui);   // 已存在時保留既有貼圖
+    }
+    TextureCacheStats stats = cache.GetStats();
+    CHECK(stats.textures == 1 && stats.paths == 1);
+    CHECK(stats.residentBytes == 100);
+    CHECK(stats.crossCategoryHits == 1);
+    CHECK(stats.categories[size_t(kUI)].bytes == 100);
+    CHECK(stats.categories[size_t(kModel)].bytes == 100);
+    CHECK(cache.Find("missing.png", kMipmapped, kUI) == nullptr);
+
+    cache.Release(kUI);
+    stats = cache.GetStats();
+    CHECK(stats.textures == 1);
+    CHECK(stats.categories[size_t(kUI)].bytes == 0);
+    cache.Release(kModel);
+    stats = cache.GetStats();
+    CHECK(stats.textures == 0 && stats.paths == 0 && stats.residentBytes == 0);
+}
+
+// 內容相同的不同路徑共用同一張貼圖；雜湊相同但位元組不同時不共用並計入碰撞
+void TestContentDedupVerifiesBytes() {
+    Fixture fixture;
+    const fs::path original = fixture.Write("a.png", "same pixels");
+    const fs::path copy = fixture.Write("copy.png", "same pixels");
+    const fs::path other = fixture.Write("other.png", "different!!");   // 同樣大小
+
+    TextureCache cache;
+    TexturePtr texture = cache.Insert("a.png", kMipmapped, 42, original, MakeTexture(1), 100, kUI);
+    CHECK(cache.FindContent(0, copy, "copy.png", kMipmapped, kUI) == nullptr);
+    CHECK(cache.FindContent(42, copy, "copy.png", kMipmapped, kModel) == texture);
+    CHECK(cache.Peek("copy.png", kMipmapped) == texture);
+    CHECK(cache.IsContentShared(texture.get()));
+    CHECK(cache.FindContent(42, other, "other.png", kMipmapped, kUI) == nullptr);
+    CHECK(cache.Peek("other.png", kMipmapped) == nullptr);
+
+    TextureCacheStats stats = cache.GetStats();
+    CHECK(stats.textures == 1 && stats.paths == 2);
+    CHECK(stats.duplicateLoads == 1 && stats.bytesSaved == 100);
+    CHECK(stats.hashCollisions == 1);
+
+    // 移除其中一個別名時貼圖仍常駐；最後一個路徑移除後才移出快取
+    CHECK(cache.Erase("a.png"));
+    CHECK(cache.IsResident(texture.get()));
+    CHECK(!cache.IsContentShared(texture.get()));
+    CHECK(cache.Erase("copy.png"));
+    CHECK(!cache.IsResident(texture.get()));
+    CHECK(!cache.Erase("copy.png"));
+    CHECK(texture->id == 1);   // 已取出的 shared_ptr 仍然有效
+}
+
+// 超出預算時依最久未使用釋放，仍被外部持有的貼圖不釋放
+void TestBudgetEvictsLeastRecentlyUsed() {
+    TextureCache cache;
+    cache.SetBudget(kUI, 250);
+    TexturePtr held = cache.Insert("held", kMipmapped, 0, {}, MakeTexture(1), 100, kUI);
+    cache.Insert("x", kMipmapped, 0, {}, MakeTexture(2), 100, kUI);
+    cache.Insert("y", kMipmapped, 0, {}, MakeTexture(3), 100, kUI);
+    CHECK(!cache.Peek("x", kMipmapped) && cache.Peek("y", kMipmapped) && cache.Peek("held", kMipmapped));
+
+    cache.Find("y", kMipmapped, kUI);
+    cache.Insert("z", kMipmapped, 0, {}, MakeTexture(4), 100, kUI);
+    CHECK(!cache.Peek("y", kMipmapped) && cache.Peek("z", kMipmapped) && cache.Peek("held", kMipmapped));
+
+    TextureCacheStats stats = cache.GetStats();
+    CHECK(stats.evictions == 2 && stats.bytesEvicted == 200);
+    CHECK(stats.categories[size_t(kUI)].bytes <= 250);
+    CHECK(stats.categories[size_t(kUI)].budget == 250);
+
+    // 外部持有的貼圖超出預算時保留，放開後下一次 Trim 才釋放
+    cache.SetBudget(kUI, 50);
+    CHECK(cache.Peek("held", kMipmapped) && !cache.Peek("z", kMipmapped));
+    held.reset();
+    CHECK(cache.Trim() == 1);
+    CHECK(cache.GetStats().textures == 0);
+}
+
+// 超出預算的分類先釋放只有自己使用的貼圖，其他分類（預算內）仍在用的最後才釋放
+void TestBudgetPrefersUnsharedTextures() {
+    TextureCache cache;
+    cache.SetBudget(kModel, 150);
+    cache.Insert("shared", kMipmapped, 0, {}, MakeTexture(1), 100, kUI);
+    cache.Find("shared", kMipmapped, kModel);
+    cache.Insert("m1", kMipmapped, 0, {}, MakeTexture(2), 10, kModel);
+    cache.Insert("m2", kMipmapped, 0, {}, MakeTexture(3), 10, kModel);
+    CHECK(cache.Peek("shared", kMipmapped) && cache.Peek("m1", kMipmapped) && cache.Peek("m2", kMipmapped));
+
+    // shared 最久未使用，但 UI 仍在用：先丟只有 Model 使用的 m1、m2；剛放入的貼圖由呼叫端持有，不會被丟
+    cache.Insert("m3", kMipmapped, 0, {}, MakeTexture(4), 40, kModel);
+    CHECK(!cache.Peek("m1", kMipmapped) && cache.Peek("m2", kMipmapped));
+    CHECK(cache.Peek("shared", kMipmapped) && cache.Peek("m3", kMipmapped));
+    CHECK(cache.GetStats().categories[size_t(kModel)].bytes == 150);
+
+    cache.Insert("m4", kMipmapped, 0, {}, MakeTexture(5), 40, kModel);
+    CHECK(!cache.Peek("m2", kMipmapped) && !cache.Peek("m3", kMipmapped));
+    CHECK(cache.Peek("shared", kMipmapped) && cache.Peek("m4", kMipmapped));
+
+    // 只丟 Model 獨用的貼圖仍不足時才丟 shared，UI 的引用一併移除
+    cache.Insert("m5", kMipmapped, 0, {}, MakeTexture(6), 100, kModel);
+    CHECK(!cache.Peek("m4", kMipmapped) && !cache.Peek("shared", kMipmapped));
+    CHECK(cache.Peek("m5", kMipmapped));
+    TextureCacheStats stats = cache.GetStats();
+    CHECK(stats.categories[size_t(kModel)].bytes == 100);
+    CHECK(stats.categories[size_t(kUI)].bytes == 0);
+}
+
+// TextureManager 的查詢：依分類可用的 variant 依序查詢
+TexturePtr FindFor(TextureCache& cache, const std::string& path, TextureCategory category) {
+    for (TextureVariant variant : AcceptedTextureVariants(category)) {
+        if (TexturePtr texture = cache.Find(path, variant, category)) {
+            return texture;
+        }
+    }
+    return nullptr;
+}
+
+// 同一檔案由兩個分類以不同方式載入：UI 背景解碼的單層貼圖不給模型使用，串流貼圖不給 UI 使用；
+// 內容鍵同樣區分 variant。D3DX 載入的 Stretched 兩個分類共用
+void TestVariantsAreNotShared() {
+    Fixture fixture;
+    const fs::path file = fixture.Write("icon.png", "icon pixels");
+    const fs::path copy = fixture.Write("icon_copy.png", "icon pixels");
+
+    TextureCache cache;
+    TexturePtr ui = cache.Insert("icon.png", TextureVariant::TopLevel, 42, file, MakeTexture(1), 100, kUI);
+    CHECK(FindFor(cache, "icon.png", kUI) == ui);
+    CHECK(FindFor(cache, "icon.png", kModel) == nullptr);
+    CHECK(cache.FindContent(42, copy, "icon_copy.png", kMipmapped, kModel) == nullptr);
+    CHECK(cache.GetStats().hashCollisions == 0 && cache.GetStats().crossCategoryHits == 0);
+
+    // 模型載入自己的含 mip 版本；UI 之後仍優先拿到單層版本
+    TexturePtr model = cache.Insert("icon.png", kMipmapped, 42, file, MakeTexture(2), 130, kModel);
+    CHECK(model != ui);
+    CHECK(FindFor(cache, "icon.png", kModel) == model && FindFor(cache, "icon.png", kUI) == ui);
+    CHECK(cache.FindContent(42, copy, "icon_copy.png", kMipmapped, kModel) == model);
+    CHECK(cache.FindContent(42, copy, "icon_copy.png", TextureVariant::TopLevel, kUI) == ui);
+
+    // 串流貼圖只由 LoadStreamed 以 Streamed 查詢
+    TexturePtr streamed = cache.Insert("rock.dds", TextureVariant::Streamed, 0, {}, MakeTexture(3), 50, kModel);
+    CHECK(FindFor(cache, "rock.dds", kUI) == nullptr && FindFor(cache, "rock.dds", kModel) == nullptr);
+    CHECK(cache.Find("rock.dds", TextureVariant::Streamed, kModel) == streamed);
+
+    // 兩邊都接受 D3DX 的 Stretched
+    TexturePtr stretched = cache.Insert("bg.bmp", TextureVariant::Stretched, 0, {}, MakeTexture(4), 200, kModel);
+    CHECK(FindFor(cache, "bg.bmp", kUI) == stretched);
+    CHECK(cache.GetStats().crossCategoryHits == 1);
+
+    TextureCacheStats stats = cache.GetStats();
+    CHECK(stats.textures == 4 && stats.paths == 6);
+    CHECK(stats.categories[size_t(kUI)].bytes == 300 && stats.categories[size_t(kModel)].bytes == 380);
+
+    // 熱重載移除路徑的所有 variant
+    CHECK(cache.Erase("icon.png"));
+    CHECK(FindFor(cache, "icon.png", kUI) == nullptr && FindFor(cache, "icon.png", kModel) == nullptr);
+    CHECK(cache.IsResident(ui.get()) && cache.IsResident(model.get()));   // icon_copy.png 仍引用
+    CHECK(cache.Erase("icon_copy.png"));
+    CHECK(!cache.IsResident(ui.get()) && !cache.IsResident(model.get()));
+    CHECK(cache.GetStats().textures == 2);
+}
+
+// 多執行緒同時查詢、放入、移除與讀統計
+void TestConcurrentAccess() {
+    TextureCache cache;
+    cache.SetBudget(kModel, 300);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, t] {
+            const TextureCategory category = t % 2 ? kUI : kModel;
+            for (int i = 0; i < 2000; ++i) {
+                const std::string key = "k" + std::to_string(i % 50);
+                if (!cache.Find(key, kMipmapped, category)) {
+                    cache.Insert(key, kMipmapped, 0, {}, MakeTexture(i), 10, category);
+                }
+                if (i % 97 == 0) {
+                    cache.Erase(key);
+                }
+                cache.GetStats();
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    TextureCacheStats stats = cache.GetStats();
+    CHECK(stats.categories[size_t(kModel)].bytes <= 300);
+    CHECK(stats.textures <= 50);
+    cache.Clear();
+    CHECK(cache.GetStats().textures == 0);
+}
+
+} // namespace
+
+int main() {
+    TestCategoriesShareByPath();
+    TestContentDedupVerifiesBytes();
+    TestBudgetEvictsLeastRecentlyUsed();
+    TestBudgetPrefersUnsharedTextures();
+    TestVariantsAreNotShared();
+    TestConcurrentAccess();
+    std::printf("TextureCacheTest ok\n");
+    return 0;
+}
@@ -0,0 +1,318 @@
+#include "TextureCooker.h"
+#include "TestCheck.h"
+#include "stb_image_write.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Fixture {
+    fs::path root;
+
+    Fixture() {
+        root = fs::temp_directory_path() / ("TextureCookerTest_" + std::to_string(
+            std::chrono::steady_clock::now().time_since_epoch().count()));
+        fs::create_directories(root);
+    }
+    ~Fixture() { fs::remove_all(root); }
+};
+
+enum class Pattern { Opaque, AlphaGradient, GreenKey, Normal };
+
+// 平滑漸層加上少量雜訊與色塊，接近一般美術貼圖的區塊內變化
+TextureImage MakeImage(uint32_t width, uint32_t height, Pattern pattern) {
+    TextureImage image;
+    image.width = width;
+    image.height = height;
+    image.rgba.resize(size_t(width) * height * 4);
+    std::mt19937 rng(static_cast<unsigned>(pattern));
+    std::uniform_int_distribution<int> noise(-6, 6);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            uint8_t* p = &image.rgba[(size_t(y) * width + x) * 4];
+            double fx = x / double(width), fy = y / double(height);
+            int r = int(255 * fx), g = int(255 * fy), b = int(128 + 100 * std::sin(fx * 20) * std::cos(fy * 13));
+            if ((x / 37 + y / 53) % 5 == 0) {
+                r = 255 - r;
+                b = 30;
+            }
+            p[0] = uint8_t(std::clamp(r + noise(rng), 0, 255));
+            p[1] = uint8_t(std::clamp(g + noise(rng), 0, 255));
+            p[2] = uint8_t(std::clamp(b + noise(rng), 0, 255));
+            p[3] = 255;
+            if (pattern == Pattern::AlphaGradient) {
+                p[3] = uint8_t(std::clamp(int(255 * std::fabs(std::sin(fx * 7 + fy * 3))), 0, 255));
+            } else if (pattern == Pattern::GreenKey) {
+                int dx = int(x) - int(width / 2), dy = int(y) - int(height / 2);
+                if (dx * dx + dy * dy < int(width * width / 9)) {
+                    p[0] = 0;
+                    p[1] = 255;
+                    p[2] = 0;
+                }
+            } else if (pattern == Pattern::Normal) {
+                double nx = 0.4 * std::sin(fx * 30), ny = 0.4 * std::cos(fy * 25);
+                double nz = std::sqrt(1 - nx * nx - ny * ny);
+                p[0] = uint8_t((nx * 0.5 + 0.5) * 255 + 0.5);
+                p[1] = uint8_t((ny * 0.5 + 0.5) * 255 + 0.5);
+                p[2] = uint8_t((nz * 0.5 + 0.5) * 255 + 0.5);
+            }
+        }
+    }
+    return image;
+}
+
+fs::path WritePng(const fs::path& file, const TextureImage& image) {
+    CHECK(stbi_write_png(file.string().c_str(), int(image.width), int(image.height), 4, image.rgba.data(),
+                         int(image.width) * 4) != 0);
+    return file;
+}
+
+fs::path WriteBmp(const fs::path& file, const TextureImage& image) {
+    std::vector<uint8_t> rgb(size_t(image.width) * image.height * 3);
+    for (size_t i = 0; i < rgb.size() / 3; ++i) {
+        std::memcpy(&rgb[i * 3], &image.rgba[i * 4], 3);
+    }
+    CHECK(stbi_write_bmp(file.string().c_str(), int(image.width), int(image.height), 3, rgb.data()) != 0);
+    return file;
+}
+
+std::vector<uint8_t> ReadAll(const fs::path& file) {
+    std::ifstream in(file, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), {});
+}
+
+// 依 BC1 規格獨立解碼一個區塊（不經過 TextureCooker 的解碼器），輸出 16 個 RGBA 像素
+void DecodeBc1Block(const uint8_t* block, uint8_t out[16][4]) {
+    uint16_t c0 = uint16_t(block[0] | block[1] << 8), c1 = uint16_t(block[2] | block[3] << 8);
+    int palette[4][4];
+    auto expand = [](uint16_t c, int* o) {
+        o[0] = int(((c >> 11) & 31) * 255 / 31.0 + 0.5);
+        o[1] = int(((c >> 5) & 63) * 255 / 63.0 + 0.5);
+        o[2] = int((c & 31) * 255 / 31.0 + 0.5);
+        o[3] = 255;
+    };
+    expand(c0, palette[0]);
+    expand(c1, palette[1]);
+    bool fourColor = c0 > c1;
+    for (int c = 0; c < 3; ++c) {
+        if (fourColor) {
+            palette[2][c] = int(std::lround((2 * palette[0][c] + palette[1][c]) / 3.0));
+            palette[3][c] = int(std::lround((palette[0][c] + 2 * palette[1][c]) / 3.0));
+        } else {
+            palette[2][c] = int(std::lround((palette[0][c] + palette[1][c]) / 2.0));
+            palette[3][c] = 0;
+        }
+    }
+    palette[2][3] = 255;
+    palette[3][3] = fourColor ? 255 : 0;
+    uint32_t bits = uint32_t(block[4]) | uint32_t(block[5]) << 8 | uint32_t(block[6]) << 16 | uint32_t(block[7]) << 24;
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            out[i][c] = uint8_t(palette[(bits >> (2 * i)) & 3][c]);
+        }
+    }
+}
+
+double Psnr(double squaredError, size_t samples) {
+    return squaredError > 0.0 ? 10.0 * std::log10(255.0 * 255.0 * samples / squaredError) : INFINITY;
+}
+
+// 不透明貼圖自動選 BC1；DDS 含完整 mip 鏈，獨立解碼最上層的 PSNR 與 stats 一致
+void TestOpaqueCooksToBc1() {
+    Fixture fixture;
+    const TextureImage image = MakeImage(256, 128, Pattern::Opaque);
+    const fs::path source = WritePng(fixture.root / "opaque.png", image);
+    const fs::path output = CookedTexturePath(source);
+    CHECK(output.filename() == "opaque.png.dds");
+
+    TextureCookStats stats = CookTexture(source, output);
+    CHECK(stats.format == TextureCookFormat::BC1);
+    CHECK(stats.width == 256 && stats.height == 128);
+    CHECK(stats.mipLevels == 9);
+    CHECK(stats.uncompressedBytes > 7 * stats.compressedBytes);   // 最後幾層小於 4×4 仍佔整個區塊，略低於 8:1
+    CHECK(stats.colorPsnr > 34.0);
+
+    std::vector<uint8_t> bytes = ReadAll(output);
+    DdsLayout layout = ParseDds(bytes);
+    CHECK(layout.format == TextureCookFormat::BC1);
+    CHECK(layout.width == 256 && layout.height == 128);
+    CHECK(layout.levels.size() == 9);
+    CHECK(layout.levels[0].size() == 64 * 32 * 8);
+    CHECK(layout.levels.back().size() == 8);
+    size_t total = 0;
+    for (const auto& level : layout.levels) {
+        total += level.size();
+    }
+    CHECK(total == stats.compressedBytes);
+    CHECK(bytes.size() == 128 + total);
+
+    double squaredError = 0.0;
+    for (uint32_t by = 0; by < 32; ++by) {
+        for (uint32_t bx = 0; bx < 64; ++bx) {
+            uint8_t pixels[16][4];
+            DecodeBc1Block(layout.levels[0].data() + (by * 64 + bx) * 8, pixels);
+            for (int i = 0; i < 16; ++i) {
+                const uint8_t* src = &image.rgba[((by * 4 + i / 4) * 256 + bx * 4 + i % 4) * 4];
+                CHECK(pixels[i][3] == 255);
+                for (int c = 0; c < 3; ++c) {
+                    double d = double(src[c]) - pixels[i][c];
+                    squaredError += d * d;
+                }
+            }
+        }
+    }
+    CHECK(Psnr(squaredError, size_t(256) * 128 * 3) > 34.0);
+}
+
+// 半透明 alpha 自動選 BC3；alpha 以 8 值插值區塊保存
+void TestAlphaCooksToBc3() {
+    Fixture fixture;
+    const fs::path source = WritePng(fixture.root / "alpha.png", MakeImage(128, 128, Pattern::AlphaGradient));
+    TextureCookStats stats = CookTexture(source, CookedTexturePath(source));
+    CHECK(stats.format == TextureCookFormat::BC3);
+    CHECK(stats.uncompressedBytes > 3 * stats.compressedBytes);
+    CHECK(stats.colorPsnr > 32.0);
+    CHECK(stats.alphaPsnr > 38.0);
+    CHECK(ParseDds(ReadAll(CookedTexturePath(source))).format == TextureCookFormat::BC3);
+}
+
+// BMP 的純綠色色鍵在解碼時轉成透明，BC1 以 punch-through alpha 保存
+void TestBmpColorKeyBecomesPunchThrough() {
+    Fixture fixture;
+    const fs::path source = WriteBmp(fixture.root / "keyed.bmp", MakeImage(128, 128, Pattern::GreenKey));
+    TextureImage decoded = DecodeTexture(source, ReadAll(source), {});
+    CHECK(decoded.rgba[(64 * 128 + 64) * 4 + 3] == 0);
+    CHECK(decoded.rgba[3] == 255);
+
+    TextureCookStats stats = CookTexture(source, CookedTexturePath(source));
+    CHECK(stats.format == TextureCookFormat::BC1);
+    std::vector<uint8_t> bytes = ReadAll(CookedTexturePath(source));
+    DdsLayout layout = ParseDds(bytes);
+    uint8_t pixels[16][4];
+    DecodeBc1Block(layout.levels[0].data() + (16 * 32 + 16) * 8, pixels);   // 圓心所在的區塊
+    CHECK(pixels[0][3] == 0);
+    DecodeBc1Block(layout.levels[0].data(), pixels);                        // 左上角，不透明
+    CHECK(pixels[0][3] == 255);
+
+    TextureCookOptions noKey;
+    noKey.colorKeyBmp = false;
+    CHECK(DecodeTexture(source, ReadAll(source), noKey).rgba[(64 * 128 + 64) * 4 + 3] == 255);
+}
+
+// 指定 BC5 的法線貼圖只保存 R、G 兩個通道
+void TestNormalMapCooksToBc5() {
+    Fixture fixture;
+    const fs::path source = WritePng(fixture.root / "normal.png", MakeImage(128, 64, Pattern::Normal));
+    TextureCookOptions options;
+    options.format = TextureCookFormat::BC5;
+    TextureCookStats stats = CookTexture(source, CookedTexturePath(source), options);
+    CHECK(stats.format == TextureCookFormat::BC5);
+    CHECK(stats.colorPsnr > 40.0);
+    CHECK(ParseDds(ReadAll(CookedTexturePath(source))).format == TextureCookFormat::BC5);
+}
+
+// sRGB 黑白棋盤在線性空間平均，下一層是 sRGB 188 而不是 128
+void TestMipFilterIsGammaCorrect() {
+    TextureImage checker;
+    checker.width = checker.height = 4;
+    checker.rgba.resize(64);
+    for (int i = 0; i < 16; ++i) {
+        uint8_t v = ((i % 4) + (i / 4)) % 2 ? 255 : 0;
+        checker.rgba[i * 4] = checker.rgba[i * 4 + 1] = checker.rgba[i * 4 + 2] = v;
+        checker.rgba[i * 4 + 3] = 255;
+    }
+    std::vector<TextureImage> mips = BuildMipChain(checker, {});
+    CHECK(mips.size() == 3);
+    CHECK(mips[1].width == 2 && mips[2].width == 1);
+    CHECK(std::abs(int(mips[1].rgba[0]) - 188) <= 1);
+    CHECK(std::abs(int(mips[2].rgba[0]) - 188) <= 1);
+
+    TextureCookOptions linear;
+    linear.srgb = false;
+    CHECK(std::abs(int(BuildMipChain(checker, linear)[1].rgba[0]) - 128) <= 1);
+}
+
+// 透明像素的顏色不會滲入相鄰的不透明像素
+void TestTransparentTexelsDoNotBleed() {
+    TextureImage image;
+    image.width = 2;
+    image.height = 1;
+    image.rgba = { 255, 0, 0, 255, 0, 255, 0, 0 };
+    std::vector<TextureImage> mips = BuildMipChain(image, {});
+    CHECK(mips.size() == 2);
+    CHECK(mips[1].rgba[0] == 255);
+    CHECK(mips[1].rgba[1] == 0);
+    CHECK(std::abs(int(mips[1].rgba[3]) - 128) <= 1);
+}
+
+// 批次烘焙：損壞的檔案與不是 4 倍數的尺寸只讓該檔失敗，其餘照常寫出
+void TestBatchReportsFailures() {
+    Fixture fixture;
+    std::vector<fs::path> sources;
+    sources.push_back(WritePng(fixture.root / "a.png", MakeImage(64, 64, Pattern::Opaque)));
+    sources.push_back(WritePng(fixture.root / "b.png", MakeImage(64, 32, Pattern::AlphaGradient)));
+    sources.push_back(WritePng(fixture.root / "odd.png", MakeImage(30, 30, Pattern::Opaque)));
+    sources.push_back(fixture.root / "broken.png");
+    std::ofstream(sources.back(), std::ios::binary) << "not an image";
+
+    TextureCookReport report = CookTextureFiles(sources);
+    CHECK(report.textures.size() == 2);
+    CHECK(report.pipeline.failures.size() == 2);
+    CHECK(fs::exists(CookedTexturePath(sources[0])));
+    CHECK(fs::exists(CookedTexturePath(sources[1])));
+    CHECK(!fs::exists(CookedTexturePath(sources[2])));
+    CHECK(!fs::exists(CookedTexturePath(sources[3])));
+    CHECK(report.ToString().find("PSNR") != std::string::npos);
+}
+
+// 被截斷或不是 DDS 的檔案拋出例外而不是讀到緩衝區外
+void TestParseDdsRejectsTruncatedFiles() {
+    Fixture fixture;
+    const fs::path source = WritePng(fixture.root / "t.png", MakeImage(64, 64, Pattern::Opaque));
+    CookTexture(source, CookedTexturePath(source));
+    std::vector<uint8_t> bytes = ReadAll(CookedTexturePath(source));
+    bytes.resize(bytes.size() - 1);
+    bool threw = false;
+    try {
+        ParseDds(bytes);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+
+    threw = false;
+    std::vector<uint8_t> garbage(256, 0x5a);
+    try {
+        ParseDds(garbage);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+} // namespace
+
+int main() {
+    TestOpaqueCooksToBc1();
+    TestAlphaCooksToBc3();
+    TestBmpColorKeyBecomesPunchThrough();
+    TestNormalMapCooksToBc5();
+    TestMipFilterIsGammaCorrect();
+    TestTransparentTexelsDoNotBleed();
+    TestBatchReportsFailures();
+    TestParseDdsRejectsTruncatedFiles();
+    std::printf("TextureCookerTest ok\n");
+    return 0;
+}
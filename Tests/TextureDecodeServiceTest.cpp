@@ -0,0 +1,211 @@
+#include "ContentHash.h"
+#include "TestCheck.h"
+#include "TextureDecodeService.h"
+#include "stb_image_write.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Fixture {
+    fs::path root;
+    std::vector<fs::path> files;
+
+    // PNG、BMP、TGA 輪流；每 9 個像素一個純綠色 (0,255,0)，其餘像素可由索引推回
+    explicit Fixture(size_t count) {
+        root = fs::temp_directory_path() / ("TextureDecodeServiceTest_" + std::to_string(
+            std::chrono::steady_clock::now().time_since_epoch().count()));
+        fs::create_directories(root);
+        for (size_t i = 0; i < count; ++i) {
+            const int width = 64 + int(i % 5) * 32, height = 48 + int(i % 3) * 16;
+            std::vector<uint8_t> rgba(size_t(width) * height * 4);
+            for (int k = 0; k < width * height; ++k) {
+                const bool key = k % 9 == 0;
+                rgba[k * 4 + 0] = key ? 0 : uint8_t(k * 7 + i);
+                rgba[k * 4 + 1] = key ? 255 : uint8_t(k);
+                rgba[k * 4 + 2] = key ? 0 : uint8_t(i);
+                rgba[k * 4 + 3] = 255;
+            }
+            const std::string stem = root.string() + "/image" + std::to_string(i);
+            switch (i % 3) {
+            case 0:
+                files.push_back(stem + ".png");
+                CHECK(stbi_write_png(files.back().string().c_str(), width, height, 4, rgba.data(), width * 4));
+                break;
+            case 1: {
+                files.push_back(stem + ".bmp");
+                std::vector<uint8_t> rgb(size_t(width) * height * 3);
+                for (int k = 0; k < width * height; ++k) {
+                    std::memcpy(&rgb[k * 3], &rgba[k * 4], 3);
+                }
+                CHECK(stbi_write_bmp(files.back().string().c_str(), width, height, 3, rgb.data()));
+                break;
+            }
+            default:
+                files.push_back(stem + ".tga");
+                CHECK(stbi_write_tga(files.back().string().c_str(), width, height, 4, rgba.data()));
+                break;
+            }
+        }
+    }
+    ~Fixture() { fs::remove_all(root); }
+};
+
+// 輪詢 TakeCompleted 直到取回 count 個結果
+std::vector<DecodedTexture> TakeAll(TextureDecodeService& service, size_t count) {
+    std::vector<DecodedTexture> results;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (results.size() < count) {
+        CHECK(std::chrono::steady_clock::now() < deadline);
+        std::vector<DecodedTexture> batch = service.TakeCompleted();
+        if (batch.empty()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        for (DecodedTexture& decoded : batch) {
+            results.push_back(std::move(decoded));
+        }
+    }
+    return results;
+}
+
+// 每個檔案只解碼一次；結果依完成順序取走，取走後不再 pending
+void TestEveryRequestCompletesOnce() {
+    Fixture fixture(30);
+    TextureDecodeService service(3);
+    for (const fs::path& file : fixture.files) {
+        CHECK(service.Request(file));
+    }
+    CHECK(!service.Request(fixture.files[0]));
+    CHECK(service.IsPending(fixture.files[0]));
+
+    std::vector<DecodedTexture> results = TakeAll(service, fixture.files.size());
+    std::set<fs::path> seen;
+    for (const DecodedTexture& decoded : results) {
+        CHECK(decoded.error.empty());
+        CHECK(!decoded.mips.empty());
+        CHECK(decoded.contentHash == HashFile(decoded.file));
+        CHECK(seen.insert(decoded.file).second);
+    }
+    CHECK(seen.size() == fixture.files.size());
+    CHECK(service.PendingCount() == 0);
+    CHECK(!service.IsPending(fixture.files[0]));
+    CHECK(service.TakeCompleted().empty());
+
+    // 取走之後可以再次排入（例如熱重載）
+    CHECK(service.Request(fixture.files[0]));
+    CHECK(TakeAll(service, 1)[0].file == fixture.files[0]);
+}
+
+// 像素轉成 A8R8G8B8 的記憶體順序；BMP 的純綠色成為透明，PNG/TGA 保留原色
+void TestPixelsAreBgraAndBmpIsKeyed() {
+    Fixture fixture(3);
+    TextureDecodeService service(1);
+    for (const fs::path& file : fixture.files) {
+        service.Request(file);
+    }
+    for (DecodedTexture& decoded : TakeAll(service, fixture.files.size())) {
+        const TextureImage& top = decoded.mips[0];
+        const size_t index = std::stoul(decoded.file.stem().string().substr(5));
+        // 像素 1：R = 7 + i、G = 1、B = i，記憶體順序為 B、G、R、A
+        CHECK(top.rgba[4] == uint8_t(index));
+        CHECK(top.rgba[5] == 1);
+        CHECK(top.rgba[6] == uint8_t(7 + index));
+        CHECK(top.rgba[7] == 255);
+        if (decoded.file.extension() == ".bmp") {
+            CHECK(top.rgba[3] == 0);
+        } else {
+            CHECK(top.rgba[1] == 255);
+            CHECK(top.rgba[3] == 255);
+        }
+    }
+}
+
+// 預設產生完整 mip 鏈；generateMips 關閉時只有最上層（UI 貼圖）
+void TestMipOption() {
+    Fixture fixture(1);   // 64x48
+    {
+        TextureDecodeService service(1);
+        service.Request(fixture.files[0]);
+        std::optional<DecodedTexture> decoded = service.Wait(fixture.files[0]);
+        CHECK(decoded && decoded->mips.size() == 7);
+        CHECK(decoded->mips.back().width == 1 && decoded->mips.back().height == 1);
+    }
+    TextureCookOptions options;
+    options.generateMips = false;
+    TextureDecodeService service(1, options);
+    service.Request(fixture.files[0]);
+    std::optional<DecodedTexture> decoded = service.Wait(fixture.files[0]);
+    CHECK(decoded && decoded->mips.size() == 1);
+    CHECK(decoded->mips[0].width == 64 && decoded->mips[0].height == 48);
+}
+
+// Wait 取走指定檔案（排隊中時在呼叫端解碼）；沒排入的檔案回傳 nullopt
+void TestWaitTakesOneFile() {
+    Fixture fixture(20);
+    TextureDecodeService service(1);
+    for (const fs::path& file : fixture.files) {
+        service.Request(file);
+    }
+    std::optional<DecodedTexture> last = service.Wait(fixture.files.back());
+    CHECK(last && last->file == fixture.files.back() && last->error.empty());
+    CHECK(!service.IsPending(fixture.files.back()));
+    CHECK(!service.Wait(fixture.files.back()));
+    CHECK(!service.Wait(fixture.root / "never-requested.png"));
+    CHECK(TakeAll(service, fixture.files.size() - 1).size() == fixture.files.size() - 1);
+}
+
+// 讀檔或解碼失敗以 error 回報，不影響其他檔案
+void TestFailuresAreReported() {
+    Fixture fixture(2);
+    const fs::path missing = fixture.root / "missing.png";
+    const fs::path broken = fixture.root / "broken.png";
+    std::FILE* file = std::fopen(broken.string().c_str(), "wb");
+    std::fputs("not a png", file);
+    std::fclose(file);
+
+    TextureDecodeService service(2);
+    service.Request(missing);
+    service.Request(broken);
+    service.Request(fixture.files[0]);
+    size_t failures = 0;
+    for (const DecodedTexture& decoded : TakeAll(service, 3)) {
+        if (decoded.file == fixture.files[0]) {
+            CHECK(decoded.error.empty());
+        } else {
+            CHECK(!decoded.error.empty() && decoded.mips.empty());
+            ++failures;
+        }
+    }
+    CHECK(failures == 2);
+}
+
+// 佇列還有工作時解構：丟棄尚未開始的檔案，等解碼中的完成後結束
+void TestDestroyWithQueuedWork() {
+    Fixture fixture(30);
+    TextureDecodeService service(2);
+    for (const fs::path& file : fixture.files) {
+        service.Request(file);
+    }
+}
+
+} // namespace
+
+int main() {
+    TestEveryRequestCompletesOnce();
+    TestPixelsAreBgraAndBmpIsKeyed();
+    TestMipOption();
+    TestWaitTakesOneFile();
+    TestFailuresAreReported();
+    TestDestroyWithQueuedWork();
+    std::printf("TextureDecodeServiceTest ok\n");
+    return 0;
+}
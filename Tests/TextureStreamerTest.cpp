@@ -0,0 +1,210 @@
+#include "TestCheck.h"
+#include "TextureStreamer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <map>
+
+namespace {
+
+// 記錄每張貼圖最精細的常駐層；只接受相鄰層的載入與釋放，與 TextureManager 的 SetLOD 用法一致
+struct FakeTarget : ITextureStreamTarget {
+    std::map<StreamTextureId, uint32_t> resident;
+    int failNext = 0;
+    size_t streamIns = 0;
+    size_t evictions = 0;
+
+    bool StreamIn(StreamTextureId id, uint32_t level) override {
+        if (failNext > 0) {
+            --failNext;
+            return false;
+        }
+        CHECK(resident.at(id) == level + 1);
+        resident[id] = level;
+        ++streamIns;
+        return true;
+    }
+
+    void Evict(StreamTextureId id, uint32_t level) override {
+        CHECK(resident.at(id) < level);
+        resident[id] = level;
+        ++evictions;
+    }
+
+    StreamTextureId Register(TextureStreamer& streamer, const StreamTextureDesc& desc) {
+        StreamTextureId id = streamer.Register(desc);
+        resident[id] = streamer.ResidentLevel(id);
+        return id;
+    }
+};
+
+// 正方形 DXT1 貼圖：每像素半個位元組，最小 1x1
+StreamTextureDesc SquareDxt1(uint32_t size) {
+    StreamTextureDesc desc{ size, size, {} };
+    for (uint32_t s = size;; s /= 2) {
+        desc.levelBytes.push_back((std::max)(uint64_t(s) * s / 2, uint64_t(8)));
+        if (s == 1) {
+            break;
+        }
+    }
+    return desc;
+}
+
+// 註冊時只有不超過 tailDimension 的 mip 尾端常駐；沒有回報使用量的貼圖停在尾端
+void TestRegisterStartsAtTail() {
+    FakeTarget target;
+    TextureStreamer streamer(target);
+    CHECK(TextureStreamer::TailLevel(SquareDxt1(1024), 64) == 4);
+    CHECK(TextureStreamer::TailLevel(SquareDxt1(32), 64) == 0);
+    CHECK(streamer.Register(StreamTextureDesc{}) == 0);
+
+    StreamTextureId id = target.Register(streamer, SquareDxt1(1024));
+    CHECK(id != 0);
+    CHECK(streamer.ResidentLevel(id) == 4);
+    uint64_t tailBytes = 0;
+    for (size_t level = 4; level < SquareDxt1(1024).levelBytes.size(); ++level) {
+        tailBytes += SquareDxt1(1024).levelBytes[level];
+    }
+    CHECK(streamer.ResidentBytes() == tailBytes);
+
+    TextureStreamerStats stats = streamer.Update();
+    CHECK(stats.levelsStreamed == 0 && stats.levelsEvicted == 0);
+    CHECK(stats.textures == 1);
+    CHECK(target.resident[id] == 4);
+}
+
+// 在螢幕上越大需要越精細的 mip；全螢幕的 1024 貼圖需要 level 0
+void TestUsageDrivesWantedLevel() {
+    FakeTarget target;
+    TextureStreamerOptions options;
+    options.uploadBytesPerFrame = 1ull << 30;
+    TextureStreamer streamer(target, options);
+    StreamTextureId closeUp = target.Register(streamer, SquareDxt1(1024));
+    StreamTextureId distant = target.Register(streamer, SquareDxt1(1024));
+
+    streamer.ReportUsage(closeUp, 1024.0f * 1024.0f);
+    streamer.ReportUsage(distant, 128.0f * 128.0f);
+    streamer.ReportUsage(distant, 16.0f * 16.0f);   // 同一幀取最大值
+    streamer.Update();
+    CHECK(streamer.WantedLevel(closeUp) == 0);
+    CHECK(streamer.WantedLevel(distant) == 3);
+    CHECK(streamer.ResidentLevel(closeUp) == 0 && target.resident[closeUp] == 0);
+    CHECK(streamer.ResidentLevel(distant) == 3 && target.resident[distant] == 3);
+
+    // 不再使用時不主動釋放
+    TextureStreamerStats stats = streamer.Update();
+    CHECK(stats.levelsEvicted == 0);
+    CHECK(streamer.ResidentLevel(closeUp) == 0);
+}
+
+// 預算不足時丟棄最不重要的貼圖；使用量交換後預算轉給新的近處貼圖
+void TestBudgetFavoursLargeOnScreen() {
+    FakeTarget target;
+    TextureStreamerOptions options;
+    options.memoryBudget = 1 << 20;
+    options.uploadBytesPerFrame = 1ull << 30;
+    TextureStreamer streamer(target, options);
+    StreamTextureId a = target.Register(streamer, SquareDxt1(1024));
+    StreamTextureId b = target.Register(streamer, SquareDxt1(1024));
+
+    for (int frame = 0; frame < 10; ++frame) {
+        streamer.ReportUsage(a, 1024.0f * 1024.0f);
+        streamer.ReportUsage(b, 64.0f * 64.0f);
+        streamer.Update();
+        CHECK(streamer.ResidentBytes() <= options.memoryBudget);
+    }
+    CHECK(streamer.ResidentLevel(a) == 0);
+    CHECK(streamer.ResidentLevel(b) == 4);
+
+    size_t evicted = 0;
+    for (int frame = 0; frame < 10; ++frame) {
+        streamer.ReportUsage(b, 1024.0f * 1024.0f);
+        streamer.ReportUsage(a, 16.0f * 16.0f);
+        evicted += streamer.Update().levelsEvicted;
+        CHECK(streamer.ResidentBytes() <= options.memoryBudget);
+    }
+    CHECK(evicted > 0);
+    CHECK(streamer.ResidentLevel(b) <= 1);
+    CHECK(streamer.ResidentLevel(a) >= 1);
+    CHECK(target.resident[a] == streamer.ResidentLevel(a));
+    CHECK(target.resident[b] == streamer.ResidentLevel(b));
+
+    // 調低預算在下一次 Update 釋放超出的部分，尾端不會被丟棄
+    streamer.SetMemoryBudget(200 << 10);
+    streamer.Update();
+    CHECK(streamer.ResidentBytes() <= (200u << 10));
+    CHECK(streamer.ResidentLevel(a) <= 4 && streamer.ResidentLevel(b) <= 4);
+}
+
+// 每幀上傳量有上限但至少一層；StreamIn 失敗時下一幀重試
+void TestUploadCapAndRetry() {
+    FakeTarget target;
+    TextureStreamerOptions options;
+    options.uploadBytesPerFrame = 1;
+    TextureStreamer streamer(target, options);
+    StreamTextureId id = target.Register(streamer, SquareDxt1(2048));
+    const uint32_t tail = streamer.ResidentLevel(id);
+
+    streamer.ReportUsage(id, 4e6f);
+    TextureStreamerStats stats = streamer.Update();
+    CHECK(stats.levelsStreamed == 1);
+    CHECK(stats.pendingTextures == 1);
+    CHECK(streamer.ResidentLevel(id) == tail - 1);
+
+    target.failNext = 1;
+    streamer.ReportUsage(id, 4e6f);
+    stats = streamer.Update();
+    CHECK(stats.levelsStreamed == 0);
+    CHECK(streamer.ResidentLevel(id) == tail - 1);
+    streamer.ReportUsage(id, 4e6f);
+    stats = streamer.Update();
+    CHECK(stats.levelsStreamed == 1);
+    CHECK(streamer.ResidentLevel(id) == tail - 2);
+    CHECK(target.streamIns == 2);
+}
+
+// 取消註冊後釋放常駐位元組，id 可被重用
+void TestUnregisterReleasesBytes() {
+    FakeTarget target;
+    TextureStreamer streamer(target);
+    StreamTextureId a = target.Register(streamer, SquareDxt1(256));
+    StreamTextureId b = target.Register(streamer, SquareDxt1(512));
+    const uint64_t both = streamer.ResidentBytes();
+    streamer.Unregister(a);
+    CHECK(streamer.ResidentBytes() < both);
+    CHECK(streamer.ResidentLevel(a) == 0);
+    streamer.ReportUsage(a, 1e6f);   // 失效的 id 直接忽略
+    streamer.Unregister(a);
+    StreamTextureId c = target.Register(streamer, SquareDxt1(256));
+    CHECK(c == a);
+    CHECK(streamer.ResidentBytes() == both);
+    streamer.Unregister(b);
+    streamer.Unregister(c);
+    CHECK(streamer.ResidentBytes() == 0);
+}
+
+// 包圍球投影面積：距離加倍面積變為四分之一，相機在球內時以半徑計
+void TestEstimateScreenPixels() {
+    const float fovY = 3.14159265f / 4.0f;
+    const float nearPixels = TextureStreamer::EstimateScreenPixels(1.0f, 10.0f, fovY, 600.0f);
+    const float farPixels = TextureStreamer::EstimateScreenPixels(1.0f, 20.0f, fovY, 600.0f);
+    CHECK(nearPixels > 0.0f);
+    CHECK(std::fabs(nearPixels / farPixels - 4.0f) < 1e-3f);
+    CHECK(TextureStreamer::EstimateScreenPixels(1.0f, 0.1f, fovY, 600.0f) ==
+          TextureStreamer::EstimateScreenPixels(1.0f, 1.0f, fovY, 600.0f));
+    CHECK(TextureStreamer::EstimateScreenPixels(0.0f, 10.0f, fovY, 600.0f) == 0.0f);
+}
+
+} // namespace
+
+int main() {
+    TestRegisterStartsAtTail();
+    TestUsageDrivesWantedLevel();
+    TestBudgetFavoursLargeOnScreen();
+    TestUploadCapAndRetry();
+    TestUnregisterReleasesBytes();
+    TestEstimateScreenPixels();
+    std::printf("TextureStreamerTest ok\n");
+    return 0;
+}
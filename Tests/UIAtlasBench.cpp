@@ -0,0 +1,169 @@
+#include "UIAtlas.h"
+#include "UIDrawList.h"
+#include "stb_image_write.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// UIManager::Render 一幀的批次數與 SetTexture 次數（依 UIBatchRenderer::Draw 的規則計算）
+// 改寫前：每張 UI 圖片是獨立貼圖，source 為整張圖
+// 改寫後：BuildUIAtlas 打包後以圖集頁面加來源矩形繪製（UITextureRef 命中圖集時的行為）
+// 畫面：背包面板（底圖 + 每格的格子框、物品圖示、數量文字）與一排帶文字的按鈕，依 UIManager 的呼叫順序記錄
+// 用法：UIAtlasBench [格數]
+
+namespace {
+
+IDirect3DBaseTexture9* FakeTexture(size_t id) {
+    return reinterpret_cast<IDirect3DBaseTexture9*>(uintptr_t(0x1000) * uintptr_t(id + 1));
+}
+
+fs::path WriteSprite(const fs::path& file, int width, int height, uint8_t seed) {
+    std::vector<uint8_t> rgba(size_t(width) * height * 4);
+    for (size_t i = 0; i < rgba.size(); i += 4) {
+        rgba[i] = seed;
+        rgba[i + 1] = uint8_t(i);
+        rgba[i + 2] = uint8_t(255 - seed);
+        rgba[i + 3] = 255;
+    }
+    if (!stbi_write_png(file.string().c_str(), width, height, 4, rgba.data(), width * 4)) {
+        std::fprintf(stderr, "無法寫入 %s\n", file.string().c_str());
+        std::exit(1);
+    }
+    return file;
+}
+
+struct Sprite {
+    std::wstring path;
+    int width;
+    int height;
+};
+
+// 依圖片路徑決定貼圖與來源矩形
+struct TextureSource {
+    IDirect3DBaseTexture9* texture;
+    uint32_t textureWidth;
+    uint32_t textureHeight;
+    UIDrawRect source;
+};
+
+using Resolver = std::unordered_map<std::wstring, TextureSource>;
+
+struct Frame {
+    size_t quadBatches = 0;
+    size_t textBatches = 0;
+    size_t textureSwitches = 0;   // SetTexture 次數
+};
+
+Frame RecordFrame(UIDrawList& list, const Resolver& textures, const std::vector<Sprite>& icons,
+                  const Sprite& panel, const Sprite& slot, const std::vector<Sprite>& buttons, int slots) {
+    auto draw = [&](const Sprite& sprite, float x, float y) {
+        const TextureSource& source = textures.at(sprite.path);
+        list.AddImage(source.texture, source.textureWidth, source.textureHeight, source.source,
+                      { x, y, x + float(sprite.width), y + float(sprite.height) }, 0xFFFFFFFF);
+    };
+
+    list.Clear();
+    draw(panel, 0, 0);
+    const int columns = 8;
+    for (int i = 0; i < slots; ++i) {
+        const float x = 8.0f + float(i % columns) * 40.0f, y = 8.0f + float(i / columns) * 40.0f;
+        draw(slot, x, y);
+        draw(icons[size_t(i) % icons.size()], x + 2, y + 2);
+        list.AddText(std::to_wstring(i % 20 + 1), int(x) + 20, int(y) + 24, int(x) + 36, int(y) + 36, 0, 0xFFFFFFFF);
+    }
+    for (size_t i = 0; i < buttons.size(); ++i) {
+        const float x = 360.0f, y = 8.0f + float(i) * 40.0f;
+        draw(buttons[i], x, y);
+        list.AddText(L"Button", int(x) + 8, int(y) + 8, int(x) + 120, int(y) + 28, 0, 0xFF000000);
+    }
+    list.Finish();
+
+    // 與 UIBatchRenderer::Draw 相同：文字批次之後重設貼圖階段，下一個 Quads 批次一定重新 SetTexture
+    Frame frame;
+    IDirect3DBaseTexture9* bound = nullptr;
+    bool statesSet = false;
+    for (const UIDrawBatch& batch : list.Batches()) {
+        if (batch.kind == UIDrawBatchKind::Text) {
+            ++frame.textBatches;
+            statesSet = false;
+            continue;
+        }
+        ++frame.quadBatches;
+        if (!statesSet || batch.texture != bound) {
+            ++frame.textureSwitches;
+            bound = batch.texture;
+            statesSet = true;
+        }
+    }
+    return frame;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int maxSlots = argc > 1 ? std::atoi(argv[1]) : 64;
+    const fs::path root = fs::temp_directory_path() / ("UIAtlasBench_" + std::to_string(
+        std::chrono::steady_clock::now().time_since_epoch().count()));
+    fs::create_directories(root);
+
+    std::vector<Sprite> icons;
+    for (int i = 0; i < 24; ++i) {
+        const fs::path file = WriteSprite(root / ("icon" + std::to_string(i) + ".png"), 32, 32, uint8_t(i * 10));
+        icons.push_back({ file.wstring(), 32, 32 });
+    }
+    const Sprite panel = { WriteSprite(root / "panel.png", 340, 340, 1).wstring(), 340, 340 };
+    const Sprite slot = { WriteSprite(root / "slot.png", 36, 36, 2).wstring(), 36, 36 };
+    std::vector<Sprite> buttons;
+    for (int i = 0; i < 4; ++i) {
+        const fs::path file = WriteSprite(root / ("button" + std::to_string(i) + ".png"), 128, 32, uint8_t(200 + i));
+        buttons.push_back({ file.wstring(), 128, 32 });
+    }
+
+    std::vector<Sprite> all = icons;
+    all.push_back(panel);
+    all.push_back(slot);
+    all.insert(all.end(), buttons.begin(), buttons.end());
+
+    Resolver separate;
+    std::vector<std::wstring> paths;
+    for (size_t i = 0; i < all.size(); ++i) {
+        const Sprite& sprite = all[i];
+        separate[sprite.path] = { FakeTexture(i), uint32_t(sprite.width), uint32_t(sprite.height),
+                                  { 0, 0, float(sprite.width), float(sprite.height) } };
+        paths.push_back(sprite.path);
+    }
+
+    const UIAtlas atlas = BuildUIAtlas(paths);
+    Resolver atlased;
+    for (const Sprite& sprite : all) {
+        const UIAtlasSprite& entry = atlas.sprites.at(sprite.path);
+        const TextureImage& page = atlas.pages[entry.page];
+        const AtlasRect& r = entry.rect;
+        atlased[sprite.path] = { FakeTexture(1000 + entry.page), page.width, page.height,
+                                 { float(r.x), float(r.y), float(r.x + r.width), float(r.y + r.height) } };
+    }
+    std::printf("%zu images -> %zu atlas page(s), %zu skipped\n\n", all.size(), atlas.pages.size(),
+                atlas.skipped.size());
+
+    std::printf("slots  quads  separate: quad batches  SetTexture  text batches  atlas: quad batches  SetTexture  text batches\n");
+    UIDrawList list;
+    for (int slots = 8; slots <= maxSlots; slots *= 2) {
+        const Frame before = RecordFrame(list, separate, icons, panel, slot, buttons, slots);
+        const size_t quads = list.QuadCount();
+        const Frame after = RecordFrame(list, atlased, icons, panel, slot, buttons, slots);
+        std::printf("%5d  %5zu  %22zu  %10zu  %12zu  %19zu  %10zu  %12zu\n", slots, quads, before.quadBatches,
+                    before.textureSwitches, before.textBatches, after.quadBatches, after.textureSwitches,
+                    after.textBatches);
+    }
+
+    fs::remove_all(root);
+    return 0;
+}
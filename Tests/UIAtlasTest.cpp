@@ -0,0 +1,284 @@
+#include "MappedFile.h"
+#include "TestCheck.h"
+#include "UIAtlas.h"
+#include "stb_image_write.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Fixture {
+    fs::path root;
+
+    Fixture() {
+        root = fs::temp_directory_path() / ("UIAtlasTest_" + std::to_string(
+            std::chrono::steady_clock::now().time_since_epoch().count()));
+        fs::create_directories(root);
+    }
+    ~Fixture() { fs::remove_all(root); }
+};
+
+// 每個像素的顏色都不同，比對時能看出位移或翻轉
+TextureImage MakeImage(uint32_t width, uint32_t height, uint8_t seed) {
+    TextureImage image;
+    image.width = width;
+    image.height = height;
+    image.rgba.resize(size_t(width) * height * 4);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            uint8_t* p = &image.rgba[(size_t(y) * width + x) * 4];
+            p[0] = uint8_t(seed + x * 16);
+            p[1] = uint8_t(y * 16 + 1);
+            p[2] = seed;
+            p[3] = uint8_t(255 - x);
+        }
+    }
+    return image;
+}
+
+void WriteBytes(const fs::path& file, const void* data, size_t size) {
+    std::ofstream stream(file, std::ios::binary | std::ios::trunc);
+    stream.write(static_cast<const char*>(data), std::streamsize(size));
+    CHECK(stream.good());
+}
+
+// 以 fs::path 開檔，非 ASCII 的檔名在各平台都能寫入
+std::wstring WritePng(const fs::path& file, const TextureImage& image) {
+    std::vector<uint8_t> png;
+    auto append = [](void* context, void* data, int size) {
+        auto* out = static_cast<std::vector<uint8_t>*>(context);
+        out->insert(out->end(), static_cast<uint8_t*>(data), static_cast<uint8_t*>(data) + size);
+    };
+    CHECK(stbi_write_png_to_func(append, &png, int(image.width), int(image.height), 4, image.rgba.data(),
+                                 int(image.width) * 4) != 0);
+    WriteBytes(file, png.data(), png.size());
+    return file.wstring();
+}
+
+std::wstring WriteBmp(const fs::path& file, const TextureImage& image) {
+    std::vector<uint8_t> bmp, rgb(size_t(image.width) * image.height * 3);
+    for (size_t i = 0; i < rgb.size() / 3; ++i) {
+        std::memcpy(&rgb[i * 3], &image.rgba[i * 4], 3);
+    }
+    auto append = [](void* context, void* data, int size) {
+        auto* out = static_cast<std::vector<uint8_t>*>(context);
+        out->insert(out->end(), static_cast<uint8_t*>(data), static_cast<uint8_t*>(data) + size);
+    };
+    CHECK(stbi_write_bmp_to_func(append, &bmp, int(image.width), int(image.height), 3, rgb.data()) != 0);
+    WriteBytes(file, bmp.data(), bmp.size());
+    return file.wstring();
+}
+
+const uint8_t* PagePixel(const TextureImage& page, int x, int y) {
+    return &page.rgba[(size_t(y) * page.width + x) * 4];
+}
+
+// rect 內與來源相同；padding 圈是最近的邊緣像素（四角為角落像素）
+void CheckBlit(const TextureImage& page, const AtlasRect& rect, const TextureImage& expected, int padding) {
+    CHECK(rect.width == int(expected.width) && rect.height == int(expected.height));
+    for (int y = -padding; y < rect.height + padding; ++y) {
+        for (int x = -padding; x < rect.width + padding; ++x) {
+            const int sx = std::clamp(x, 0, rect.width - 1), sy = std::clamp(y, 0, rect.height - 1);
+            const uint8_t* source = &expected.rgba[(size_t(sy) * expected.width + sx) * 4];
+            CHECK(std::memcmp(PagePixel(page, rect.x + x, rect.y + y), source, 4) == 0);
+        }
+    }
+}
+
+bool Contains(const std::vector<std::wstring>& list, const std::wstring& value) {
+    return std::find(list.begin(), list.end(), value) != list.end();
+}
+
+// PNG 原樣放入；BMP 的純綠色變成透明黑（與 TextureManager 的色彩鍵相同），其他像素不透明
+void TestPixelsPaddingAndColorKey() {
+    Fixture fixture;
+    const TextureImage png = MakeImage(5, 3, 40);
+    TextureImage bmp = MakeImage(4, 4, 90);
+    for (size_t i = 0; i < bmp.rgba.size(); i += 4) {
+        bmp.rgba[i + 3] = 255;
+    }
+    const size_t keyed = (size_t(1) * 4 + 2) * 4;
+    bmp.rgba[keyed + 0] = 0;
+    bmp.rgba[keyed + 1] = 255;
+    bmp.rgba[keyed + 2] = 0;
+
+    const std::wstring pngPath = WritePng(fixture.root / "icon.png", png);
+    const std::wstring bmpPath = WriteBmp(fixture.root / "button.bmp", bmp);
+
+    for (int padding : { 0, 1, 3 }) {
+        UIAtlasOptions options;
+        options.pageSize = 64;
+        options.padding = padding;
+        const UIAtlas atlas = BuildUIAtlas({ pngPath, bmpPath }, options);
+        CHECK(atlas.skipped.empty() && atlas.sprites.size() == 2 && atlas.pages.size() == 1);
+        const TextureImage& page = atlas.pages[0];
+        CHECK(page.width == 64 && page.rgba.size() == size_t(page.width) * page.height * 4);
+
+        CheckBlit(page, atlas.sprites.at(pngPath).rect, png, padding);
+
+        TextureImage expected = bmp;
+        expected.rgba[keyed + 1] = 0;
+        expected.rgba[keyed + 3] = 0;
+        const AtlasRect& rect = atlas.sprites.at(bmpPath).rect;
+        CheckBlit(page, rect, expected, padding);
+        CHECK(PagePixel(page, rect.x + 2, rect.y + 1)[3] == 0 && PagePixel(page, rect.x, rect.y)[3] == 255);
+    }
+}
+
+// 太大、找不到、無法解碼的圖片記入 skipped；重複與空白的路徑只處理一次
+void TestSkippedAndDuplicates() {
+    Fixture fixture;
+    const std::wstring small = WritePng(fixture.root / "small.png", MakeImage(8, 8, 1));
+    const std::wstring wide = WritePng(fixture.root / "wide.png", MakeImage(17, 4, 2));
+    const std::wstring missing = (fixture.root / "missing.png").wstring();
+    const std::wstring broken = (fixture.root / "broken.png").wstring();
+    WriteBytes(broken, "not a png", 9);
+
+    UIAtlasOptions options;
+    options.pageSize = 64;
+    options.maxSpriteSize = 16;
+    const UIAtlas atlas = BuildUIAtlas({ small, wide, small, L"", missing, broken, small }, options);
+    CHECK(atlas.sprites.size() == 1 && atlas.sprites.count(small));
+    CHECK(atlas.skipped.size() == 3);
+    CHECK(Contains(atlas.skipped, wide) && Contains(atlas.skipped, missing) && Contains(atlas.skipped, broken));
+
+    // 在 maxSpriteSize 以內、但加上 padding 後比頁面大：由打包器拒絕，同樣記入 skipped
+    options.pageSize = 16;
+    options.padding = 2;
+    const std::wstring fits = WritePng(fixture.root / "fits.png", MakeImage(12, 12, 3));
+    const std::wstring tight = WritePng(fixture.root / "tight.png", MakeImage(13, 4, 4));
+    const UIAtlas packed = BuildUIAtlas({ fits, tight }, options);
+    CHECK(packed.sprites.size() == 1 && packed.sprites.count(fits));
+    CHECK(packed.skipped.size() == 1 && packed.skipped[0] == tight);
+
+    // 全部跳過時沒有頁面
+    const UIAtlas empty = BuildUIAtlas({ missing }, options);
+    CHECK(empty.pages.empty() && empty.PageCount() == 0 && empty.skipped.size() == 1);
+}
+
+// 放不下時開新頁；只有最後一頁裁成 2 的冪次高度，且不裁掉用到的列
+void TestPagesAndTrimmedHeight() {
+    Fixture fixture;
+    std::vector<std::wstring> images;
+    std::vector<TextureImage> sources;
+    for (int i = 0; i < 21; ++i) {
+        sources.push_back(MakeImage(uint32_t(10 + i % 3), uint32_t(10 + i % 4), uint8_t(i * 7)));
+        images.push_back(WritePng(fixture.root / ("sprite" + std::to_string(i) + ".png"), sources.back()));
+    }
+    UIAtlasOptions options;
+    options.pageSize = 32;
+    options.padding = 1;
+    const UIAtlas atlas = BuildUIAtlas(images, options);
+    CHECK(atlas.skipped.empty() && atlas.sprites.size() == images.size());
+    CHECK(atlas.pages.size() > 2);
+    for (size_t page = 0; page + 1 < atlas.pages.size(); ++page) {
+        CHECK(atlas.pages[page].width == 32 && atlas.pages[page].height == 32);
+    }
+    const TextureImage& last = atlas.pages.back();
+    CHECK(last.height < 32 && (last.height & (last.height - 1)) == 0);
+    for (size_t i = 0; i < images.size(); ++i) {
+        const UIAtlasSprite& sprite = atlas.sprites.at(images[i]);
+        CHECK(sprite.rect.y + sprite.rect.height + options.padding <= int(atlas.pages[sprite.page].height));
+        CheckBlit(atlas.pages[sprite.page], sprite.rect, sources[i], options.padding);
+    }
+}
+
+// libstdc++ 以 C locale 轉換寬字元路徑，非 ASCII 的檔名無法表示時改用 ASCII 的名稱（Windows 一律用前者）
+fs::path WideName(const wchar_t* name, const wchar_t* fallback) {
+    try {
+        return fs::path(name);
+    } catch (const fs::filesystem_error&) {
+        return fs::path(fallback);
+    }
+}
+
+// 寫出再讀回：精靈、skipped（含非 ASCII 的路徑）與頁面像素都與建置結果相同
+void TestManifestRoundTrip() {
+    Fixture fixture;
+    const std::wstring icon = WritePng(fixture.root / WideName(L"圖示.png", L"icon.png"), MakeImage(6, 5, 11));
+    const std::wstring other = WritePng(fixture.root / "other.png", MakeImage(9, 7, 22));
+    const std::wstring missing = (fixture.root / WideName(L"不存在.png", L"missing.png")).wstring();
+    UIAtlasOptions options;
+    options.pageSize = 16;
+    UIAtlas atlas = BuildUIAtlas({ icon, other, missing }, options);
+    CHECK(atlas.pages.size() == 2);
+
+    const fs::path manifest = fixture.root / "ui_atlas.json";
+    WriteUIAtlas(atlas, manifest);
+    CHECK(atlas.pageFiles.size() == 2);
+    CHECK(atlas.pageFiles[0] == fixture.root / "ui_atlas_0.png" && atlas.pageFiles[1] == fixture.root / "ui_atlas_1.png");
+    CHECK(!fs::exists(fixture.root / "ui_atlas.json.tmp"));
+
+    const UIAtlas loaded = ReadUIAtlas(manifest);
+    CHECK(loaded.pages.empty() && loaded.PageCount() == 2 && loaded.pageFiles == atlas.pageFiles);
+    CHECK(loaded.skipped == atlas.skipped && loaded.skipped[0] == missing);
+    CHECK(loaded.sprites.size() == atlas.sprites.size());
+    for (const auto& [path, sprite] : atlas.sprites) {
+        const UIAtlasSprite& read = loaded.sprites.at(path);
+        CHECK(read.page == sprite.page && read.rect.x == sprite.rect.x && read.rect.y == sprite.rect.y);
+        CHECK(read.rect.width == sprite.rect.width && read.rect.height == sprite.rect.height);
+    }
+
+    TextureCookOptions decodeOptions;
+    for (size_t page = 0; page < atlas.pages.size(); ++page) {
+        MappedFile file(loaded.pageFiles[page]);
+        const TextureImage decoded = DecodeTexture(loaded.pageFiles[page], file.bytes(), decodeOptions);
+        CHECK(decoded.width == atlas.pages[page].width && decoded.height == atlas.pages[page].height);
+        CHECK(decoded.rgba == atlas.pages[page].rgba);
+    }
+}
+
+// 清單不存在、格式錯誤或頁碼超出範圍時拋出 std::runtime_error
+void TestReadErrorsThrow() {
+    Fixture fixture;
+    auto throws = [](const fs::path& manifest) {
+        try {
+            ReadUIAtlas(manifest);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    auto write = [&](const char* name, const std::string& text) {
+        WriteBytes(fixture.root / name, text.data(), text.size());
+        return fixture.root / name;
+    };
+
+    CHECK(throws(fixture.root / "missing.json"));
+    CHECK(throws(write("truncated.json", "{ \"pages\": [\"a_0.png\"], \"sprites\": [")));
+    CHECK(throws(write("no_sprites.json", "{ \"pages\": [] }")));
+    CHECK(throws(write("bad_page.json",
+        "{ \"pages\": [\"a_0.png\"], \"sprites\": [ { \"path\": \"x.png\", \"page\": 1, \"x\": 0, \"y\": 0,"
+        " \"width\": 4, \"height\": 4 } ] }")));
+    CHECK(throws(write("bad_rect.json",
+        "{ \"pages\": [\"a_0.png\"], \"sprites\": [ { \"path\": \"x.png\", \"page\": 0, \"x\": \"left\", \"y\": 0,"
+        " \"width\": 4, \"height\": 4 } ] }")));
+
+    // skipped 可省略
+    const UIAtlas atlas = ReadUIAtlas(write("minimal.json",
+        "{ \"pages\": [\"a_0.png\"], \"sprites\": [ { \"path\": \"x.png\", \"page\": 0, \"x\": 1, \"y\": 2,"
+        " \"width\": 4, \"height\": 4 } ] }"));
+    CHECK(atlas.sprites.size() == 1 && atlas.sprites.at(L"x.png").rect.y == 2 && atlas.skipped.empty());
+}
+
+} // namespace
+
+int main() {
+    TestPixelsPaddingAndColorKey();
+    TestSkippedAndDuplicates();
+    TestPagesAndTrimmedHeight();
+    TestManifestRoundTrip();
+    TestReadErrorsThrow();
+    std::printf("UIAtlasTest ok\n");
+    return 0;
+}
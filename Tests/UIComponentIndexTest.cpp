@@ -0,0 +1,205 @@
+#include "TestCheck.h"
+#include "UIComponentIndex.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// 與 UIComponentNew 相同的欄位
+struct Component {
+    int id = 0;
+    std::wstring name;
+    Component* parent = nullptr;
+    std::vector<std::unique_ptr<Component>> children;
+};
+
+using Index = UIComponentIndex<Component>;
+using Roots = std::vector<std::unique_ptr<Component>>;
+
+Component* Add(Roots& roots, Component* parent, int id, const std::wstring& name) {
+    auto component = std::make_unique<Component>();
+    component->id = id;
+    component->name = name;
+    component->parent = parent;
+    Component* result = component.get();
+    (parent ? parent->children : roots).push_back(std::move(component));
+    return result;
+}
+
+// 改寫前的查找：依前序走訪組件樹
+Component* Walk(const Roots& components, const std::function<bool(const Component*)>& match) {
+    for (const auto& component : components) {
+        if (match(component.get())) {
+            return component.get();
+        }
+        if (Component* found = Walk(component->children, match)) {
+            return found;
+        }
+    }
+    return nullptr;
+}
+
+bool Validate(const Index& index, std::wstring* log = nullptr) {
+    std::wostringstream out;
+    const bool valid = index.Validate(out);
+    if (log) {
+        *log = out.str();
+    }
+    return valid;
+}
+
+// 加入整個子樹後可依名稱與 ID 找到每個組件；移除子樹後全部找不到
+void TestAddAndRemoveSubtrees() {
+    Roots roots;
+    Index index(roots);
+    Component* panel = Add(roots, nullptr, 1, L"Panel");
+    Component* ok = Add(roots, panel, 2, L"Button_OK");
+    Component* label = Add(roots, ok, 3, L"Label");
+    Component* cancel = Add(roots, panel, 4, L"Button_Cancel");
+    index.AddTree(panel);
+
+    CHECK(index.Size() == 4);
+    CHECK(index.FindByName(L"Panel") == panel && index.FindById(1) == panel);
+    CHECK(index.FindByName(L"Label") == label && index.FindById(3) == label);
+    CHECK(index.FindByName(L"Button_Cancel") == cancel && index.FindById(4) == cancel);
+    CHECK(index.FindByName(L"missing") == nullptr && index.FindById(99) == nullptr);
+    CHECK(Validate(index));
+
+    // 之後加入的子組件各自登記
+    Component* extra = Add(roots, cancel, 5, L"Extra");
+    CHECK(!Validate(index));
+    index.AddTree(extra);
+    CHECK(Validate(index));
+
+    // 拖放接受後移除：先移出索引再從樹中刪除
+    index.RemoveTree(ok);
+    panel->children.erase(panel->children.begin());
+    CHECK(index.FindByName(L"Button_OK") == nullptr && index.FindById(3) == nullptr);
+    CHECK(index.FindByName(L"Extra") == extra);
+    CHECK(index.Size() == 3);
+    CHECK(Validate(index));
+
+    index.Clear();
+    CHECK(index.Size() == 0 && index.FindById(1) == nullptr);
+}
+
+// 名稱或 ID 重複時與原本的遞迴查找相同，回傳前序走訪最先遇到的，而不是最早登記的
+void TestDuplicatesResolveByTreeOrder() {
+    Roots roots;
+    Index index(roots);
+    Component* first = Add(roots, nullptr, 7, L"icon.png");
+    Component* second = Add(roots, nullptr, 7, L"icon.png");
+    index.AddTree(first);
+    index.AddTree(second);
+    CHECK(index.FindByName(L"icon.png") == first);
+    CHECK(index.FindById(7) == first);
+
+    // 之後才建立在 first 底下的組件，前序上排在 second 之前
+    Component* child = Add(roots, first, 8, L"slot");
+    Component* grandchild = Add(roots, child, 7, L"icon.png");
+    index.AddTree(child);
+    Component* late = Add(roots, first, 9, L"slot");
+    index.AddTree(late);
+    CHECK(index.FindByName(L"icon.png") == first);   // 祖先在子孫之前
+    CHECK(index.FindByName(L"slot") == child);        // 兄弟依 children 的順序
+    index.Rename(first, L"panel");
+    CHECK(index.FindByName(L"icon.png") == grandchild);   // 在 first 的子樹中，排在 second 之前
+    CHECK(Validate(index));
+
+    index.RemoveTree(first);
+    roots.erase(roots.begin());
+    CHECK(index.FindByName(L"icon.png") == second && index.FindById(7) == second);
+    CHECK(index.FindByName(L"slot") == nullptr && index.FindById(8) == nullptr);
+    CHECK(Validate(index));
+
+    // 較早的根組件底下的子組件排在之後的根組件之前
+    Component* third = Add(roots, nullptr, 20, L"root");
+    Component* nested = Add(roots, second, 21, L"root");
+    index.AddTree(third);
+    index.AddTree(nested);
+    CHECK(index.FindByName(L"root") == nested);
+    CHECK(Validate(index));
+}
+
+// 透過 Rename/Renumber 改名稱或 ID：舊鍵找不到、新鍵找得到；直接改欄位會被 Validate 發現
+void TestRenameAndRenumber() {
+    Roots roots;
+    Index index(roots);
+    Component* button = Add(roots, nullptr, 10, L"Button");
+    Component* other = Add(roots, nullptr, 11, L"Button_Convert");
+    index.AddTree(button);
+    index.AddTree(other);
+
+    index.Rename(button, L"Button_Convert");
+    CHECK(button->name == L"Button_Convert");
+    CHECK(index.FindByName(L"Button") == nullptr);
+    CHECK(index.FindByName(L"Button_Convert") == button);   // 兩個同名，button 在樹中較前面
+    index.Renumber(button, 42);
+    CHECK(button->id == 42 && index.FindById(42) == button && index.FindById(10) == nullptr);
+    index.Rename(button, L"Button_Convert");
+    index.Renumber(button, 42);
+    CHECK(index.Size() == 2);
+    CHECK(Validate(index));
+
+    // 略過索引直接改名：樹中的組件在索引中找不到
+    other->name = L"Renamed";
+    std::wstring log;
+    CHECK(!Validate(index, &log));
+    CHECK(log.find(L"\"Renamed\" (id 11) missing from name index") != std::wstring::npos);
+    other->name = L"Button_Convert";
+    other->id = 12;
+    CHECK(!Validate(index, &log));
+    CHECK(log.find(L"missing from id index") != std::wstring::npos);
+    other->id = 11;
+
+    // 重複登記：總數與樹中的組件數不同
+    index.AddTree(other);
+    CHECK(!Validate(index, &log));
+    CHECK(log.find(L"3 names and 3 ids for 2 components") != std::wstring::npos);
+}
+
+// 隨機的組件樹（子組件可能在之後的根組件建立後才加到較前面的父組件下）、名稱與 ID（含重複）與改名，
+// 查找結果與原本的前序走訪相同
+void TestMatchesTreeWalk() {
+    std::mt19937 rng(5);
+    auto random = [&rng](int low, int high) { return std::uniform_int_distribution<int>(low, high)(rng); };
+    for (int round = 0; round < 50; ++round) {
+        Roots roots;
+        Index index(roots);
+        std::vector<Component*> all;
+        for (int i = 0; i < 300; ++i) {
+            Component* parent = all.empty() || random(0, 3) == 0 ? nullptr : all[size_t(random(0, int(all.size()) - 1))];
+            all.push_back(Add(roots, parent, random(0, 200), L"C" + std::to_wstring(random(0, 200))));
+            index.AddTree(all.back());
+        }
+        for (int i = 0; i < 50; ++i) {
+            Component* component = all[size_t(random(0, int(all.size()) - 1))];
+            index.Rename(component, L"C" + std::to_wstring(random(0, 200)));
+            index.Renumber(component, random(0, 200));
+        }
+        CHECK(Validate(index));
+        for (int id = 0; id <= 200; ++id) {
+            CHECK(index.FindById(id) == Walk(roots, [id](const Component* c) { return c->id == id; }));
+            const std::wstring name = L"C" + std::to_wstring(id);
+            CHECK(index.FindByName(name) == Walk(roots, [&name](const Component* c) { return c->name == name; }));
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    TestAddAndRemoveSubtrees();
+    TestDuplicatesResolveByTreeOrder();
+    TestRenameAndRenumber();
+    TestMatchesTreeWalk();
+    std::printf("UIComponentIndexTest ok\n");
+    return 0;
+}
@@ -0,0 +1,163 @@
+#include "TestCheck.h"
+#include "UIDrawList.h"
+
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+
+// UIDrawList 只以指標識別貼圖，不需要真的貼圖
+IDirect3DBaseTexture9* FakeTexture(int id) {
+    return reinterpret_cast<IDirect3DBaseTexture9*>(uintptr_t(0x1000) * uintptr_t(id));
+}
+
+UIDrawRect Rect(float left, float top, float right, float bottom) {
+    return { left, top, right, bottom };
+}
+
+// 不重疊的圖示輪流使用兩張貼圖、各帶一行標籤：合併成貼圖 A、標籤、貼圖 B 三批
+void TestIconsWithLabelsMergeIntoThreeBatches() {
+    UIDrawList list;
+    for (int i = 0; i < 20; ++i) {
+        const float x = float(i * 50);
+        list.AddImage(FakeTexture(1 + i % 2), 64, 64, Rect(0, 0, 32, 32), Rect(x, 0, x + 32, 32), 0xFFFFFFFF);
+        list.AddText(L"label", int(x), 34, int(x) + 40, 50, 0, 0xFF000000);
+    }
+    list.Finish();
+
+    const auto& batches = list.Batches();
+    CHECK(batches.size() == 3);
+    CHECK(list.QuadCount() == 20 && list.TextCount() == 20);
+    CHECK(list.Vertices().size() == 80 && list.TextRuns().size() == 20);
+    CHECK(batches[0].kind == UIDrawBatchKind::Quads && batches[0].texture == FakeTexture(1));
+    CHECK(batches[0].first == 0 && batches[0].count == 10);
+    CHECK(batches[1].kind == UIDrawBatchKind::Text && batches[1].first == 0 && batches[1].count == 20);
+    CHECK(batches[2].texture == FakeTexture(2) && batches[2].first == 10 && batches[2].count == 10);
+
+    // 批次內依加入順序：貼圖 B 的第一個是第 2 個圖示（x = 50）；文字同樣保留順序
+    CHECK(list.Vertices()[10 * 4].x == 50.0f - 0.5f);
+    CHECK(list.TextRuns()[1].left == 50);
+}
+
+// 頂點：半像素偏移、UV 依來源矩形換算、顏色照填
+void TestQuadVertices() {
+    UIDrawList list;
+    list.AddImage(FakeTexture(1), 64, 32, Rect(16, 8, 48, 32), Rect(10, 20, 42, 44), 0x80FF0000);
+    list.AddSolid(Rect(0, 100, 10, 110), 0xFF00FF00);
+    list.Finish();
+
+    CHECK(list.Batches().size() == 2);
+    const UIVertex* v = list.Vertices().data();
+    CHECK(v[0].x == 9.5f && v[0].y == 19.5f && v[2].x == 41.5f && v[2].y == 43.5f);
+    CHECK(v[0].u == 0.25f && v[0].v == 0.25f && v[2].u == 0.75f && v[2].v == 1.0f);
+    CHECK(v[1].u == 0.75f && v[1].v == 0.25f && v[3].u == 0.25f && v[3].v == 1.0f);
+    CHECK(v[0].z == 0.0f && v[0].rhw == 1.0f && v[0].color == 0x80FF0000);
+    CHECK(list.Batches()[1].texture == nullptr && v[4].color == 0xFF00FF00);
+}
+
+// 純色按鈕各帶文字：所有底色一批、所有文字一批
+void TestSolidButtonsMergeIntoTwoBatches() {
+    UIDrawList list;
+    for (int i = 0; i < 10; ++i) {
+        list.AddSolid(Rect(0, float(i * 40), 100, float(i * 40 + 30)), 0xFF808080);
+        list.AddText(L"button", 0, i * 40, 100, i * 40 + 30, 0, 0xFFFFFFFF);
+    }
+    list.Finish();
+    CHECK(list.Batches().size() == 2);
+    CHECK(list.Batches()[0].count == 10 && list.Batches()[1].count == 10);
+}
+
+// 重疊的堆疊不能重新排序：A、蓋在上面的 B、再蓋上 A，仍是三批
+void TestOverlapKeepsOrder() {
+    UIDrawList list;
+    list.AddImage(FakeTexture(1), 64, 64, Rect(0, 0, 64, 64), Rect(0, 0, 64, 64), ~0u);
+    list.AddImage(FakeTexture(2), 64, 64, Rect(0, 0, 64, 64), Rect(10, 10, 74, 74), ~0u);
+    list.AddImage(FakeTexture(1), 64, 64, Rect(0, 0, 64, 64), Rect(20, 20, 84, 84), ~0u);
+    list.Finish();
+    CHECK(list.Batches().size() == 3);
+    CHECK(list.Batches()[2].texture == FakeTexture(1));
+
+    // 對話框底色上的圖示與文字：後面的圖示與文字跨過不重疊的批次併入前面的同類批次
+    list.Clear();
+    list.AddSolid(Rect(0, 0, 300, 200), 0xFF202020);
+    list.AddImage(FakeTexture(3), 32, 32, Rect(0, 0, 32, 32), Rect(10, 10, 42, 42), ~0u);
+    list.AddText(L"ok", 10, 10, 42, 42, 0, ~0u);
+    list.AddImage(FakeTexture(3), 32, 32, Rect(0, 0, 32, 32), Rect(50, 10, 82, 42), ~0u);
+    list.AddText(L"cancel", 50, 10, 82, 42, 0, ~0u);
+    list.Finish();
+    CHECK(list.Batches().size() == 3);
+    CHECK(list.Batches()[0].count == 1 && list.Batches()[1].count == 2 && list.Batches()[2].count == 2);
+}
+
+// DT_NOCLIP 的文字範圍不確定：之後的項目不能跨過它往前合併，它也不併入前面的文字批次
+void TestNoClipTextBlocksMerging() {
+    UIDrawList list;
+    list.AddSolid(Rect(0, 0, 10, 10), 1);
+    list.AddText(L"t", 0, 0, 10, 10, UIDrawList::kTextNoClip, 1);
+    list.AddSolid(Rect(100, 100, 110, 110), 1);
+    list.Finish();
+    CHECK(list.Batches().size() == 3);
+
+    list.Clear();
+    list.AddText(L"a", 0, 0, 10, 10, 0, 1);
+    list.AddSolid(Rect(100, 100, 110, 110), 1);
+    list.AddText(L"b", 200, 0, 210, 10, UIDrawList::kTextNoClip, 1);
+    list.Finish();
+    CHECK(list.Batches().size() == 3);
+}
+
+// 只往回找 kLookback 批：中間有太多不同貼圖時不再合併
+void TestLookbackLimit() {
+    UIDrawList list;
+    list.AddImage(FakeTexture(1), 8, 8, Rect(0, 0, 8, 8), Rect(0, 0, 8, 8), 1);
+    for (int i = 0; i < int(UIDrawList::kLookback) + 2; ++i) {
+        const float x = float(20 + i * 10);
+        list.AddImage(FakeTexture(2 + i), 8, 8, Rect(0, 0, 8, 8), Rect(x, 0, x + 8, 8), 1);
+    }
+    list.AddImage(FakeTexture(1), 8, 8, Rect(0, 0, 8, 8), Rect(0, 50, 8, 58), 1);
+    list.Finish();
+    CHECK(list.Batches().size() == UIDrawList::kLookback + 4);
+
+    // 在範圍內時合併
+    list.Clear();
+    list.AddImage(FakeTexture(1), 8, 8, Rect(0, 0, 8, 8), Rect(0, 0, 8, 8), 1);
+    for (int i = 0; i < int(UIDrawList::kLookback) - 1; ++i) {
+        const float x = float(20 + i * 10);
+        list.AddImage(FakeTexture(2 + i), 8, 8, Rect(0, 0, 8, 8), Rect(x, 0, x + 8, 8), 1);
+    }
+    list.AddImage(FakeTexture(1), 8, 8, Rect(0, 0, 8, 8), Rect(0, 50, 8, 58), 1);
+    list.Finish();
+    CHECK(list.Batches().size() == UIDrawList::kLookback);
+    CHECK(list.Batches()[0].count == 2);
+}
+
+// 外框是四個純色四邊形；空矩形、空字串與沒有貼圖的圖片不產生項目
+void TestFrameAndDegenerateItems() {
+    UIDrawList list;
+    list.AddFrame(Rect(0, 0, 100, 50), 1, 2.0f);
+    list.Finish();
+    CHECK(list.QuadCount() == 4 && list.Batches().size() == 1);
+    CHECK(list.Vertices()[0].y == -0.5f && list.Vertices()[2].y == 1.5f);   // 上緣寬 2
+
+    list.Clear();
+    list.AddSolid(Rect(5, 5, 5, 10), 1);
+    list.AddText(L"", 0, 0, 1, 1, 0, 0);
+    list.AddImage(nullptr, 8, 8, Rect(0, 0, 8, 8), Rect(0, 0, 8, 8), 1);
+    list.AddImage(FakeTexture(1), 0, 8, Rect(0, 0, 8, 8), Rect(0, 0, 8, 8), 1);
+    list.Finish();
+    CHECK(list.Batches().empty() && list.Vertices().empty() && list.TextRuns().empty());
+}
+
+} // namespace
+
+int main() {
+    TestIconsWithLabelsMergeIntoThreeBatches();
+    TestQuadVertices();
+    TestSolidButtonsMergeIntoTwoBatches();
+    TestOverlapKeepsOrder();
+    TestNoClipTextBlocksMerging();
+    TestLookbackLimit();
+    TestFrameAndDegenerateItems();
+    std::printf("UIDrawListTest ok\n");
+    return 0;
+}
@@ -0,0 +1,245 @@
+#include "TestCheck.h"
+#include "UIHitGrid.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<uint32_t> QuerySorted(const UIHitGrid& grid, int x, int y) {
+    std::vector<uint32_t> out;
+    grid.Query(x, y, out);
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+// 右、下邊界不含；Update 移走舊位置；空矩形等同移除
+void TestInsertUpdateRemove() {
+    UIHitGrid grid;
+    grid.Insert(1, { 10, 10, 74, 30 });   // 跨兩格
+    grid.Insert(2, { 60, 0, 100, 20 });
+    CHECK(grid.Size() == 2);
+    CHECK(QuerySorted(grid, 10, 10) == std::vector<uint32_t>{ 1 });
+    CHECK(QuerySorted(grid, 65, 15) == (std::vector<uint32_t>{ 1, 2 }));
+    CHECK(QuerySorted(grid, 73, 29) == std::vector<uint32_t>{ 1 });
+    CHECK(QuerySorted(grid, 74, 29).empty() && QuerySorted(grid, 73, 30).empty());
+    CHECK(QuerySorted(grid, 9, 10).empty());
+
+    grid.Update(1, { 200, 200, 210, 210 });
+    CHECK(QuerySorted(grid, 10, 10).empty());
+    CHECK(QuerySorted(grid, 205, 205) == std::vector<uint32_t>{ 1 });
+    CHECK(grid.Size() == 2);
+
+    grid.Insert(2, { 5, 5, 5, 50 });
+    CHECK(grid.Size() == 1);
+    CHECK(QuerySorted(grid, 65, 15).empty());
+
+    grid.Remove(1);
+    grid.Remove(1);
+    grid.Remove(42);
+    CHECK(grid.Size() == 0 && grid.CellCount() == 0);
+
+    grid.Insert(3, { 0, 0, 10, 10 });
+    grid.Clear();
+    CHECK(grid.Size() == 0 && QuerySorted(grid, 1, 1).empty());
+}
+
+// 負座標落在正確的格子；超過 kMaxCellsPerItem 格的大矩形（全螢幕背景）不佔格子
+void TestNegativeAndLargeRects() {
+    UIHitGrid grid;
+    grid.Insert(1, { -100, -70, -60, -1 });
+    CHECK(QuerySorted(grid, -100, -70) == std::vector<uint32_t>{ 1 });
+    CHECK(QuerySorted(grid, -61, -2) == std::vector<uint32_t>{ 1 });
+    CHECK(QuerySorted(grid, -60, -2).empty() && QuerySorted(grid, -61, -1).empty());
+    CHECK(QuerySorted(grid, 0, 0).empty());
+
+    const size_t cells = grid.CellCount();
+    grid.Insert(2, { -5000, -5000, 5000, 5000 });
+    CHECK(grid.CellCount() == cells);
+    CHECK(QuerySorted(grid, -80, -30) == (std::vector<uint32_t>{ 1, 2 }));
+    CHECK(QuerySorted(grid, 4999, 4999) == std::vector<uint32_t>{ 2 });
+    CHECK(QuerySorted(grid, 5000, 0).empty());
+
+    // 大矩形縮小後改登記到格子，反之亦然
+    grid.Update(2, { 0, 0, 64, 64 });
+    CHECK(grid.CellCount() == cells + 1);
+    CHECK(QuerySorted(grid, -80, -30) == std::vector<uint32_t>{ 1 });
+    grid.Update(1, { -5000, 0, 5000, 1 << 20 });
+    CHECK(QuerySorted(grid, 10, 10) == (std::vector<uint32_t>{ 1, 2 }));
+    CHECK(grid.CellCount() == 1);
+}
+
+// 隨機插入、更新、移除與查詢，結果與逐一檢查每個矩形相同
+void TestMatchesBruteForce() {
+    std::mt19937 rng(1);
+    auto random = [&rng](int low, int high) { return std::uniform_int_distribution<int>(low, high)(rng); };
+    constexpr uint32_t kKeys = 1500;
+    UIHitGrid grid;
+    std::vector<UIHitRect> rects(kKeys);
+    std::vector<bool> live(kKeys, false);
+    for (int step = 0; step < 60000; ++step) {
+        const uint32_t key = uint32_t(random(0, kKeys - 1));
+        const int op = random(0, 9);
+        if (op < 6) {
+            const int x = random(-300, 2000), y = random(-300, 1200);
+            const int maxSize = op == 0 ? 5000 : 120;
+            rects[key] = { x, y, x + random(-5, maxSize), y + random(-5, maxSize) };
+            grid.Insert(key, rects[key]);
+            live[key] = !rects[key].Empty();
+        } else if (op == 6) {
+            grid.Remove(key);
+            live[key] = false;
+        } else {
+            const int x = random(-400, 2100), y = random(-400, 1300);
+            std::vector<uint32_t> expected;
+            for (uint32_t k = 0; k < kKeys; ++k) {
+                if (live[k] && rects[k].Contains(x, y)) {
+                    expected.push_back(k);
+                }
+            }
+            CHECK(QuerySorted(grid, x, y) == expected);
+        }
+    }
+    CHECK(grid.Size() == size_t(std::count(live.begin(), live.end(), true)));
+}
+
+// 背包畫面：2000 個 48x48 圖示排成格子，每點最多一個圖示；圖示間的縫隙沒有候選
+void TestInventoryIcons() {
+    UIHitGrid grid;
+    for (uint32_t i = 0; i < 2000; ++i) {
+        const int x = int(i % 50) * 52, y = int(i / 50) * 52;
+        grid.Insert(i, { x, y, x + 48, y + 48 });
+    }
+    CHECK(QuerySorted(grid, 52 * 7 + 10, 52 * 3 + 47) == std::vector<uint32_t>{ 3 * 50 + 7 });
+    CHECK(QuerySorted(grid, 52 * 7 + 49, 52 * 3 + 10).empty());
+    CHECK(QuerySorted(grid, 52 * 50, 0).empty());
+
+    // 拖放時移動一個圖示：只改變它自己的登記
+    grid.Update(0, { 52 * 7 + 4, 52 * 3 + 4, 52 * 7 + 52, 52 * 3 + 52 });
+    CHECK(QuerySorted(grid, 52 * 7 + 10, 52 * 3 + 10) == (std::vector<uint32_t>{ 0, 3 * 50 + 7 }));
+    CHECK(QuerySorted(grid, 10, 10).empty());
+}
+
+// UIManager 的用法：元件依前序編號（編號越大越晚畫、在越上層），登記被所有祖先裁切後的矩形；
+// 查詢後濾掉自己或祖先隱藏的候選，取編號最大者，與原本由上層往下遞迴的結果相同
+struct Component {
+    UIHitRect rect;   // 相對父元件
+    bool visible = true;
+    bool draggable = false;
+    Component* parent = nullptr;
+    std::vector<std::unique_ptr<Component>> children;
+
+    UIHitRect Absolute() const {
+        if (!parent) {
+            return rect;
+        }
+        const UIHitRect origin = parent->Absolute();
+        return { rect.left + origin.left, rect.top + origin.top, rect.right + origin.left, rect.bottom + origin.top };
+    }
+};
+
+void TestSlotsMatchRecursiveHitTest() {
+    std::mt19937 rng(7);
+    auto random = [&rng](int low, int high) { return std::uniform_int_distribution<int>(low, high)(rng); };
+    std::function<void(std::vector<std::unique_ptr<Component>>&, Component*, int)> generate =
+        [&](std::vector<std::unique_ptr<Component>>& out, Component* parent, int depth) {
+            const int count = random(0, depth == 0 ? 6 : 3);
+            for (int i = 0; i < count; ++i) {
+                auto component = std::make_unique<Component>();
+                const int x = random(-50, 300), y = random(-50, 300);
+                component->rect = { x, y, x + random(0, 250), y + random(0, 250) };
+                component->visible = random(0, 5) != 0;
+                component->draggable = random(0, 2) == 0;
+                component->parent = parent;
+                if (depth < 4) {
+                    generate(component->children, component.get(), depth + 1);
+                }
+                out.push_back(std::move(component));
+            }
+        };
+
+    for (int round = 0; round < 100; ++round) {
+        std::vector<std::unique_ptr<Component>> roots;
+        generate(roots, nullptr, 0);
+
+        struct Slot {
+            Component* component;
+            uint32_t parent;
+        };
+        std::vector<Slot> slots;
+        std::vector<UIHitRect> clips;
+        UIHitGrid grid;
+        std::function<void(std::vector<std::unique_ptr<Component>>&, uint32_t)> assign =
+            [&](std::vector<std::unique_ptr<Component>>& components, uint32_t parent) {
+                for (auto& component : components) {
+                    const uint32_t slot = uint32_t(slots.size());
+                    UIHitRect clip = component->Absolute();
+                    if (parent != UINT32_MAX) {
+                        const UIHitRect& outer = clips[parent];
+                        clip = { (std::max)(clip.left, outer.left), (std::max)(clip.top, outer.top),
+                                 (std::min)(clip.right, outer.right), (std::min)(clip.bottom, outer.bottom) };
+                    }
+                    slots.push_back({ component.get(), parent });
+                    clips.push_back(clip);
+                    grid.Insert(slot, clip);
+                    assign(component->children, slot);
+                }
+            };
+        assign(roots, UINT32_MAX);
+
+        for (int query = 0; query < 500; ++query) {
+            const int x = random(-60, 900), y = random(-60, 900);
+            for (bool draggableOnly : { false, true }) {
+                // 原本的遞迴：由最上層的兄弟往下，先找子元件
+                std::function<Component*(std::vector<std::unique_ptr<Component>>&)> recursive =
+                    [&](std::vector<std::unique_ptr<Component>>& components) -> Component* {
+                    for (auto it = components.rbegin(); it != components.rend(); ++it) {
+                        Component* component = it->get();
+                        if (!component->visible || !component->Absolute().Contains(x, y)) {
+                            continue;
+                        }
+                        if (Component* child = recursive(component->children)) {
+                            return child;
+                        }
+                        if (!draggableOnly || component->draggable) {
+                            return component;
+                        }
+                    }
+                    return nullptr;
+                };
+
+                std::vector<uint32_t> candidates;
+                grid.Query(x, y, candidates);
+                std::sort(candidates.begin(), candidates.end(), std::greater<uint32_t>());
+                Component* indexed = nullptr;
+                for (uint32_t slot : candidates) {
+                    bool shown = true;
+                    for (uint32_t s = slot; s != UINT32_MAX && shown; s = slots[s].parent) {
+                        shown = slots[s].component->visible;
+                    }
+                    if (shown && (!draggableOnly || slots[slot].component->draggable)) {
+                        indexed = slots[slot].component;
+                        break;
+                    }
+                }
+                CHECK(indexed == recursive(roots));
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    TestInsertUpdateRemove();
+    TestNegativeAndLargeRects();
+    TestMatchesBruteForce();
+    TestInventoryIcons();
+    TestSlotsMatchRecursiveHitTest();
+    std::printf("UIHitGridTest ok\n");
+    return 0;
+}
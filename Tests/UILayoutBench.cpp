@@ -0,0 +1,118 @@
+#include "UILayoutCache.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+// UIManager 每幀讀取組件絕對座標的成本隨樹深度的變化
+// 改寫前：GetAbsoluteRect 每次都沿著父組件走到根（每次讀取 O(深度)）
+// 改寫後：UILayoutCache 快取絕對座標，移動組件只讓子樹失效，Update 每個組件只算一次
+// 每幀先移動根組件（最壞情況：整棵樹失效）或不移動，再讀取每個組件一次（Render 與點擊測試的讀取模式）
+// 用法：UILayoutBench [最大深度]
+
+namespace {
+
+struct Rect {
+    int left = 0, top = 0, right = 0, bottom = 0;
+};
+
+struct Component {
+    int relativeX = 1, relativeY = 1;
+    int width = 10, height = 10;
+    Component* parent = nullptr;
+    std::vector<std::unique_ptr<Component>> children;
+    mutable UILayoutState<Rect> layout_;
+};
+
+using Layout = UILayoutCache<Component>;
+
+constexpr int kComponentsPerLevel = 4;
+constexpr int kReadsPerFrame = 4096;
+
+// 改寫前的 GetAbsoluteRect
+Rect Uncached(const Component& component) {
+    int x = component.relativeX, y = component.relativeY;
+    if (component.parent) {
+        const Rect parent = Uncached(*component.parent);
+        x += parent.left;
+        y += parent.top;
+    }
+    return { x, y, x + component.width, y + component.height };
+}
+
+// 深度為 depth 的鏈，每層另掛 kComponentsPerLevel - 1 個葉組件（類似面板裡的按鈕）
+std::vector<const Component*> BuildTree(std::vector<std::unique_ptr<Component>>& roots, int depth) {
+    std::vector<const Component*> all;
+    Component* parent = nullptr;
+    for (int level = 0; level < depth; ++level) {
+        Component* next = nullptr;
+        for (int i = 0; i < kComponentsPerLevel; ++i) {
+            auto component = std::make_unique<Component>();
+            component->parent = parent;
+            all.push_back(component.get());
+            if (i == 0) {
+                next = component.get();
+            }
+            (parent ? parent->children : roots).push_back(std::move(component));
+        }
+        parent = next;
+    }
+    return all;
+}
+
+template <typename Frame>
+double NanosecondsPerRead(int frames, Frame&& frame) {
+    auto start = std::chrono::steady_clock::now();
+    long long sum = 0;
+    for (int f = 0; f < frames; ++f) {
+        sum += frame(f);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    if (sum == 42) {
+        std::printf(" ");   // 讓編譯器保留讀取結果
+    }
+    return ns / (double(frames) * kReadsPerFrame);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int maxDepth = argc > 1 ? std::atoi(argv[1]) : 256;
+
+    std::printf("depth  uncached ns/read  cached(move) ns/read  cached(static) ns/read\n");
+    for (int depth = 1; depth <= maxDepth; depth *= 4) {
+        std::vector<std::unique_ptr<Component>> roots;
+        Layout layout(roots);
+        const std::vector<const Component*> all = BuildTree(roots, depth);
+        Component* root = roots.front().get();
+        const int frames = 200;
+
+        auto reads = [&](auto&& read) {
+            long long sum = 0;
+            for (int i = 0; i < kReadsPerFrame; ++i) {
+                sum += read(*all[(size_t(i) * 7919) % all.size()]).left;
+            }
+            return sum;
+        };
+
+        const double uncached = NanosecondsPerRead(frames, [&](int f) {
+            root->relativeX = f;
+            return reads(Uncached);
+        });
+        const double moved = NanosecondsPerRead(frames, [&](int f) {
+            root->relativeX = f;
+            Layout::Invalidate(*root);
+            layout.MarkDirty();
+            layout.Update();
+            return reads(Layout::Absolute);
+        });
+        const double still = NanosecondsPerRead(frames, [&](int) {
+            layout.Update();
+            return reads(Layout::Absolute);
+        });
+        std::printf("%5d  %16.1f  %20.1f  %22.1f\n", depth, uncached, moved, still);
+    }
+    return 0;
+}
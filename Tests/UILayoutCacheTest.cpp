@@ -0,0 +1,251 @@
+#include "TestCheck.h"
+#include "UILayoutCache.h"
+
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Rect {
+    int left = 0, top = 0, right = 0, bottom = 0;
+};
+
+// 與 UIComponentNew 相同的欄位
+struct Component {
+    int relativeX = 0, relativeY = 0;
+    int width = 10, height = 10;
+    Component* parent = nullptr;
+    std::vector<std::unique_ptr<Component>> children;
+    mutable UILayoutState<Rect> layout_;
+};
+
+using Layout = UILayoutCache<Component>;
+using Roots = std::vector<std::unique_ptr<Component>>;
+
+Component* Add(Roots& roots, Component* parent, int x, int y) {
+    auto component = std::make_unique<Component>();
+    component->relativeX = x;
+    component->relativeY = y;
+    component->parent = parent;
+    Component* result = component.get();
+    (parent ? parent->children : roots).push_back(std::move(component));
+    return result;
+}
+
+// 改寫前的計算：每次都沿著父組件走到根
+Rect Reference(const Component& component) {
+    int x = component.relativeX, y = component.relativeY;
+    for (const Component* p = component.parent; p; p = p->parent) {
+        x += p->relativeX;
+        y += p->relativeY;
+    }
+    return { x, y, x + component.width, y + component.height };
+}
+
+bool Matches(const Component& component) {
+    const Rect cached = Layout::Absolute(component);
+    const Rect expected = Reference(component);
+    return cached.left == expected.left && cached.top == expected.top &&
+           cached.right == expected.right && cached.bottom == expected.bottom;
+}
+
+// 與 UIComponentNew::SetPosition/SetSize 相同：改欄位後失效，並通知管理者
+void Move(Layout& layout, Component* component, int x, int y) {
+    component->relativeX = x;
+    component->relativeY = y;
+    Layout::Invalidate(*component);
+    layout.MarkDirty();
+}
+
+// 尚未 Update 就讀取：新組件一開始即為失效，讀取時沿父組件計算
+void TestReadBeforeUpdate() {
+    Roots roots;
+    Layout layout(roots);
+    Component* root = Add(roots, nullptr, 100, 50);
+    Component* mid = Add(roots, root, 10, 20);
+    Component* leaf = Add(roots, mid, 1, 2);
+    CHECK(layout.IsDirty());
+    CHECK(Matches(*leaf));
+    CHECK(!root->layout_.dirty && !mid->layout_.dirty);   // 往上的父組件一併算好
+    CHECK(Layout::Absolute(*leaf).left == 111 && Layout::Absolute(*leaf).top == 72);
+}
+
+// 移動父組件後直接讀子組件（不經過 Update）
+void TestMoveParentThenReadChild() {
+    Roots roots;
+    Layout layout(roots);
+    Component* root = Add(roots, nullptr, 0, 0);
+    Component* mid = Add(roots, root, 10, 10);
+    Component* leaf = Add(roots, mid, 5, 5);
+    Component* sibling = Add(roots, root, 30, 30);
+    layout.Update();
+    CHECK(!layout.IsDirty() && !leaf->layout_.dirty && !sibling->layout_.dirty);
+
+    Move(layout, root, 200, 100);
+    CHECK(leaf->layout_.dirty && sibling->layout_.dirty);
+    CHECK(Matches(*leaf) && Layout::Absolute(*leaf).left == 215);
+    // 只重算了 leaf 與它的祖先
+    CHECK(!mid->layout_.dirty && sibling->layout_.dirty);
+    layout.Update();
+    CHECK(!sibling->layout_.dirty && Matches(*sibling));
+}
+
+// 換父組件：組件本身要失效，否則仍保留舊父組件下的座標
+void TestReparent() {
+    Roots roots;
+    Layout layout(roots);
+    Component* a = Add(roots, nullptr, 0, 0);
+    Component* b = Add(roots, nullptr, 500, 0);
+    Component* child = Add(roots, a, 10, 10);
+    Component* grandchild = Add(roots, child, 1, 1);
+    layout.Update();
+
+    // 新的父組件已失效而子組件仍有效：不呼叫 Invalidate 時讀到的是舊座標
+    Move(layout, b, 600, 0);
+    b->children.push_back(std::move(a->children.front()));
+    a->children.clear();
+    child->parent = b;
+    CHECK(Layout::Absolute(*child).left == 10);
+
+    Layout::Invalidate(*child);
+    layout.MarkDirty();
+    CHECK(Matches(*grandchild) && Layout::Absolute(*grandchild).left == 611);
+    CHECK(Matches(*child));
+}
+
+// SetSize：右下角跟著改變，子組件的位置不變
+void TestSetSize() {
+    Roots roots;
+    Layout layout(roots);
+    Component* panel = Add(roots, nullptr, 20, 30);
+    Component* button = Add(roots, panel, 5, 5);
+    layout.Update();
+
+    panel->width = 300;
+    panel->height = 200;
+    Layout::Invalidate(*panel);
+    layout.MarkDirty();
+    layout.Update();
+    const Rect rect = Layout::Absolute(*panel);
+    CHECK(rect.right == 320 && rect.bottom == 230);
+    CHECK(Matches(*button) && Layout::Absolute(*button).left == 25);
+}
+
+// 失效遇到已失效的組件即停止：依賴「失效組件的子孫一定也已失效」
+void TestInvalidateStopsAtDirtyNode() {
+    Roots roots;
+    Layout layout(roots);
+    Component* root = Add(roots, nullptr, 0, 0);
+    Component* child = Add(roots, root, 1, 1);
+    layout.Update();
+
+    Layout::Invalidate(*root);
+    CHECK(root->layout_.dirty && child->layout_.dirty);
+
+    // 刻意違反條件：父組件失效而子組件有效時，再次失效父組件不會往下傳
+    child->layout_.dirty = false;
+    Layout::Invalidate(*root);
+    CHECK(!child->layout_.dirty);
+}
+
+// 旗標清除時 Update 不走訪；直接改欄位而沒有失效的組件不會重算
+void TestUpdateSkipsWhenClean() {
+    Roots roots;
+    Layout layout(roots);
+    Component* root = Add(roots, nullptr, 0, 0);
+    Component* child = Add(roots, root, 1, 1);
+    layout.Update();
+    CHECK(!layout.IsDirty());
+
+    // 失效但沒有通知管理者：Update 略過，讀取時仍依組件自己的旗標重算
+    root->relativeX = 50;
+    Layout::Invalidate(*root);
+    layout.Update();
+    CHECK(root->layout_.dirty && child->layout_.dirty);
+    CHECK(Matches(*child));
+
+    // 沒有失效就改欄位：讀取與 Update 都保留舊值
+    root->relativeX = 70;
+    layout.MarkDirty();
+    layout.Update();
+    CHECK(Layout::Absolute(*child).left == 51);
+}
+
+// 隨機的移動、改大小與換父組件，任意順序讀取都與逐層計算相同
+void TestRandomEdits() {
+    std::mt19937 rng(7);
+    Roots roots;
+    Layout layout(roots);
+    std::vector<Component*> all;
+    for (int i = 0; i < 200; ++i) {
+        Component* parent = all.empty() || rng() % 8 == 0 ? nullptr : all[rng() % all.size()];
+        all.push_back(Add(roots, parent, int(rng() % 100), int(rng() % 100)));
+    }
+
+    auto isAncestor = [](const Component* a, const Component* b) {
+        for (const Component* p = b; p; p = p->parent) {
+            if (p == a) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    for (int step = 0; step < 5000; ++step) {
+        Component* target = all[rng() % all.size()];
+        switch (rng() % 4) {
+        case 0:
+            Move(layout, target, int(rng() % 100), int(rng() % 100));
+            break;
+        case 1:
+            target->width = int(rng() % 50);
+            Layout::Invalidate(*target);
+            layout.MarkDirty();
+            break;
+        case 2: {
+            Component* newParent = all[rng() % all.size()];
+            if (isAncestor(target, newParent) || newParent == target->parent) {
+                break;
+            }
+            Roots& from = target->parent ? target->parent->children : roots;
+            for (auto it = from.begin(); it != from.end(); ++it) {
+                if (it->get() == target) {
+                    newParent->children.push_back(std::move(*it));
+                    from.erase(it);
+                    break;
+                }
+            }
+            target->parent = newParent;
+            Layout::Invalidate(*target);
+            layout.MarkDirty();
+            break;
+        }
+        default:
+            if (rng() % 4 == 0) {
+                layout.Update();
+            }
+            break;
+        }
+        CHECK(Matches(*all[rng() % all.size()]));
+    }
+    layout.Update();
+    for (const Component* component : all) {
+        CHECK(!component->layout_.dirty && Matches(*component));
+    }
+}
+
+} // namespace
+
+int main() {
+    TestReadBeforeUpdate();
+    TestMoveParentThenReadChild();
+    TestReparent();
+    TestSetSize();
+    TestInvalidateStopsAtDirtyNode();
+    TestUpdateSkipsWhenClean();
+    TestRandomEdits();
+    std::printf("UILayoutCacheTest ok\n");
+    return 0;
+}
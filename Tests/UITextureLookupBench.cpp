@@ -0,0 +1,110 @@
+#include "AssetId.h"
+#include "ResourceHandle.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// UIManager::Render 每幀取得元件貼圖的 CPU 成本
+// 改寫前：每個元件每幀呼叫 TextureManager::Load(path)，命中時仍做 exists() 系統呼叫、路徑轉換與鎖住的 map 查詢
+// 改寫後：UITextureRef 比對路徑後只解析 handle
+// 用法：UITextureLookupBench [元件數]
+
+namespace {
+
+struct Texture {
+    int id;
+};
+
+constexpr int kFrames = 2000;
+
+// 改寫前 TextureManager::Load 的命中路徑
+struct PathCache {
+    std::shared_mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<Texture>> textures;
+
+    std::shared_ptr<Texture> Load(const fs::path& file) {
+        if (!fs::exists(file)) {
+            return nullptr;
+        }
+        const std::string key = file.string();
+        std::shared_lock lock{ mutex };
+        auto it = textures.find(key);
+        return it != textures.end() ? it->second : nullptr;
+    }
+};
+
+// 改寫後 UITextureRef::Get 的命中路徑
+struct TextureRef {
+    std::wstring path;
+    ResourceHandle<Texture> handle;
+};
+
+template <typename Frame>
+double MicrosecondsPerFrame(Frame&& frame) {
+    auto start = std::chrono::steady_clock::now();
+    size_t drawn = 0;
+    for (int i = 0; i < kFrames; ++i) {
+        drawn += frame();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (drawn == 0) {
+        std::fprintf(stderr, "no textures resolved\n");
+        std::exit(1);
+    }
+    return seconds / kFrames * 1e6;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int elements = argc > 1 ? std::atoi(argv[1]) : 200;
+    const fs::path root = fs::temp_directory_path() / "UITextureLookupBench";
+    fs::create_directories(root);
+
+    PathCache cache;
+    HandlePool<Texture> pool;
+    std::vector<std::wstring> paths;
+    std::vector<TextureRef> refs;
+    for (int i = 0; i < elements; ++i) {
+        const fs::path file = root / ("ui_" + std::to_string(i) + ".png");
+        std::ofstream(file, std::ios::binary) << "png";
+        auto texture = std::make_shared<Texture>(Texture{ i });
+        cache.textures[file.string()] = texture;
+        paths.push_back(file.wstring());
+        AssetPathInterner::Instance().Intern(file);
+        refs.push_back({ paths.back(), pool.Insert(texture) });
+    }
+
+    const double before = MicrosecondsPerFrame([&] {
+        size_t drawn = 0;
+        for (const auto& path : paths) {
+            drawn += cache.Load(path) ? 1 : 0;
+        }
+        return drawn;
+    });
+    const double after = MicrosecondsPerFrame([&] {
+        size_t drawn = 0;
+        for (size_t i = 0; i < refs.size(); ++i) {
+            if (refs[i].path == paths[i]) {
+                drawn += pool.Resolve(refs[i].handle) ? 1 : 0;
+            }
+        }
+        return drawn;
+    });
+
+    std::printf("%d UI element(s): path Load %.1f us/frame, handle resolve %.2f us/frame (%.0fx)\n", elements,
+                before, after, before / after);
+    fs::remove_all(root);
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include "XFileObjectIndex.h"
+#include "TestCheck.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char kScene[] = R"(xof 0303txt 0032
+Frame Scene {
+  Mesh SceneMesh { 3; 0;0;0;, 1;0;0;, 0;1;0;; 1; 3;0,1,2;; }
+  Frame Box {
+    FrameTransformMatrix { 1,0,0,0, 0,1,0,0, 0,0,1,0, 5,0,0,1;; }
+    Mesh { 4; 0;0;0;, 1;0;0;, 1;1;0;, 0;1;0;; 1; 4;0,1,2,3;; }
+  }
+}
+Frame Other { Mesh { 3; 0;0;0;, 1;0;0;, 0;1;0;; 1; 3;0,1,2;; } }
+)";
+
+size_t CountTempFiles(const fs::path& dir) {
+    size_t count = 0;
+    for (const auto& entry : fs::directory_iterator(dir)) {
+        count += entry.path().extension() == ".tmp" ? 1 : 0;
+    }
+    return count;
+}
+
+} // namespace
+
+int main() {
+    const fs::path root = fs::temp_directory_path() / ("XFileObjectIndexTest_" + std::to_string(
+        std::chrono::steady_clock::now().time_since_epoch().count()));
+    fs::create_directories(root);
+    const fs::path model = root / "scene.x";
+    std::ofstream(model, std::ios::binary) << kScene;
+    fs::path sidecar = model;
+    sidecar += ".objidx";
+
+    // 多個執行緒同時建立同一個旁檔：每個都得到完整結果，最後只留下一個完整的旁檔
+    std::vector<std::thread> threads;
+    std::vector<size_t> frameCounts(8);
+    for (size_t i = 0; i < frameCounts.size(); ++i) {
+        threads.emplace_back([&, i] { frameCounts[i] = LoadXFileObjectIndex(model).frames.size(); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t count : frameCounts) {
+        CHECK(count == 3);
+    }
+    CHECK(fs::exists(sidecar));
+    CHECK(CountTempFiles(root) == 0);
+
+    // 從旁檔讀回的結果與重新略讀相同
+    XFileLayout cached = LoadXFileObjectIndex(model);
+    XFileLayout fresh = IndexXFile(model);
+    CHECK(cached.frames.size() == fresh.frames.size());
+    CHECK(cached.frames[1].body.offset == fresh.frames[1].body.offset);
+    CHECK(cached.frames[1].body.size == fresh.frames[1].body.size);
+    CHECK(cached.meshes.size() == fresh.meshes.size());
+
+    // 損毀的旁檔會被重建
+    std::ofstream(sidecar, std::ios::trunc) << "{ not json";
+    CHECK(LoadXFileObjectIndex(model).frames.size() == 3);
+    CHECK(CountTempFiles(root) == 0);
+
+    auto box = ExtractXFileObject(model, "Box");
+    CHECK(box.has_value());
+    if (box) {
+        XFileScene scene = ParseXFileMemory(box->data(), box->size());
+        CHECK(scene.meshes.size() == 1);
+        CHECK(scene.meshes[0].positions.size() == 4);
+    }
+    CHECK(!ExtractXFileObject(model, "Missing"));
+
+    fs::remove_all(root);
+    std::printf("XFileObjectIndexTest ok\n");
+    return 0;
+}
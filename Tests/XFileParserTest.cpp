@@ -0,0 +1,432 @@
+#include "XFileParser.h"
+#include "TestCheck.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+const char kSkinnedQuad[] = R"(xof 0303txt 0032
+template Frame {
+ <3d82ab46-62da-11cf-ab39-0020af71e433>
+ [...]
+}
+// comment
+AnimTicksPerSecond { 24; }
+Material Shared { 0.5;0.5;0.5;1.0;; 8.0; 1.0;1.0;1.0;; 0.0;0.0;0.0;; TextureFilename { "tex\\a.png"; } }
+Frame Root {
+  FrameTransformMatrix { 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1;; }
+  Frame Bone1 {
+    FrameTransformMatrix { 1,0,0,0, 0,1,0,0, 0,0,1,0, 1,2,3,1;; }
+  }
+  Mesh Quad {
+    4;
+    0.0;0.0;0.0;,
+    1.0;0.0;0.0;,
+    1.0;1.0;0.0;,
+    -1.5e-1;+1.0;0.0;;
+    1;
+    4;0,1,2,3;;
+    MeshNormals { 1; 0.0;0.0;1.0;; 1; 4;0,0,0,0;; }
+    MeshTextureCoords { 4; 0;0;, 1;0;, 1;1;, 0;1;; }
+    MeshMaterialList { 2; 1; 1;; { Shared } Material { 1;0;0;1;; 5; 0;0;0;; 0;0;0;; } }
+    XSkinMeshHeader { 2; 4; 1; }
+    SkinWeights { "Bone1"; 2; 0, 1; 0.25, 0.75; 1,0,0,0, 0,1,0,0, 0,0,1,0, -1,-2,-3,1;; }
+  }
+}
+AnimationSet Walk {
+  Animation { { Bone1 }
+    AnimationKey { 0; 2; 0;4;1,0,0,0;;, 24;4;0.7071,0,0.7071,0;;; }
+    AnimationKey { 2; 1; 0;3;1,2,3;;; }
+    AnimationOptions { 1; 0; }
+  }
+}
+)";
+
+const char kNested[] = R"(xof 0303txt 0032
+Frame Scene {
+  Mesh SceneMesh { 3; 0;0;0;, 1;0;0;, 0;1;0;; 1; 3;0,1,2;; }
+  Frame Box {
+    FrameTransformMatrix { 1,0,0,0, 0,1,0,0, 0,0,1,0, 5,0,0,1;; }
+    Mesh { 4; 0;0;0;, 1;0;0;, 1;1;0;, 0;1;0;; 1; 4;0,1,2,3;; }
+  }
+}
+Frame Other { Mesh { 3; 0;0;0;, 1;0;0;, 0;1;0;; 1; 3;0,1,2;; } }
+)";
+
+bool Near(float a, float b) {
+    return std::fabs(a - b) < 1e-5f;
+}
+
+// 文字格式轉成二進位格式：名稱、字串、大括號、GUID 與 [...] 各自成為 token；
+// 連續的整數與浮點數（含 '.'、指數或負號的數字）分別合併成 TOKEN_INTEGER_LIST／TOKEN_FLOAT_LIST，
+// singleIntegers 時整數改為逐一以 TOKEN_INTEGER 寫出；double64 時浮點數為 8 位元組（檔頭 0064）
+std::string ToBinaryX(std::string_view text, bool double64 = false, bool singleIntegers = false) {
+    std::string out = "xof 0303bin ";
+    out += double64 ? "0064" : "0032";
+    auto u16 = [&out](uint16_t v) { out.append(reinterpret_cast<const char*>(&v), 2); };
+    auto u32 = [&out](uint32_t v) { out.append(reinterpret_cast<const char*>(&v), 4); };
+
+    std::vector<uint32_t> ints;
+    std::vector<double> floats;
+    auto flush = [&] {
+        if (!ints.empty()) {
+            if (singleIntegers) {
+                for (uint32_t v : ints) {
+                    u16(3);
+                    u32(v);
+                }
+            } else {
+                u16(6);
+                u32(uint32_t(ints.size()));
+                for (uint32_t v : ints) {
+                    u32(v);
+                }
+            }
+            ints.clear();
+        }
+        if (!floats.empty()) {
+            u16(7);
+            u32(uint32_t(floats.size()));
+            for (double v : floats) {
+                if (double64) {
+                    out.append(reinterpret_cast<const char*>(&v), 8);
+                } else {
+                    const float f = float(v);
+                    out.append(reinterpret_cast<const char*>(&f), 4);
+                }
+            }
+            floats.clear();
+        }
+    };
+    auto name = [&](uint16_t token, std::string_view value) {
+        flush();
+        u16(token);
+        u32(uint32_t(value.size()));
+        out += value;
+    };
+
+    size_t i = 16;
+    while (i < text.size()) {
+        const char c = text[i];
+        if (c == ',' || c == ';' || static_cast<unsigned char>(c) <= ' ') {
+            ++i;
+        } else if (c == '/' && text.compare(i, 2, "//") == 0) {
+            i = text.find('\n', i);
+        } else if (c == '{' || c == '}' || c == '[' || c == ']' || c == '.') {
+            flush();
+            u16(c == '{' ? 10 : c == '}' ? 11 : c == '[' ? 14 : c == ']' ? 15 : 18);
+            ++i;
+        } else if (c == '<') {
+            flush();
+            u16(5);
+            out.append(16, '\x5A');
+            i = text.find('>', i) + 1;
+        } else if (c == '"') {
+            // 二進位字串沒有跳脫；結尾為 DWORD 的 TOKEN_SEMICOLON
+            const size_t close = text.find('"', i + 1);
+            std::string value(text.substr(i + 1, close - i - 1));
+            for (size_t pos = value.find("\\\\"); pos != std::string::npos; pos = value.find("\\\\", pos + 1)) {
+                value.erase(pos, 1);
+            }
+            name(2, value);
+            u32(0x14);
+            i = close + 1;
+        } else {
+            size_t end = i;
+            while (end < text.size() && std::strchr(",; \t\r\n{}\"<", text[end]) == nullptr) {
+                ++end;
+            }
+            const std::string token(text.substr(i, end - i));
+            if (c == '-' || c == '+' || (c >= '0' && c <= '9')) {
+                if (c == '-' || token.find_first_of(".eE") != std::string::npos) {
+                    if (!ints.empty()) {
+                        flush();
+                    }
+                    floats.push_back(std::strtod(token.c_str(), nullptr));
+                } else {
+                    if (!floats.empty()) {
+                        flush();
+                    }
+                    ints.push_back(uint32_t(std::strtol(token.c_str(), nullptr, 10)));
+                }
+            } else if (token == "template") {
+                flush();
+                u16(31);
+            } else {
+                name(1, token);
+            }
+            i = end;
+        }
+    }
+    flush();
+    return out;
+}
+
+// 兩份剖析結果逐欄位相同；tolerance 為 0 時浮點數必須逐位元相同
+bool SameScene(const XFileScene& a, const XFileScene& b, float tolerance = 0) {
+    auto same = [tolerance](float x, float y) { return tolerance == 0 ? x == y : std::fabs(x - y) <= tolerance; };
+    auto sameArray = [&same](const float* x, const float* y, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            if (!same(x[i], y[i])) {
+                return false;
+            }
+        }
+        return true;
+    };
+    auto sameVectors = [&sameArray](const auto& x, const auto& y, size_t floatsPerItem) {
+        return x.size() == y.size() &&
+               (x.empty() || sameArray(&x[0].x, &y[0].x, x.size() * floatsPerItem));
+    };
+    auto sameVectorKeys = [&sameArray](const std::vector<XFileVectorKey>& x, const std::vector<XFileVectorKey>& y) {
+        for (size_t k = 0; k < x.size() && k < y.size(); ++k) {
+            if (x[k].time != y[k].time || !sameArray(&x[k].value.x, &y[k].value.x, 3)) {
+                return false;
+            }
+        }
+        return x.size() == y.size();
+    };
+
+    if (a.ticksPerSecond != b.ticksPerSecond || a.frames.size() != b.frames.size() ||
+        a.meshes.size() != b.meshes.size() || a.animationSets.size() != b.animationSets.size()) {
+        return false;
+    }
+    for (size_t f = 0; f < a.frames.size(); ++f) {
+        if (a.frames[f].name != b.frames[f].name || a.frames[f].parent != b.frames[f].parent ||
+            !sameArray(a.frames[f].transform.m, b.frames[f].transform.m, 16)) {
+            return false;
+        }
+    }
+    for (size_t m = 0; m < a.meshes.size(); ++m) {
+        const XFileMesh& x = a.meshes[m];
+        const XFileMesh& y = b.meshes[m];
+        if (x.name != y.name || x.frameIndex != y.frameIndex || !sameVectors(x.positions, y.positions, 3) ||
+            x.indices != y.indices || !sameVectors(x.normals, y.normals, 3) || x.normalIndices != y.normalIndices ||
+            x.uvs.size() != y.uvs.size() || x.triangleMaterials != y.triangleMaterials ||
+            x.materials.size() != y.materials.size() || x.skinWeights.size() != y.skinWeights.size()) {
+            return false;
+        }
+        if (!x.uvs.empty() && !sameArray(&x.uvs[0].u, &y.uvs[0].u, x.uvs.size() * 2)) {
+            return false;
+        }
+        for (size_t i = 0; i < x.materials.size(); ++i) {
+            const XFileMaterial& p = x.materials[i];
+            const XFileMaterial& q = y.materials[i];
+            if (!sameArray(p.diffuse, q.diffuse, 4) || !same(p.power, q.power) || !sameArray(p.specular, q.specular, 3) ||
+                !sameArray(p.emissive, q.emissive, 3) || p.textureFileName != q.textureFileName) {
+                return false;
+            }
+        }
+        for (size_t i = 0; i < x.skinWeights.size(); ++i) {
+            const XFileSkinWeights& p = x.skinWeights[i];
+            const XFileSkinWeights& q = y.skinWeights[i];
+            if (p.boneName != q.boneName || p.vertexIndices != q.vertexIndices || p.weights.size() != q.weights.size() ||
+                !sameArray(p.weights.data(), q.weights.data(), p.weights.size()) ||
+                !sameArray(p.offset.m, q.offset.m, 16)) {
+                return false;
+            }
+        }
+    }
+    for (size_t s = 0; s < a.animationSets.size(); ++s) {
+        const auto& x = a.animationSets[s];
+        const auto& y = b.animationSets[s];
+        if (x.name != y.name || x.animations.size() != y.animations.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < x.animations.size(); ++i) {
+            const XFileAnimation& p = x.animations[i];
+            const XFileAnimation& q = y.animations[i];
+            if (p.frameName != q.frameName || p.rotationKeys.size() != q.rotationKeys.size() ||
+                !sameVectorKeys(p.scaleKeys, q.scaleKeys) || !sameVectorKeys(p.positionKeys, q.positionKeys) ||
+                p.matrixKeys.size() != q.matrixKeys.size()) {
+                return false;
+            }
+            for (size_t k = 0; k < p.rotationKeys.size(); ++k) {
+                if (p.rotationKeys[k].time != q.rotationKeys[k].time ||
+                    !sameArray(&p.rotationKeys[k].w, &q.rotationKeys[k].w, 4)) {
+                    return false;
+                }
+            }
+            for (size_t k = 0; k < p.matrixKeys.size(); ++k) {
+                if (p.matrixKeys[k].time != q.matrixKeys[k].time ||
+                    !sameArray(p.matrixKeys[k].value.m, q.matrixKeys[k].value.m, 16)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool SameInfos(const std::vector<XFileMeshInfo>& a, const std::vector<XFileMeshInfo>& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const XFileMeshInfo& x, const XFileMeshInfo& y) {
+        return x.frameName == y.frameName && x.meshName == y.meshName && x.frameIndex == y.frameIndex &&
+               x.vertexCount == y.vertexCount && x.triangleCount == y.triangleCount &&
+               x.materialCount == y.materialCount && x.skinned == y.skinned;
+    });
+}
+
+XFileScene Parse(const std::string& data) {
+    return ParseXFileMemory(data.data(), data.size());
+}
+
+void TestFullParse() {
+    XFileScene scene = ParseXFileMemory(kSkinnedQuad, std::strlen(kSkinnedQuad));
+    CHECK(scene.ticksPerSecond == 24);
+    CHECK(scene.frames.size() == 2);
+    CHECK(scene.frames[1].name == "Bone1" && scene.frames[1].parent == 0);
+    CHECK(Near(scene.frames[1].transform.m[12], 1) && Near(scene.frames[1].transform.m[14], 3));
+
+    CHECK(scene.meshes.size() == 1);
+    const XFileMesh& mesh = scene.meshes[0];
+    CHECK(mesh.name == "Quad" && mesh.frameIndex == 0);
+    CHECK(mesh.positions.size() == 4);
+    CHECK(Near(mesh.positions[3].x, -0.15f));
+    CHECK(mesh.indices.size() == 6);   // 四邊形扇形三角化
+    CHECK(mesh.normalIndices.size() == mesh.indices.size());
+    CHECK(mesh.uvs.size() == 4);
+    CHECK(mesh.materials.size() == 2);
+    CHECK(mesh.materials[0].textureFileName == "tex\\a.png");
+    CHECK(mesh.triangleMaterials.size() == 2 && mesh.triangleMaterials[0] == 1);
+    CHECK(mesh.skinWeights.size() == 1);
+    CHECK(mesh.skinWeights[0].boneName == "Bone1");
+    CHECK(mesh.skinWeights[0].weights.size() == 2 && Near(mesh.skinWeights[0].weights[1], 0.75f));
+    CHECK(Near(mesh.skinWeights[0].offset.m[13], -2));
+
+    CHECK(scene.animationSets.size() == 1);
+    const XFileAnimation& animation = scene.animationSets[0].animations.at(0);
+    CHECK(animation.frameName == "Bone1");
+    CHECK(animation.rotationKeys.size() == 2 && animation.rotationKeys[1].time == 24);
+    CHECK(animation.positionKeys.size() == 1 && Near(animation.positionKeys[0].value.y, 2));
+}
+
+// 略讀與完整剖析得到相同的結構資訊
+void TestScanMatchesParse() {
+    auto infos = ScanXFileMemory(kSkinnedQuad, std::strlen(kSkinnedQuad));
+    CHECK(infos.size() == 1);
+    CHECK(infos[0].frameName == "Root" && infos[0].meshName == "Quad");
+    CHECK(infos[0].vertexCount == 4 && infos[0].triangleCount == 2);
+    CHECK(infos[0].materialCount == 2 && infos[0].skinned);
+
+    auto layout = IndexXFileMemory(kNested, std::strlen(kNested));
+    CHECK(layout.meshes.size() == 3);
+    CHECK(layout.frames.size() == 3);
+    CHECK(layout.frames[1].name == "Box" && layout.frames[1].parent == 0);
+    CHECK(layout.frames[1].transform.size != 0);
+    CHECK(layout.frames[0].transform.size == 0);
+    CHECK(XFileModelNames(layout.meshes) == (std::vector<std::string>{ "Scene", "Box", "Other" }));
+}
+
+void TestErrors() {
+    const char compressed[] = "xof 0303tzip0032";
+    bool threw = false;
+    try {
+        ParseXFileMemory(compressed, std::strlen(compressed));
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+
+    const char truncated[] = "xof 0303txt 0032\nFrame A { Mesh { 3; 0;0;0;, 1;0;";
+    threw = false;
+    try {
+        ParseXFileMemory(truncated, std::strlen(truncated));
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+// 二進位格式（列表或單一整數 token、32 或 64 位元浮點數）剖析出與文字格式相同的場景
+void TestBinaryMatchesText() {
+    for (const char* text : { kSkinnedQuad, kNested }) {
+        const XFileScene expected = ParseXFileMemory(text, std::strlen(text));
+        CHECK(SameScene(expected, Parse(ToBinaryX(text))));
+        CHECK(SameScene(expected, Parse(ToBinaryX(text, false, true))));
+        CHECK(SameScene(expected, Parse(ToBinaryX(text, true)), 1e-6f));
+    }
+    const XFileScene scene = Parse(ToBinaryX(kSkinnedQuad, true));
+    CHECK(scene.meshes.at(0).materials.at(0).textureFileName == "tex\\a.png");
+    CHECK(Near(scene.meshes[0].positions[3].x, -0.15f) && Near(scene.meshes[0].skinWeights[0].offset.m[13], -2));
+}
+
+// 略讀、索引與擷取子樹在二進位輸入上的結果與文字格式相同
+void TestBinaryScan() {
+    for (const char* text : { kSkinnedQuad, kNested }) {
+        const auto expected = ScanXFileMemory(text, std::strlen(text));
+        for (const std::string& binary : { ToBinaryX(text), ToBinaryX(text, false, true), ToBinaryX(text, true) }) {
+            CHECK(SameInfos(expected, ScanXFileMemory(binary.data(), binary.size())));
+            const XFileLayout layout = IndexXFileMemory(binary.data(), binary.size());
+            CHECK(SameInfos(expected, layout.meshes));
+            CHECK(XFileModelNames(layout.meshes) == XFileModelNames(Parse(binary)));
+        }
+    }
+
+    const std::string binary = ToBinaryX(kNested, true);
+    const std::filesystem::path file = std::filesystem::temp_directory_path() / ("XFileParserTest_" +
+        std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".x");
+    std::ofstream(file, std::ios::binary) << binary;
+    const XFileLayout layout = IndexXFile(file);
+    CHECK(layout.frames.size() == 3 && layout.frames[1].name == "Box" && layout.frames[1].transform.size != 0);
+    const std::string subset = ExtractXFileFrame(file, layout, 1);
+    std::filesystem::remove(file);
+    CHECK(subset.compare(0, 16, "xof 0303bin 0064") == 0);
+    const XFileScene box = Parse(subset);
+    CHECK(box.frames.size() == 2 && box.frames[0].name == "Scene" && box.frames[1].name == "Box");
+    CHECK(box.meshes.size() == 1 && box.meshes[0].frameIndex == 1 && box.meshes[0].positions.size() == 4);
+    CHECK(Near(box.frames[1].transform.m[12], 5));
+}
+
+// 截斷的二進位檔：剖析、略讀與索引都只拋出 std::runtime_error，不讀取緩衝區以外的位元組；
+// 截斷點剛好落在頂層物件之間時三者都成功，落在最後一個頂層物件（AnimationSet）之內時三者都失敗
+void TestBinaryTruncation() {
+    for (const std::string& binary : { ToBinaryX(kSkinnedQuad), ToBinaryX(kSkinnedQuad, false, true),
+                                       ToBinaryX(kSkinnedQuad, true) }) {
+        const size_t lastObject = binary.rfind("AnimationSet") - 6;   // TOKEN_NAME 與長度欄位
+        for (size_t size = 16; size < binary.size(); ++size) {
+            // 每個長度各複製一份，越界讀取可由 sanitizer 偵測
+            const std::vector<char> prefix(binary.begin(), binary.begin() + std::ptrdiff_t(size));
+            int failures = 0;
+            try {
+                ParseXFileMemory(prefix.data(), prefix.size());
+            } catch (const std::runtime_error&) {
+                ++failures;
+            }
+            try {
+                ScanXFileMemory(prefix.data(), prefix.size());
+            } catch (const std::runtime_error&) {
+                ++failures;
+            }
+            try {
+                IndexXFileMemory(prefix.data(), prefix.size());
+            } catch (const std::runtime_error&) {
+                ++failures;
+            }
+            CHECK(failures == 0 || failures == 3);
+            // 剩下不到 2 個位元組（不足一個 token）視為檔案結束
+            CHECK(size <= lastObject + 1 || failures == 3);
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    TestFullParse();
+    TestScanMatchesParse();
+    TestErrors();
+    TestBinaryMatchesText();
+    TestBinaryScan();
+    TestBinaryTruncation();
+    std::printf("XFileParserTest ok\n");
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include "ImportPipeline.h"
+#include "XFileParser.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+// 以 ImportPipeline 匯入 .x 檔：讀檔 → XFileParser 剖析 → 攤平成頂點／索引陣列 → 空的上傳階段
+// 不需要裝置，用來在建置機上量測各階段的吞吐量、back-pressure 與在途記憶體
+// 用法：ImportPipelineTool [選項] <檔案或目錄>...
+//   --budget MB        在途資料上限（預設 512）
+//   --read N           讀檔 worker 數（預設 2）
+//   --parse N          剖析 worker 數（預設硬體執行緒數）
+//   --process N        處理 worker 數（預設硬體執行緒數）
+//   --queue N          階段間佇列容量（預設 4）
+//   --upload-ms X      上傳階段每個檔案模擬的裝置執行緒工作時間（預設 0，完全略過）
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct FlatVertex {
+    XFileVector3 pos;
+    XFileVector3 norm;
+    XFileVector2 uv;
+};
+
+struct FlatModel {
+    std::vector<FlatVertex> vertices;
+    std::vector<uint32_t> indices;
+};
+
+// 與 XNativeModelLoader 相同的資料量：每個 Mesh 的頂點攤平成交錯格式，索引依位置索引複製
+std::vector<FlatModel> Flatten(XFileScene&& scene) {
+    std::vector<FlatModel> models;
+    models.reserve(scene.meshes.size());
+    for (const XFileMesh& mesh : scene.meshes) {
+        FlatModel model;
+        model.vertices.resize(mesh.positions.size());
+        for (size_t i = 0; i < mesh.positions.size(); ++i) {
+            model.vertices[i].pos = mesh.positions[i];
+            if (i < mesh.uvs.size()) {
+                model.vertices[i].uv = mesh.uvs[i];
+            }
+        }
+        for (size_t i = 0; i < mesh.normalIndices.size() && i < mesh.indices.size(); ++i) {
+            if (mesh.normalIndices[i] < mesh.normals.size()) {
+                model.vertices[mesh.indices[i]].norm = mesh.normals[mesh.normalIndices[i]];
+            }
+        }
+        model.indices = mesh.indices;
+        models.push_back(std::move(model));
+    }
+    return models;
+}
+
+void CollectFiles(const fs::path& input, std::vector<fs::path>& files) {
+    std::error_code ec;
+    if (fs::is_directory(input, ec)) {
+        for (const auto& entry : fs::recursive_directory_iterator(input, ec)) {
+            std::string ext = entry.path().extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+            if (entry.is_regular_file() && ext == ".x") {
+                files.push_back(entry.path());
+            }
+        }
+    } else {
+        files.push_back(input);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    ImportPipelineOptions options;
+    double uploadMs = 0.0;
+    std::vector<fs::path> files;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--budget") == 0 && hasValue) {
+            options.memoryBudget = std::strtoull(argv[++i], nullptr, 10) << 20;
+        } else if (std::strcmp(argv[i], "--read") == 0 && hasValue) {
+            options.readWorkers = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--parse") == 0 && hasValue) {
+            options.parseWorkers = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--process") == 0 && hasValue) {
+            options.processWorkers = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--queue") == 0 && hasValue) {
+            options.queueCapacity = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--upload-ms") == 0 && hasValue) {
+            uploadMs = std::atof(argv[++i]);
+        } else {
+            CollectFiles(argv[i], files);
+        }
+    }
+    if (files.empty()) {
+        std::fprintf(stderr, "usage: ImportPipelineTool [--budget MB] [--read N] [--parse N] [--process N] "
+                             "[--queue N] [--upload-ms X] <file.x | directory>...\n");
+        return 2;
+    }
+    std::sort(files.begin(), files.end());
+
+    size_t models = 0;
+    size_t vertices = 0;
+    ImportPipeline<XFileScene, std::vector<FlatModel>>::UploadFn upload;
+    if (uploadMs > 0.0) {
+        // 只佔用呼叫端執行緒，模擬 CreateBuffers 在裝置執行緒上的成本
+        upload = [&](const fs::path&, std::vector<FlatModel>&& flat) {
+            models += flat.size();
+            for (const auto& model : flat) {
+                vertices += model.vertices.size();
+            }
+            std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(uploadMs));
+        };
+    }
+
+    ImportPipeline<XFileScene, std::vector<FlatModel>> pipeline(
+        [](const fs::path&, std::vector<uint8_t>&& bytes) {
+            return ParseXFileMemory(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        },
+        [](const fs::path&, XFileScene&& scene) { return Flatten(std::move(scene)); },
+        upload, options);
+
+    const ImportPipelineStats stats = pipeline.Run(files);
+    std::printf("%s", stats.ToString().c_str());
+    if (upload) {
+        std::printf("uploaded %zu model(s), %zu vertices\n", models, vertices);
+    }
+    for (const auto& [file, error] : stats.failures) {
+        std::printf("failed: %s: %s\n", file.string().c_str(), error.c_str());
+    }
+#ifdef __linux__
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    std::printf("max RSS %.1f MB (budget %.1f MB)\n", usage.ru_maxrss / 1024.0, options.memoryBudget / 1048576.0);
+#endif
+    return stats.failures.empty() ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+#include "XFileParser.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// 以 XFileParser 剖析 .x 檔並印出結構與速度，不需要 D3DX 或裝置
+// 用法：XFileParseTool [--scan] [--repeat N] <檔案或目錄>...
+//   --scan      只略讀結構（ScanXFile），不讀數值陣列
+//   --repeat N  每個檔案剖析 N 次，取最快的一次（預設 3）
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Totals {
+    size_t files = 0;
+    size_t failures = 0;
+    uint64_t bytes = 0;
+    double seconds = 0.0;
+};
+
+void CollectFiles(const fs::path& input, std::vector<fs::path>& files) {
+    std::error_code ec;
+    if (fs::is_directory(input, ec)) {
+        for (const auto& entry : fs::recursive_directory_iterator(input, ec)) {
+            std::string ext = entry.path().extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+            if (entry.is_regular_file() && ext == ".x") {
+                files.push_back(entry.path());
+            }
+        }
+    } else {
+        files.push_back(input);
+    }
+}
+
+template <typename Parse>
+double FastestSeconds(int repeat, Parse&& parse) {
+    double best = 0.0;
+    for (int i = 0; i < repeat; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        parse();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = i == 0 ? seconds : (std::min)(best, seconds);
+    }
+    return best;
+}
+
+void ParseOne(const fs::path& file, bool scanOnly, int repeat, Totals& totals) {
+    std::error_code ec;
+    const uint64_t bytes = fs::file_size(file, ec);
+    try {
+        size_t frames = 0, meshes = 0, vertices = 0, triangles = 0, animationSets = 0;
+        double seconds = 0.0;
+        if (scanOnly) {
+            std::vector<XFileMeshInfo> infos;
+            seconds = FastestSeconds(repeat, [&] { infos = ScanXFile(file); });
+            meshes = infos.size();
+            for (const auto& info : infos) {
+                vertices += info.vertexCount;
+                triangles += info.triangleCount;
+            }
+        } else {
+            XFileScene scene;
+            seconds = FastestSeconds(repeat, [&] { scene = ParseXFile(file); });
+            frames = scene.frames.size();
+            meshes = scene.meshes.size();
+            animationSets = scene.animationSets.size();
+            for (const auto& mesh : scene.meshes) {
+                vertices += mesh.positions.size();
+                triangles += mesh.indices.size() / 3;
+            }
+        }
+        std::printf("%-40s %10.2f KB %9.3f ms %8.1f MB/s  frames %zu meshes %zu vertices %zu triangles %zu anims %zu\n",
+                    file.filename().string().c_str(), bytes / 1024.0, seconds * 1e3,
+                    seconds > 0 ? bytes / seconds / 1048576.0 : 0.0, frames, meshes, vertices, triangles,
+                    animationSets);
+        totals.bytes += bytes;
+        totals.seconds += seconds;
+    } catch (const std::exception& e) {
+        std::printf("%-40s FAILED: %s\n", file.filename().string().c_str(), e.what());
+        ++totals.failures;
+    }
+    ++totals.files;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool scanOnly = false;
+    int repeat = 3;
+    std::vector<fs::path> files;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--scan") == 0) {
+            scanOnly = true;
+        } else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = (std::max)(1, std::atoi(argv[++i]));
+        } else {
+            CollectFiles(argv[i], files);
+        }
+    }
+    if (files.empty()) {
+        std::fprintf(stderr, "usage: XFileParseTool [--scan] [--repeat N] <file.x | directory>...\n");
+        return 2;
+    }
+
+    Totals totals;
+    for (const auto& file : files) {
+        ParseOne(file, scanOnly, repeat, totals);
+    }
+    std::printf("%zu file(s), %zu failed, %.2f MB in %.3f ms (%.1f MB/s)\n", totals.files, totals.failures,
+                totals.bytes / 1048576.0, totals.seconds * 1e3,
+                totals.seconds > 0 ? totals.bytes / totals.seconds / 1048576.0 : 0.0);
+    return totals.failures == 0 ? 0 : 1;
+}